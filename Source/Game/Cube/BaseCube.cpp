@@ -10,9 +10,9 @@ BaseCube::BaseCube(_In_ const XMFLOAT4& outputColor)
 {
 }
 
-HRESULT BaseCube::Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext)
+HRESULT BaseCube::Initialize(_In_ library::RenderDevice* pDevice)
 {
-    return initialize(pDevice, pImmediateContext);
+    return initialize(pDevice);
 }
 
 UINT BaseCube::GetNumVertices() const
@@ -37,6 +37,6 @@ public:
     Cube& operator=(Cube&& other) = delete;
     ~Cube() = default;
 
-    virtual HRESULT Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext) override;
+    virtual HRESULT Initialize(_In_ library::RenderDevice* pDevice) override;
     virtual void Update(_In_ FLOAT deltaTime) override;
 };
\ No newline at end of file
@@ -12,7 +12,7 @@
 #include "Common.h"
 
 #include <cstdio>
-#include <fstream>
+#include <filesystem>
 #include <memory>
 
 #include "Cube/Cube.h"
@@ -24,6 +24,10 @@
 #include "Scene/Scene.h"
 #include "Scene/Voxel.h"
 #include "Shader/SkyMapVertexShader.h"
+#include "Shader/TerrainVertexShader.h"
+#include "Shader/VoxelChunkVertexShader.h"
+#include "Shader/VoxelColumnVertexShader.h"
+#include "Shader/VoxelCompactVertexShader.h"
 
 /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
   Function: wWinMain
@@ -49,167 +53,79 @@
 INT WINAPI wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _In_ LPWSTR lpCmdLine, _In_ INT nCmdShow)
 {
     UNREFERENCED_PARAMETER(hPrevInstance);
-    UNREFERENCED_PARAMETER(lpCmdLine);
 
     std::unique_ptr<library::Game> game = std::make_unique<library::Game>(L"Game Graphics Programming Assignment 3: Cube Mapping");
 
-    std::ofstream sceneFile;
-    sceneFile.open("HeightMap.txt");
-    constexpr const UINT MAP_WIDTH = 0;
-    constexpr const UINT MAP_HEIGHT = 0;
-    constexpr const UINT MAP_DEPTH = 0;
-    XMFLOAT4 aColors[] =
-    {
-        XMFLOAT4(0.0f,      0.666f, 0.0f,   1.0f),  // GRASSLAND
-        XMFLOAT4(1.0f,      1.0f,   1.0f,   1.0f),  // SNOW
-        XMFLOAT4(0.0f,      0.0f,   0.666f, 1.0f),  // OCEAN
-        XMFLOAT4(1.0f,      0.666f, 0.0f,   1.0f),  // SAND
-        XMFLOAT4(0.666f,    0.0f,   0.0f,   1.0f),  // SCORCHED
-        XMFLOAT4(0.956f,    0.643f, 0.376f, 1.0f),  // BARE
-        XMFLOAT4(0.941f,    0.0f,   1.0f,   1.0f),  // TUNDRA
-        XMFLOAT4(0.803f,    0.521f, 0.247f, 1.0f),  // TEMPERATE_DESERT
-        XMFLOAT4(0.42f,     0.556f, 0.137f, 1.0f),  // SHRUBLAND
-        XMFLOAT4(0.0f,      0.392f, 0.0f,   1.0f),  // TAIGA
-        XMFLOAT4(1.0f,      0.55f,  0.0f,   1.0f),  // TEMPERATE_DECIDUOUS_FOREST
-        XMFLOAT4(0.0f,      0.5f,   0.0f,   1.0f),  // TEMPERATE_RAIN_FOREST
-        XMFLOAT4(0.956f,    0.643f, 0.376f, 1.0f),  // SUBTROPICAL_DESERT
-        XMFLOAT4(0.133f,    0.545f, 0.133f, 1.0f),  // TROPICAL_SEASONAL_FOREST
-        XMFLOAT4(0.15f,     0.372f, 0.15f,  1.0f),  // TROPICAL_RAIN_FOREST
-    };
-
-    sceneFile << MAP_WIDTH << " " << MAP_HEIGHT << " " << MAP_DEPTH << ' ' << ARRAYSIZE(aColors) << '\n';
-
-    for (UINT colorIdx = 0; colorIdx < ARRAYSIZE(aColors); ++colorIdx)
-    {
-        sceneFile << aColors[colorIdx].x << ' ' <<
-            aColors[colorIdx].y << ' ' <<
-            aColors[colorIdx].z << '\n';
-    }
-
-    for (UINT z = 0u; z < MAP_DEPTH; ++z)
-    {
-        for (UINT x = 0u; x < MAP_WIDTH; ++x)
+    // Worlds are pregenerated with "WorldTool generate HeightMap.bin", the text map is the fallback
+    std::filesystem::path heightMapPath = L"HeightMap.bin";
+    if (!std::filesystem::exists(heightMapPath))
+    {
+        heightMapPath = L"HeightMap.txt";
+    }
+
+    // "-chunked" meshes the voxels into greedy chunk meshes, "-exposed" only instances the blocks with a visible face,
+    // "-streamed" streams greedy chunk meshes of a generated world around the camera, "-lod" merges distant blocks,
+    // "-smooth" draws the height map as a continuous level of detail heightfield instead of blocks
+    library::eVoxelBuildMode voxelBuildMode = library::eVoxelBuildMode::INSTANCED;
+    if (wcsstr(lpCmdLine, L"-streamed"))
+    {
+        voxelBuildMode = library::eVoxelBuildMode::STREAMED;
+    }
+    else if (wcsstr(lpCmdLine, L"-smooth"))
+    {
+        voxelBuildMode = library::eVoxelBuildMode::SMOOTH;
+    }
+    else if (wcsstr(lpCmdLine, L"-lod"))
+    {
+        voxelBuildMode = library::eVoxelBuildMode::LOD;
+    }
+    else if (wcsstr(lpCmdLine, L"-chunked"))
+    {
+        voxelBuildMode = library::eVoxelBuildMode::CHUNKED;
+    }
+    else if (wcsstr(lpCmdLine, L"-exposed"))
+    {
+        voxelBuildMode = library::eVoxelBuildMode::INSTANCED_EXPOSED;
+    }
+
+    // "-compact" instances the voxels with 8-byte grid cells instead of matrices, "-columns" with one 8-byte column per cell
+    library::eInstanceFormat instanceFormat = library::eInstanceFormat::MATRIX;
+    if (wcsstr(lpCmdLine, L"-columns"))
+    {
+        instanceFormat = library::eInstanceFormat::COLUMN;
+    }
+    else if (wcsstr(lpCmdLine, L"-compact"))
+    {
+        instanceFormat = library::eInstanceFormat::COMPACT;
+    }
+
+    // "-water" draws the ocean cells as one flat surface instead of stacked blocks
+    BOOL bWaterSurface = wcsstr(lpCmdLine, L"-water") != nullptr;
+
+    // "-persist" loads the edited chunks from the region files of "World" and saves the edits back to them
+    std::filesystem::path regionDirectory;
+    if (wcsstr(lpCmdLine, L"-persist"))
+    {
+        regionDirectory = L"World";
+    }
+
+    // "-density" generates a 512x64x512 grid with caves and overhangs instead of loading the height map
+    std::shared_ptr<library::Scene> mainScene;
+    if (wcsstr(lpCmdLine, L"-density"))
+    {
+        const library::DensityDesc densityDesc =
         {
-            FLOAT height = 0.0f;
-
-            FLOAT frequencySum = 0.0f;
-            for (UINT i = 0; i < 4; ++i)
-            {
-                FLOAT frequency = pow(2.0f, static_cast<FLOAT>(i));
-                frequencySum += 1.0f / frequency;
-                height += library::Scene::GetPerlin2d(frequency * static_cast<FLOAT>(x), frequency * static_cast<FLOAT>(z), 0.1f, 4u) / frequency;
-            }
-            height /= frequencySum;
-            height = pow(height * 1.2f, 1.25f);
-
-            assert(height >= 0.0f);
-
-            FLOAT moisture = 0.0f;
-
-            frequencySum = 0.0f;
-            for (UINT i = 0; i < 4; ++i)
-            {
-                FLOAT frequency = pow(2.0f, static_cast<FLOAT>(i));
-                frequencySum += 1.0f / frequency;
-                moisture += library::Scene::GetPerlin2d(frequency * static_cast<FLOAT>(x), frequency * static_cast<FLOAT>(z), 0.1f, 4u) / frequency;
-            }
-            moisture /= frequencySum;
-            moisture = pow(moisture * 1.2f, 1.25f);
-
-            library::eBlockType blockType = library::eBlockType::GRASSLAND;
-
-            if (height < 0.1f)
-            {
-                blockType = library::eBlockType::OCEAN;
-            }
-            else if (height < 0.12f)
-            {
-                blockType = library::eBlockType::SAND;
-            }
-            else if (height > 0.8f)
-            {
-                if (moisture < 0.1f)
-                {
-                    blockType = library::eBlockType::SCORCHED;
-                }
-                else if (moisture < 0.2f)
-                {
-                    blockType = library::eBlockType::BARE;
-                }
-                else if (moisture < 0.5f)
-                {
-                    blockType = library::eBlockType::TUNDRA;
-                }
-                else
-                {
-                    blockType = library::eBlockType::SNOW;
-                }
-            }
-            else if (height > 0.6f)
-            {
-                if (moisture < 0.33f)
-                {
-                    blockType = library::eBlockType::TEMPERATE_DESERT;
-                }
-                else if (moisture < 0.66f)
-                {
-                    blockType = library::eBlockType::SHRUBLAND;
-                }
-                else
-                {
-                    blockType = library::eBlockType::TAIGA;
-                }
-            }
-            else if (height > 0.3f)
-            {
-                if (moisture < 0.16f)
-                {
-                    blockType = library::eBlockType::TEMPERATE_DESERT;
-                }
-                else if (moisture < 0.5f)
-                {
-                    blockType = library::eBlockType::GRASSLAND;
-                }
-                else if (moisture < 0.83f)
-                {
-                    blockType = library::eBlockType::TEMPERATE_DECIDUOUS_FOREST;
-                }
-                else
-                {
-                    blockType = library::eBlockType::TEMPERATE_RAIN_FOREST;
-                }
-            }
-            else
-            {
-
-                if (moisture < 0.16f)
-                {
-                    blockType = library::eBlockType::SUBTROPICAL_DESERT;
-                }
-                else if (moisture < 0.33f)
-                {
-                    blockType = library::eBlockType::GRASSLAND;
-                }
-                else if (moisture < 0.66f)
-                {
-                    blockType = library::eBlockType::TROPICAL_SEASONAL_FOREST;
-                }
-                else
-                {
-                    blockType = library::eBlockType::TROPICAL_RAIN_FOREST;
-                }
-            }
-
-            sceneFile << static_cast<CHAR>(blockType);
-
-            sceneFile << height << ' ';
-        }
-        sceneFile << '\n';
-    }
-    sceneFile << std::endl;
-    sceneFile.close();
-
-    std::shared_ptr<library::Scene> mainScene = std::make_shared<library::Scene>(L"HeightMap.txt");
+            .uWidth = 512u,
+            .uHeight = 64u,
+            .uDepth = 512u,
+            .uSeed = 0u,
+        };
+        mainScene = std::make_shared<library::Scene>(densityDesc, voxelBuildMode, instanceFormat, regionDirectory);
+    }
+    else
+    {
+        mainScene = std::make_shared<library::Scene>(heightMapPath, voxelBuildMode, instanceFormat, bWaterSurface, regionDirectory);
+    }
 
     // Phong
     std::shared_ptr<library::VertexShader> phongVertexShader = std::make_shared<library::VertexShader>(L"Shaders/PhongShaders.fxh", "VSPhong", "vs_5_0");
@@ -223,6 +139,30 @@ INT WINAPI wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
     {
         return 0;
     }
+    // Voxel Compact
+    std::shared_ptr<library::VoxelCompactVertexShader> voxelCompactVertexShader = std::make_shared<library::VoxelCompactVertexShader>(L"Shaders/VoxelShaders.fxh", "VSVoxelCompact", "vs_5_0");
+    if (FAILED(mainScene->AddVertexShader(L"VoxelCompactShader", voxelCompactVertexShader)))
+    {
+        return 0;
+    }
+    // Voxel Column
+    std::shared_ptr<library::VoxelColumnVertexShader> voxelColumnVertexShader = std::make_shared<library::VoxelColumnVertexShader>(L"Shaders/VoxelShaders.fxh", "VSVoxelColumn", "vs_5_0");
+    if (FAILED(mainScene->AddVertexShader(L"VoxelColumnShader", voxelColumnVertexShader)))
+    {
+        return 0;
+    }
+    // Voxel Chunk
+    std::shared_ptr<library::VoxelChunkVertexShader> voxelChunkVertexShader = std::make_shared<library::VoxelChunkVertexShader>(L"Shaders/VoxelShaders.fxh", "VSVoxelChunk", "vs_5_0");
+    if (FAILED(mainScene->AddVertexShader(L"VoxelChunkShader", voxelChunkVertexShader)))
+    {
+        return 0;
+    }
+    // Terrain
+    std::shared_ptr<library::TerrainVertexShader> terrainVertexShader = std::make_shared<library::TerrainVertexShader>(L"Shaders/VoxelShaders.fxh", "VSTerrain", "vs_5_0");
+    if (FAILED(mainScene->AddVertexShader(L"TerrainShader", terrainVertexShader)))
+    {
+        return 0;
+    }
     // Light Cube
     std::shared_ptr<library::VertexShader> lightVertexShader = std::make_shared<library::VertexShader>(L"Shaders/PhongShaders.fxh", "VSLightCube", "vs_5_0");
     if (FAILED(mainScene->AddVertexShader(L"LightShader", lightVertexShader)))
@@ -254,6 +194,18 @@ INT WINAPI wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
     {
         return 0;
     }
+    // Voxel Material Array
+    std::shared_ptr<library::PixelShader> voxelArrayPixelShader = std::make_shared<library::PixelShader>(L"Shaders/VoxelShaders.fxh", "PSVoxelArray", "ps_5_0");
+    if (FAILED(mainScene->AddPixelShader(L"VoxelArrayShader", voxelArrayPixelShader)))
+    {
+        return 0;
+    }
+    // Voxel Chunk
+    std::shared_ptr<library::PixelShader> voxelChunkPixelShader = std::make_shared<library::PixelShader>(L"Shaders/VoxelShaders.fxh", "PSVoxelChunk", "ps_5_0");
+    if (FAILED(mainScene->AddPixelShader(L"VoxelChunkShader", voxelChunkPixelShader)))
+    {
+        return 0;
+    }
     // Light Cube
     std::shared_ptr<library::PixelShader> lightPixelShader = std::make_shared<library::PixelShader>(L"Shaders/PhongShaders.fxh", "PSLightCube", "ps_5_0");
     if (FAILED(mainScene->AddPixelShader(L"LightShader", lightPixelShader)))
@@ -273,12 +225,46 @@ INT WINAPI wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
         return 0;
     }
 
-    if (FAILED(mainScene->SetVertexShaderOfVoxel(L"VoxelShader")))
+    // The compact blocks of every type are one voxel, colored by the material arrays
+    PCWSTR pszVoxelVertexShaderName = L"VoxelShader";
+    PCWSTR pszVoxelPixelShaderName = L"VoxelShader";
+    if (mainScene->GetInstanceFormat() == library::eInstanceFormat::COMPACT)
+    {
+        pszVoxelVertexShaderName = L"VoxelCompactShader";
+        pszVoxelPixelShaderName = L"VoxelArrayShader";
+    }
+    else if (mainScene->GetInstanceFormat() == library::eInstanceFormat::COLUMN)
+    {
+        pszVoxelVertexShaderName = L"VoxelColumnShader";
+    }
+
+    if (FAILED(mainScene->SetVertexShaderOfVoxel(pszVoxelVertexShaderName)))
+    {
+        return 0;
+    }
+
+    if (FAILED(mainScene->SetPixelShaderOfVoxel(pszVoxelPixelShaderName)))
+    {
+        return 0;
+    }
+
+    if (FAILED(mainScene->SetVertexShaderOfVoxelChunk(L"VoxelChunkShader")))
+    {
+        return 0;
+    }
+
+    if (FAILED(mainScene->SetPixelShaderOfVoxelChunk(L"VoxelChunkShader")))
+    {
+        return 0;
+    }
+
+    if (FAILED(mainScene->SetVertexShaderOfTerrain(L"TerrainShader")))
     {
         return 0;
     }
 
-    if (FAILED(mainScene->SetPixelShaderOfVoxel(L"VoxelShader")))
+    // The terrain colors come through the vertex like the chunk colors, so it shares their pixel shader
+    if (FAILED(mainScene->SetPixelShaderOfTerrain(L"VoxelChunkShader")))
     {
         return 0;
     }
@@ -46,7 +46,6 @@ namespace library
         Renderable(XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f))
         , m_filePath(filePath)
         , m_animationBuffer(nullptr)
-        , m_skinningConstantBuffer(nullptr)
         , m_aVertices(std::vector<SimpleVertex>())
         , m_aAnimationData(std::vector<AnimationData>())
         , m_aIndices(std::vector<WORD>())
@@ -61,7 +60,7 @@ namespace library
 
     {};
 
-    HRESULT Model::Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext)
+    HRESULT Model::Initialize(_In_ RenderDevice* pDevice)
     {
         HRESULT hr = S_OK;
 
@@ -80,7 +79,7 @@ namespace library
 
             XMMatrixInverse(nullptr, m_globalInverseTransform);
 
-            hr = initFromScene(pDevice, pImmediateContext, m_pScene, m_filePath);
+            hr = initFromScene(pDevice, m_pScene, m_filePath);
             if (FAILED(hr)) return (hr);
 
 
@@ -112,21 +111,6 @@ namespace library
 
         hr = pDevice->CreateBuffer(&bufferDesc, &subData, m_animationBuffer.GetAddressOf());
         if (FAILED(hr)) return (hr);
-
-        D3D11_BUFFER_DESC bd;
-        bd.ByteWidth = sizeof(CBSkinning);
-        bd.Usage = D3D11_USAGE_DEFAULT;
-        bd.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
-        bd.CPUAccessFlags = 0;
-        bd.MiscFlags = 0;
-        bd.StructureByteStride = 0;
-
-        hr = pDevice->CreateBuffer(
-            &bd,
-            nullptr,
-            m_skinningConstantBuffer.GetAddressOf()
-        );
-        if (FAILED(hr)) return hr;
         return hr;
     }
     void Model::Update(_In_ FLOAT deltaTime)
@@ -149,11 +133,6 @@ namespace library
         return m_animationBuffer;
     }
 
-    ComPtr<ID3D11Buffer>& Model::GetSkinningConstantBuffer()
-    {
-        return m_skinningConstantBuffer;
-    }
-
     UINT Model::GetNumVertices() const
     {
         return static_cast<UINT>(m_aVertices.size());
@@ -298,7 +277,7 @@ namespace library
         }
     }
 
-    HRESULT Model::loadNormalTexture(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext, _In_ const std::filesystem::path& parentDirectory, _In_ const aiMaterial* pMaterial, _In_ UINT uIndex)
+    HRESULT Model::loadNormalTexture(_In_ RenderDevice* pDevice, _In_ const std::filesystem::path& parentDirectory, _In_ const aiMaterial* pMaterial, _In_ UINT uIndex)
     {
         HRESULT hr = S_OK;
         m_aMaterials[uIndex]->pNormal = nullptr;
@@ -340,8 +319,7 @@ namespace library
     }
 
     HRESULT Model::initFromScene(
-        _In_ ID3D11Device* pDevice,
-        _In_ ID3D11DeviceContext* pImmediateContext,
+        _In_ RenderDevice* pDevice,
         _In_ const aiScene* pScene,
         _In_ const std::filesystem::path& filePath
     ) {
@@ -351,7 +329,7 @@ namespace library
         countVerticesAndIndices(NumVertices, NumIndices, m_pScene);
         reserveSpace(NumVertices, NumIndices);
         initAllMeshes(m_pScene);
-        initMaterials(pDevice, pImmediateContext, m_pScene, filePath);
+        initMaterials(pDevice, m_pScene, filePath);
 
         m_aAnimationData.resize(GetNumVertices());
 
@@ -373,15 +351,14 @@ namespace library
         };
 
 
-        initialize(pDevice, pImmediateContext);
+        initialize(pDevice);
 
         return S_OK;
     }
 
 
     HRESULT Model::initMaterials(
-        _In_ ID3D11Device* pDevice,
-        _In_ ID3D11DeviceContext* pImmediateContext,
+        _In_ RenderDevice* pDevice,
         _In_ const aiScene* pScene,
         _In_ const std::filesystem::path& filePath
     )
@@ -399,15 +376,21 @@ namespace library
             std::copy(szName.begin(), szName.end(), pwszName.begin());
             m_aMaterials.push_back(std::make_shared<Material>(pwszName));
 
-            loadTextures(pDevice, pImmediateContext, parentDirectory, pMaterial, i);
+            // Glass and other see-through materials are blended, cutouts are alpha tested
+            FLOAT opacity = 1.0f;
+            if ((pMaterial->Get(AI_MATKEY_OPACITY, opacity) == AI_SUCCESS && opacity < 1.0f) || pMaterial->GetTextureCount(aiTextureType_OPACITY) > 0u)
+            {
+                m_aMaterials.back()->bTransparent = TRUE;
+            }
+
+            loadTextures(pDevice, parentDirectory, pMaterial, i);
         }
 
         return hr;
     }
 
     HRESULT Model::loadDiffuseTexture(
-        _In_ ID3D11Device* pDevice,
-        _In_ ID3D11DeviceContext* pImmediateContext,
+        _In_ RenderDevice* pDevice,
         _In_ const std::filesystem::path& parentDirectory,
         _In_ const aiMaterial* pMaterial,
         _In_ UINT uIndex
@@ -433,7 +416,7 @@ namespace library
 
                 m_aMaterials[uIndex]->pDiffuse = std::make_shared<Texture>(fullPath);
 
-                hr = m_aMaterials[uIndex]->pDiffuse->Initialize(pDevice, pImmediateContext);
+                hr = m_aMaterials[uIndex]->pDiffuse->Initialize(pDevice);
                 if (FAILED(hr))
                 {
                     OutputDebugString(L"Error loading diffuse texture \"");
@@ -454,8 +437,7 @@ namespace library
 
 
     HRESULT Model::loadSpecularTexture(
-        _In_ ID3D11Device* pDevice,
-        _In_ ID3D11DeviceContext* pImmediateContext,
+        _In_ RenderDevice* pDevice,
         _In_ const std::filesystem::path& parentDirectory,
         _In_ const aiMaterial* pMaterial,
         _In_ UINT uIndex
@@ -481,7 +463,7 @@ namespace library
 
                 m_aMaterials[uIndex]->pSpecularExponent = std::make_shared<Texture>(fullPath);
 
-                hr = m_aMaterials[uIndex]->pSpecularExponent->Initialize(pDevice, pImmediateContext);
+                hr = m_aMaterials[uIndex]->pSpecularExponent->Initialize(pDevice);
                 if (FAILED(hr))
                 {
                     OutputDebugString(L"Error loading specular texture \"");
@@ -503,25 +485,24 @@ namespace library
 
 
     HRESULT Model::loadTextures(
-        _In_ ID3D11Device* pDevice,
-        _In_ ID3D11DeviceContext* pImmediateContext,
+        _In_ RenderDevice* pDevice,
         _In_ const std::filesystem::path& parentDirectory,
         _In_ const aiMaterial* pMaterial,
         _In_ UINT uIndex
     )
     {
-        HRESULT hr = loadDiffuseTexture(pDevice, pImmediateContext, parentDirectory, pMaterial, uIndex);
+        HRESULT hr = loadDiffuseTexture(pDevice, parentDirectory, pMaterial, uIndex);
         if (FAILED(hr))
         {
             return hr;
         }
 
-        hr = loadSpecularTexture(pDevice, pImmediateContext, parentDirectory, pMaterial, uIndex);
+        hr = loadSpecularTexture(pDevice, parentDirectory, pMaterial, uIndex);
         if (FAILED(hr))
         {
             return hr;
         }
-        hr = loadNormalTexture(pDevice, pImmediateContext, parentDirectory, pMaterial, uIndex);
+        hr = loadNormalTexture(pDevice, parentDirectory, pMaterial, uIndex);
         if (FAILED(hr))
         {
             return hr;
@@ -42,8 +42,6 @@ namespace library
                   Returns the vertex buffer
                 GetIndexBuffer
                   Returns the index buffer
-                GetConstantBuffer
-                  Returns the constant buffer
                 GetWorldMatrix
                   Returns the world matrix
                 GetNumVertices
@@ -68,11 +66,10 @@ namespace library
         Model& operator=(Model&& other) = delete;
         virtual ~Model() = default;
 
-        virtual HRESULT Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext);
+        virtual HRESULT Initialize(_In_ RenderDevice* pDevice);
         virtual void Update(_In_ FLOAT deltaTime) override;
 
         ComPtr<ID3D11Buffer>& GetAnimationBuffer();
-        ComPtr<ID3D11Buffer>& GetSkinningConstantBuffer();
 
         virtual UINT GetNumVertices() const override;
         virtual UINT GetNumIndices() const override;
@@ -134,14 +131,12 @@ namespace library
         virtual const WORD* getIndices() const override;
         void initAllMeshes(_In_ const aiScene* pScene);
         HRESULT initFromScene(
-            _In_ ID3D11Device* pDevice,
-            _In_ ID3D11DeviceContext* pImmediateContext,
+            _In_ RenderDevice* pDevice,
             _In_ const aiScene* pScene,
             _In_ const std::filesystem::path& filePath
         );
         HRESULT initMaterials(
-            _In_ ID3D11Device* pDevice,
-            _In_ ID3D11DeviceContext* pImmediateContext,
+            _In_ RenderDevice* pDevice,
             _In_ const aiScene* pScene,
             _In_ const std::filesystem::path& filePath
         );
@@ -152,29 +147,25 @@ namespace library
         void interpolateRotation(_Inout_ XMVECTOR& outQuaternion, _In_ FLOAT animationTimeTicks, _In_ const aiNodeAnim* pNodeAnim);
         void interpolateScaling(_Inout_ XMFLOAT3& outScale, _In_ FLOAT animationTimeTicks, _In_ const aiNodeAnim* pNodeAnim);
         HRESULT loadDiffuseTexture(
-            _In_ ID3D11Device* pDevice,
-            _In_ ID3D11DeviceContext* pImmediateContext,
+            _In_ RenderDevice* pDevice,
             _In_ const std::filesystem::path& parentDirectory,
             _In_ const aiMaterial* pMaterial,
             _In_ UINT uIndex
         );
         HRESULT loadSpecularTexture(
-            _In_ ID3D11Device* pDevice,
-            _In_ ID3D11DeviceContext* pImmediateContext,
+            _In_ RenderDevice* pDevice,
             _In_ const std::filesystem::path& parentDirectory,
             _In_ const aiMaterial* pMaterial,
             _In_ UINT uIndex
         );
         HRESULT loadNormalTexture(
-            _In_ ID3D11Device* pDevice,
-            _In_ ID3D11DeviceContext* pImmediateContext,
+            _In_ RenderDevice* pDevice,
             _In_ const std::filesystem::path& parentDirectory,
             _In_ const aiMaterial* pMaterial,
             _In_ UINT uIndex
         );
         HRESULT loadTextures(
-            _In_ ID3D11Device* pDevice,
-            _In_ ID3D11DeviceContext* pImmediateContext,
+            _In_ RenderDevice* pDevice,
             _In_ const std::filesystem::path& parentDirectory,
             _In_ const aiMaterial* pMaterial,
             _In_ UINT uIndex
@@ -189,7 +180,6 @@ namespace library
         std::filesystem::path m_filePath;
 
         ComPtr<ID3D11Buffer> m_animationBuffer;
-        ComPtr<ID3D11Buffer> m_skinningConstantBuffer;
 
         std::vector<SimpleVertex> m_aVertices;
         std::vector<AnimationData> m_aAnimationData;
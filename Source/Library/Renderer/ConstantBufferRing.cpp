@@ -0,0 +1,391 @@
+#include "Renderer/ConstantBufferRing.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ConstantBufferRing::ConstantBufferRing
+      Summary:  Constructor
+      Modifies: [m_bOffsets, m_aPages, m_uCurrentPage,
+                 m_aFixedBuffers, m_uNextFixedBuffer, m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ConstantBufferRing::ConstantBufferRing()
+        : m_bOffsets(FALSE)
+        , m_aPages()
+        , m_uCurrentPage(0u)
+        , m_aFixedBuffers()
+        , m_uNextFixedBuffer(0u)
+        , m_stats()
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ConstantBufferRing::Initialize
+      Summary:  Binds from offsets when the device supports it and
+                creates the first page, falls back to fixed constant
+                buffers otherwise
+      Args:     RenderDevice* pDevice
+                  The render device to create the buffers with
+      Modifies: [m_bOffsets, m_aPages, m_uCurrentPage,
+                 m_aFixedBuffers, m_uNextFixedBuffer].
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT ConstantBufferRing::Initialize(_In_ RenderDevice* pDevice)
+    {
+        m_bOffsets = pDevice->SupportsConstantBufferOffsets();
+        m_aPages.clear();
+        m_uCurrentPage = 0u;
+        m_aFixedBuffers.clear();
+        m_uNextFixedBuffer = 0u;
+
+        if (!m_bOffsets)
+        {
+            return S_OK;
+        }
+
+        return createPage(pDevice);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ConstantBufferRing::Begin
+      Summary:  Starts the constants of a frame from the first page,
+                after what the previous frames wrote to it, or from the
+                first fixed buffer
+      Modifies: [m_uCurrentPage, m_uNextFixedBuffer, m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ConstantBufferRing::Begin()
+    {
+        m_uCurrentPage = 0u;
+        m_uNextFixedBuffer = 0u;
+        m_stats = ConstantBufferRingStats();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ConstantBufferRing::Allocate
+      Summary:  Copies constants to the current page, moving on to the
+                next page when it is full, or to the next fixed buffer,
+                and returns their range
+      Args:     RenderDevice* pDevice
+                  The render device to map the pages with
+                const void* pData
+                  Constants to write
+                UINT uSize
+                  Size of the constants, at most a page
+                ConstantBufferRange& outRange
+                  Receives the buffer and range of the constants
+      Modifies: [m_aPages, m_uCurrentPage, m_aFixedBuffers,
+                 m_uNextFixedBuffer, m_stats].
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT ConstantBufferRing::Allocate(_In_ RenderDevice* pDevice, _In_reads_bytes_(uSize) const void* pData, _In_ UINT uSize, _Out_ ConstantBufferRange& outRange)
+    {
+        outRange = ConstantBufferRange();
+
+        if (uSize == 0u || uSize > PAGE_SIZE || (m_bOffsets && m_aPages.empty()))
+        {
+            return E_INVALIDARG;
+        }
+
+        HRESULT hr = S_OK;
+        const UINT uAlignedSize = (uSize + ALIGNMENT - 1u) & ~(ALIGNMENT - 1u);
+
+        if (!m_bOffsets)
+        {
+            return allocateFixed(pDevice, pData, uSize, uAlignedSize, outRange);
+        }
+
+        // A page written this frame can not be discarded, the frame goes on in the next one
+        if (m_aPages[m_uCurrentPage].pMappedData && m_aPages[m_uCurrentPage].uOffset + uAlignedSize > PAGE_SIZE)
+        {
+            ++m_uCurrentPage;
+            if (m_uCurrentPage == m_aPages.size())
+            {
+                hr = createPage(pDevice);
+                if (FAILED(hr))
+                {
+                    return hr;
+                }
+            }
+        }
+
+        Page& page = m_aPages[m_uCurrentPage];
+        if (!page.pMappedData)
+        {
+            // The GPU is done with every range of a page once its fence has passed, nothing needs discarding
+            D3D11_MAP mapType = D3D11_MAP_WRITE_NO_OVERWRITE;
+            if (page.uOffset + uAlignedSize > PAGE_SIZE)
+            {
+                if (!page.bWritten || !hasFencePassed(pDevice, page))
+                {
+                    mapType = D3D11_MAP_WRITE_DISCARD;
+                    ++m_stats.uNumDiscards;
+                }
+                page.uOffset = 0u;
+            }
+
+            D3D11_MAPPED_SUBRESOURCE mappedSubresource;
+            hr = pDevice->Map(page.buffer.Get(), 0u, mapType, 0u, &mappedSubresource);
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+            page.pMappedData = static_cast<BYTE*>(mappedSubresource.pData);
+            page.bWritten = TRUE;
+            ++m_stats.uNumMaps;
+        }
+
+        memcpy(page.pMappedData + page.uOffset, pData, uSize);
+
+        outRange =
+        {
+            .pBuffer = page.buffer.Get(),
+            .uFirstConstant = page.uOffset / 16u,
+            .uNumConstants = uAlignedSize / 16u
+        };
+        page.uOffset += uAlignedSize;
+
+        ++m_stats.uNumAllocations;
+        m_stats.uNumUploadedBytes += uSize;
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ConstantBufferRing::End
+      Summary:  Unmaps the pages written this frame, the ranges can be
+                drawn with afterwards
+      Args:     RenderDevice* pDevice
+                  The render device the pages were mapped with
+      Modifies: [m_aPages].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ConstantBufferRing::End(_In_ RenderDevice* pDevice)
+    {
+        for (Page& page : m_aPages)
+        {
+            if (page.pMappedData)
+            {
+                pDevice->Unmap(page.buffer.Get(), 0u);
+                page.pMappedData = nullptr;
+                page.bFencePending = TRUE;
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ConstantBufferRing::Fence
+      Summary:  Issues the fences of the pages written this frame. It
+                is called once the draws reading the ranges are
+                submitted, so the fences pass only after the GPU has
+                drawn them
+      Args:     RenderDevice* pDevice
+                  The render device the draws were submitted to
+      Modifies: [m_aPages].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void ConstantBufferRing::Fence(_In_ RenderDevice* pDevice)
+    {
+        for (Page& page : m_aPages)
+        {
+            if (page.bFencePending)
+            {
+                pDevice->End(page.fence.Get());
+                page.bFencePending = FALSE;
+                page.bInFlight = TRUE;
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ConstantBufferRing::GetStats
+      Summary:  Returns the work of the ring since the last Begin
+      Returns:  const ConstantBufferRingStats&
+                  Maps, discards, allocations and uploaded bytes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const ConstantBufferRingStats& ConstantBufferRing::GetStats() const
+    {
+        return m_stats;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ConstantBufferRing::GetNumPages
+      Summary:  Returns the number of pages, the most a frame has used
+      Returns:  UINT
+                  Number of pages
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT ConstantBufferRing::GetNumPages() const
+    {
+        return static_cast<UINT>(m_aPages.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ConstantBufferRing::UsesOffsets
+      Summary:  Returns whether the ranges are bound from an offset
+                into shared pages or are whole fixed buffers
+      Returns:  BOOL
+                  TRUE when the device binds constant buffers from an
+                  offset
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL ConstantBufferRing::UsesOffsets() const
+    {
+        return m_bOffsets;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ConstantBufferRing::allocateFixed
+      Summary:  Copies constants to the next fixed constant buffer,
+                created the first time a frame needs it and grown when
+                it is too small. It is mapped with DISCARD and unmapped
+                at once, the buffer the earlier frames drew with is
+                renamed by the driver
+      Args:     RenderDevice* pDevice
+                  The render device to create and map the buffers with
+                const void* pData
+                  Constants to write
+                UINT uSize
+                  Size of the constants
+                UINT uAlignedSize
+                  Size rounded up to the alignment, the size of the
+                  buffer
+                ConstantBufferRange& outRange
+                  Receives the buffer, bound whole
+      Modifies: [m_aFixedBuffers, m_uNextFixedBuffer, m_stats].
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT ConstantBufferRing::allocateFixed(_In_ RenderDevice* pDevice, _In_reads_bytes_(uSize) const void* pData, _In_ UINT uSize, _In_ UINT uAlignedSize, _Out_ ConstantBufferRange& outRange)
+    {
+        if (m_uNextFixedBuffer == m_aFixedBuffers.size())
+        {
+            m_aFixedBuffers.push_back(FixedBuffer{ .buffer = nullptr, .uSize = 0u });
+        }
+
+        HRESULT hr = S_OK;
+        FixedBuffer& fixedBuffer = m_aFixedBuffers[m_uNextFixedBuffer];
+        if (fixedBuffer.uSize < uAlignedSize)
+        {
+            D3D11_BUFFER_DESC bd =
+            {
+                .ByteWidth = uAlignedSize,
+                .Usage = D3D11_USAGE_DYNAMIC,
+                .BindFlags = D3D11_BIND_CONSTANT_BUFFER,
+                .CPUAccessFlags = D3D11_CPU_ACCESS_WRITE
+            };
+
+            fixedBuffer.buffer.Reset();
+            fixedBuffer.uSize = 0u;
+            hr = pDevice->CreateBuffer(&bd, nullptr, fixedBuffer.buffer.GetAddressOf());
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+            fixedBuffer.uSize = uAlignedSize;
+        }
+
+        D3D11_MAPPED_SUBRESOURCE mappedSubresource;
+        hr = pDevice->Map(fixedBuffer.buffer.Get(), 0u, D3D11_MAP_WRITE_DISCARD, 0u, &mappedSubresource);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+        memcpy(mappedSubresource.pData, pData, uSize);
+        pDevice->Unmap(fixedBuffer.buffer.Get(), 0u);
+
+        outRange =
+        {
+            .pBuffer = fixedBuffer.buffer.Get(),
+            .uFirstConstant = 0u,
+            .uNumConstants = fixedBuffer.uSize / 16u
+        };
+        ++m_uNextFixedBuffer;
+
+        ++m_stats.uNumMaps;
+        ++m_stats.uNumDiscards;
+        ++m_stats.uNumAllocations;
+        m_stats.uNumUploadedBytes += uSize;
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ConstantBufferRing::hasFencePassed
+      Summary:  Tells whether the GPU is done with a page: its fence
+                was issued and has passed, checked without flushing the
+                commands
+      Args:     RenderDevice* pDevice
+                  The render device the fence was issued on
+                Page& page
+                  The page, no longer in flight once its fence passed
+      Returns:  BOOL
+                  TRUE if the page can be written from its start
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL ConstantBufferRing::hasFencePassed(_In_ RenderDevice* pDevice, _Inout_ Page& page)
+    {
+        if (page.bFencePending)
+        {
+            return FALSE;
+        }
+
+        if (page.bInFlight)
+        {
+            BOOL bDone = FALSE;
+            if (pDevice->GetData(page.fence.Get(), &bDone, sizeof(bDone), D3D11_ASYNC_GETDATA_DONOTFLUSH) == S_OK && bDone)
+            {
+                page.bInFlight = FALSE;
+            }
+        }
+
+        return !page.bInFlight;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ConstantBufferRing::createPage
+      Summary:  Creates a page and its fence, full so that its first
+                map discards
+      Args:     RenderDevice* pDevice
+                  The render device to create the page with
+      Modifies: [m_aPages].
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT ConstantBufferRing::createPage(_In_ RenderDevice* pDevice)
+    {
+        D3D11_BUFFER_DESC bd =
+        {
+            .ByteWidth = PAGE_SIZE,
+            .Usage = D3D11_USAGE_DYNAMIC,
+            .BindFlags = D3D11_BIND_CONSTANT_BUFFER,
+            .CPUAccessFlags = D3D11_CPU_ACCESS_WRITE
+        };
+
+        Page page =
+        {
+            .buffer = nullptr,
+            .fence = nullptr,
+            .uOffset = PAGE_SIZE,
+            .pMappedData = nullptr,
+            .bFencePending = FALSE,
+            .bInFlight = FALSE,
+            .bWritten = FALSE
+        };
+        HRESULT hr = pDevice->CreateBuffer(&bd, nullptr, page.buffer.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        D3D11_QUERY_DESC queryDesc =
+        {
+            .Query = D3D11_QUERY_EVENT,
+            .MiscFlags = 0u
+        };
+        hr = pDevice->CreateQuery(&queryDesc, page.fence.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        m_aPages.push_back(page);
+
+        return S_OK;
+    }
+}
\ No newline at end of file
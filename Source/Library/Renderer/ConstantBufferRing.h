@@ -0,0 +1,161 @@
+/*+===================================================================
+  File:      CONSTANTBUFFERRING.H
+
+  Summary:   ConstantBufferRing header file contains declarations of
+             ConstantBufferRing class, the dynamic constant buffers the
+             constants of a frame are written to and bound from with
+             an offset, or one by one where offsets are unsupported.
+
+  Classes: ConstantBufferRing
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Renderer/RenderDevice.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   ConstantBufferRange
+
+        Summary:  Constants bound to a slot: the buffer and the range
+                  of it in shader constants of 16 bytes, a null buffer
+                  leaves the slot as it is
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct ConstantBufferRange
+    {
+        ID3D11Buffer* pBuffer;
+        UINT uFirstConstant;
+        UINT uNumConstants;
+
+        bool operator==(const ConstantBufferRange& other) const = default;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   ConstantBufferRingStats
+
+        Summary:  Work of the ring in the last frame: the maps, the
+                  ones discarding a full page, the constants written and
+                  their bytes
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct ConstantBufferRingStats
+    {
+        UINT64 uNumMaps;
+        UINT64 uNumDiscards;
+        UINT64 uNumAllocations;
+        UINT64 uNumUploadedBytes;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    ConstantBufferRing
+
+      Summary:  Pages of dynamic constant buffers shared by the draws
+                of every frame. Each allocation copies the constants
+                after the previous ones, aligned to the 256 bytes a
+                bound range starts and ends at, and returns the range to
+                bind with VSSetConstantBuffers1 / PSSetConstantBuffers1.
+                A page is mapped once a frame, with NO_OVERWRITE while
+                it has room after what earlier frames wrote, which the
+                GPU may still read. When it wraps it is written again
+                from its start with NO_OVERWRITE if its fence has
+                passed, and with DISCARD otherwise. A full page moves
+                the frame on to the next page, so the ranges handed out
+                earlier in the frame stay valid, and new pages are
+                created when a frame needs more of them. Every page is
+                unmapped by End, before the draws, and fenced by Fence,
+                after them.
+                Devices that can not bind from an offset, feature
+                levels 10_0 and 10_1 and the drivers without the
+                Direct3D 11.1 options, get fixed constant buffers
+                instead, chosen by Initialize. Every allocation takes
+                the next of them, maps it with DISCARD and unmaps it at
+                once, and its range starts at the beginning of the
+                buffer, so it is bound whole. The buffers are taken
+                again in the same order the next frame
+
+      Methods:  Initialize
+                  Chooses the binding and creates the first page
+                Begin
+                  Starts the constants of a frame
+                Allocate
+                  Writes constants and returns their range
+                End
+                  Unmaps the pages written this frame
+                Fence
+                  Fences the pages of the frame behind their draws
+                GetStats
+                  Returns the work of the last frame
+                GetNumPages
+                  Returns the number of pages
+                UsesOffsets
+                  Returns whether the ranges are bound from an offset
+                ConstantBufferRing
+                  Constructor.
+                ~ConstantBufferRing
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class ConstantBufferRing
+    {
+    public:
+        static constexpr const UINT PAGE_SIZE = 256u * 1024u;
+
+        // Bound ranges start and span multiples of 16 constants of 16 bytes
+        static constexpr const UINT ALIGNMENT = 256u;
+
+        ConstantBufferRing();
+        ConstantBufferRing(const ConstantBufferRing& other) = delete;
+        ConstantBufferRing(ConstantBufferRing&& other) = delete;
+        ConstantBufferRing& operator=(const ConstantBufferRing& other) = delete;
+        ConstantBufferRing& operator=(ConstantBufferRing&& other) = delete;
+        ~ConstantBufferRing() = default;
+
+        HRESULT Initialize(_In_ RenderDevice* pDevice);
+        void Begin();
+        HRESULT Allocate(_In_ RenderDevice* pDevice, _In_reads_bytes_(uSize) const void* pData, _In_ UINT uSize, _Out_ ConstantBufferRange& outRange);
+        void End(_In_ RenderDevice* pDevice);
+        void Fence(_In_ RenderDevice* pDevice);
+
+        template <class T>
+        HRESULT Allocate(_In_ RenderDevice* pDevice, _In_ const T& constants, _Out_ ConstantBufferRange& outRange)
+        {
+            return Allocate(pDevice, &constants, sizeof(T), outRange);
+        }
+
+        const ConstantBufferRingStats& GetStats() const;
+        UINT GetNumPages() const;
+        BOOL UsesOffsets() const;
+
+    private:
+        struct Page
+        {
+            ComPtr<ID3D11Buffer> buffer;
+            ComPtr<ID3D11Query> fence;
+            UINT uOffset;
+            BYTE* pMappedData;
+            BOOL bFencePending;
+            BOOL bInFlight;
+            BOOL bWritten;
+        };
+
+        struct FixedBuffer
+        {
+            ComPtr<ID3D11Buffer> buffer;
+            UINT uSize;
+        };
+
+        HRESULT allocateFixed(_In_ RenderDevice* pDevice, _In_reads_bytes_(uSize) const void* pData, _In_ UINT uSize, _In_ UINT uAlignedSize, _Out_ ConstantBufferRange& outRange);
+        BOOL hasFencePassed(_In_ RenderDevice* pDevice, _Inout_ Page& page);
+        HRESULT createPage(_In_ RenderDevice* pDevice);
+
+    private:
+        BOOL m_bOffsets;
+        std::vector<Page> m_aPages;
+        UINT m_uCurrentPage;
+        std::vector<FixedBuffer> m_aFixedBuffers;
+        UINT m_uNextFixedBuffer;
+        ConstantBufferRingStats m_stats;
+    };
+}
\ No newline at end of file
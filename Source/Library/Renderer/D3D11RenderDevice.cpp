@@ -0,0 +1,417 @@
+#include "Renderer/D3D11RenderDevice.h"
+
+#include "Texture/DDSTextureLoader.h"
+#include "Texture/WICTextureLoader.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderDevice::D3D11RenderDevice
+      Summary:  Constructor, checks whether the context binds
+                constant buffers from an offset and maps them without
+                overwriting
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device
+                ID3D11DeviceContext* pImmediateContext
+                  Its immediate context
+      Modifies: [m_device, m_immediateContext, m_immediateContext1,
+                 m_bConstantBufferOffsets].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    D3D11RenderDevice::D3D11RenderDevice(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext)
+        : m_device(pDevice)
+        , m_immediateContext(pImmediateContext)
+        , m_immediateContext1()
+        , m_bConstantBufferOffsets(FALSE)
+    {
+        D3D11_FEATURE_DATA_D3D11_OPTIONS options = {};
+        if (SUCCEEDED(m_immediateContext.As(&m_immediateContext1))
+            && SUCCEEDED(m_device->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof(options))))
+        {
+            m_bConstantBufferOffsets = options.ConstantBufferOffsetting && options.MapNoOverwriteOnDynamicConstantBuffer;
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderDevice::GetDevice
+      Summary:  Returns the Direct3D device
+      Returns:  ID3D11Device*
+                  The device
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ID3D11Device* D3D11RenderDevice::GetDevice() const
+    {
+        return m_device.Get();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderDevice::GetImmediateContext
+      Summary:  Returns the immediate context
+      Returns:  ID3D11DeviceContext*
+                  The immediate context
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ID3D11DeviceContext* D3D11RenderDevice::GetImmediateContext() const
+    {
+        return m_immediateContext.Get();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderDevice::CreateBuffer
+      Summary:  Forwards to ID3D11Device::CreateBuffer
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT D3D11RenderDevice::CreateBuffer(_In_ const D3D11_BUFFER_DESC* pDesc, _In_opt_ const D3D11_SUBRESOURCE_DATA* pInitialData, _Out_ ID3D11Buffer** ppBuffer)
+    {
+        return m_device->CreateBuffer(pDesc, pInitialData, ppBuffer);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderDevice::CreateTexture2D
+      Summary:  Forwards to ID3D11Device::CreateTexture2D
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT D3D11RenderDevice::CreateTexture2D(_In_ const D3D11_TEXTURE2D_DESC* pDesc, _In_opt_ const D3D11_SUBRESOURCE_DATA* pInitialData, _Out_ ID3D11Texture2D** ppTexture2D)
+    {
+        return m_device->CreateTexture2D(pDesc, pInitialData, ppTexture2D);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderDevice::CreateTextureFromFile
+      Summary:  Loads a texture with the WIC loader, which also
+                generates its mip chain, or with the DDS loader
+      Args:     const std::filesystem::path& filePath
+                  Path to the texture
+                ID3D11ShaderResourceView** ppTextureView
+                  Receives the view of the texture
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT D3D11RenderDevice::CreateTextureFromFile(_In_ const std::filesystem::path& filePath, _Out_ ID3D11ShaderResourceView** ppTextureView)
+    {
+        HRESULT hr = CreateWICTextureFromFile(m_device.Get(), m_immediateContext.Get(), filePath.c_str(), nullptr, ppTextureView);
+        if (FAILED(hr))
+        {
+            hr = CreateDDSTextureFromFile(m_device.Get(), filePath.c_str(), nullptr, ppTextureView);
+        }
+
+        return hr;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderDevice::CreateShaderResourceView
+      Summary:  Forwards to ID3D11Device::CreateShaderResourceView
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT D3D11RenderDevice::CreateShaderResourceView(_In_ ID3D11Resource* pResource, _In_opt_ const D3D11_SHADER_RESOURCE_VIEW_DESC* pDesc, _Out_ ID3D11ShaderResourceView** ppView)
+    {
+        return m_device->CreateShaderResourceView(pResource, pDesc, ppView);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderDevice::CreateRenderTargetView
+      Summary:  Forwards to ID3D11Device::CreateRenderTargetView
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT D3D11RenderDevice::CreateRenderTargetView(_In_ ID3D11Resource* pResource, _In_opt_ const D3D11_RENDER_TARGET_VIEW_DESC* pDesc, _Out_ ID3D11RenderTargetView** ppView)
+    {
+        return m_device->CreateRenderTargetView(pResource, pDesc, ppView);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderDevice::CreateDepthStencilView
+      Summary:  Forwards to ID3D11Device::CreateDepthStencilView
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT D3D11RenderDevice::CreateDepthStencilView(_In_ ID3D11Resource* pResource, _In_opt_ const D3D11_DEPTH_STENCIL_VIEW_DESC* pDesc, _Out_ ID3D11DepthStencilView** ppView)
+    {
+        return m_device->CreateDepthStencilView(pResource, pDesc, ppView);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderDevice::CreateSamplerState
+      Summary:  Forwards to ID3D11Device::CreateSamplerState
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT D3D11RenderDevice::CreateSamplerState(_In_ const D3D11_SAMPLER_DESC* pDesc, _Out_ ID3D11SamplerState** ppSamplerState)
+    {
+        return m_device->CreateSamplerState(pDesc, ppSamplerState);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderDevice::CompileShader
+      Summary:  Compiles the shader file with the HLSL compiler
+      Args:     PCWSTR pszFileName
+                  Name of the file that contains the shader code
+                PCSTR pszEntryPoint
+                  Name of the shader entry point function
+                PCSTR pszShaderModel
+                  Shader target to compile against
+                UINT uFlags
+                  D3DCOMPILE flags
+                ID3DBlob** ppCode
+                  Receives the compiled code
+                ID3DBlob** ppErrorMessages
+                  Receives the compiler messages, may be null
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT D3D11RenderDevice::CompileShader(_In_ PCWSTR pszFileName, _In_ PCSTR pszEntryPoint, _In_ PCSTR pszShaderModel, _In_ UINT uFlags, _Outptr_ ID3DBlob** ppCode, _Outptr_opt_result_maybenull_ ID3DBlob** ppErrorMessages)
+    {
+        return D3DCompileFromFile(pszFileName, nullptr, nullptr, pszEntryPoint, pszShaderModel, uFlags, 0u, ppCode, ppErrorMessages);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderDevice::CreateInputLayout
+      Summary:  Forwards to ID3D11Device::CreateInputLayout
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT D3D11RenderDevice::CreateInputLayout(_In_reads_(uNumElements) const D3D11_INPUT_ELEMENT_DESC* pInputElementDescs, _In_ UINT uNumElements, _In_ const void* pShaderBytecode, _In_ SIZE_T bytecodeLength, _Out_ ID3D11InputLayout** ppInputLayout)
+    {
+        return m_device->CreateInputLayout(pInputElementDescs, uNumElements, pShaderBytecode, bytecodeLength, ppInputLayout);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderDevice::CreateVertexShader
+      Summary:  Forwards to ID3D11Device::CreateVertexShader
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT D3D11RenderDevice::CreateVertexShader(_In_ const void* pShaderBytecode, _In_ SIZE_T bytecodeLength, _Out_ ID3D11VertexShader** ppVertexShader)
+    {
+        return m_device->CreateVertexShader(pShaderBytecode, bytecodeLength, nullptr, ppVertexShader);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderDevice::CreatePixelShader
+      Summary:  Forwards to ID3D11Device::CreatePixelShader
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT D3D11RenderDevice::CreatePixelShader(_In_ const void* pShaderBytecode, _In_ SIZE_T bytecodeLength, _Out_ ID3D11PixelShader** ppPixelShader)
+    {
+        return m_device->CreatePixelShader(pShaderBytecode, bytecodeLength, nullptr, ppPixelShader);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderDevice::CreateQuery
+      Summary:  Forwards to ID3D11Device::CreateQuery
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT D3D11RenderDevice::CreateQuery(_In_ const D3D11_QUERY_DESC* pQueryDesc, _Out_ ID3D11Query** ppQuery)
+    {
+        return m_device->CreateQuery(pQueryDesc, ppQuery);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderDevice::SupportsConstantBufferOffsets
+      Summary:  Returns whether the context has the Direct3D 11.1
+                interface and the driver binds constant buffers from an
+                offset and maps them with NO_OVERWRITE
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL D3D11RenderDevice::SupportsConstantBufferOffsets() const
+    {
+        return m_bConstantBufferOffsets;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderDevice::UpdateSubresource
+      Summary:  Forwards to ID3D11DeviceContext::UpdateSubresource
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderDevice::UpdateSubresource(_In_ ID3D11Resource* pDstResource, _In_ UINT uDstSubresource, _In_opt_ const D3D11_BOX* pDstBox, _In_ const void* pSrcData, _In_ UINT uSrcRowPitch, _In_ UINT uSrcDepthPitch)
+    {
+        m_immediateContext->UpdateSubresource(pDstResource, uDstSubresource, pDstBox, pSrcData, uSrcRowPitch, uSrcDepthPitch);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderDevice::Map
+      Summary:  Forwards to ID3D11DeviceContext::Map
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT D3D11RenderDevice::Map(_In_ ID3D11Resource* pResource, _In_ UINT uSubresource, _In_ D3D11_MAP mapType, _In_ UINT uMapFlags, _Out_ D3D11_MAPPED_SUBRESOURCE* pMappedResource)
+    {
+        return m_immediateContext->Map(pResource, uSubresource, mapType, uMapFlags, pMappedResource);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderDevice::Unmap
+      Summary:  Forwards to ID3D11DeviceContext::Unmap
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderDevice::Unmap(_In_ ID3D11Resource* pResource, _In_ UINT uSubresource)
+    {
+        m_immediateContext->Unmap(pResource, uSubresource);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderDevice::End
+      Summary:  Forwards to ID3D11DeviceContext::End
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderDevice::End(_In_ ID3D11Asynchronous* pAsync)
+    {
+        m_immediateContext->End(pAsync);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderDevice::GetData
+      Summary:  Forwards to ID3D11DeviceContext::GetData
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT D3D11RenderDevice::GetData(_In_ ID3D11Asynchronous* pAsync, _Out_writes_bytes_opt_(uDataSize) void* pData, _In_ UINT uDataSize, _In_ UINT uGetDataFlags)
+    {
+        return m_immediateContext->GetData(pAsync, pData, uDataSize, uGetDataFlags);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderDevice::IASetVertexBuffers
+      Summary:  Forwards to ID3D11DeviceContext::IASetVertexBuffers
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderDevice::IASetVertexBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_(uNumBuffers) ID3D11Buffer* const* ppVertexBuffers, _In_reads_(uNumBuffers) const UINT* pStrides, _In_reads_(uNumBuffers) const UINT* pOffsets)
+    {
+        m_immediateContext->IASetVertexBuffers(uStartSlot, uNumBuffers, ppVertexBuffers, pStrides, pOffsets);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderDevice::IASetIndexBuffer
+      Summary:  Forwards to ID3D11DeviceContext::IASetIndexBuffer
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderDevice::IASetIndexBuffer(_In_opt_ ID3D11Buffer* pIndexBuffer, _In_ DXGI_FORMAT format, _In_ UINT uOffset)
+    {
+        m_immediateContext->IASetIndexBuffer(pIndexBuffer, format, uOffset);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderDevice::IASetInputLayout
+      Summary:  Forwards to ID3D11DeviceContext::IASetInputLayout
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderDevice::IASetInputLayout(_In_opt_ ID3D11InputLayout* pInputLayout)
+    {
+        m_immediateContext->IASetInputLayout(pInputLayout);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderDevice::IASetPrimitiveTopology
+      Summary:  Forwards to ID3D11DeviceContext::IASetPrimitiveTopology
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderDevice::IASetPrimitiveTopology(_In_ D3D11_PRIMITIVE_TOPOLOGY topology)
+    {
+        m_immediateContext->IASetPrimitiveTopology(topology);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderDevice::VSSetShader
+      Summary:  Forwards to ID3D11DeviceContext::VSSetShader
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderDevice::VSSetShader(_In_opt_ ID3D11VertexShader* pVertexShader)
+    {
+        m_immediateContext->VSSetShader(pVertexShader, nullptr, 0);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderDevice::VSSetConstantBuffers
+      Summary:  Forwards to ID3D11DeviceContext::VSSetConstantBuffers
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderDevice::VSSetConstantBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers)
+    {
+        m_immediateContext->VSSetConstantBuffers(uStartSlot, uNumBuffers, ppConstantBuffers);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderDevice::VSSetConstantBuffers1
+      Summary:  Forwards to ID3D11DeviceContext1::VSSetConstantBuffers1
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderDevice::VSSetConstantBuffers1(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers, _In_reads_(uNumBuffers) const UINT* pFirstConstant, _In_reads_(uNumBuffers) const UINT* pNumConstants)
+    {
+        m_immediateContext1->VSSetConstantBuffers1(uStartSlot, uNumBuffers, ppConstantBuffers, pFirstConstant, pNumConstants);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderDevice::VSSetShaderResources
+      Summary:  Forwards to ID3D11DeviceContext::VSSetShaderResources
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderDevice::VSSetShaderResources(_In_ UINT uStartSlot, _In_ UINT uNumViews, _In_reads_(uNumViews) ID3D11ShaderResourceView* const* ppShaderResourceViews)
+    {
+        m_immediateContext->VSSetShaderResources(uStartSlot, uNumViews, ppShaderResourceViews);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderDevice::PSSetShader
+      Summary:  Forwards to ID3D11DeviceContext::PSSetShader
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderDevice::PSSetShader(_In_opt_ ID3D11PixelShader* pPixelShader)
+    {
+        m_immediateContext->PSSetShader(pPixelShader, nullptr, 0);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderDevice::PSSetConstantBuffers
+      Summary:  Forwards to ID3D11DeviceContext::PSSetConstantBuffers
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderDevice::PSSetConstantBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers)
+    {
+        m_immediateContext->PSSetConstantBuffers(uStartSlot, uNumBuffers, ppConstantBuffers);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderDevice::PSSetConstantBuffers1
+      Summary:  Forwards to ID3D11DeviceContext1::PSSetConstantBuffers1
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderDevice::PSSetConstantBuffers1(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers, _In_reads_(uNumBuffers) const UINT* pFirstConstant, _In_reads_(uNumBuffers) const UINT* pNumConstants)
+    {
+        m_immediateContext1->PSSetConstantBuffers1(uStartSlot, uNumBuffers, ppConstantBuffers, pFirstConstant, pNumConstants);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderDevice::PSSetShaderResources
+      Summary:  Forwards to ID3D11DeviceContext::PSSetShaderResources
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderDevice::PSSetShaderResources(_In_ UINT uStartSlot, _In_ UINT uNumViews, _In_reads_(uNumViews) ID3D11ShaderResourceView* const* ppShaderResourceViews)
+    {
+        m_immediateContext->PSSetShaderResources(uStartSlot, uNumViews, ppShaderResourceViews);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderDevice::PSSetSamplers
+      Summary:  Forwards to ID3D11DeviceContext::PSSetSamplers
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderDevice::PSSetSamplers(_In_ UINT uStartSlot, _In_ UINT uNumSamplers, _In_reads_(uNumSamplers) ID3D11SamplerState* const* ppSamplers)
+    {
+        m_immediateContext->PSSetSamplers(uStartSlot, uNumSamplers, ppSamplers);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderDevice::OMSetRenderTargets
+      Summary:  Forwards to ID3D11DeviceContext::OMSetRenderTargets
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderDevice::OMSetRenderTargets(_In_ UINT uNumViews, _In_reads_opt_(uNumViews) ID3D11RenderTargetView* const* ppRenderTargetViews, _In_opt_ ID3D11DepthStencilView* pDepthStencilView)
+    {
+        m_immediateContext->OMSetRenderTargets(uNumViews, ppRenderTargetViews, pDepthStencilView);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderDevice::RSSetViewports
+      Summary:  Forwards to ID3D11DeviceContext::RSSetViewports
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderDevice::RSSetViewports(_In_ UINT uNumViewports, _In_reads_(uNumViewports) const D3D11_VIEWPORT* pViewports)
+    {
+        m_immediateContext->RSSetViewports(uNumViewports, pViewports);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderDevice::ClearRenderTargetView
+      Summary:  Forwards to ID3D11DeviceContext::ClearRenderTargetView
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderDevice::ClearRenderTargetView(_In_ ID3D11RenderTargetView* pRenderTargetView, _In_ const FLOAT aColorRGBA[4])
+    {
+        m_immediateContext->ClearRenderTargetView(pRenderTargetView, aColorRGBA);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderDevice::ClearDepthStencilView
+      Summary:  Forwards to ID3D11DeviceContext::ClearDepthStencilView
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderDevice::ClearDepthStencilView(_In_ ID3D11DepthStencilView* pDepthStencilView, _In_ UINT uClearFlags, _In_ FLOAT depth, _In_ UINT8 stencil)
+    {
+        m_immediateContext->ClearDepthStencilView(pDepthStencilView, uClearFlags, depth, stencil);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderDevice::DrawIndexed
+      Summary:  Forwards to ID3D11DeviceContext::DrawIndexed
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderDevice::DrawIndexed(_In_ UINT uIndexCount, _In_ UINT uStartIndexLocation, _In_ INT baseVertexLocation)
+    {
+        m_immediateContext->DrawIndexed(uIndexCount, uStartIndexLocation, baseVertexLocation);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   D3D11RenderDevice::DrawIndexedInstanced
+      Summary:  Forwards to ID3D11DeviceContext::DrawIndexedInstanced
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void D3D11RenderDevice::DrawIndexedInstanced(_In_ UINT uIndexCountPerInstance, _In_ UINT uInstanceCount, _In_ UINT uStartIndexLocation, _In_ INT baseVertexLocation, _In_ UINT uStartInstanceLocation)
+    {
+        m_immediateContext->DrawIndexedInstanced(uIndexCountPerInstance, uInstanceCount, uStartIndexLocation, baseVertexLocation, uStartInstanceLocation);
+    }
+}
\ No newline at end of file
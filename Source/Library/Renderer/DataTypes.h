@@ -7,6 +7,7 @@ namespace library
 #define NUM_LIGHTS (1)
 #define MAX_NUM_BONES (256)
 #define MAX_NUM_BONES_PER_VERTEX (16)
+#define MAX_NUM_TERRAIN_LEVELS (16)
 
 	struct SimpleVertex
 	{
@@ -20,6 +21,33 @@ namespace library
 		XMMATRIX Transformation;
 	};
 
+	// Grid coordinates of an axis-aligned block and its type, for instances that are only translated
+	struct CompactInstanceData
+	{
+		USHORT X;
+		USHORT Y;
+		USHORT Z;
+		USHORT BlockType;
+	};
+
+	// Grid cell of a column of blocks from BaseY up to TopY excluded, for instances stretched along the y axis
+	struct ColumnInstanceData
+	{
+		USHORT X;
+		USHORT BaseY;
+		USHORT Z;
+		USHORT TopY;
+	};
+
+	// Column of the corner of a smooth terrain patch, its vertices are 2^Level columns apart
+	struct TerrainPatchData
+	{
+		UINT X;
+		UINT Z;
+		UINT Level;
+		UINT Padding;
+	};
+
 	struct AnimationData
 	{
 		XMUINT4 aBoneIndices;
@@ -62,6 +90,14 @@ namespace library
 		XMFLOAT4 LightAttenuationDistance[NUM_LIGHTS];
 	};
 
+	// Origin is the bottom of the column (0, 0), a morph range is the start of the morph and one over its length
+	struct CBTerrain
+	{
+		XMFLOAT4 Origin;
+		XMFLOAT4 MorphRanges[MAX_NUM_TERRAIN_LEVELS];
+		XMUINT4 MapSize;
+	};
+
 	struct CBShadowMatrix
 	{
 		XMMATRIX World;
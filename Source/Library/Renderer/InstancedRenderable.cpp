@@ -1,7 +1,26 @@
 #include "Renderer/InstancedRenderable.h"
 
+#include <algorithm>
+
 namespace library
 {
+    namespace
+    {
+        // Dirty instances closer than this are uploaded together, a few more bytes cost less than another call
+        constexpr const UINT INSTANCE_UPLOAD_MAX_GAP_BYTES = 256u;
+
+        // Moves the last instance into the removed one, returns the index it had
+        template <class T>
+        UINT swapRemove(_Inout_ std::vector<T>& aInstanceData, _In_ UINT uIndex)
+        {
+            UINT uLastIndex = static_cast<UINT>(aInstanceData.size()) - 1u;
+            aInstanceData[uIndex] = aInstanceData[uLastIndex];
+            aInstanceData.pop_back();
+
+            return uLastIndex;
+        }
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   InstancedRenderable::InstancedRenderable
 
@@ -11,7 +30,7 @@ namespace library
                   Default color of the renderable
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     InstancedRenderable::InstancedRenderable(_In_ const XMFLOAT4& outputColor)
-        :Renderable(outputColor), m_padding()
+        :Renderable(outputColor), m_instanceFormat(eInstanceFormat::MATRIX), m_uInstanceCapacity(0u), m_bInstanceDataReset(TRUE), m_padding()
     {}
     
 
@@ -26,14 +45,42 @@ namespace library
                 const XMFLOAT4& outputColor
                   Default color of the renderable
 
-      Modifies: [m_instanceBuffer, m_aInstanceData].
+      Modifies: [m_instanceBuffer, m_aInstanceData, m_instanceFormat,
+                 m_uInstanceCapacity, m_bInstanceDataReset].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     InstancedRenderable::InstancedRenderable
     (_In_ std::vector<InstanceData>&& aInstanceData, _In_ const XMFLOAT4& outputColor)
         : Renderable(outputColor),
-        m_padding(), 
         m_instanceBuffer(nullptr),
-        m_aInstanceData(std::move(aInstanceData)) {}
+        m_aInstanceData(std::move(aInstanceData)),
+        m_instanceFormat(eInstanceFormat::MATRIX),
+        m_uInstanceCapacity(0u),
+        m_bInstanceDataReset(TRUE),
+        m_padding() {}
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstancedRenderable::GetInstanceStride
+
+      Summary:  Returns the size of one instance in the given format
+
+      Args:     eInstanceFormat instanceFormat
+                  Format of the instance buffer
+
+      Returns:  UINT
+                  Stride of the instance buffer
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT InstancedRenderable::GetInstanceStride(_In_ eInstanceFormat instanceFormat)
+    {
+        switch (instanceFormat)
+        {
+        case eInstanceFormat::COMPACT:
+            return sizeof(CompactInstanceData);
+        case eInstanceFormat::COLUMN:
+            return sizeof(ColumnInstanceData);
+        default:
+            return sizeof(InstanceData);
+        }
+    }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   InstancedRenderable::SetInstanceData
@@ -43,11 +90,329 @@ namespace library
       Args:     std::vector<InstanceData>&& aInstanceData
                   Instance data
 
-      Modifies: [m_aInstanceData].
+      Modifies: [m_aInstanceData, m_auDirtyInstances,
+                 m_bInstanceDataReset].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     void InstancedRenderable::SetInstanceData(_In_ std::vector<InstanceData>&& aInstanceData) 
     {
         m_aInstanceData = std::move(aInstanceData);
+        m_aCompactInstanceData.clear();
+        m_aColumnInstanceData.clear();
+        m_instanceFormat = eInstanceFormat::MATRIX;
+
+        // Every instance may have changed, the next update uploads them all
+        m_auDirtyInstances.clear();
+        m_bInstanceDataReset = TRUE;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstancedRenderable::SetCompactInstanceData
+
+      Summary:  Sets the instance data in the compact format. Each
+                instance is translated by twice its grid coordinates,
+                the rest of the placement comes from the world matrix
+
+      Args:     std::vector<CompactInstanceData>&& aInstanceData
+                  Instance data
+
+      Modifies: [m_aInstanceData, m_aCompactInstanceData,
+                 m_aColumnInstanceData, m_instanceFormat,
+                 m_auDirtyInstances, m_bInstanceDataReset].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void InstancedRenderable::SetCompactInstanceData(_In_ std::vector<CompactInstanceData>&& aInstanceData)
+    {
+        m_aCompactInstanceData = std::move(aInstanceData);
+        m_aInstanceData.clear();
+        m_aColumnInstanceData.clear();
+        m_instanceFormat = eInstanceFormat::COMPACT;
+
+        m_auDirtyInstances.clear();
+        m_bInstanceDataReset = TRUE;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstancedRenderable::SetColumnInstanceData
+
+      Summary:  Sets the instance data in the column format. Each
+                instance stretches the mesh over the blocks
+                [BaseY, TopY) of its grid cell, the rest of the
+                placement comes from the world matrix
+
+      Args:     std::vector<ColumnInstanceData>&& aInstanceData
+                  Instance data
+
+      Modifies: [m_aInstanceData, m_aCompactInstanceData,
+                 m_aColumnInstanceData, m_instanceFormat,
+                 m_auDirtyInstances, m_bInstanceDataReset].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void InstancedRenderable::SetColumnInstanceData(_In_ std::vector<ColumnInstanceData>&& aInstanceData)
+    {
+        m_aColumnInstanceData = std::move(aInstanceData);
+        m_aInstanceData.clear();
+        m_aCompactInstanceData.clear();
+        m_instanceFormat = eInstanceFormat::COLUMN;
+
+        m_auDirtyInstances.clear();
+        m_bInstanceDataReset = TRUE;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstancedRenderable::AddInstance
+
+      Summary:  Appends an instance in the matrix format, uploaded by
+                the next UpdateInstanceBuffer
+
+      Args:     const InstanceData& instanceData
+                  Instance data
+
+      Modifies: [m_aInstanceData, m_auDirtyInstances].
+
+      Returns:  UINT
+                  Index of the new instance
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT InstancedRenderable::AddInstance(_In_ const InstanceData& instanceData)
+    {
+        m_aInstanceData.push_back(instanceData);
+
+        UINT uIndex = static_cast<UINT>(m_aInstanceData.size()) - 1u;
+        m_auDirtyInstances.push_back(uIndex);
+
+        return uIndex;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstancedRenderable::AddInstance
+
+      Summary:  Appends an instance in the compact format, uploaded by
+                the next UpdateInstanceBuffer
+
+      Args:     const CompactInstanceData& instanceData
+                  Instance data
+
+      Modifies: [m_aCompactInstanceData, m_auDirtyInstances].
+
+      Returns:  UINT
+                  Index of the new instance
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT InstancedRenderable::AddInstance(_In_ const CompactInstanceData& instanceData)
+    {
+        m_aCompactInstanceData.push_back(instanceData);
+
+        UINT uIndex = static_cast<UINT>(m_aCompactInstanceData.size()) - 1u;
+        m_auDirtyInstances.push_back(uIndex);
+
+        return uIndex;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstancedRenderable::AddInstance
+
+      Summary:  Appends an instance in the column format, uploaded by
+                the next UpdateInstanceBuffer
+
+      Args:     const ColumnInstanceData& instanceData
+                  Instance data
+
+      Modifies: [m_aColumnInstanceData, m_auDirtyInstances].
+
+      Returns:  UINT
+                  Index of the new instance
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT InstancedRenderable::AddInstance(_In_ const ColumnInstanceData& instanceData)
+    {
+        m_aColumnInstanceData.push_back(instanceData);
+
+        UINT uIndex = static_cast<UINT>(m_aColumnInstanceData.size()) - 1u;
+        m_auDirtyInstances.push_back(uIndex);
+
+        return uIndex;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstancedRenderable::RemoveInstance
+
+      Summary:  Removes an instance by moving the last instance into
+                its place, so only that one instance is uploaded again.
+                The order of the instances is not kept
+
+      Args:     UINT uIndex
+                  Index of the removed instance
+
+      Modifies: [m_aInstanceData, m_aCompactInstanceData,
+                 m_aColumnInstanceData, m_auDirtyInstances].
+
+      Returns:  UINT
+                  Former index of the instance moved to uIndex, uIndex
+                  itself when the last instance was removed
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT InstancedRenderable::RemoveInstance(_In_ UINT uIndex)
+    {
+        UINT uMovedIndex = uIndex;
+        switch (m_instanceFormat)
+        {
+        case eInstanceFormat::COMPACT:
+            uMovedIndex = swapRemove(m_aCompactInstanceData, uIndex);
+            break;
+        case eInstanceFormat::COLUMN:
+            uMovedIndex = swapRemove(m_aColumnInstanceData, uIndex);
+            break;
+        default:
+            uMovedIndex = swapRemove(m_aInstanceData, uIndex);
+            break;
+        }
+
+        if (uMovedIndex != uIndex)
+        {
+            m_auDirtyInstances.push_back(uIndex);
+        }
+
+        return uMovedIndex;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstancedRenderable::BuildDirtyRanges
+
+      Summary:  Sorts the instances changed since the last upload and
+                merges them into ranges, closing the gaps of up to
+                INSTANCE_UPLOAD_MAX_GAP_BYTES. Instances removed since
+                are not uploaded. Everything is one range after the
+                instance data was set
+
+      Args:     std::vector<InstanceRange>& aOutRanges
+                  Ranges to upload, in increasing order
+
+      Modifies: [m_auDirtyInstances].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void InstancedRenderable::BuildDirtyRanges(_Out_ std::vector<InstanceRange>& aOutRanges)
+    {
+        aOutRanges.clear();
+
+        UINT uNumInstances = GetNumInstances();
+        if (m_bInstanceDataReset)
+        {
+            if (uNumInstances > 0u)
+            {
+                aOutRanges.push_back(InstanceRange{ .uFirst = 0u, .uCount = uNumInstances });
+            }
+            return;
+        }
+
+        std::sort(m_auDirtyInstances.begin(), m_auDirtyInstances.end());
+        m_auDirtyInstances.erase(std::unique(m_auDirtyInstances.begin(), m_auDirtyInstances.end()), m_auDirtyInstances.end());
+
+        UINT uMaxGap = std::max(INSTANCE_UPLOAD_MAX_GAP_BYTES / GetInstanceStride(), 1u);
+        for (UINT uIndex : m_auDirtyInstances)
+        {
+            if (uIndex >= uNumInstances)
+            {
+                break;
+            }
+
+            if (!aOutRanges.empty() && uIndex <= aOutRanges.back().uFirst + aOutRanges.back().uCount + uMaxGap)
+            {
+                aOutRanges.back().uCount = uIndex + 1u - aOutRanges.back().uFirst;
+                continue;
+            }
+
+            aOutRanges.push_back(InstanceRange{ .uFirst = uIndex, .uCount = 1u });
+        }
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstancedRenderable::ClearDirtyInstances
+
+      Summary:  Forgets the changed instances, once they are uploaded
+
+      Modifies: [m_auDirtyInstances, m_bInstanceDataReset].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void InstancedRenderable::ClearDirtyInstances()
+    {
+        m_auDirtyInstances.clear();
+        m_bInstanceDataReset = FALSE;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstancedRenderable::UpdateInstanceBuffer
+
+      Summary:  Uploads the instances changed since the last update,
+                one UpdateSubresource with a destination box per dirty
+                range. The buffer is created again, half as large
+                again as needed, when the instances outgrow it. Called
+                once per frame so that every edit of the frame goes up
+                in the same batch
+
+      Args:     RenderDevice* pDevice
+                  The render device to upload the instances with
+
+      Modifies: [m_instanceBuffer, m_uInstanceCapacity,
+                 m_auDirtyInstances, m_bInstanceDataReset].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT InstancedRenderable::UpdateInstanceBuffer(_In_ RenderDevice* pDevice)
+    {
+        // Not created yet, initializeInstance uploads everything
+        if (!m_instanceBuffer)
+        {
+            return S_OK;
+        }
+
+        if (GetNumInstances() > m_uInstanceCapacity)
+        {
+            D3D11_BUFFER_DESC bd =
+            {
+                .ByteWidth = std::max(GetNumInstances(), m_uInstanceCapacity + m_uInstanceCapacity / 2u) * GetInstanceStride(),
+                .Usage = D3D11_USAGE_DEFAULT,
+                .BindFlags = D3D11_BIND_VERTEX_BUFFER,
+                .CPUAccessFlags = 0u,
+                .MiscFlags = 0u,
+                .StructureByteStride = 0u
+            };
+
+            ComPtr<ID3D11Buffer> instanceBuffer;
+            HRESULT hr = pDevice->CreateBuffer(&bd, nullptr, instanceBuffer.GetAddressOf());
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+
+            m_instanceBuffer = instanceBuffer;
+            m_uInstanceCapacity = bd.ByteWidth / GetInstanceStride();
+            m_bInstanceDataReset = TRUE;
+        }
+
+        const BYTE* pInstanceData = reinterpret_cast<const BYTE*>(getInstanceData());
+
+        std::vector<InstanceRange> aRanges;
+        BuildDirtyRanges(aRanges);
+        for (const InstanceRange& range : aRanges)
+        {
+            D3D11_BOX box =
+            {
+                .left = range.uFirst * GetInstanceStride(),
+                .top = 0u,
+                .front = 0u,
+                .right = (range.uFirst + range.uCount) * GetInstanceStride(),
+                .bottom = 1u,
+                .back = 1u
+            };
+
+            pDevice->UpdateSubresource(m_instanceBuffer.Get(), 0u, &box, pInstanceData + box.left, 0u, 0u);
+        }
+
+        ClearDirtyInstances();
+
+        return S_OK;
     }
 
 
@@ -75,27 +440,117 @@ namespace library
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     UINT InstancedRenderable::GetNumInstances() const 
     {
-        return m_aInstanceData.size();
+        switch (m_instanceFormat)
+        {
+        case eInstanceFormat::COMPACT:
+            return static_cast<UINT>(m_aCompactInstanceData.size());
+        case eInstanceFormat::COLUMN:
+            return static_cast<UINT>(m_aColumnInstanceData.size());
+        default:
+            return static_cast<UINT>(m_aInstanceData.size());
+        }
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstancedRenderable::GetInstanceData
+
+      Summary:  Returns the instance data in the matrix format, empty
+                in the other formats
+
+      Returns:  const std::vector<InstanceData>&
+                  Instance data
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const std::vector<InstanceData>& InstancedRenderable::GetInstanceData() const
+    {
+        return m_aInstanceData;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstancedRenderable::GetCompactInstanceData
+
+      Summary:  Returns the instance data in the compact format, empty
+                in the other formats
+
+      Returns:  const std::vector<CompactInstanceData>&
+                  Instance data
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const std::vector<CompactInstanceData>& InstancedRenderable::GetCompactInstanceData() const
+    {
+        return m_aCompactInstanceData;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstancedRenderable::GetColumnInstanceData
+
+      Summary:  Returns the instance data in the column format, empty
+                in the other formats
+
+      Returns:  const std::vector<ColumnInstanceData>&
+                  Instance data
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const std::vector<ColumnInstanceData>& InstancedRenderable::GetColumnInstanceData() const
+    {
+        return m_aColumnInstanceData;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstancedRenderable::GetInstanceFormat
+
+      Summary:  Returns the format of the instance buffer
+
+      Returns:  eInstanceFormat
+                  Instance format
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    eInstanceFormat InstancedRenderable::GetInstanceFormat() const
+    {
+        return m_instanceFormat;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstancedRenderable::GetInstanceStride
+
+      Summary:  Returns the size of one instance, the stride to bind
+                the instance buffer with
+
+      Returns:  UINT
+                  Stride of the instance buffer
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT InstancedRenderable::GetInstanceStride() const
+    {
+        return GetInstanceStride(m_instanceFormat);
     }
 
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   InstancedRenderable::initializeInstance
 
-      Summary:  Creates an instance buffer
+      Summary:  Creates an instance buffer from the instance data in
+                the current format. The buffer is updated in place by
+                UpdateInstanceBuffer afterwards
 
-      Args:     ID3D11Device* pDevice
-                  Pointer to a Direct3D 11 device
+      Args:     RenderDevice* pDevice
+                  The render device
 
-      Modifies: [m_instanceBuffer].
+      Modifies: [m_instanceBuffer, m_uInstanceCapacity,
+                 m_auDirtyInstances, m_bInstanceDataReset].
 
       Returns:  HRESULT
                   Status code
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    HRESULT InstancedRenderable::initializeInstance(_In_ ID3D11Device* pDevice) 
+    HRESULT InstancedRenderable::initializeInstance(_In_ RenderDevice* pDevice) 
     {
+        if (GetNumInstances() == 0u)
+        {
+            return E_FAIL;
+        }
+
         D3D11_BUFFER_DESC bd;
-        bd.ByteWidth = m_aInstanceData.size() * sizeof(InstanceData);
+        bd.ByteWidth = GetNumInstances() * GetInstanceStride();
         bd.Usage = D3D11_USAGE_DEFAULT;
         bd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
         bd.CPUAccessFlags = 0;
@@ -104,7 +559,7 @@ namespace library
 
         D3D11_SUBRESOURCE_DATA initData = 
         {
-            .pSysMem = &m_aInstanceData[0],
+            .pSysMem = getInstanceData(),
             .SysMemPitch = 0,
             .SysMemSlicePitch = 0
         };
@@ -116,6 +571,33 @@ namespace library
             return hr;
         }
 
+        m_uInstanceCapacity = GetNumInstances();
+        ClearDirtyInstances();
+
+        return S_OK;
+    }
+
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   InstancedRenderable::getInstanceData
+
+      Summary:  Returns the instance data of the current format, laid
+                out as the instance buffer
+
+      Returns:  const void*
+                  Pointer to the first instance
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const void* InstancedRenderable::getInstanceData() const
+    {
+        switch (m_instanceFormat)
+        {
+        case eInstanceFormat::COMPACT:
+            return m_aCompactInstanceData.data();
+        case eInstanceFormat::COLUMN:
+            return m_aColumnInstanceData.data();
+        default:
+            return m_aInstanceData.data();
+        }
     }
 
 }
@@ -18,6 +18,36 @@
 
 namespace library
 {
+    /*E+E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E
+        Enum:     eInstanceFormat
+
+        Summary:  Enumeration of instance buffer formats. MATRIX
+                  stores a full transformation per instance, COMPACT
+                  stores the 16-bit grid coordinates and the block type
+                  of an axis-aligned block in 8 bytes, COLUMN stores
+                  the grid cell and the base and top heights of a
+                  whole column of blocks in 8 bytes
+    E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E-E*/
+    enum class eInstanceFormat
+    {
+        MATRIX,
+        COMPACT,
+        COLUMN,
+        COUNT,
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   InstanceRange
+
+        Summary:  Instances [uFirst, uFirst + uCount) of the instance
+                  buffer, uploaded with one UpdateSubresource
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct InstanceRange
+    {
+        UINT uFirst;
+        UINT uCount;
+    };
+
     /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
       Class:    InstancedRenderable
 
@@ -25,12 +55,38 @@ namespace library
 
       Methods:  SetInstanceData
                   Sets the instance data
+                SetCompactInstanceData
+                  Sets the instance data in the compact format
+                SetColumnInstanceData
+                  Sets the instance data in the column format
+                AddInstance
+                  Appends an instance and marks it dirty
+                RemoveInstance
+                  Moves the last instance into the removed one
+                BuildDirtyRanges
+                  Merges the dirty instances into ranges to upload
+                ClearDirtyInstances
+                  Forgets the dirty instances once uploaded
+                UpdateInstanceBuffer
+                  Uploads the dirty ranges of the instance buffer
                 GetInstanceBuffer
                   Returns a instance buffer
                 GetNumInstances
                   Returns the number of instance data
+                GetInstanceData
+                  Returns the instance data in the matrix format
+                GetCompactInstanceData
+                  Returns the instance data in the compact format
+                GetColumnInstanceData
+                  Returns the instance data in the column format
+                GetInstanceFormat
+                  Returns the format of the instance buffer
+                GetInstanceStride
+                  Returns the size of one instance
                 initializeInstance
                   Initialize the instance buffer
+                getInstanceData
+                  Returns the instance data of the current format
                 InstancedRenderable
                   Constructor.
                 ~InstancedRenderable
@@ -47,13 +103,30 @@ namespace library
         InstancedRenderable& operator=(InstancedRenderable&& other) = delete;
         ~InstancedRenderable() = default;
 
-        virtual HRESULT Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext) override = 0;
+        virtual HRESULT Initialize(_In_ RenderDevice* pDevice) override = 0;
         virtual void Update(_In_ FLOAT deltaTime) override = 0;
 
+        static UINT GetInstanceStride(_In_ eInstanceFormat instanceFormat);
+
         void SetInstanceData(_In_ std::vector<InstanceData>&& aInstanceData);
+        void SetCompactInstanceData(_In_ std::vector<CompactInstanceData>&& aInstanceData);
+        void SetColumnInstanceData(_In_ std::vector<ColumnInstanceData>&& aInstanceData);
+
+        UINT AddInstance(_In_ const InstanceData& instanceData);
+        UINT AddInstance(_In_ const CompactInstanceData& instanceData);
+        UINT AddInstance(_In_ const ColumnInstanceData& instanceData);
+        UINT RemoveInstance(_In_ UINT uIndex);
+        void BuildDirtyRanges(_Out_ std::vector<InstanceRange>& aOutRanges);
+        void ClearDirtyInstances();
+        HRESULT UpdateInstanceBuffer(_In_ RenderDevice* pDevice);
 
         virtual ComPtr<ID3D11Buffer>& GetInstanceBuffer();
         virtual UINT GetNumInstances() const;
+        const std::vector<InstanceData>& GetInstanceData() const;
+        const std::vector<CompactInstanceData>& GetCompactInstanceData() const;
+        const std::vector<ColumnInstanceData>& GetColumnInstanceData() const;
+        eInstanceFormat GetInstanceFormat() const;
+        UINT GetInstanceStride() const;
 
         UINT GetNumVertices() const override = 0;
         UINT GetNumIndices() const override = 0;
@@ -62,11 +135,18 @@ namespace library
         const SimpleVertex* getVertices() const override = 0;
         const WORD* getIndices() const override = 0;
 
-        virtual HRESULT initializeInstance(_In_ ID3D11Device* pDevice);
+        virtual HRESULT initializeInstance(_In_ RenderDevice* pDevice);
+        const void* getInstanceData() const;
 
     protected:
         ComPtr<ID3D11Buffer> m_instanceBuffer;
         std::vector<InstanceData> m_aInstanceData;
+        std::vector<CompactInstanceData> m_aCompactInstanceData;
+        std::vector<ColumnInstanceData> m_aColumnInstanceData;
+        eInstanceFormat m_instanceFormat;
+        UINT m_uInstanceCapacity;
+        std::vector<UINT> m_auDirtyInstances;
+        BOOL m_bInstanceDataReset;
 
     private:
         BYTE m_padding[8];
@@ -0,0 +1,1099 @@
+#include "Renderer/NullRenderDevice.h"
+
+namespace library
+{
+    namespace
+    {
+        /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+          Class:    NullDeviceChild
+
+          Summary:  Reference counted placeholder of a device child, the
+                    object the null device hands out for T
+        C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+        template <class T>
+        class NullDeviceChild : public T
+        {
+        public:
+            NullDeviceChild() = default;
+            virtual ~NullDeviceChild() = default;
+
+            HRESULT STDMETHODCALLTYPE QueryInterface(REFIID, void** ppvObject) override
+            {
+                if (ppvObject)
+                {
+                    *ppvObject = nullptr;
+                }
+                return E_NOINTERFACE;
+            }
+
+            ULONG STDMETHODCALLTYPE AddRef() override
+            {
+                return ++m_uRefCount;
+            }
+
+            ULONG STDMETHODCALLTYPE Release() override
+            {
+                ULONG uRefCount = --m_uRefCount;
+                if (uRefCount == 0u)
+                {
+                    delete this;
+                }
+                return uRefCount;
+            }
+
+            void STDMETHODCALLTYPE GetDevice(ID3D11Device** ppDevice) override
+            {
+                *ppDevice = nullptr;
+            }
+
+            HRESULT STDMETHODCALLTYPE GetPrivateData(REFGUID, UINT* pDataSize, void*) override
+            {
+                if (pDataSize)
+                {
+                    *pDataSize = 0u;
+                }
+                return DXGI_ERROR_NOT_FOUND;
+            }
+
+            HRESULT STDMETHODCALLTYPE SetPrivateData(REFGUID, UINT, const void*) override
+            {
+                return S_OK;
+            }
+
+            HRESULT STDMETHODCALLTYPE SetPrivateDataInterface(REFGUID, const IUnknown*) override
+            {
+                return S_OK;
+            }
+
+        private:
+            std::atomic<ULONG> m_uRefCount = 1u;
+        };
+
+        /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+          Class:    NullResource
+
+          Summary:  Placeholder of a resource of the given dimension
+        C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+        template <class T, D3D11_RESOURCE_DIMENSION Dimension>
+        class NullResource : public NullDeviceChild<T>
+        {
+        public:
+            void STDMETHODCALLTYPE GetType(D3D11_RESOURCE_DIMENSION* pResourceDimension) override
+            {
+                *pResourceDimension = Dimension;
+            }
+
+            void STDMETHODCALLTYPE SetEvictionPriority(UINT uEvictionPriority) override
+            {
+                m_uEvictionPriority = uEvictionPriority;
+            }
+
+            UINT STDMETHODCALLTYPE GetEvictionPriority() override
+            {
+                return m_uEvictionPriority;
+            }
+
+        private:
+            UINT m_uEvictionPriority = 0u;
+        };
+
+        /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+          Class:    NullBuffer
+
+          Summary:  Placeholder of a buffer, keeps the memory that Map
+                    hands out
+        C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+        class NullBuffer final : public NullResource<ID3D11Buffer, D3D11_RESOURCE_DIMENSION_BUFFER>
+        {
+        public:
+            explicit NullBuffer(_In_ const D3D11_BUFFER_DESC& desc)
+                : m_desc(desc)
+                , m_aMemory(desc.ByteWidth)
+            { }
+
+            void STDMETHODCALLTYPE GetDesc(D3D11_BUFFER_DESC* pDesc) override
+            {
+                *pDesc = m_desc;
+            }
+
+            BYTE* GetMemory()
+            {
+                return m_aMemory.data();
+            }
+
+        private:
+            D3D11_BUFFER_DESC m_desc;
+            std::vector<BYTE> m_aMemory;
+        };
+
+        /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+          Class:    NullTexture2D
+
+          Summary:  Placeholder of a 2D texture
+        C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+        class NullTexture2D final : public NullResource<ID3D11Texture2D, D3D11_RESOURCE_DIMENSION_TEXTURE2D>
+        {
+        public:
+            explicit NullTexture2D(_In_ const D3D11_TEXTURE2D_DESC& desc)
+                : m_desc(desc)
+            { }
+
+            void STDMETHODCALLTYPE GetDesc(D3D11_TEXTURE2D_DESC* pDesc) override
+            {
+                *pDesc = m_desc;
+            }
+
+        private:
+            D3D11_TEXTURE2D_DESC m_desc;
+        };
+
+        /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+          Class:    NullView
+
+          Summary:  Placeholder of a view, holds its resource
+        C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+        template <class T, class Desc>
+        class NullView final : public NullDeviceChild<T>
+        {
+        public:
+            NullView(_In_opt_ ID3D11Resource* pResource, _In_opt_ const Desc* pDesc)
+                : m_resource(pResource)
+                , m_desc(pDesc ? *pDesc : Desc{})
+            { }
+
+            void STDMETHODCALLTYPE GetResource(ID3D11Resource** ppResource) override
+            {
+                *ppResource = m_resource.Get();
+                if (*ppResource)
+                {
+                    (*ppResource)->AddRef();
+                }
+            }
+
+            void STDMETHODCALLTYPE GetDesc(Desc* pDesc) override
+            {
+                *pDesc = m_desc;
+            }
+
+        private:
+            ComPtr<ID3D11Resource> m_resource;
+            Desc m_desc;
+        };
+
+        /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+          Class:    NullSamplerState
+
+          Summary:  Placeholder of a sampler
+        C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+        class NullSamplerState final : public NullDeviceChild<ID3D11SamplerState>
+        {
+        public:
+            explicit NullSamplerState(_In_ const D3D11_SAMPLER_DESC& desc)
+                : m_desc(desc)
+            { }
+
+            void STDMETHODCALLTYPE GetDesc(D3D11_SAMPLER_DESC* pDesc) override
+            {
+                *pDesc = m_desc;
+            }
+
+        private:
+            D3D11_SAMPLER_DESC m_desc;
+        };
+
+        /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+          Class:    NullQuery
+
+          Summary:  Placeholder of a query, done as soon as it is issued
+        C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+        class NullQuery final : public NullDeviceChild<ID3D11Query>
+        {
+        public:
+            explicit NullQuery(_In_ const D3D11_QUERY_DESC& desc)
+                : m_desc(desc)
+            { }
+
+            UINT STDMETHODCALLTYPE GetDataSize() override
+            {
+                return m_desc.Query == D3D11_QUERY_EVENT ? sizeof(BOOL) : 0u;
+            }
+
+            void STDMETHODCALLTYPE GetDesc(D3D11_QUERY_DESC* pDesc) override
+            {
+                *pDesc = m_desc;
+            }
+
+        private:
+            D3D11_QUERY_DESC m_desc;
+        };
+
+        /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+          Class:    NullBlob
+
+          Summary:  Placeholder of compiled shader code, holds the name
+                    of the entry point so that it is never empty
+        C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+        class NullBlob final : public ID3DBlob
+        {
+        public:
+            explicit NullBlob(_In_ PCSTR pszEntryPoint)
+                : m_aBytes(pszEntryPoint, pszEntryPoint + strlen(pszEntryPoint) + 1u)
+            { }
+            virtual ~NullBlob() = default;
+
+            HRESULT STDMETHODCALLTYPE QueryInterface(REFIID, void** ppvObject) override
+            {
+                if (ppvObject)
+                {
+                    *ppvObject = nullptr;
+                }
+                return E_NOINTERFACE;
+            }
+
+            ULONG STDMETHODCALLTYPE AddRef() override
+            {
+                return ++m_uRefCount;
+            }
+
+            ULONG STDMETHODCALLTYPE Release() override
+            {
+                ULONG uRefCount = --m_uRefCount;
+                if (uRefCount == 0u)
+                {
+                    delete this;
+                }
+                return uRefCount;
+            }
+
+            LPVOID STDMETHODCALLTYPE GetBufferPointer() override
+            {
+                return m_aBytes.data();
+            }
+
+            SIZE_T STDMETHODCALLTYPE GetBufferSize() override
+            {
+                return m_aBytes.size();
+            }
+
+        private:
+            std::vector<char> m_aBytes;
+            std::atomic<ULONG> m_uRefCount = 1u;
+        };
+
+        // Size of the placeholder texture a file load creates
+        constexpr const UINT FILE_TEXTURE_SIZE = 1u;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderDevice::NullRenderDevice
+      Summary:  Constructor
+      Modifies: [m_uNumCreationCalls, m_uNumCreatedResources,
+                 m_uNumInitialBytes, m_uNumContextCalls, m_uNumUploads,
+                 m_uNumUploadedBytes, m_uNumStateChanges, m_uNumDraws,
+                 m_uNumDrawnIndices].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    NullRenderDevice::NullRenderDevice()
+        : m_uNumCreationCalls(0u)
+        , m_uNumCreatedResources(0u)
+        , m_uNumInitialBytes(0u)
+        , m_uNumContextCalls(0u)
+        , m_uNumUploads(0u)
+        , m_uNumUploadedBytes(0u)
+        , m_uNumStateChanges(0u)
+        , m_uNumDraws(0u)
+        , m_uNumDrawnIndices(0u)
+    { }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderDevice::GetStats
+      Summary:  Returns the counters since the construction or the last
+                reset
+      Returns:  RenderDeviceStats
+                  Counters
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    RenderDeviceStats NullRenderDevice::GetStats() const
+    {
+        return RenderDeviceStats
+        {
+            .uNumCalls = m_uNumCreationCalls + m_uNumContextCalls,
+            .uNumCreatedResources = m_uNumCreatedResources,
+            .uNumInitialBytes = m_uNumInitialBytes,
+            .uNumUploads = m_uNumUploads,
+            .uNumUploadedBytes = m_uNumUploadedBytes,
+            .uNumStateChanges = m_uNumStateChanges,
+            .uNumDraws = m_uNumDraws,
+            .uNumDrawnIndices = m_uNumDrawnIndices
+        };
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderDevice::ResetStats
+      Summary:  Resets the counters, between the initialization and the
+                frames or between frames
+      Modifies: [m_uNumCreationCalls, m_uNumCreatedResources,
+                 m_uNumInitialBytes, m_uNumContextCalls, m_uNumUploads,
+                 m_uNumUploadedBytes, m_uNumStateChanges, m_uNumDraws,
+                 m_uNumDrawnIndices].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void NullRenderDevice::ResetStats()
+    {
+        m_uNumCreationCalls = 0u;
+        m_uNumCreatedResources = 0u;
+        m_uNumInitialBytes = 0u;
+        m_uNumContextCalls = 0u;
+        m_uNumUploads = 0u;
+        m_uNumUploadedBytes = 0u;
+        m_uNumStateChanges = 0u;
+        m_uNumDraws = 0u;
+        m_uNumDrawnIndices = 0u;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderDevice::CreateBuffer
+      Summary:  Creates a placeholder buffer with the initial data
+      Args:     const D3D11_BUFFER_DESC* pDesc
+                  Description of the buffer
+                const D3D11_SUBRESOURCE_DATA* pInitialData
+                  Initial data, may be null
+                ID3D11Buffer** ppBuffer
+                  Receives the buffer
+      Modifies: [m_uNumCreationCalls, m_uNumCreatedResources,
+                 m_uNumInitialBytes].
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT NullRenderDevice::CreateBuffer(_In_ const D3D11_BUFFER_DESC* pDesc, _In_opt_ const D3D11_SUBRESOURCE_DATA* pInitialData, _Out_ ID3D11Buffer** ppBuffer)
+    {
+        if (!pDesc || !ppBuffer || pDesc->ByteWidth == 0u)
+        {
+            return E_INVALIDARG;
+        }
+
+        NullBuffer* pBuffer = new NullBuffer(*pDesc);
+        if (pInitialData && pInitialData->pSysMem)
+        {
+            memcpy(pBuffer->GetMemory(), pInitialData->pSysMem, pDesc->ByteWidth);
+        }
+        *ppBuffer = pBuffer;
+
+        recordCreation(pInitialData ? pDesc->ByteWidth : 0u);
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderDevice::CreateTexture2D
+      Summary:  Creates a placeholder texture, counting the rows of the
+                initial data of every subresource
+      Args:     const D3D11_TEXTURE2D_DESC* pDesc
+                  Description of the texture
+                const D3D11_SUBRESOURCE_DATA* pInitialData
+                  Initial data of every subresource, may be null
+                ID3D11Texture2D** ppTexture2D
+                  Receives the texture
+      Modifies: [m_uNumCreationCalls, m_uNumCreatedResources,
+                 m_uNumInitialBytes].
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT NullRenderDevice::CreateTexture2D(_In_ const D3D11_TEXTURE2D_DESC* pDesc, _In_opt_ const D3D11_SUBRESOURCE_DATA* pInitialData, _Out_ ID3D11Texture2D** ppTexture2D)
+    {
+        if (!pDesc || !ppTexture2D || pDesc->Width == 0u || pDesc->Height == 0u)
+        {
+            return E_INVALIDARG;
+        }
+
+        UINT64 uNumInitialBytes = 0u;
+        if (pInitialData)
+        {
+            UINT uNumMipLevels = std::max(pDesc->MipLevels, 1u);
+            for (UINT uSlice = 0u; uSlice < std::max(pDesc->ArraySize, 1u); ++uSlice)
+            {
+                for (UINT uMip = 0u; uMip < uNumMipLevels; ++uMip)
+                {
+                    UINT uNumRows = std::max(pDesc->Height >> uMip, 1u);
+                    uNumInitialBytes += static_cast<UINT64>(pInitialData[uSlice * uNumMipLevels + uMip].SysMemPitch) * uNumRows;
+                }
+            }
+        }
+
+        *ppTexture2D = new NullTexture2D(*pDesc);
+
+        recordCreation(uNumInitialBytes);
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderDevice::CreateTextureFromFile
+      Summary:  Creates a placeholder texture and its view without
+                reading the file, the measurements do not depend on the
+                art on disk
+      Args:     const std::filesystem::path& filePath
+                  Path to the texture
+                ID3D11ShaderResourceView** ppTextureView
+                  Receives the view of the texture
+      Modifies: [m_uNumCreationCalls, m_uNumCreatedResources].
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT NullRenderDevice::CreateTextureFromFile(_In_ const std::filesystem::path& filePath, _Out_ ID3D11ShaderResourceView** ppTextureView)
+    {
+        if (filePath.empty() || !ppTextureView)
+        {
+            return E_INVALIDARG;
+        }
+
+        D3D11_TEXTURE2D_DESC desc =
+        {
+            .Width = FILE_TEXTURE_SIZE,
+            .Height = FILE_TEXTURE_SIZE,
+            .MipLevels = 1u,
+            .ArraySize = 1u,
+            .Format = DXGI_FORMAT_R8G8B8A8_UNORM,
+            .SampleDesc = {.Count = 1u, .Quality = 0u },
+            .Usage = D3D11_USAGE_DEFAULT,
+            .BindFlags = D3D11_BIND_SHADER_RESOURCE,
+            .CPUAccessFlags = 0u,
+            .MiscFlags = 0u
+        };
+        ComPtr<ID3D11Texture2D> texture;
+        HRESULT hr = CreateTexture2D(&desc, nullptr, texture.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        return CreateShaderResourceView(texture.Get(), nullptr, ppTextureView);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderDevice::CreateShaderResourceView
+      Summary:  Creates a placeholder view of the resource
+      Args:     ID3D11Resource* pResource
+                  Viewed resource
+                const D3D11_SHADER_RESOURCE_VIEW_DESC* pDesc
+                  Description of the view, may be null
+                ID3D11ShaderResourceView** ppView
+                  Receives the view
+      Modifies: [m_uNumCreationCalls, m_uNumCreatedResources].
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT NullRenderDevice::CreateShaderResourceView(_In_ ID3D11Resource* pResource, _In_opt_ const D3D11_SHADER_RESOURCE_VIEW_DESC* pDesc, _Out_ ID3D11ShaderResourceView** ppView)
+    {
+        if (!pResource || !ppView)
+        {
+            return E_INVALIDARG;
+        }
+
+        *ppView = new NullView<ID3D11ShaderResourceView, D3D11_SHADER_RESOURCE_VIEW_DESC>(pResource, pDesc);
+
+        recordCreation(0u);
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderDevice::CreateRenderTargetView
+      Summary:  Creates a placeholder render target view
+      Args:     ID3D11Resource* pResource
+                  Viewed resource
+                const D3D11_RENDER_TARGET_VIEW_DESC* pDesc
+                  Description of the view, may be null
+                ID3D11RenderTargetView** ppView
+                  Receives the view
+      Modifies: [m_uNumCreationCalls, m_uNumCreatedResources].
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT NullRenderDevice::CreateRenderTargetView(_In_ ID3D11Resource* pResource, _In_opt_ const D3D11_RENDER_TARGET_VIEW_DESC* pDesc, _Out_ ID3D11RenderTargetView** ppView)
+    {
+        if (!pResource || !ppView)
+        {
+            return E_INVALIDARG;
+        }
+
+        *ppView = new NullView<ID3D11RenderTargetView, D3D11_RENDER_TARGET_VIEW_DESC>(pResource, pDesc);
+
+        recordCreation(0u);
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderDevice::CreateDepthStencilView
+      Summary:  Creates a placeholder depth stencil view
+      Args:     ID3D11Resource* pResource
+                  Viewed resource
+                const D3D11_DEPTH_STENCIL_VIEW_DESC* pDesc
+                  Description of the view, may be null
+                ID3D11DepthStencilView** ppView
+                  Receives the view
+      Modifies: [m_uNumCreationCalls, m_uNumCreatedResources].
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT NullRenderDevice::CreateDepthStencilView(_In_ ID3D11Resource* pResource, _In_opt_ const D3D11_DEPTH_STENCIL_VIEW_DESC* pDesc, _Out_ ID3D11DepthStencilView** ppView)
+    {
+        if (!pResource || !ppView)
+        {
+            return E_INVALIDARG;
+        }
+
+        *ppView = new NullView<ID3D11DepthStencilView, D3D11_DEPTH_STENCIL_VIEW_DESC>(pResource, pDesc);
+
+        recordCreation(0u);
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderDevice::CreateSamplerState
+      Summary:  Creates a placeholder sampler
+      Args:     const D3D11_SAMPLER_DESC* pDesc
+                  Description of the sampler
+                ID3D11SamplerState** ppSamplerState
+                  Receives the sampler
+      Modifies: [m_uNumCreationCalls, m_uNumCreatedResources].
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT NullRenderDevice::CreateSamplerState(_In_ const D3D11_SAMPLER_DESC* pDesc, _Out_ ID3D11SamplerState** ppSamplerState)
+    {
+        if (!pDesc || !ppSamplerState)
+        {
+            return E_INVALIDARG;
+        }
+
+        *ppSamplerState = new NullSamplerState(*pDesc);
+
+        recordCreation(0u);
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderDevice::CompileShader
+      Summary:  Hands out placeholder code without reading the file, so
+                that no shader compiler is needed
+      Args:     PCWSTR pszFileName
+                  Name of the file that contains the shader code
+                PCSTR pszEntryPoint
+                  Name of the shader entry point function
+                PCSTR pszShaderModel
+                  Shader target to compile against
+                UINT uFlags
+                  D3DCOMPILE flags
+                ID3DBlob** ppCode
+                  Receives the placeholder code
+                ID3DBlob** ppErrorMessages
+                  Receives null, may be null
+      Modifies: [m_uNumCreationCalls].
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT NullRenderDevice::CompileShader(_In_ PCWSTR pszFileName, _In_ PCSTR pszEntryPoint, _In_ PCSTR pszShaderModel, _In_ UINT, _Outptr_ ID3DBlob** ppCode, _Outptr_opt_result_maybenull_ ID3DBlob** ppErrorMessages)
+    {
+        ++m_uNumCreationCalls;
+
+        if (ppErrorMessages)
+        {
+            *ppErrorMessages = nullptr;
+        }
+        if (!pszFileName || !pszEntryPoint || !pszShaderModel || !ppCode)
+        {
+            return E_INVALIDARG;
+        }
+
+        *ppCode = new NullBlob(pszEntryPoint);
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderDevice::CreateInputLayout
+      Summary:  Creates a placeholder input layout
+      Args:     const D3D11_INPUT_ELEMENT_DESC* pInputElementDescs
+                  Elements of the layout
+                UINT uNumElements
+                  Number of elements
+                const void* pShaderBytecode
+                  Compiled vertex shader
+                SIZE_T bytecodeLength
+                  Size of the compiled vertex shader
+                ID3D11InputLayout** ppInputLayout
+                  Receives the layout
+      Modifies: [m_uNumCreationCalls, m_uNumCreatedResources].
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT NullRenderDevice::CreateInputLayout(_In_reads_(uNumElements) const D3D11_INPUT_ELEMENT_DESC* pInputElementDescs, _In_ UINT uNumElements, _In_ const void* pShaderBytecode, _In_ SIZE_T bytecodeLength, _Out_ ID3D11InputLayout** ppInputLayout)
+    {
+        if (!pInputElementDescs || uNumElements == 0u || !pShaderBytecode || bytecodeLength == 0u || !ppInputLayout)
+        {
+            return E_INVALIDARG;
+        }
+
+        *ppInputLayout = new NullDeviceChild<ID3D11InputLayout>();
+
+        recordCreation(0u);
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderDevice::CreateVertexShader
+      Summary:  Creates a placeholder vertex shader
+      Args:     const void* pShaderBytecode
+                  Compiled shader
+                SIZE_T bytecodeLength
+                  Size of the compiled shader
+                ID3D11VertexShader** ppVertexShader
+                  Receives the shader
+      Modifies: [m_uNumCreationCalls, m_uNumCreatedResources].
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT NullRenderDevice::CreateVertexShader(_In_ const void* pShaderBytecode, _In_ SIZE_T bytecodeLength, _Out_ ID3D11VertexShader** ppVertexShader)
+    {
+        if (!pShaderBytecode || bytecodeLength == 0u || !ppVertexShader)
+        {
+            return E_INVALIDARG;
+        }
+
+        *ppVertexShader = new NullDeviceChild<ID3D11VertexShader>();
+
+        recordCreation(0u);
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderDevice::CreatePixelShader
+      Summary:  Creates a placeholder pixel shader
+      Args:     const void* pShaderBytecode
+                  Compiled shader
+                SIZE_T bytecodeLength
+                  Size of the compiled shader
+                ID3D11PixelShader** ppPixelShader
+                  Receives the shader
+      Modifies: [m_uNumCreationCalls, m_uNumCreatedResources].
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT NullRenderDevice::CreatePixelShader(_In_ const void* pShaderBytecode, _In_ SIZE_T bytecodeLength, _Out_ ID3D11PixelShader** ppPixelShader)
+    {
+        if (!pShaderBytecode || bytecodeLength == 0u || !ppPixelShader)
+        {
+            return E_INVALIDARG;
+        }
+
+        *ppPixelShader = new NullDeviceChild<ID3D11PixelShader>();
+
+        recordCreation(0u);
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderDevice::CreateQuery
+      Summary:  Creates a placeholder query, only event queries are
+                supported
+      Args:     const D3D11_QUERY_DESC* pQueryDesc
+                  Description of the query
+                ID3D11Query** ppQuery
+                  Receives the query
+      Modifies: [m_uNumCreationCalls, m_uNumCreatedResources].
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT NullRenderDevice::CreateQuery(_In_ const D3D11_QUERY_DESC* pQueryDesc, _Out_ ID3D11Query** ppQuery)
+    {
+        if (!pQueryDesc || !ppQuery || pQueryDesc->Query != D3D11_QUERY_EVENT)
+        {
+            return E_INVALIDARG;
+        }
+
+        *ppQuery = new NullQuery(*pQueryDesc);
+
+        recordCreation(0u);
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderDevice::SupportsConstantBufferOffsets
+      Summary:  Returns TRUE, the null device binds whatever it is given
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL NullRenderDevice::SupportsConstantBufferOffsets() const
+    {
+        return TRUE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderDevice::UpdateSubresource
+      Summary:  Counts an upload, the bytes of the box or of the whole
+                buffer, or the rows of the texture
+      Args:     ID3D11Resource* pDstResource
+                  Updated resource
+                UINT uDstSubresource
+                  Updated subresource
+                const D3D11_BOX* pDstBox
+                  Updated region, null for all of it
+                const void* pSrcData
+                  Uploaded data
+                UINT uSrcRowPitch
+                  Bytes of one row of the data
+                UINT uSrcDepthPitch
+                  Bytes of one slice of the data
+      Modifies: [m_uNumContextCalls, m_uNumUploads, m_uNumUploadedBytes].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void NullRenderDevice::UpdateSubresource(_In_ ID3D11Resource* pDstResource, _In_ UINT uDstSubresource, _In_opt_ const D3D11_BOX* pDstBox, _In_ const void* pSrcData, _In_ UINT uSrcRowPitch, _In_ UINT)
+    {
+        ++m_uNumContextCalls;
+        ++m_uNumUploads;
+
+        D3D11_RESOURCE_DIMENSION dimension = D3D11_RESOURCE_DIMENSION_UNKNOWN;
+        pDstResource->GetType(&dimension);
+        if (dimension == D3D11_RESOURCE_DIMENSION_BUFFER)
+        {
+            NullBuffer* pBuffer = static_cast<NullBuffer*>(static_cast<ID3D11Buffer*>(pDstResource));
+            D3D11_BUFFER_DESC desc;
+            pBuffer->GetDesc(&desc);
+
+            UINT uOffset = pDstBox ? pDstBox->left : 0u;
+            UINT uNumBytes = pDstBox ? pDstBox->right - pDstBox->left : desc.ByteWidth;
+            memcpy(pBuffer->GetMemory() + uOffset, pSrcData, uNumBytes);
+            m_uNumUploadedBytes += uNumBytes;
+        }
+        else if (dimension == D3D11_RESOURCE_DIMENSION_TEXTURE2D)
+        {
+            D3D11_TEXTURE2D_DESC desc;
+            static_cast<ID3D11Texture2D*>(pDstResource)->GetDesc(&desc);
+
+            UINT uMip = uDstSubresource % std::max(desc.MipLevels, 1u);
+            UINT uNumRows = pDstBox ? pDstBox->bottom - pDstBox->top : std::max(desc.Height >> uMip, 1u);
+            m_uNumUploadedBytes += static_cast<UINT64>(uSrcRowPitch) * uNumRows;
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderDevice::Map
+      Summary:  Hands out the memory of a buffer, counting an upload of
+                all of it
+      Args:     ID3D11Resource* pResource
+                  Mapped resource, only buffers are mapped
+                UINT uSubresource
+                  Mapped subresource
+                D3D11_MAP mapType
+                  Access to the memory
+                UINT uMapFlags
+                  Map flags
+                D3D11_MAPPED_SUBRESOURCE* pMappedResource
+                  Receives the memory
+      Modifies: [m_uNumContextCalls, m_uNumUploads, m_uNumUploadedBytes].
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT NullRenderDevice::Map(_In_ ID3D11Resource* pResource, _In_ UINT, _In_ D3D11_MAP, _In_ UINT, _Out_ D3D11_MAPPED_SUBRESOURCE* pMappedResource)
+    {
+        ++m_uNumContextCalls;
+
+        D3D11_RESOURCE_DIMENSION dimension = D3D11_RESOURCE_DIMENSION_UNKNOWN;
+        pResource->GetType(&dimension);
+        if (dimension != D3D11_RESOURCE_DIMENSION_BUFFER)
+        {
+            return E_INVALIDARG;
+        }
+
+        NullBuffer* pBuffer = static_cast<NullBuffer*>(static_cast<ID3D11Buffer*>(pResource));
+        D3D11_BUFFER_DESC desc;
+        pBuffer->GetDesc(&desc);
+
+        *pMappedResource =
+        {
+            .pData = pBuffer->GetMemory(),
+            .RowPitch = desc.ByteWidth,
+            .DepthPitch = desc.ByteWidth
+        };
+
+        ++m_uNumUploads;
+        m_uNumUploadedBytes += desc.ByteWidth;
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderDevice::Unmap
+      Summary:  Counts the call
+      Modifies: [m_uNumContextCalls].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void NullRenderDevice::Unmap(_In_ ID3D11Resource*, _In_ UINT)
+    {
+        ++m_uNumContextCalls;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderDevice::End
+      Summary:  Counts the call
+      Modifies: [m_uNumContextCalls].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void NullRenderDevice::End(_In_ ID3D11Asynchronous*)
+    {
+        ++m_uNumContextCalls;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderDevice::GetData
+      Summary:  Counts the call, an event query has always passed as
+                nothing is ever queued
+      Args:     ID3D11Asynchronous* pAsync
+                  Issued query
+                void* pData
+                  Receives TRUE, may be null
+                UINT uDataSize
+                  Size of the result
+                UINT uGetDataFlags
+                  Flags of the read
+      Modifies: [m_uNumContextCalls].
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT NullRenderDevice::GetData(_In_ ID3D11Asynchronous* pAsync, _Out_writes_bytes_opt_(uDataSize) void* pData, _In_ UINT uDataSize, _In_ UINT)
+    {
+        ++m_uNumContextCalls;
+
+        if (!pAsync || (pData && uDataSize != sizeof(BOOL)))
+        {
+            return E_INVALIDARG;
+        }
+
+        if (pData)
+        {
+            *static_cast<BOOL*>(pData) = TRUE;
+        }
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderDevice::IASetVertexBuffers
+      Summary:  Counts a state change
+      Modifies: [m_uNumContextCalls, m_uNumStateChanges].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void NullRenderDevice::IASetVertexBuffers(_In_ UINT, _In_ UINT, _In_reads_(uNumBuffers) ID3D11Buffer* const*, _In_reads_(uNumBuffers) const UINT*, _In_reads_(uNumBuffers) const UINT*)
+    {
+        recordStateChange();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderDevice::IASetIndexBuffer
+      Summary:  Counts a state change
+      Modifies: [m_uNumContextCalls, m_uNumStateChanges].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void NullRenderDevice::IASetIndexBuffer(_In_opt_ ID3D11Buffer*, _In_ DXGI_FORMAT, _In_ UINT)
+    {
+        recordStateChange();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderDevice::IASetInputLayout
+      Summary:  Counts a state change
+      Modifies: [m_uNumContextCalls, m_uNumStateChanges].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void NullRenderDevice::IASetInputLayout(_In_opt_ ID3D11InputLayout*)
+    {
+        recordStateChange();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderDevice::IASetPrimitiveTopology
+      Summary:  Counts a state change
+      Modifies: [m_uNumContextCalls, m_uNumStateChanges].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void NullRenderDevice::IASetPrimitiveTopology(_In_ D3D11_PRIMITIVE_TOPOLOGY)
+    {
+        recordStateChange();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderDevice::VSSetShader
+      Summary:  Counts a state change
+      Modifies: [m_uNumContextCalls, m_uNumStateChanges].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void NullRenderDevice::VSSetShader(_In_opt_ ID3D11VertexShader*)
+    {
+        recordStateChange();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderDevice::VSSetConstantBuffers
+      Summary:  Counts a state change
+      Modifies: [m_uNumContextCalls, m_uNumStateChanges].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void NullRenderDevice::VSSetConstantBuffers(_In_ UINT, _In_ UINT, _In_reads_(uNumBuffers) ID3D11Buffer* const*)
+    {
+        recordStateChange();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderDevice::VSSetConstantBuffers1
+      Summary:  Counts a state change
+      Modifies: [m_uNumContextCalls, m_uNumStateChanges].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void NullRenderDevice::VSSetConstantBuffers1(_In_ UINT, _In_ UINT, _In_reads_(uNumBuffers) ID3D11Buffer* const*, _In_reads_(uNumBuffers) const UINT*, _In_reads_(uNumBuffers) const UINT*)
+    {
+        recordStateChange();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderDevice::VSSetShaderResources
+      Summary:  Counts a state change
+      Modifies: [m_uNumContextCalls, m_uNumStateChanges].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void NullRenderDevice::VSSetShaderResources(_In_ UINT, _In_ UINT, _In_reads_(uNumViews) ID3D11ShaderResourceView* const*)
+    {
+        recordStateChange();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderDevice::PSSetShader
+      Summary:  Counts a state change
+      Modifies: [m_uNumContextCalls, m_uNumStateChanges].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void NullRenderDevice::PSSetShader(_In_opt_ ID3D11PixelShader*)
+    {
+        recordStateChange();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderDevice::PSSetConstantBuffers
+      Summary:  Counts a state change
+      Modifies: [m_uNumContextCalls, m_uNumStateChanges].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void NullRenderDevice::PSSetConstantBuffers(_In_ UINT, _In_ UINT, _In_reads_(uNumBuffers) ID3D11Buffer* const*)
+    {
+        recordStateChange();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderDevice::PSSetConstantBuffers1
+      Summary:  Counts a state change
+      Modifies: [m_uNumContextCalls, m_uNumStateChanges].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void NullRenderDevice::PSSetConstantBuffers1(_In_ UINT, _In_ UINT, _In_reads_(uNumBuffers) ID3D11Buffer* const*, _In_reads_(uNumBuffers) const UINT*, _In_reads_(uNumBuffers) const UINT*)
+    {
+        recordStateChange();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderDevice::PSSetShaderResources
+      Summary:  Counts a state change
+      Modifies: [m_uNumContextCalls, m_uNumStateChanges].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void NullRenderDevice::PSSetShaderResources(_In_ UINT, _In_ UINT, _In_reads_(uNumViews) ID3D11ShaderResourceView* const*)
+    {
+        recordStateChange();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderDevice::PSSetSamplers
+      Summary:  Counts a state change
+      Modifies: [m_uNumContextCalls, m_uNumStateChanges].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void NullRenderDevice::PSSetSamplers(_In_ UINT, _In_ UINT, _In_reads_(uNumSamplers) ID3D11SamplerState* const*)
+    {
+        recordStateChange();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderDevice::OMSetRenderTargets
+      Summary:  Counts a state change
+      Modifies: [m_uNumContextCalls, m_uNumStateChanges].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void NullRenderDevice::OMSetRenderTargets(_In_ UINT, _In_reads_opt_(uNumViews) ID3D11RenderTargetView* const*, _In_opt_ ID3D11DepthStencilView*)
+    {
+        recordStateChange();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderDevice::RSSetViewports
+      Summary:  Counts a state change
+      Modifies: [m_uNumContextCalls, m_uNumStateChanges].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void NullRenderDevice::RSSetViewports(_In_ UINT, _In_reads_(uNumViewports) const D3D11_VIEWPORT*)
+    {
+        recordStateChange();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderDevice::ClearRenderTargetView
+      Summary:  Counts the call
+      Modifies: [m_uNumContextCalls].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void NullRenderDevice::ClearRenderTargetView(_In_ ID3D11RenderTargetView*, _In_ const FLOAT[4])
+    {
+        ++m_uNumContextCalls;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderDevice::ClearDepthStencilView
+      Summary:  Counts the call
+      Modifies: [m_uNumContextCalls].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void NullRenderDevice::ClearDepthStencilView(_In_ ID3D11DepthStencilView*, _In_ UINT, _In_ FLOAT, _In_ UINT8)
+    {
+        ++m_uNumContextCalls;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderDevice::DrawIndexed
+      Summary:  Counts a draw and its indices
+      Modifies: [m_uNumContextCalls, m_uNumDraws, m_uNumDrawnIndices].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void NullRenderDevice::DrawIndexed(_In_ UINT uIndexCount, _In_ UINT, _In_ INT)
+    {
+        ++m_uNumContextCalls;
+        ++m_uNumDraws;
+        m_uNumDrawnIndices += uIndexCount;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderDevice::DrawIndexedInstanced
+      Summary:  Counts a draw and the indices of all its instances
+      Modifies: [m_uNumContextCalls, m_uNumDraws, m_uNumDrawnIndices].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void NullRenderDevice::DrawIndexedInstanced(_In_ UINT uIndexCountPerInstance, _In_ UINT uInstanceCount, _In_ UINT, _In_ INT, _In_ UINT)
+    {
+        ++m_uNumContextCalls;
+        ++m_uNumDraws;
+        m_uNumDrawnIndices += static_cast<UINT64>(uIndexCountPerInstance) * uInstanceCount;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderDevice::recordCreation
+      Summary:  Counts a created resource, from any thread
+      Args:     UINT64 uNumInitialBytes
+                  Bytes of its initial data
+      Modifies: [m_uNumCreationCalls, m_uNumCreatedResources,
+                 m_uNumInitialBytes].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void NullRenderDevice::recordCreation(_In_ UINT64 uNumInitialBytes)
+    {
+        ++m_uNumCreationCalls;
+        ++m_uNumCreatedResources;
+        m_uNumInitialBytes += uNumInitialBytes;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   NullRenderDevice::recordStateChange
+      Summary:  Counts a state call of the context
+      Modifies: [m_uNumContextCalls, m_uNumStateChanges].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void NullRenderDevice::recordStateChange()
+    {
+        ++m_uNumContextCalls;
+        ++m_uNumStateChanges;
+    }
+}
\ No newline at end of file
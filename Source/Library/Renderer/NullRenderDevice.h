@@ -0,0 +1,115 @@
+/*+===================================================================
+  File:      NULLRENDERDEVICE.H
+
+  Summary:   NullRenderDevice header file contains declarations of
+             NullRenderDevice class, the render device that records
+             the calls of the renderer without a GPU.
+
+  Classes: NullRenderDevice
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include <atomic>
+
+#include "Renderer/RenderDevice.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    NullRenderDevice
+
+      Summary:  Render device that draws nothing and counts what the
+                renderer asks for: the calls, the created resources and
+                their initial bytes, the uploads and their bytes, the
+                state changes and the draws. The created objects are
+                placeholders that only keep their descriptions, and the
+                buffers their memory so that Map hands out a writable
+                pointer, so that Scene::Initialize and Renderer::Render
+                run unchanged on machines without a GPU
+
+      Methods:  GetStats
+                  Returns the counters
+                ResetStats
+                  Resets the counters
+                NullRenderDevice
+                  Constructor.
+                ~NullRenderDevice
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class NullRenderDevice final : public RenderDevice
+    {
+    public:
+        NullRenderDevice();
+        NullRenderDevice(const NullRenderDevice& other) = delete;
+        NullRenderDevice(NullRenderDevice&& other) = delete;
+        NullRenderDevice& operator=(const NullRenderDevice& other) = delete;
+        NullRenderDevice& operator=(NullRenderDevice&& other) = delete;
+        ~NullRenderDevice() override = default;
+
+        RenderDeviceStats GetStats() const;
+        void ResetStats();
+
+        HRESULT CreateBuffer(_In_ const D3D11_BUFFER_DESC* pDesc, _In_opt_ const D3D11_SUBRESOURCE_DATA* pInitialData, _Out_ ID3D11Buffer** ppBuffer) override;
+        HRESULT CreateTexture2D(_In_ const D3D11_TEXTURE2D_DESC* pDesc, _In_opt_ const D3D11_SUBRESOURCE_DATA* pInitialData, _Out_ ID3D11Texture2D** ppTexture2D) override;
+        HRESULT CreateTextureFromFile(_In_ const std::filesystem::path& filePath, _Out_ ID3D11ShaderResourceView** ppTextureView) override;
+        HRESULT CreateShaderResourceView(_In_ ID3D11Resource* pResource, _In_opt_ const D3D11_SHADER_RESOURCE_VIEW_DESC* pDesc, _Out_ ID3D11ShaderResourceView** ppView) override;
+        HRESULT CreateRenderTargetView(_In_ ID3D11Resource* pResource, _In_opt_ const D3D11_RENDER_TARGET_VIEW_DESC* pDesc, _Out_ ID3D11RenderTargetView** ppView) override;
+        HRESULT CreateDepthStencilView(_In_ ID3D11Resource* pResource, _In_opt_ const D3D11_DEPTH_STENCIL_VIEW_DESC* pDesc, _Out_ ID3D11DepthStencilView** ppView) override;
+        HRESULT CreateSamplerState(_In_ const D3D11_SAMPLER_DESC* pDesc, _Out_ ID3D11SamplerState** ppSamplerState) override;
+        HRESULT CompileShader(_In_ PCWSTR pszFileName, _In_ PCSTR pszEntryPoint, _In_ PCSTR pszShaderModel, _In_ UINT uFlags, _Outptr_ ID3DBlob** ppCode, _Outptr_opt_result_maybenull_ ID3DBlob** ppErrorMessages) override;
+        HRESULT CreateInputLayout(_In_reads_(uNumElements) const D3D11_INPUT_ELEMENT_DESC* pInputElementDescs, _In_ UINT uNumElements, _In_ const void* pShaderBytecode, _In_ SIZE_T bytecodeLength, _Out_ ID3D11InputLayout** ppInputLayout) override;
+        HRESULT CreateVertexShader(_In_ const void* pShaderBytecode, _In_ SIZE_T bytecodeLength, _Out_ ID3D11VertexShader** ppVertexShader) override;
+        HRESULT CreatePixelShader(_In_ const void* pShaderBytecode, _In_ SIZE_T bytecodeLength, _Out_ ID3D11PixelShader** ppPixelShader) override;
+        HRESULT CreateQuery(_In_ const D3D11_QUERY_DESC* pQueryDesc, _Out_ ID3D11Query** ppQuery) override;
+        BOOL SupportsConstantBufferOffsets() const override;
+
+        void UpdateSubresource(_In_ ID3D11Resource* pDstResource, _In_ UINT uDstSubresource, _In_opt_ const D3D11_BOX* pDstBox, _In_ const void* pSrcData, _In_ UINT uSrcRowPitch, _In_ UINT uSrcDepthPitch) override;
+        HRESULT Map(_In_ ID3D11Resource* pResource, _In_ UINT uSubresource, _In_ D3D11_MAP mapType, _In_ UINT uMapFlags, _Out_ D3D11_MAPPED_SUBRESOURCE* pMappedResource) override;
+        void Unmap(_In_ ID3D11Resource* pResource, _In_ UINT uSubresource) override;
+        void End(_In_ ID3D11Asynchronous* pAsync) override;
+        HRESULT GetData(_In_ ID3D11Asynchronous* pAsync, _Out_writes_bytes_opt_(uDataSize) void* pData, _In_ UINT uDataSize, _In_ UINT uGetDataFlags) override;
+
+        void IASetVertexBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_(uNumBuffers) ID3D11Buffer* const* ppVertexBuffers, _In_reads_(uNumBuffers) const UINT* pStrides, _In_reads_(uNumBuffers) const UINT* pOffsets) override;
+        void IASetIndexBuffer(_In_opt_ ID3D11Buffer* pIndexBuffer, _In_ DXGI_FORMAT format, _In_ UINT uOffset) override;
+        void IASetInputLayout(_In_opt_ ID3D11InputLayout* pInputLayout) override;
+        void IASetPrimitiveTopology(_In_ D3D11_PRIMITIVE_TOPOLOGY topology) override;
+
+        void VSSetShader(_In_opt_ ID3D11VertexShader* pVertexShader) override;
+        void VSSetConstantBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers) override;
+        void VSSetConstantBuffers1(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers, _In_reads_(uNumBuffers) const UINT* pFirstConstant, _In_reads_(uNumBuffers) const UINT* pNumConstants) override;
+        void VSSetShaderResources(_In_ UINT uStartSlot, _In_ UINT uNumViews, _In_reads_(uNumViews) ID3D11ShaderResourceView* const* ppShaderResourceViews) override;
+
+        void PSSetShader(_In_opt_ ID3D11PixelShader* pPixelShader) override;
+        void PSSetConstantBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers) override;
+        void PSSetConstantBuffers1(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers, _In_reads_(uNumBuffers) const UINT* pFirstConstant, _In_reads_(uNumBuffers) const UINT* pNumConstants) override;
+        void PSSetShaderResources(_In_ UINT uStartSlot, _In_ UINT uNumViews, _In_reads_(uNumViews) ID3D11ShaderResourceView* const* ppShaderResourceViews) override;
+        void PSSetSamplers(_In_ UINT uStartSlot, _In_ UINT uNumSamplers, _In_reads_(uNumSamplers) ID3D11SamplerState* const* ppSamplers) override;
+
+        void OMSetRenderTargets(_In_ UINT uNumViews, _In_reads_opt_(uNumViews) ID3D11RenderTargetView* const* ppRenderTargetViews, _In_opt_ ID3D11DepthStencilView* pDepthStencilView) override;
+        void RSSetViewports(_In_ UINT uNumViewports, _In_reads_(uNumViewports) const D3D11_VIEWPORT* pViewports) override;
+
+        void ClearRenderTargetView(_In_ ID3D11RenderTargetView* pRenderTargetView, _In_ const FLOAT aColorRGBA[4]) override;
+        void ClearDepthStencilView(_In_ ID3D11DepthStencilView* pDepthStencilView, _In_ UINT uClearFlags, _In_ FLOAT depth, _In_ UINT8 stencil) override;
+        void DrawIndexed(_In_ UINT uIndexCount, _In_ UINT uStartIndexLocation, _In_ INT baseVertexLocation) override;
+        void DrawIndexedInstanced(_In_ UINT uIndexCountPerInstance, _In_ UINT uInstanceCount, _In_ UINT uStartIndexLocation, _In_ INT baseVertexLocation, _In_ UINT uStartInstanceLocation) override;
+
+    private:
+        void recordCreation(_In_ UINT64 uNumInitialBytes);
+        void recordStateChange();
+
+    private:
+        std::atomic<UINT64> m_uNumCreationCalls;
+        std::atomic<UINT64> m_uNumCreatedResources;
+        std::atomic<UINT64> m_uNumInitialBytes;
+        UINT64 m_uNumContextCalls;
+        UINT64 m_uNumUploads;
+        UINT64 m_uNumUploadedBytes;
+        UINT64 m_uNumStateChanges;
+        UINT64 m_uNumDraws;
+        UINT64 m_uNumDrawnIndices;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,147 @@
+#include "Renderer/PipelineState.h"
+
+namespace library
+{
+    namespace
+    {
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: hashValue
+
+          Summary:  Adds the bytes of a value to an FNV-1a hash
+
+          Args:     UINT64 uHash
+                      Hash so far
+                    const T& value
+                      Value to add
+
+          Returns:  UINT64
+                      Hash with the value
+        F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+        template <class T>
+        UINT64 hashValue(_In_ UINT64 uHash, _In_ const T& value)
+        {
+            constexpr const UINT64 FNV_PRIME = 0x100000001B3ull;
+
+            const BYTE* pBytes = reinterpret_cast<const BYTE*>(&value);
+            for (size_t i = 0u; i < sizeof(T); ++i)
+            {
+                uHash = (uHash ^ pBytes[i]) * FNV_PRIME;
+            }
+
+            return uHash;
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   PipelineStateDescHash::operator()
+      Summary:  Hashes the members of a description one by one, so
+                the padding between them never counts
+      Args:     const PipelineStateDesc& desc
+                  The description
+      Returns:  size_t
+                  Hash of the description
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    size_t PipelineStateDescHash::operator()(_In_ const PipelineStateDesc& desc) const
+    {
+        UINT64 uHash = 0xCBF29CE484222325ull;
+        uHash = hashValue(uHash, desc.pVertexShader);
+        uHash = hashValue(uHash, desc.pPixelShader);
+        uHash = hashValue(uHash, desc.pInputLayout);
+        uHash = hashValue(uHash, desc.aStrides);
+        uHash = hashValue(uHash, desc.uNumVertexBuffers);
+        uHash = hashValue(uHash, desc.indexFormat);
+        uHash = hashValue(uHash, desc.topology);
+        uHash = hashValue(uHash, desc.uVSConstantBufferSlots);
+        uHash = hashValue(uHash, desc.uPSConstantBufferSlots);
+
+        return static_cast<size_t>(uHash);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   PipelineState::PipelineState
+      Summary:  Constructor
+      Args:     const PipelineStateDesc& desc
+                  Description of the pipeline
+      Modifies: [m_desc].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    PipelineState::PipelineState(_In_ const PipelineStateDesc& desc)
+        : m_desc(desc)
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   PipelineState::GetDesc
+      Summary:  Returns the description of the pipeline
+      Returns:  const PipelineStateDesc&
+                  Shaders, layout, streams and constant buffer slots
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const PipelineStateDesc& PipelineState::GetDesc() const
+    {
+        return m_desc;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   PipelineStateCache::PipelineStateCache
+      Summary:  Constructor
+      Modifies: [m_pipelineStates, m_uNumRequests].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    PipelineStateCache::PipelineStateCache()
+        : m_pipelineStates()
+        , m_uNumRequests(0u)
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   PipelineStateCache::GetPipelineState
+      Summary:  Returns the pipeline of an equal description, creating
+                it the first time it is asked for. The nodes of the map
+                never move, so the pipeline stays where it is while
+                others are added
+      Args:     const PipelineStateDesc& desc
+                  Description of the pipeline
+                const PipelineState*& outPipelineState
+                  Receives the shared pipeline
+      Modifies: [m_pipelineStates, m_uNumRequests].
+      Returns:  HRESULT
+                  Status code, E_INVALIDARG without shaders, layout or
+                  vertex streams
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT PipelineStateCache::GetPipelineState(_In_ const PipelineStateDesc& desc, _Out_ const PipelineState*& outPipelineState)
+    {
+        outPipelineState = nullptr;
+
+        if (!desc.pVertexShader || !desc.pPixelShader || !desc.pInputLayout
+            || desc.uNumVertexBuffers == 0u || desc.uNumVertexBuffers > PipelineStateDesc::MAX_VERTEX_BUFFERS)
+        {
+            return E_INVALIDARG;
+        }
+
+        outPipelineState = &m_pipelineStates.try_emplace(desc, desc).first->second;
+        ++m_uNumRequests;
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   PipelineStateCache::GetNumPipelineStates
+      Summary:  Returns the number of unique pipelines created
+      Returns:  UINT
+                  Number of pipelines
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT PipelineStateCache::GetNumPipelineStates() const
+    {
+        return static_cast<UINT>(m_pipelineStates.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   PipelineStateCache::GetNumRequests
+      Summary:  Returns the number of pipelines asked for, one per
+                renderable, against the unique ones they collapse to
+      Returns:  UINT64
+                  Number of calls of GetPipelineState that succeeded
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT64 PipelineStateCache::GetNumRequests() const
+    {
+        return m_uNumRequests;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,132 @@
+/*+===================================================================
+  File:      PIPELINESTATE.H
+
+  Summary:   PipelineState header file contains declarations of
+             PipelineState class, the immutable shaders, input layout,
+             vertex streams and constant buffer slots of a kind of
+             draw, and of PipelineStateCache class that creates them
+             once and shares them between renderables.
+
+  Classes: PipelineState, PipelineStateCache
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Renderer/RenderDevice.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   PipelineStateDesc
+
+        Summary:  Everything a draw binds that does not change with
+                  the object: the shaders and the input layout, the
+                  strides of the vertex streams, the index format and
+                  the primitive topology, and the constant buffer slots
+                  each shader reads as a mask of bits, bit i for slot i.
+                  Rasterizer, blend and depth stencil state are left at
+                  the defaults of the device
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct PipelineStateDesc
+    {
+        static constexpr const UINT MAX_VERTEX_BUFFERS = 3u;
+
+        ID3D11VertexShader* pVertexShader;
+        ID3D11PixelShader* pPixelShader;
+        ID3D11InputLayout* pInputLayout;
+        UINT aStrides[MAX_VERTEX_BUFFERS];
+        UINT uNumVertexBuffers;
+        DXGI_FORMAT indexFormat;
+        D3D11_PRIMITIVE_TOPOLOGY topology;
+        UINT uVSConstantBufferSlots;
+        UINT uPSConstantBufferSlots;
+
+        bool operator==(const PipelineStateDesc& other) const = default;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   PipelineStateDescHash
+
+        Summary:  Hash of a pipeline state description, FNV-1a over its
+                  members
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct PipelineStateDescHash
+    {
+        size_t operator()(_In_ const PipelineStateDesc& desc) const;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    PipelineState
+
+      Summary:  Pipeline of a kind of draw, never changed once created.
+                Draws sharing a pipeline share the object, so telling
+                whether a draw needs a new pipeline is a comparison of
+                two pointers
+
+      Methods:  GetDesc
+                  Returns the description of the pipeline
+                PipelineState
+                  Constructor.
+                ~PipelineState
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class PipelineState
+    {
+    public:
+        PipelineState() = delete;
+        explicit PipelineState(_In_ const PipelineStateDesc& desc);
+        PipelineState(const PipelineState& other) = delete;
+        PipelineState(PipelineState&& other) = delete;
+        PipelineState& operator=(const PipelineState& other) = delete;
+        PipelineState& operator=(PipelineState&& other) = delete;
+        ~PipelineState() = default;
+
+        const PipelineStateDesc& GetDesc() const;
+
+    private:
+        const PipelineStateDesc m_desc;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    PipelineStateCache
+
+      Summary:  Pipeline states hashed by their description. Asking for
+                a description returns the pipeline created for an equal
+                one, so renderables with the same shaders and streams
+                end up with the same object. The pipelines live as long
+                as the cache
+
+      Methods:  GetPipelineState
+                  Returns the pipeline of a description
+                GetNumPipelineStates
+                  Returns the number of unique pipelines
+                GetNumRequests
+                  Returns the number of pipelines asked for
+                PipelineStateCache
+                  Constructor.
+                ~PipelineStateCache
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class PipelineStateCache
+    {
+    public:
+        PipelineStateCache();
+        PipelineStateCache(const PipelineStateCache& other) = delete;
+        PipelineStateCache(PipelineStateCache&& other) = delete;
+        PipelineStateCache& operator=(const PipelineStateCache& other) = delete;
+        PipelineStateCache& operator=(PipelineStateCache&& other) = delete;
+        ~PipelineStateCache() = default;
+
+        HRESULT GetPipelineState(_In_ const PipelineStateDesc& desc, _Out_ const PipelineState*& outPipelineState);
+
+        UINT GetNumPipelineStates() const;
+        UINT64 GetNumRequests() const;
+
+    private:
+        std::unordered_map<PipelineStateDesc, PipelineState, PipelineStateDescHash> m_pipelineStates;
+        UINT64 m_uNumRequests;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,133 @@
+/*+===================================================================
+  File:      RENDERDEVICE.H
+
+  Summary:   RenderDevice header file contains declarations of
+             RenderDevice interface, the resource creation, upload,
+             state and draw calls the Library makes, so that the same
+             renderer runs on Direct3D 11 or without a GPU.
+
+  Classes: RenderDevice
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+namespace library
+{
+    struct RenderDeviceStats
+    {
+        UINT64 uNumCalls;
+        UINT64 uNumCreatedResources;
+        UINT64 uNumInitialBytes;
+        UINT64 uNumUploads;
+        UINT64 uNumUploadedBytes;
+        UINT64 uNumStateChanges;
+        UINT64 uNumDraws;
+        UINT64 uNumDrawnIndices;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    RenderDevice
+
+      Summary:  Device and immediate context calls of the Library. The
+                resources stay the Direct3D 11 interfaces and the calls
+                take the same arguments, the implementation only
+                decides where they go: D3D11RenderDevice forwards them
+                to a device and its context, NullRenderDevice counts
+                them without a GPU. Creation may be called from any
+                thread, the other calls from the rendering thread only
+
+      Methods:  CreateBuffer / CreateTexture2D
+                  Create a resource
+                CreateTextureFromFile
+                  Loads a WIC or DDS texture
+                CreateShaderResourceView / CreateRenderTargetView /
+                CreateDepthStencilView
+                  Create a view of a resource
+                CreateSamplerState
+                  Creates a sampler
+                CompileShader
+                  Compiles a shader file to bytecode
+                CreateInputLayout / CreateVertexShader /
+                CreatePixelShader
+                  Create the shader objects from compiled bytecode
+                CreateQuery
+                  Creates a query, an event query fences the GPU work
+                SupportsConstantBufferOffsets
+                  Returns whether constant buffers can be bound from
+                  an offset
+                UpdateSubresource / Map / Unmap
+                  Upload the data of a resource
+                End / GetData
+                  Issue a query and read its result
+                IASetVertexBuffers / IASetIndexBuffer /
+                IASetInputLayout / IASetPrimitiveTopology
+                  Set the input assembler state
+                VSSetShader / VSSetConstantBuffers /
+                VSSetConstantBuffers1 / VSSetShaderResources
+                  Set the vertex shader state
+                PSSetShader / PSSetConstantBuffers /
+                PSSetConstantBuffers1 / PSSetShaderResources /
+                PSSetSamplers
+                  Set the pixel shader state
+                OMSetRenderTargets / RSSetViewports
+                  Set the targets and the viewport
+                ClearRenderTargetView / ClearDepthStencilView
+                  Clear a target
+                DrawIndexed / DrawIndexedInstanced
+                  Draw
+                ~RenderDevice
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class RenderDevice
+    {
+    public:
+        virtual ~RenderDevice() = default;
+
+        virtual HRESULT CreateBuffer(_In_ const D3D11_BUFFER_DESC* pDesc, _In_opt_ const D3D11_SUBRESOURCE_DATA* pInitialData, _Out_ ID3D11Buffer** ppBuffer) = 0;
+        virtual HRESULT CreateTexture2D(_In_ const D3D11_TEXTURE2D_DESC* pDesc, _In_opt_ const D3D11_SUBRESOURCE_DATA* pInitialData, _Out_ ID3D11Texture2D** ppTexture2D) = 0;
+        virtual HRESULT CreateTextureFromFile(_In_ const std::filesystem::path& filePath, _Out_ ID3D11ShaderResourceView** ppTextureView) = 0;
+        virtual HRESULT CreateShaderResourceView(_In_ ID3D11Resource* pResource, _In_opt_ const D3D11_SHADER_RESOURCE_VIEW_DESC* pDesc, _Out_ ID3D11ShaderResourceView** ppView) = 0;
+        virtual HRESULT CreateRenderTargetView(_In_ ID3D11Resource* pResource, _In_opt_ const D3D11_RENDER_TARGET_VIEW_DESC* pDesc, _Out_ ID3D11RenderTargetView** ppView) = 0;
+        virtual HRESULT CreateDepthStencilView(_In_ ID3D11Resource* pResource, _In_opt_ const D3D11_DEPTH_STENCIL_VIEW_DESC* pDesc, _Out_ ID3D11DepthStencilView** ppView) = 0;
+        virtual HRESULT CreateSamplerState(_In_ const D3D11_SAMPLER_DESC* pDesc, _Out_ ID3D11SamplerState** ppSamplerState) = 0;
+        virtual HRESULT CompileShader(_In_ PCWSTR pszFileName, _In_ PCSTR pszEntryPoint, _In_ PCSTR pszShaderModel, _In_ UINT uFlags, _Outptr_ ID3DBlob** ppCode, _Outptr_opt_result_maybenull_ ID3DBlob** ppErrorMessages) = 0;
+        virtual HRESULT CreateInputLayout(_In_reads_(uNumElements) const D3D11_INPUT_ELEMENT_DESC* pInputElementDescs, _In_ UINT uNumElements, _In_ const void* pShaderBytecode, _In_ SIZE_T bytecodeLength, _Out_ ID3D11InputLayout** ppInputLayout) = 0;
+        virtual HRESULT CreateVertexShader(_In_ const void* pShaderBytecode, _In_ SIZE_T bytecodeLength, _Out_ ID3D11VertexShader** ppVertexShader) = 0;
+        virtual HRESULT CreatePixelShader(_In_ const void* pShaderBytecode, _In_ SIZE_T bytecodeLength, _Out_ ID3D11PixelShader** ppPixelShader) = 0;
+        virtual HRESULT CreateQuery(_In_ const D3D11_QUERY_DESC* pQueryDesc, _Out_ ID3D11Query** ppQuery) = 0;
+        virtual BOOL SupportsConstantBufferOffsets() const = 0;
+
+        virtual void UpdateSubresource(_In_ ID3D11Resource* pDstResource, _In_ UINT uDstSubresource, _In_opt_ const D3D11_BOX* pDstBox, _In_ const void* pSrcData, _In_ UINT uSrcRowPitch, _In_ UINT uSrcDepthPitch) = 0;
+        virtual HRESULT Map(_In_ ID3D11Resource* pResource, _In_ UINT uSubresource, _In_ D3D11_MAP mapType, _In_ UINT uMapFlags, _Out_ D3D11_MAPPED_SUBRESOURCE* pMappedResource) = 0;
+        virtual void Unmap(_In_ ID3D11Resource* pResource, _In_ UINT uSubresource) = 0;
+        virtual void End(_In_ ID3D11Asynchronous* pAsync) = 0;
+        virtual HRESULT GetData(_In_ ID3D11Asynchronous* pAsync, _Out_writes_bytes_opt_(uDataSize) void* pData, _In_ UINT uDataSize, _In_ UINT uGetDataFlags) = 0;
+
+        virtual void IASetVertexBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_(uNumBuffers) ID3D11Buffer* const* ppVertexBuffers, _In_reads_(uNumBuffers) const UINT* pStrides, _In_reads_(uNumBuffers) const UINT* pOffsets) = 0;
+        virtual void IASetIndexBuffer(_In_opt_ ID3D11Buffer* pIndexBuffer, _In_ DXGI_FORMAT format, _In_ UINT uOffset) = 0;
+        virtual void IASetInputLayout(_In_opt_ ID3D11InputLayout* pInputLayout) = 0;
+        virtual void IASetPrimitiveTopology(_In_ D3D11_PRIMITIVE_TOPOLOGY topology) = 0;
+
+        virtual void VSSetShader(_In_opt_ ID3D11VertexShader* pVertexShader) = 0;
+        virtual void VSSetConstantBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers) = 0;
+        virtual void VSSetConstantBuffers1(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers, _In_reads_(uNumBuffers) const UINT* pFirstConstant, _In_reads_(uNumBuffers) const UINT* pNumConstants) = 0;
+        virtual void VSSetShaderResources(_In_ UINT uStartSlot, _In_ UINT uNumViews, _In_reads_(uNumViews) ID3D11ShaderResourceView* const* ppShaderResourceViews) = 0;
+
+        virtual void PSSetShader(_In_opt_ ID3D11PixelShader* pPixelShader) = 0;
+        virtual void PSSetConstantBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers) = 0;
+        virtual void PSSetConstantBuffers1(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers, _In_reads_(uNumBuffers) const UINT* pFirstConstant, _In_reads_(uNumBuffers) const UINT* pNumConstants) = 0;
+        virtual void PSSetShaderResources(_In_ UINT uStartSlot, _In_ UINT uNumViews, _In_reads_(uNumViews) ID3D11ShaderResourceView* const* ppShaderResourceViews) = 0;
+        virtual void PSSetSamplers(_In_ UINT uStartSlot, _In_ UINT uNumSamplers, _In_reads_(uNumSamplers) ID3D11SamplerState* const* ppSamplers) = 0;
+
+        virtual void OMSetRenderTargets(_In_ UINT uNumViews, _In_reads_opt_(uNumViews) ID3D11RenderTargetView* const* ppRenderTargetViews, _In_opt_ ID3D11DepthStencilView* pDepthStencilView) = 0;
+        virtual void RSSetViewports(_In_ UINT uNumViewports, _In_reads_(uNumViewports) const D3D11_VIEWPORT* pViewports) = 0;
+
+        virtual void ClearRenderTargetView(_In_ ID3D11RenderTargetView* pRenderTargetView, _In_ const FLOAT aColorRGBA[4]) = 0;
+        virtual void ClearDepthStencilView(_In_ ID3D11DepthStencilView* pDepthStencilView, _In_ UINT uClearFlags, _In_ FLOAT depth, _In_ UINT8 stencil) = 0;
+        virtual void DrawIndexed(_In_ UINT uIndexCount, _In_ UINT uStartIndexLocation, _In_ INT baseVertexLocation) = 0;
+        virtual void DrawIndexedInstanced(_In_ UINT uIndexCountPerInstance, _In_ UINT uInstanceCount, _In_ UINT uStartIndexLocation, _In_ INT baseVertexLocation, _In_ UINT uStartInstanceLocation) = 0;
+    };
+}
\ No newline at end of file
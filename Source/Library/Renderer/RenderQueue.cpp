@@ -0,0 +1,526 @@
+#include "Renderer/RenderQueue.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+namespace library
+{
+    namespace
+    {
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: isUsed
+
+          Summary:  Tells whether a draw binds a slot, a null object or
+                    constant buffer leaves it as it is
+
+          Args:     const void* pObject / const ConstantBufferRange& range
+                      Object or constants of the slot
+
+          Returns:  BOOL
+                      TRUE if the slot is bound
+        F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+        BOOL isUsed(_In_opt_ const void* pObject)
+        {
+            return pObject != nullptr;
+        }
+
+        BOOL isUsed(_In_ const ConstantBufferRange& range)
+        {
+            return range.pBuffer != nullptr;
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: countSlots
+
+          Summary:  Counts the slots a draw binds
+
+          Args:     const T (&aSlots)[N]
+                      Objects of the slots
+
+          Returns:  UINT64
+                      Number of bound slots
+        F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+        template <class T, size_t N>
+        UINT64 countSlots(_In_ const T (&aSlots)[N])
+        {
+            return static_cast<UINT64>(std::count_if(aSlots, aSlots + N, [](const T& slot) { return isUsed(slot); }));
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: bindSlots
+
+          Summary:  Binds the slots whose object differs from the bound
+                    one, one call per run of consecutive changed slots
+
+          Args:     const T (&aWanted)[N]
+                      Objects the draw needs, unused ones leave the
+                      slot
+                    T (&aBound)[N]
+                      Objects bound so far, updated
+                    const Bind& bind
+                      Binds a run of slots: start slot, number of
+                      slots and their objects
+
+          Returns:  UINT64
+                      Number of calls issued
+        F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+        template <class T, size_t N, class Bind>
+        UINT64 bindSlots(_In_ const T (&aWanted)[N], _Inout_ T (&aBound)[N], _In_ const Bind& bind)
+        {
+            UINT64 uNumCalls = 0u;
+            UINT uSlot = 0u;
+            while (uSlot < N)
+            {
+                if (!isUsed(aWanted[uSlot]) || aWanted[uSlot] == aBound[uSlot])
+                {
+                    ++uSlot;
+                    continue;
+                }
+
+                UINT uEnd = uSlot + 1u;
+                while (uEnd < N && isUsed(aWanted[uEnd]) && !(aWanted[uEnd] == aBound[uEnd]))
+                {
+                    ++uEnd;
+                }
+
+                bind(uSlot, uEnd - uSlot, &aWanted[uSlot]);
+                std::copy(aWanted + uSlot, aWanted + uEnd, aBound + uSlot);
+                ++uNumCalls;
+                uSlot = uEnd;
+            }
+
+            return uNumCalls;
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: bindConstantBuffers
+
+          Summary:  Binds a run of constant buffer ranges of a stage
+
+          Args:     UINT uSlot
+                      First slot
+                    UINT uNumSlots
+                      Number of slots
+                    const ConstantBufferRange* pRanges
+                      Constants of the slots
+                    const Bind& bind
+                      Binding of the stage, from the offsets of the
+                      ranges or of the whole buffers
+        F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+        template <class Bind>
+        void bindConstantBuffers(_In_ UINT uSlot, _In_ UINT uNumSlots, _In_reads_(uNumSlots) const ConstantBufferRange* pRanges, _In_ const Bind& bind)
+        {
+            ID3D11Buffer* apBuffers[DrawState::NUM_CONSTANT_BUFFER_SLOTS];
+            UINT aFirstConstants[DrawState::NUM_CONSTANT_BUFFER_SLOTS];
+            UINT aNumConstants[DrawState::NUM_CONSTANT_BUFFER_SLOTS];
+            for (UINT i = 0u; i < uNumSlots; ++i)
+            {
+                apBuffers[i] = pRanges[i].pBuffer;
+                aFirstConstants[i] = pRanges[i].uFirstConstant;
+                aNumConstants[i] = pRanges[i].uNumConstants;
+            }
+
+            bind(uSlot, uNumSlots, apBuffers, aFirstConstants, aNumConstants);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderQueue::RenderQueue
+      Summary:  Constructor
+      Modifies: [m_eye, m_farDistance, m_aStates, m_aBindings,
+                 m_aRecords, m_aItems, m_aScratchItems, m_ids,
+                 m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    RenderQueue::RenderQueue()
+        : m_eye()
+        , m_farDistance(1.0f)
+        , m_aStates()
+        , m_aBindings()
+        , m_aRecords()
+        , m_aItems()
+        , m_aScratchItems()
+        , m_ids()
+        , m_stats()
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderQueue::Reset
+      Summary:  Empties the queue, keeping its memory for the draws of
+                the new frame
+      Args:     const XMFLOAT3& eye
+                  Position of the camera the draws are sorted from
+                FLOAT farDistance
+                  Distance of the far plane
+      Modifies: [m_eye, m_farDistance, m_aStates, m_aBindings,
+                 m_aRecords, m_aItems, m_ids, m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RenderQueue::Reset(_In_ const XMFLOAT3& eye, _In_ FLOAT farDistance)
+    {
+        m_eye = eye;
+        m_farDistance = farDistance;
+        m_aStates.clear();
+        m_aBindings.clear();
+        m_aRecords.clear();
+        m_aItems.clear();
+        m_stats = RenderQueueStats();
+
+        if (m_ids.size() > MAX_IDS)
+        {
+            m_ids.clear();
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderQueue::AddState
+      Summary:  Adds the state of an object for its draws, keeping
+                only the constant buffer ranges of the slots its
+                pipeline reads
+      Args:     const DrawState& state
+                  Pipeline, geometry and constant buffers
+      Modifies: [m_aStates].
+      Returns:  UINT
+                  Index of the state for the draws
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT RenderQueue::AddState(_In_ const DrawState& state)
+    {
+        assert(state.pPipelineState);
+
+        m_aStates.push_back(state);
+
+        DrawState& addedState = m_aStates.back();
+        const PipelineStateDesc& pipeline = state.pPipelineState->GetDesc();
+        for (UINT i = 0u; i < DrawState::NUM_CONSTANT_BUFFER_SLOTS; ++i)
+        {
+            if (!(pipeline.uVSConstantBufferSlots & (1u << i)))
+            {
+                addedState.aVSConstantBuffers[i] = ConstantBufferRange();
+            }
+            if (!(pipeline.uPSConstantBufferSlots & (1u << i)))
+            {
+                addedState.aPSConstantBuffers[i] = ConstantBufferRange();
+            }
+        }
+
+        return static_cast<UINT>(m_aStates.size() - 1u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderQueue::AddBindings
+      Summary:  Adds the textures and samplers of a material
+      Args:     const DrawBindings& bindings
+                  Views and samplers of the pixel shader
+      Modifies: [m_aBindings].
+      Returns:  UINT
+                  Index of the bindings for the draws
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT RenderQueue::AddBindings(_In_ const DrawBindings& bindings)
+    {
+        m_aBindings.push_back(bindings);
+
+        return static_cast<UINT>(m_aBindings.size() - 1u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderQueue::AddDraw
+      Summary:  Adds a draw with its sort key
+      Args:     eRenderPass pass
+                  Pass of the draw
+                const XMFLOAT3& position
+                  Position of the object, its distance from the camera
+                  orders the draws of the same state
+                const DrawRecord& record
+                  State, bindings and range of the draw
+      Modifies: [m_aRecords, m_aItems, m_ids, m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RenderQueue::AddDraw(_In_ eRenderPass pass, _In_ const XMFLOAT3& position, _In_ const DrawRecord& record)
+    {
+        assert(record.uState < m_aStates.size() && record.uBindings < m_aBindings.size());
+
+        const DrawState& state = m_aStates[record.uState];
+        const DrawBindings& bindings = m_aBindings[record.uBindings];
+
+        constexpr const UINT64 DEPTH_MASK = (1ull << DEPTH_BITS) - 1ull;
+
+        const FLOAT dx = position.x - m_eye.x;
+        const FLOAT dy = position.y - m_eye.y;
+        const FLOAT dz = position.z - m_eye.z;
+        const FLOAT distance = std::clamp(std::sqrt(dx * dx + dy * dy + dz * dz) / m_farDistance, 0.0f, 1.0f);
+        const UINT64 uDepth = static_cast<UINT64>(distance * static_cast<FLOAT>(DEPTH_MASK));
+
+        // The texture set of a material is told apart by its first view
+        const ID3D11ShaderResourceView* const* ppFirstView = std::find_if(bindings.apPSViews, bindings.apPSViews + DrawBindings::NUM_VIEW_SLOTS,
+            [](const ID3D11ShaderResourceView* pView) { return pView != nullptr; });
+        const void* pTextures = ppFirstView != bindings.apPSViews + DrawBindings::NUM_VIEW_SLOTS ? *ppFirstView : nullptr;
+
+        const UINT64 uPipeline = getId(state.pPipelineState, 14u);
+        const UINT64 uTextures = getId(pTextures, 16u);
+        const UINT64 uGeometry = getId(state.apVertexBuffers[0], 8u);
+
+        UINT64 uKey = static_cast<UINT64>(pass) << 62u;
+        if (pass == eRenderPass::TRANSPARENT_GEOMETRY)
+        {
+            uKey |= ((DEPTH_MASK - uDepth) << 38u) | (uPipeline << 24u) | (uTextures << 8u) | uGeometry;
+            ++m_stats.uNumTransparentDraws;
+        }
+        else
+        {
+            uKey |= (uPipeline << 48u) | (uTextures << 32u) | (uGeometry << 24u) | uDepth;
+        }
+
+        m_aItems.push_back({ .uKey = uKey, .uRecord = static_cast<UINT>(m_aRecords.size()) });
+        m_aRecords.push_back(record);
+
+        // Vertex and index buffers, and the layout, shaders and topology of the pipeline are one call each
+        m_stats.uNumBindings += 1u + (state.pIndexBuffer ? 1u : 0u) + 4u
+            + countSlots(state.aVSConstantBuffers) + countSlots(state.aPSConstantBuffers) + countSlots(state.apVSViews)
+            + countSlots(bindings.apPSViews) + countSlots(bindings.apPSSamplers);
+        ++m_stats.uNumDraws;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderQueue::Submit
+      Summary:  Sorts the draws by key and issues them, binding only
+                the state that differs from the previous draw. The
+                pipeline is bound only when its pointer differs from
+                the bound one, and then only its parts that differ.
+                Nothing is assumed bound when the submission starts.
+                Constant buffers are bound from the offsets of their
+                ranges when the device supports it, and whole
+                otherwise, where the ranges start at the beginning of
+                their own buffers
+      Args:     RenderDevice* pDevice
+                  The render device to draw with
+      Modifies: [m_aItems, m_aScratchItems, m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RenderQueue::Submit(_In_ RenderDevice* pDevice)
+    {
+        sortItems();
+
+        DrawState bound = {};
+        DrawBindings boundBindings = {};
+        PipelineStateDesc boundPipeline = {};
+        UINT aBoundStrides[DrawState::MAX_VERTEX_BUFFERS] = {};
+        UINT uNumBoundVertexBuffers = 0u;
+        DXGI_FORMAT boundIndexFormat = DXGI_FORMAT_UNKNOWN;
+        UINT uBoundState = UINT_MAX;
+        UINT uBoundBindings = UINT_MAX;
+
+        const BOOL bConstantBufferOffsets = pDevice->SupportsConstantBufferOffsets();
+
+        UINT64 uNumStateChanges = 0u;
+        for (const SortItem& item : m_aItems)
+        {
+            const DrawRecord& record = m_aRecords[item.uRecord];
+
+            if (record.uState != uBoundState)
+            {
+                const DrawState& state = m_aStates[record.uState];
+                const PipelineStateDesc& pipeline = state.pPipelineState->GetDesc();
+
+                if (state.pPipelineState != bound.pPipelineState)
+                {
+                    if (pipeline.pInputLayout != boundPipeline.pInputLayout)
+                    {
+                        pDevice->IASetInputLayout(pipeline.pInputLayout);
+                        ++uNumStateChanges;
+                    }
+
+                    if (pipeline.topology != boundPipeline.topology)
+                    {
+                        pDevice->IASetPrimitiveTopology(pipeline.topology);
+                        ++uNumStateChanges;
+                    }
+
+                    if (pipeline.pVertexShader != boundPipeline.pVertexShader)
+                    {
+                        pDevice->VSSetShader(pipeline.pVertexShader);
+                        ++uNumStateChanges;
+                    }
+
+                    if (pipeline.pPixelShader != boundPipeline.pPixelShader)
+                    {
+                        pDevice->PSSetShader(pipeline.pPixelShader);
+                        ++uNumStateChanges;
+                    }
+
+                    boundPipeline = pipeline;
+                    bound.pPipelineState = state.pPipelineState;
+                    ++m_stats.uNumPipelineChanges;
+                }
+
+                if (pipeline.uNumVertexBuffers != uNumBoundVertexBuffers
+                    || !std::equal(state.apVertexBuffers, state.apVertexBuffers + pipeline.uNumVertexBuffers, bound.apVertexBuffers)
+                    || !std::equal(pipeline.aStrides, pipeline.aStrides + pipeline.uNumVertexBuffers, aBoundStrides)
+                    || !std::equal(state.aOffsets, state.aOffsets + pipeline.uNumVertexBuffers, bound.aOffsets))
+                {
+                    pDevice->IASetVertexBuffers(0u, pipeline.uNumVertexBuffers, state.apVertexBuffers, pipeline.aStrides, state.aOffsets);
+                    std::copy(state.apVertexBuffers, state.apVertexBuffers + DrawState::MAX_VERTEX_BUFFERS, bound.apVertexBuffers);
+                    std::copy(pipeline.aStrides, pipeline.aStrides + DrawState::MAX_VERTEX_BUFFERS, aBoundStrides);
+                    std::copy(state.aOffsets, state.aOffsets + DrawState::MAX_VERTEX_BUFFERS, bound.aOffsets);
+                    uNumBoundVertexBuffers = pipeline.uNumVertexBuffers;
+                    ++uNumStateChanges;
+                }
+
+                if (state.pIndexBuffer && (state.pIndexBuffer != bound.pIndexBuffer || pipeline.indexFormat != boundIndexFormat))
+                {
+                    pDevice->IASetIndexBuffer(state.pIndexBuffer, pipeline.indexFormat, 0u);
+                    bound.pIndexBuffer = state.pIndexBuffer;
+                    boundIndexFormat = pipeline.indexFormat;
+                    ++uNumStateChanges;
+                }
+
+                uNumStateChanges += bindSlots(state.aVSConstantBuffers, bound.aVSConstantBuffers,
+                    [pDevice, bConstantBufferOffsets](UINT uSlot, UINT uNumSlots, const ConstantBufferRange* pRanges)
+                    {
+                        bindConstantBuffers(uSlot, uNumSlots, pRanges,
+                            [pDevice, bConstantBufferOffsets](UINT uStart, UINT uNum, ID3D11Buffer* const* ppBuffers, const UINT* pFirst, const UINT* pNum)
+                            {
+                                if (bConstantBufferOffsets)
+                                {
+                                    pDevice->VSSetConstantBuffers1(uStart, uNum, ppBuffers, pFirst, pNum);
+                                }
+                                else
+                                {
+                                    pDevice->VSSetConstantBuffers(uStart, uNum, ppBuffers);
+                                }
+                            });
+                    });
+                uNumStateChanges += bindSlots(state.aPSConstantBuffers, bound.aPSConstantBuffers,
+                    [pDevice, bConstantBufferOffsets](UINT uSlot, UINT uNumSlots, const ConstantBufferRange* pRanges)
+                    {
+                        bindConstantBuffers(uSlot, uNumSlots, pRanges,
+                            [pDevice, bConstantBufferOffsets](UINT uStart, UINT uNum, ID3D11Buffer* const* ppBuffers, const UINT* pFirst, const UINT* pNum)
+                            {
+                                if (bConstantBufferOffsets)
+                                {
+                                    pDevice->PSSetConstantBuffers1(uStart, uNum, ppBuffers, pFirst, pNum);
+                                }
+                                else
+                                {
+                                    pDevice->PSSetConstantBuffers(uStart, uNum, ppBuffers);
+                                }
+                            });
+                    });
+                uNumStateChanges += bindSlots(state.apVSViews, bound.apVSViews,
+                    [pDevice](UINT uSlot, UINT uNumSlots, ID3D11ShaderResourceView* const* ppViews) { pDevice->VSSetShaderResources(uSlot, uNumSlots, ppViews); });
+
+                uBoundState = record.uState;
+            }
+
+            if (record.uBindings != uBoundBindings)
+            {
+                const DrawBindings& bindings = m_aBindings[record.uBindings];
+
+                uNumStateChanges += bindSlots(bindings.apPSViews, boundBindings.apPSViews,
+                    [pDevice](UINT uSlot, UINT uNumSlots, ID3D11ShaderResourceView* const* ppViews) { pDevice->PSSetShaderResources(uSlot, uNumSlots, ppViews); });
+                uNumStateChanges += bindSlots(bindings.apPSSamplers, boundBindings.apPSSamplers,
+                    [pDevice](UINT uSlot, UINT uNumSlots, ID3D11SamplerState* const* ppSamplers) { pDevice->PSSetSamplers(uSlot, uNumSlots, ppSamplers); });
+
+                uBoundBindings = record.uBindings;
+            }
+
+            if (record.uNumInstances > 0u)
+            {
+                pDevice->DrawIndexedInstanced(record.uNumIndices, record.uNumInstances, record.uStartIndex, record.iBaseVertex, 0u);
+            }
+            else
+            {
+                pDevice->DrawIndexed(record.uNumIndices, record.uStartIndex, record.iBaseVertex);
+            }
+        }
+
+        m_stats.uNumStateChanges = uNumStateChanges;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderQueue::GetStats
+      Summary:  Returns the work of the last submission
+      Returns:  const RenderQueueStats&
+                  Draws, bindings asked for and state changes issued
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const RenderQueueStats& RenderQueue::GetStats() const
+    {
+        return m_stats;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderQueue::getId
+      Summary:  Returns the small id of a state object, the same for
+                the object while the table lasts
+      Args:     const void* pObject
+                  The object, null has the id 0
+                UINT uNumBits
+                  Width of the id in the key, larger ids wrap
+      Modifies: [m_ids].
+      Returns:  UINT
+                  Id of the object
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT RenderQueue::getId(_In_opt_ const void* pObject, _In_ UINT uNumBits)
+    {
+        if (!pObject)
+        {
+            return 0u;
+        }
+
+        const UINT uId = m_ids.try_emplace(pObject, static_cast<UINT>(m_ids.size()) + 1u).first->second;
+
+        return uId & ((1u << uNumBits) - 1u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   RenderQueue::sortItems
+      Summary:  Least significant digit radix sort of the keys, eight
+                passes of 8 bits with every histogram counted in one
+                sweep. Passes over a digit all keys share are skipped,
+                and draws with the same key keep the order they were
+                added in
+      Modifies: [m_aItems, m_aScratchItems].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void RenderQueue::sortItems()
+    {
+        constexpr const UINT NUM_DIGITS = 8u;
+        constexpr const UINT NUM_BUCKETS = 256u;
+
+        const size_t uNumItems = m_aItems.size();
+        if (uNumItems < 2u)
+        {
+            return;
+        }
+
+        UINT aaCounts[NUM_DIGITS][NUM_BUCKETS] = {};
+        for (const SortItem& item : m_aItems)
+        {
+            for (UINT uDigit = 0u; uDigit < NUM_DIGITS; ++uDigit)
+            {
+                ++aaCounts[uDigit][(item.uKey >> (uDigit * 8u)) & 0xFFu];
+            }
+        }
+
+        m_aScratchItems.resize(uNumItems);
+        for (UINT uDigit = 0u; uDigit < NUM_DIGITS; ++uDigit)
+        {
+            const UINT uShift = uDigit * 8u;
+            UINT* aCounts = aaCounts[uDigit];
+            if (aCounts[(m_aItems[0].uKey >> uShift) & 0xFFu] == uNumItems)
+            {
+                continue;
+            }
+
+            UINT uOffset = 0u;
+            for (UINT uBucket = 0u; uBucket < NUM_BUCKETS; ++uBucket)
+            {
+                const UINT uCount = aCounts[uBucket];
+                aCounts[uBucket] = uOffset;
+                uOffset += uCount;
+            }
+
+            for (const SortItem& item : m_aItems)
+            {
+                m_aScratchItems[aCounts[(item.uKey >> uShift) & 0xFFu]++] = item;
+            }
+            m_aItems.swap(m_aScratchItems);
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,191 @@
+/*+===================================================================
+  File:      RENDERQUEUE.H
+
+  Summary:   RenderQueue header file contains declarations of
+             RenderQueue class, the draws of a frame collected with a
+             64-bit sort key and submitted in the order that changes
+             the least pipeline state.
+
+  Classes: RenderQueue
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Renderer/ConstantBufferRing.h"
+#include "Renderer/PipelineState.h"
+#include "Renderer/RenderDevice.h"
+
+namespace library
+{
+    /*E+E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E
+        Enum:     eRenderPass
+
+        Summary:  Passes of a frame in the order they are drawn. The
+                  background and opaque draws are grouped by state and
+                  drawn front to back, the transparent ones back to
+                  front over them
+    E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E-E*/
+    enum class eRenderPass
+    {
+        BACKGROUND,
+        OPAQUE_GEOMETRY,
+        TRANSPARENT_GEOMETRY,
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   DrawState
+
+        Summary:  Pipeline, geometry and constant buffer ranges of an
+                  object, shared by the draws of its meshes. The
+                  pipeline gives the shaders, the strides of the vertex
+                  buffers and the constant buffer slots that are bound,
+                  the ranges of the other slots are dropped. Vertex
+                  buffers are bound from a byte offset, non-zero for
+                  the allocations of an upload arena. A null constant
+                  buffer or view leaves its slot as it is
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct DrawState
+    {
+        static constexpr const UINT MAX_VERTEX_BUFFERS = PipelineStateDesc::MAX_VERTEX_BUFFERS;
+        static constexpr const UINT NUM_CONSTANT_BUFFER_SLOTS = 5u;
+        static constexpr const UINT NUM_VIEW_SLOTS = 6u;
+
+        const PipelineState* pPipelineState;
+        ID3D11Buffer* apVertexBuffers[MAX_VERTEX_BUFFERS];
+        UINT aOffsets[MAX_VERTEX_BUFFERS];
+        ID3D11Buffer* pIndexBuffer;
+        ConstantBufferRange aVSConstantBuffers[NUM_CONSTANT_BUFFER_SLOTS];
+        ConstantBufferRange aPSConstantBuffers[NUM_CONSTANT_BUFFER_SLOTS];
+        ID3D11ShaderResourceView* apVSViews[NUM_VIEW_SLOTS];
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   DrawBindings
+
+        Summary:  Textures and samplers of the pixel shader for the
+                  material of a mesh, a null view or sampler leaves its
+                  slot as it is
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct DrawBindings
+    {
+        static constexpr const UINT NUM_VIEW_SLOTS = 6u;
+        static constexpr const UINT NUM_SAMPLER_SLOTS = 5u;
+
+        ID3D11ShaderResourceView* apPSViews[NUM_VIEW_SLOTS];
+        ID3D11SamplerState* apPSSamplers[NUM_SAMPLER_SLOTS];
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   DrawRecord
+
+        Summary:  One draw, the indices of its state and bindings in
+                  the queue and the range to draw. Zero instances draws
+                  without instancing
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct DrawRecord
+    {
+        UINT uState;
+        UINT uBindings;
+        UINT uNumIndices;
+        UINT uNumInstances;
+        UINT uStartIndex;
+        INT iBaseVertex;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   RenderQueueStats
+
+        Summary:  Work of the last submission. Bindings are the state
+                  calls the draws ask for, what binding the whole state
+                  of every draw costs, state changes the calls issued
+                  once the sorted draws skip what is already bound.
+                  Pipeline changes are the draws whose pipeline differs
+                  from the one of the previous draw
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct RenderQueueStats
+    {
+        UINT64 uNumDraws;
+        UINT64 uNumTransparentDraws;
+        UINT64 uNumBindings;
+        UINT64 uNumStateChanges;
+        UINT64 uNumPipelineChanges;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    RenderQueue
+
+      Summary:  Draws of a frame. Every draw gets a 64-bit key: the
+                pass in the top bits, then the pipeline, the texture set
+                and the geometry with the quantized distance from the
+                camera last, or the distance first and inverted for the
+                transparent pass. The keys are radix sorted, so draws
+                sharing pipelines and textures end up next to each other
+                and the transparent ones are blended back to front, and
+                the submission only issues the state that differs from
+                what the previous draw bound
+
+      Methods:  Reset
+                  Empties the queue for a new frame
+                AddState
+                  Adds the state of an object
+                AddBindings
+                  Adds the textures of a material
+                AddDraw
+                  Adds a draw of a state and bindings
+                Submit
+                  Sorts the draws and issues them
+                GetStats
+                  Returns the work of the last submission
+                RenderQueue
+                  Constructor.
+                ~RenderQueue
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class RenderQueue
+    {
+    public:
+        RenderQueue();
+        RenderQueue(const RenderQueue& other) = delete;
+        RenderQueue(RenderQueue&& other) = delete;
+        RenderQueue& operator=(const RenderQueue& other) = delete;
+        RenderQueue& operator=(RenderQueue&& other) = delete;
+        ~RenderQueue() = default;
+
+        void Reset(_In_ const XMFLOAT3& eye, _In_ FLOAT farDistance);
+        UINT AddState(_In_ const DrawState& state);
+        UINT AddBindings(_In_ const DrawBindings& bindings);
+        void AddDraw(_In_ eRenderPass pass, _In_ const XMFLOAT3& position, _In_ const DrawRecord& record);
+        void Submit(_In_ RenderDevice* pDevice);
+
+        const RenderQueueStats& GetStats() const;
+
+    private:
+        struct SortItem
+        {
+            UINT64 uKey;
+            UINT uRecord;
+        };
+
+        UINT getId(_In_opt_ const void* pObject, _In_ UINT uNumBits);
+        void sortItems();
+
+    private:
+        static constexpr const UINT DEPTH_BITS = 24u;
+
+        // Ids only group the keys, so the table restarts once streamed buffers have filled it
+        static constexpr const size_t MAX_IDS = 1u << 16u;
+
+        XMFLOAT3 m_eye;
+        FLOAT m_farDistance;
+        std::vector<DrawState> m_aStates;
+        std::vector<DrawBindings> m_aBindings;
+        std::vector<DrawRecord> m_aRecords;
+        std::vector<SortItem> m_aItems;
+        std::vector<SortItem> m_aScratchItems;
+        std::unordered_map<const void*, UINT> m_ids;
+        RenderQueueStats m_stats;
+    };
+}
\ No newline at end of file
@@ -13,10 +13,10 @@ namespace library
       Summary:  Constructor
       Args:     const XMFLOAT4* outputColor
                   Default color of the renderable
-      Modifies: [m_vertexBuffer, m_indexBuffer, m_constantBuffer,
+      Modifies: [m_vertexBuffer, m_indexBuffer,
                  m_textureRV, m_samplerLinear, m_vertexShader,
-                 m_pixelShader, m_textureFilePath, m_outputColor,
-                 m_world].
+                 m_pixelShader, m_pPipelineState, m_textureFilePath,
+                 m_outputColor, m_world].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     /*--------------------------------------------------------------------
       TODO: Renderable::Renderable definition (remove the comment)
@@ -24,9 +24,9 @@ namespace library
     Renderable::Renderable(_In_ const XMFLOAT4& outputColor)
         : m_vertexBuffer(nullptr),
         m_indexBuffer(nullptr),
-        m_constantBuffer(nullptr),
         m_vertexShader(nullptr),
         m_pixelShader(nullptr),
+        m_pPipelineState(nullptr),
         m_outputColor(outputColor),
         m_world(XMMatrixIdentity()),
         m_aMeshes(),
@@ -40,11 +40,9 @@ namespace library
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Renderable::initialize
       Summary:  Initializes the buffers, texture, and the world matrix
-      Args:     ID3D11Device* pDevice
-                  The Direct3D device to create the buffers
-                ID3D11DeviceContext* pImmediateContext
-                  The Direct3D context to set buffers
-      Modifies: [m_vertexBuffer, m_indexBuffer, m_constantBuffer,
+      Args:     RenderDevice* pDevice
+                  The render device to create the buffers
+      Modifies: [m_vertexBuffer, m_indexBuffer,
                  m_textureRV, m_samplerLinear, m_world].
       Returns:  HRESULT
                   Status code
@@ -53,7 +51,7 @@ namespace library
       TODO: Renderable::initialize definition (remove the comment)
     --------------------------------------------------------------------*/
 
-    HRESULT Renderable::initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext) {
+    HRESULT Renderable::initialize(_In_ RenderDevice* pDevice) {
         HRESULT hr;
 
 
@@ -100,17 +98,6 @@ namespace library
             return hr;
         ///////
 
-
-        //Create the constant buffer
-        bd.Usage = D3D11_USAGE_DEFAULT;
-        bd.ByteWidth = sizeof(CBChangesEveryFrame);
-        bd.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
-        bd.CPUAccessFlags = 0;
-
-        hr = pDevice->CreateBuffer(&bd, nullptr, m_constantBuffer.GetAddressOf());
-        if (FAILED(hr))
-            return hr;
-
         return S_OK;
     }
 
@@ -120,10 +107,11 @@ namespace library
                 object
       Args:     const std::shared_ptr<VertexShader>& vertexShader
                   Vertex shader to set to
-      Modifies: [m_vertexShader].
+      Modifies: [m_vertexShader, m_pPipelineState].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     void Renderable::SetVertexShader(_In_ const std::shared_ptr<VertexShader>& vertexShader) {
         m_vertexShader = vertexShader;
+        m_pPipelineState = nullptr;
     }
 
 
@@ -133,10 +121,25 @@ namespace library
                 object
       Args:     const std::shared_ptr<PixelShader>& pixelShader
                   Pixel shader to set to
-      Modifies: [m_pixelShader].
+      Modifies: [m_pixelShader, m_pPipelineState].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     void Renderable::SetPixelShader(_In_ const std::shared_ptr<PixelShader>& pixelShader) {
         m_pixelShader = pixelShader;
+        m_pPipelineState = nullptr;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderable::SetPipelineState
+      Summary:  Sets the pipeline the renderable is drawn with, shared
+                with the renderables of the same shaders and streams.
+                Changing a shader clears it
+      Args:     const PipelineState* pPipelineState
+                  Pipeline owned by the pipeline state cache of the
+                  renderer
+      Modifies: [m_pPipelineState].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderable::SetPipelineState(_In_opt_ const PipelineState* pPipelineState) {
+        m_pPipelineState = pPipelineState;
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -169,6 +172,16 @@ namespace library
         return m_vertexShader->GetVertexLayout();
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderable::GetPipelineState
+      Summary:  Returns the pipeline the renderable is drawn with
+      Returns:  const PipelineState*
+                  Pipeline, null until the renderer creates it
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const PipelineState* Renderable::GetPipelineState() const {
+        return m_pPipelineState;
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Renderable::GetVertexBuffer
       Summary:  Returns the vertex buffer
@@ -189,16 +202,6 @@ namespace library
         return m_indexBuffer;
     }
 
-    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Renderable::GetConstantBuffer
-      Summary:  Returns the constant buffer
-      Returns:  ComPtr<ID3D11Buffer>&
-                  Constant buffer
-    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    ComPtr<ID3D11Buffer>& Renderable::GetConstantBuffer() {
-        return m_constantBuffer;
-    }
-
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
     Method:   Renderable::GetNormalBuffer
 
@@ -14,6 +14,8 @@
 #include "Common.h"
 
 #include "Renderer/DataTypes.h"
+#include "Renderer/PipelineState.h"
+#include "Renderer/RenderDevice.h"
 #include "Shader/PixelShader.h"
 #include "Shader/VertexShader.h"
 #include "Texture/Material.h"
@@ -35,10 +37,11 @@ namespace library
                   Returns the vertex buffer
                 GetIndexBuffer
                   Returns the index buffer
-                GetConstantBuffer
-                  Returns the constant buffer
                 GetWorldMatrix
                   Returns the world matrix
+                SetPipelineState / GetPipelineState
+                  Set and return the pipeline the renderable is drawn
+                  with
                 GetNumVertices
                   Pure virtual function that returns the number of
                   vertices
@@ -80,11 +83,12 @@ namespace library
         Renderable& operator=(Renderable&& other) = delete;
         virtual ~Renderable() = default;
 
-        virtual HRESULT Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext) = 0;
+        virtual HRESULT Initialize(_In_ RenderDevice* pDevice) = 0;
         virtual void Update(_In_ FLOAT deltaTime) = 0;
 
         void SetVertexShader(_In_ const std::shared_ptr<VertexShader>& vertexShader);
         void SetPixelShader(_In_ const std::shared_ptr<PixelShader>& pixelShader);
+        void SetPipelineState(_In_opt_ const PipelineState* pPipelineState);
 
         void AddMaterial(_In_ const std::shared_ptr<Material>& material);
         HRESULT SetMaterialOfMesh(_In_ const UINT uMeshIndex, _In_ const UINT uMaterialIndex);
@@ -92,9 +96,9 @@ namespace library
         ComPtr<ID3D11VertexShader>& GetVertexShader();
         ComPtr<ID3D11PixelShader>& GetPixelShader();
         ComPtr<ID3D11InputLayout>& GetVertexLayout();
+        const PipelineState* GetPipelineState() const;
         ComPtr<ID3D11Buffer>& GetVertexBuffer();
         ComPtr<ID3D11Buffer>& GetIndexBuffer();
-        ComPtr<ID3D11Buffer>& GetConstantBuffer();
         ComPtr<ID3D11Buffer>& GetNormalBuffer();
 
         const XMMATRIX& GetWorldMatrix() const;
@@ -121,8 +125,7 @@ namespace library
         const virtual SimpleVertex* getVertices() const = 0;
         virtual const WORD* getIndices() const = 0;
         virtual HRESULT initialize(
-            _In_ ID3D11Device* pDevice,
-            _In_ ID3D11DeviceContext* pImmediateContext
+            _In_ RenderDevice* pDevice
         );
 
         void calculateNormalMapVectors();
@@ -131,7 +134,6 @@ namespace library
     protected:
         ComPtr<ID3D11Buffer> m_vertexBuffer;
         ComPtr<ID3D11Buffer> m_indexBuffer;
-        ComPtr<ID3D11Buffer> m_constantBuffer;
         ComPtr<ID3D11Buffer> m_normalBuffer;
 
         std::vector<BasicMeshEntry> m_aMeshes;
@@ -140,6 +142,7 @@ namespace library
 
         std::shared_ptr<VertexShader> m_vertexShader;
         std::shared_ptr<PixelShader> m_pixelShader;
+        const PipelineState* m_pPipelineState;
 
         XMFLOAT4 m_outputColor;
         BYTE m_padding[8];
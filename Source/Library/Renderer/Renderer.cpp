@@ -1,18 +1,98 @@
 ﻿#include "Renderer/Renderer.h"
 
+#include "Renderer/D3D11RenderDevice.h"
+
 namespace library
 {
+    namespace
+    {
+        // Constant buffer slots of the shaders, as bits of the slot masks of a pipeline
+        constexpr const UINT CAMERA_CONSTANTS = 1u << 0u;
+        constexpr const UINT PROJECTION_CONSTANTS = 1u << 1u;
+        constexpr const UINT OBJECT_CONSTANTS = 1u << 2u;
+        constexpr const UINT LIGHT_CONSTANTS = 1u << 3u;
+        constexpr const UINT MESH_CONSTANTS = 1u << 4u;
+
+        constexpr const UINT VS_CONSTANTS = CAMERA_CONSTANTS | PROJECTION_CONSTANTS | OBJECT_CONSTANTS | LIGHT_CONSTANTS;
+        constexpr const UINT PS_CONSTANTS = CAMERA_CONSTANTS | OBJECT_CONSTANTS | LIGHT_CONSTANTS;
+
+        // Vertex streams and constant buffers of each kind of renderable, the shaders and the layout are its own
+        constexpr const PipelineStateDesc SKY_BOX_PIPELINE =
+        {
+            .aStrides = { sizeof(SimpleVertex), sizeof(NormalData) },
+            .uNumVertexBuffers = 2u,
+            .indexFormat = DXGI_FORMAT_R16_UINT,
+            .topology = D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST,
+            .uVSConstantBufferSlots = VS_CONSTANTS,
+            .uPSConstantBufferSlots = CAMERA_CONSTANTS | PROJECTION_CONSTANTS | OBJECT_CONSTANTS
+        };
+
+        constexpr const PipelineStateDesc RENDERABLE_PIPELINE =
+        {
+            .aStrides = { sizeof(SimpleVertex), sizeof(NormalData) },
+            .uNumVertexBuffers = 2u,
+            .indexFormat = DXGI_FORMAT_R16_UINT,
+            .topology = D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST,
+            .uVSConstantBufferSlots = VS_CONSTANTS,
+            .uPSConstantBufferSlots = PS_CONSTANTS
+        };
+
+        // The instance stride depends on the instance format of the scene
+        constexpr const PipelineStateDesc VOXEL_PIPELINE =
+        {
+            .aStrides = { sizeof(SimpleVertex), sizeof(NormalData), 0u },
+            .uNumVertexBuffers = 3u,
+            .indexFormat = DXGI_FORMAT_R16_UINT,
+            .topology = D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST,
+            .uVSConstantBufferSlots = VS_CONSTANTS,
+            .uPSConstantBufferSlots = PS_CONSTANTS
+        };
+
+        constexpr const PipelineStateDesc VOXEL_CHUNK_PIPELINE =
+        {
+            .aStrides = { sizeof(SimpleVertex), sizeof(XMFLOAT4) },
+            .uNumVertexBuffers = 2u,
+            .indexFormat = DXGI_FORMAT_R16_UINT,
+            .topology = D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST,
+            .uVSConstantBufferSlots = VS_CONSTANTS,
+            .uPSConstantBufferSlots = PS_CONSTANTS
+        };
+
+        constexpr const PipelineStateDesc TERRAIN_PIPELINE =
+        {
+            .aStrides = { sizeof(SimpleVertex), sizeof(TerrainPatchData) },
+            .uNumVertexBuffers = 2u,
+            .indexFormat = DXGI_FORMAT_R16_UINT,
+            .topology = D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST,
+            .uVSConstantBufferSlots = VS_CONSTANTS | MESH_CONSTANTS,
+            .uPSConstantBufferSlots = PS_CONSTANTS
+        };
+
+        constexpr const PipelineStateDesc MODEL_PIPELINE =
+        {
+            .aStrides = { sizeof(SimpleVertex), sizeof(NormalData), sizeof(AnimationData) },
+            .uNumVertexBuffers = 3u,
+            .indexFormat = DXGI_FORMAT_R16_UINT,
+            .topology = D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST,
+            .uVSConstantBufferSlots = VS_CONSTANTS | MESH_CONSTANTS,
+            .uPSConstantBufferSlots = PS_CONSTANTS | PROJECTION_CONSTANTS
+        };
+    }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Renderer::Renderer
       Summary:  Constructor
       Modifies: [m_driverType, m_featureLevel, m_d3dDevice, m_d3dDevice1,
-                  m_immediateContext, m_immediateContext1, m_swapChain,
+                  m_immediateContext, m_immediateContext1, m_renderDevice,
+                  m_stateFilter, m_swapChain,
                   m_swapChain1, m_renderTargetView, m_depthStencil,
-                  m_depthStencilView, m_cbChangeOnResize, m_cbShadowMatrix,
-                  m_pszMainSceneName, m_camera, m_projection, m_scenes
+                  m_depthStencilView, m_cbShadowMatrix,
+                  m_pszMainSceneName, m_camera, m_projection,
+                  m_projectionScale, m_scenes
                   m_invalidTexture, m_shadowMapTexture, m_shadowVertexShader,
-                  m_shadowPixelShader].
+                  m_shadowPixelShader, m_renderQueue, m_constantBufferRing,
+                  m_cameraConstants, m_projectionConstants, m_lightConstants,
+                  m_vertexUploadArena, m_pipelineStates].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     Renderer::Renderer()
         : m_driverType(D3D_DRIVER_TYPE_NULL)
@@ -21,23 +101,31 @@ namespace library
         , m_d3dDevice1(nullptr)
         , m_immediateContext(nullptr)
         , m_immediateContext1(nullptr)
+        , m_renderDevice()
+        , m_stateFilter()
         , m_swapChain(nullptr)
         , m_swapChain1(nullptr)
         , m_renderTargetView(nullptr)
         , m_depthStencil(nullptr)
         , m_depthStencilView(nullptr)
-        , m_cbChangeOnResize(nullptr)
-        , m_cbLights(nullptr)
         , m_cbShadowMatrix(nullptr)
         , m_pszMainSceneName(nullptr)
         , m_padding{ '\0' }
         , m_camera(XMVectorSet(0.0f, 3.0f, -6.0f, 0.0f))
         , m_projection()
+        , m_projectionScale(1.0f)
         , m_scenes()
         , m_invalidTexture(std::make_shared<Texture>(L"Content/Common/InvalidTexture.png"))
         , m_shadowMapTexture()
         , m_shadowVertexShader()
         , m_shadowPixelShader()
+        , m_renderQueue()
+        , m_constantBufferRing()
+        , m_cameraConstants()
+        , m_projectionConstants()
+        , m_lightConstants()
+        , m_vertexUploadArena(D3D11_BIND_VERTEX_BUFFER, UploadArena::DEFAULT_PAGE_SIZE)
+        , m_pipelineStates()
     { }
 
 
@@ -47,10 +135,8 @@ namespace library
       Args:     HWND hWnd
                   Handle to the window
       Modifies: [m_d3dDevice, m_featureLevel, m_immediateContext,
-                  m_d3dDevice1, m_immediateContext1, m_swapChain1,
-                  m_swapChain, m_renderTargetView, m_vertexShader,
-                  m_vertexLayout, m_pixelShader, m_vertexBuffer
-                  m_cbShadowMatrix].
+                  m_d3dDevice1, m_immediateContext1, m_renderDevice,
+                  m_swapChain1, m_swapChain, m_renderTargetView].
       Returns:  HRESULT
                   Status code
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
@@ -108,6 +194,10 @@ namespace library
             return hr;
         }
 
+        // Every call goes through the state filter, so the redundant bindings never reach the driver
+        m_stateFilter = std::make_shared<StateFilterRenderDevice>(std::make_shared<D3D11RenderDevice>(m_d3dDevice.Get(), m_immediateContext.Get()));
+        m_renderDevice = m_stateFilter;
+
         // Obtain DXGI factory from device (since we used nullptr for pAdapter above)
         ComPtr<IDXGIFactory1> dxgiFactory;
         {
@@ -188,12 +278,103 @@ namespace library
             return hr;
         }
 
-        hr = m_d3dDevice->CreateRenderTargetView(pBackBuffer.Get(), nullptr, m_renderTargetView.GetAddressOf());
+        hr = m_renderDevice->CreateRenderTargetView(pBackBuffer.Get(), nullptr, m_renderTargetView.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        return initializeResources(uWidth, uHeight);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::InitializeHeadless
+      Summary:  Initializes the renderer on the given render device
+                without a window, rendering into an offscreen target and
+                presenting nothing, so that the frames can be measured
+                on machines without a GPU
+      Args:     const std::shared_ptr<RenderDevice>& renderDevice
+                  Render device to create the resources and draw with
+                UINT uWidth
+                  Width of the offscreen target
+                UINT uHeight
+                  Height of the offscreen target
+      Modifies: [m_renderDevice, m_stateFilter, m_renderTargetView].
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Renderer::InitializeHeadless(_In_ const std::shared_ptr<RenderDevice>& renderDevice, _In_ UINT uWidth, _In_ UINT uHeight)
+    {
+        if (!renderDevice || uWidth == 0u || uHeight == 0u)
+        {
+            return E_INVALIDARG;
+        }
+
+        m_stateFilter = std::make_shared<StateFilterRenderDevice>(renderDevice);
+        m_renderDevice = m_stateFilter;
+
+        D3D11_TEXTURE2D_DESC descTarget =
+        {
+            .Width = uWidth,
+            .Height = uHeight,
+            .MipLevels = 1u,
+            .ArraySize = 1u,
+            .Format = DXGI_FORMAT_R8G8B8A8_UNORM,
+            .SampleDesc = {.Count = 1u, .Quality = 0u },
+            .Usage = D3D11_USAGE_DEFAULT,
+            .BindFlags = D3D11_BIND_RENDER_TARGET,
+            .CPUAccessFlags = 0u,
+            .MiscFlags = 0u
+        };
+        ComPtr<ID3D11Texture2D> target;
+        HRESULT hr = m_renderDevice->CreateTexture2D(&descTarget, nullptr, target.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        hr = m_renderDevice->CreateRenderTargetView(target.Get(), nullptr, m_renderTargetView.GetAddressOf());
         if (FAILED(hr))
         {
             return hr;
         }
 
+        return initializeResources(uWidth, uHeight);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::GetRenderDevice
+      Summary:  Returns the render device
+      Returns:  std::shared_ptr<RenderDevice>
+                  Render device, null before the initialization
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    std::shared_ptr<RenderDevice> Renderer::GetRenderDevice() const
+    {
+        return m_renderDevice;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::initializeResources
+      Summary:  Creates the depth buffer, the viewport, the constant
+                buffer ring, the shadow matrix buffer and the shadow
+                map, then initializes the main scene, the pipelines of
+                its renderables and the fallback texture on the render
+                device
+      Args:     UINT uWidth
+                  Width of the render target
+                UINT uHeight
+                  Height of the render target
+      Modifies: [m_depthStencil, m_depthStencilView, m_projection,
+                  m_projectionScale, m_constantBufferRing,
+                  m_cbShadowMatrix, m_shadowMapTexture,
+                  m_pipelineStates, m_invalidTexture].
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Renderer::initializeResources(_In_ UINT uWidth, _In_ UINT uHeight)
+    {
+        HRESULT hr = S_OK;
+
         // Create depth stencil texture
         D3D11_TEXTURE2D_DESC descDepth =
         {
@@ -208,7 +389,7 @@ namespace library
             .CPUAccessFlags = 0u,
             .MiscFlags = 0u
         };
-        hr = m_d3dDevice->CreateTexture2D(&descDepth, nullptr, m_depthStencil.GetAddressOf());
+        hr = m_renderDevice->CreateTexture2D(&descDepth, nullptr, m_depthStencil.GetAddressOf());
         if (FAILED(hr))
         {
             return hr;
@@ -221,13 +402,13 @@ namespace library
             .ViewDimension = D3D11_DSV_DIMENSION_TEXTURE2D,
             .Texture2D = {.MipSlice = 0 }
         };
-        hr = m_d3dDevice->CreateDepthStencilView(m_depthStencil.Get(), &descDSV, m_depthStencilView.GetAddressOf());
+        hr = m_renderDevice->CreateDepthStencilView(m_depthStencil.Get(), &descDSV, m_depthStencilView.GetAddressOf());
         if (FAILED(hr))
         {
             return hr;
         }
 
-        m_immediateContext->OMSetRenderTargets(1, m_renderTargetView.GetAddressOf(), m_depthStencilView.Get());
+        m_renderDevice->OMSetRenderTargets(1, m_renderTargetView.GetAddressOf(), m_depthStencilView.Get());
 
         // Setup the viewport
         D3D11_VIEWPORT vp =
@@ -239,21 +420,12 @@ namespace library
             .MinDepth = 0.0f,
             .MaxDepth = 1.0f,
         };
-        m_immediateContext->RSSetViewports(1, &vp);
-
-        // Set primitive topology
-        m_immediateContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+        m_renderDevice->RSSetViewports(1, &vp);
 
-        // Create the constant buffers
-        D3D11_BUFFER_DESC bd =
-        {
-            .ByteWidth = sizeof(CBChangeOnResize),
-            .Usage = D3D11_USAGE_DEFAULT,
-            .BindFlags = D3D11_BIND_CONSTANT_BUFFER,
-            .CPUAccessFlags = 0
-        };
+        // The primitive topology is part of the pipeline of every draw
 
-        hr = m_d3dDevice->CreateBuffer(&bd, nullptr, m_cbChangeOnResize.GetAddressOf());
+        // The constants of every frame are written to the ring, bound from an offset where the device supports it
+        hr = m_constantBufferRing.Initialize(m_renderDevice.get());
 
         if (FAILED(hr))
         {
@@ -261,26 +433,10 @@ namespace library
         }
 
         // Initialize the projection matrix
-        m_projection = XMMatrixPerspectiveFovLH(XM_PIDIV4, static_cast<FLOAT>(uWidth) / static_cast<FLOAT>(uHeight), 0.01f, 1000.0f);
-
-        CBChangeOnResize cbChangesOnResize =
-        {
-            .Projection = XMMatrixTranspose(m_projection)
-        };
-        m_immediateContext->UpdateSubresource(m_cbChangeOnResize.Get(), 0, nullptr, &cbChangesOnResize, 0, 0);
-        m_immediateContext->VSSetConstantBuffers(1u, 1u, m_cbChangeOnResize.GetAddressOf());
-
-        bd.ByteWidth = sizeof(CBLights);
-        bd.Usage = D3D11_USAGE_DEFAULT;
-        bd.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
-        bd.CPUAccessFlags = 0u;
+        m_projection = XMMatrixPerspectiveFovLH(XM_PIDIV4, static_cast<FLOAT>(uWidth) / static_cast<FLOAT>(uHeight), 0.01f, FAR_DISTANCE);
 
-        hr = m_d3dDevice->CreateBuffer(&bd, nullptr, m_cbLights.GetAddressOf());
-
-        if (FAILED(hr))
-        {
-            return hr;
-        }
+        // Pixels covered by one world unit at a distance of one unit, used to pick the levels of detail
+        m_projectionScale = static_cast<FLOAT>(uHeight) / (2.0f * tanf(XM_PIDIV4 / 2.0f));
 
         D3D11_BUFFER_DESC cbShadowMatrix =
         {
@@ -290,7 +446,7 @@ namespace library
             .CPUAccessFlags = 0u
         };
 
-        hr = m_d3dDevice->CreateBuffer(&cbShadowMatrix, nullptr, m_cbShadowMatrix.GetAddressOf());
+        hr = m_renderDevice->CreateBuffer(&cbShadowMatrix, nullptr, m_cbShadowMatrix.GetAddressOf());
 
         if (FAILED(hr))
         {
@@ -299,7 +455,7 @@ namespace library
 
         m_shadowMapTexture = std::make_shared<RenderTexture>(uWidth, uHeight);
 
-        hr = m_shadowMapTexture->Initialize(m_d3dDevice.Get(), m_immediateContext.Get());
+        hr = m_shadowMapTexture->Initialize(m_renderDevice.get());
 
         if (FAILED(hr))
         {
@@ -316,16 +472,21 @@ namespace library
             m_scenes[m_pszMainSceneName]->GetPointLight(i)->Initialize(uWidth, uHeight);
         }
 
-        m_camera.Initialize(m_d3dDevice.Get());
+        hr = m_scenes[m_pszMainSceneName]->Initialize(m_renderDevice.get());
+
+        if (FAILED(hr))
+        {
+            return hr;
+        }
 
-        hr = m_scenes[m_pszMainSceneName]->Initialize(m_d3dDevice.Get(), m_immediateContext.Get());
+        hr = createPipelineStates(*m_scenes[m_pszMainSceneName]);
 
         if (FAILED(hr))
         {
             return hr;
         }
 
-        hr = m_invalidTexture->Initialize(m_d3dDevice.Get(), m_immediateContext.Get());
+        hr = m_invalidTexture->Initialize(m_renderDevice.get());
 
         if (FAILED(hr))
         {
@@ -427,7 +588,9 @@ namespace library
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Renderer::Update
-      Summary:  Update the renderables each frame
+      Summary:  Update the renderables each frame, then stream the
+                voxel chunks around the moved camera and cull the ones
+                hidden behind the terrain
       Args:     FLOAT deltaTime
                   Time difference of a frame
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
@@ -436,33 +599,56 @@ namespace library
         m_scenes[m_pszMainSceneName]->Update(deltaTime);
 
         m_camera.Update(deltaTime);
+
+        m_scenes[m_pszMainSceneName]->UpdateStreaming(m_camera.GetEye());
+        m_scenes[m_pszMainSceneName]->UpdateLevelOfDetail(m_camera.GetEye(), m_projectionScale);
+        m_scenes[m_pszMainSceneName]->UpdateOcclusion(m_camera.GetEye());
     }
 
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Renderer::Render
-      Summary:  Render the frame
+      Summary:  Render the frame. The draws of every scene are
+                collected in the render queue and submitted sorted by
+                state, the transparent ones back to front. The constants
+                of the frame are written to the constant buffer ring
+                while the draws are collected and bound as ranges of it,
+                the instances drawn only this frame go to the vertex
+                upload arena
+      Modifies: [m_renderQueue, m_stateFilter,
+                 m_constantBufferRing, m_cameraConstants,
+                 m_projectionConstants, m_lightConstants,
+                 m_vertexUploadArena].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     void Renderer::Render()
     {
+        m_stateFilter->ResetStats();
+
         // RenderSceneToTexture();
 
         // Clear the back buffer
-        m_immediateContext->ClearRenderTargetView(m_renderTargetView.Get(), Colors::MidnightBlue);
+        m_renderDevice->ClearRenderTargetView(m_renderTargetView.Get(), Colors::MidnightBlue);
 
         // Clear the depth buffer to 1.0 (maximum depth)
-        m_immediateContext->ClearDepthStencilView(m_depthStencilView.Get(), D3D11_CLEAR_DEPTH, 1.0f, 0u);
+        m_renderDevice->ClearDepthStencilView(m_depthStencilView.Get(), D3D11_CLEAR_DEPTH, 1.0f, 0u);
+
+        // Upload the blocks edited this frame, only the changed instances
+        m_scenes[m_pszMainSceneName]->FlushVoxelEdits(m_renderDevice.get());
 
-        m_camera.Initialize(m_d3dDevice.Get());
+        // Camera, projection and lights are written once and shared by every draw
+        m_constantBufferRing.Begin();
+        m_vertexUploadArena.Begin();
 
-        // Update the camera constant buffer
         CBChangeOnCameraMovement cbChangeOnCameraMovement =
         {
             .View = XMMatrixTranspose(m_camera.GetView()),
         };
         XMStoreFloat4(&cbChangeOnCameraMovement.CameraPosition, m_camera.GetEye());
 
-        m_immediateContext->UpdateSubresource(m_camera.GetConstantBuffer().Get(), 0u, nullptr, &cbChangeOnCameraMovement, 0u, 0u);
+        CBChangeOnResize cbChangeOnResize =
+        {
+            .Projection = XMMatrixTranspose(m_projection)
+        };
 
         CBLights cbLights = {};
 
@@ -477,408 +663,746 @@ namespace library
             cbLights.LightAttenuationDistance[i] = XMFLOAT4(attenuationDistance, attenuationDistance, attenuationDistanceSquared, attenuationDistanceSquared);
         }
 
-        m_immediateContext->UpdateSubresource(m_cbLights.Get(), 0u, nullptr, &cbLights, 0u, 0u);
+        if (FAILED(m_constantBufferRing.Allocate(m_renderDevice.get(), cbChangeOnCameraMovement, m_cameraConstants))
+            || FAILED(m_constantBufferRing.Allocate(m_renderDevice.get(), cbChangeOnResize, m_projectionConstants))
+            || FAILED(m_constantBufferRing.Allocate(m_renderDevice.get(), cbLights, m_lightConstants)))
+        {
+            m_constantBufferRing.End(m_renderDevice.get());
+            m_vertexUploadArena.End(m_renderDevice.get());
+            m_constantBufferRing.Fence(m_renderDevice.get());
+            m_vertexUploadArena.Fence(m_renderDevice.get());
+            return;
+        }
+
+        // Collect the draws of every scene, the queue orders them to change the least state
+        XMFLOAT3 eye;
+        XMStoreFloat3(&eye, m_camera.GetEye());
+        m_renderQueue.Reset(eye, FAR_DISTANCE);
+
+        queueSkyBox(*m_scenes[m_pszMainSceneName]);
+        for (auto scene = m_scenes.begin(); scene != m_scenes.end(); ++scene)
+        {
+            queueRenderables(*scene->second);
+            queueVoxels(*scene->second);
+            queueVoxelChunks(*scene->second);
+            queueTerrain(*scene->second);
+            queueModels(*scene->second);
+        }
+
+        m_constantBufferRing.End(m_renderDevice.get());
+        m_vertexUploadArena.End(m_renderDevice.get());
+        m_renderQueue.Submit(m_renderDevice.get());
+
+        // The pages are reused once the GPU has drawn from them, so they are fenced behind the draws
+        m_constantBufferRing.Fence(m_renderDevice.get());
+        m_vertexUploadArena.Fence(m_renderDevice.get());
+
+        // Present the information rendered to the back buffer to the front buffer
+        if (m_swapChain)
+        {
+            m_swapChain->Present(0u, 0u);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::GetRenderQueueStats
+      Summary:  Returns the draws and state changes of the last frame
+      Returns:  const RenderQueueStats&
+                  Work of the last submission of the render queue
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const RenderQueueStats& Renderer::GetRenderQueueStats() const
+    {
+        return m_renderQueue.GetStats();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::GetStateFilterStats
+      Summary:  Returns the state calls the state filter issued and
+                dropped in the last frame
+      Returns:  StateFilterStats
+                  Counters of the state filter, zero before the
+                  initialization
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    StateFilterStats Renderer::GetStateFilterStats() const
+    {
+        return m_stateFilter ? m_stateFilter->GetStats() : StateFilterStats();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::GetConstantBufferRingStats
+      Summary:  Returns the maps and bytes of the constants uploaded in
+                the last frame
+      Returns:  const ConstantBufferRingStats&
+                  Work of the constant buffer ring
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const ConstantBufferRingStats& Renderer::GetConstantBufferRingStats() const
+    {
+        return m_constantBufferRing.GetStats();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::GetVertexUploadArena
+      Summary:  Returns the arena of the vertex and instance data drawn
+                only this frame
+      Returns:  UploadArena&
+                  Arena of dynamic vertex buffers
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UploadArena& Renderer::GetVertexUploadArena()
+    {
+        return m_vertexUploadArena;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::GetPipelineStateCache
+      Summary:  Returns the pipelines the renderables share
+      Returns:  const PipelineStateCache&
+                  Unique pipelines and the renderables that asked for
+                  them
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const PipelineStateCache& Renderer::GetPipelineStateCache() const
+    {
+        return m_pipelineStates;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::createPipelineStates
+      Summary:  Gives every renderable of an initialized scene its
+                pipeline, the renderables of the same shaders and
+                streams the same one. Chunks streamed in later get
+                theirs from the same cache the first frame they are
+                drawn
+      Args:     Scene& scene
+                  The initialized scene
+      Modifies: [m_pipelineStates].
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Renderer::createPipelineStates(_In_ Scene& scene)
+    {
+        HRESULT hr = S_OK;
+        const PipelineState* pPipelineState = nullptr;
 
-        if (m_scenes[m_pszMainSceneName]->GetSkyBox())
+        if (scene.GetSkyBox() && scene.GetSkyBox()->HasTexture())
         {
-            UINT aStrides[2] =
+            hr = getPipelineState(*scene.GetSkyBox(), SKY_BOX_PIPELINE, pPipelineState);
+            if (FAILED(hr))
             {
-                sizeof(SimpleVertex),
-                sizeof(NormalData)
-            };
-            UINT aOffsets[2] = { 0u, 0u };
+                return hr;
+            }
+        }
 
-            ComPtr<ID3D11Buffer> aBuffers[2] =
+        for (auto renderable = scene.GetRenderables().begin(); renderable != scene.GetRenderables().end(); ++renderable)
+        {
+            hr = getPipelineState(*renderable->second, RENDERABLE_PIPELINE, pPipelineState);
+            if (FAILED(hr))
             {
-                m_scenes[m_pszMainSceneName]->GetSkyBox()->GetVertexBuffer().Get(),
-                m_scenes[m_pszMainSceneName]->GetSkyBox()->GetNormalBuffer().Get()
-            };
+                return hr;
+            }
+        }
 
-            // Set the vertex buffer
-            m_immediateContext->IASetVertexBuffers(0u, 2u, aBuffers->GetAddressOf(), aStrides, aOffsets);
+        for (const std::shared_ptr<Voxel>& voxel : scene.GetVoxels())
+        {
+            PipelineStateDesc voxelPipeline = VOXEL_PIPELINE;
+            voxelPipeline.aStrides[2] = voxel->GetInstanceStride();
+            hr = getPipelineState(*voxel, voxelPipeline, pPipelineState);
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+        }
 
-            // Set the index buffer
-            m_immediateContext->IASetIndexBuffer(m_scenes[m_pszMainSceneName]->GetSkyBox()->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0u);
+        for (const std::shared_ptr<VoxelChunk>& voxelChunk : scene.GetVoxelChunks())
+        {
+            hr = getPipelineState(*voxelChunk, VOXEL_CHUNK_PIPELINE, pPipelineState);
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+        }
 
-            // Set the input layout
-            m_immediateContext->IASetInputLayout(m_scenes[m_pszMainSceneName]->GetSkyBox()->GetVertexLayout().Get());
+        if (scene.GetTerrain())
+        {
+            hr = getPipelineState(*scene.GetTerrain(), TERRAIN_PIPELINE, pPipelineState);
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+        }
 
-            CBChangesEveryFrame cbChangesEveryFrame =
+        for (auto model = scene.GetModels().begin(); model != scene.GetModels().end(); ++model)
+        {
+            hr = getPipelineState(*model->second, MODEL_PIPELINE, pPipelineState);
+            if (FAILED(hr))
             {
-                .World = XMMatrixTranspose(m_scenes[m_pszMainSceneName]->GetSkyBox()->GetWorldMatrix()),
-                .OutputColor = m_scenes[m_pszMainSceneName]->GetSkyBox()->GetOutputColor(),
-                .HasNormalMap = m_scenes[m_pszMainSceneName]->GetSkyBox()->HasNormalMap()
-            };
-            m_immediateContext->UpdateSubresource(m_scenes[m_pszMainSceneName]->GetSkyBox()->GetConstantBuffer().Get(), 0u, nullptr, &cbChangesEveryFrame, 0u, 0u);
+                return hr;
+            }
+        }
 
-            m_immediateContext->VSSetShader(m_scenes[m_pszMainSceneName]->GetSkyBox()->GetVertexShader().Get(), nullptr, 0u);
-            m_immediateContext->VSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
-            m_immediateContext->VSSetConstantBuffers(1u, 1u, m_cbChangeOnResize.GetAddressOf());
-            m_immediateContext->VSSetConstantBuffers(2u, 1u, m_scenes[m_pszMainSceneName]->GetSkyBox()->GetConstantBuffer().GetAddressOf());
-            m_immediateContext->VSSetConstantBuffers(3u, 1u, m_cbLights.GetAddressOf());
+        WCHAR szMessage[256];
+        swprintf_s(szMessage, L"Pipeline states: %u unique for %llu renderables\n",
+            m_pipelineStates.GetNumPipelineStates(), m_pipelineStates.GetNumRequests());
+        OutputDebugString(szMessage);
 
-            m_immediateContext->PSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
-            m_immediateContext->PSSetConstantBuffers(1u, 1u, m_cbChangeOnResize.GetAddressOf());
-            m_immediateContext->PSSetConstantBuffers(2u, 1u, m_scenes[m_pszMainSceneName]->GetSkyBox()->GetConstantBuffer().GetAddressOf());
-            m_immediateContext->PSSetShader(m_scenes[m_pszMainSceneName]->GetSkyBox()->GetPixelShader().Get(), nullptr, 0u);
+        return S_OK;
+    }
 
-            if (m_scenes[m_pszMainSceneName]->GetSkyBox()->HasTexture())
-            {
-                for (UINT i = 0u; i < m_scenes[m_pszMainSceneName]->GetSkyBox()->GetNumMeshes(); ++i)
-                {
-                    UINT materialIndex = m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMesh(i).uMaterialIndex;
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::getPipelineState
+      Summary:  Returns the pipeline of a renderable, looked up in the
+                cache by its shaders, its layout and the streams of its
+                kind the first time and kept by the renderable
+      Args:     Renderable& renderable
+                  The renderable
+                const PipelineStateDesc& streams
+                  Vertex streams, index format, topology and constant
+                  buffer slots of the kind of the renderable
+                const PipelineState*& outPipelineState
+                  Receives the shared pipeline
+      Modifies: [m_pipelineStates].
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Renderer::getPipelineState(_In_ Renderable& renderable, _In_ const PipelineStateDesc& streams, _Out_ const PipelineState*& outPipelineState)
+    {
+        outPipelineState = renderable.GetPipelineState();
+        if (outPipelineState)
+        {
+            return S_OK;
+        }
 
-                    if (m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMaterial(materialIndex)->pDiffuse)
-                    {
-                        eTextureSamplerType textureSamplerType = m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMaterial(materialIndex)->pDiffuse->GetSamplerType();
+        PipelineStateDesc desc = streams;
+        desc.pVertexShader = renderable.GetVertexShader().Get();
+        desc.pPixelShader = renderable.GetPixelShader().Get();
+        desc.pInputLayout = renderable.GetVertexLayout().Get();
 
-                        m_immediateContext->PSSetShaderResources(0u, 1u, m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMaterial(materialIndex)->pDiffuse->GetTextureResourceView().GetAddressOf());
-                        m_immediateContext->PSSetSamplers(0u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
-                    }
+        HRESULT hr = m_pipelineStates.GetPipelineState(desc, outPipelineState);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
 
-                    if (m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMaterial(materialIndex)->pNormal)
-                    {
-                        eTextureSamplerType textureSamplerType = m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMaterial(materialIndex)->pNormal->GetSamplerType();
+        renderable.SetPipelineState(outPipelineState);
 
-                        m_immediateContext->PSSetShaderResources(1u, 1u, m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMaterial(materialIndex)->pNormal->GetTextureResourceView().GetAddressOf());
-                        m_immediateContext->PSSetSamplers(0u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
-                    }
+        return S_OK;
+    }
 
-                    m_immediateContext->DrawIndexed(
-                        m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMesh(i).uNumIndices,
-                        m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMesh(i).uBaseIndex,
-                        m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMesh(i).uBaseVertex
-                    );
-                }
-            }
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::createDrawState
+      Summary:  Writes the per object constants of a renderable to the
+                constant buffer ring and returns its pipeline, index
+                buffer and the constants of the frame in their slots,
+                the pipeline drops the ones its shaders do not read.
+                The caller adds the vertex buffers and what else its
+                shaders need
+      Args:     Renderable& renderable
+                  The renderable to draw
+                const PipelineStateDesc& streams
+                  Streams and constant buffer slots of the kind of the
+                  renderable
+                DrawState& outState
+                  Receives the state of the draws of the renderable
+      Modifies: [m_constantBufferRing, m_pipelineStates].
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Renderer::createDrawState(_In_ Renderable& renderable, _In_ const PipelineStateDesc& streams, _Out_ DrawState& outState)
+    {
+        const PipelineState* pPipelineState = nullptr;
+        HRESULT hr = getPipelineState(renderable, streams, pPipelineState);
+        if (FAILED(hr))
+        {
+            return hr;
         }
 
-        for (auto scene = m_scenes.begin(); scene != m_scenes.end(); ++scene)
+        CBChangesEveryFrame cbChangesEveryFrame =
         {
-            for (auto renderable = scene->second->GetRenderables().begin(); renderable != scene->second->GetRenderables().end(); ++renderable)
-            {
-                // Set the vertex buffer
-                UINT aStrides[2] =
-                {
-                    static_cast<UINT>(sizeof(SimpleVertex)),
-                    static_cast<UINT>(sizeof(NormalData))
-                };
-                UINT aOffsets[2] = { 0u, 0u };
-                ComPtr<ID3D11Buffer> aBuffers[2]
-                {
-                   renderable->second->GetVertexBuffer(),
-                   renderable->second->GetNormalBuffer()
-                };
+            .World = XMMatrixTranspose(renderable.GetWorldMatrix()),
+            .OutputColor = renderable.GetOutputColor(),
+            .HasNormalMap = renderable.HasNormalMap()
+        };
+        ConstantBufferRange objectConstants;
+        hr = m_constantBufferRing.Allocate(m_renderDevice.get(), cbChangesEveryFrame, objectConstants);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
 
-                m_immediateContext->IASetVertexBuffers(0u, 2u, aBuffers->GetAddressOf(), aStrides, aOffsets);
+        outState =
+        {
+            .pPipelineState = pPipelineState,
+            .pIndexBuffer = renderable.GetIndexBuffer().Get(),
+            .aVSConstantBuffers = { m_cameraConstants, m_projectionConstants, objectConstants, m_lightConstants },
+            .aPSConstantBuffers = { m_cameraConstants, m_projectionConstants, objectConstants, m_lightConstants },
+        };
 
-                // Set the index buffer
-                m_immediateContext->IASetIndexBuffer(renderable->second->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0u);
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::getEnvironmentBindings
+      Summary:  Returns the textures of the sky box the reflecting
+                shaders sample as their environment map
+      Args:     Scene& scene
+                  Scene of the sky box
+      Returns:  DrawBindings
+                  Sky box textures in the first slots, empty without a
+                  sky box
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    DrawBindings Renderer::getEnvironmentBindings(_In_ Scene& scene) const
+    {
+        DrawBindings bindings = {};
 
-                // Set the input layout
-                m_immediateContext->IASetInputLayout(renderable->second->GetVertexLayout().Get());
+        const std::shared_ptr<Skybox>& skybox = scene.GetSkyBox();
+        if (skybox && skybox->GetNumMeshes() > 0u && skybox->GetMesh(0u).uMaterialIndex < skybox->GetNumMaterials())
+        {
+            addMaterialBindings(*skybox->GetMaterial(skybox->GetMesh(0u).uMaterialIndex), 0u, 0u, bindings);
+        }
 
-                // Create renderable constant buffer and update
-                CBChangesEveryFrame cbChangesEveryFrame =
-                {
-                    .World = XMMatrixTranspose(renderable->second->GetWorldMatrix()),
-                    .OutputColor = renderable->second->GetOutputColor(),
-                    .HasNormalMap = renderable->second->HasNormalMap()
-                };
-                m_immediateContext->UpdateSubresource(renderable->second->GetConstantBuffer().Get(), 0u, nullptr, &cbChangesEveryFrame, 0u, 0u);
-
-                // Render
-                m_immediateContext->VSSetShader(renderable->second->GetVertexShader().Get(), nullptr, 0u);
-                m_immediateContext->VSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
-                m_immediateContext->VSSetConstantBuffers(1u, 1u, m_cbChangeOnResize.GetAddressOf());
-                m_immediateContext->VSSetConstantBuffers(2u, 1u, renderable->second->GetConstantBuffer().GetAddressOf());
-                m_immediateContext->VSSetConstantBuffers(3u, 1u, m_cbLights.GetAddressOf());
-
-                m_immediateContext->PSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
-                m_immediateContext->PSSetConstantBuffers(2u, 1u, renderable->second->GetConstantBuffer().GetAddressOf());
-                m_immediateContext->PSSetConstantBuffers(3u, 1u, m_cbLights.GetAddressOf());
-                m_immediateContext->PSSetShader(renderable->second->GetPixelShader().Get(), nullptr, 0u);
-
-                if (renderable->second->HasTexture())
+        return bindings;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::queueSkyBox
+      Summary:  Adds the draws of the sky box of the scene to the
+                background pass
+      Args:     Scene& scene
+                  Scene of the sky box
+      Modifies: [m_renderQueue, m_constantBufferRing, m_pipelineStates].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::queueSkyBox(_In_ Scene& scene)
+    {
+        std::shared_ptr<Skybox>& skybox = scene.GetSkyBox();
+        if (!skybox || !skybox->HasTexture())
+        {
+            return;
+        }
+
+        DrawState state;
+        if (FAILED(createDrawState(*skybox, SKY_BOX_PIPELINE, state)))
+        {
+            return;
+        }
+        state.apVertexBuffers[0] = skybox->GetVertexBuffer().Get();
+        state.apVertexBuffers[1] = skybox->GetNormalBuffer().Get();
+
+        const UINT uState = m_renderQueue.AddState(state);
+        const XMFLOAT3 position = getPosition(*skybox);
+        for (UINT i = 0u; i < skybox->GetNumMeshes(); ++i)
+        {
+            DrawBindings bindings = {};
+            if (skybox->GetMesh(i).uMaterialIndex < skybox->GetNumMaterials())
+            {
+                addMaterialBindings(*skybox->GetMaterial(skybox->GetMesh(i).uMaterialIndex), 0u, 0u, bindings);
+            }
+
+            m_renderQueue.AddDraw(eRenderPass::BACKGROUND, position,
                 {
-                    for (UINT i = 0u; i < renderable->second->GetNumMeshes(); ++i)
-                    {
-                        UINT materialIndex = renderable->second->GetMesh(i).uMaterialIndex;
+                    .uState = uState,
+                    .uBindings = m_renderQueue.AddBindings(bindings),
+                    .uNumIndices = skybox->GetMesh(i).uNumIndices,
+                    .uNumInstances = 0u,
+                    .uStartIndex = skybox->GetMesh(i).uBaseIndex,
+                    .iBaseVertex = static_cast<INT>(skybox->GetMesh(i).uBaseVertex)
+                });
+        }
+    }
 
-                        if (scene->second->GetSkyBox()->GetMaterial(materialIndex)->pDiffuse)
-                        {
-                            eTextureSamplerType textureSamplerType = scene->second->GetSkyBox()->GetMaterial(materialIndex)->pDiffuse->GetSamplerType();
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::queueRenderables
+      Summary:  Adds the draws of the renderables of the scene, every
+                mesh of a textured renderable with the sky box behind
+                its own material
+      Args:     Scene& scene
+                  Scene of the renderables
+      Modifies: [m_renderQueue, m_constantBufferRing, m_pipelineStates].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::queueRenderables(_In_ Scene& scene)
+    {
+        const DrawBindings environmentBindings = getEnvironmentBindings(scene);
+        const UINT uEnvironmentBindings = m_renderQueue.AddBindings(environmentBindings);
 
-                            m_immediateContext->PSSetShaderResources(0u, 1u, scene->second->GetSkyBox()->GetMaterial(materialIndex)->pDiffuse->GetTextureResourceView().GetAddressOf());
-                            m_immediateContext->PSSetSamplers(0u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
-                        }
+        for (auto renderable = scene.GetRenderables().begin(); renderable != scene.GetRenderables().end(); ++renderable)
+        {
+            DrawState state;
+            if (FAILED(createDrawState(*renderable->second, RENDERABLE_PIPELINE, state)))
+            {
+                continue;
+            }
+            state.apVertexBuffers[0] = renderable->second->GetVertexBuffer().Get();
+            state.apVertexBuffers[1] = renderable->second->GetNormalBuffer().Get();
 
-                        if (scene->second->GetSkyBox()->GetMaterial(materialIndex)->pNormal)
-                        {
-                            eTextureSamplerType textureSamplerType = scene->second->GetSkyBox()->GetMaterial(materialIndex)->pNormal->GetSamplerType();
+            const UINT uState = m_renderQueue.AddState(state);
+            const XMFLOAT3 position = getPosition(*renderable->second);
 
-                            m_immediateContext->PSSetShaderResources(1u, 1u, scene->second->GetSkyBox()->GetMaterial(materialIndex)->pNormal->GetTextureResourceView().GetAddressOf());
-                            m_immediateContext->PSSetSamplers(0u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
-                        }
-                    }
+            if (!renderable->second->HasTexture())
+            {
+                m_renderQueue.AddDraw(eRenderPass::OPAQUE_GEOMETRY, position,
+                    {
+                        .uState = uState,
+                        .uBindings = uEnvironmentBindings,
+                        .uNumIndices = renderable->second->GetNumIndices(),
+                        .uNumInstances = 0u,
+                        .uStartIndex = 0u,
+                        .iBaseVertex = 0
+                    });
+                continue;
+            }
 
-                    for (UINT i = 0u; i < renderable->second->GetNumMeshes(); ++i)
+            for (UINT i = 0u; i < renderable->second->GetNumMeshes(); ++i)
+            {
+                eRenderPass pass = eRenderPass::OPAQUE_GEOMETRY;
+                DrawBindings bindings = environmentBindings;
+
+                UINT materialIndex = renderable->second->GetMesh(i).uMaterialIndex;
+                if (materialIndex < renderable->second->GetNumMaterials())
+                {
+                    addMaterialBindings(*renderable->second->GetMaterial(materialIndex), 2u, 3u, bindings);
+                    if (renderable->second->GetMaterial(materialIndex)->bTransparent)
                     {
-                        UINT materialIndex = renderable->second->GetMesh(i).uMaterialIndex;
-
-                        if (renderable->second->GetMaterial(materialIndex)->pDiffuse)
-                        {
-                            eTextureSamplerType textureSamplerType = renderable->second->GetMaterial(materialIndex)->pDiffuse->GetSamplerType();
-
-                            m_immediateContext->PSSetShaderResources(0u, 1u, renderable->second->GetMaterial(materialIndex)->pDiffuse->GetTextureResourceView().GetAddressOf());
-                            m_immediateContext->PSSetSamplers(2u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
-                        }
-
-                        if (renderable->second->GetMaterial(materialIndex)->pNormal)
-                        {
-                            eTextureSamplerType textureSamplerType = renderable->second->GetMaterial(materialIndex)->pNormal->GetSamplerType();
-
-                            m_immediateContext->PSSetShaderResources(1u, 1u, renderable->second->GetMaterial(materialIndex)->pNormal->GetTextureResourceView().GetAddressOf());
-                            m_immediateContext->PSSetSamplers(3u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
-                        }
-
-                        if (m_shadowMapTexture != nullptr)
-                        {
-                            m_immediateContext->PSSetShaderResources(4u, 1u, m_shadowMapTexture->GetShaderResourceView().GetAddressOf());
-                            m_immediateContext->PSSetSamplers(4u, 1u, m_shadowMapTexture->GetSamplerState().GetAddressOf());
-                        }
-
-                        m_immediateContext->DrawIndexed(
-                            renderable->second->GetMesh(i).uNumIndices,
-                            renderable->second->GetMesh(i).uBaseIndex,
-                            renderable->second->GetMesh(i).uBaseVertex
-                        );
+                        pass = eRenderPass::TRANSPARENT_GEOMETRY;
                     }
                 }
-                else
+
+                if (m_shadowMapTexture != nullptr)
                 {
-                    m_immediateContext->DrawIndexed(renderable->second->GetNumIndices(), 0u, 0);
+                    bindings.apPSViews[4] = m_shadowMapTexture->GetShaderResourceView().Get();
+                    bindings.apPSSamplers[4] = m_shadowMapTexture->GetSamplerState().Get();
                 }
+
+                m_renderQueue.AddDraw(pass, position,
+                    {
+                        .uState = uState,
+                        .uBindings = m_renderQueue.AddBindings(bindings),
+                        .uNumIndices = renderable->second->GetMesh(i).uNumIndices,
+                        .uNumInstances = 0u,
+                        .uStartIndex = renderable->second->GetMesh(i).uBaseIndex,
+                        .iBaseVertex = static_cast<INT>(renderable->second->GetMesh(i).uBaseVertex)
+                    });
             }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::queueVoxels
+      Summary:  Adds the instanced draws of the voxels of the scene.
+                The material arrays of the shared compact voxel are in
+                the bindings of every block type
+      Args:     Scene& scene
+                  Scene of the voxels
+      Modifies: [m_renderQueue, m_constantBufferRing, m_pipelineStates].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::queueVoxels(_In_ Scene& scene)
+    {
+        DrawBindings voxelBindings = {};
+
+        VoxelMaterialArray* pVoxelMaterials = scene.GetVoxelMaterials();
+        if (pVoxelMaterials)
+        {
+            voxelBindings.apPSViews[4] = pVoxelMaterials->GetAlbedoView().Get();
+            voxelBindings.apPSViews[5] = pVoxelMaterials->GetNormalView().Get();
+            voxelBindings.apPSSamplers[0] = Texture::s_samplers[static_cast<size_t>(eTextureSamplerType::TRILINEAR_WRAP)].Get();
+        }
+        const UINT uVoxelBindings = m_renderQueue.AddBindings(voxelBindings);
 
-            // Render the voxels
-            for (auto voxel : scene->second->GetVoxels())
+        for (const std::shared_ptr<Voxel>& voxel : scene.GetVoxels())
+        {
+            if (voxel->GetNumInstances() == 0u)
             {
-                UINT aStrides[3] =
-                {
-                    static_cast<UINT>(sizeof(SimpleVertex)),
-                    static_cast<UINT>(sizeof(NormalData)),
-                    static_cast<UINT>(sizeof(InstanceData))
-                };
-                UINT aOffsets[3] = { 0u, 0u, 0u };
+                continue;
+            }
 
-                ComPtr<ID3D11Buffer> aBuffers[3] =
-                {
-                    voxel->GetVertexBuffer(),
-                    voxel->GetNormalBuffer(),
-                    voxel->GetInstanceBuffer()
-                };
+            PipelineStateDesc voxelPipeline = VOXEL_PIPELINE;
+            voxelPipeline.aStrides[2] = voxel->GetInstanceStride();
 
-                // Set the vertex buffer
-                m_immediateContext->IASetVertexBuffers(0u, 3u, aBuffers->GetAddressOf(), aStrides, aOffsets);
+            DrawState state;
+            if (FAILED(createDrawState(*voxel, voxelPipeline, state)))
+            {
+                continue;
+            }
+            state.apVertexBuffers[0] = voxel->GetVertexBuffer().Get();
+            state.apVertexBuffers[1] = voxel->GetNormalBuffer().Get();
+            state.apVertexBuffers[2] = voxel->GetInstanceBuffer().Get();
 
-                // Set the index buffer
-                m_immediateContext->IASetIndexBuffer(voxel->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0);
+            const UINT uState = m_renderQueue.AddState(state);
+            const XMFLOAT3 position = getPosition(*voxel);
 
-                // Set the input layout
-                m_immediateContext->IASetInputLayout(voxel->GetVertexLayout().Get());
+            if (!voxel->HasTexture())
+            {
+                m_renderQueue.AddDraw(eRenderPass::OPAQUE_GEOMETRY, position,
+                    {
+                        .uState = uState,
+                        .uBindings = uVoxelBindings,
+                        .uNumIndices = voxel->GetNumIndices(),
+                        .uNumInstances = voxel->GetNumInstances(),
+                        .uStartIndex = 0u,
+                        .iBaseVertex = 0
+                    });
+                continue;
+            }
+
+            for (UINT i = 0u; i < voxel->GetNumMeshes(); ++i)
+            {
+                DrawBindings bindings = voxelBindings;
 
-                // Set the constant buffer
-                CBChangesEveryFrame cbChangesEveryFrame =
+                UINT materialIndex = voxel->GetMesh(i).uMaterialIndex;
+                if (materialIndex < voxel->GetNumMaterials())
                 {
-                    .World = XMMatrixTranspose(voxel->GetWorldMatrix()),
-                    .OutputColor = voxel->GetOutputColor(),
-                    .HasNormalMap = voxel->HasNormalMap()
-                };
+                    addMaterialBindings(*voxel->GetMaterial(materialIndex), 0u, 0u, bindings);
+                }
 
-                m_immediateContext->UpdateSubresource(voxel->GetConstantBuffer().Get(), 0u, nullptr, &cbChangesEveryFrame, 0u, 0u);
+                if (m_shadowMapTexture != nullptr)
+                {
+                    bindings.apPSViews[2] = m_shadowMapTexture->GetShaderResourceView().Get();
+                    bindings.apPSSamplers[2] = m_shadowMapTexture->GetSamplerState().Get();
+                }
 
-                m_immediateContext->VSSetShader(voxel->GetVertexShader().Get(), nullptr, 0u);
-                m_immediateContext->VSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
-                m_immediateContext->VSSetConstantBuffers(1u, 1u, m_cbChangeOnResize.GetAddressOf());
-                m_immediateContext->VSSetConstantBuffers(2u, 1u, voxel->GetConstantBuffer().GetAddressOf());
-                m_immediateContext->VSSetConstantBuffers(3u, 1u, m_cbLights.GetAddressOf());
+                m_renderQueue.AddDraw(eRenderPass::OPAQUE_GEOMETRY, position,
+                    {
+                        .uState = uState,
+                        .uBindings = m_renderQueue.AddBindings(bindings),
+                        .uNumIndices = voxel->GetMesh(i).uNumIndices,
+                        .uNumInstances = voxel->GetNumInstances(),
+                        .uStartIndex = voxel->GetMesh(i).uBaseIndex,
+                        .iBaseVertex = static_cast<INT>(voxel->GetMesh(i).uBaseVertex)
+                    });
+            }
+        }
+    }
 
-                m_immediateContext->PSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
-                m_immediateContext->PSSetConstantBuffers(2u, 1u, voxel->GetConstantBuffer().GetAddressOf());
-                m_immediateContext->PSSetConstantBuffers(3u, 1u, m_cbLights.GetAddressOf());
-                m_immediateContext->PSSetShader(voxel->GetPixelShader().Get(), nullptr, 0u);
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::queueVoxelChunks
+      Summary:  Adds the draws of the visible voxel chunks of the
+                scene, one per 16-bit addressable section, usually a
+                single one per chunk
+      Args:     Scene& scene
+                  Scene of the chunks
+      Modifies: [m_renderQueue, m_constantBufferRing, m_pipelineStates].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::queueVoxelChunks(_In_ Scene& scene)
+    {
+        if (scene.GetVisibleVoxelChunks().empty())
+        {
+            return;
+        }
 
+        const UINT uBindings = m_renderQueue.AddBindings(DrawBindings());
+        for (const std::shared_ptr<VoxelChunk>& voxelChunk : scene.GetVisibleVoxelChunks())
+        {
+            DrawState state;
+            if (FAILED(createDrawState(*voxelChunk, VOXEL_CHUNK_PIPELINE, state)))
+            {
+                continue;
+            }
+            state.apVertexBuffers[0] = voxelChunk->GetVertexBuffer().Get();
+            state.apVertexBuffers[1] = voxelChunk->GetColorBuffer().Get();
 
-                if (voxel->HasTexture())
-                {
-                    for (UINT i = 0; i < voxel->GetNumMeshes(); ++i)
+            const UINT uState = m_renderQueue.AddState(state);
+            const XMFLOAT3 position = getPosition(*voxelChunk);
+            for (UINT i = 0u; i < voxelChunk->GetNumMeshes(); ++i)
+            {
+                m_renderQueue.AddDraw(eRenderPass::OPAQUE_GEOMETRY, position,
                     {
-                        UINT materialIndex = voxel->GetMesh(i).uMaterialIndex;
-
-                        if (voxel->GetMaterial(materialIndex)->pDiffuse)
-                        {
-                            eTextureSamplerType textureSamplerType = voxel->GetMaterial(materialIndex)->pDiffuse->GetSamplerType();
-
-                            m_immediateContext->PSSetShaderResources(0u, 1u, voxel->GetMaterial(materialIndex)->pDiffuse->GetTextureResourceView().GetAddressOf());
-                            m_immediateContext->PSSetSamplers(0u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
-                        }
-
-                        if (voxel->GetMaterial(materialIndex)->pNormal)
-                        {
-                            eTextureSamplerType textureSamplerType = voxel->GetMaterial(materialIndex)->pNormal->GetSamplerType();
-
-                            m_immediateContext->PSSetShaderResources(1u, 1u, voxel->GetMaterial(materialIndex)->pNormal->GetTextureResourceView().GetAddressOf());
-                            m_immediateContext->PSSetSamplers(0u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
-                        }
-
-                        if (m_shadowMapTexture != nullptr)
-                        {
-                            m_immediateContext->PSSetShaderResources(2u, 1u, m_shadowMapTexture->GetShaderResourceView().GetAddressOf());
-                            m_immediateContext->PSSetSamplers(2u, 1u, m_shadowMapTexture->GetSamplerState().GetAddressOf());
-                        }
-
-                        m_immediateContext->DrawIndexedInstanced(
-                            voxel->GetMesh(i).uNumIndices,
-                            voxel->GetNumInstances(),
-                            voxel->GetMesh(i).uBaseIndex,
-                            voxel->GetMesh(i).uBaseVertex,
-                            0
-                        );
-                    }
-                }
-                else
-                {
-                    // Draw
-                    m_immediateContext->DrawIndexedInstanced(voxel->GetNumIndices(), voxel->GetNumInstances(), 0u, 0, 0u);
-                }
+                        .uState = uState,
+                        .uBindings = uBindings,
+                        .uNumIndices = voxelChunk->GetMesh(i).uNumIndices,
+                        .uNumInstances = 0u,
+                        .uStartIndex = voxelChunk->GetMesh(i).uBaseIndex,
+                        .iBaseVertex = static_cast<INT>(voxelChunk->GetMesh(i).uBaseVertex)
+                    });
             }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::queueTerrain
+      Summary:  Adds the draw of the smooth terrain of the scene, every
+                patch is an instance of the same grid, the patches are
+                uploaded to the vertex upload arena
+      Args:     Scene& scene
+                  Scene of the terrain
+      Modifies: [m_renderQueue, m_constantBufferRing,
+                 m_vertexUploadArena, m_pipelineStates].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::queueTerrain(_In_ Scene& scene)
+    {
+        std::shared_ptr<Terrain>& terrain = scene.GetTerrain();
+        UploadAllocation patches;
+        if (!terrain || terrain->GetNumInstances() == 0u || FAILED(terrain->UploadInstances(m_renderDevice.get(), m_vertexUploadArena, patches)))
+        {
+            return;
+        }
 
-            // Render the models
-            for (auto model = scene->second->GetModels().begin(); model != scene->second->GetModels().end(); ++model)
+        ConstantBufferRange terrainConstants;
+        DrawState state;
+        if (FAILED(m_constantBufferRing.Allocate(m_renderDevice.get(), terrain->GetTerrainConstants(), terrainConstants))
+            || FAILED(createDrawState(*terrain, TERRAIN_PIPELINE, state)))
+        {
+            return;
+        }
+        state.apVertexBuffers[0] = terrain->GetVertexBuffer().Get();
+        state.apVertexBuffers[1] = patches.pBuffer;
+        state.aOffsets[1] = patches.uOffset;
+        state.aVSConstantBuffers[4] = terrainConstants;
+        state.apVSViews[2] = terrain->GetHeightView().Get();
+        state.apVSViews[3] = terrain->GetColorView().Get();
+
+        m_renderQueue.AddDraw(eRenderPass::OPAQUE_GEOMETRY, getPosition(*terrain),
             {
-                // Set the vertex buffer
-                UINT aStrides[3] =
-                {
-                    static_cast<UINT>(sizeof(SimpleVertex)),
-                    static_cast<UINT>(sizeof(NormalData)),
-                    static_cast<UINT>(sizeof(AnimationData))
-                };
-                UINT aOffsets[3] = { 0u, 0u, 0u };
+                .uState = m_renderQueue.AddState(state),
+                .uBindings = m_renderQueue.AddBindings(DrawBindings()),
+                .uNumIndices = terrain->GetNumIndices(),
+                .uNumInstances = terrain->GetNumInstances(),
+                .uStartIndex = 0u,
+                .iBaseVertex = 0
+            });
+    }
 
-                ComPtr<ID3D11Buffer> aBuffers[3]
-                {
-                   model->second->GetVertexBuffer(),
-                   model->second->GetNormalBuffer(),
-                   model->second->GetAnimationBuffer()
-                };
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::queueModels
+      Summary:  Uploads the bone transforms of the models of the scene
+                and adds the draws of their meshes, the meshes of
+                transparent materials to the transparent pass
+      Args:     Scene& scene
+                  Scene of the models
+      Modifies: [m_renderQueue, m_constantBufferRing, m_pipelineStates].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::queueModels(_In_ Scene& scene)
+    {
+        for (auto model = scene.GetModels().begin(); model != scene.GetModels().end(); ++model)
+        {
+            CBSkinning cbSkinning =
+            {
+                .BoneTransforms = {}
+            };
 
-                m_immediateContext->IASetVertexBuffers(0u, 3u, aBuffers->GetAddressOf(), aStrides, aOffsets);
-                m_immediateContext->IASetIndexBuffer(model->second->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0u);
-                m_immediateContext->IASetInputLayout(model->second->GetVertexLayout().Get());
+            for (UINT i = 0u; i < model->second->GetBoneTransforms().size(); ++i)
+            {
+                cbSkinning.BoneTransforms[i] = XMMatrixTranspose(model->second->GetBoneTransforms()[i]);
+            }
 
-                // Create model's constant buffer and update
-                CBChangesEveryFrame cbChangesEveryFrame =
-                {
-                    .World = XMMatrixTranspose(model->second->GetWorldMatrix()),
-                    .OutputColor = model->second->GetOutputColor(),
-                    .HasNormalMap = model->second->HasNormalMap()
-                };
-                m_immediateContext->UpdateSubresource(model->second->GetConstantBuffer().Get(), 0u, nullptr, &cbChangesEveryFrame, 0u, 0u);
+            ConstantBufferRange skinningConstants;
+            DrawState state;
+            if (FAILED(m_constantBufferRing.Allocate(m_renderDevice.get(), cbSkinning, skinningConstants))
+                || FAILED(createDrawState(*model->second, MODEL_PIPELINE, state)))
+            {
+                continue;
+            }
 
-                CBSkinning cbSkinning =
-                {
-                    .BoneTransforms = {}
-                };
+            state.apVertexBuffers[0] = model->second->GetVertexBuffer().Get();
+            state.apVertexBuffers[1] = model->second->GetNormalBuffer().Get();
+            state.apVertexBuffers[2] = model->second->GetAnimationBuffer().Get();
+            state.aVSConstantBuffers[4] = skinningConstants;
 
-                for (UINT i = 0u; i < model->second->GetBoneTransforms().size(); ++i)
-                {
-                    cbSkinning.BoneTransforms[i] = XMMatrixTranspose(model->second->GetBoneTransforms()[i]);
-                }
-                m_immediateContext->UpdateSubresource(model->second->GetSkinningConstantBuffer().Get(), 0u, nullptr, &cbSkinning, 0u, 0u);
-
-                // Render
-                m_immediateContext->VSSetShader(model->second->GetVertexShader().Get(), nullptr, 0);
-                m_immediateContext->VSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
-                m_immediateContext->VSSetConstantBuffers(1u, 1u, m_cbChangeOnResize.GetAddressOf());
-                m_immediateContext->VSSetConstantBuffers(2u, 1u, model->second->GetConstantBuffer().GetAddressOf());
-                m_immediateContext->VSSetConstantBuffers(3u, 1u, m_cbLights.GetAddressOf());
-                m_immediateContext->VSSetConstantBuffers(4u, 1u, model->second->GetSkinningConstantBuffer().GetAddressOf());
-
-                m_immediateContext->PSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
-                m_immediateContext->PSSetConstantBuffers(1u, 1u, m_cbChangeOnResize.GetAddressOf());
-                m_immediateContext->PSSetConstantBuffers(2u, 1u, model->second->GetConstantBuffer().GetAddressOf());
-                m_immediateContext->PSSetConstantBuffers(3u, 1u, m_cbLights.GetAddressOf());
-                m_immediateContext->PSSetShader(model->second->GetPixelShader().Get(), nullptr, 0);
-
-                if (model->second->HasTexture())
+            const UINT uState = m_renderQueue.AddState(state);
+            const XMFLOAT3 position = getPosition(*model->second);
+
+            if (!model->second->HasTexture())
+            {
+                m_renderQueue.AddDraw(eRenderPass::OPAQUE_GEOMETRY, position,
+                    {
+                        .uState = uState,
+                        .uBindings = m_renderQueue.AddBindings(getEnvironmentBindings(scene)),
+                        .uNumIndices = model->second->GetNumIndices(),
+                        .uNumInstances = 0u,
+                        .uStartIndex = 0u,
+                        .iBaseVertex = 0
+                    });
+                continue;
+            }
+
+            for (UINT i = 0u; i < model->second->GetNumMeshes(); ++i)
+            {
+                eRenderPass pass = eRenderPass::OPAQUE_GEOMETRY;
+                DrawBindings bindings = {};
+
+                UINT materialIndex = model->second->GetMesh(i).uMaterialIndex;
+                if (materialIndex < model->second->GetNumMaterials())
                 {
-                    for (UINT i = 0u; i < model->second->GetNumMeshes(); ++i)
+                    addMaterialBindings(*model->second->GetMaterial(materialIndex), 0u, 1u, bindings);
+                    if (model->second->GetMaterial(materialIndex)->bTransparent)
                     {
-                        UINT materialIndex = model->second->GetMesh(i).uMaterialIndex;
-
-                        if (model->second->GetMaterial(materialIndex)->pDiffuse)
-                        {
-                            eTextureSamplerType textureSamplerType = model->second->GetMaterial(materialIndex)->pDiffuse->GetSamplerType();
-
-                            m_immediateContext->PSSetShaderResources(0u, 1u, model->second->GetMaterial(materialIndex)->pDiffuse->GetTextureResourceView().GetAddressOf());
-                            m_immediateContext->PSSetSamplers(0u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
-                        }
-
-                        if (model->second->GetMaterial(materialIndex)->pNormal)
-                        {
-                            eTextureSamplerType textureSamplerType = model->second->GetMaterial(materialIndex)->pNormal->GetSamplerType();
-
-                            m_immediateContext->PSSetShaderResources(1u, 1u, model->second->GetMaterial(materialIndex)->pNormal->GetTextureResourceView().GetAddressOf());
-                            m_immediateContext->PSSetSamplers(1u, 1u, Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf());
-                        }
-
-                        if (m_shadowMapTexture != nullptr)
-                        {
-                            m_immediateContext->PSSetShaderResources(2u, 1u, m_shadowMapTexture->GetShaderResourceView().GetAddressOf());
-                            m_immediateContext->PSSetSamplers(2u, 1u, m_shadowMapTexture->GetSamplerState().GetAddressOf());
-                        }
-
-                        m_immediateContext->DrawIndexed(
-                            model->second->GetMesh(i).uNumIndices,
-                            model->second->GetMesh(i).uBaseIndex,
-                            model->second->GetMesh(i).uBaseVertex
-                        );
+                        pass = eRenderPass::TRANSPARENT_GEOMETRY;
                     }
                 }
-                else
+
+                if (m_shadowMapTexture != nullptr)
                 {
-                    m_immediateContext->DrawIndexed(model->second->GetNumIndices(), 0u, 0);
+                    bindings.apPSViews[2] = m_shadowMapTexture->GetShaderResourceView().Get();
+                    bindings.apPSSamplers[2] = m_shadowMapTexture->GetSamplerState().Get();
                 }
-            }
-            // Present the information rendered to the back buffer to the front buffer
-            m_swapChain->Present(0u, 0u);
 
-            /*
-            ComPtr<ID3D11ShaderResourceView> shaderResourceView[1] = { nullptr };
-            m_immediateContext->PSSetShaderResources(1u, 1u, shaderResourceView->GetAddressOf());
+                m_renderQueue.AddDraw(pass, position,
+                    {
+                        .uState = uState,
+                        .uBindings = m_renderQueue.AddBindings(bindings),
+                        .uNumIndices = model->second->GetMesh(i).uNumIndices,
+                        .uNumInstances = 0u,
+                        .uStartIndex = model->second->GetMesh(i).uBaseIndex,
+                        .iBaseVertex = static_cast<INT>(model->second->GetMesh(i).uBaseVertex)
+                    });
+            }
+        }
+    }
 
-            ComPtr<ID3D11Buffer> vertexBuffers[3] = { nullptr, nullptr, nullptr };
-            UINT zero = 0u;
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::addMaterialBindings
+      Summary:  Binds the diffuse and normal maps of a material to the
+                first two view slots
+      Args:     const Material& material
+                  The material
+                UINT uDiffuseSampler
+                  Sampler slot of the diffuse map
+                UINT uNormalSampler
+                  Sampler slot of the normal map
+                DrawBindings& bindings
+                  Bindings the maps are added to
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Renderer::addMaterialBindings(_In_ const Material& material, _In_ UINT uDiffuseSampler, _In_ UINT uNormalSampler, _Inout_ DrawBindings& bindings)
+    {
+        if (material.pDiffuse)
+        {
+            bindings.apPSViews[0] = material.pDiffuse->GetTextureResourceView().Get();
+            bindings.apPSSamplers[uDiffuseSampler] = Texture::s_samplers[static_cast<size_t>(material.pDiffuse->GetSamplerType())].Get();
+        }
 
-            m_immediateContext->IASetVertexBuffers(0u, 3u, vertexBuffers->GetAddressOf(), &zero, &zero);
-            */
+        if (material.pNormal)
+        {
+            bindings.apPSViews[1] = material.pNormal->GetTextureResourceView().Get();
+            bindings.apPSSamplers[uNormalSampler] = Texture::s_samplers[static_cast<size_t>(material.pNormal->GetSamplerType())].Get();
         }
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::getPosition
+      Summary:  Returns the position of a renderable in world space,
+                the translation of its world matrix
+      Args:     const Renderable& renderable
+                  The renderable
+      Returns:  XMFLOAT3
+                  Position the draws are sorted by
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    XMFLOAT3 Renderer::getPosition(_In_ const Renderable& renderable)
+    {
+        XMFLOAT3 position;
+        XMStoreFloat3(&position, renderable.GetWorldMatrix().r[3]);
+
+        return position;
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Renderer::RenderSceneToTexture
       Summary:  Render scene to the texture
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     void Renderer::RenderSceneToTexture()
     {
-        m_immediateContext->OMSetRenderTargets(1u, m_shadowMapTexture->GetRenderTargetView().GetAddressOf(), m_depthStencilView.Get());
+        m_renderDevice->OMSetRenderTargets(1u, m_shadowMapTexture->GetRenderTargetView().GetAddressOf(), m_depthStencilView.Get());
 
-        m_immediateContext->ClearRenderTargetView(m_shadowMapTexture->GetRenderTargetView().Get(), Colors::White);
-        m_immediateContext->ClearDepthStencilView(m_depthStencilView.Get(), D3D11_CLEAR_DEPTH, 1.0f, 0);
+        m_renderDevice->ClearRenderTargetView(m_shadowMapTexture->GetRenderTargetView().Get(), Colors::White);
+        m_renderDevice->ClearDepthStencilView(m_depthStencilView.Get(), D3D11_CLEAR_DEPTH, 1.0f, 0);
 
-        m_immediateContext->VSSetShader(m_shadowVertexShader->GetVertexShader().Get(), nullptr, 0u);
-        m_immediateContext->PSSetShader(m_shadowPixelShader->GetPixelShader().Get(), nullptr, 0u);
+        m_renderDevice->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+        m_renderDevice->VSSetShader(m_shadowVertexShader->GetVertexShader().Get());
+        m_renderDevice->PSSetShader(m_shadowPixelShader->GetPixelShader().Get());
 
         for (auto renderable : m_scenes[m_pszMainSceneName]->GetRenderables())
         {
@@ -886,13 +1410,13 @@ namespace library
             UINT uStride = sizeof(SimpleVertex);
             UINT uOffset = 0;
 
-            m_immediateContext->IASetVertexBuffers(0u, 1u, renderable.second->GetVertexBuffer().GetAddressOf(), &uStride, &uOffset);
+            m_renderDevice->IASetVertexBuffers(0u, 1u, renderable.second->GetVertexBuffer().GetAddressOf(), &uStride, &uOffset);
 
             // Set the index buffer
-            m_immediateContext->IASetIndexBuffer(renderable.second->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0u);
+            m_renderDevice->IASetIndexBuffer(renderable.second->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0u);
 
             // Set the input layout
-            m_immediateContext->IASetInputLayout(m_shadowVertexShader->GetVertexLayout().Get());
+            m_renderDevice->IASetInputLayout(m_shadowVertexShader->GetVertexLayout().Get());
 
             // Shadow constant buffer
             CBShadowMatrix cbShadowMatrix =
@@ -903,13 +1427,13 @@ namespace library
                 .IsVoxel = FALSE
             };
 
-            m_immediateContext->UpdateSubresource(m_cbShadowMatrix.Get(), 0u, nullptr, &cbShadowMatrix, 0u, 0u);
+            m_renderDevice->UpdateSubresource(m_cbShadowMatrix.Get(), 0u, nullptr, &cbShadowMatrix, 0u, 0u);
 
-            m_immediateContext->VSSetConstantBuffers(0u, 1u, m_cbShadowMatrix.GetAddressOf());
+            m_renderDevice->VSSetConstantBuffers(0u, 1u, m_cbShadowMatrix.GetAddressOf());
 
             for (UINT i = 0; i < renderable.second->GetNumMeshes(); ++i)
             {
-                m_immediateContext->DrawIndexed(renderable.second->GetMesh(i).uNumIndices, renderable.second->GetMesh(i).uBaseIndex, static_cast<INT>(renderable.second->GetMesh(i).uBaseVertex));
+                m_renderDevice->DrawIndexed(renderable.second->GetMesh(i).uNumIndices, renderable.second->GetMesh(i).uBaseIndex, static_cast<INT>(renderable.second->GetMesh(i).uBaseVertex));
             }
         }
 
@@ -919,13 +1443,13 @@ namespace library
             UINT stride0 = sizeof(SimpleVertex);
             UINT offset0 = 0;
 
-            m_immediateContext->IASetVertexBuffers(0u, 1u, model.second->GetVertexBuffer().GetAddressOf(), &stride0, &offset0);
+            m_renderDevice->IASetVertexBuffers(0u, 1u, model.second->GetVertexBuffer().GetAddressOf(), &stride0, &offset0);
 
             // Set the index buffer
-            m_immediateContext->IASetIndexBuffer(model.second->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0);
+            m_renderDevice->IASetIndexBuffer(model.second->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0);
 
             // Set the input layout
-            m_immediateContext->IASetInputLayout(m_shadowVertexShader->GetVertexLayout().Get());
+            m_renderDevice->IASetInputLayout(m_shadowVertexShader->GetVertexLayout().Get());
 
             // Shadow constant buffer
             CBShadowMatrix cbShadowMatrix =
@@ -936,17 +1460,17 @@ namespace library
                 .IsVoxel = FALSE
             };
 
-            m_immediateContext->UpdateSubresource(m_cbShadowMatrix.Get(), 0u, nullptr, &cbShadowMatrix, 0u, 0u);
+            m_renderDevice->UpdateSubresource(m_cbShadowMatrix.Get(), 0u, nullptr, &cbShadowMatrix, 0u, 0u);
 
-            m_immediateContext->VSSetConstantBuffers(0u, 1u, m_cbShadowMatrix.GetAddressOf());
+            m_renderDevice->VSSetConstantBuffers(0u, 1u, m_cbShadowMatrix.GetAddressOf());
 
             for (UINT i = 0; i < model.second->GetNumMeshes(); ++i)
             {
-                m_immediateContext->DrawIndexed(model.second->GetMesh(i).uNumIndices, model.second->GetMesh(i).uBaseIndex, static_cast<INT>(model.second->GetMesh(i).uBaseVertex));
+                m_renderDevice->DrawIndexed(model.second->GetMesh(i).uNumIndices, model.second->GetMesh(i).uBaseIndex, static_cast<INT>(model.second->GetMesh(i).uBaseVertex));
             }
         }
 
-        m_immediateContext->OMSetRenderTargets(1, m_renderTargetView.GetAddressOf(), m_depthStencilView.Get());
+        m_renderDevice->OMSetRenderTargets(1, m_renderTargetView.GetAddressOf(), m_depthStencilView.Get());
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -13,8 +13,14 @@
 #include "Camera/Camera.h"
 #include "Light/PointLight.h"
 #include "Model/Model.h"
+#include "Renderer/ConstantBufferRing.h"
 #include "Renderer/DataTypes.h"
+#include "Renderer/PipelineState.h"
 #include "Renderer/Renderable.h"
+#include "Renderer/RenderDevice.h"
+#include "Renderer/RenderQueue.h"
+#include "Renderer/StateFilterRenderDevice.h"
+#include "Renderer/UploadArena.h"
 #include "Scene/Scene.h"
 #include "Shader/PixelShader.h"
 #include "Shader/VertexShader.h"
@@ -24,13 +30,14 @@
 
 namespace library
 {
-
     /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
       Class:    Renderer
       Summary:  Renderer initializes Direct3D, and renders renderable
                 data onto the screen
       Methods:  Initialize
                   Creates Direct3D device and swap chain
+                InitializeHeadless
+                  Initializes on a given render device without a window
                 AddRenderable
                   Add a renderable object and initialize the object
                 Update
@@ -39,6 +46,19 @@ namespace library
                   Renders the frame
                 GetDriverType
                   Returns the Direct3D driver type
+                GetRenderDevice
+                  Returns the render device
+                GetRenderQueueStats
+                  Returns the draws and state changes of the last frame
+                GetStateFilterStats
+                  Returns the state calls issued and dropped in the last
+                  frame
+                GetConstantBufferRingStats
+                  Returns the constants uploaded in the last frame
+                GetVertexUploadArena
+                  Returns the arena of the transient vertex data
+                GetPipelineStateCache
+                  Returns the pipelines the renderables share
                 Renderer
                   Constructor.
                 ~Renderer
@@ -55,6 +75,7 @@ namespace library
         ~Renderer() = default;
 
         HRESULT Initialize(_In_ HWND hWnd);
+        HRESULT InitializeHeadless(_In_ const std::shared_ptr<RenderDevice>& renderDevice, _In_ UINT uWidth, _In_ UINT uHeight);
 
         HRESULT AddScene(_In_ PCWSTR pszSceneName, _In_ const std::shared_ptr<Scene>& scene);
         std::shared_ptr<Scene> GetSceneOrNull(_In_ PCWSTR pszSceneName);
@@ -67,29 +88,54 @@ namespace library
         void RenderSceneToTexture();
 
         D3D_DRIVER_TYPE GetDriverType() const;
+        std::shared_ptr<RenderDevice> GetRenderDevice() const;
+        const RenderQueueStats& GetRenderQueueStats() const;
+        StateFilterStats GetStateFilterStats() const;
+        const ConstantBufferRingStats& GetConstantBufferRingStats() const;
+        UploadArena& GetVertexUploadArena();
+        const PipelineStateCache& GetPipelineStateCache() const;
 
         std::shared_ptr<MainWindow> WindowPtr;
 
+    private:
+        HRESULT initializeResources(_In_ UINT uWidth, _In_ UINT uHeight);
+
+        HRESULT createPipelineStates(_In_ Scene& scene);
+        HRESULT getPipelineState(_In_ Renderable& renderable, _In_ const PipelineStateDesc& streams, _Out_ const PipelineState*& outPipelineState);
+        HRESULT createDrawState(_In_ Renderable& renderable, _In_ const PipelineStateDesc& streams, _Out_ DrawState& outState);
+        DrawBindings getEnvironmentBindings(_In_ Scene& scene) const;
+        void queueSkyBox(_In_ Scene& scene);
+        void queueRenderables(_In_ Scene& scene);
+        void queueVoxels(_In_ Scene& scene);
+        void queueVoxelChunks(_In_ Scene& scene);
+        void queueTerrain(_In_ Scene& scene);
+        void queueModels(_In_ Scene& scene);
+
+        static void addMaterialBindings(_In_ const Material& material, _In_ UINT uDiffuseSampler, _In_ UINT uNormalSampler, _Inout_ DrawBindings& bindings);
+        static XMFLOAT3 getPosition(_In_ const Renderable& renderable);
 
     private:
+        static constexpr const FLOAT FAR_DISTANCE = 1000.0f;
+
         D3D_DRIVER_TYPE m_driverType;
         D3D_FEATURE_LEVEL m_featureLevel;
         ComPtr<ID3D11Device> m_d3dDevice;
         ComPtr<ID3D11Device1> m_d3dDevice1;
         ComPtr<ID3D11DeviceContext> m_immediateContext;
         ComPtr<ID3D11DeviceContext1> m_immediateContext1;
+        std::shared_ptr<RenderDevice> m_renderDevice;
+        std::shared_ptr<StateFilterRenderDevice> m_stateFilter;
         ComPtr<IDXGISwapChain> m_swapChain;
         ComPtr<IDXGISwapChain1> m_swapChain1;
         ComPtr<ID3D11RenderTargetView> m_renderTargetView;
         ComPtr<ID3D11Texture2D> m_depthStencil;
         ComPtr<ID3D11DepthStencilView> m_depthStencilView;
-        ComPtr<ID3D11Buffer> m_cbChangeOnResize;
-        ComPtr<ID3D11Buffer> m_cbLights;
         ComPtr<ID3D11Buffer> m_cbShadowMatrix;
         PCWSTR m_pszMainSceneName;
         BYTE m_padding[8];
         Camera m_camera;
         XMMATRIX m_projection;
+        FLOAT m_projectionScale;
 
         std::unordered_map<PCWSTR, std::shared_ptr<Renderable>> m_renderables;
         std::unordered_map<PCWSTR, std::shared_ptr<Model>> m_models;
@@ -101,6 +147,13 @@ namespace library
         std::shared_ptr<RenderTexture> m_shadowMapTexture;
         std::shared_ptr<ShadowVertexShader> m_shadowVertexShader;
         std::shared_ptr<PixelShader> m_shadowPixelShader;
+        RenderQueue m_renderQueue;
+        ConstantBufferRing m_constantBufferRing;
+        ConstantBufferRange m_cameraConstants;
+        ConstantBufferRange m_projectionConstants;
+        ConstantBufferRange m_lightConstants;
+        UploadArena m_vertexUploadArena;
+        PipelineStateCache m_pipelineStates;
     };
 
 }
\ No newline at end of file
@@ -29,19 +29,17 @@ namespace library
 
       Summary:  Initializes the skybox and cube map texture
 
-      Args:     ID3D11Device* pDevice
-                  The Direct3D device to create the buffers
-                ID3D11DeviceContext* pImmediateContext
-                  The Direct3D context to set buffers
+      Args:     RenderDevice* pDevice
+                  The render device to create the buffers
 
       Modifies: [m_aMeshes, m_aMaterials].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    HRESULT Skybox::Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext)
+    HRESULT Skybox::Initialize(_In_ RenderDevice* pDevice)
     {
         HRESULT hr = S_OK;
 
         // Call parent��s Initialize method
-        hr = Model::Initialize(pDevice, pImmediateContext);
+        hr = Model::Initialize(pDevice);
 
         if (FAILED(hr))
         {
@@ -56,7 +54,7 @@ namespace library
 
         // Set and initialize the first (0th) material��s diffuse texture by the m_cubeMapFileName
         m_aMaterials[0]->pDiffuse = std::make_shared<Texture>(m_cubeMapFileName);
-        hr = m_aMaterials[0]->pDiffuse->Initialize(pDevice, pImmediateContext);
+        hr = m_aMaterials[0]->pDiffuse->Initialize(pDevice);
 
         if (FAILED(hr))
         {
@@ -0,0 +1,862 @@
+#include "Renderer/StateFilterRenderDevice.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateFilterRenderDevice::StateFilterRenderDevice
+      Summary:  Constructor, nothing is known to be bound yet
+      Args:     const std::shared_ptr<RenderDevice>& renderDevice
+                  Render device to forward the calls to
+      Modifies: [m_renderDevice, m_vertexBuffers, m_indexBuffer,
+                 m_inputLayout, m_topology, m_vertexShader,
+                 m_pixelShader, m_vsConstantBuffers,
+                 m_psConstantBuffers, m_vsViews, m_psViews,
+                 m_psSamplers, m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    StateFilterRenderDevice::StateFilterRenderDevice(_In_ const std::shared_ptr<RenderDevice>& renderDevice)
+        : m_renderDevice(renderDevice)
+        , m_vertexBuffers()
+        , m_indexBuffer()
+        , m_inputLayout()
+        , m_topology()
+        , m_vertexShader()
+        , m_pixelShader()
+        , m_vsConstantBuffers()
+        , m_psConstantBuffers()
+        , m_vsViews()
+        , m_psViews()
+        , m_psSamplers()
+        , m_stats()
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateFilterRenderDevice::GetRenderDevice
+      Summary:  Returns the render device the calls are forwarded to
+      Returns:  const std::shared_ptr<RenderDevice>&
+                  The render device
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const std::shared_ptr<RenderDevice>& StateFilterRenderDevice::GetRenderDevice() const
+    {
+        return m_renderDevice;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateFilterRenderDevice::GetStats
+      Summary:  Returns the state calls forwarded and dropped since the
+                construction or the last reset
+      Returns:  const StateFilterStats&
+                  Counters
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const StateFilterStats& StateFilterRenderDevice::GetStats() const
+    {
+        return m_stats;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateFilterRenderDevice::ResetStats
+      Summary:  Resets the counters, the shadowed state is kept
+      Modifies: [m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StateFilterRenderDevice::ResetStats()
+    {
+        m_stats = StateFilterStats();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateFilterRenderDevice::CreateBuffer
+      Summary:  Forwards the call
+      Args:     const D3D11_BUFFER_DESC* pDesc
+                  Description of the buffer
+                const D3D11_SUBRESOURCE_DATA* pInitialData
+                  Initial data, may be null
+                ID3D11Buffer** ppBuffer
+                  Receives the buffer
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT StateFilterRenderDevice::CreateBuffer(_In_ const D3D11_BUFFER_DESC* pDesc, _In_opt_ const D3D11_SUBRESOURCE_DATA* pInitialData, _Out_ ID3D11Buffer** ppBuffer)
+    {
+        return m_renderDevice->CreateBuffer(pDesc, pInitialData, ppBuffer);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateFilterRenderDevice::CreateTexture2D
+      Summary:  Forwards the call
+      Args:     const D3D11_TEXTURE2D_DESC* pDesc
+                  Description of the texture
+                const D3D11_SUBRESOURCE_DATA* pInitialData
+                  Initial data of the subresources, may be null
+                ID3D11Texture2D** ppTexture2D
+                  Receives the texture
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT StateFilterRenderDevice::CreateTexture2D(_In_ const D3D11_TEXTURE2D_DESC* pDesc, _In_opt_ const D3D11_SUBRESOURCE_DATA* pInitialData, _Out_ ID3D11Texture2D** ppTexture2D)
+    {
+        return m_renderDevice->CreateTexture2D(pDesc, pInitialData, ppTexture2D);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateFilterRenderDevice::CreateTextureFromFile
+      Summary:  Forwards the call
+      Args:     const std::filesystem::path& filePath
+                  Path of the texture file
+                ID3D11ShaderResourceView** ppTextureView
+                  Receives the view of the texture
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT StateFilterRenderDevice::CreateTextureFromFile(_In_ const std::filesystem::path& filePath, _Out_ ID3D11ShaderResourceView** ppTextureView)
+    {
+        return m_renderDevice->CreateTextureFromFile(filePath, ppTextureView);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateFilterRenderDevice::CreateShaderResourceView
+      Summary:  Forwards the call
+      Args:     ID3D11Resource* pResource
+                  Resource of the view
+                const D3D11_SHADER_RESOURCE_VIEW_DESC* pDesc
+                  Description of the view, may be null
+                ID3D11ShaderResourceView** ppView
+                  Receives the view
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT StateFilterRenderDevice::CreateShaderResourceView(_In_ ID3D11Resource* pResource, _In_opt_ const D3D11_SHADER_RESOURCE_VIEW_DESC* pDesc, _Out_ ID3D11ShaderResourceView** ppView)
+    {
+        return m_renderDevice->CreateShaderResourceView(pResource, pDesc, ppView);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateFilterRenderDevice::CreateRenderTargetView
+      Summary:  Forwards the call
+      Args:     ID3D11Resource* pResource
+                  Resource of the view
+                const D3D11_RENDER_TARGET_VIEW_DESC* pDesc
+                  Description of the view, may be null
+                ID3D11RenderTargetView** ppView
+                  Receives the view
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT StateFilterRenderDevice::CreateRenderTargetView(_In_ ID3D11Resource* pResource, _In_opt_ const D3D11_RENDER_TARGET_VIEW_DESC* pDesc, _Out_ ID3D11RenderTargetView** ppView)
+    {
+        return m_renderDevice->CreateRenderTargetView(pResource, pDesc, ppView);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateFilterRenderDevice::CreateDepthStencilView
+      Summary:  Forwards the call
+      Args:     ID3D11Resource* pResource
+                  Resource of the view
+                const D3D11_DEPTH_STENCIL_VIEW_DESC* pDesc
+                  Description of the view, may be null
+                ID3D11DepthStencilView** ppView
+                  Receives the view
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT StateFilterRenderDevice::CreateDepthStencilView(_In_ ID3D11Resource* pResource, _In_opt_ const D3D11_DEPTH_STENCIL_VIEW_DESC* pDesc, _Out_ ID3D11DepthStencilView** ppView)
+    {
+        return m_renderDevice->CreateDepthStencilView(pResource, pDesc, ppView);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateFilterRenderDevice::CreateSamplerState
+      Summary:  Forwards the call
+      Args:     const D3D11_SAMPLER_DESC* pDesc
+                  Description of the sampler
+                ID3D11SamplerState** ppSamplerState
+                  Receives the sampler
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT StateFilterRenderDevice::CreateSamplerState(_In_ const D3D11_SAMPLER_DESC* pDesc, _Out_ ID3D11SamplerState** ppSamplerState)
+    {
+        return m_renderDevice->CreateSamplerState(pDesc, ppSamplerState);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateFilterRenderDevice::CompileShader
+      Summary:  Forwards the call
+      Args:     PCWSTR pszFileName
+                  Path of the shader file
+                PCSTR pszEntryPoint
+                  Entry point of the shader
+                PCSTR pszShaderModel
+                  Shader model to compile to
+                UINT uFlags
+                  Compile flags
+                ID3DBlob** ppCode
+                  Receives the bytecode
+                ID3DBlob** ppErrorMessages
+                  Receives the error messages, may be null
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT StateFilterRenderDevice::CompileShader(_In_ PCWSTR pszFileName, _In_ PCSTR pszEntryPoint, _In_ PCSTR pszShaderModel, _In_ UINT uFlags, _Outptr_ ID3DBlob** ppCode, _Outptr_opt_result_maybenull_ ID3DBlob** ppErrorMessages)
+    {
+        return m_renderDevice->CompileShader(pszFileName, pszEntryPoint, pszShaderModel, uFlags, ppCode, ppErrorMessages);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateFilterRenderDevice::CreateInputLayout
+      Summary:  Forwards the call
+      Args:     const D3D11_INPUT_ELEMENT_DESC* pInputElementDescs
+                  Elements of the layout
+                UINT uNumElements
+                  Number of elements
+                const void* pShaderBytecode
+                  Bytecode of the vertex shader
+                SIZE_T bytecodeLength
+                  Size of the bytecode
+                ID3D11InputLayout** ppInputLayout
+                  Receives the layout
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT StateFilterRenderDevice::CreateInputLayout(_In_reads_(uNumElements) const D3D11_INPUT_ELEMENT_DESC* pInputElementDescs, _In_ UINT uNumElements, _In_ const void* pShaderBytecode, _In_ SIZE_T bytecodeLength, _Out_ ID3D11InputLayout** ppInputLayout)
+    {
+        return m_renderDevice->CreateInputLayout(pInputElementDescs, uNumElements, pShaderBytecode, bytecodeLength, ppInputLayout);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateFilterRenderDevice::CreateVertexShader
+      Summary:  Forwards the call
+      Args:     const void* pShaderBytecode
+                  Bytecode of the shader
+                SIZE_T bytecodeLength
+                  Size of the bytecode
+                ID3D11VertexShader** ppVertexShader
+                  Receives the shader
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT StateFilterRenderDevice::CreateVertexShader(_In_ const void* pShaderBytecode, _In_ SIZE_T bytecodeLength, _Out_ ID3D11VertexShader** ppVertexShader)
+    {
+        return m_renderDevice->CreateVertexShader(pShaderBytecode, bytecodeLength, ppVertexShader);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateFilterRenderDevice::CreatePixelShader
+      Summary:  Forwards the call
+      Args:     const void* pShaderBytecode
+                  Bytecode of the shader
+                SIZE_T bytecodeLength
+                  Size of the bytecode
+                ID3D11PixelShader** ppPixelShader
+                  Receives the shader
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT StateFilterRenderDevice::CreatePixelShader(_In_ const void* pShaderBytecode, _In_ SIZE_T bytecodeLength, _Out_ ID3D11PixelShader** ppPixelShader)
+    {
+        return m_renderDevice->CreatePixelShader(pShaderBytecode, bytecodeLength, ppPixelShader);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateFilterRenderDevice::CreateQuery
+      Summary:  Forwards the call
+      Args:     const D3D11_QUERY_DESC* pQueryDesc
+                  Description of the query
+                ID3D11Query** ppQuery
+                  Receives the query
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT StateFilterRenderDevice::CreateQuery(_In_ const D3D11_QUERY_DESC* pQueryDesc, _Out_ ID3D11Query** ppQuery)
+    {
+        return m_renderDevice->CreateQuery(pQueryDesc, ppQuery);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateFilterRenderDevice::SupportsConstantBufferOffsets
+      Summary:  Forwards the call
+      Returns:  BOOL
+                  TRUE when constant buffers can be bound from an offset
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL StateFilterRenderDevice::SupportsConstantBufferOffsets() const
+    {
+        return m_renderDevice->SupportsConstantBufferOffsets();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateFilterRenderDevice::UpdateSubresource
+      Summary:  Forwards the call
+      Args:     ID3D11Resource* pDstResource
+                  Resource to update
+                UINT uDstSubresource
+                  Subresource to update
+                const D3D11_BOX* pDstBox
+                  Region to update, null for the whole subresource
+                const void* pSrcData
+                  Data to upload
+                UINT uSrcRowPitch
+                  Size of a row of the data
+                UINT uSrcDepthPitch
+                  Size of a slice of the data
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StateFilterRenderDevice::UpdateSubresource(_In_ ID3D11Resource* pDstResource, _In_ UINT uDstSubresource, _In_opt_ const D3D11_BOX* pDstBox, _In_ const void* pSrcData, _In_ UINT uSrcRowPitch, _In_ UINT uSrcDepthPitch)
+    {
+        m_renderDevice->UpdateSubresource(pDstResource, uDstSubresource, pDstBox, pSrcData, uSrcRowPitch, uSrcDepthPitch);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateFilterRenderDevice::Map
+      Summary:  Forwards the call
+      Args:     ID3D11Resource* pResource
+                  Resource to map
+                UINT uSubresource
+                  Subresource to map
+                D3D11_MAP mapType
+                  Access of the mapping
+                UINT uMapFlags
+                  Map flags
+                D3D11_MAPPED_SUBRESOURCE* pMappedResource
+                  Receives the mapped memory
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT StateFilterRenderDevice::Map(_In_ ID3D11Resource* pResource, _In_ UINT uSubresource, _In_ D3D11_MAP mapType, _In_ UINT uMapFlags, _Out_ D3D11_MAPPED_SUBRESOURCE* pMappedResource)
+    {
+        return m_renderDevice->Map(pResource, uSubresource, mapType, uMapFlags, pMappedResource);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateFilterRenderDevice::Unmap
+      Summary:  Forwards the call
+      Args:     ID3D11Resource* pResource
+                  Mapped resource
+                UINT uSubresource
+                  Mapped subresource
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StateFilterRenderDevice::Unmap(_In_ ID3D11Resource* pResource, _In_ UINT uSubresource)
+    {
+        m_renderDevice->Unmap(pResource, uSubresource);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateFilterRenderDevice::End
+      Summary:  Forwards the call
+      Args:     ID3D11Asynchronous* pAsync
+                  Query to issue
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StateFilterRenderDevice::End(_In_ ID3D11Asynchronous* pAsync)
+    {
+        m_renderDevice->End(pAsync);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateFilterRenderDevice::GetData
+      Summary:  Forwards the call
+      Args:     ID3D11Asynchronous* pAsync
+                  Issued query
+                void* pData
+                  Receives the result, may be null
+                UINT uDataSize
+                  Size of the result
+                UINT uGetDataFlags
+                  Flags of the read
+      Returns:  HRESULT
+                  S_OK once the result is available, S_FALSE before
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT StateFilterRenderDevice::GetData(_In_ ID3D11Asynchronous* pAsync, _Out_writes_bytes_opt_(uDataSize) void* pData, _In_ UINT uDataSize, _In_ UINT uGetDataFlags)
+    {
+        return m_renderDevice->GetData(pAsync, pData, uDataSize, uGetDataFlags);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateFilterRenderDevice::IASetVertexBuffers
+      Summary:  Binds the vertex buffers whose buffer, stride or offset
+                differs from the bound one
+      Args:     UINT uStartSlot
+                  First slot
+                UINT uNumBuffers
+                  Number of slots
+                ID3D11Buffer* const* ppVertexBuffers
+                  Buffers of the slots
+                const UINT* pStrides
+                  Strides of the slots
+                const UINT* pOffsets
+                  Offsets of the slots
+      Modifies: [m_vertexBuffers, m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StateFilterRenderDevice::IASetVertexBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_(uNumBuffers) ID3D11Buffer* const* ppVertexBuffers, _In_reads_(uNumBuffers) const UINT* pStrides, _In_reads_(uNumBuffers) const UINT* pOffsets)
+    {
+        VertexBufferSlot aSlots[D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT];
+        const UINT uNumSlots = std::min(uNumBuffers, static_cast<UINT>(D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT));
+        for (UINT i = 0u; i < uNumSlots; ++i)
+        {
+            aSlots[i] = { .pBuffer = ppVertexBuffers[i], .uStride = pStrides[i], .uOffset = pOffsets[i] };
+        }
+
+        UINT uFirst = 0u;
+        UINT uCount = 0u;
+        if (filter(m_vertexBuffers, uStartSlot, uNumBuffers, aSlots, uFirst, uCount))
+        {
+            m_renderDevice->IASetVertexBuffers(uStartSlot + uFirst, uCount, ppVertexBuffers + uFirst, pStrides + uFirst, pOffsets + uFirst);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateFilterRenderDevice::IASetIndexBuffer
+      Summary:  Binds the index buffer unless it is bound with the same
+                format and offset
+      Args:     ID3D11Buffer* pIndexBuffer
+                  Index buffer, may be null
+                DXGI_FORMAT format
+                  Format of the indices
+                UINT uOffset
+                  Offset of the first index
+      Modifies: [m_indexBuffer, m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StateFilterRenderDevice::IASetIndexBuffer(_In_opt_ ID3D11Buffer* pIndexBuffer, _In_ DXGI_FORMAT format, _In_ UINT uOffset)
+    {
+        const IndexBufferSlot slot = { .pBuffer = pIndexBuffer, .format = format, .uOffset = uOffset };
+
+        UINT uFirst = 0u;
+        UINT uCount = 0u;
+        if (filter(m_indexBuffer, 0u, 1u, &slot, uFirst, uCount))
+        {
+            m_renderDevice->IASetIndexBuffer(pIndexBuffer, format, uOffset);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateFilterRenderDevice::IASetInputLayout
+      Summary:  Binds the input layout unless it is bound
+      Args:     ID3D11InputLayout* pInputLayout
+                  Input layout, may be null
+      Modifies: [m_inputLayout, m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StateFilterRenderDevice::IASetInputLayout(_In_opt_ ID3D11InputLayout* pInputLayout)
+    {
+        UINT uFirst = 0u;
+        UINT uCount = 0u;
+        if (filter(m_inputLayout, 0u, 1u, &pInputLayout, uFirst, uCount))
+        {
+            m_renderDevice->IASetInputLayout(pInputLayout);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateFilterRenderDevice::IASetPrimitiveTopology
+      Summary:  Sets the topology unless it is set
+      Args:     D3D11_PRIMITIVE_TOPOLOGY topology
+                  Primitive topology
+      Modifies: [m_topology, m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StateFilterRenderDevice::IASetPrimitiveTopology(_In_ D3D11_PRIMITIVE_TOPOLOGY topology)
+    {
+        UINT uFirst = 0u;
+        UINT uCount = 0u;
+        if (filter(m_topology, 0u, 1u, &topology, uFirst, uCount))
+        {
+            m_renderDevice->IASetPrimitiveTopology(topology);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateFilterRenderDevice::VSSetShader
+      Summary:  Binds the vertex shader unless it is bound
+      Args:     ID3D11VertexShader* pVertexShader
+                  Vertex shader, may be null
+      Modifies: [m_vertexShader, m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StateFilterRenderDevice::VSSetShader(_In_opt_ ID3D11VertexShader* pVertexShader)
+    {
+        UINT uFirst = 0u;
+        UINT uCount = 0u;
+        if (filter(m_vertexShader, 0u, 1u, &pVertexShader, uFirst, uCount))
+        {
+            m_renderDevice->VSSetShader(pVertexShader);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateFilterRenderDevice::VSSetConstantBuffers
+      Summary:  Binds the constant buffers of the vertex shader that
+                differ from the bound ones
+      Args:     UINT uStartSlot
+                  First slot
+                UINT uNumBuffers
+                  Number of slots
+                ID3D11Buffer* const* ppConstantBuffers
+                  Buffers of the slots
+      Modifies: [m_vsConstantBuffers, m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StateFilterRenderDevice::VSSetConstantBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers)
+    {
+        UINT uFirst = 0u;
+        UINT uCount = 0u;
+        if (filterConstantBuffers(m_vsConstantBuffers, uStartSlot, uNumBuffers, ppConstantBuffers, nullptr, nullptr, uFirst, uCount))
+        {
+            m_renderDevice->VSSetConstantBuffers(uStartSlot + uFirst, uCount, ppConstantBuffers + uFirst);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateFilterRenderDevice::VSSetConstantBuffers1
+      Summary:  Binds the constant buffer ranges of the vertex shader
+                that differ from the bound ones
+      Args:     UINT uStartSlot
+                  First slot
+                UINT uNumBuffers
+                  Number of slots
+                ID3D11Buffer* const* ppConstantBuffers
+                  Buffers of the slots
+                const UINT* pFirstConstant
+                  First constant of the range of each slot
+                const UINT* pNumConstants
+                  Number of constants of the range of each slot
+      Modifies: [m_vsConstantBuffers, m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StateFilterRenderDevice::VSSetConstantBuffers1(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers, _In_reads_(uNumBuffers) const UINT* pFirstConstant, _In_reads_(uNumBuffers) const UINT* pNumConstants)
+    {
+        UINT uFirst = 0u;
+        UINT uCount = 0u;
+        if (filterConstantBuffers(m_vsConstantBuffers, uStartSlot, uNumBuffers, ppConstantBuffers, pFirstConstant, pNumConstants, uFirst, uCount))
+        {
+            m_renderDevice->VSSetConstantBuffers1(uStartSlot + uFirst, uCount, ppConstantBuffers + uFirst, pFirstConstant + uFirst, pNumConstants + uFirst);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateFilterRenderDevice::VSSetShaderResources
+      Summary:  Binds the views of the vertex shader that differ from
+                the bound ones
+      Args:     UINT uStartSlot
+                  First slot
+                UINT uNumViews
+                  Number of slots
+                ID3D11ShaderResourceView* const* ppShaderResourceViews
+                  Views of the slots
+      Modifies: [m_vsViews, m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StateFilterRenderDevice::VSSetShaderResources(_In_ UINT uStartSlot, _In_ UINT uNumViews, _In_reads_(uNumViews) ID3D11ShaderResourceView* const* ppShaderResourceViews)
+    {
+        UINT uFirst = 0u;
+        UINT uCount = 0u;
+        if (filter(m_vsViews, uStartSlot, uNumViews, ppShaderResourceViews, uFirst, uCount))
+        {
+            m_renderDevice->VSSetShaderResources(uStartSlot + uFirst, uCount, ppShaderResourceViews + uFirst);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateFilterRenderDevice::PSSetShader
+      Summary:  Binds the pixel shader unless it is bound
+      Args:     ID3D11PixelShader* pPixelShader
+                  Pixel shader, may be null
+      Modifies: [m_pixelShader, m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StateFilterRenderDevice::PSSetShader(_In_opt_ ID3D11PixelShader* pPixelShader)
+    {
+        UINT uFirst = 0u;
+        UINT uCount = 0u;
+        if (filter(m_pixelShader, 0u, 1u, &pPixelShader, uFirst, uCount))
+        {
+            m_renderDevice->PSSetShader(pPixelShader);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateFilterRenderDevice::PSSetConstantBuffers
+      Summary:  Binds the constant buffers of the pixel shader that
+                differ from the bound ones
+      Args:     UINT uStartSlot
+                  First slot
+                UINT uNumBuffers
+                  Number of slots
+                ID3D11Buffer* const* ppConstantBuffers
+                  Buffers of the slots
+      Modifies: [m_psConstantBuffers, m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StateFilterRenderDevice::PSSetConstantBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers)
+    {
+        UINT uFirst = 0u;
+        UINT uCount = 0u;
+        if (filterConstantBuffers(m_psConstantBuffers, uStartSlot, uNumBuffers, ppConstantBuffers, nullptr, nullptr, uFirst, uCount))
+        {
+            m_renderDevice->PSSetConstantBuffers(uStartSlot + uFirst, uCount, ppConstantBuffers + uFirst);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateFilterRenderDevice::PSSetConstantBuffers1
+      Summary:  Binds the constant buffer ranges of the pixel shader
+                that differ from the bound ones
+      Args:     UINT uStartSlot
+                  First slot
+                UINT uNumBuffers
+                  Number of slots
+                ID3D11Buffer* const* ppConstantBuffers
+                  Buffers of the slots
+                const UINT* pFirstConstant
+                  First constant of the range of each slot
+                const UINT* pNumConstants
+                  Number of constants of the range of each slot
+      Modifies: [m_psConstantBuffers, m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StateFilterRenderDevice::PSSetConstantBuffers1(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers, _In_reads_(uNumBuffers) const UINT* pFirstConstant, _In_reads_(uNumBuffers) const UINT* pNumConstants)
+    {
+        UINT uFirst = 0u;
+        UINT uCount = 0u;
+        if (filterConstantBuffers(m_psConstantBuffers, uStartSlot, uNumBuffers, ppConstantBuffers, pFirstConstant, pNumConstants, uFirst, uCount))
+        {
+            m_renderDevice->PSSetConstantBuffers1(uStartSlot + uFirst, uCount, ppConstantBuffers + uFirst, pFirstConstant + uFirst, pNumConstants + uFirst);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateFilterRenderDevice::PSSetShaderResources
+      Summary:  Binds the views of the pixel shader that differ from the
+                bound ones
+      Args:     UINT uStartSlot
+                  First slot
+                UINT uNumViews
+                  Number of slots
+                ID3D11ShaderResourceView* const* ppShaderResourceViews
+                  Views of the slots
+      Modifies: [m_psViews, m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StateFilterRenderDevice::PSSetShaderResources(_In_ UINT uStartSlot, _In_ UINT uNumViews, _In_reads_(uNumViews) ID3D11ShaderResourceView* const* ppShaderResourceViews)
+    {
+        UINT uFirst = 0u;
+        UINT uCount = 0u;
+        if (filter(m_psViews, uStartSlot, uNumViews, ppShaderResourceViews, uFirst, uCount))
+        {
+            m_renderDevice->PSSetShaderResources(uStartSlot + uFirst, uCount, ppShaderResourceViews + uFirst);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateFilterRenderDevice::PSSetSamplers
+      Summary:  Binds the samplers of the pixel shader that differ from
+                the bound ones
+      Args:     UINT uStartSlot
+                  First slot
+                UINT uNumSamplers
+                  Number of slots
+                ID3D11SamplerState* const* ppSamplers
+                  Samplers of the slots
+      Modifies: [m_psSamplers, m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StateFilterRenderDevice::PSSetSamplers(_In_ UINT uStartSlot, _In_ UINT uNumSamplers, _In_reads_(uNumSamplers) ID3D11SamplerState* const* ppSamplers)
+    {
+        UINT uFirst = 0u;
+        UINT uCount = 0u;
+        if (filter(m_psSamplers, uStartSlot, uNumSamplers, ppSamplers, uFirst, uCount))
+        {
+            m_renderDevice->PSSetSamplers(uStartSlot + uFirst, uCount, ppSamplers + uFirst);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateFilterRenderDevice::OMSetRenderTargets
+      Summary:  Forwards the call and forgets the bound views, Direct3D
+                unbinds the views of a resource bound as a target
+      Args:     UINT uNumViews
+                  Number of render targets
+                ID3D11RenderTargetView* const* ppRenderTargetViews
+                  Render targets
+                ID3D11DepthStencilView* pDepthStencilView
+                  Depth stencil target, may be null
+      Modifies: [m_vsViews, m_psViews].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StateFilterRenderDevice::OMSetRenderTargets(_In_ UINT uNumViews, _In_reads_opt_(uNumViews) ID3D11RenderTargetView* const* ppRenderTargetViews, _In_opt_ ID3D11DepthStencilView* pDepthStencilView)
+    {
+        m_renderDevice->OMSetRenderTargets(uNumViews, ppRenderTargetViews, pDepthStencilView);
+
+        std::fill(std::begin(m_vsViews.abKnown), std::end(m_vsViews.abKnown), FALSE);
+        std::fill(std::begin(m_psViews.abKnown), std::end(m_psViews.abKnown), FALSE);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateFilterRenderDevice::RSSetViewports
+      Summary:  Forwards the call
+      Args:     UINT uNumViewports
+                  Number of viewports
+                const D3D11_VIEWPORT* pViewports
+                  Viewports
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StateFilterRenderDevice::RSSetViewports(_In_ UINT uNumViewports, _In_reads_(uNumViewports) const D3D11_VIEWPORT* pViewports)
+    {
+        m_renderDevice->RSSetViewports(uNumViewports, pViewports);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateFilterRenderDevice::ClearRenderTargetView
+      Summary:  Forwards the call
+      Args:     ID3D11RenderTargetView* pRenderTargetView
+                  Render target to clear
+                const FLOAT aColorRGBA[4]
+                  Clear color
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StateFilterRenderDevice::ClearRenderTargetView(_In_ ID3D11RenderTargetView* pRenderTargetView, _In_ const FLOAT aColorRGBA[4])
+    {
+        m_renderDevice->ClearRenderTargetView(pRenderTargetView, aColorRGBA);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateFilterRenderDevice::ClearDepthStencilView
+      Summary:  Forwards the call
+      Args:     ID3D11DepthStencilView* pDepthStencilView
+                  Depth stencil target to clear
+                UINT uClearFlags
+                  Parts to clear
+                FLOAT depth
+                  Clear depth
+                UINT8 stencil
+                  Clear stencil
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StateFilterRenderDevice::ClearDepthStencilView(_In_ ID3D11DepthStencilView* pDepthStencilView, _In_ UINT uClearFlags, _In_ FLOAT depth, _In_ UINT8 stencil)
+    {
+        m_renderDevice->ClearDepthStencilView(pDepthStencilView, uClearFlags, depth, stencil);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateFilterRenderDevice::DrawIndexed
+      Summary:  Forwards the call
+      Args:     UINT uIndexCount
+                  Number of indices
+                UINT uStartIndexLocation
+                  First index
+                INT baseVertexLocation
+                  Added to every index
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StateFilterRenderDevice::DrawIndexed(_In_ UINT uIndexCount, _In_ UINT uStartIndexLocation, _In_ INT baseVertexLocation)
+    {
+        m_renderDevice->DrawIndexed(uIndexCount, uStartIndexLocation, baseVertexLocation);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateFilterRenderDevice::DrawIndexedInstanced
+      Summary:  Forwards the call
+      Args:     UINT uIndexCountPerInstance
+                  Number of indices of an instance
+                UINT uInstanceCount
+                  Number of instances
+                UINT uStartIndexLocation
+                  First index
+                INT baseVertexLocation
+                  Added to every index
+                UINT uStartInstanceLocation
+                  First instance
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void StateFilterRenderDevice::DrawIndexedInstanced(_In_ UINT uIndexCountPerInstance, _In_ UINT uInstanceCount, _In_ UINT uStartIndexLocation, _In_ INT baseVertexLocation, _In_ UINT uStartInstanceLocation)
+    {
+        m_renderDevice->DrawIndexedInstanced(uIndexCountPerInstance, uInstanceCount, uStartIndexLocation, baseVertexLocation, uStartInstanceLocation);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateFilterRenderDevice::filterConstantBuffers
+      Summary:  Filters a constant buffer call, with the ranges of the
+                slots or without them for the whole buffers
+      Args:     SlotShadow<ConstantBufferSlot, ...>& shadow
+                  Bound constant buffers of the stage
+                UINT uStartSlot
+                  First slot of the call
+                UINT uNumBuffers
+                  Number of slots of the call
+                ID3D11Buffer* const* ppConstantBuffers
+                  Buffers of the call
+                const UINT* pFirstConstant
+                  First constants of the ranges, null for whole buffers
+                const UINT* pNumConstants
+                  Numbers of constants of the ranges, null for whole
+                  buffers
+                UINT& uOutFirst
+                  Receives the first slot to bind, relative to the
+                  start slot
+                UINT& uOutCount
+                  Receives the number of slots to bind
+      Modifies: [m_stats].
+      Returns:  BOOL
+                  TRUE when the call has to be issued
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL StateFilterRenderDevice::filterConstantBuffers(_Inout_ SlotShadow<ConstantBufferSlot, D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT>& shadow, _In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers, _In_reads_opt_(uNumBuffers) const UINT* pFirstConstant, _In_reads_opt_(uNumBuffers) const UINT* pNumConstants, _Out_ UINT& uOutFirst, _Out_ UINT& uOutCount)
+    {
+        ConstantBufferSlot aSlots[D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT];
+        const UINT uNumSlots = std::min(uNumBuffers, static_cast<UINT>(D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT));
+        for (UINT i = 0u; i < uNumSlots; ++i)
+        {
+            aSlots[i] =
+            {
+                .pBuffer = ppConstantBuffers[i],
+                .uFirstConstant = pFirstConstant ? pFirstConstant[i] : 0u,
+                .uNumConstants = pNumConstants ? pNumConstants[i] : 0u
+            };
+        }
+
+        return filter(shadow, uStartSlot, uNumBuffers, aSlots, uOutFirst, uOutCount);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   StateFilterRenderDevice::filter
+      Summary:  Compares the values of a call with the shadow, narrows
+                the call to the first through the last slot that
+                changes and records them as bound. A call reaching past
+                the slots of the shadow is issued in full and leaves
+                its slots unknown
+      Args:     SlotShadow<T, N>& shadow
+                  Bound values of the slots
+                UINT uStartSlot
+                  First slot of the call
+                UINT uNumSlots
+                  Number of slots of the call
+                const T* pValues
+                  Values of the call
+                UINT& uOutFirst
+                  Receives the first slot to bind, relative to the
+                  start slot
+                UINT& uOutCount
+                  Receives the number of slots to bind
+      Modifies: [m_stats].
+      Returns:  BOOL
+                  TRUE when the call has to be issued
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    template <class T, UINT N>
+    BOOL StateFilterRenderDevice::filter(_Inout_ SlotShadow<T, N>& shadow, _In_ UINT uStartSlot, _In_ UINT uNumSlots, _In_reads_(uNumSlots) const T* pValues, _Out_ UINT& uOutFirst, _Out_ UINT& uOutCount)
+    {
+        uOutFirst = 0u;
+        uOutCount = uNumSlots;
+
+        if (uStartSlot >= N || uNumSlots > N - uStartSlot)
+        {
+            for (UINT uSlot = uStartSlot; uSlot < N; ++uSlot)
+            {
+                shadow.abKnown[uSlot] = FALSE;
+            }
+            ++m_stats.uNumIssuedCalls;
+            return TRUE;
+        }
+
+        UINT uFirst = uNumSlots;
+        UINT uLast = 0u;
+        for (UINT i = 0u; i < uNumSlots; ++i)
+        {
+            const UINT uSlot = uStartSlot + i;
+            if (!shadow.abKnown[uSlot] || !(shadow.aValues[uSlot] == pValues[i]))
+            {
+                uFirst = std::min(uFirst, i);
+                uLast = i;
+                shadow.aValues[uSlot] = pValues[i];
+                shadow.abKnown[uSlot] = TRUE;
+            }
+        }
+
+        if (uFirst == uNumSlots)
+        {
+            ++m_stats.uNumFilteredCalls;
+            return FALSE;
+        }
+
+        uOutFirst = uFirst;
+        uOutCount = uLast - uFirst + 1u;
+        ++m_stats.uNumIssuedCalls;
+        return TRUE;
+    }
+}
\ No newline at end of file
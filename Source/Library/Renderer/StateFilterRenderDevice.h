@@ -0,0 +1,172 @@
+/*+===================================================================
+  File:      STATEFILTERRENDERDEVICE.H
+
+  Summary:   StateFilterRenderDevice header file contains declarations
+             of StateFilterRenderDevice class, the render device that
+             drops the state calls binding what is already bound before
+             they reach another render device.
+
+  Classes: StateFilterRenderDevice
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Renderer/RenderDevice.h"
+
+namespace library
+{
+    struct StateFilterStats
+    {
+        UINT64 uNumIssuedCalls;
+        UINT64 uNumFilteredCalls;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    StateFilterRenderDevice
+
+      Summary:  Render device in front of another one that shadows the
+                state bound on the immediate context: the shaders, the
+                input layout, the topology, the vertex and index
+                buffers and, per slot, the constant buffers with the
+                range they are bound from, views and samplers of both
+                stages. A state call binding what is
+                already bound is dropped, and a call over a range of
+                slots is trimmed to the slots that change. Creation,
+                uploads, targets, clears and draws are forwarded as is.
+                The shadow keeps raw pointers: a bound object is
+                referenced by the context, so its address cannot be
+                reused while the shadow still holds it. Binding render
+                targets forgets the bound views, Direct3D unbinds those
+                of the targets
+
+      Methods:  GetRenderDevice
+                  Returns the render device the calls are forwarded to
+                GetStats
+                  Returns the issued and filtered state calls
+                ResetStats
+                  Resets the counters
+                StateFilterRenderDevice
+                  Constructor.
+                ~StateFilterRenderDevice
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class StateFilterRenderDevice final : public RenderDevice
+    {
+    public:
+        StateFilterRenderDevice() = delete;
+        StateFilterRenderDevice(_In_ const std::shared_ptr<RenderDevice>& renderDevice);
+        StateFilterRenderDevice(const StateFilterRenderDevice& other) = delete;
+        StateFilterRenderDevice(StateFilterRenderDevice&& other) = delete;
+        StateFilterRenderDevice& operator=(const StateFilterRenderDevice& other) = delete;
+        StateFilterRenderDevice& operator=(StateFilterRenderDevice&& other) = delete;
+        ~StateFilterRenderDevice() override = default;
+
+        const std::shared_ptr<RenderDevice>& GetRenderDevice() const;
+        const StateFilterStats& GetStats() const;
+        void ResetStats();
+
+        HRESULT CreateBuffer(_In_ const D3D11_BUFFER_DESC* pDesc, _In_opt_ const D3D11_SUBRESOURCE_DATA* pInitialData, _Out_ ID3D11Buffer** ppBuffer) override;
+        HRESULT CreateTexture2D(_In_ const D3D11_TEXTURE2D_DESC* pDesc, _In_opt_ const D3D11_SUBRESOURCE_DATA* pInitialData, _Out_ ID3D11Texture2D** ppTexture2D) override;
+        HRESULT CreateTextureFromFile(_In_ const std::filesystem::path& filePath, _Out_ ID3D11ShaderResourceView** ppTextureView) override;
+        HRESULT CreateShaderResourceView(_In_ ID3D11Resource* pResource, _In_opt_ const D3D11_SHADER_RESOURCE_VIEW_DESC* pDesc, _Out_ ID3D11ShaderResourceView** ppView) override;
+        HRESULT CreateRenderTargetView(_In_ ID3D11Resource* pResource, _In_opt_ const D3D11_RENDER_TARGET_VIEW_DESC* pDesc, _Out_ ID3D11RenderTargetView** ppView) override;
+        HRESULT CreateDepthStencilView(_In_ ID3D11Resource* pResource, _In_opt_ const D3D11_DEPTH_STENCIL_VIEW_DESC* pDesc, _Out_ ID3D11DepthStencilView** ppView) override;
+        HRESULT CreateSamplerState(_In_ const D3D11_SAMPLER_DESC* pDesc, _Out_ ID3D11SamplerState** ppSamplerState) override;
+        HRESULT CompileShader(_In_ PCWSTR pszFileName, _In_ PCSTR pszEntryPoint, _In_ PCSTR pszShaderModel, _In_ UINT uFlags, _Outptr_ ID3DBlob** ppCode, _Outptr_opt_result_maybenull_ ID3DBlob** ppErrorMessages) override;
+        HRESULT CreateInputLayout(_In_reads_(uNumElements) const D3D11_INPUT_ELEMENT_DESC* pInputElementDescs, _In_ UINT uNumElements, _In_ const void* pShaderBytecode, _In_ SIZE_T bytecodeLength, _Out_ ID3D11InputLayout** ppInputLayout) override;
+        HRESULT CreateVertexShader(_In_ const void* pShaderBytecode, _In_ SIZE_T bytecodeLength, _Out_ ID3D11VertexShader** ppVertexShader) override;
+        HRESULT CreatePixelShader(_In_ const void* pShaderBytecode, _In_ SIZE_T bytecodeLength, _Out_ ID3D11PixelShader** ppPixelShader) override;
+        HRESULT CreateQuery(_In_ const D3D11_QUERY_DESC* pQueryDesc, _Out_ ID3D11Query** ppQuery) override;
+        BOOL SupportsConstantBufferOffsets() const override;
+
+        void UpdateSubresource(_In_ ID3D11Resource* pDstResource, _In_ UINT uDstSubresource, _In_opt_ const D3D11_BOX* pDstBox, _In_ const void* pSrcData, _In_ UINT uSrcRowPitch, _In_ UINT uSrcDepthPitch) override;
+        HRESULT Map(_In_ ID3D11Resource* pResource, _In_ UINT uSubresource, _In_ D3D11_MAP mapType, _In_ UINT uMapFlags, _Out_ D3D11_MAPPED_SUBRESOURCE* pMappedResource) override;
+        void Unmap(_In_ ID3D11Resource* pResource, _In_ UINT uSubresource) override;
+        void End(_In_ ID3D11Asynchronous* pAsync) override;
+        HRESULT GetData(_In_ ID3D11Asynchronous* pAsync, _Out_writes_bytes_opt_(uDataSize) void* pData, _In_ UINT uDataSize, _In_ UINT uGetDataFlags) override;
+
+        void IASetVertexBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_(uNumBuffers) ID3D11Buffer* const* ppVertexBuffers, _In_reads_(uNumBuffers) const UINT* pStrides, _In_reads_(uNumBuffers) const UINT* pOffsets) override;
+        void IASetIndexBuffer(_In_opt_ ID3D11Buffer* pIndexBuffer, _In_ DXGI_FORMAT format, _In_ UINT uOffset) override;
+        void IASetInputLayout(_In_opt_ ID3D11InputLayout* pInputLayout) override;
+        void IASetPrimitiveTopology(_In_ D3D11_PRIMITIVE_TOPOLOGY topology) override;
+
+        void VSSetShader(_In_opt_ ID3D11VertexShader* pVertexShader) override;
+        void VSSetConstantBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers) override;
+        void VSSetConstantBuffers1(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers, _In_reads_(uNumBuffers) const UINT* pFirstConstant, _In_reads_(uNumBuffers) const UINT* pNumConstants) override;
+        void VSSetShaderResources(_In_ UINT uStartSlot, _In_ UINT uNumViews, _In_reads_(uNumViews) ID3D11ShaderResourceView* const* ppShaderResourceViews) override;
+
+        void PSSetShader(_In_opt_ ID3D11PixelShader* pPixelShader) override;
+        void PSSetConstantBuffers(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers) override;
+        void PSSetConstantBuffers1(_In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers, _In_reads_(uNumBuffers) const UINT* pFirstConstant, _In_reads_(uNumBuffers) const UINT* pNumConstants) override;
+        void PSSetShaderResources(_In_ UINT uStartSlot, _In_ UINT uNumViews, _In_reads_(uNumViews) ID3D11ShaderResourceView* const* ppShaderResourceViews) override;
+        void PSSetSamplers(_In_ UINT uStartSlot, _In_ UINT uNumSamplers, _In_reads_(uNumSamplers) ID3D11SamplerState* const* ppSamplers) override;
+
+        void OMSetRenderTargets(_In_ UINT uNumViews, _In_reads_opt_(uNumViews) ID3D11RenderTargetView* const* ppRenderTargetViews, _In_opt_ ID3D11DepthStencilView* pDepthStencilView) override;
+        void RSSetViewports(_In_ UINT uNumViewports, _In_reads_(uNumViewports) const D3D11_VIEWPORT* pViewports) override;
+
+        void ClearRenderTargetView(_In_ ID3D11RenderTargetView* pRenderTargetView, _In_ const FLOAT aColorRGBA[4]) override;
+        void ClearDepthStencilView(_In_ ID3D11DepthStencilView* pDepthStencilView, _In_ UINT uClearFlags, _In_ FLOAT depth, _In_ UINT8 stencil) override;
+        void DrawIndexed(_In_ UINT uIndexCount, _In_ UINT uStartIndexLocation, _In_ INT baseVertexLocation) override;
+        void DrawIndexedInstanced(_In_ UINT uIndexCountPerInstance, _In_ UINT uInstanceCount, _In_ UINT uStartIndexLocation, _In_ INT baseVertexLocation, _In_ UINT uStartInstanceLocation) override;
+
+    private:
+        // Bound value of every slot, a slot is unknown until the first call binding it
+        template <class T, UINT N>
+        struct SlotShadow
+        {
+            T aValues[N];
+            BOOL abKnown[N];
+        };
+
+        struct VertexBufferSlot
+        {
+            ID3D11Buffer* pBuffer;
+            UINT uStride;
+            UINT uOffset;
+
+            bool operator==(const VertexBufferSlot& other) const = default;
+        };
+
+        // A constant buffer bound without a range has zero constants, the whole buffer
+        struct ConstantBufferSlot
+        {
+            ID3D11Buffer* pBuffer;
+            UINT uFirstConstant;
+            UINT uNumConstants;
+
+            bool operator==(const ConstantBufferSlot& other) const = default;
+        };
+
+        struct IndexBufferSlot
+        {
+            ID3D11Buffer* pBuffer;
+            DXGI_FORMAT format;
+            UINT uOffset;
+
+            bool operator==(const IndexBufferSlot& other) const = default;
+        };
+
+        BOOL filterConstantBuffers(_Inout_ SlotShadow<ConstantBufferSlot, D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT>& shadow, _In_ UINT uStartSlot, _In_ UINT uNumBuffers, _In_reads_(uNumBuffers) ID3D11Buffer* const* ppConstantBuffers, _In_reads_opt_(uNumBuffers) const UINT* pFirstConstant, _In_reads_opt_(uNumBuffers) const UINT* pNumConstants, _Out_ UINT& uOutFirst, _Out_ UINT& uOutCount);
+
+        template <class T, UINT N>
+        BOOL filter(_Inout_ SlotShadow<T, N>& shadow, _In_ UINT uStartSlot, _In_ UINT uNumSlots, _In_reads_(uNumSlots) const T* pValues, _Out_ UINT& uOutFirst, _Out_ UINT& uOutCount);
+
+    private:
+        std::shared_ptr<RenderDevice> m_renderDevice;
+        SlotShadow<VertexBufferSlot, D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT> m_vertexBuffers;
+        SlotShadow<IndexBufferSlot, 1u> m_indexBuffer;
+        SlotShadow<ID3D11InputLayout*, 1u> m_inputLayout;
+        SlotShadow<D3D11_PRIMITIVE_TOPOLOGY, 1u> m_topology;
+        SlotShadow<ID3D11VertexShader*, 1u> m_vertexShader;
+        SlotShadow<ID3D11PixelShader*, 1u> m_pixelShader;
+        SlotShadow<ConstantBufferSlot, D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT> m_vsConstantBuffers;
+        SlotShadow<ConstantBufferSlot, D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT> m_psConstantBuffers;
+        SlotShadow<ID3D11ShaderResourceView*, D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT> m_vsViews;
+        SlotShadow<ID3D11ShaderResourceView*, D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT> m_psViews;
+        SlotShadow<ID3D11SamplerState*, D3D11_COMMONSHADER_SAMPLER_SLOT_COUNT> m_psSamplers;
+        StateFilterStats m_stats;
+    };
+}
\ No newline at end of file
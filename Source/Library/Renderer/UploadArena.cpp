@@ -0,0 +1,314 @@
+#include "Renderer/UploadArena.h"
+
+#include <algorithm>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   UploadArena::UploadArena
+      Summary:  Constructor, the pages are created by the first frames
+                that need them
+      Args:     UINT uBindFlags
+                  D3D11_BIND_VERTEX_BUFFER or D3D11_BIND_INDEX_BUFFER
+                UINT uPageSize
+                  Size of a page in bytes, larger allocations get a page
+                  of their own size
+      Modifies: [m_uBindFlags, m_uPageSize, m_aPages, m_uCurrentPage,
+                 m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UploadArena::UploadArena(_In_ UINT uBindFlags, _In_ UINT uPageSize)
+        : m_uBindFlags(uBindFlags)
+        , m_uPageSize(uPageSize)
+        , m_aPages()
+        , m_uCurrentPage(NO_PAGE)
+        , m_stats()
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   UploadArena::Begin
+      Summary:  Starts the allocations of a frame
+      Modifies: [m_uCurrentPage, m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void UploadArena::Begin()
+    {
+        m_uCurrentPage = NO_PAGE;
+        m_stats = UploadArenaStats();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   UploadArena::Allocate
+      Summary:  Hands out memory after the previous allocation of the
+                frame, taking a free page or creating one when it does
+                not fit in the current page
+      Args:     RenderDevice* pDevice
+                  The render device to map the pages with
+                UINT uSize
+                  Size of the allocation in bytes
+                UINT uAlignment
+                  Multiple of bytes the offset is rounded up to, the
+                  vertex stride or the index size
+                UploadAllocation& outAllocation
+                  Receives the buffer, the offset and the memory
+      Modifies: [m_aPages, m_uCurrentPage, m_stats].
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT UploadArena::Allocate(_In_ RenderDevice* pDevice, _In_ UINT uSize, _In_ UINT uAlignment, _Out_ UploadAllocation& outAllocation)
+    {
+        outAllocation = UploadAllocation();
+
+        if (uSize == 0u || uAlignment == 0u)
+        {
+            return E_INVALIDARG;
+        }
+
+        UINT uOffset = 0u;
+        if (m_uCurrentPage != NO_PAGE)
+        {
+            const Page& page = m_aPages[m_uCurrentPage];
+            uOffset = (page.uOffset + uAlignment - 1u) / uAlignment * uAlignment;
+            if (uOffset > page.uSize || uSize > page.uSize - uOffset)
+            {
+                m_uCurrentPage = NO_PAGE;
+            }
+        }
+
+        if (m_uCurrentPage == NO_PAGE)
+        {
+            for (UINT i = 0u; i < m_aPages.size(); ++i)
+            {
+                if (m_aPages[i].uSize >= uSize && isPageFree(pDevice, m_aPages[i]))
+                {
+                    m_uCurrentPage = i;
+                    break;
+                }
+            }
+
+            if (m_uCurrentPage == NO_PAGE)
+            {
+                HRESULT hr = createPage(pDevice, std::max(m_uPageSize, uSize));
+                if (FAILED(hr))
+                {
+                    return hr;
+                }
+                m_uCurrentPage = static_cast<UINT>(m_aPages.size() - 1u);
+            }
+
+            // The GPU is done with a page once its fence has passed, it is only discarded the first time
+            Page& page = m_aPages[m_uCurrentPage];
+            D3D11_MAPPED_SUBRESOURCE mappedResource;
+            HRESULT hr = pDevice->Map(page.buffer.Get(), 0u, page.bWritten ? D3D11_MAP_WRITE_NO_OVERWRITE : D3D11_MAP_WRITE_DISCARD, 0u, &mappedResource);
+            if (FAILED(hr))
+            {
+                m_uCurrentPage = NO_PAGE;
+                return hr;
+            }
+
+            page.pMappedData = static_cast<BYTE*>(mappedResource.pData);
+            page.uOffset = 0u;
+            page.bWritten = TRUE;
+            uOffset = 0u;
+            ++m_stats.uNumMaps;
+        }
+
+        Page& page = m_aPages[m_uCurrentPage];
+        outAllocation =
+        {
+            .pBuffer = page.buffer.Get(),
+            .uOffset = uOffset,
+            .pData = page.pMappedData + uOffset
+        };
+        page.uOffset = uOffset + uSize;
+
+        ++m_stats.uNumAllocations;
+        m_stats.uNumUploadedBytes += uSize;
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   UploadArena::Upload
+      Summary:  Allocates memory and copies the data to it
+      Args:     RenderDevice* pDevice
+                  The render device to map the pages with
+                const void* pData
+                  Data to copy
+                UINT uSize
+                  Size of the data in bytes
+                UINT uAlignment
+                  Multiple of bytes the offset is rounded up to
+                UploadAllocation& outAllocation
+                  Receives the buffer, the offset and the memory
+      Modifies: [m_aPages, m_uCurrentPage, m_stats].
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT UploadArena::Upload(_In_ RenderDevice* pDevice, _In_reads_bytes_(uSize) const void* pData, _In_ UINT uSize, _In_ UINT uAlignment, _Out_ UploadAllocation& outAllocation)
+    {
+        HRESULT hr = Allocate(pDevice, uSize, uAlignment, outAllocation);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        memcpy(outAllocation.pData, pData, uSize);
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   UploadArena::End
+      Summary:  Unmaps the pages written this frame, the allocations
+                can be drawn afterwards. The pages stay taken until
+                Fence is called behind their draws
+      Args:     RenderDevice* pDevice
+                  The render device the pages were mapped with
+      Modifies: [m_aPages, m_uCurrentPage].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void UploadArena::End(_In_ RenderDevice* pDevice)
+    {
+        for (Page& page : m_aPages)
+        {
+            if (page.pMappedData)
+            {
+                pDevice->Unmap(page.buffer.Get(), 0u);
+                page.pMappedData = nullptr;
+                page.bFencePending = TRUE;
+            }
+        }
+
+        m_uCurrentPage = NO_PAGE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   UploadArena::Fence
+      Summary:  Issues the fences of the pages written this frame. It
+                is called once their draws are submitted, so the fences
+                pass only after the GPU has drawn them
+      Args:     RenderDevice* pDevice
+                  The render device the draws were submitted to
+      Modifies: [m_aPages].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void UploadArena::Fence(_In_ RenderDevice* pDevice)
+    {
+        for (Page& page : m_aPages)
+        {
+            if (page.bFencePending)
+            {
+                pDevice->End(page.fence.Get());
+                page.bFencePending = FALSE;
+                page.bInFlight = TRUE;
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   UploadArena::GetStats
+      Summary:  Returns the work of the arena since the last Begin
+      Returns:  const UploadArenaStats&
+                  Allocations, bytes, maps and created pages
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const UploadArenaStats& UploadArena::GetStats() const
+    {
+        return m_stats;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   UploadArena::GetNumPages
+      Summary:  Returns the number of pages, the most the frames in
+                flight have needed
+      Returns:  UINT
+                  Number of pages
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT UploadArena::GetNumPages() const
+    {
+        return static_cast<UINT>(m_aPages.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   UploadArena::isPageFree
+      Summary:  Tells whether a page can be written this frame: it is
+                not mapped already, its fence was issued and has
+                passed, checked without flushing the commands
+      Args:     RenderDevice* pDevice
+                  The render device the fence was issued on
+                Page& page
+                  The page, no longer in flight once its fence passed
+      Returns:  BOOL
+                  TRUE if the page can be mapped
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL UploadArena::isPageFree(_In_ RenderDevice* pDevice, _Inout_ Page& page)
+    {
+        if (page.pMappedData || page.bFencePending)
+        {
+            return FALSE;
+        }
+
+        if (page.bInFlight)
+        {
+            BOOL bDone = FALSE;
+            if (pDevice->GetData(page.fence.Get(), &bDone, sizeof(bDone), D3D11_ASYNC_GETDATA_DONOTFLUSH) == S_OK && bDone)
+            {
+                page.bInFlight = FALSE;
+            }
+        }
+
+        return !page.bInFlight;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   UploadArena::createPage
+      Summary:  Creates a page and its fence
+      Args:     RenderDevice* pDevice
+                  The render device to create the page with
+                UINT uSize
+                  Size of the page in bytes
+      Modifies: [m_aPages, m_stats].
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT UploadArena::createPage(_In_ RenderDevice* pDevice, _In_ UINT uSize)
+    {
+        D3D11_BUFFER_DESC bd =
+        {
+            .ByteWidth = uSize,
+            .Usage = D3D11_USAGE_DYNAMIC,
+            .BindFlags = m_uBindFlags,
+            .CPUAccessFlags = D3D11_CPU_ACCESS_WRITE
+        };
+
+        Page page =
+        {
+            .buffer = nullptr,
+            .fence = nullptr,
+            .uSize = uSize,
+            .uOffset = 0u,
+            .pMappedData = nullptr,
+            .bFencePending = FALSE,
+            .bInFlight = FALSE,
+            .bWritten = FALSE
+        };
+        HRESULT hr = pDevice->CreateBuffer(&bd, nullptr, page.buffer.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        D3D11_QUERY_DESC queryDesc =
+        {
+            .Query = D3D11_QUERY_EVENT,
+            .MiscFlags = 0u
+        };
+        hr = pDevice->CreateQuery(&queryDesc, page.fence.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        m_aPages.push_back(page);
+        ++m_stats.uNumCreatedPages;
+
+        return S_OK;
+    }
+}
\ No newline at end of file
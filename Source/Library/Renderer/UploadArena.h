@@ -0,0 +1,131 @@
+/*+===================================================================
+  File:      UPLOADARENA.H
+
+  Summary:   UploadArena header file contains declarations of
+             UploadArena class, the dynamic vertex or index buffers the
+             transient geometry of a frame is written to.
+
+  Classes: UploadArena
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include <climits>
+
+#include "Renderer/RenderDevice.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   UploadAllocation
+
+        Summary:  Memory handed out by the arena: the buffer, the byte
+                  offset to bind it from and the mapped memory, writable
+                  until the arena ends the frame
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct UploadAllocation
+    {
+        ID3D11Buffer* pBuffer;
+        UINT uOffset;
+        BYTE* pData;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   UploadArenaStats
+
+        Summary:  Work of the arena in the last frame: the allocations
+                  and their bytes, the maps and the pages created because
+                  every other page was still read by the GPU
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct UploadArenaStats
+    {
+        UINT64 uNumAllocations;
+        UINT64 uNumUploadedBytes;
+        UINT64 uNumMaps;
+        UINT64 uNumCreatedPages;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    UploadArena
+
+      Summary:  Large dynamic vertex or index buffers, the pages, that
+                the data drawn only this frame is suballocated from.
+                Allocations are handed out linearly from the page mapped
+                for the frame, the next one is taken when it is full.
+                End unmaps the pages written this frame before their
+                draws are submitted, Fence issues an event query behind
+                the draws, the fence of the page. A page is written again, from its start with
+                NO_OVERWRITE, once its fence has passed, so the GPU is
+                done with what it held, and a new page is created only
+                when every page is still in flight
+
+      Methods:  Begin
+                  Starts the allocations of a frame
+                Allocate
+                  Hands out mapped memory of a buffer
+                Upload
+                  Copies data to mapped memory of a buffer
+                End
+                  Unmaps the pages of the frame
+                Fence
+                  Fences the pages of the frame behind their draws
+                GetStats
+                  Returns the work of the last frame
+                GetNumPages
+                  Returns the number of pages
+                UploadArena
+                  Constructor.
+                ~UploadArena
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class UploadArena
+    {
+    public:
+        static constexpr const UINT DEFAULT_PAGE_SIZE = 4u * 1024u * 1024u;
+
+        UploadArena() = delete;
+        UploadArena(_In_ UINT uBindFlags, _In_ UINT uPageSize);
+        UploadArena(const UploadArena& other) = delete;
+        UploadArena(UploadArena&& other) = delete;
+        UploadArena& operator=(const UploadArena& other) = delete;
+        UploadArena& operator=(UploadArena&& other) = delete;
+        ~UploadArena() = default;
+
+        void Begin();
+        HRESULT Allocate(_In_ RenderDevice* pDevice, _In_ UINT uSize, _In_ UINT uAlignment, _Out_ UploadAllocation& outAllocation);
+        HRESULT Upload(_In_ RenderDevice* pDevice, _In_reads_bytes_(uSize) const void* pData, _In_ UINT uSize, _In_ UINT uAlignment, _Out_ UploadAllocation& outAllocation);
+        void End(_In_ RenderDevice* pDevice);
+        void Fence(_In_ RenderDevice* pDevice);
+
+        const UploadArenaStats& GetStats() const;
+        UINT GetNumPages() const;
+
+    private:
+        struct Page
+        {
+            ComPtr<ID3D11Buffer> buffer;
+            ComPtr<ID3D11Query> fence;
+            UINT uSize;
+            UINT uOffset;
+            BYTE* pMappedData;
+            BOOL bFencePending;
+            BOOL bInFlight;
+            BOOL bWritten;
+        };
+
+        BOOL isPageFree(_In_ RenderDevice* pDevice, _Inout_ Page& page);
+        HRESULT createPage(_In_ RenderDevice* pDevice, _In_ UINT uSize);
+
+    private:
+        static constexpr const UINT NO_PAGE = UINT_MAX;
+
+        UINT m_uBindFlags;
+        UINT m_uPageSize;
+        std::vector<Page> m_aPages;
+        UINT m_uCurrentPage;
+        UploadArenaStats m_stats;
+    };
+}
\ No newline at end of file
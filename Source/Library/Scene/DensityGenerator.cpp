@@ -0,0 +1,399 @@
+#include "Scene/DensityGenerator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <execution>
+#include <numeric>
+#include <random>
+
+#include "Scene/TerrainGenerator.h"
+
+namespace library
+{
+    namespace
+    {
+        // Surface height, as a fraction of the grid height, and its variation around it
+        constexpr const FLOAT SURFACE_BASE = 0.45f;
+        constexpr const FLOAT SURFACE_AMPLITUDE = 1.2f;
+        constexpr const FLOAT SURFACE_FREQUENCY = 1.0f / 128.0f;
+        constexpr const UINT SURFACE_OCTAVES = 5u;
+
+        constexpr const FLOAT MOISTURE_FREQUENCY = 1.0f / 96.0f;
+        constexpr const UINT MOISTURE_OCTAVES = 3u;
+
+        // Density lost per grid height above the surface, the lower it is the farther from the surface the 3D noise reaches
+        constexpr const FLOAT DENSITY_GRADIENT = 3.0f;
+        constexpr const FLOAT DENSITY_FREQUENCY = 1.0f / 24.0f;
+        constexpr const UINT DENSITY_OCTAVES = 3u;
+
+        // Number of blocks under the air that keep the block type of the surface
+        constexpr const UINT SURFACE_DEPTH = 3u;
+
+        // Cave worms: one per chunk, starting between 15% and 55% of the grid height
+        constexpr const UINT CAVE_WORMS_PER_CHUNK = 1u;
+        constexpr const UINT CAVE_WORM_STEPS = 96u;
+        constexpr const FLOAT CAVE_MIN_START = 0.15f;
+        constexpr const FLOAT CAVE_MAX_START = 0.55f;
+        constexpr const FLOAT CAVE_MIN_RADIUS = 1.5f;
+        constexpr const FLOAT CAVE_MAX_RADIUS = 3.5f;
+        constexpr const FLOAT CAVE_MAX_TURN = 0.6f;
+        constexpr const FLOAT CAVE_MAX_PITCH = 0.6f;
+
+        constexpr const FLOAT PI = 3.14159265f;
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: nextUnit
+
+          Summary:  Draws a number in [0, 1) from the 24 high bits of the
+                    generator, which the standard fixes for a seed,
+                    unlike the distributions
+
+          Args:     std::mt19937& rng
+                      Random number generator
+
+          Returns:  FLOAT
+                      Random number in [0, 1)
+        F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+        FLOAT nextUnit(std::mt19937& rng)
+        {
+            return static_cast<FLOAT>(rng() >> 8u) * (1.0f / 16777216.0f);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DensityGenerator::DensityGenerator
+      Summary:  Constructor. Traces the cave worms of the grid
+      Args:     const DensityDesc& desc
+                  Dimensions and seed of the grid
+      Modifies: [m_desc, m_uNumChunksX, m_uNumChunksZ, m_uNumLatticeY,
+                 m_surfaceNoise, m_moistureNoise, m_densityNoise,
+                 m_uNumCaveWorms, m_uNumCaveSpheres,
+                 m_aaChunkSpheres].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    DensityGenerator::DensityGenerator(_In_ const DensityDesc& desc)
+        : m_desc(desc)
+        , m_uNumChunksX((desc.uWidth + CHUNK_SIZE - 1u) / CHUNK_SIZE)
+        , m_uNumChunksZ((desc.uDepth + CHUNK_SIZE - 1u) / CHUNK_SIZE)
+        , m_uNumLatticeY((desc.uHeight + LATTICE_STEP - 1u) / LATTICE_STEP + 1u)
+        , m_surfaceNoise(desc.uSeed)
+        , m_moistureNoise(desc.uSeed + 1u)
+        , m_densityNoise(desc.uSeed + 2u)
+        , m_uNumCaveWorms(0u)
+        , m_uNumCaveSpheres(0u)
+        , m_aaChunkSpheres()
+    {
+        traceCaveWorms();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DensityGenerator::Generate
+      Summary:  Generates every chunk of the grid
+      Args:     std::unique_ptr<VoxelGrid>& outGrid
+                  Generated grid
+                BOOL bParallel
+                  Whether the chunks are generated on all cores
+      Modifies: [outGrid].
+      Returns:  HRESULT
+                  Status code, E_INVALIDARG for an empty grid or a grid
+                  higher than the runs of a chunk can store
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT DensityGenerator::Generate(_Out_ std::unique_ptr<VoxelGrid>& outGrid, _In_ BOOL bParallel) const
+    {
+        if (m_desc.uWidth == 0u || m_desc.uHeight == 0u || m_desc.uDepth == 0u || m_desc.uHeight > USHRT_MAX)
+        {
+            return E_INVALIDARG;
+        }
+
+        std::unique_ptr<VoxelGrid> grid = std::make_unique<VoxelGrid>(m_desc.uWidth, m_desc.uHeight, m_desc.uDepth, TerrainGenerator::GetPalette());
+
+        std::vector<UINT> aChunkIndices(static_cast<size_t>(m_uNumChunksX) * m_uNumChunksZ);
+        std::iota(aChunkIndices.begin(), aChunkIndices.end(), 0u);
+
+        // Chunks replace disjoint storages, so they need no synchronization
+        auto generateChunk = [&](UINT uChunkIndex)
+        {
+            VoxelChunkStorage chunk(m_desc.uHeight);
+            GenerateChunk(uChunkIndex % m_uNumChunksX, uChunkIndex / m_uNumChunksX, chunk);
+            grid->SetChunk(uChunkIndex % m_uNumChunksX, uChunkIndex / m_uNumChunksX, std::move(chunk));
+        };
+
+        if (bParallel)
+        {
+            std::for_each(std::execution::par, aChunkIndices.begin(), aChunkIndices.end(), generateChunk);
+        }
+        else
+        {
+            std::for_each(aChunkIndices.begin(), aChunkIndices.end(), generateChunk);
+        }
+
+        outGrid = std::move(grid);
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DensityGenerator::GenerateChunk
+      Summary:  Samples the density lattice of a chunk, then fills,
+                carves and encodes its columns
+      Args:     UINT uChunkX
+                UINT uChunkZ
+                  Coordinates of the chunk
+                VoxelChunkStorage& outChunk
+                  Blocks of the chunk, the columns outside of the grid
+                  are empty
+      Modifies: [outChunk].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void DensityGenerator::GenerateChunk(_In_ UINT uChunkX, _In_ UINT uChunkZ, _Out_ VoxelChunkStorage& outChunk) const
+    {
+        const UINT uFirstX = uChunkX * CHUNK_SIZE;
+        const UINT uFirstZ = uChunkZ * CHUNK_SIZE;
+        const UINT uNumX = std::min(CHUNK_SIZE, m_desc.uWidth - uFirstX);
+        const UINT uNumZ = std::min(CHUNK_SIZE, m_desc.uDepth - uFirstZ);
+        const std::vector<CaveSphere>& aSpheres = m_aaChunkSpheres[static_cast<size_t>(uChunkZ) * m_uNumChunksX + uChunkX];
+
+        std::vector<FLOAT> aLattice;
+        sampleLattice(uFirstX, uFirstZ, aLattice);
+
+        // Encoding the whole chunk at once never moves the runs, unlike setting its blocks one by one
+        std::vector<CHAR> aBlocks(static_cast<size_t>(CHUNK_SIZE) * CHUNK_SIZE * m_desc.uHeight, HeightMap::EMPTY_BLOCK);
+        for (UINT z = 0u; z < uNumZ; ++z)
+        {
+            for (UINT x = 0u; x < uNumX; ++x)
+            {
+                CHAR* pColumn = aBlocks.data() + (static_cast<size_t>(z) * CHUNK_SIZE + x) * m_desc.uHeight;
+                fillColumn(uFirstX + x, uFirstZ + z, uFirstX, uFirstZ, aLattice, pColumn);
+                carveColumn(uFirstX + x, uFirstZ + z, aSpheres, pColumn);
+            }
+        }
+
+        outChunk = VoxelChunkStorage(m_desc.uHeight, aBlocks.data());
+    }
+
+    UINT DensityGenerator::GetNumCaveWorms() const
+    {
+        return m_uNumCaveWorms;
+    }
+
+    size_t DensityGenerator::GetNumCaveSpheres() const
+    {
+        return m_uNumCaveSpheres;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DensityGenerator::traceCaveWorms
+      Summary:  Walks every cave worm from its random start, turning
+                a little at each step, and adds each of its spheres to
+                the chunks it touches. The worms are drawn in one
+                sequence from the seed, so the caves do not depend on
+                the order the chunks are generated in
+      Modifies: [m_uNumCaveWorms, m_uNumCaveSpheres,
+                 m_aaChunkSpheres].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void DensityGenerator::traceCaveWorms()
+    {
+        m_aaChunkSpheres.assign(static_cast<size_t>(m_uNumChunksX) * m_uNumChunksZ, std::vector<CaveSphere>());
+        m_uNumCaveWorms = static_cast<UINT>(m_aaChunkSpheres.size()) * CAVE_WORMS_PER_CHUNK;
+        m_uNumCaveSpheres = 0u;
+
+        const FLOAT width = static_cast<FLOAT>(m_desc.uWidth);
+        const FLOAT height = static_cast<FLOAT>(m_desc.uHeight);
+        const FLOAT depth = static_cast<FLOAT>(m_desc.uDepth);
+
+        std::mt19937 rng(m_desc.uSeed);
+        for (UINT uWorm = 0u; uWorm < m_uNumCaveWorms; ++uWorm)
+        {
+            FLOAT x = nextUnit(rng) * width;
+            FLOAT y = (CAVE_MIN_START + nextUnit(rng) * (CAVE_MAX_START - CAVE_MIN_START)) * height;
+            FLOAT z = nextUnit(rng) * depth;
+            FLOAT yaw = nextUnit(rng) * 2.0f * PI;
+            FLOAT pitch = (nextUnit(rng) - 0.5f) * CAVE_MAX_PITCH;
+            FLOAT radius = CAVE_MIN_RADIUS + nextUnit(rng) * (CAVE_MAX_RADIUS - CAVE_MIN_RADIUS);
+
+            for (UINT uStep = 0u; uStep < CAVE_WORM_STEPS; ++uStep)
+            {
+                FLOAT stepRadius = radius * (0.75f + 0.5f * nextUnit(rng));
+
+                // Spheres entirely below the floor or above the grid carve nothing
+                INT iFirstChunkX = static_cast<INT>(std::floor((x - stepRadius) / static_cast<FLOAT>(CHUNK_SIZE)));
+                INT iLastChunkX = static_cast<INT>(std::floor((x + stepRadius) / static_cast<FLOAT>(CHUNK_SIZE)));
+                INT iFirstChunkZ = static_cast<INT>(std::floor((z - stepRadius) / static_cast<FLOAT>(CHUNK_SIZE)));
+                INT iLastChunkZ = static_cast<INT>(std::floor((z + stepRadius) / static_cast<FLOAT>(CHUNK_SIZE)));
+                iFirstChunkX = std::max(iFirstChunkX, 0);
+                iFirstChunkZ = std::max(iFirstChunkZ, 0);
+                iLastChunkX = std::min(iLastChunkX, static_cast<INT>(m_uNumChunksX) - 1);
+                iLastChunkZ = std::min(iLastChunkZ, static_cast<INT>(m_uNumChunksZ) - 1);
+                if (y + stepRadius >= 1.0f && y - stepRadius < height && iFirstChunkX <= iLastChunkX && iFirstChunkZ <= iLastChunkZ)
+                {
+                    const CaveSphere sphere = { .x = x, .y = y, .z = z, .fRadius = stepRadius };
+                    for (INT iChunkZ = iFirstChunkZ; iChunkZ <= iLastChunkZ; ++iChunkZ)
+                    {
+                        for (INT iChunkX = iFirstChunkX; iChunkX <= iLastChunkX; ++iChunkX)
+                        {
+                            m_aaChunkSpheres[static_cast<size_t>(iChunkZ) * m_uNumChunksX + static_cast<size_t>(iChunkX)].push_back(sphere);
+                        }
+                    }
+                    ++m_uNumCaveSpheres;
+                }
+
+                FLOAT step = stepRadius * 0.5f;
+                x += std::cos(yaw) * std::cos(pitch) * step;
+                y += std::sin(pitch) * step;
+                z += std::sin(yaw) * std::cos(pitch) * step;
+                yaw += (nextUnit(rng) - 0.5f) * CAVE_MAX_TURN;
+                pitch = std::clamp(pitch * 0.9f + (nextUnit(rng) - 0.5f) * CAVE_MAX_TURN * 0.5f, -CAVE_MAX_PITCH, CAVE_MAX_PITCH);
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DensityGenerator::sampleLattice
+      Summary:  Samples the 3D noise of a chunk every LATTICE_STEP
+                blocks, including the points on the far faces of the
+                chunk so the columns interpolate across the chunk
+                borders. This costs about 1 / LATTICE_STEP^3 of a
+                sample per block
+      Args:     UINT uFirstX
+                UINT uFirstZ
+                  First column of the chunk
+                std::vector<FLOAT>& aOutLattice
+                  Noise minus one half, indexed by
+                  (z * (CHUNK_SIZE / LATTICE_STEP + 1) + x) *
+                  m_uNumLatticeY + y
+      Modifies: [aOutLattice].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void DensityGenerator::sampleLattice(_In_ UINT uFirstX, _In_ UINT uFirstZ, _Out_ std::vector<FLOAT>& aOutLattice) const
+    {
+        const UINT uNumLatticeXZ = CHUNK_SIZE / LATTICE_STEP + 1u;
+
+        aOutLattice.resize(static_cast<size_t>(uNumLatticeXZ) * uNumLatticeXZ * m_uNumLatticeY);
+        size_t uIndex = 0u;
+        for (UINT z = 0u; z < uNumLatticeXZ; ++z)
+        {
+            for (UINT x = 0u; x < uNumLatticeXZ; ++x)
+            {
+                for (UINT y = 0u; y < m_uNumLatticeY; ++y)
+                {
+                    aOutLattice[uIndex++] = m_densityNoise.Sample3d(
+                        static_cast<FLOAT>(uFirstX + x * LATTICE_STEP),
+                        static_cast<FLOAT>(y * LATTICE_STEP),
+                        static_cast<FLOAT>(uFirstZ + z * LATTICE_STEP),
+                        DENSITY_FREQUENCY,
+                        DENSITY_OCTAVES
+                    ) - 0.5f;
+                }
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DensityGenerator::fillColumn
+      Summary:  Evaluates the density of every block of a column, from
+                the top down. The solid blocks right under the air take
+                the biome of the height of the first of them, the
+                deeper ones DEEP_BLOCK_TYPE. The bottom block is always
+                solid
+      Args:     UINT x
+                UINT z
+                  Column in the grid
+                UINT uFirstX
+                UINT uFirstZ
+                  First column of the chunk of the lattice
+                const std::vector<FLOAT>& aLattice
+                  Noise lattice of the chunk
+                CHAR* aOutBlocks
+                  Block types of the column, from the bottom up
+      Modifies: [aOutBlocks].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void DensityGenerator::fillColumn(_In_ UINT x, _In_ UINT z, _In_ UINT uFirstX, _In_ UINT uFirstZ, _In_ const std::vector<FLOAT>& aLattice, _Out_writes_(m_desc.uHeight) CHAR* aOutBlocks) const
+    {
+        const UINT uNumLatticeXZ = CHUNK_SIZE / LATTICE_STEP + 1u;
+        const FLOAT height = static_cast<FLOAT>(m_desc.uHeight);
+
+        FLOAT surface = SURFACE_BASE + (m_surfaceNoise.Sample(static_cast<FLOAT>(x), static_cast<FLOAT>(z), SURFACE_FREQUENCY, SURFACE_OCTAVES) - 0.5f) * SURFACE_AMPLITUDE;
+        FLOAT moisture = m_moistureNoise.Sample(static_cast<FLOAT>(x), static_cast<FLOAT>(z), MOISTURE_FREQUENCY, MOISTURE_OCTAVES);
+
+        const UINT uLatticeX = (x - uFirstX) / LATTICE_STEP;
+        const UINT uLatticeZ = (z - uFirstZ) / LATTICE_STEP;
+        const FLOAT xFrac = static_cast<FLOAT>((x - uFirstX) % LATTICE_STEP) / static_cast<FLOAT>(LATTICE_STEP);
+        const FLOAT zFrac = static_cast<FLOAT>((z - uFirstZ) % LATTICE_STEP) / static_cast<FLOAT>(LATTICE_STEP);
+
+        const FLOAT* pLow0 = aLattice.data() + (static_cast<size_t>(uLatticeZ) * uNumLatticeXZ + uLatticeX) * m_uNumLatticeY;
+        const FLOAT* pLow1 = pLow0 + m_uNumLatticeY;
+        const FLOAT* pHigh0 = pLow0 + static_cast<size_t>(uNumLatticeXZ) * m_uNumLatticeY;
+        const FLOAT* pHigh1 = pHigh0 + m_uNumLatticeY;
+        auto sampleColumn = [&](UINT uLatticeY)
+        {
+            FLOAT low = pLow0[uLatticeY] + xFrac * (pLow1[uLatticeY] - pLow0[uLatticeY]);
+            FLOAT high = pHigh0[uLatticeY] + xFrac * (pHigh1[uLatticeY] - pHigh0[uLatticeY]);
+
+            return low + zFrac * (high - low);
+        };
+
+        UINT uCachedLatticeY = UINT_MAX;
+        FLOAT noiseBelow = 0.0f;
+        FLOAT noiseAbove = 0.0f;
+        UINT uDepthBelowAir = 0u;
+        CHAR surfaceType = DEEP_BLOCK_TYPE;
+        for (UINT y = m_desc.uHeight; y-- > 0u; )
+        {
+            UINT uLatticeY = y / LATTICE_STEP;
+            if (uLatticeY != uCachedLatticeY)
+            {
+                noiseBelow = sampleColumn(uLatticeY);
+                noiseAbove = sampleColumn(uLatticeY + 1u);
+                uCachedLatticeY = uLatticeY;
+            }
+            FLOAT yFrac = static_cast<FLOAT>(y % LATTICE_STEP) / static_cast<FLOAT>(LATTICE_STEP);
+            FLOAT density = (surface - static_cast<FLOAT>(y) / height) * DENSITY_GRADIENT + noiseBelow + yFrac * (noiseAbove - noiseBelow);
+
+            if (density <= 0.0f && y > 0u)
+            {
+                aOutBlocks[y] = HeightMap::EMPTY_BLOCK;
+                uDepthBelowAir = 0u;
+                continue;
+            }
+
+            if (uDepthBelowAir == 0u)
+            {
+                surfaceType = static_cast<CHAR>(TerrainGenerator::ClassifyBiome(std::max(static_cast<FLOAT>(y) / height, 0.0f), moisture));
+            }
+            aOutBlocks[y] = uDepthBelowAir < SURFACE_DEPTH ? surfaceType : DEEP_BLOCK_TYPE;
+            uDepthBelowAir = std::min(uDepthBelowAir + 1u, SURFACE_DEPTH);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   DensityGenerator::carveColumn
+      Summary:  Removes the blocks of a column inside the cave spheres,
+                the bottom block is kept so the caves have a floor
+      Args:     UINT x
+                UINT z
+                  Column in the grid
+                const std::vector<CaveSphere>& aSpheres
+                  Spheres touching the chunk of the column
+                CHAR* aBlocks
+                  Block types of the column, from the bottom up
+      Modifies: [aBlocks].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void DensityGenerator::carveColumn(_In_ UINT x, _In_ UINT z, _In_ const std::vector<CaveSphere>& aSpheres, _Inout_updates_(m_desc.uHeight) CHAR* aBlocks) const
+    {
+        for (const CaveSphere& sphere : aSpheres)
+        {
+            FLOAT dx = static_cast<FLOAT>(x) - sphere.x;
+            FLOAT dz = static_cast<FLOAT>(z) - sphere.z;
+            FLOAT halfHeightSquared = sphere.fRadius * sphere.fRadius - dx * dx - dz * dz;
+            if (halfHeightSquared <= 0.0f)
+            {
+                continue;
+            }
+
+            FLOAT halfHeight = std::sqrt(halfHeightSquared);
+            INT iFirstY = std::max(static_cast<INT>(std::ceil(sphere.y - halfHeight)), 1);
+            INT iLastY = std::min(static_cast<INT>(std::floor(sphere.y + halfHeight)), static_cast<INT>(m_desc.uHeight) - 1);
+            for (INT y = iFirstY; y <= iLastY; ++y)
+            {
+                aBlocks[y] = HeightMap::EMPTY_BLOCK;
+            }
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,117 @@
+/*+===================================================================
+  File:      DENSITYGENERATOR.H
+
+  Summary:   DensityGenerator header file contains declarations of
+             DensityGenerator class used to generate a voxel grid with
+             caves and overhangs from a 3D density field, chunk by
+             chunk on all cores.
+
+  Classes: DensityGenerator
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Scene/PerlinNoise.h"
+#include "Scene/VoxelGrid.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   DensityDesc
+
+        Summary:  Dimensions of the generated grid and the seed of its
+                  noise channels and caves
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct DensityDesc
+    {
+        UINT uWidth;
+        UINT uHeight;
+        UINT uDepth;
+        UINT uSeed;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   CaveSphere
+
+        Summary:  One step of a cave worm, the blocks whose center is
+                  within fRadius of the center are carved
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct CaveSphere
+    {
+        FLOAT x;
+        FLOAT y;
+        FLOAT z;
+        FLOAT fRadius;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    DensityGenerator
+
+      Summary:  Generates the blocks of a grid from a density field: a
+                block is solid when the 2D surface height above it,
+                minus its own height, plus fractal 3D noise is
+                positive, so the noise carves overhangs and arches
+                near the surface. The 3D noise is sampled every
+                LATTICE_STEP blocks and interpolated. Cave worms walk
+                from seeded starting points and carve spheres. The
+                worms are traced once by the constructor and every
+                chunk keeps the spheres that touch it, so the chunks
+                are generated in parallel and the result depends on
+                the seed only
+
+      Methods:  Generate
+                  Generates the whole grid
+                GenerateChunk
+                  Generates the blocks of one chunk
+                GetNumCaveWorms
+                  Returns the number of cave worms of the grid
+                GetNumCaveSpheres
+                  Returns the number of spheres of the cave worms
+                DensityGenerator
+                  Constructor.
+                ~DensityGenerator
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class DensityGenerator
+    {
+    public:
+        static constexpr const UINT CHUNK_SIZE = VoxelGrid::CHUNK_SIZE;
+        static constexpr const UINT LATTICE_STEP = 4u;
+        static constexpr const CHAR DEEP_BLOCK_TYPE = static_cast<CHAR>(eBlockType::BARE);
+
+        DensityGenerator() = delete;
+        explicit DensityGenerator(_In_ const DensityDesc& desc);
+        DensityGenerator(const DensityGenerator& other) = delete;
+        DensityGenerator(DensityGenerator&& other) = delete;
+        DensityGenerator& operator=(const DensityGenerator& other) = delete;
+        DensityGenerator& operator=(DensityGenerator&& other) = delete;
+        ~DensityGenerator() = default;
+
+        HRESULT Generate(_Out_ std::unique_ptr<VoxelGrid>& outGrid, _In_ BOOL bParallel = TRUE) const;
+        void GenerateChunk(_In_ UINT uChunkX, _In_ UINT uChunkZ, _Out_ VoxelChunkStorage& outChunk) const;
+
+        UINT GetNumCaveWorms() const;
+        size_t GetNumCaveSpheres() const;
+
+    private:
+        void traceCaveWorms();
+        void sampleLattice(_In_ UINT uFirstX, _In_ UINT uFirstZ, _Out_ std::vector<FLOAT>& aOutLattice) const;
+        void fillColumn(_In_ UINT x, _In_ UINT z, _In_ UINT uFirstX, _In_ UINT uFirstZ, _In_ const std::vector<FLOAT>& aLattice, _Out_writes_(m_desc.uHeight) CHAR* aOutBlocks) const;
+        void carveColumn(_In_ UINT x, _In_ UINT z, _In_ const std::vector<CaveSphere>& aSpheres, _Inout_updates_(m_desc.uHeight) CHAR* aBlocks) const;
+
+    private:
+        DensityDesc m_desc;
+        UINT m_uNumChunksX;
+        UINT m_uNumChunksZ;
+        UINT m_uNumLatticeY;
+        PerlinNoise m_surfaceNoise;
+        PerlinNoise m_moistureNoise;
+        PerlinNoise m_densityNoise;
+        UINT m_uNumCaveWorms;
+        size_t m_uNumCaveSpheres;
+        std::vector<std::vector<CaveSphere>> m_aaChunkSpheres;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,878 @@
+#include "Scene/HeightMap.h"
+
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+
+namespace library
+{
+    namespace
+    {
+        /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+          Class:    MappedFile
+
+          Summary:  Read-only memory mapping of a whole file
+        C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+        class MappedFile
+        {
+        public:
+            MappedFile()
+                : m_hFile(INVALID_HANDLE_VALUE)
+                , m_hMapping(nullptr)
+                , m_pData(nullptr)
+                , m_uSize(0u)
+            {
+            }
+            MappedFile(const MappedFile& other) = delete;
+            MappedFile& operator=(const MappedFile& other) = delete;
+
+            ~MappedFile()
+            {
+                if (m_pData)
+                {
+                    UnmapViewOfFile(m_pData);
+                }
+                if (m_hMapping)
+                {
+                    CloseHandle(m_hMapping);
+                }
+                if (m_hFile != INVALID_HANDLE_VALUE)
+                {
+                    CloseHandle(m_hFile);
+                }
+            }
+
+            HRESULT Open(_In_ const std::filesystem::path& filePath)
+            {
+                m_hFile = CreateFile(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+                if (m_hFile == INVALID_HANDLE_VALUE)
+                {
+                    return HRESULT_FROM_WIN32(GetLastError());
+                }
+
+                LARGE_INTEGER fileSize;
+                if (!GetFileSizeEx(m_hFile, &fileSize))
+                {
+                    return HRESULT_FROM_WIN32(GetLastError());
+                }
+
+                m_uSize = static_cast<size_t>(fileSize.QuadPart);
+                if (m_uSize == 0u)
+                {
+                    // Empty files cannot be mapped
+                    return S_OK;
+                }
+
+                m_hMapping = CreateFileMapping(m_hFile, nullptr, PAGE_READONLY, 0u, 0u, nullptr);
+                if (!m_hMapping)
+                {
+                    return HRESULT_FROM_WIN32(GetLastError());
+                }
+
+                m_pData = static_cast<const BYTE*>(MapViewOfFile(m_hMapping, FILE_MAP_READ, 0u, 0u, 0u));
+                if (!m_pData)
+                {
+                    return HRESULT_FROM_WIN32(GetLastError());
+                }
+
+                return S_OK;
+            }
+
+            const BYTE* GetData() const
+            {
+                return m_pData;
+            }
+
+            size_t GetSize() const
+            {
+                return m_uSize;
+            }
+
+        private:
+            HANDLE m_hFile;
+            HANDLE m_hMapping;
+            const BYTE* m_pData;
+            size_t m_uSize;
+        };
+
+        /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+          Class:    TextCursor
+
+          Summary:  Tokenizer over the legacy text height map that
+                    follows the std::istream extraction rules used by
+                    the former parser, without per-token stream calls
+        C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+        class TextCursor
+        {
+        public:
+            TextCursor(_In_reads_(uSize) const CHAR* pData, _In_ size_t uSize)
+                : m_pCurrent(pData)
+                , m_pEnd(pData + uSize)
+            {
+            }
+
+            BOOL IsEnd()
+            {
+                skipWhitespace();
+                return m_pCurrent >= m_pEnd;
+            }
+
+            BOOL ReadUInt(_Out_ UINT& uValue)
+            {
+                skipWhitespace();
+                std::from_chars_result result = std::from_chars(m_pCurrent, m_pEnd, uValue);
+                if (result.ec != std::errc())
+                {
+                    return FALSE;
+                }
+                m_pCurrent = result.ptr;
+                return TRUE;
+            }
+
+            BOOL ReadFloat(_Out_ FLOAT& value)
+            {
+                skipWhitespace();
+                const CHAR* pBegin = m_pCurrent;
+                if (pBegin < m_pEnd && *pBegin == '+')
+                {
+                    ++pBegin;
+                }
+                std::from_chars_result result = std::from_chars(pBegin, m_pEnd, value);
+                if (result.ec != std::errc())
+                {
+                    return FALSE;
+                }
+                m_pCurrent = result.ptr;
+                return TRUE;
+            }
+
+            BOOL ReadChar(_Out_ CHAR& value)
+            {
+                skipWhitespace();
+                if (m_pCurrent >= m_pEnd)
+                {
+                    return FALSE;
+                }
+                value = *m_pCurrent++;
+                return TRUE;
+            }
+
+            void SkipToken()
+            {
+                skipWhitespace();
+                while (m_pCurrent < m_pEnd && !isWhitespace(*m_pCurrent))
+                {
+                    ++m_pCurrent;
+                }
+            }
+
+        private:
+            static BOOL isWhitespace(_In_ CHAR c)
+            {
+                return c == ' ' || (c >= '\t' && c <= '\r');
+            }
+
+            void skipWhitespace()
+            {
+                while (m_pCurrent < m_pEnd && isWhitespace(*m_pCurrent))
+                {
+                    ++m_pCurrent;
+                }
+            }
+
+        private:
+            const CHAR* m_pCurrent;
+            const CHAR* m_pEnd;
+        };
+
+        constexpr const UINT16 MAX_QUANTIZED_HEIGHT = 0xFFFFu;
+
+        // Largest side of a binary height map, so that no offset of its sections can overflow
+        constexpr const UINT MAX_BINARY_DIMENSION = 1u << 16u;
+
+        size_t alignTo4(_In_ size_t uOffset)
+        {
+            return (uOffset + 3u) & ~static_cast<size_t>(3u);
+        }
+
+        BOOL isBlockType(_In_ CHAR voxelType)
+        {
+            return static_cast<CHAR>(eBlockType::GRASSLAND) <= voxelType && voxelType < static_cast<CHAR>(eBlockType::COUNT);
+        }
+
+        UINT toColumnHeight(_In_ UINT uMapHeight, _In_ FLOAT height)
+        {
+            return static_cast<UINT>(static_cast<FLOAT>(uMapHeight) * height);
+        }
+
+        LONGLONG getPerformanceCounter()
+        {
+            LARGE_INTEGER counter;
+            QueryPerformanceCounter(&counter);
+            return counter.QuadPart;
+        }
+
+        DOUBLE getElapsedSeconds(_In_ LONGLONG startCounter)
+        {
+            LARGE_INTEGER frequency;
+            QueryPerformanceFrequency(&frequency);
+            return static_cast<DOUBLE>(getPerformanceCounter() - startCounter) / static_cast<DOUBLE>(frequency.QuadPart);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightMap::DetectFormat
+      Summary:  Returns the format of the given height map file by
+                looking for the binary magic number
+      Args:     const std::filesystem::path& filePath
+                  Path to the height map
+      Returns:  eHeightMapFormat
+                  BINARY if the file starts with the magic number,
+                  TEXT otherwise
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    eHeightMapFormat HeightMap::DetectFormat(_In_ const std::filesystem::path& filePath)
+    {
+        std::ifstream inputFile(filePath, std::ios::binary);
+
+        UINT32 uMagic = 0u;
+        inputFile.read(reinterpret_cast<CHAR*>(&uMagic), sizeof(uMagic));
+
+        if (inputFile.gcount() == sizeof(uMagic) && uMagic == BINARY_MAGIC)
+        {
+            return eHeightMapFormat::BINARY;
+        }
+
+        return eHeightMapFormat::TEXT;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightMap::Convert
+      Summary:  Loads a height map in any format and saves it in the
+                given format
+      Args:     const std::filesystem::path& srcFilePath
+                  Path to the height map to convert
+                const std::filesystem::path& dstFilePath
+                  Path to the converted height map
+                eHeightMapFormat dstFormat
+                  Format of the converted height map
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT HeightMap::Convert(_In_ const std::filesystem::path& srcFilePath, _In_ const std::filesystem::path& dstFilePath, _In_ eHeightMapFormat dstFormat)
+    {
+        HeightMap heightMap;
+        HRESULT hr = heightMap.LoadFromFile(srcFilePath);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        switch (dstFormat)
+        {
+        case eHeightMapFormat::TEXT:
+            return heightMap.SaveToText(dstFilePath);
+        case eHeightMapFormat::BINARY:
+            return heightMap.SaveToBinary(dstFilePath);
+        default:
+            return E_INVALIDARG;
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightMap::HeightMap
+      Summary:  Constructor of an empty height map
+      Modifies: [m_uWidth, m_uHeight, m_uDepth, m_aPalette,
+                 m_aBlockTypes, m_aHeights, m_loadTime].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HeightMap::HeightMap()
+        : m_uWidth(0u)
+        , m_uHeight(0u)
+        , m_uDepth(0u)
+        , m_aPalette()
+        , m_aBlockTypes()
+        , m_aHeights()
+        , m_loadTime(0.0)
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightMap::HeightMap
+      Summary:  Constructor of a height map whose cells are filled
+                with SetCell
+      Args:     UINT uWidth
+                  Number of cells along the x axis
+                UINT uHeight
+                  Maximum number of blocks in a column
+                UINT uDepth
+                  Number of cells along the z axis
+                std::vector<XMFLOAT4>&& aPalette
+                  Colors of the block types
+      Modifies: [m_uWidth, m_uHeight, m_uDepth, m_aPalette,
+                 m_aBlockTypes, m_aHeights, m_loadTime].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HeightMap::HeightMap(_In_ UINT uWidth, _In_ UINT uHeight, _In_ UINT uDepth, _In_ std::vector<XMFLOAT4>&& aPalette)
+        : m_uWidth(0u)
+        , m_uHeight(0u)
+        , m_uDepth(0u)
+        , m_aPalette(std::move(aPalette))
+        , m_aBlockTypes()
+        , m_aHeights()
+        , m_loadTime(0.0)
+    {
+        resize(uWidth, uHeight, uDepth);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightMap::LoadFromFile
+      Summary:  Loads the height map in the format found in the file
+      Args:     const std::filesystem::path& filePath
+                  Path to the height map
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT HeightMap::LoadFromFile(_In_ const std::filesystem::path& filePath)
+    {
+        if (DetectFormat(filePath) == eHeightMapFormat::BINARY)
+        {
+            return LoadFromBinary(filePath);
+        }
+
+        return LoadFromText(filePath);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightMap::LoadFromText
+      Summary:  Memory-maps and parses the legacy text height map with
+                std::from_chars
+      Args:     const std::filesystem::path& filePath
+                  Path to the height map
+      Modifies: [m_uWidth, m_uHeight, m_uDepth, m_aPalette,
+                 m_aBlockTypes, m_aHeights, m_loadTime].
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT HeightMap::LoadFromText(_In_ const std::filesystem::path& filePath)
+    {
+        LONGLONG startCounter = getPerformanceCounter();
+
+        MappedFile file;
+        HRESULT hr = file.Open(filePath);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        hr = parseText(reinterpret_cast<const CHAR*>(file.GetData()), file.GetSize());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        m_loadTime = getElapsedSeconds(startCounter);
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightMap::LoadFromBinary
+      Summary:  Memory-maps and decodes the binary height map
+      Args:     const std::filesystem::path& filePath
+                  Path to the height map
+      Modifies: [m_uWidth, m_uHeight, m_uDepth, m_aPalette,
+                 m_aBlockTypes, m_aHeights, m_loadTime].
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT HeightMap::LoadFromBinary(_In_ const std::filesystem::path& filePath)
+    {
+        LONGLONG startCounter = getPerformanceCounter();
+
+        MappedFile file;
+        HRESULT hr = file.Open(filePath);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        hr = parseBinary(file.GetData(), file.GetSize());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        m_loadTime = getElapsedSeconds(startCounter);
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightMap::SaveToText
+      Summary:  Saves the height map in the legacy text format. Empty
+                cells are written as zero-height grassland so that the
+                cell order is kept
+      Args:     const std::filesystem::path& filePath
+                  Path to the height map
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT HeightMap::SaveToText(_In_ const std::filesystem::path& filePath) const
+    {
+        std::ofstream outputFile(filePath, std::ios::binary);
+        if (!outputFile.is_open())
+        {
+            return E_FAIL;
+        }
+
+        std::string buffer;
+        buffer.reserve(64u + m_aPalette.size() * 32u + m_aHeights.size() * 10u + m_uDepth);
+
+        CHAR szNumber[32];
+        auto appendFloat = [&buffer, &szNumber](FLOAT value)
+        {
+            std::to_chars_result result = std::to_chars(szNumber, szNumber + ARRAYSIZE(szNumber), value, std::chars_format::general, 6);
+            buffer.append(szNumber, result.ptr);
+        };
+        auto appendUInt = [&buffer, &szNumber](UINT uValue)
+        {
+            std::to_chars_result result = std::to_chars(szNumber, szNumber + ARRAYSIZE(szNumber), uValue);
+            buffer.append(szNumber, result.ptr);
+        };
+
+        appendUInt(m_uWidth);
+        buffer.push_back(' ');
+        appendUInt(m_uHeight);
+        buffer.push_back(' ');
+        appendUInt(m_uDepth);
+        buffer.push_back(' ');
+        appendUInt(static_cast<UINT>(m_aPalette.size()));
+        buffer.push_back('\n');
+
+        for (const XMFLOAT4& color : m_aPalette)
+        {
+            appendFloat(color.x);
+            buffer.push_back(' ');
+            appendFloat(color.y);
+            buffer.push_back(' ');
+            appendFloat(color.z);
+            buffer.push_back('\n');
+        }
+
+        for (UINT z = 0u; z < m_uDepth; ++z)
+        {
+            for (UINT x = 0u; x < m_uWidth; ++x)
+            {
+                size_t uIndex = static_cast<size_t>(z) * m_uWidth + x;
+                if (m_aBlockTypes[uIndex] == EMPTY_BLOCK)
+                {
+                    buffer.push_back(static_cast<CHAR>(eBlockType::GRASSLAND));
+                    appendFloat(0.0f);
+                }
+                else
+                {
+                    buffer.push_back(m_aBlockTypes[uIndex]);
+                    appendFloat(m_aHeights[uIndex]);
+                }
+                buffer.push_back(' ');
+            }
+            buffer.push_back('\n');
+        }
+        buffer.push_back('\n');
+
+        outputFile.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+
+        return outputFile.good() ? S_OK : E_FAIL;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightMap::SaveToBinary
+      Summary:  Saves the height map in the binary format. Heights are
+                quantized to 16 bits, nudged so that every column keeps
+                exactly the same number of blocks as before
+      Args:     const std::filesystem::path& filePath
+                  Path to the height map
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT HeightMap::SaveToBinary(_In_ const std::filesystem::path& filePath) const
+    {
+        std::ofstream outputFile(filePath, std::ios::binary);
+        if (!outputFile.is_open())
+        {
+            return E_FAIL;
+        }
+
+        FLOAT maxHeight = 0.0f;
+        for (FLOAT height : m_aHeights)
+        {
+            maxHeight = std::max(maxHeight, height);
+        }
+
+        HeightMapBinaryHeader header =
+        {
+            .uMagic = BINARY_MAGIC,
+            .uVersion = BINARY_VERSION,
+            .uHeaderSize = static_cast<UINT16>(sizeof(HeightMapBinaryHeader)),
+            .uWidth = m_uWidth,
+            .uHeight = m_uHeight,
+            .uDepth = m_uDepth,
+            .uNumColors = static_cast<UINT32>(m_aPalette.size()),
+            .fHeightScale = maxHeight > 0.0f ? maxHeight / static_cast<FLOAT>(MAX_QUANTIZED_HEIGHT) : 1.0f / static_cast<FLOAT>(MAX_QUANTIZED_HEIGHT),
+            .uReserved = 0u
+        };
+
+        std::vector<UINT16> aQuantizedHeights(m_aHeights.size());
+        for (size_t i = 0u; i < m_aHeights.size(); ++i)
+        {
+            FLOAT height = std::max(m_aHeights[i], 0.0f);
+            LONG quantized = std::clamp(std::lround(height / header.fHeightScale), 0l, static_cast<LONG>(MAX_QUANTIZED_HEIGHT));
+
+            UINT uColumnHeight = toColumnHeight(m_uHeight, height);
+            while (quantized < MAX_QUANTIZED_HEIGHT && toColumnHeight(m_uHeight, static_cast<FLOAT>(quantized) * header.fHeightScale) < uColumnHeight)
+            {
+                ++quantized;
+            }
+            while (quantized > 0 && toColumnHeight(m_uHeight, static_cast<FLOAT>(quantized) * header.fHeightScale) > uColumnHeight)
+            {
+                --quantized;
+            }
+
+            aQuantizedHeights[i] = static_cast<UINT16>(quantized);
+        }
+
+        outputFile.write(reinterpret_cast<const CHAR*>(&header), sizeof(header));
+
+        for (const XMFLOAT4& color : m_aPalette)
+        {
+            FLOAT aColor[4] = { color.x, color.y, color.z, color.w };
+            outputFile.write(reinterpret_cast<const CHAR*>(aColor), sizeof(aColor));
+        }
+
+        outputFile.write(m_aBlockTypes.data(), static_cast<std::streamsize>(m_aBlockTypes.size()));
+
+        const CHAR aPadding[4] = { 0, };
+        outputFile.write(aPadding, static_cast<std::streamsize>(alignTo4(m_aBlockTypes.size()) - m_aBlockTypes.size()));
+
+        outputFile.write(reinterpret_cast<const CHAR*>(aQuantizedHeights.data()), static_cast<std::streamsize>(aQuantizedHeights.size() * sizeof(UINT16)));
+
+        return outputFile.good() ? S_OK : E_FAIL;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightMap::SetCell
+      Summary:  Sets the block type and height of a cell
+      Args:     UINT x
+                  Index of the cell along the x axis
+                UINT z
+                  Index of the cell along the z axis
+                CHAR blockType
+                  eBlockType value of the cell
+                FLOAT height
+                  Normalized height of the cell
+      Modifies: [m_aBlockTypes, m_aHeights].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void HeightMap::SetCell(_In_ UINT x, _In_ UINT z, _In_ CHAR blockType, _In_ FLOAT height)
+    {
+        assert(x < m_uWidth && z < m_uDepth);
+
+        size_t uIndex = static_cast<size_t>(z) * m_uWidth + x;
+        m_aBlockTypes[uIndex] = blockType;
+        m_aHeights[uIndex] = height;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightMap::GetBlockType
+      Summary:  Returns the block type of a cell
+      Args:     UINT x
+                  Index of the cell along the x axis
+                UINT z
+                  Index of the cell along the z axis
+      Returns:  CHAR
+                  eBlockType value of the cell, EMPTY_BLOCK if the cell
+                  was never filled
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    CHAR HeightMap::GetBlockType(_In_ UINT x, _In_ UINT z) const
+    {
+        return m_aBlockTypes[static_cast<size_t>(z) * m_uWidth + x];
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightMap::GetNormalizedHeight
+      Summary:  Returns the normalized height of a cell
+      Args:     UINT x
+                  Index of the cell along the x axis
+                UINT z
+                  Index of the cell along the z axis
+      Returns:  FLOAT
+                  Normalized height of the cell
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT HeightMap::GetNormalizedHeight(_In_ UINT x, _In_ UINT z) const
+    {
+        return m_aHeights[static_cast<size_t>(z) * m_uWidth + x];
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightMap::GetColumnHeight
+      Summary:  Returns the number of blocks stacked in a cell
+      Args:     UINT x
+                  Index of the cell along the x axis
+                UINT z
+                  Index of the cell along the z axis
+      Returns:  UINT
+                  Number of blocks, 0 for empty cells
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT HeightMap::GetColumnHeight(_In_ UINT x, _In_ UINT z) const
+    {
+        size_t uIndex = static_cast<size_t>(z) * m_uWidth + x;
+        if (m_aBlockTypes[uIndex] == EMPTY_BLOCK)
+        {
+            return 0u;
+        }
+
+        return toColumnHeight(m_uHeight, m_aHeights[uIndex]);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightMap::GetExposedHeight
+      Summary:  Returns the lowest block of a cell that has at least
+                one face not covered by a block. The top block always
+                faces the sky, and a block is exposed on a side when
+                the neighboring column, or the edge of the map, is
+                lower than it. The underside of the map is not seen,
+                so the bottom faces do not count
+      Args:     UINT x
+                  Index of the cell along the x axis
+                UINT z
+                  Index of the cell along the z axis
+      Returns:  UINT
+                  Height of the lowest exposed block, the blocks below
+                  it are fully enclosed. 0 for empty cells
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT HeightMap::GetExposedHeight(_In_ UINT x, _In_ UINT z) const
+    {
+        UINT uColumnHeight = GetColumnHeight(x, z);
+        if (uColumnHeight == 0u)
+        {
+            return 0u;
+        }
+
+        UINT uExposedHeight = uColumnHeight - 1u;
+        if (x == 0u || z == 0u || x + 1u >= m_uWidth || z + 1u >= m_uDepth)
+        {
+            return 0u;
+        }
+
+        uExposedHeight = std::min(uExposedHeight, GetColumnHeight(x - 1u, z));
+        uExposedHeight = std::min(uExposedHeight, GetColumnHeight(x + 1u, z));
+        uExposedHeight = std::min(uExposedHeight, GetColumnHeight(x, z - 1u));
+        uExposedHeight = std::min(uExposedHeight, GetColumnHeight(x, z + 1u));
+
+        return uExposedHeight;
+    }
+
+    UINT HeightMap::GetWidth() const
+    {
+        return m_uWidth;
+    }
+
+    UINT HeightMap::GetHeight() const
+    {
+        return m_uHeight;
+    }
+
+    UINT HeightMap::GetDepth() const
+    {
+        return m_uDepth;
+    }
+
+    const std::vector<XMFLOAT4>& HeightMap::GetPalette() const
+    {
+        return m_aPalette;
+    }
+
+    DOUBLE HeightMap::GetLoadTime() const
+    {
+        return m_loadTime;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightMap::resize
+      Summary:  Resizes the map and clears every cell
+      Args:     UINT uWidth
+                  Number of cells along the x axis
+                UINT uHeight
+                  Maximum number of blocks in a column
+                UINT uDepth
+                  Number of cells along the z axis
+      Modifies: [m_uWidth, m_uHeight, m_uDepth, m_aBlockTypes,
+                 m_aHeights].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void HeightMap::resize(_In_ UINT uWidth, _In_ UINT uHeight, _In_ UINT uDepth)
+    {
+        m_uWidth = uWidth;
+        m_uHeight = uHeight;
+        m_uDepth = uDepth;
+
+        size_t uNumCells = static_cast<size_t>(uWidth) * static_cast<size_t>(uDepth);
+        m_aBlockTypes.assign(uNumCells, EMPTY_BLOCK);
+        m_aHeights.assign(uNumCells, 0.0f);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightMap::parseText
+      Summary:  Parses the legacy text height map. Unreadable tokens
+                are skipped, and block types out of the eBlockType range
+                are ignored, exactly like the former std::ifstream
+                parser of Scene
+      Args:     const CHAR* pData
+                  Text of the height map
+                size_t uSize
+                  Size of the text in bytes
+      Modifies: [m_uWidth, m_uHeight, m_uDepth, m_aPalette,
+                 m_aBlockTypes, m_aHeights].
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT HeightMap::parseText(_In_reads_(uSize) const CHAR* pData, _In_ size_t uSize)
+    {
+        TextCursor cursor(pData, uSize);
+
+        UINT aDimension[4] = { 0u, };
+        UINT uDimensionIdx = 0u;
+        while (uDimensionIdx < ARRAYSIZE(aDimension) && !cursor.IsEnd())
+        {
+            if (cursor.ReadUInt(aDimension[uDimensionIdx]))
+            {
+                ++uDimensionIdx;
+            }
+            else
+            {
+                cursor.SkipToken();
+            }
+        }
+
+        resize(aDimension[0], aDimension[1], aDimension[2]);
+
+        m_aPalette.clear();
+        m_aPalette.reserve(aDimension[3]);
+        XMFLOAT4 color(0.0f, 0.0f, 0.0f, 1.0f);
+        while (m_aPalette.size() < aDimension[3] && !cursor.IsEnd())
+        {
+            if (cursor.ReadFloat(color.x) && cursor.ReadFloat(color.y) && cursor.ReadFloat(color.z))
+            {
+                m_aPalette.push_back(color);
+            }
+            else
+            {
+                cursor.SkipToken();
+            }
+        }
+
+        size_t uNumCells = m_aBlockTypes.size();
+        size_t uCellIdx = 0u;
+        CHAR voxelType;
+        FLOAT height;
+        while (uNumCells > 0u && !cursor.IsEnd())
+        {
+            if (!cursor.ReadChar(voxelType) || !cursor.ReadFloat(height))
+            {
+                cursor.SkipToken();
+            }
+            else if (isBlockType(voxelType))
+            {
+                m_aBlockTypes[uCellIdx] = voxelType;
+                m_aHeights[uCellIdx] = height;
+
+                if (++uCellIdx >= uNumCells)
+                {
+                    uCellIdx = 0u;
+                }
+            }
+        }
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HeightMap::parseBinary
+      Summary:  Validates and decodes the binary height map. Every
+                cell must be empty or hold a block type of the
+                eBlockType range the text parser accepts, otherwise the
+                map is rejected before anything is replaced
+      Args:     const BYTE* pData
+                  Contents of the binary height map
+                size_t uSize
+                  Size of the contents in bytes
+      Modifies: [m_uWidth, m_uHeight, m_uDepth, m_aPalette,
+                 m_aBlockTypes, m_aHeights].
+      Returns:  HRESULT
+                  Status code, E_FAIL when the dimensions are out of
+                  range, the file is truncated or a cell holds an
+                  unknown block type
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT HeightMap::parseBinary(_In_reads_(uSize) const BYTE* pData, _In_ size_t uSize)
+    {
+        if (uSize < sizeof(HeightMapBinaryHeader))
+        {
+            return E_FAIL;
+        }
+
+        HeightMapBinaryHeader header;
+        memcpy(&header, pData, sizeof(header));
+
+        if (header.uMagic != BINARY_MAGIC || header.uVersion != BINARY_VERSION || header.uHeaderSize < sizeof(HeightMapBinaryHeader))
+        {
+            return E_FAIL;
+        }
+
+        if (header.uWidth == 0u || header.uWidth > MAX_BINARY_DIMENSION
+            || header.uHeight == 0u || header.uHeight > MAX_BINARY_DIMENSION
+            || header.uDepth == 0u || header.uDepth > MAX_BINARY_DIMENSION)
+        {
+            return E_FAIL;
+        }
+
+        // Every section is checked against what is left of the file before its offset is added, so no sum overflows
+        const size_t uPaletteOffset = header.uHeaderSize;
+        if (uPaletteOffset > uSize || header.uNumColors > (uSize - uPaletteOffset) / sizeof(XMFLOAT4))
+        {
+            return E_FAIL;
+        }
+
+        const size_t uNumCells = static_cast<size_t>(header.uWidth) * static_cast<size_t>(header.uDepth);
+        const size_t uBlockTypesOffset = uPaletteOffset + static_cast<size_t>(header.uNumColors) * sizeof(XMFLOAT4);
+        if (uNumCells > uSize - uBlockTypesOffset)
+        {
+            return E_FAIL;
+        }
+
+        const size_t uHeightsOffset = alignTo4(uBlockTypesOffset + uNumCells);
+        if (uHeightsOffset > uSize || uNumCells > (uSize - uHeightsOffset) / sizeof(UINT16))
+        {
+            return E_FAIL;
+        }
+
+        const CHAR* pBlockTypes = reinterpret_cast<const CHAR*>(pData + uBlockTypesOffset);
+        for (size_t i = 0u; i < uNumCells; ++i)
+        {
+            if (pBlockTypes[i] != EMPTY_BLOCK && !isBlockType(pBlockTypes[i]))
+            {
+                return E_FAIL;
+            }
+        }
+
+        resize(header.uWidth, header.uHeight, header.uDepth);
+
+        m_aPalette.resize(header.uNumColors);
+        memcpy(m_aPalette.data(), pData + uPaletteOffset, m_aPalette.size() * sizeof(XMFLOAT4));
+
+        memcpy(m_aBlockTypes.data(), pBlockTypes, uNumCells);
+
+        const UINT16* pQuantizedHeights = reinterpret_cast<const UINT16*>(pData + uHeightsOffset);
+        for (size_t i = 0u; i < uNumCells; ++i)
+        {
+            m_aHeights[i] = static_cast<FLOAT>(pQuantizedHeights[i]) * header.fHeightScale;
+        }
+
+        return S_OK;
+    }
+}
\ No newline at end of file
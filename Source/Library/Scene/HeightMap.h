@@ -0,0 +1,144 @@
+/*+===================================================================
+  File:      HEIGHTMAP.H
+
+  Summary:   HeightMap header file contains declarations of HeightMap
+             class used to load, store and save the voxel height map
+             in the legacy text format and in the binary format.
+
+  Classes: HeightMap
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+namespace library
+{
+    /*E+E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E
+        Enum:     eHeightMapFormat
+
+        Summary:  Enumeration of height map file formats
+    E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E-E*/
+    enum class eHeightMapFormat
+    {
+        TEXT,
+        BINARY,
+        COUNT,
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   HeightMapBinaryHeader
+
+        Summary:  Header of the binary height map file. It is followed
+                  by the palette (uNumColors * 4 FLOATs), the block
+                  types (uWidth * uDepth bytes, padded to 4 bytes) and
+                  the quantized heights (uWidth * uDepth UINT16s)
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct HeightMapBinaryHeader
+    {
+        UINT32 uMagic;
+        UINT16 uVersion;
+        UINT16 uHeaderSize;
+        UINT32 uWidth;
+        UINT32 uHeight;
+        UINT32 uDepth;
+        UINT32 uNumColors;
+        FLOAT fHeightScale;
+        UINT32 uReserved;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    HeightMap
+
+      Summary:  2.5D voxel map storing one block type and one height
+                per (x, z) cell, plus the color palette of block types
+
+      Methods:  LoadFromFile
+                  Loads the height map, detecting the file format
+                LoadFromText
+                  Loads the legacy text height map
+                LoadFromBinary
+                  Loads the memory-mapped binary height map
+                SaveToText
+                  Saves the height map in the legacy text format
+                SaveToBinary
+                  Saves the height map in the binary format
+                Convert
+                  Converts a height map file to the other format
+                DetectFormat
+                  Returns the format of the given file
+                SetCell
+                  Sets the block type and height of a cell
+                GetBlockType
+                  Returns the block type of a cell
+                GetNormalizedHeight
+                  Returns the normalized height of a cell
+                GetColumnHeight
+                  Returns the number of blocks stacked in a cell
+                GetExposedHeight
+                  Returns the lowest block of a cell that has an
+                  exposed face
+                GetWidth / GetHeight / GetDepth
+                  Return the dimensions of the map
+                GetPalette
+                  Returns the colors of the block types
+                GetLoadTime
+                  Returns the time spent by the last load in seconds
+                HeightMap
+                  Constructor.
+                ~HeightMap
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class HeightMap
+    {
+    public:
+        static constexpr const UINT32 BINARY_MAGIC = 0x50414D48u; // "HMAP"
+        static constexpr const UINT16 BINARY_VERSION = 1u;
+        static constexpr const CHAR EMPTY_BLOCK = 0;
+
+        static eHeightMapFormat DetectFormat(_In_ const std::filesystem::path& filePath);
+        static HRESULT Convert(_In_ const std::filesystem::path& srcFilePath, _In_ const std::filesystem::path& dstFilePath, _In_ eHeightMapFormat dstFormat);
+
+        HeightMap();
+        HeightMap(_In_ UINT uWidth, _In_ UINT uHeight, _In_ UINT uDepth, _In_ std::vector<XMFLOAT4>&& aPalette);
+        HeightMap(const HeightMap& other) = delete;
+        HeightMap(HeightMap&& other) = default;
+        HeightMap& operator=(const HeightMap& other) = delete;
+        HeightMap& operator=(HeightMap&& other) = default;
+        ~HeightMap() = default;
+
+        HRESULT LoadFromFile(_In_ const std::filesystem::path& filePath);
+        HRESULT LoadFromText(_In_ const std::filesystem::path& filePath);
+        HRESULT LoadFromBinary(_In_ const std::filesystem::path& filePath);
+        HRESULT SaveToText(_In_ const std::filesystem::path& filePath) const;
+        HRESULT SaveToBinary(_In_ const std::filesystem::path& filePath) const;
+
+        void SetCell(_In_ UINT x, _In_ UINT z, _In_ CHAR blockType, _In_ FLOAT height);
+
+        CHAR GetBlockType(_In_ UINT x, _In_ UINT z) const;
+        FLOAT GetNormalizedHeight(_In_ UINT x, _In_ UINT z) const;
+        UINT GetColumnHeight(_In_ UINT x, _In_ UINT z) const;
+        UINT GetExposedHeight(_In_ UINT x, _In_ UINT z) const;
+
+        UINT GetWidth() const;
+        UINT GetHeight() const;
+        UINT GetDepth() const;
+        const std::vector<XMFLOAT4>& GetPalette() const;
+        DOUBLE GetLoadTime() const;
+
+    private:
+        void resize(_In_ UINT uWidth, _In_ UINT uHeight, _In_ UINT uDepth);
+        HRESULT parseText(_In_reads_(uSize) const CHAR* pData, _In_ size_t uSize);
+        HRESULT parseBinary(_In_reads_(uSize) const BYTE* pData, _In_ size_t uSize);
+
+    private:
+        UINT m_uWidth;
+        UINT m_uHeight;
+        UINT m_uDepth;
+        std::vector<XMFLOAT4> m_aPalette;
+        std::vector<CHAR> m_aBlockTypes;
+        std::vector<FLOAT> m_aHeights;
+        DOUBLE m_loadTime;
+    };
+}
\ No newline at end of file
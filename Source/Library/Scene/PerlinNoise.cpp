@@ -0,0 +1,569 @@
+#include "Scene/PerlinNoise.h"
+
+#include <intrin.h>
+#include <immintrin.h>
+
+namespace library
+{
+    namespace
+    {
+        constexpr const UINT SSE2_WIDTH = 4u;
+        constexpr const UINT AVX2_WIDTH = 8u;
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: smoothLerp
+
+          Summary:  Smoothstep interpolation, evaluated in the exact
+                    order of the former Scene::smoothLerp so the batched
+                    paths round identically
+
+          Args:     FLOAT x
+                      Lower value
+                    FLOAT y
+                      Upper value
+                    FLOAT s
+                      Interpolation factor in [0, 1)
+
+          Returns:  FLOAT
+                      Interpolated value
+        F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+        FLOAT smoothLerp(FLOAT x, FLOAT y, FLOAT s)
+        {
+            FLOAT w = s * s * (3.0f - 2.0f * s);
+
+            return x + w * (y - x);
+        }
+
+        __m128 smoothLerp4(__m128 x, __m128 y, __m128 s)
+        {
+            __m128 w = _mm_mul_ps(_mm_mul_ps(s, s), _mm_sub_ps(_mm_set1_ps(3.0f), _mm_mul_ps(_mm_set1_ps(2.0f), s)));
+
+            return _mm_add_ps(x, _mm_mul_ps(w, _mm_sub_ps(y, x)));
+        }
+
+        __m256 smoothLerp8(__m256 x, __m256 y, __m256 s)
+        {
+            __m256 w = _mm256_mul_ps(_mm256_mul_ps(s, s), _mm256_sub_ps(_mm256_set1_ps(3.0f), _mm256_mul_ps(_mm256_set1_ps(2.0f), s)));
+
+            return _mm256_add_ps(x, _mm256_mul_ps(w, _mm256_sub_ps(y, x)));
+        }
+
+        /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+          Struct:   RowOctave
+
+          Summary:  Part of an octave shared by every sample of a row:
+                    the hashes of the two lattice rows and the vertical
+                    interpolation factor
+        S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+        struct RowOctave
+        {
+            INT iHash0;
+            INT iHash1;
+            FLOAT yFrac;
+        };
+
+        RowOctave getRowOctave(const INT* aHashes, FLOAT ya)
+        {
+            INT iY = static_cast<INT>(ya);
+
+            return RowOctave
+            {
+                .iHash0 = aHashes[iY & 255],
+                .iHash1 = aHashes[(iY + 1) & 255],
+                .yFrac = ya - static_cast<FLOAT>(iY),
+            };
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: sampleRowSse2
+
+          Summary:  Evaluates 4 samples of a row per iteration. SSE2 has
+                    no gather, so the table is read lane by lane
+
+          Args:     const INT* aHashes
+                      Hash table of the noise
+                    FLOAT x
+                      Horizontal coordinate of the first sample
+                    FLOAT y
+                      Vertical coordinate of the row
+                    FLOAT step
+                      Distance between two samples
+                    FLOAT frequency
+                      Frequency of the first octave
+                    UINT uNumOctaves
+                      Number of octaves
+                    UINT uCount
+                      Number of samples, multiple of 4
+                    FLOAT* aOutSamples
+                      Output samples
+
+          Modifies: [aOutSamples].
+        F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+        void sampleRowSse2(const INT* aHashes, FLOAT x, FLOAT y, FLOAT step, FLOAT frequency, UINT uNumOctaves, UINT uCount, FLOAT* aOutSamples)
+        {
+            alignas(16) INT aX[SSE2_WIDTH];
+            alignas(16) INT aS[SSE2_WIDTH];
+            alignas(16) INT aT[SSE2_WIDTH];
+            alignas(16) INT aU[SSE2_WIDTH];
+            alignas(16) INT aV[SSE2_WIDTH];
+
+            const __m128 lanes = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+
+            for (UINT i = 0u; i < uCount; i += SSE2_WIDTH)
+            {
+                __m128 index = _mm_add_ps(_mm_set1_ps(static_cast<FLOAT>(i)), lanes);
+                __m128 xa = _mm_mul_ps(_mm_add_ps(_mm_set1_ps(x), _mm_mul_ps(_mm_set1_ps(step), index)), _mm_set1_ps(frequency));
+                FLOAT ya = y * frequency;
+                FLOAT amp = 1.0f;
+                FLOAT div = 0.0f;
+                __m128 fin = _mm_setzero_ps();
+
+                for (UINT uOctave = 0u; uOctave < uNumOctaves; ++uOctave)
+                {
+                    RowOctave row = getRowOctave(aHashes, ya);
+
+                    __m128i iX = _mm_cvttps_epi32(xa);
+                    __m128 xFrac = _mm_sub_ps(xa, _mm_cvtepi32_ps(iX));
+                    _mm_store_si128(reinterpret_cast<__m128i*>(aX), iX);
+
+                    for (UINT uLane = 0u; uLane < SSE2_WIDTH; ++uLane)
+                    {
+                        aS[uLane] = aHashes[(row.iHash0 + aX[uLane]) & 255];
+                        aT[uLane] = aHashes[(row.iHash0 + aX[uLane] + 1) & 255];
+                        aU[uLane] = aHashes[(row.iHash1 + aX[uLane]) & 255];
+                        aV[uLane] = aHashes[(row.iHash1 + aX[uLane] + 1) & 255];
+                    }
+
+                    __m128 low = smoothLerp4(
+                        _mm_cvtepi32_ps(_mm_load_si128(reinterpret_cast<const __m128i*>(aS))),
+                        _mm_cvtepi32_ps(_mm_load_si128(reinterpret_cast<const __m128i*>(aT))),
+                        xFrac
+                    );
+                    __m128 high = smoothLerp4(
+                        _mm_cvtepi32_ps(_mm_load_si128(reinterpret_cast<const __m128i*>(aU))),
+                        _mm_cvtepi32_ps(_mm_load_si128(reinterpret_cast<const __m128i*>(aV))),
+                        xFrac
+                    );
+                    __m128 noise = smoothLerp4(low, high, _mm_set1_ps(row.yFrac));
+
+                    div += 256.0f * amp;
+                    fin = _mm_add_ps(fin, _mm_mul_ps(noise, _mm_set1_ps(amp)));
+                    amp /= 2.0f;
+                    xa = _mm_mul_ps(xa, _mm_set1_ps(2.0f));
+                    ya *= 2.0f;
+                }
+
+                _mm_storeu_ps(aOutSamples + i, _mm_div_ps(fin, _mm_set1_ps(div)));
+            }
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: sampleRowAvx2
+
+          Summary:  Evaluates 8 samples of a row per iteration, reading
+                    the table with gathers
+
+          Args:     const INT* aHashes
+                      Hash table of the noise
+                    FLOAT x
+                      Horizontal coordinate of the first sample
+                    FLOAT y
+                      Vertical coordinate of the row
+                    FLOAT step
+                      Distance between two samples
+                    FLOAT frequency
+                      Frequency of the first octave
+                    UINT uNumOctaves
+                      Number of octaves
+                    UINT uCount
+                      Number of samples, multiple of 8
+                    FLOAT* aOutSamples
+                      Output samples
+
+          Modifies: [aOutSamples].
+        F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+        void sampleRowAvx2(const INT* aHashes, FLOAT x, FLOAT y, FLOAT step, FLOAT frequency, UINT uNumOctaves, UINT uCount, FLOAT* aOutSamples)
+        {
+            const __m256 lanes = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+            const __m256i mask = _mm256_set1_epi32(255);
+            const __m256i one = _mm256_set1_epi32(1);
+
+            for (UINT i = 0u; i < uCount; i += AVX2_WIDTH)
+            {
+                __m256 index = _mm256_add_ps(_mm256_set1_ps(static_cast<FLOAT>(i)), lanes);
+                __m256 xa = _mm256_mul_ps(_mm256_add_ps(_mm256_set1_ps(x), _mm256_mul_ps(_mm256_set1_ps(step), index)), _mm256_set1_ps(frequency));
+                FLOAT ya = y * frequency;
+                FLOAT amp = 1.0f;
+                FLOAT div = 0.0f;
+                __m256 fin = _mm256_setzero_ps();
+
+                for (UINT uOctave = 0u; uOctave < uNumOctaves; ++uOctave)
+                {
+                    RowOctave row = getRowOctave(aHashes, ya);
+
+                    __m256i iX = _mm256_cvttps_epi32(xa);
+                    __m256 xFrac = _mm256_sub_ps(xa, _mm256_cvtepi32_ps(iX));
+
+                    __m256i left0 = _mm256_add_epi32(_mm256_set1_epi32(row.iHash0), iX);
+                    __m256i left1 = _mm256_add_epi32(_mm256_set1_epi32(row.iHash1), iX);
+
+                    __m256i s = _mm256_i32gather_epi32(aHashes, _mm256_and_si256(left0, mask), 4);
+                    __m256i t = _mm256_i32gather_epi32(aHashes, _mm256_and_si256(_mm256_add_epi32(left0, one), mask), 4);
+                    __m256i u = _mm256_i32gather_epi32(aHashes, _mm256_and_si256(left1, mask), 4);
+                    __m256i v = _mm256_i32gather_epi32(aHashes, _mm256_and_si256(_mm256_add_epi32(left1, one), mask), 4);
+
+                    __m256 low = smoothLerp8(_mm256_cvtepi32_ps(s), _mm256_cvtepi32_ps(t), xFrac);
+                    __m256 high = smoothLerp8(_mm256_cvtepi32_ps(u), _mm256_cvtepi32_ps(v), xFrac);
+                    __m256 noise = smoothLerp8(low, high, _mm256_set1_ps(row.yFrac));
+
+                    div += 256.0f * amp;
+                    fin = _mm256_add_ps(fin, _mm256_mul_ps(noise, _mm256_set1_ps(amp)));
+                    amp /= 2.0f;
+                    xa = _mm256_mul_ps(xa, _mm256_set1_ps(2.0f));
+                    ya *= 2.0f;
+                }
+
+                _mm256_storeu_ps(aOutSamples + i, _mm256_div_ps(fin, _mm256_set1_ps(div)));
+            }
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: nextSeedValue
+
+          Summary:  Steps the splitmix64 generator. The permutation of
+                    a seed must not depend on the standard library, so
+                    <random> is not used
+
+          Args:     UINT64& uState
+                      State of the generator
+
+          Modifies: [uState].
+
+          Returns:  UINT64
+                      Next pseudo random value
+        F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+        UINT64 nextSeedValue(UINT64& uState)
+        {
+            UINT64 z = (uState += 0x9E3779B97F4A7C15ull);
+            z = (z ^ (z >> 30u)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27u)) * 0x94D049BB133111EBull;
+
+            return z ^ (z >> 31u);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   PerlinNoise::GetSupportedInstructionSet
+
+      Summary:  Returns the widest code path the CPU and the operating
+                system support. AVX2 needs the CPUID feature bit and
+                the OS saving the YMM registers
+
+      Returns:  eNoiseInstructionSet
+                  Widest supported code path
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    eNoiseInstructionSet PerlinNoise::GetSupportedInstructionSet()
+    {
+        static const eNoiseInstructionSet s_supported = []()
+        {
+            INT aInfo[4] = {};
+            __cpuid(aInfo, 0);
+            INT iMaxLeaf = aInfo[0];
+
+            __cpuid(aInfo, 1);
+            BOOL bOsxsave = (aInfo[2] & (1 << 27)) != 0;
+            BOOL bAvx = (aInfo[2] & (1 << 28)) != 0;
+
+            if (iMaxLeaf >= 7 && bOsxsave && bAvx && (_xgetbv(0) & 6ull) == 6ull)
+            {
+                __cpuidex(aInfo, 7, 0);
+                if (aInfo[1] & (1 << 5))
+                {
+                    return eNoiseInstructionSet::AVX2;
+                }
+            }
+
+            // SSE2 is part of the x64 baseline
+            return eNoiseInstructionSet::SSE2;
+        }();
+
+        return s_supported;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   PerlinNoise::PerlinNoise
+
+      Summary:  Constructor. The default seed keeps the original hash
+                table, any other seed shuffles it
+
+      Args:     UINT uSeed
+                  Seed of the noise channel
+
+      Modifies: [m_aHashes, m_instructionSet].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    PerlinNoise::PerlinNoise(_In_ UINT uSeed)
+        : m_aHashes()
+        , m_instructionSet(GetSupportedInstructionSet())
+    {
+        for (UINT i = 0u; i < NUM_HASHES; ++i)
+        {
+            m_aHashes[i] = static_cast<INT>(ms_aDefaultHashes[i]);
+        }
+
+        if (uSeed != DEFAULT_SEED)
+        {
+            UINT64 uState = uSeed;
+            for (UINT i = NUM_HASHES - 1u; i > 0u; --i)
+            {
+                UINT j = static_cast<UINT>(nextSeedValue(uState) % (i + 1u));
+                std::swap(m_aHashes[i], m_aHashes[j]);
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   PerlinNoise::Sample
+
+      Summary:  Evaluates one sample of the fractal noise
+
+      Args:     FLOAT x
+                  Horizontal coordinate, in [0, 2^31)
+                FLOAT y
+                  Vertical coordinate, in [0, 2^31)
+                FLOAT frequency
+                  Frequency of the first octave
+                UINT uNumOctaves
+                  Number of octaves
+
+      Returns:  FLOAT
+                  Noise value in [0, 1)
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT PerlinNoise::Sample(_In_ FLOAT x, _In_ FLOAT y, _In_ FLOAT frequency, _In_ UINT uNumOctaves) const
+    {
+        FLOAT xa = x * frequency;
+        FLOAT ya = y * frequency;
+        FLOAT amp = 1.0f;
+        FLOAT fin = 0.0f;
+        FLOAT div = 0.0f;
+
+        for (UINT i = 0u; i < uNumOctaves; ++i)
+        {
+            RowOctave row = getRowOctave(m_aHashes, ya);
+
+            INT iX = static_cast<INT>(xa);
+            FLOAT xFrac = xa - static_cast<FLOAT>(iX);
+
+            FLOAT low = smoothLerp(
+                static_cast<FLOAT>(m_aHashes[(row.iHash0 + iX) & 255]),
+                static_cast<FLOAT>(m_aHashes[(row.iHash0 + iX + 1) & 255]),
+                xFrac
+            );
+            FLOAT high = smoothLerp(
+                static_cast<FLOAT>(m_aHashes[(row.iHash1 + iX) & 255]),
+                static_cast<FLOAT>(m_aHashes[(row.iHash1 + iX + 1) & 255]),
+                xFrac
+            );
+
+            div += 256.0f * amp;
+            fin += smoothLerp(low, high, row.yFrac) * amp;
+            amp /= 2.0f;
+            xa *= 2.0f;
+            ya *= 2.0f;
+        }
+
+        return fin / div;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   PerlinNoise::Sample3d
+
+      Summary:  Evaluates one sample of the fractal noise in three
+                dimensions. The lattice corners are hashed through the
+                same table as Sample, one lookup per axis, and blended
+                with the same smoothstep along x, then y, then z
+
+      Args:     FLOAT x
+                FLOAT y
+                FLOAT z
+                  Coordinates, in [0, 2^31)
+                FLOAT frequency
+                  Frequency of the first octave
+                UINT uNumOctaves
+                  Number of octaves
+
+      Returns:  FLOAT
+                  Noise value in [0, 1)
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT PerlinNoise::Sample3d(_In_ FLOAT x, _In_ FLOAT y, _In_ FLOAT z, _In_ FLOAT frequency, _In_ UINT uNumOctaves) const
+    {
+        FLOAT xa = x * frequency;
+        FLOAT ya = y * frequency;
+        FLOAT za = z * frequency;
+        FLOAT amp = 1.0f;
+        FLOAT fin = 0.0f;
+        FLOAT div = 0.0f;
+
+        for (UINT i = 0u; i < uNumOctaves; ++i)
+        {
+            INT iX = static_cast<INT>(xa);
+            INT iY = static_cast<INT>(ya);
+            INT iZ = static_cast<INT>(za);
+            FLOAT xFrac = xa - static_cast<FLOAT>(iX);
+            FLOAT yFrac = ya - static_cast<FLOAT>(iY);
+            FLOAT zFrac = za - static_cast<FLOAT>(iZ);
+
+            FLOAT aSlices[2];
+            for (INT dz = 0; dz < 2; ++dz)
+            {
+                INT iHashZ = m_aHashes[(iZ + dz) & 255];
+                FLOAT aRows[2];
+                for (INT dy = 0; dy < 2; ++dy)
+                {
+                    INT iHashY = m_aHashes[(iHashZ + iY + dy) & 255];
+                    aRows[dy] = smoothLerp(
+                        static_cast<FLOAT>(m_aHashes[(iHashY + iX) & 255]),
+                        static_cast<FLOAT>(m_aHashes[(iHashY + iX + 1) & 255]),
+                        xFrac
+                    );
+                }
+                aSlices[dz] = smoothLerp(aRows[0], aRows[1], yFrac);
+            }
+
+            div += 256.0f * amp;
+            fin += smoothLerp(aSlices[0], aSlices[1], zFrac) * amp;
+            amp /= 2.0f;
+            xa *= 2.0f;
+            ya *= 2.0f;
+            za *= 2.0f;
+        }
+
+        return fin / div;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   PerlinNoise::SampleRow
+
+      Summary:  Evaluates the samples at (x + i * step, y). Each sample
+                equals Sample of the same coordinates whatever the
+                code path is
+
+      Args:     FLOAT x
+                  Horizontal coordinate of the first sample
+                FLOAT y
+                  Vertical coordinate of the row
+                FLOAT step
+                  Distance between two samples
+                FLOAT frequency
+                  Frequency of the first octave
+                UINT uNumOctaves
+                  Number of octaves
+                UINT uCount
+                  Number of samples
+                FLOAT* aOutSamples
+                  Output samples
+
+      Modifies: [aOutSamples].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void PerlinNoise::SampleRow(_In_ FLOAT x, _In_ FLOAT y, _In_ FLOAT step, _In_ FLOAT frequency, _In_ UINT uNumOctaves, _In_ UINT uCount, _Out_writes_(uCount) FLOAT* aOutSamples) const
+    {
+        UINT uNumBatched = 0u;
+
+        switch (m_instructionSet)
+        {
+        case eNoiseInstructionSet::AVX2:
+            uNumBatched = uCount - uCount % AVX2_WIDTH;
+            sampleRowAvx2(m_aHashes, x, y, step, frequency, uNumOctaves, uNumBatched, aOutSamples);
+            break;
+
+        case eNoiseInstructionSet::SSE2:
+            uNumBatched = uCount - uCount % SSE2_WIDTH;
+            sampleRowSse2(m_aHashes, x, y, step, frequency, uNumOctaves, uNumBatched, aOutSamples);
+            break;
+
+        default:
+            break;
+        }
+
+        for (UINT i = uNumBatched; i < uCount; ++i)
+        {
+            aOutSamples[i] = Sample(x + step * static_cast<FLOAT>(i), y, frequency, uNumOctaves);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   PerlinNoise::FillTile
+
+      Summary:  Evaluates the samples at (x + i * step, y + j * step),
+                row by row
+
+      Args:     FLOAT x
+                  Horizontal coordinate of the first sample
+                FLOAT y
+                  Vertical coordinate of the first sample
+                FLOAT step
+                  Distance between two samples
+                FLOAT frequency
+                  Frequency of the first octave
+                UINT uNumOctaves
+                  Number of octaves
+                UINT uWidth
+                  Number of samples of a row
+                UINT uHeight
+                  Number of rows
+                FLOAT* aOutSamples
+                  Output samples, row major
+
+      Modifies: [aOutSamples].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void PerlinNoise::FillTile(_In_ FLOAT x, _In_ FLOAT y, _In_ FLOAT step, _In_ FLOAT frequency, _In_ UINT uNumOctaves, _In_ UINT uWidth, _In_ UINT uHeight, _Out_writes_(uWidth * uHeight) FLOAT* aOutSamples) const
+    {
+        for (UINT j = 0u; j < uHeight; ++j)
+        {
+            SampleRow(x, y + step * static_cast<FLOAT>(j), step, frequency, uNumOctaves, uWidth, aOutSamples + static_cast<size_t>(j) * uWidth);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   PerlinNoise::SetInstructionSet
+
+      Summary:  Selects the code path of the batched methods
+
+      Args:     eNoiseInstructionSet instructionSet
+                  Code path
+
+      Modifies: [m_instructionSet].
+
+      Returns:  HRESULT
+                  Status code, E_NOTIMPL when the CPU lacks the
+                  instruction set
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT PerlinNoise::SetInstructionSet(_In_ eNoiseInstructionSet instructionSet)
+    {
+        if (instructionSet >= eNoiseInstructionSet::COUNT)
+        {
+            return E_INVALIDARG;
+        }
+
+        if (instructionSet > GetSupportedInstructionSet())
+        {
+            return E_NOTIMPL;
+        }
+
+        m_instructionSet = instructionSet;
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   PerlinNoise::GetInstructionSet
+
+      Summary:  Returns the code path of the batched methods
+
+      Returns:  eNoiseInstructionSet
+                  Code path
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    eNoiseInstructionSet PerlinNoise::GetInstructionSet() const
+    {
+        return m_instructionSet;
+    }
+}
\ No newline at end of file
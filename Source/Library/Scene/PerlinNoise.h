@@ -0,0 +1,105 @@
+/*+===================================================================
+  File:      PERLINNOISE.H
+
+  Summary:   PerlinNoise header file contains declarations of
+             PerlinNoise class, the batched noise engine used to
+             generate the height and the moisture of the voxel map.
+
+  Classes: PerlinNoise
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+namespace library
+{
+    /*E+E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E
+        Enum:     eNoiseInstructionSet
+
+        Summary:  Enumeration of the code paths of the noise engine.
+                  SSE2 evaluates 4 samples and AVX2 8 samples per
+                  instruction
+    E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E-E*/
+    enum class eNoiseInstructionSet
+    {
+        SCALAR,
+        SSE2,
+        AVX2,
+        COUNT,
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    PerlinNoise
+
+      Summary:  Fractal value noise evaluated in batches. With the
+                default seed every sample is bit-identical to the
+                former scalar Scene::GetPerlin2d for coordinates in
+                [0, 2^31). Each seed shuffles the hash table so the
+                height and the moisture use separate channels
+
+      Methods:  Sample
+                  Evaluates one sample
+                Sample3d
+                  Evaluates one sample of the volumetric noise
+                SampleRow
+                  Evaluates a row of evenly spaced samples
+                FillTile
+                  Evaluates a tile of evenly spaced samples
+                SetInstructionSet
+                  Selects the code path of the batched methods
+                GetInstructionSet
+                  Returns the code path of the batched methods
+                GetSupportedInstructionSet
+                  Returns the widest code path the CPU supports
+                PerlinNoise
+                  Constructor.
+                ~PerlinNoise
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class PerlinNoise
+    {
+    public:
+        static constexpr const UINT DEFAULT_SEED = 0u;
+
+        static eNoiseInstructionSet GetSupportedInstructionSet();
+
+        explicit PerlinNoise(_In_ UINT uSeed = DEFAULT_SEED);
+        PerlinNoise(const PerlinNoise& other) = default;
+        PerlinNoise(PerlinNoise&& other) = default;
+        PerlinNoise& operator=(const PerlinNoise& other) = default;
+        PerlinNoise& operator=(PerlinNoise&& other) = default;
+        ~PerlinNoise() = default;
+
+        FLOAT Sample(_In_ FLOAT x, _In_ FLOAT y, _In_ FLOAT frequency, _In_ UINT uNumOctaves) const;
+        FLOAT Sample3d(_In_ FLOAT x, _In_ FLOAT y, _In_ FLOAT z, _In_ FLOAT frequency, _In_ UINT uNumOctaves) const;
+        void SampleRow(_In_ FLOAT x, _In_ FLOAT y, _In_ FLOAT step, _In_ FLOAT frequency, _In_ UINT uNumOctaves, _In_ UINT uCount, _Out_writes_(uCount) FLOAT* aOutSamples) const;
+        void FillTile(_In_ FLOAT x, _In_ FLOAT y, _In_ FLOAT step, _In_ FLOAT frequency, _In_ UINT uNumOctaves, _In_ UINT uWidth, _In_ UINT uHeight, _Out_writes_(uWidth * uHeight) FLOAT* aOutSamples) const;
+
+        HRESULT SetInstructionSet(_In_ eNoiseInstructionSet instructionSet);
+        eNoiseInstructionSet GetInstructionSet() const;
+
+    private:
+        static constexpr const UINT ms_aDefaultHashes[] =
+        {
+            208,34,231,213,32,248,233,56,161,78,24,140,71,48,140,254,245,255,247,247,40,
+            185,248,251,245,28,124,204,204,76,36,1,107,28,234,163,202,224,245,128,167,204,
+            9,92,217,54,239,174,173,102,193,189,190,121,100,108,167,44,43,77,180,204,8,81,
+            70,223,11,38,24,254,210,210,177,32,81,195,243,125,8,169,112,32,97,53,195,13,
+            203,9,47,104,125,117,114,124,165,203,181,235,193,206,70,180,174,0,167,181,41,
+            164,30,116,127,198,245,146,87,224,149,206,57,4,192,210,65,210,129,240,178,105,
+            228,108,245,148,140,40,35,195,38,58,65,207,215,253,65,85,208,76,62,3,237,55,89,
+            232,50,217,64,244,157,199,121,252,90,17,212,203,149,152,140,187,234,177,73,174,
+            193,100,192,143,97,53,145,135,19,103,13,90,135,151,199,91,239,247,33,39,145,
+            101,120,99,3,186,86,99,41,237,203,111,79,220,135,158,42,30,154,120,67,87,167,
+            135,176,183,191,253,115,184,21,233,58,129,233,142,39,128,211,118,137,139,255,
+            114,20,218,113,154,27,127,246,250,1,8,198,250,209,92,222,173,21,88,102,219
+        };
+        static constexpr const UINT NUM_HASHES = ARRAYSIZE(ms_aDefaultHashes);
+
+    private:
+        INT m_aHashes[NUM_HASHES];
+        eNoiseInstructionSet m_instructionSet;
+    };
+}
\ No newline at end of file
@@ -4,172 +4,332 @@
 
 namespace library
 {
-    FLOAT Scene::GetPerlin2d(FLOAT x, FLOAT y, FLOAT frequency, UINT uDepth)
+    namespace
     {
-        FLOAT xa = x * frequency;
-        FLOAT ya = y * frequency;
-        FLOAT amp = 1.0f;
-        FLOAT fin = 0.0f;
-        FLOAT div = 0.0f;
-
-        for (UINT i = 0; i < uDepth; ++i)
+        // Streamed world: chunk columns within 12 columns (768 cells) of the camera, at most 256 MB
+        constexpr const ChunkStreamingDesc STREAMED_WORLD_DESC =
         {
-            div += 256.0f * amp;
-            fin += getNoise2d(xa, ya) * amp;
-            amp /= 2.0f;
-            xa *= 2.0f;
-            ya *= 2.0f;
-        }
+            .terrain =
+            {
+                .uWidth = 0u,
+                .uHeight = 64u,
+                .uDepth = 0u,
+                .uHeightSeed = 0u,
+                .uMoistureSeed = 1u
+            },
+            .meshing = eVoxelMeshing::GREEDY,
+            .uLoadRadius = 12u,
+            .uMemoryBudget = 256ull << 20u,
+            .uMaxLoadsPerFrame = 4u,
+            .uMaxEvictionsPerFrame = 8u,
+            .uNumWorkers = 0u
+        };
+
+        // Largest error of a level of detail on screen, in pixels
+        constexpr const FLOAT LOD_MAX_SCREEN_ERROR = 4.0f;
+
+        // Distance the smooth terrain is drawn at full detail within, 128 columns
+        constexpr const FLOAT TERRAIN_DETAIL_DISTANCE = 256.0f;
+
+        // Serialized bytes of edited chunks handed to the region writer per frame
+        constexpr const UINT64 REGION_BYTES_PER_FRAME = 256ull << 10u;
+    }
+
+    FLOAT Scene::GetPerlin2d(FLOAT x, FLOAT y, FLOAT frequency, UINT uDepth)
+    {
+        static const PerlinNoise s_noise;
 
-        return fin / div;
+        return s_noise.Sample(x, y, frequency, uDepth);
     }
 
-    Scene::Scene(const std::filesystem::path& filePath)
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::Scene
+      Summary:  Constructor. Loads the height map, in the text or in
+                the binary format, fills the block grid used by the
+                raycasts and builds either the voxel instances, the
+                chunk meshes, the level of detail tree or the smooth
+                terrain. STREAMED ignores the height map and streams a
+                generated world instead
+      Args:     const std::filesystem::path& filePath
+                  Path to the height map
+                eVoxelBuildMode buildMode
+                  How the voxels are turned into geometry
+                eInstanceFormat instanceFormat
+                  Format of the voxel instances, COMPACT and COLUMN
+                  need the map to fit in 16-bit grid coordinates
+                BOOL bWaterSurface
+                  Whether the instanced builds draw the water cells as
+                  one flat surface mesh instead of blocks
+                const std::filesystem::path& regionDirectory
+                  Directory of the region files the edited blocks are
+                  loaded from and saved to, none when empty
+      Modifies: [m_filePath, m_heightMap, m_buildMode,
+                 m_instanceFormat, m_bWaterSurface, m_voxels,
+                 m_voxelChunks, m_chunkStreamer, m_lodTree,
+                 m_aLodNodeChunks, m_aLodNodeIndices, m_terrain,
+                 m_voxelGrid, m_voxelEditor, m_voxelMaterials,
+                 m_regionStore, m_lightMap,
+                 m_horizonCuller, m_aInstanceStats, m_renderables,
+                 m_aPointLights,
+                 m_vertexShaders, m_pixelShaders, m_skyBox].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    Scene::Scene(const std::filesystem::path& filePath, eVoxelBuildMode buildMode, eInstanceFormat instanceFormat, BOOL bWaterSurface, const std::filesystem::path& regionDirectory)
         : m_filePath(filePath)
+        , m_heightMap()
+        , m_buildMode(buildMode)
+        , m_instanceFormat(instanceFormat)
         , m_voxels()
+        , m_voxelChunks()
+        , m_chunkStreamer()
+        , m_lodTree()
+        , m_aLodNodeChunks()
+        , m_aLodNodeIndices()
+        , m_terrain()
+        , m_voxelGrid()
+        , m_voxelEditor()
+        , m_voxelMaterials()
+        , m_regionStore()
+        , m_lightMap()
+        , m_horizonCuller()
+        , m_aVisibleVoxelChunks()
+        , m_aInstanceStats()
+        , m_bWaterSurface(bWaterSurface)
+        , m_waterStats()
         , m_renderables()
         , m_aPointLights{ nullptr }
         , m_vertexShaders()
         , m_pixelShaders()
         , m_skyBox()
     {
-        std::ifstream inputFile;
-        inputFile.open(m_filePath.string());
+        if (m_buildMode == eVoxelBuildMode::STREAMED)
+        {
+            m_chunkStreamer = std::make_unique<VoxelChunkStreamer>(STREAMED_WORLD_DESC);
+            return;
+        }
 
-        std::string trash;
-        UINT aDimension[4] = { 0u, };
-        UINT uDimensionIdx = 0u;
-        while (!inputFile.eof() && uDimensionIdx < ARRAYSIZE(aDimension))
+        HRESULT hr = m_heightMap.LoadFromFile(m_filePath);
+        if (FAILED(hr))
         {
-            inputFile >> aDimension[uDimensionIdx];
+            OutputDebugString(L"Can't load height map from \"");
+            OutputDebugString(m_filePath.c_str());
+            OutputDebugString(L"\"\n");
+            return;
+        }
+
+        WCHAR szMessage[256];
+        swprintf_s(szMessage, L"Height map %ux%ux%u loaded in %.3f ms\n", m_heightMap.GetWidth(), m_heightMap.GetHeight(), m_heightMap.GetDepth(), m_heightMap.GetLoadTime() * 1000.0);
+        OutputDebugString(szMessage);
+
+        // Picking and raycasts look up the blocks in the grid whatever the geometry is built from
+        m_voxelGrid = std::make_unique<VoxelGrid>(m_heightMap);
+
+        // Saved chunks replace the ones of the height map, the instances are then built from the grid
+        UINT uNumLoadedChunks = openRegionStore(regionDirectory);
 
-            if (inputFile.fail())
+        switch (m_buildMode)
+        {
+        case eVoxelBuildMode::CHUNKED:
+            buildChunks();
+            break;
+        case eVoxelBuildMode::LOD:
+            buildLevelsOfDetail();
+            break;
+        case eVoxelBuildMode::SMOOTH:
+            buildTerrain();
+            break;
+        default:
+            if (uNumLoadedChunks > 0u)
             {
-                if (inputFile.eof())
-                {
-                    break;
-                }
-                inputFile.clear();
-                inputFile >> trash;
+                buildGridInstances();
             }
             else
             {
-                ++uDimensionIdx;
+                buildInstances();
             }
+            break;
         }
+    }
 
-        UINT uColorIdx = 0u;
-        XMFLOAT4 color;
-        while (!inputFile.eof() && uColorIdx < aDimension[3])
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::Scene
+      Summary:  Constructor. Generates the block grid from a density
+                field with caves and overhangs, on all cores, and
+                builds either the voxel instances or the chunk meshes
+                from it. The level of detail, smooth and streamed
+                builds need a height map, so they build chunks, and a column
+                instance can't cover the air under an overhang, so
+                COLUMN instances blocks in the COMPACT format
+      Args:     const DensityDesc& densityDesc
+                  Dimensions and seed of the generated grid
+                eVoxelBuildMode buildMode
+                  How the voxels are turned into geometry
+                eInstanceFormat instanceFormat
+                  Format of the voxel instances
+                const std::filesystem::path& regionDirectory
+                  Directory of the region files the edited blocks are
+                  loaded from and saved to, none when empty
+      Modifies: [m_filePath, m_heightMap, m_buildMode,
+                 m_instanceFormat, m_bWaterSurface, m_voxels,
+                 m_voxelChunks, m_chunkStreamer, m_lodTree,
+                 m_aLodNodeChunks, m_aLodNodeIndices, m_terrain,
+                 m_voxelGrid, m_voxelEditor, m_voxelMaterials,
+                 m_regionStore, m_lightMap,
+                 m_horizonCuller, m_aInstanceStats, m_renderables,
+                 m_aPointLights,
+                 m_vertexShaders, m_pixelShaders, m_skyBox].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    Scene::Scene(const DensityDesc& densityDesc, eVoxelBuildMode buildMode, eInstanceFormat instanceFormat, const std::filesystem::path& regionDirectory)
+        : m_filePath()
+        , m_heightMap()
+        , m_buildMode(buildMode)
+        , m_instanceFormat(instanceFormat)
+        , m_voxels()
+        , m_voxelChunks()
+        , m_chunkStreamer()
+        , m_lodTree()
+        , m_aLodNodeChunks()
+        , m_aLodNodeIndices()
+        , m_terrain()
+        , m_voxelGrid()
+        , m_voxelEditor()
+        , m_voxelMaterials()
+        , m_regionStore()
+        , m_lightMap()
+        , m_horizonCuller()
+        , m_aVisibleVoxelChunks()
+        , m_aInstanceStats()
+        , m_bWaterSurface(FALSE)
+        , m_waterStats()
+        , m_renderables()
+        , m_aPointLights{ nullptr }
+        , m_vertexShaders()
+        , m_pixelShaders()
+        , m_skyBox()
+    {
+        if (m_buildMode == eVoxelBuildMode::STREAMED || m_buildMode == eVoxelBuildMode::LOD || m_buildMode == eVoxelBuildMode::SMOOTH)
+        {
+            OutputDebugString(L"Density grid: streamed, level of detail and smooth builds need a height map, building chunks\n");
+            m_buildMode = eVoxelBuildMode::CHUNKED;
+        }
+        if (m_instanceFormat == eInstanceFormat::COLUMN)
         {
-            inputFile >> color.x >> color.y >> color.z;
+            OutputDebugString(L"Density grid: columns can't skip the air under overhangs, instancing compact blocks\n");
+            m_instanceFormat = eInstanceFormat::COMPACT;
+        }
 
-            if (inputFile.fail())
-            {
-                if (inputFile.eof())
-                {
-                    break;
-                }
-                inputFile.clear();
-                inputFile >> trash;
-            }
-            else
-            {
-                color.w = 1.0f;
-                m_voxels.push_back(std::make_shared<Voxel>(color));
-                ++uColorIdx;
-            }
+        LARGE_INTEGER frequency;
+        LARGE_INTEGER start;
+        LARGE_INTEGER end;
+        QueryPerformanceFrequency(&frequency);
+        QueryPerformanceCounter(&start);
+
+        DensityGenerator generator(densityDesc);
+        HRESULT hr = generator.Generate(m_voxelGrid);
+        if (FAILED(hr))
+        {
+            OutputDebugString(L"Can't generate the density grid\n");
+            return;
         }
 
-        std::vector<std::vector<InstanceData>> aInstanceData;
-        aInstanceData.reserve(m_voxels.size());
-        for (UINT renderableIdx = 0u; renderableIdx < m_voxels.size(); ++renderableIdx)
+        QueryPerformanceCounter(&end);
+
+        WCHAR szMessage[256];
+        swprintf_s(
+            szMessage,
+            L"Density grid %ux%ux%u generated in %.3f ms, %u cave worms\n",
+            densityDesc.uWidth, densityDesc.uHeight, densityDesc.uDepth,
+            static_cast<DOUBLE>(end.QuadPart - start.QuadPart) * 1000.0 / static_cast<DOUBLE>(frequency.QuadPart),
+            generator.GetNumCaveWorms()
+        );
+        OutputDebugString(szMessage);
+
+        openRegionStore(regionDirectory);
+
+        if (m_buildMode == eVoxelBuildMode::CHUNKED)
         {
-            aInstanceData.push_back(std::vector<InstanceData>());
-            aInstanceData.back().reserve(
-                static_cast<size_t>(aDimension[0]) * static_cast<size_t>(aDimension[1]) * static_cast<size_t>(aDimension[2])
-            );
+            buildChunks();
+        }
+        else
+        {
+            buildGridInstances();
         }
+    }
 
-        UINT uDepthIdx = 0u;
-        UINT uWidthIdx = 0u;
-        CHAR voxelType;
-        FLOAT height;
-        while (!inputFile.eof())
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::~Scene
+      Summary:  Destructor. Saves the chunks edited since the last
+                frame and waits for the region writer
+      Modifies: [m_regionStore].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    Scene::~Scene()
+    {
+        if (m_regionStore && FAILED(m_regionStore->Flush(*m_voxelGrid)))
         {
-            inputFile >> voxelType >> height;
+            OutputDebugString(L"Can't save the edited chunks to the region files\n");
+        }
+    }
 
-            if (inputFile.fail())
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::Initialize
+      Summary:  Initializes the voxels, their material arrays, voxel
+                chunks, shaders, renderables, models, and skybox
+      Args:     RenderDevice* pDevice
+                  The render device to create the buffers
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Scene::Initialize(_In_ RenderDevice* pDevice)
+    {
+        for (auto voxel : m_voxels)
+        {
+            HRESULT hr = voxel->Initialize(pDevice);
+            if (FAILED(hr))
             {
-                if (inputFile.eof())
-                {
-                    break;
-                }
-                inputFile.clear();
-                inputFile >> trash;
+                return hr;
             }
-            else if (static_cast<CHAR>(eBlockType::GRASSLAND) <= voxelType && voxelType < static_cast<CHAR>(eBlockType::COUNT))
-            {
-                for (UINT heightIdx = 0; heightIdx < static_cast<UINT>(static_cast<float>(aDimension[1]) * height); ++heightIdx)
-                {
-                    aInstanceData[static_cast<size_t>(voxelType) - static_cast<size_t>(eBlockType::GRASSLAND)].push_back(
-                        InstanceData
-                        {
-                            .Transformation = XMMatrixTranslation(
-                                2.0f * (static_cast<FLOAT>(uWidthIdx) - static_cast<FLOAT>(aDimension[0]) / 2.0f),
-                                2.0f * (static_cast<FLOAT>(heightIdx) - static_cast<FLOAT>(aDimension[1])) + (static_cast<FLOAT>(aDimension[1]) * 0.75f),
-                                2.0f * (static_cast<FLOAT>(uDepthIdx) - static_cast<FLOAT>(aDimension[2]) / 2.0f)
-                                )
-                        }
-                    );
-                }
-                ++uWidthIdx;
-                if (uWidthIdx >= aDimension[0])
-                {
-                    uWidthIdx -= aDimension[0];
-                    ++uDepthIdx;
+        }
 
-                    if (uDepthIdx >= aDimension[2])
-                    {
-                        uDepthIdx -= aDimension[2];
-                    }
-                }
+        if (m_voxelMaterials)
+        {
+            HRESULT hr = m_voxelMaterials->Initialize(pDevice);
+            if (FAILED(hr))
+            {
+                return hr;
             }
         }
 
-        inputFile.close();
+        for (auto voxelChunk : m_voxelChunks)
+        {
+            HRESULT hr = voxelChunk->Initialize(pDevice);
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+        }
 
-        UINT uVoxelIdx = 0u;
-        auto it = m_voxels.begin();
-        while (it != m_voxels.end())
+        if (m_chunkStreamer)
         {
-            if (aInstanceData[uVoxelIdx].size() <= 0)
+            HRESULT hr = m_chunkStreamer->Initialize(pDevice);
+            if (FAILED(hr))
             {
-                it = m_voxels.erase(it);
+                return hr;
             }
-            else
+        }
+
+        // Every level is uploaded once, the selection only picks the chunks to draw
+        for (const std::vector<std::shared_ptr<VoxelChunk>>& aNodeChunks : m_aLodNodeChunks)
+        {
+            for (const std::shared_ptr<VoxelChunk>& voxelChunk : aNodeChunks)
             {
-                (*it)->SetInstanceData(std::move(aInstanceData[uVoxelIdx]));
-                ++it;
+                HRESULT hr = voxelChunk->Initialize(pDevice);
+                if (FAILED(hr))
+                {
+                    return hr;
+                }
             }
-            ++uVoxelIdx;
         }
-    }
 
-    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Scene::Initialize
-      Summary:  Initializes the voxels, shaders, renderables, models,
-                and skybox
-      Args:     ID3D11Device* pDevice
-                  The Direct3D device to create the buffers
-                ID3D11DeviceContext* pImmediateContext
-                  The Direct3D context to set buffers
-    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    HRESULT Scene::Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext)
-    {
-        for (auto voxel : m_voxels)
+        if (m_terrain)
         {
-            HRESULT hr = voxel->Initialize(pDevice, pImmediateContext);
+            HRESULT hr = m_terrain->Initialize(pDevice);
             if (FAILED(hr))
             {
                 return hr;
@@ -196,7 +356,7 @@ namespace library
 
         for (auto it = m_renderables.begin(); it != m_renderables.end(); ++it)
         {
-            HRESULT hr = it->second->Initialize(pDevice, pImmediateContext);
+            HRESULT hr = it->second->Initialize(pDevice);
             if (FAILED(hr))
             {
                 return hr;
@@ -205,7 +365,7 @@ namespace library
 
         for (auto it = m_models.begin(); it != m_models.end(); ++it)
         {
-            HRESULT hr = it->second->Initialize(pDevice, pImmediateContext);
+            HRESULT hr = it->second->Initialize(pDevice);
             if (FAILED(hr))
             {
                 return hr;
@@ -219,7 +379,7 @@ namespace library
 
         for (auto it = m_materials.begin(); it != m_materials.end(); ++it)
         {
-            HRESULT hr = it->second->Initialize(pDevice, pImmediateContext);
+            HRESULT hr = it->second->Initialize(pDevice);
             if (FAILED(hr))
             {
                 return hr;
@@ -228,7 +388,7 @@ namespace library
 
         if (m_skyBox)
         {
-            HRESULT hr = m_skyBox->Initialize(pDevice, pImmediateContext);
+            HRESULT hr = m_skyBox->Initialize(pDevice);
 
             if (FAILED(hr))
             {
@@ -433,6 +593,248 @@ namespace library
         m_skyBox->Update(deltaTime);
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::UpdateStreaming
+      Summary:  Streams the voxel chunks around the camera, does
+                nothing unless the voxels are streamed
+      Args:     const XMVECTOR& eye
+                  Position of the camera
+      Modifies: [m_chunkStreamer].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Scene::UpdateStreaming(_In_ const XMVECTOR& eye)
+    {
+        if (m_chunkStreamer)
+        {
+            m_chunkStreamer->Update(eye);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::UpdateLevelOfDetail
+      Summary:  Selects the levels of detail seen from the camera and
+                gathers their chunks, or the patches of the smooth
+                terrain, does nothing unless the voxels were built as
+                a level of detail tree or as a smooth terrain
+      Args:     const XMVECTOR& eye
+                  Position of the camera
+                FLOAT projectionScale
+                  Pixels covered by one world unit at a distance of one
+                  unit
+      Modifies: [m_lodTree, m_aLodNodeIndices, m_voxelChunks,
+                 m_terrain].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Scene::UpdateLevelOfDetail(_In_ const XMVECTOR& eye, _In_ FLOAT projectionScale)
+    {
+        // The terrain levels are set by distance, the morph ranges are fixed when it is built
+        if (m_terrain)
+        {
+            m_terrain->Select(eye);
+            return;
+        }
+
+        if (!m_lodTree)
+        {
+            return;
+        }
+
+        m_lodTree->Select(eye, projectionScale, m_aLodNodeIndices);
+        if (m_lodTree->GetStats().uNumChangedNodes == 0u && !m_voxelChunks.empty())
+        {
+            return;
+        }
+
+        m_voxelChunks.clear();
+        for (UINT uNodeIndex : m_aLodNodeIndices)
+        {
+            m_voxelChunks.insert(m_voxelChunks.end(), m_aLodNodeChunks[uNodeIndex].begin(), m_aLodNodeChunks[uNodeIndex].end());
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::UpdateOcclusion
+      Summary:  Culls the chunks hidden behind the terrain seen from
+                the camera and gathers the others, does nothing unless
+                the voxels were built as chunks or as a level of detail
+                tree. A node of the tree is kept when one of the chunks
+                it covers is
+      Args:     const XMVECTOR& eye
+                  Position of the camera
+      Modifies: [m_horizonCuller, m_aVisibleVoxelChunks].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Scene::UpdateOcclusion(_In_ const XMVECTOR& eye)
+    {
+        if (!m_horizonCuller)
+        {
+            return;
+        }
+
+        // The meshes only need the chunks, the columns are left untested
+        m_horizonCuller->Cull(eye, FALSE);
+
+        m_aVisibleVoxelChunks.clear();
+        if (m_lodTree)
+        {
+            for (UINT uNodeIndex : m_aLodNodeIndices)
+            {
+                const VoxelLodNode& node = m_lodTree->GetNode(uNodeIndex);
+                if (m_horizonCuller->IsTileVisible(VoxelHorizonCuller::CHUNK_LEVEL + node.uLevel, node.uNodeX, node.uNodeZ))
+                {
+                    m_aVisibleVoxelChunks.insert(m_aVisibleVoxelChunks.end(), m_aLodNodeChunks[uNodeIndex].begin(), m_aLodNodeChunks[uNodeIndex].end());
+                }
+            }
+            return;
+        }
+
+        for (const std::shared_ptr<VoxelChunk>& voxelChunk : m_voxelChunks)
+        {
+            if (m_horizonCuller->IsTileVisible(VoxelHorizonCuller::CHUNK_LEVEL, voxelChunk->GetChunkX(), voxelChunk->GetChunkZ()))
+            {
+                m_aVisibleVoxelChunks.push_back(voxelChunk);
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::SetBlock
+      Summary:  Sets the type of a block of the instanced voxels. The
+                instances are changed right away and uploaded by the
+                next FlushVoxelEdits, with the other edits of the frame
+      Args:     UINT x
+                  Index of the block along the x axis
+                UINT y
+                  Index of the block along the y axis
+                UINT z
+                  Index of the block along the z axis
+                CHAR blockType
+                  Type of the block, one that already has a voxel
+      Modifies: [m_voxelEditor, m_voxels].
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Scene::SetBlock(_In_ UINT x, _In_ UINT y, _In_ UINT z, _In_ CHAR blockType)
+    {
+        HRESULT hr = createVoxelEditor();
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        hr = m_voxelEditor->SetBlock(x, y, z, blockType);
+        if (SUCCEEDED(hr) && m_regionStore)
+        {
+            m_regionStore->MarkDirty(x / VoxelGrid::CHUNK_SIZE, z / VoxelGrid::CHUNK_SIZE);
+        }
+
+        return hr;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::ClearBlock
+      Summary:  Removes a block of the instanced voxels, uploaded by the
+                next FlushVoxelEdits
+      Args:     UINT x
+                  Index of the block along the x axis
+                UINT y
+                  Index of the block along the y axis
+                UINT z
+                  Index of the block along the z axis
+      Modifies: [m_voxelEditor, m_voxels].
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Scene::ClearBlock(_In_ UINT x, _In_ UINT y, _In_ UINT z)
+    {
+        HRESULT hr = createVoxelEditor();
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        hr = m_voxelEditor->ClearBlock(x, y, z);
+        if (SUCCEEDED(hr) && m_regionStore)
+        {
+            m_regionStore->MarkDirty(x / VoxelGrid::CHUNK_SIZE, z / VoxelGrid::CHUNK_SIZE);
+        }
+
+        return hr;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::FlushVoxelEdits
+      Summary:  Uploads the instances changed by the edits of the
+                frame, only their dirty ranges, and hands the edited
+                chunks of the frame to the region writer. Called once
+                per frame before the voxels are drawn
+      Args:     RenderDevice* pDevice
+                  The render device to upload the instances with
+      Modifies: [m_voxels, m_regionStore].
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Scene::FlushVoxelEdits(_In_ RenderDevice* pDevice)
+    {
+        if (!m_voxelEditor)
+        {
+            return S_OK;
+        }
+
+        for (const std::shared_ptr<Voxel>& voxel : m_voxels)
+        {
+            HRESULT hr = voxel->UpdateInstanceBuffer(pDevice);
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+        }
+
+        if (m_regionStore)
+        {
+            m_regionStore->QueueDirtyChunks(*m_voxelGrid);
+        }
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::Raycast
+      Summary:  Finds the first block along a ray, edits included
+      Args:     const VoxelRay& ray
+                  Ray in world space
+                VoxelRayHit& outHit
+                  Block, face normal and block type of the hit
+      Returns:  BOOL
+                  TRUE if the ray hits a block, FALSE without a grid
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL Scene::Raycast(_In_ const VoxelRay& ray, _Out_ VoxelRayHit& outHit) const
+    {
+        if (!m_voxelGrid)
+        {
+            outHit = VoxelRayHit{ .bHit = FALSE, .normal = XMINT3(0, 0, 0), .distance = ray.maxDistance };
+            return FALSE;
+        }
+
+        return m_voxelGrid->Raycast(ray, outHit);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::RaycastBatch
+      Summary:  Answers a batch of rays on all cores
+      Args:     const std::vector<VoxelRay>& aRays
+                  Rays in world space
+                std::vector<VoxelRayHit>& aOutHits
+                  First block along each ray, in the order of the rays
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Scene::RaycastBatch(_In_ const std::vector<VoxelRay>& aRays, _Out_ std::vector<VoxelRayHit>& aOutHits) const
+    {
+        if (!m_voxelGrid)
+        {
+            aOutHits.assign(aRays.size(), VoxelRayHit{ .bHit = FALSE, .normal = XMINT3(0, 0, 0), .distance = 0.0f });
+            return;
+        }
+
+        m_voxelGrid->RaycastBatch(aRays, aOutHits);
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Scene::GetVoxels
       Summary:  Returns the vector of voxels
@@ -444,6 +846,40 @@ namespace library
         return m_voxels;
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::GetVoxelChunks
+      Summary:  Returns the vector of voxel chunks, the resident ones
+                when they are streamed
+      Returns:  std::vector<std::shared_ptr<VoxelChunk>>&
+                  Voxel chunks
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    std::vector<std::shared_ptr<VoxelChunk>>& Scene::GetVoxelChunks()
+    {
+        if (m_chunkStreamer)
+        {
+            return m_chunkStreamer->GetResidentChunks();
+        }
+
+        return m_voxelChunks;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::GetVisibleVoxelChunks
+      Summary:  Returns the voxel chunks kept by the last occlusion
+                update, all of them when they are not culled
+      Returns:  std::vector<std::shared_ptr<VoxelChunk>>&
+                  Voxel chunks to draw
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    std::vector<std::shared_ptr<VoxelChunk>>& Scene::GetVisibleVoxelChunks()
+    {
+        if (m_horizonCuller)
+        {
+            return m_aVisibleVoxelChunks;
+        }
+
+        return GetVoxelChunks();
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Scene::GetRenderables
       Summary:  Returns the vector of renderables
@@ -519,6 +955,31 @@ namespace library
         return m_skyBox;
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::GetTerrain
+      Summary:  Returns the smooth terrain
+      Returns:  std::shared_ptr<Terrain>&
+                  Terrain, nullptr unless the height map was built as a
+                  smooth terrain
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    std::shared_ptr<Terrain>& Scene::GetTerrain()
+    {
+        return m_terrain;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::GetVoxelMaterials
+      Summary:  Returns the albedo and normal map arrays of the block
+                types
+      Returns:  VoxelMaterialArray*
+                  Material arrays, nullptr unless the voxels have
+                  compact instances, which all share one voxel
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    VoxelMaterialArray* Scene::GetVoxelMaterials()
+    {
+        return m_voxelMaterials.get();
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Scene::GetFilePath
       Summary:  Returns the file path to the height map
@@ -542,14 +1003,137 @@ namespace library
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Scene::SetVertexShaderOfRenderable
-      Summary:  Sets the vertex shader for a renderable
-      Args:     PCWSTR pszRenderableName
-                  Key of the renderable
-                PCWSTR pszVertexShaderName
-                  Key of the vertex shader
-      Modifies: [m_renderables].
-      Returns:  HRESULT
+      Method:   Scene::GetHeightMap
+      Summary:  Returns the height map the voxels are built from
+      Returns:  const HeightMap&
+                  Height map
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const HeightMap& Scene::GetHeightMap() const
+    {
+        return m_heightMap;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::GetVoxelBuildMode
+      Summary:  Returns how the voxels of the scene were built
+      Returns:  eVoxelBuildMode
+                  Build mode
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    eVoxelBuildMode Scene::GetVoxelBuildMode() const
+    {
+        return m_buildMode;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::GetInstanceFormat
+      Summary:  Returns the format of the voxel instances, MATRIX if
+                the map did not fit the compact or column format
+      Returns:  eInstanceFormat
+                  Instance format
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    eInstanceFormat Scene::GetInstanceFormat() const
+    {
+        return m_instanceFormat;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::GetInstanceStats
+      Summary:  Returns the number of instances kept and culled for
+                each block type, indexed from eBlockType::GRASSLAND.
+                Empty unless the voxels were built as instances
+      Returns:  const std::vector<VoxelInstanceStats>&
+                  Instance statistics
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const std::vector<VoxelInstanceStats>& Scene::GetInstanceStats() const
+    {
+        return m_aInstanceStats;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::GetStreamingStats
+      Summary:  Returns the state of the chunk streamer after the last
+                update
+      Returns:  const ChunkStreamingStats*
+                  Streaming statistics, nullptr unless the voxels are
+                  streamed
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const ChunkStreamingStats* Scene::GetStreamingStats() const
+    {
+        return m_chunkStreamer ? &m_chunkStreamer->GetStats() : nullptr;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::GetWaterStats
+      Summary:  Returns the water surface built in place of the water
+                blocks and the instances it replaced
+      Returns:  const VoxelWaterStats*
+                  Water statistics, nullptr unless the instanced
+                  voxels were built with a water surface
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const VoxelWaterStats* Scene::GetWaterStats() const
+    {
+        return m_bWaterSurface && (m_buildMode == eVoxelBuildMode::INSTANCED || m_buildMode == eVoxelBuildMode::INSTANCED_EXPOSED) ? &m_waterStats : nullptr;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::GetOcclusionStats
+      Summary:  Returns the chunks culled by the last occlusion update
+      Returns:  const VoxelHorizonStats*
+                  Occlusion statistics, nullptr unless the voxels were
+                  built as chunks or as a level of detail tree
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const VoxelHorizonStats* Scene::GetOcclusionStats() const
+    {
+        return m_horizonCuller ? &m_horizonCuller->GetStats() : nullptr;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::GetLevelOfDetailStats
+      Summary:  Returns the geometry selected per level of detail by
+                the last update
+      Returns:  const VoxelLodStats*
+                  Level of detail statistics, nullptr unless the voxels
+                  were built as a level of detail tree
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const VoxelLodStats* Scene::GetLevelOfDetailStats() const
+    {
+        return m_lodTree ? &m_lodTree->GetStats() : nullptr;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::GetTerrainStats
+      Summary:  Returns the patches of the smooth terrain selected by
+                the last update
+      Returns:  const TerrainLodStats*
+                  Terrain statistics, nullptr unless the height map was
+                  built as a smooth terrain
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const TerrainLodStats* Scene::GetTerrainStats() const
+    {
+        return m_terrain ? &m_terrain->GetLodTree().GetStats() : nullptr;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::GetVoxelGrid
+      Summary:  Returns the block grid
+      Returns:  const VoxelGrid*
+                  Block grid, nullptr for the streamed world or when
+                  the height map failed to load
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const VoxelGrid* Scene::GetVoxelGrid() const
+    {
+        return m_voxelGrid.get();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::SetVertexShaderOfRenderable
+      Summary:  Sets the vertex shader for a renderable
+      Args:     PCWSTR pszRenderableName
+                  Key of the renderable
+                PCWSTR pszVertexShaderName
+                  Key of the vertex shader
+      Modifies: [m_renderables].
+      Returns:  HRESULT
                   Status code
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     HRESULT Scene::SetVertexShaderOfRenderable(_In_ PCWSTR pszRenderableName, _In_ PCWSTR pszVertexShaderName)
@@ -700,38 +1284,615 @@ namespace library
         return S_OK;
     }
 
-    FLOAT Scene::getNoise2(UINT x, UINT y)
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::SetVertexShaderOfVoxelChunk
+      Summary:  Sets the vertex shader for the voxel chunks in a scene
+      Args:     PCWSTR pszVertexShaderName
+                  Key of the vertex shader
+      Modifies: [m_voxelChunks, m_chunkStreamer, m_aLodNodeChunks].
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Scene::SetVertexShaderOfVoxelChunk(_In_ PCWSTR pszVertexShaderName)
     {
-        UINT temp = ms_aHashes[y % 256u];
+        if (!m_vertexShaders.contains(pszVertexShaderName))
+        {
+            return E_FAIL;
+        }
+
+        for (std::shared_ptr<VoxelChunk>& voxelChunk : m_voxelChunks)
+        {
+            voxelChunk->SetVertexShader(m_vertexShaders[pszVertexShaderName]);
+        }
+
+        for (std::vector<std::shared_ptr<VoxelChunk>>& aNodeChunks : m_aLodNodeChunks)
+        {
+            for (std::shared_ptr<VoxelChunk>& voxelChunk : aNodeChunks)
+            {
+                voxelChunk->SetVertexShader(m_vertexShaders[pszVertexShaderName]);
+            }
+        }
+
+        if (m_chunkStreamer)
+        {
+            m_chunkStreamer->SetVertexShader(m_vertexShaders[pszVertexShaderName]);
+        }
 
-        return static_cast<FLOAT>(ms_aHashes[(temp + x) % 256u]);
+        return S_OK;
     }
 
-    FLOAT Scene::getNoise2d(FLOAT x, FLOAT y)
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::SetPixelShaderOfVoxelChunk
+      Summary:  Sets the pixel shader for the voxel chunks in a scene
+      Args:     PCWSTR pszPixelShaderName
+                  Key of the pixel shader
+      Modifies: [m_voxelChunks, m_chunkStreamer, m_aLodNodeChunks].
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Scene::SetPixelShaderOfVoxelChunk(_In_ PCWSTR pszPixelShaderName)
     {
-        UINT uX = static_cast<UINT>(x);
-        UINT uY = static_cast<UINT>(y);
-        FLOAT xFrac = x - static_cast<FLOAT>(uX);
-        FLOAT yFrac = y - static_cast<FLOAT>(uY);
+        if (!m_pixelShaders.contains(pszPixelShaderName))
+        {
+            return E_FAIL;
+        }
+
+        for (std::shared_ptr<VoxelChunk>& voxelChunk : m_voxelChunks)
+        {
+            voxelChunk->SetPixelShader(m_pixelShaders[pszPixelShaderName]);
+        }
 
-        UINT s = static_cast<UINT>(getNoise2(uX, uY));
-        UINT t = static_cast<UINT>(getNoise2(uX + 1u, uY));
-        UINT u = static_cast<UINT>(getNoise2(uX, uY + 1u));
-        UINT v = static_cast<UINT>(getNoise2(uX + 1u, uY + 1u));
+        for (std::vector<std::shared_ptr<VoxelChunk>>& aNodeChunks : m_aLodNodeChunks)
+        {
+            for (std::shared_ptr<VoxelChunk>& voxelChunk : aNodeChunks)
+            {
+                voxelChunk->SetPixelShader(m_pixelShaders[pszPixelShaderName]);
+            }
+        }
 
-        FLOAT low = smoothLerp(static_cast<FLOAT>(s), static_cast<FLOAT>(t), xFrac);
-        FLOAT high = smoothLerp(static_cast<FLOAT>(u), static_cast<FLOAT>(v), xFrac);
+        if (m_chunkStreamer)
+        {
+            m_chunkStreamer->SetPixelShader(m_pixelShaders[pszPixelShaderName]);
+        }
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::SetVertexShaderOfTerrain
+      Summary:  Sets the vertex shader for the smooth terrain
+      Args:     PCWSTR pszVertexShaderName
+                  Key of the vertex shader
+      Modifies: [m_terrain].
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Scene::SetVertexShaderOfTerrain(_In_ PCWSTR pszVertexShaderName)
+    {
+        if (!m_vertexShaders.contains(pszVertexShaderName))
+        {
+            return E_FAIL;
+        }
+
+        if (m_terrain)
+        {
+            m_terrain->SetVertexShader(m_vertexShaders[pszVertexShaderName]);
+        }
 
-        return smoothLerp(low, high, yFrac);
+        return S_OK;
     }
 
-    FLOAT Scene::lerp(FLOAT x, FLOAT y, FLOAT s)
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::SetPixelShaderOfTerrain
+      Summary:  Sets the pixel shader for the smooth terrain
+      Args:     PCWSTR pszPixelShaderName
+                  Key of the pixel shader
+      Modifies: [m_terrain].
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Scene::SetPixelShaderOfTerrain(_In_ PCWSTR pszPixelShaderName)
     {
-        return x + s * (y - x);
+        if (!m_pixelShaders.contains(pszPixelShaderName))
+        {
+            return E_FAIL;
+        }
+
+        if (m_terrain)
+        {
+            m_terrain->SetPixelShader(m_pixelShaders[pszPixelShaderName]);
+        }
+
+        return S_OK;
     }
 
-    FLOAT Scene::smoothLerp(FLOAT x, FLOAT y, FLOAT s)
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::buildInstances
+      Summary:  Creates one instanced voxel per block type, with one
+                instance per block of the height map, or only per
+                block with an exposed face in INSTANCED_EXPOSED.
+                COMPACT instances hold the grid cell and the voxel
+                world matrix moves the cell (0, 0, 0) to its place.
+                They also hold the block type, so all types share a
+                single voxel, drawn with the material arrays.
+                COLUMN emits a single instance per cell instead,
+                stretched over the same blocks. With a water surface,
+                the water cells get no instances and are meshed by
+                VoxelWaterMesher into a single chunk
+      Modifies: [m_voxels, m_voxelMaterials, m_voxelChunks,
+                 m_aInstanceStats, m_instanceFormat, m_waterStats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Scene::buildInstances()
     {
-        return lerp(x, y, s * s * (3.0f - 2.0f * s));
+        // Grid coordinates of the compact and column formats are 16-bit
+        if ((m_instanceFormat == eInstanceFormat::COMPACT || m_instanceFormat == eInstanceFormat::COLUMN) &&
+            (m_heightMap.GetWidth() > USHRT_MAX || m_heightMap.GetHeight() > USHRT_MAX || m_heightMap.GetDepth() > USHRT_MAX))
+        {
+            OutputDebugString(L"Height map is too large for compact instances, using matrices\n");
+            m_instanceFormat = eInstanceFormat::MATRIX;
+        }
+        BOOL bCompact = m_instanceFormat == eInstanceFormat::COMPACT;
+        BOOL bColumns = m_instanceFormat == eInstanceFormat::COLUMN;
+
+        if (bCompact)
+        {
+            m_voxels.push_back(std::make_shared<Voxel>(XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f)));
+            m_voxelMaterials = std::make_unique<VoxelMaterialArray>(m_heightMap.GetPalette());
+        }
+        else
+        {
+            for (const XMFLOAT4& color : m_heightMap.GetPalette())
+            {
+                m_voxels.push_back(std::make_shared<Voxel>(color));
+            }
+        }
+
+        // Only blocks with an exposed face are emitted in INSTANCED_EXPOSED, the ones below are fully enclosed
+        BOOL bExposedOnly = m_buildMode == eVoxelBuildMode::INSTANCED_EXPOSED;
+
+        // Count the blocks of each type first so that every array is allocated once
+        m_aInstanceStats.assign(m_heightMap.GetPalette().size(), VoxelInstanceStats{ .uNumKept = 0u, .uNumCulled = 0u });
+        std::vector<size_t> auNumColumns(m_heightMap.GetPalette().size(), 0u);
+        for (UINT uDepthIdx = 0u; uDepthIdx < m_heightMap.GetDepth(); ++uDepthIdx)
+        {
+            for (UINT uWidthIdx = 0u; uWidthIdx < m_heightMap.GetWidth(); ++uWidthIdx)
+            {
+                size_t uVoxelIdx = static_cast<size_t>(m_heightMap.GetBlockType(uWidthIdx, uDepthIdx)) - static_cast<size_t>(eBlockType::GRASSLAND);
+                if (m_heightMap.GetBlockType(uWidthIdx, uDepthIdx) != HeightMap::EMPTY_BLOCK && uVoxelIdx < m_aInstanceStats.size())
+                {
+                    UINT uColumnHeight = m_heightMap.GetColumnHeight(uWidthIdx, uDepthIdx);
+                    UINT uFirstHeight = bExposedOnly ? m_heightMap.GetExposedHeight(uWidthIdx, uDepthIdx) : 0u;
+                    if (m_bWaterSurface && VoxelWaterMesher::IsWater(m_heightMap.GetBlockType(uWidthIdx, uDepthIdx)))
+                    {
+                        uFirstHeight = uColumnHeight;
+                    }
+
+                    m_aInstanceStats[uVoxelIdx].uNumKept += uColumnHeight - uFirstHeight;
+                    m_aInstanceStats[uVoxelIdx].uNumCulled += uFirstHeight;
+                    auNumColumns[uVoxelIdx] += uColumnHeight > uFirstHeight ? 1u : 0u;
+                }
+            }
+        }
+
+        std::vector<std::vector<InstanceData>> aInstanceData(m_voxels.size());
+        std::vector<std::vector<CompactInstanceData>> aCompactInstanceData(m_voxels.size());
+        std::vector<std::vector<ColumnInstanceData>> aColumnInstanceData(m_voxels.size());
+        for (size_t uVoxelIdx = 0u; uVoxelIdx < aInstanceData.size(); ++uVoxelIdx)
+        {
+            if (bColumns)
+            {
+                aColumnInstanceData[uVoxelIdx].reserve(auNumColumns[uVoxelIdx]);
+            }
+            else if (bCompact)
+            {
+                UINT64 uNumKept = 0u;
+                for (const VoxelInstanceStats& stats : m_aInstanceStats)
+                {
+                    uNumKept += stats.uNumKept;
+                }
+                aCompactInstanceData[uVoxelIdx].reserve(static_cast<size_t>(uNumKept));
+            }
+            else
+            {
+                aInstanceData[uVoxelIdx].reserve(static_cast<size_t>(m_aInstanceStats[uVoxelIdx].uNumKept));
+            }
+        }
+
+        const FLOAT width = static_cast<FLOAT>(m_heightMap.GetWidth());
+        const FLOAT height = static_cast<FLOAT>(m_heightMap.GetHeight());
+        const FLOAT depth = static_cast<FLOAT>(m_heightMap.GetDepth());
+        for (UINT uDepthIdx = 0u; uDepthIdx < m_heightMap.GetDepth(); ++uDepthIdx)
+        {
+            for (UINT uWidthIdx = 0u; uWidthIdx < m_heightMap.GetWidth(); ++uWidthIdx)
+            {
+                CHAR voxelType = m_heightMap.GetBlockType(uWidthIdx, uDepthIdx);
+                size_t uTypeIdx = static_cast<size_t>(voxelType) - static_cast<size_t>(eBlockType::GRASSLAND);
+                if (voxelType == HeightMap::EMPTY_BLOCK || uTypeIdx >= m_aInstanceStats.size())
+                {
+                    continue;
+                }
+                size_t uVoxelIdx = bCompact ? 0u : uTypeIdx;
+
+                UINT uColumnHeight = m_heightMap.GetColumnHeight(uWidthIdx, uDepthIdx);
+                UINT uFirstHeight = bExposedOnly ? m_heightMap.GetExposedHeight(uWidthIdx, uDepthIdx) : 0u;
+                if (m_bWaterSurface && VoxelWaterMesher::IsWater(voxelType))
+                {
+                    uFirstHeight = uColumnHeight;
+                }
+
+                if (bColumns)
+                {
+                    if (uColumnHeight > uFirstHeight)
+                    {
+                        aColumnInstanceData[uVoxelIdx].push_back(
+                            ColumnInstanceData
+                            {
+                                .X = static_cast<USHORT>(uWidthIdx),
+                                .BaseY = static_cast<USHORT>(uFirstHeight),
+                                .Z = static_cast<USHORT>(uDepthIdx),
+                                .TopY = static_cast<USHORT>(uColumnHeight)
+                            }
+                        );
+                    }
+                    continue;
+                }
+
+                for (UINT heightIdx = uFirstHeight; heightIdx < uColumnHeight; ++heightIdx)
+                {
+                    if (bCompact)
+                    {
+                        aCompactInstanceData[uVoxelIdx].push_back(
+                            CompactInstanceData
+                            {
+                                .X = static_cast<USHORT>(uWidthIdx),
+                                .Y = static_cast<USHORT>(heightIdx),
+                                .Z = static_cast<USHORT>(uDepthIdx),
+                                .BlockType = static_cast<USHORT>(voxelType)
+                            }
+                        );
+                        continue;
+                    }
+
+                    aInstanceData[uVoxelIdx].push_back(
+                        InstanceData
+                        {
+                            .Transformation = XMMatrixTranslation(
+                                2.0f * (static_cast<FLOAT>(uWidthIdx) - width / 2.0f),
+                                2.0f * (static_cast<FLOAT>(heightIdx) - height) + (height * 0.75f),
+                                2.0f * (static_cast<FLOAT>(uDepthIdx) - depth / 2.0f)
+                                )
+                        }
+                    );
+                }
+            }
+        }
+
+        UINT uVoxelIdx = 0u;
+        auto it = m_voxels.begin();
+        while (it != m_voxels.end())
+        {
+            if (aInstanceData[uVoxelIdx].size() + aCompactInstanceData[uVoxelIdx].size() + aColumnInstanceData[uVoxelIdx].size() <= 0)
+            {
+                it = m_voxels.erase(it);
+            }
+            else if (bColumns)
+            {
+                // The column of the cell (0, 0, 0) starts where the compact block of that cell is
+                (*it)->SetColumnInstanceData(std::move(aColumnInstanceData[uVoxelIdx]));
+                (*it)->Translate(XMVectorSet(-width, -2.0f * height + height * 0.75f, -depth, 0.0f));
+                ++it;
+            }
+            else if (bCompact)
+            {
+                // Same placement as the matrices: 2 * (x - width / 2), 2 * (y - height) + height * 0.75, 2 * (z - depth / 2)
+                (*it)->SetCompactInstanceData(std::move(aCompactInstanceData[uVoxelIdx]));
+                (*it)->Translate(XMVectorSet(-width, -2.0f * height + height * 0.75f, -depth, 0.0f));
+                ++it;
+            }
+            else
+            {
+                (*it)->SetInstanceData(std::move(aInstanceData[uVoxelIdx]));
+                ++it;
+            }
+            ++uVoxelIdx;
+        }
+
+        WCHAR szMessage[256];
+        if (m_bWaterSurface)
+        {
+            VoxelChunkMesh waterMesh;
+            VoxelWaterMesher(m_heightMap, m_voxelGrid->GetOrigin()).Mesh(waterMesh, m_waterStats);
+            if (!waterMesh.aVertices.empty())
+            {
+                m_voxelChunks.push_back(std::make_shared<VoxelChunk>(std::move(waterMesh), m_heightMap.GetPalette()));
+            }
+
+            // A replaced instance was a 12-triangle cube
+            UINT64 uNumReplaced = bExposedOnly ? m_waterStats.uNumExposedBlocks : m_waterStats.uNumBlocks;
+            if (bColumns)
+            {
+                uNumReplaced = m_waterStats.uNumColumns;
+            }
+            swprintf_s(
+                szMessage,
+                L"Water surface: %llu cells in %llu regions, %llu quads (%llu triangles) replace %llu instances (%llu triangles)\n",
+                m_waterStats.uNumCells,
+                m_waterStats.uNumRegions,
+                m_waterStats.uNumQuads,
+                m_waterStats.uNumQuads * 2u,
+                uNumReplaced,
+                uNumReplaced * 12u
+            );
+            OutputDebugString(szMessage);
+        }
+
+        for (size_t uTypeIdx = 0u; uTypeIdx < m_aInstanceStats.size(); ++uTypeIdx)
+        {
+            if (m_aInstanceStats[uTypeIdx].uNumKept + m_aInstanceStats[uTypeIdx].uNumCulled > 0u)
+            {
+                swprintf_s(
+                    szMessage,
+                    L"Block type %d: %llu instances kept, %llu culled\n",
+                    static_cast<INT>(eBlockType::GRASSLAND) + static_cast<INT>(uTypeIdx),
+                    m_aInstanceStats[uTypeIdx].uNumKept,
+                    m_aInstanceStats[uTypeIdx].uNumCulled
+                );
+                OutputDebugString(szMessage);
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::buildChunks
+      Summary:  Bakes the sky light of the voxel grid, then meshes it
+                into chunks with the greedy mesher, every vertex shaded
+                with the baked light and its ambient occlusion, and
+                creates one renderable per non-empty chunk. The chunks
+                hidden behind the terrain are culled by the heights of
+                the grid
+      Modifies: [m_lightMap, m_voxelChunks, m_horizonCuller].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Scene::buildChunks()
+    {
+        LARGE_INTEGER frequency;
+        LARGE_INTEGER start;
+        LARGE_INTEGER end;
+        QueryPerformanceFrequency(&frequency);
+        QueryPerformanceCounter(&start);
+
+        m_lightMap = std::make_unique<VoxelLightMap>(*m_voxelGrid);
+        VoxelLightUpdate lightUpdate = m_lightMap->Bake();
+
+        QueryPerformanceCounter(&end);
+
+        WCHAR szLightMessage[256];
+        swprintf_s(
+            szLightMessage,
+            L"Voxel light: %llu lit cells baked in %.3f ms, %.1f MB\n",
+            lightUpdate.uNumChangedCells,
+            static_cast<DOUBLE>(end.QuadPart - start.QuadPart) * 1000.0 / static_cast<DOUBLE>(frequency.QuadPart),
+            static_cast<DOUBLE>(m_lightMap->GetMemoryUsage()) / (1024.0 * 1024.0)
+        );
+        OutputDebugString(szLightMessage);
+
+        VoxelChunkMesher mesher(*m_voxelGrid, eVoxelMeshing::GREEDY, *m_lightMap);
+
+        std::vector<VoxelChunkMesh> aMeshes;
+        mesher.MeshAll(aMeshes);
+
+        VoxelMeshStats stats = mesher.GetStats(aMeshes);
+
+        WCHAR szMessage[256];
+        swprintf_s(
+            szMessage,
+            L"Voxel chunks: %llu blocks, %llu chunks, %llu vertices (instanced %llu), %llu triangles (instanced %llu), %llu draws (instanced %llu)\n",
+            stats.uNumBlocks, stats.uNumChunks,
+            stats.uNumVertices, stats.uNumInstancedVertices,
+            stats.uNumTriangles, stats.uNumInstancedTriangles,
+            stats.uNumDraws, stats.uNumInstancedDraws
+        );
+        OutputDebugString(szMessage);
+
+        m_voxelChunks.reserve(aMeshes.size());
+        for (VoxelChunkMesh& mesh : aMeshes)
+        {
+            m_voxelChunks.push_back(std::make_shared<VoxelChunk>(std::move(mesh), m_voxelGrid->GetPalette()));
+        }
+
+        m_horizonCuller = std::make_unique<VoxelHorizonCuller>(*m_voxelGrid);
+        m_horizonCuller->Build();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::buildGridInstances
+      Summary:  Creates the voxel instances of every block of the grid,
+                or of every exposed block, for grids that are not built
+                from a height map. The editor that built them is kept,
+                so the blocks can be edited right away
+      Modifies: [m_voxelEditor, m_voxels, m_voxelMaterials,
+                 m_aInstanceStats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Scene::buildGridInstances()
+    {
+        if (m_instanceFormat == eInstanceFormat::COMPACT &&
+            (m_voxelGrid->GetWidth() > USHRT_MAX || m_voxelGrid->GetHeight() > USHRT_MAX || m_voxelGrid->GetDepth() > USHRT_MAX))
+        {
+            OutputDebugString(L"Voxel grid is too large for compact instances, using matrices\n");
+            m_instanceFormat = eInstanceFormat::MATRIX;
+        }
+
+        m_voxelEditor = std::make_unique<VoxelEditor>(*m_voxelGrid, m_instanceFormat, m_buildMode == eVoxelBuildMode::INSTANCED_EXPOSED);
+        m_voxelEditor->Build(m_voxels, m_aInstanceStats);
+        if (m_instanceFormat == eInstanceFormat::COMPACT)
+        {
+            m_voxelMaterials = std::make_unique<VoxelMaterialArray>(m_voxelGrid->GetPalette());
+        }
+
+        size_t uNumInstances = 0u;
+        for (const std::shared_ptr<Voxel>& voxel : m_voxels)
+        {
+            uNumInstances += voxel->GetNumInstances();
+        }
+
+        WCHAR szMessage[256];
+        swprintf_s(szMessage, L"Voxel instances: %llu instances of %llu block types\n", static_cast<UINT64>(uNumInstances), static_cast<UINT64>(m_voxels.size()));
+        OutputDebugString(szMessage);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::buildLevelsOfDetail
+      Summary:  Builds the level of detail tree of the height map and
+                one chunk per mesh of every node. The chunks to draw
+                are picked by UpdateLevelOfDetail, then culled by
+                UpdateOcclusion
+      Modifies: [m_lodTree, m_aLodNodeChunks, m_horizonCuller].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Scene::buildLevelsOfDetail()
+    {
+        m_lodTree = std::make_unique<VoxelLodTree>(m_heightMap, eVoxelMeshing::GREEDY, LOD_MAX_SCREEN_ERROR);
+        m_lodTree->Build();
+
+        m_horizonCuller = std::make_unique<VoxelHorizonCuller>(*m_voxelGrid);
+        m_horizonCuller->Build();
+
+        UINT64 auNumTriangles[NUM_VOXEL_LOD_LEVELS] = { 0u, };
+        m_aLodNodeChunks.resize(m_lodTree->GetNumNodes());
+        for (UINT uNodeIndex = 0u; uNodeIndex < m_lodTree->GetNumNodes(); ++uNodeIndex)
+        {
+            VoxelLodNode& node = m_lodTree->GetNode(uNodeIndex);
+            auNumTriangles[node.uLevel] += node.uNumTriangles;
+
+            // The tree keeps the counts of the node, the meshes move to the chunks
+            for (VoxelChunkMesh& mesh : node.aMeshes)
+            {
+                m_aLodNodeChunks[uNodeIndex].push_back(std::make_shared<VoxelChunk>(std::move(mesh), m_heightMap.GetPalette()));
+            }
+            node.aMeshes.clear();
+        }
+
+        WCHAR szMessage[256];
+        swprintf_s(
+            szMessage,
+            L"Voxel LOD: %u nodes, %llu / %llu / %llu / %llu triangles at 1x / 2x / 4x / 8x\n",
+            m_lodTree->GetNumNodes(), auNumTriangles[0], auNumTriangles[1], auNumTriangles[2], auNumTriangles[3]
+        );
+        OutputDebugString(szMessage);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::buildTerrain
+      Summary:  Builds the smooth terrain of the height map, the
+                patches to draw are picked by UpdateLevelOfDetail
+      Modifies: [m_terrain].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Scene::buildTerrain()
+    {
+        m_terrain = std::make_shared<Terrain>(m_heightMap, TERRAIN_DETAIL_DISTANCE);
+
+        WCHAR szMessage[256];
+        swprintf_s(szMessage, L"Smooth terrain: %u levels of %u-triangle patches\n", m_terrain->GetLodTree().GetNumLevels(), TerrainLodTree::PATCH_TRIANGLES);
+        OutputDebugString(szMessage);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::createVoxelEditor
+      Summary:  Creates the editor of the instanced voxels on the first
+                edit, its instance index is only kept by scenes that
+                edit
+      Modifies: [m_voxelEditor].
+      Returns:  HRESULT
+                  Status code, E_NOTIMPL unless the voxels are instanced
+                  one block per instance, without a water surface
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Scene::createVoxelEditor()
+    {
+        if (m_voxelEditor)
+        {
+            return S_OK;
+        }
+
+        // A column instance covers several blocks, editing one block would split it, and the water surface is not rebuilt
+        if (!m_voxelGrid || (m_buildMode != eVoxelBuildMode::INSTANCED && m_buildMode != eVoxelBuildMode::INSTANCED_EXPOSED) ||
+            m_instanceFormat == eInstanceFormat::COLUMN || m_bWaterSurface)
+        {
+            return E_NOTIMPL;
+        }
+
+        std::unique_ptr<VoxelEditor> voxelEditor = std::make_unique<VoxelEditor>(*m_voxelGrid, m_instanceFormat, m_buildMode == eVoxelBuildMode::INSTANCED_EXPOSED);
+        HRESULT hr = voxelEditor->Attach(m_voxels);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        m_voxelEditor = std::move(voxelEditor);
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::openRegionStore
+      Summary:  Opens the region files of the directory and replaces
+                the chunks of the grid by the saved ones. Only the
+                builds the editor can change are saved
+      Args:     const std::filesystem::path& regionDirectory
+                  Directory of the region files, none when empty
+      Modifies: [m_regionStore, m_voxelGrid].
+      Returns:  UINT
+                  Number of chunks loaded
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT Scene::openRegionStore(_In_ const std::filesystem::path& regionDirectory)
+    {
+        if (regionDirectory.empty() || !m_voxelGrid)
+        {
+            return 0u;
+        }
+
+        if ((m_buildMode != eVoxelBuildMode::INSTANCED && m_buildMode != eVoxelBuildMode::INSTANCED_EXPOSED) ||
+            m_instanceFormat == eInstanceFormat::COLUMN || m_bWaterSurface)
+        {
+            OutputDebugString(L"Region files: only editable instanced builds are saved\n");
+            return 0u;
+        }
+
+        LARGE_INTEGER frequency;
+        LARGE_INTEGER start;
+        LARGE_INTEGER end;
+        QueryPerformanceFrequency(&frequency);
+        QueryPerformanceCounter(&start);
+
+        std::unique_ptr<VoxelRegionStore> regionStore = std::make_unique<VoxelRegionStore>(regionDirectory, m_voxelGrid->GetHeight(), REGION_BYTES_PER_FRAME);
+        HRESULT hr = regionStore->Initialize();
+        if (FAILED(hr))
+        {
+            OutputDebugString(L"Can't create the region directory \"");
+            OutputDebugString(regionDirectory.c_str());
+            OutputDebugString(L"\"\n");
+            return 0u;
+        }
+
+        // Region files of another grid height are refused, the chunks loaded before are kept
+        UINT uNumLoadedChunks = 0u;
+        hr = regionStore->LoadGrid(*m_voxelGrid, &uNumLoadedChunks);
+        if (FAILED(hr))
+        {
+            OutputDebugString(L"Can't load the region files, the edits are not saved\n");
+            return uNumLoadedChunks;
+        }
+
+        QueryPerformanceCounter(&end);
+
+        WCHAR szMessage[256];
+        swprintf_s(
+            szMessage,
+            L"Region files: %u chunks loaded in %.3f ms\n",
+            uNumLoadedChunks,
+            static_cast<DOUBLE>(end.QuadPart - start.QuadPart) * 1000.0 / static_cast<DOUBLE>(frequency.QuadPart)
+        );
+        OutputDebugString(szMessage);
+
+        m_regionStore = std::move(regionStore);
+
+        return uNumLoadedChunks;
     }
 }
\ No newline at end of file
@@ -10,30 +10,52 @@
 
 #include "Common.h"
 
-#include <fstream>
-
 #include "Model/Model.h"
 #include "Light/PointLight.h"
 #include "Renderer/Skybox.h"
 #include "Renderer/Renderable.h"
+#include "Scene/DensityGenerator.h"
+#include "Scene/HeightMap.h"
+#include "Scene/PerlinNoise.h"
+#include "Scene/Terrain.h"
 #include "Scene/Voxel.h"
+#include "Scene/VoxelChunk.h"
+#include "Scene/VoxelChunkStreamer.h"
+#include "Scene/VoxelEditor.h"
+#include "Scene/VoxelGrid.h"
+#include "Scene/VoxelHorizonCuller.h"
+#include "Scene/VoxelLodTree.h"
+#include "Scene/VoxelRegionStore.h"
+#include "Scene/VoxelWaterMesher.h"
+#include "Texture/VoxelMaterialArray.h"
 
 namespace library
 {
+    enum class eVoxelBuildMode
+    {
+        INSTANCED,
+        INSTANCED_EXPOSED,
+        CHUNKED,
+        STREAMED,
+        LOD,
+        SMOOTH,
+    };
+
     class Scene
     {
     public:
         static FLOAT GetPerlin2d(FLOAT x, FLOAT y, FLOAT frequency, UINT uDepth);
 
         Scene() = delete;
-        Scene(const std::filesystem::path& filePath);
+        Scene(const std::filesystem::path& filePath, eVoxelBuildMode buildMode = eVoxelBuildMode::INSTANCED, eInstanceFormat instanceFormat = eInstanceFormat::MATRIX, BOOL bWaterSurface = FALSE, const std::filesystem::path& regionDirectory = std::filesystem::path());
+        Scene(const DensityDesc& densityDesc, eVoxelBuildMode buildMode = eVoxelBuildMode::CHUNKED, eInstanceFormat instanceFormat = eInstanceFormat::MATRIX, const std::filesystem::path& regionDirectory = std::filesystem::path());
         Scene(const Scene& other) = delete;
         Scene(Scene&& other) = delete;
         Scene& operator=(const Scene& other) = delete;
         Scene& operator=(Scene&& other) = delete;
-        virtual ~Scene() = default;
+        virtual ~Scene();
 
-        virtual HRESULT Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext);
+        virtual HRESULT Initialize(_In_ RenderDevice* pDevice);
 
         HRESULT AddVoxel(_In_ const std::shared_ptr<Voxel>& voxel);
         HRESULT AddRenderable(_In_ PCWSTR pszRenderableName, _In_ const std::shared_ptr<Renderable>& renderable);
@@ -45,8 +67,20 @@ namespace library
         HRESULT AddSkyBox(_In_ const std::shared_ptr<Skybox>& skybox);
 
         void Update(_In_ FLOAT deltaTime);
+        void UpdateStreaming(_In_ const XMVECTOR& eye);
+        void UpdateLevelOfDetail(_In_ const XMVECTOR& eye, _In_ FLOAT projectionScale);
+        void UpdateOcclusion(_In_ const XMVECTOR& eye);
+
+        HRESULT SetBlock(_In_ UINT x, _In_ UINT y, _In_ UINT z, _In_ CHAR blockType);
+        HRESULT ClearBlock(_In_ UINT x, _In_ UINT y, _In_ UINT z);
+        HRESULT FlushVoxelEdits(_In_ RenderDevice* pDevice);
+
+        BOOL Raycast(_In_ const VoxelRay& ray, _Out_ VoxelRayHit& outHit) const;
+        void RaycastBatch(_In_ const std::vector<VoxelRay>& aRays, _Out_ std::vector<VoxelRayHit>& aOutHits) const;
 
         std::vector<std::shared_ptr<Voxel>>& GetVoxels();
+        std::vector<std::shared_ptr<VoxelChunk>>& GetVoxelChunks();
+        std::vector<std::shared_ptr<VoxelChunk>>& GetVisibleVoxelChunks();
         std::unordered_map<std::wstring, std::shared_ptr<Renderable>>& GetRenderables();
         std::unordered_map<std::wstring, std::shared_ptr<Model>>& GetModels();
         std::shared_ptr<PointLight>& GetPointLight(_In_ size_t index);
@@ -54,9 +88,21 @@ namespace library
         std::unordered_map<std::wstring, std::shared_ptr<PixelShader>>& GetPixelShaders();
         std::unordered_map<std::wstring, std::shared_ptr<Material>>& GetMaterials();
         std::shared_ptr<Skybox>& GetSkyBox();
+        std::shared_ptr<Terrain>& GetTerrain();
+        VoxelMaterialArray* GetVoxelMaterials();
 
         const std::filesystem::path& GetFilePath() const;
         PCWSTR GetFileName() const;
+        const HeightMap& GetHeightMap() const;
+        eVoxelBuildMode GetVoxelBuildMode() const;
+        eInstanceFormat GetInstanceFormat() const;
+        const std::vector<VoxelInstanceStats>& GetInstanceStats() const;
+        const ChunkStreamingStats* GetStreamingStats() const;
+        const VoxelLodStats* GetLevelOfDetailStats() const;
+        const VoxelWaterStats* GetWaterStats() const;
+        const VoxelHorizonStats* GetOcclusionStats() const;
+        const TerrainLodStats* GetTerrainStats() const;
+        const VoxelGrid* GetVoxelGrid() const;
 
         HRESULT SetVertexShaderOfRenderable(_In_ PCWSTR pszRenderableName, _In_ PCWSTR pszVertexShaderName);
         HRESULT SetPixelShaderOfRenderable(_In_ PCWSTR pszRenderableName, _In_ PCWSTR pszPixelShaderName);
@@ -68,32 +114,43 @@ namespace library
         HRESULT SetPixelShaderOfVoxel(_In_ PCWSTR pszPixelShaderName);
         HRESULT SetMaterialOfVoxel(_In_ PCWSTR pszMaterialName);
 
-    private:
-        static FLOAT getNoise2(UINT x, UINT y);
-        static FLOAT getNoise2d(FLOAT x, FLOAT y);
-        static FLOAT lerp(FLOAT x, FLOAT y, FLOAT s);
-        static FLOAT smoothLerp(FLOAT x, FLOAT y, FLOAT s);
+        HRESULT SetVertexShaderOfVoxelChunk(_In_ PCWSTR pszVertexShaderName);
+        HRESULT SetPixelShaderOfVoxelChunk(_In_ PCWSTR pszPixelShaderName);
+
+        HRESULT SetVertexShaderOfTerrain(_In_ PCWSTR pszVertexShaderName);
+        HRESULT SetPixelShaderOfTerrain(_In_ PCWSTR pszPixelShaderName);
 
     private:
-        static constexpr const UINT ms_aHashes[] =
-        {
-            208,34,231,213,32,248,233,56,161,78,24,140,71,48,140,254,245,255,247,247,40,
-            185,248,251,245,28,124,204,204,76,36,1,107,28,234,163,202,224,245,128,167,204,
-            9,92,217,54,239,174,173,102,193,189,190,121,100,108,167,44,43,77,180,204,8,81,
-            70,223,11,38,24,254,210,210,177,32,81,195,243,125,8,169,112,32,97,53,195,13,
-            203,9,47,104,125,117,114,124,165,203,181,235,193,206,70,180,174,0,167,181,41,
-            164,30,116,127,198,245,146,87,224,149,206,57,4,192,210,65,210,129,240,178,105,
-            228,108,245,148,140,40,35,195,38,58,65,207,215,253,65,85,208,76,62,3,237,55,89,
-            232,50,217,64,244,157,199,121,252,90,17,212,203,149,152,140,187,234,177,73,174,
-            193,100,192,143,97,53,145,135,19,103,13,90,135,151,199,91,239,247,33,39,145,
-            101,120,99,3,186,86,99,41,237,203,111,79,220,135,158,42,30,154,120,67,87,167,
-            135,176,183,191,253,115,184,21,233,58,129,233,142,39,128,211,118,137,139,255,
-            114,20,218,113,154,27,127,246,250,1,8,198,250,209,92,222,173,21,88,102,219
-        };
+        void buildInstances();
+        void buildChunks();
+        void buildGridInstances();
+        void buildLevelsOfDetail();
+        void buildTerrain();
+        HRESULT createVoxelEditor();
+        UINT openRegionStore(_In_ const std::filesystem::path& regionDirectory);
 
     private:
         std::filesystem::path m_filePath;
+        HeightMap m_heightMap;
+        eVoxelBuildMode m_buildMode;
+        eInstanceFormat m_instanceFormat;
         std::vector<std::shared_ptr<Voxel>> m_voxels;
+        std::vector<std::shared_ptr<VoxelChunk>> m_voxelChunks;
+        std::unique_ptr<VoxelChunkStreamer> m_chunkStreamer;
+        std::unique_ptr<VoxelLodTree> m_lodTree;
+        std::vector<std::vector<std::shared_ptr<VoxelChunk>>> m_aLodNodeChunks;
+        std::vector<UINT> m_aLodNodeIndices;
+        std::shared_ptr<Terrain> m_terrain;
+        std::unique_ptr<VoxelGrid> m_voxelGrid;
+        std::unique_ptr<VoxelEditor> m_voxelEditor;
+        std::unique_ptr<VoxelMaterialArray> m_voxelMaterials;
+        std::unique_ptr<VoxelRegionStore> m_regionStore;
+        std::unique_ptr<VoxelLightMap> m_lightMap;
+        std::unique_ptr<VoxelHorizonCuller> m_horizonCuller;
+        std::vector<std::shared_ptr<VoxelChunk>> m_aVisibleVoxelChunks;
+        std::vector<VoxelInstanceStats> m_aInstanceStats;
+        BOOL m_bWaterSurface;
+        VoxelWaterStats m_waterStats;
         std::unordered_map<std::wstring, std::shared_ptr<Renderable>> m_renderables;
         std::unordered_map<std::wstring, std::shared_ptr<Model>> m_models;
         std::shared_ptr<PointLight> m_aPointLights[NUM_LIGHTS];
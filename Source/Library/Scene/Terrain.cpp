@@ -0,0 +1,318 @@
+#include "Scene/Terrain.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Terrain::Terrain
+      Summary:  Constructor. Builds the level of detail tree of the
+                height map and the grid of the patches
+      Args:     const HeightMap& heightMap
+                  Height map, must outlive the terrain
+                FLOAT detailDistance
+                  Distance the full detail is drawn within, in world
+                  units
+      Modifies: [m_heightMap, m_lodTree, m_aVertices, m_aIndices,
+                 m_aPatches, m_cbTerrain, m_heightView, m_colorView].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    Terrain::Terrain(_In_ const HeightMap& heightMap, _In_ FLOAT detailDistance)
+        : Renderable(XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f))
+        , m_heightMap(heightMap)
+        , m_lodTree(heightMap, detailDistance)
+        , m_aVertices()
+        , m_aIndices()
+        , m_aPatches()
+        , m_cbTerrain()
+        , m_heightView()
+        , m_colorView()
+    {
+        m_lodTree.Build();
+        TerrainLodTree::BuildPatchMesh(m_aVertices, m_aIndices);
+
+        // The morph ranges are set once the tree is built and never change
+        m_lodTree.GetShaderConstants(m_cbTerrain);
+
+        BasicMeshEntry basicMeshEntry;
+        basicMeshEntry.uNumIndices = static_cast<UINT>(m_aIndices.size());
+        m_aMeshes.push_back(basicMeshEntry);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Terrain::Initialize
+      Summary:  Creates the grid vertex and index buffers and the
+                height and color textures of the map
+      Args:     RenderDevice* pDevice
+                  The render device to create the buffers
+      Modifies: [m_vertexBuffer, m_indexBuffer, m_heightView,
+                 m_colorView].
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Terrain::Initialize(_In_ RenderDevice* pDevice)
+    {
+        D3D11_BUFFER_DESC bd =
+        {
+            .ByteWidth = static_cast<UINT>(sizeof(SimpleVertex) * m_aVertices.size()),
+            .Usage = D3D11_USAGE_IMMUTABLE,
+            .BindFlags = D3D11_BIND_VERTEX_BUFFER,
+            .CPUAccessFlags = 0u
+        };
+        D3D11_SUBRESOURCE_DATA initData =
+        {
+            .pSysMem = m_aVertices.data()
+        };
+
+        HRESULT hr = pDevice->CreateBuffer(&bd, &initData, m_vertexBuffer.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        bd.ByteWidth = static_cast<UINT>(sizeof(WORD) * m_aIndices.size());
+        bd.BindFlags = D3D11_BIND_INDEX_BUFFER;
+        initData.pSysMem = m_aIndices.data();
+
+        hr = pDevice->CreateBuffer(&bd, &initData, m_indexBuffer.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        return createMapTextures(pDevice);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Terrain::Update
+      Summary:  Updates the terrain every frame
+      Args:     FLOAT deltaTime
+                  Elapsed time
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Terrain::Update(_In_ FLOAT deltaTime)
+    {
+        UNREFERENCED_PARAMETER(deltaTime);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Terrain::Select
+      Summary:  Picks the patches seen from the camera position, they
+                are uploaded by UploadInstances every frame
+      Args:     const XMVECTOR& eye
+                  Position of the camera
+      Modifies: [m_lodTree, m_aPatches].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void Terrain::Select(_In_ const XMVECTOR& eye)
+    {
+        m_lodTree.Select(eye, m_aPatches);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Terrain::UploadInstances
+      Summary:  Copies the patches of the last selection to the upload
+                arena, they are drawn from the returned allocation this
+                frame only
+      Args:     RenderDevice* pDevice
+                  The render device the arena maps its pages with
+                UploadArena& arena
+                  Vertex upload arena of the frame
+                UploadAllocation& outAllocation
+                  Receives the buffer and offset of the patches
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Terrain::UploadInstances(_In_ RenderDevice* pDevice, _In_ UploadArena& arena, _Out_ UploadAllocation& outAllocation) const
+    {
+        outAllocation = UploadAllocation();
+
+        if (m_aPatches.empty())
+        {
+            return E_FAIL;
+        }
+
+        return arena.Upload(pDevice, m_aPatches.data(), static_cast<UINT>(sizeof(TerrainPatchData) * m_aPatches.size()), sizeof(TerrainPatchData), outAllocation);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Terrain::GetTerrainConstants
+      Summary:  Returns the constants of the map origin and the morph
+                ranges
+      Returns:  const CBTerrain&
+                  Terrain constants
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const CBTerrain& Terrain::GetTerrainConstants() const
+    {
+        return m_cbTerrain;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Terrain::GetHeightView
+      Summary:  Returns the view of the column heights
+      Returns:  ComPtr<ID3D11ShaderResourceView>&
+                  Shader resource view
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ComPtr<ID3D11ShaderResourceView>& Terrain::GetHeightView()
+    {
+        return m_heightView;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Terrain::GetColorView
+      Summary:  Returns the view of the column colors
+      Returns:  ComPtr<ID3D11ShaderResourceView>&
+                  Shader resource view
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ComPtr<ID3D11ShaderResourceView>& Terrain::GetColorView()
+    {
+        return m_colorView;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Terrain::GetNumInstances
+      Summary:  Returns the number of patches of the last selection
+      Returns:  UINT
+                  Number of instances
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT Terrain::GetNumInstances() const
+    {
+        return static_cast<UINT>(m_aPatches.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Terrain::GetLodTree
+      Summary:  Returns the level of detail tree of the terrain
+      Returns:  const TerrainLodTree&
+                  Level of detail tree
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const TerrainLodTree& Terrain::GetLodTree() const
+    {
+        return m_lodTree;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Terrain::GetNumVertices
+      Summary:  Returns the number of vertices of the patch grid
+      Returns:  UINT
+                  Number of vertices
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT Terrain::GetNumVertices() const
+    {
+        return static_cast<UINT>(m_aVertices.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Terrain::GetNumIndices
+      Summary:  Returns the number of indices of the patch grid
+      Returns:  UINT
+                  Number of indices
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT Terrain::GetNumIndices() const
+    {
+        return static_cast<UINT>(m_aIndices.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Terrain::getVertices
+      Summary:  Returns the pointer to the vertices data
+      Returns:  const library::SimpleVertex*
+                  Pointer to the vertices data
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const SimpleVertex* Terrain::getVertices() const
+    {
+        return m_aVertices.data();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Terrain::getIndices
+      Summary:  Returns the pointer to the indices data
+      Returns:  const WORD*
+                  Pointer to the indices data
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const WORD* Terrain::getIndices() const
+    {
+        return m_aIndices.data();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Terrain::createMapTextures
+      Summary:  Creates the texture of the column heights, read as
+                integers, and the texture of the colors of their block
+                types
+      Args:     RenderDevice* pDevice
+                  The render device to create the textures
+      Modifies: [m_heightView, m_colorView].
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT Terrain::createMapTextures(_In_ RenderDevice* pDevice)
+    {
+        const UINT uWidth = m_heightMap.GetWidth();
+        const UINT uDepth = m_heightMap.GetDepth();
+        if (uWidth > D3D11_REQ_TEXTURE2D_U_OR_V_DIMENSION || uDepth > D3D11_REQ_TEXTURE2D_U_OR_V_DIMENSION)
+        {
+            return E_INVALIDARG;
+        }
+
+        const std::vector<XMFLOAT4>& aPalette = m_heightMap.GetPalette();
+        std::vector<WORD> aHeights(static_cast<size_t>(uWidth) * uDepth);
+        std::vector<UINT> aColors(static_cast<size_t>(uWidth) * uDepth);
+        for (UINT z = 0u; z < uDepth; ++z)
+        {
+            for (UINT x = 0u; x < uWidth; ++x)
+            {
+                size_t uIndex = static_cast<size_t>(z) * uWidth + x;
+                aHeights[uIndex] = static_cast<WORD>(m_heightMap.GetColumnHeight(x, z));
+
+                size_t uColorIdx = static_cast<size_t>(m_heightMap.GetBlockType(x, z)) - static_cast<size_t>(eBlockType::GRASSLAND);
+                XMFLOAT4 color = uColorIdx < aPalette.size() ? aPalette[uColorIdx] : m_outputColor;
+                aColors[uIndex] =
+                    static_cast<UINT>(std::clamp(color.x, 0.0f, 1.0f) * 255.0f + 0.5f) |
+                    static_cast<UINT>(std::clamp(color.y, 0.0f, 1.0f) * 255.0f + 0.5f) << 8u |
+                    static_cast<UINT>(std::clamp(color.z, 0.0f, 1.0f) * 255.0f + 0.5f) << 16u |
+                    255u << 24u;
+            }
+        }
+
+        D3D11_TEXTURE2D_DESC textureDesc =
+        {
+            .Width = uWidth,
+            .Height = uDepth,
+            .MipLevels = 1u,
+            .ArraySize = 1u,
+            .Format = DXGI_FORMAT_R16_UINT,
+            .SampleDesc = {.Count = 1u },
+            .Usage = D3D11_USAGE_IMMUTABLE,
+            .BindFlags = D3D11_BIND_SHADER_RESOURCE,
+            .CPUAccessFlags = 0u,
+            .MiscFlags = 0u
+        };
+        D3D11_SUBRESOURCE_DATA initData =
+        {
+            .pSysMem = aHeights.data(),
+            .SysMemPitch = static_cast<UINT>(sizeof(WORD) * uWidth)
+        };
+
+        ComPtr<ID3D11Texture2D> heightTexture;
+        HRESULT hr = pDevice->CreateTexture2D(&textureDesc, &initData, heightTexture.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        hr = pDevice->CreateShaderResourceView(heightTexture.Get(), nullptr, m_heightView.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        textureDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+        initData.pSysMem = aColors.data();
+        initData.SysMemPitch = static_cast<UINT>(sizeof(UINT) * uWidth);
+
+        ComPtr<ID3D11Texture2D> colorTexture;
+        hr = pDevice->CreateTexture2D(&textureDesc, &initData, colorTexture.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        return pDevice->CreateShaderResourceView(colorTexture.Get(), nullptr, m_colorView.GetAddressOf());
+    }
+}
\ No newline at end of file
@@ -0,0 +1,102 @@
+/*+===================================================================
+  File:      TERRAIN.H
+
+  Summary:   Terrain header file contains declarations of Terrain
+             class, the renderable of the height map drawn as a smooth
+             continuous level of detail heightfield.
+
+  Classes: Terrain
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Renderer/DataTypes.h"
+#include "Renderer/Renderable.h"
+#include "Renderer/UploadArena.h"
+#include "Scene/TerrainLodTree.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    Terrain
+
+      Summary:  Renderable of the patches picked by TerrainLodTree.
+                The vertex and index buffers hold the one grid shared
+                by all patches, the patches are instances uploaded to
+                the upload arena every frame, so the whole terrain is
+                one instanced draw. The vertex shader reads the column
+                heights and the block colors from two textures of the
+                size of the map, at most 16384 x 16384 columns
+
+      Methods:  Initialize
+                  Creates the buffers and the textures of the map
+                Update
+                  Does nothing, the patches change with the camera
+                Select
+                  Picks the patches seen from the camera position
+                UploadInstances
+                  Uploads the patches of the last selection
+                GetTerrainConstants
+                  Returns the constants of the morph ranges
+                GetHeightView / GetColorView
+                  Return the views of the map textures
+                GetNumInstances
+                  Returns the number of selected patches
+                GetLodTree
+                  Returns the level of detail tree
+                GetNumVertices
+                  Returns the number of vertices of the grid
+                GetNumIndices
+                  Returns the number of indices of the grid
+                Terrain
+                  Constructor.
+                ~Terrain
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class Terrain : public Renderable
+    {
+    public:
+        Terrain() = delete;
+        Terrain(_In_ const HeightMap& heightMap, _In_ FLOAT detailDistance);
+        Terrain(const Terrain& other) = delete;
+        Terrain(Terrain&& other) = delete;
+        Terrain& operator=(const Terrain& other) = delete;
+        Terrain& operator=(Terrain&& other) = delete;
+        ~Terrain() = default;
+
+        virtual HRESULT Initialize(_In_ RenderDevice* pDevice) override;
+        virtual void Update(_In_ FLOAT deltaTime) override;
+
+        void Select(_In_ const XMVECTOR& eye);
+        HRESULT UploadInstances(_In_ RenderDevice* pDevice, _In_ UploadArena& arena, _Out_ UploadAllocation& outAllocation) const;
+
+        const CBTerrain& GetTerrainConstants() const;
+        ComPtr<ID3D11ShaderResourceView>& GetHeightView();
+        ComPtr<ID3D11ShaderResourceView>& GetColorView();
+        UINT GetNumInstances() const;
+        const TerrainLodTree& GetLodTree() const;
+
+        UINT GetNumVertices() const override;
+        UINT GetNumIndices() const override;
+
+    protected:
+        const SimpleVertex* getVertices() const override;
+        const WORD* getIndices() const override;
+
+    private:
+        HRESULT createMapTextures(_In_ RenderDevice* pDevice);
+
+    private:
+        const HeightMap& m_heightMap;
+        TerrainLodTree m_lodTree;
+        std::vector<SimpleVertex> m_aVertices;
+        std::vector<WORD> m_aIndices;
+        std::vector<TerrainPatchData> m_aPatches;
+        CBTerrain m_cbTerrain;
+        ComPtr<ID3D11ShaderResourceView> m_heightView;
+        ComPtr<ID3D11ShaderResourceView> m_colorView;
+    };
+}
\ No newline at end of file
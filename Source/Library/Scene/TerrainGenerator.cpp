@@ -0,0 +1,314 @@
+#include "Scene/TerrainGenerator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <execution>
+#include <numeric>
+
+namespace library
+{
+    namespace
+    {
+        constexpr const FLOAT NOISE_FREQUENCY = 0.1f;
+        constexpr const UINT NOISE_OCTAVES = 4u;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainGenerator::ClassifyBiome
+      Summary:  Looks the block type up in the biome table: the first
+                band containing the height, then the first threshold
+                above the moisture
+      Args:     FLOAT height
+                  Height of the cell
+                FLOAT moisture
+                  Moisture of the cell
+      Returns:  eBlockType
+                  Block type of the cell
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    eBlockType TerrainGenerator::ClassifyBiome(_In_ FLOAT height, _In_ FLOAT moisture)
+    {
+        for (const BiomeBand& band : ms_aBiomeBands)
+        {
+            if (height < band.fMaxHeight || (band.bInclusive && height == band.fMaxHeight))
+            {
+                for (UINT i = 0u; i + 1u < band.uNumThresholds; ++i)
+                {
+                    if (moisture < band.aThresholds[i].fMaxMoisture)
+                    {
+                        return band.aThresholds[i].blockType;
+                    }
+                }
+
+                return band.aThresholds[band.uNumThresholds - 1u].blockType;
+            }
+        }
+
+        return eBlockType::GRASSLAND;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainGenerator::GetPalette
+      Summary:  Returns the colors of the block types, from GRASSLAND
+                to TROPICAL_RAIN_FOREST
+      Returns:  std::vector<XMFLOAT4>
+                  Colors of the block types
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    std::vector<XMFLOAT4> TerrainGenerator::GetPalette()
+    {
+        return std::vector<XMFLOAT4>
+        {
+            XMFLOAT4(0.0f,      0.666f, 0.0f,   1.0f),  // GRASSLAND
+            XMFLOAT4(1.0f,      1.0f,   1.0f,   1.0f),  // SNOW
+            XMFLOAT4(0.0f,      0.0f,   0.666f, 1.0f),  // OCEAN
+            XMFLOAT4(1.0f,      0.666f, 0.0f,   1.0f),  // SAND
+            XMFLOAT4(0.666f,    0.0f,   0.0f,   1.0f),  // SCORCHED
+            XMFLOAT4(0.956f,    0.643f, 0.376f, 1.0f),  // BARE
+            XMFLOAT4(0.941f,    0.0f,   1.0f,   1.0f),  // TUNDRA
+            XMFLOAT4(0.803f,    0.521f, 0.247f, 1.0f),  // TEMPERATE_DESERT
+            XMFLOAT4(0.42f,     0.556f, 0.137f, 1.0f),  // SHRUBLAND
+            XMFLOAT4(0.0f,      0.392f, 0.0f,   1.0f),  // TAIGA
+            XMFLOAT4(1.0f,      0.55f,  0.0f,   1.0f),  // TEMPERATE_DECIDUOUS_FOREST
+            XMFLOAT4(0.0f,      0.5f,   0.0f,   1.0f),  // TEMPERATE_RAIN_FOREST
+            XMFLOAT4(0.956f,    0.643f, 0.376f, 1.0f),  // SUBTROPICAL_DESERT
+            XMFLOAT4(0.133f,    0.545f, 0.133f, 1.0f),  // TROPICAL_SEASONAL_FOREST
+            XMFLOAT4(0.15f,     0.372f, 0.15f,  1.0f),  // TROPICAL_RAIN_FOREST
+        };
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainGenerator::TerrainGenerator
+      Summary:  Constructor
+      Args:     const TerrainDesc& desc
+                  Dimensions and seeds of the map
+      Modifies: [m_desc, m_heightNoise, m_moistureNoise].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    TerrainGenerator::TerrainGenerator(_In_ const TerrainDesc& desc)
+        : m_desc(desc)
+        , m_heightNoise(desc.uHeightSeed)
+        , m_moistureNoise(desc.uMoistureSeed)
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainGenerator::Generate
+      Summary:  Generates every tile of the height map
+      Args:     HeightMap& outHeightMap
+                  Generated height map
+                BOOL bParallel
+                  Whether the tiles are generated on all cores
+      Modifies: [outHeightMap].
+      Returns:  HRESULT
+                  Status code, E_INVALIDARG for an empty map
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT TerrainGenerator::Generate(_Out_ HeightMap& outHeightMap, _In_ BOOL bParallel) const
+    {
+        if (m_desc.uWidth == 0u || m_desc.uHeight == 0u || m_desc.uDepth == 0u)
+        {
+            return E_INVALIDARG;
+        }
+
+        HeightMap heightMap(m_desc.uWidth, m_desc.uHeight, m_desc.uDepth, GetPalette());
+
+        UINT uNumTilesX = GetNumTilesX();
+        std::vector<UINT> aTileIndices(static_cast<size_t>(uNumTilesX) * GetNumTilesZ());
+        std::iota(aTileIndices.begin(), aTileIndices.end(), 0u);
+
+        // Tiles write disjoint cells, so they need no synchronization
+        auto generateTile = [&](UINT uTileIndex)
+        {
+            GenerateTile(uTileIndex % uNumTilesX, uTileIndex / uNumTilesX, heightMap);
+        };
+
+        if (bParallel)
+        {
+            std::for_each(std::execution::par, aTileIndices.begin(), aTileIndices.end(), generateTile);
+        }
+        else
+        {
+            std::for_each(aTileIndices.begin(), aTileIndices.end(), generateTile);
+        }
+
+        outHeightMap = std::move(heightMap);
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainGenerator::GenerateToFile
+      Summary:  Generates the height map and saves it in the binary
+                format
+      Args:     const std::filesystem::path& filePath
+                  Path to the binary height map
+                BOOL bParallel
+                  Whether the tiles are generated on all cores
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT TerrainGenerator::GenerateToFile(_In_ const std::filesystem::path& filePath, _In_ BOOL bParallel) const
+    {
+        HeightMap heightMap;
+        HRESULT hr = Generate(heightMap, bParallel);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        return heightMap.SaveToBinary(filePath);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainGenerator::GenerateTile
+      Summary:  Generates the cells of one tile
+      Args:     UINT uTileX
+                  Index of the tile along the x axis
+                UINT uTileZ
+                  Index of the tile along the z axis
+                HeightMap& heightMap
+                  Height map sized by this generator
+      Modifies: [heightMap].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TerrainGenerator::GenerateTile(_In_ UINT uTileX, _In_ UINT uTileZ, _Inout_ HeightMap& heightMap) const
+    {
+        UINT uStartX = uTileX * TILE_SIZE;
+        UINT uStartZ = uTileZ * TILE_SIZE;
+        UINT uEndX = std::min(uStartX + TILE_SIZE, m_desc.uWidth);
+        UINT uEndZ = std::min(uStartZ + TILE_SIZE, m_desc.uDepth);
+
+        fillCells(uStartX, uStartZ, uEndX - uStartX, uEndZ - uStartZ, uStartX, uStartZ, heightMap);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainGenerator::GenerateRegion
+      Summary:  Generates a rectangle of the world regardless of the
+                width and the depth of the description, so the world
+                can be paged in around the camera. Cell (0, 0) of the
+                region is cell (uStartX, uStartZ) of the world. The
+                samples stay exact while the coordinates are below
+                2^24
+      Args:     UINT uStartX
+                UINT uStartZ
+                  First cell of the region
+                UINT uWidth
+                UINT uDepth
+                  Number of cells of the region along the x and the z
+                  axes
+                HeightMap& outHeightMap
+                  Generated region
+      Modifies: [outHeightMap].
+      Returns:  HRESULT
+                  Status code, E_INVALIDARG for an empty region
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT TerrainGenerator::GenerateRegion(_In_ UINT uStartX, _In_ UINT uStartZ, _In_ UINT uWidth, _In_ UINT uDepth, _Out_ HeightMap& outHeightMap) const
+    {
+        if (uWidth == 0u || uDepth == 0u || m_desc.uHeight == 0u)
+        {
+            return E_INVALIDARG;
+        }
+
+        HeightMap heightMap(uWidth, m_desc.uHeight, uDepth, GetPalette());
+        fillCells(uStartX, uStartZ, uWidth, uDepth, 0u, 0u, heightMap);
+
+        outHeightMap = std::move(heightMap);
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainGenerator::GetNumTilesX
+      Summary:  Returns the number of tiles along the x axis
+      Returns:  UINT
+                  Number of tiles
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT TerrainGenerator::GetNumTilesX() const
+    {
+        return (m_desc.uWidth + TILE_SIZE - 1u) / TILE_SIZE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainGenerator::GetNumTilesZ
+      Summary:  Returns the number of tiles along the z axis
+      Returns:  UINT
+                  Number of tiles
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT TerrainGenerator::GetNumTilesZ() const
+    {
+        return (m_desc.uDepth + TILE_SIZE - 1u) / TILE_SIZE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainGenerator::sumFrequencies
+      Summary:  Averages the NUM_FREQUENCIES samples of a cell, each
+                weighted by the inverse of its frequency
+      Args:     const FLOAT* aRows
+                  NUM_FREQUENCIES rows of samples
+                UINT uWidth
+                  Number of samples of a row
+                UINT x
+                  Index of the cell in the rows
+      Returns:  FLOAT
+                  Weighted average of the samples
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT TerrainGenerator::sumFrequencies(_In_reads_(uWidth * NUM_FREQUENCIES) const FLOAT* aRows, _In_ UINT uWidth, _In_ UINT x)
+    {
+        FLOAT value = 0.0f;
+        FLOAT frequencySum = 0.0f;
+        FLOAT frequency = 1.0f;
+        for (UINT i = 0u; i < NUM_FREQUENCIES; ++i)
+        {
+            frequencySum += 1.0f / frequency;
+            value += aRows[static_cast<size_t>(i) * uWidth + x] / frequency;
+            frequency *= 2.0f;
+        }
+
+        return value / frequencySum;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainGenerator::fillCells
+      Summary:  Generates a rectangle of world cells into the height
+                map. Each row samples both noise channels
+                NUM_FREQUENCIES times with PerlinNoise::SampleRow,
+                then classifies its cells
+      Args:     UINT uStartX
+                UINT uStartZ
+                  First world cell of the rectangle
+                UINT uWidth
+                UINT uDepth
+                  Size of the rectangle in cells
+                UINT uDstX
+                UINT uDstZ
+                  Cell of the height map receiving the first cell
+                HeightMap& heightMap
+                  Height map to fill
+      Modifies: [heightMap].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TerrainGenerator::fillCells(_In_ UINT uStartX, _In_ UINT uStartZ, _In_ UINT uWidth, _In_ UINT uDepth, _In_ UINT uDstX, _In_ UINT uDstZ, _Inout_ HeightMap& heightMap) const
+    {
+        std::vector<FLOAT> aHeightRows(static_cast<size_t>(NUM_FREQUENCIES) * uWidth);
+        std::vector<FLOAT> aMoistureRows(aHeightRows.size());
+
+        for (UINT uRow = 0u; uRow < uDepth; ++uRow)
+        {
+            UINT z = uStartZ + uRow;
+
+            // Powers of two keep frequency * x exact, so a tile samples the same values as a whole row
+            FLOAT frequency = 1.0f;
+            for (UINT i = 0u; i < NUM_FREQUENCIES; ++i)
+            {
+                m_heightNoise.SampleRow(frequency * static_cast<FLOAT>(uStartX), frequency * static_cast<FLOAT>(z), frequency, NOISE_FREQUENCY, NOISE_OCTAVES, uWidth, aHeightRows.data() + static_cast<size_t>(i) * uWidth);
+                m_moistureNoise.SampleRow(frequency * static_cast<FLOAT>(uStartX), frequency * static_cast<FLOAT>(z), frequency, NOISE_FREQUENCY, NOISE_OCTAVES, uWidth, aMoistureRows.data() + static_cast<size_t>(i) * uWidth);
+                frequency *= 2.0f;
+            }
+
+            for (UINT uColumn = 0u; uColumn < uWidth; ++uColumn)
+            {
+                FLOAT height = std::pow(sumFrequencies(aHeightRows.data(), uWidth, uColumn) * 1.2f, 1.25f);
+                FLOAT moisture = std::pow(sumFrequencies(aMoistureRows.data(), uWidth, uColumn) * 1.2f, 1.25f);
+
+                assert(height >= 0.0f);
+
+                heightMap.SetCell(uDstX + uColumn, uDstZ + uRow, static_cast<CHAR>(ClassifyBiome(height, moisture)), height);
+            }
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,140 @@
+/*+===================================================================
+  File:      TERRAINGENERATOR.H
+
+  Summary:   TerrainGenerator header file contains declarations of
+             TerrainGenerator class used to generate the voxel height
+             map from the noise channels, tile by tile on all cores.
+
+  Classes: TerrainGenerator
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include <cfloat>
+
+#include "Scene/HeightMap.h"
+#include "Scene/PerlinNoise.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   TerrainDesc
+
+        Summary:  Dimensions of the generated map and seeds of its
+                  height and moisture channels
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct TerrainDesc
+    {
+        UINT uWidth;
+        UINT uHeight;
+        UINT uDepth;
+        UINT uHeightSeed;
+        UINT uMoistureSeed;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   BiomeThreshold
+
+        Summary:  Block type of the cells of a height band whose
+                  moisture is below fMaxMoisture
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct BiomeThreshold
+    {
+        FLOAT fMaxMoisture;
+        eBlockType blockType;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   BiomeBand
+
+        Summary:  Range of heights below fMaxHeight, or up to it when
+                  bInclusive is set, with its moisture thresholds in
+                  ascending order
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct BiomeBand
+    {
+        static constexpr const UINT MAX_THRESHOLDS = 4u;
+
+        FLOAT fMaxHeight;
+        BOOL bInclusive;
+        UINT uNumThresholds;
+        BiomeThreshold aThresholds[MAX_THRESHOLDS];
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    TerrainGenerator
+
+      Summary:  Generates the height and the block type of every cell
+                from two noise channels. The map is split into
+                TILE_SIZE^2 tiles evaluated in parallel, and the
+                result does not depend on the tiling nor on the
+                number of cores
+
+      Methods:  Generate
+                  Generates the height map in memory
+                GenerateToFile
+                  Generates the height map into a binary file
+                GenerateTile
+                  Generates one tile of the height map
+                GenerateRegion
+                  Generates any rectangle of the unbounded world
+                ClassifyBiome
+                  Returns the block type of a height and a moisture
+                GetPalette
+                  Returns the colors of the block types
+                GetNumTilesX / GetNumTilesZ
+                  Return the number of tiles along each axis
+                TerrainGenerator
+                  Constructor.
+                ~TerrainGenerator
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class TerrainGenerator
+    {
+    public:
+        static constexpr const UINT TILE_SIZE = 64u;
+        static constexpr const UINT NUM_FREQUENCIES = 4u;
+
+        static eBlockType ClassifyBiome(_In_ FLOAT height, _In_ FLOAT moisture);
+        static std::vector<XMFLOAT4> GetPalette();
+
+        TerrainGenerator() = delete;
+        explicit TerrainGenerator(_In_ const TerrainDesc& desc);
+        TerrainGenerator(const TerrainGenerator& other) = delete;
+        TerrainGenerator(TerrainGenerator&& other) = delete;
+        TerrainGenerator& operator=(const TerrainGenerator& other) = delete;
+        TerrainGenerator& operator=(TerrainGenerator&& other) = delete;
+        ~TerrainGenerator() = default;
+
+        HRESULT Generate(_Out_ HeightMap& outHeightMap, _In_ BOOL bParallel = TRUE) const;
+        HRESULT GenerateToFile(_In_ const std::filesystem::path& filePath, _In_ BOOL bParallel = TRUE) const;
+        void GenerateTile(_In_ UINT uTileX, _In_ UINT uTileZ, _Inout_ HeightMap& heightMap) const;
+        HRESULT GenerateRegion(_In_ UINT uStartX, _In_ UINT uStartZ, _In_ UINT uWidth, _In_ UINT uDepth, _Out_ HeightMap& outHeightMap) const;
+
+        UINT GetNumTilesX() const;
+        UINT GetNumTilesZ() const;
+
+    private:
+        static constexpr const BiomeBand ms_aBiomeBands[] =
+        {
+            { 0.1f, FALSE, 1u, { { FLT_MAX, eBlockType::OCEAN } } },
+            { 0.12f, FALSE, 1u, { { FLT_MAX, eBlockType::SAND } } },
+            { 0.3f, TRUE, 4u, { { 0.16f, eBlockType::SUBTROPICAL_DESERT }, { 0.33f, eBlockType::GRASSLAND }, { 0.66f, eBlockType::TROPICAL_SEASONAL_FOREST }, { FLT_MAX, eBlockType::TROPICAL_RAIN_FOREST } } },
+            { 0.6f, TRUE, 4u, { { 0.16f, eBlockType::TEMPERATE_DESERT }, { 0.5f, eBlockType::GRASSLAND }, { 0.83f, eBlockType::TEMPERATE_DECIDUOUS_FOREST }, { FLT_MAX, eBlockType::TEMPERATE_RAIN_FOREST } } },
+            { 0.8f, TRUE, 3u, { { 0.33f, eBlockType::TEMPERATE_DESERT }, { 0.66f, eBlockType::SHRUBLAND }, { FLT_MAX, eBlockType::TAIGA } } },
+            { FLT_MAX, TRUE, 4u, { { 0.1f, eBlockType::SCORCHED }, { 0.2f, eBlockType::BARE }, { 0.5f, eBlockType::TUNDRA }, { FLT_MAX, eBlockType::SNOW } } },
+        };
+
+        static FLOAT sumFrequencies(_In_reads_(uWidth * NUM_FREQUENCIES) const FLOAT* aRows, _In_ UINT uWidth, _In_ UINT x);
+
+        void fillCells(_In_ UINT uStartX, _In_ UINT uStartZ, _In_ UINT uWidth, _In_ UINT uDepth, _In_ UINT uDstX, _In_ UINT uDstZ, _Inout_ HeightMap& heightMap) const;
+
+    private:
+        TerrainDesc m_desc;
+        PerlinNoise m_heightNoise;
+        PerlinNoise m_moistureNoise;
+    };
+}
\ No newline at end of file
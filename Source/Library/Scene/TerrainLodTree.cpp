@@ -0,0 +1,578 @@
+#include "Scene/TerrainLodTree.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <execution>
+#include <numeric>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainLodTree::BuildPatchMesh
+      Summary:  Builds the grid of PATCH_SIZE x PATCH_SIZE quads drawn
+                for every patch. The position of a vertex is its grid
+                coordinates, the vertex shader scales and moves it to
+                the patch and reads its height. Every quad is split
+                along the same diagonal so that the grid with its odd
+                vertices slid onto the even ones is the grid of the
+                next level
+      Args:     std::vector<SimpleVertex>& aOutVertices
+                  Vertices of the grid
+                std::vector<WORD>& aOutIndices
+                  Indices of the triangles of the grid
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TerrainLodTree::BuildPatchMesh(_Out_ std::vector<SimpleVertex>& aOutVertices, _Out_ std::vector<WORD>& aOutIndices)
+    {
+        constexpr const UINT uNumVerticesPerSide = PATCH_SIZE + 1u;
+
+        aOutVertices.clear();
+        aOutIndices.clear();
+        aOutVertices.reserve(uNumVerticesPerSide * uNumVerticesPerSide);
+        aOutIndices.reserve(PATCH_SIZE * PATCH_SIZE * 6u);
+
+        for (UINT z = 0u; z < uNumVerticesPerSide; ++z)
+        {
+            for (UINT x = 0u; x < uNumVerticesPerSide; ++x)
+            {
+                aOutVertices.push_back(
+                    SimpleVertex
+                    {
+                        .Position = XMFLOAT3(static_cast<FLOAT>(x), 0.0f, static_cast<FLOAT>(z)),
+                        .TexCoord = XMFLOAT2(static_cast<FLOAT>(x) / static_cast<FLOAT>(PATCH_SIZE), static_cast<FLOAT>(z) / static_cast<FLOAT>(PATCH_SIZE)),
+                        .Normal = XMFLOAT3(0.0f, 1.0f, 0.0f)
+                    }
+                );
+            }
+        }
+
+        for (UINT z = 0u; z < PATCH_SIZE; ++z)
+        {
+            for (UINT x = 0u; x < PATCH_SIZE; ++x)
+            {
+                WORD uCorner = static_cast<WORD>(z * uNumVerticesPerSide + x);
+                const WORD aIndices[6] =
+                {
+                    uCorner,
+                    static_cast<WORD>(uCorner + uNumVerticesPerSide),
+                    static_cast<WORD>(uCorner + uNumVerticesPerSide + 1u),
+                    uCorner,
+                    static_cast<WORD>(uCorner + uNumVerticesPerSide + 1u),
+                    static_cast<WORD>(uCorner + 1u)
+                };
+                aOutIndices.insert(aOutIndices.end(), std::begin(aIndices), std::end(aIndices));
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainLodTree::TerrainLodTree
+      Summary:  Constructor. Lays out the nodes of every level up to
+                the one a single node covers the map with, the map
+                placed like the instanced voxels. Build fills them
+      Args:     const HeightMap& heightMap
+                  Height map, must outlive the tree
+                FLOAT detailDistance
+                  Distance the full detail is drawn within, in world
+                  units
+      Modifies: [m_heightMap, m_origin, m_uNumLevels, m_auNumNodesX,
+                 m_auNumNodesZ, m_auFirstNodes, m_aMinHeights,
+                 m_aMaxHeights, m_aRanges, m_aMorphStarts, m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    TerrainLodTree::TerrainLodTree(_In_ const HeightMap& heightMap, _In_ FLOAT detailDistance)
+        : m_heightMap(heightMap)
+        , m_origin(
+            -static_cast<FLOAT>(heightMap.GetWidth()) - 1.0f,
+            -2.0f * static_cast<FLOAT>(heightMap.GetHeight()) + 0.75f * static_cast<FLOAT>(heightMap.GetHeight()) - 1.0f,
+            -static_cast<FLOAT>(heightMap.GetDepth()) - 1.0f
+        )
+        , m_uNumLevels(1u)
+        , m_auNumNodesX()
+        , m_auNumNodesZ()
+        , m_auFirstNodes()
+        , m_aMinHeights()
+        , m_aMaxHeights()
+        , m_aRanges()
+        , m_aMorphStarts()
+        , m_stats()
+    {
+        const UINT uMapSize = std::max(m_heightMap.GetWidth(), m_heightMap.GetDepth());
+        while (m_uNumLevels < MAX_NUM_TERRAIN_LEVELS && (LEAF_SIZE << (m_uNumLevels - 1u)) < uMapSize)
+        {
+            ++m_uNumLevels;
+        }
+
+        UINT uNumNodes = 0u;
+        for (UINT uLevel = 0u; uLevel < m_uNumLevels; ++uLevel)
+        {
+            UINT uNodeColumns = LEAF_SIZE << uLevel;
+            m_auNumNodesX[uLevel] = std::max((m_heightMap.GetWidth() + uNodeColumns - 1u) / uNodeColumns, 1u);
+            m_auNumNodesZ[uLevel] = std::max((m_heightMap.GetDepth() + uNodeColumns - 1u) / uNodeColumns, 1u);
+            m_auFirstNodes[uLevel] = uNumNodes;
+            uNumNodes += m_auNumNodesX[uLevel] * m_auNumNodesZ[uLevel];
+        }
+
+        m_aMinHeights.resize(uNumNodes, 0u);
+        m_aMaxHeights.resize(uNumNodes, 0u);
+
+        // Until Build knows the heights every level is drawn everywhere
+        std::fill(std::begin(m_aRanges), std::end(m_aRanges), FLT_MAX);
+        std::fill(std::begin(m_aMorphStarts), std::end(m_aMorphStarts), FLT_MAX);
+        m_aRanges[0] = detailDistance;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainLodTree::Build
+      Summary:  Finds the lowest and highest column of the leaves,
+                merges them up the tree and sets the range of every
+                level
+      Args:     BOOL bParallel
+                  Whether the leaves are filled on all cores
+      Modifies: [m_aMinHeights, m_aMaxHeights, m_aRanges,
+                 m_aMorphStarts].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TerrainLodTree::Build(_In_ BOOL bParallel)
+    {
+        std::vector<UINT> aLeaves(m_auNumNodesX[0] * m_auNumNodesZ[0]);
+        std::iota(aLeaves.begin(), aLeaves.end(), 0u);
+
+        auto buildOne = [this](UINT uLeaf)
+        {
+            buildLeaf(uLeaf % m_auNumNodesX[0], uLeaf / m_auNumNodesX[0]);
+        };
+
+        if (bParallel)
+        {
+            std::for_each(std::execution::par, aLeaves.begin(), aLeaves.end(), buildOne);
+        }
+        else
+        {
+            std::for_each(aLeaves.begin(), aLeaves.end(), buildOne);
+        }
+
+        for (UINT uLevel = 1u; uLevel < m_uNumLevels; ++uLevel)
+        {
+            for (UINT uNodeZ = 0u; uNodeZ < m_auNumNodesZ[uLevel]; ++uNodeZ)
+            {
+                for (UINT uNodeX = 0u; uNodeX < m_auNumNodesX[uLevel]; ++uNodeX)
+                {
+                    WORD uMinHeight = USHRT_MAX;
+                    WORD uMaxHeight = 0u;
+                    for (UINT uChildZ = 2u * uNodeZ; uChildZ < std::min(2u * uNodeZ + 2u, m_auNumNodesZ[uLevel - 1u]); ++uChildZ)
+                    {
+                        for (UINT uChildX = 2u * uNodeX; uChildX < std::min(2u * uNodeX + 2u, m_auNumNodesX[uLevel - 1u]); ++uChildX)
+                        {
+                            UINT uChildIndex = getNodeIndex(uLevel - 1u, uChildX, uChildZ);
+                            uMinHeight = std::min(uMinHeight, m_aMinHeights[uChildIndex]);
+                            uMaxHeight = std::max(uMaxHeight, m_aMaxHeights[uChildIndex]);
+                        }
+                    }
+
+                    UINT uNodeIndex = getNodeIndex(uLevel, uNodeX, uNodeZ);
+                    m_aMinHeights[uNodeIndex] = uMinHeight;
+                    m_aMaxHeights[uNodeIndex] = uMaxHeight;
+                }
+            }
+        }
+
+        buildRanges(m_aRanges[0]);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainLodTree::Select
+      Summary:  Picks the patches to draw. A node is drawn at its level
+                where its children are out of the range of the level
+                below, and skipped when it is out of its own range, its
+                parent then drawing it. The root level has no range so
+                the whole map is always drawn
+      Args:     const XMVECTOR& eye
+                  Position of the camera
+                std::vector<TerrainPatchData>& aOutPatches
+                  Patches to draw, one instance each
+      Modifies: [m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TerrainLodTree::Select(_In_ const XMVECTOR& eye, _Out_ std::vector<TerrainPatchData>& aOutPatches)
+    {
+        LARGE_INTEGER frequency;
+        LARGE_INTEGER start;
+        LARGE_INTEGER end;
+        QueryPerformanceFrequency(&frequency);
+        QueryPerformanceCounter(&start);
+
+        aOutPatches.clear();
+        m_stats = {};
+
+        XMFLOAT3 eyePosition(XMVectorGetX(eye), XMVectorGetY(eye), XMVectorGetZ(eye));
+
+        const UINT uRootLevel = m_uNumLevels - 1u;
+        for (UINT uNodeZ = 0u; uNodeZ < m_auNumNodesZ[uRootLevel]; ++uNodeZ)
+        {
+            for (UINT uNodeX = 0u; uNodeX < m_auNumNodesX[uRootLevel]; ++uNodeX)
+            {
+                selectNode(uRootLevel, uNodeX, uNodeZ, eyePosition, aOutPatches);
+            }
+        }
+
+        m_stats.uNumPatches = aOutPatches.size();
+        m_stats.uNumTriangles = m_stats.uNumPatches * PATCH_TRIANGLES;
+
+        QueryPerformanceCounter(&end);
+        m_stats.selectTime = static_cast<DOUBLE>(end.QuadPart - start.QuadPart) / static_cast<DOUBLE>(frequency.QuadPart);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainLodTree::GetVertexPosition
+      Summary:  Returns the world position of a vertex of a patch as
+                the vertex shader computes it. The distance of the
+                vertex sets how far it slides toward the even vertex
+                before it, the heights are interpolated between the
+                columns it passes over
+      Args:     const TerrainPatchData& patch
+                  Patch of the vertex
+                UINT uGridX
+                  Column of the vertex in the grid, up to PATCH_SIZE
+                UINT uGridZ
+                  Row of the vertex in the grid, up to PATCH_SIZE
+                const XMFLOAT3& eye
+                  Position of the camera
+      Returns:  XMFLOAT3
+                  Morphed position of the vertex
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    XMFLOAT3 TerrainLodTree::GetVertexPosition(_In_ const TerrainPatchData& patch, _In_ UINT uGridX, _In_ UINT uGridZ, _In_ const XMFLOAT3& eye) const
+    {
+        const FLOAT spacing = static_cast<FLOAT>(1u << patch.Level);
+        const FLOAT maxColumnX = static_cast<FLOAT>(m_heightMap.GetWidth() - 1u);
+        const FLOAT maxColumnZ = static_cast<FLOAT>(m_heightMap.GetDepth() - 1u);
+
+        auto getPosition = [&](FLOAT gridX, FLOAT gridZ)
+        {
+            FLOAT columnX = std::min(static_cast<FLOAT>(patch.X) + gridX * spacing, maxColumnX);
+            FLOAT columnZ = std::min(static_cast<FLOAT>(patch.Z) + gridZ * spacing, maxColumnZ);
+
+            return XMFLOAT3(
+                m_origin.x + 1.0f + 2.0f * columnX,
+                getHeight(columnX, columnZ),
+                m_origin.z + 1.0f + 2.0f * columnZ
+            );
+        };
+
+        FLOAT gridX = static_cast<FLOAT>(uGridX);
+        FLOAT gridZ = static_cast<FLOAT>(uGridZ);
+        XMFLOAT3 position = getPosition(gridX, gridZ);
+
+        FLOAT dx = position.x - eye.x;
+        FLOAT dy = position.y - eye.y;
+        FLOAT dz = position.z - eye.z;
+        FLOAT morph = GetMorphFactor(patch.Level, std::sqrt(dx * dx + dy * dy + dz * dz));
+        if (morph == 0.0f)
+        {
+            return position;
+        }
+
+        gridX -= std::fmod(gridX, 2.0f) * morph;
+        gridZ -= std::fmod(gridZ, 2.0f) * morph;
+
+        return getPosition(gridX, gridZ);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainLodTree::GetMorphFactor
+      Summary:  Returns how far the vertices of a level slid onto the
+                grid of the next one, from none at the start of the
+                morph to all the way at the end of the range
+      Args:     UINT uLevel
+                  Level of detail
+                FLOAT distance
+                  Distance from the camera to the vertex
+      Returns:  FLOAT
+                  Morph factor between 0 and 1
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT TerrainLodTree::GetMorphFactor(_In_ UINT uLevel, _In_ FLOAT distance) const
+    {
+        if (m_aRanges[uLevel] == FLT_MAX)
+        {
+            return 0.0f;
+        }
+
+        FLOAT scale = 1.0f / (m_aRanges[uLevel] - m_aMorphStarts[uLevel]);
+
+        return std::clamp((distance - m_aMorphStarts[uLevel]) * scale, 0.0f, 1.0f);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainLodTree::GetShaderConstants
+      Summary:  Fills the constants the terrain vertex shader places
+                and morphs the patches with
+      Args:     CBTerrain& outConstants
+                  Constants of the terrain
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TerrainLodTree::GetShaderConstants(_Out_ CBTerrain& outConstants) const
+    {
+        outConstants = {};
+        outConstants.Origin = XMFLOAT4(m_origin.x + 1.0f, m_origin.y, m_origin.z + 1.0f, 0.0f);
+
+        // The root level never morphs, 0 scales every distance to a factor of 0
+        for (UINT uLevel = 0u; uLevel < m_uNumLevels; ++uLevel)
+        {
+            FLOAT scale = m_aRanges[uLevel] == FLT_MAX ? 0.0f : 1.0f / (m_aRanges[uLevel] - m_aMorphStarts[uLevel]);
+            outConstants.MorphRanges[uLevel] = XMFLOAT4(m_aRanges[uLevel] == FLT_MAX ? 0.0f : m_aMorphStarts[uLevel], scale, 0.0f, 0.0f);
+        }
+
+        outConstants.MapSize = XMUINT4(m_heightMap.GetWidth(), m_heightMap.GetDepth(), m_uNumLevels, 0u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainLodTree::GetNumLevels
+      Summary:  Returns the number of levels of the tree
+      Returns:  UINT
+                  Number of levels, the root level included
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT TerrainLodTree::GetNumLevels() const
+    {
+        return m_uNumLevels;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainLodTree::GetRange
+      Summary:  Returns the distance a level is drawn within
+      Args:     UINT uLevel
+                  Level of detail
+      Returns:  FLOAT
+                  Range in world units, FLT_MAX for the root level
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT TerrainLodTree::GetRange(_In_ UINT uLevel) const
+    {
+        return m_aRanges[uLevel];
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainLodTree::GetStats
+      Summary:  Returns the patches picked by the last selection
+      Returns:  const TerrainLodStats&
+                  Selection statistics
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const TerrainLodStats& TerrainLodTree::GetStats() const
+    {
+        return m_stats;
+    }
+
+    UINT TerrainLodTree::getNodeIndex(_In_ UINT uLevel, _In_ UINT uNodeX, _In_ UINT uNodeZ) const
+    {
+        return m_auFirstNodes[uLevel] + uNodeZ * m_auNumNodesX[uLevel] + uNodeX;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainLodTree::buildLeaf
+      Summary:  Finds the lowest and highest column of a leaf, the
+                columns of its far edges included since its patches
+                have vertices on them
+      Args:     UINT uNodeX
+                  Coordinate of the leaf
+                UINT uNodeZ
+                  Coordinate of the leaf
+      Modifies: [m_aMinHeights, m_aMaxHeights].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TerrainLodTree::buildLeaf(_In_ UINT uNodeX, _In_ UINT uNodeZ)
+    {
+        const UINT uFirstX = std::min(uNodeX * LEAF_SIZE, m_heightMap.GetWidth() - 1u);
+        const UINT uFirstZ = std::min(uNodeZ * LEAF_SIZE, m_heightMap.GetDepth() - 1u);
+        const UINT uLastX = std::min(uFirstX + LEAF_SIZE, m_heightMap.GetWidth() - 1u);
+        const UINT uLastZ = std::min(uFirstZ + LEAF_SIZE, m_heightMap.GetDepth() - 1u);
+
+        WORD uMinHeight = USHRT_MAX;
+        WORD uMaxHeight = 0u;
+        for (UINT z = uFirstZ; z <= uLastZ; ++z)
+        {
+            for (UINT x = uFirstX; x <= uLastX; ++x)
+            {
+                WORD uHeight = static_cast<WORD>(m_heightMap.GetColumnHeight(x, z));
+                uMinHeight = std::min(uMinHeight, uHeight);
+                uMaxHeight = std::max(uMaxHeight, uHeight);
+            }
+        }
+
+        UINT uNodeIndex = getNodeIndex(0u, uNodeX, uNodeZ);
+        m_aMinHeights[uNodeIndex] = uMinHeight;
+        m_aMaxHeights[uNodeIndex] = uMaxHeight;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainLodTree::buildRanges
+      Summary:  Doubles the range from one level to the next and starts
+                the morph at MORPH_START_RATIO of the way from the
+                previous range. A node of level l reaches at most its
+                diagonal past the range of l, where the next level must
+                not have started morphing yet, so the range of l is
+                pushed to at least diagonal / MORPH_START_RATIO. Finer
+                nodes then always meet coarser ones fully morphed and
+                never two levels apart
+      Args:     FLOAT detailDistance
+                  Distance the full detail is drawn within
+      Modifies: [m_aRanges, m_aMorphStarts].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TerrainLodTree::buildRanges(_In_ FLOAT detailDistance)
+    {
+        FLOAT previousRange = 0.0f;
+        for (UINT uLevel = 0u; uLevel < MAX_NUM_TERRAIN_LEVELS; ++uLevel)
+        {
+            if (uLevel + 1u >= m_uNumLevels)
+            {
+                m_aRanges[uLevel] = FLT_MAX;
+                m_aMorphStarts[uLevel] = FLT_MAX;
+                continue;
+            }
+
+            const FLOAT nodeWidth = 2.0f * static_cast<FLOAT>(LEAF_SIZE << uLevel);
+            FLOAT maxDiagonal = 0.0f;
+            for (UINT uNodeIndex = m_auFirstNodes[uLevel]; uNodeIndex < m_auFirstNodes[uLevel + 1u]; ++uNodeIndex)
+            {
+                FLOAT nodeHeight = 2.0f * static_cast<FLOAT>(m_aMaxHeights[uNodeIndex] - m_aMinHeights[uNodeIndex]);
+                maxDiagonal = std::max(maxDiagonal, std::sqrt(2.0f * nodeWidth * nodeWidth + nodeHeight * nodeHeight));
+            }
+
+            FLOAT range = std::max(uLevel == 0u ? detailDistance : 2.0f * previousRange, maxDiagonal / MORPH_START_RATIO);
+            m_aRanges[uLevel] = range;
+            m_aMorphStarts[uLevel] = previousRange + MORPH_START_RATIO * (range - previousRange);
+            previousRange = range;
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainLodTree::getHeight
+      Summary:  Returns the top of the columns at a position of the
+                map, interpolated between the four columns around it
+      Args:     FLOAT columnX
+                  Column coordinate, within the map
+                FLOAT columnZ
+                  Row coordinate, within the map
+      Returns:  FLOAT
+                  Height in world units
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT TerrainLodTree::getHeight(_In_ FLOAT columnX, _In_ FLOAT columnZ) const
+    {
+        UINT x0 = static_cast<UINT>(columnX);
+        UINT z0 = static_cast<UINT>(columnZ);
+        UINT x1 = std::min(x0 + 1u, m_heightMap.GetWidth() - 1u);
+        UINT z1 = std::min(z0 + 1u, m_heightMap.GetDepth() - 1u);
+        FLOAT tx = columnX - static_cast<FLOAT>(x0);
+        FLOAT tz = columnZ - static_cast<FLOAT>(z0);
+
+        FLOAT h00 = static_cast<FLOAT>(m_heightMap.GetColumnHeight(x0, z0));
+        FLOAT h10 = static_cast<FLOAT>(m_heightMap.GetColumnHeight(x1, z0));
+        FLOAT h01 = static_cast<FLOAT>(m_heightMap.GetColumnHeight(x0, z1));
+        FLOAT h11 = static_cast<FLOAT>(m_heightMap.GetColumnHeight(x1, z1));
+
+        FLOAT height = (h00 * (1.0f - tx) + h10 * tx) * (1.0f - tz) + (h01 * (1.0f - tx) + h11 * tx) * tz;
+
+        return m_origin.y + 2.0f * height;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainLodTree::getSquaredDistance
+      Summary:  Returns the squared distance from the camera to the
+                bounds of a node, 0 inside them
+      Args:     UINT uLevel
+                  Level of the node
+                UINT uNodeX
+                  Coordinate of the node
+                UINT uNodeZ
+                  Coordinate of the node
+                const XMFLOAT3& eye
+                  Position of the camera
+      Returns:  FLOAT
+                  Squared distance in world units
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT TerrainLodTree::getSquaredDistance(_In_ UINT uLevel, _In_ UINT uNodeX, _In_ UINT uNodeZ, _In_ const XMFLOAT3& eye) const
+    {
+        const UINT uNodeColumns = LEAF_SIZE << uLevel;
+        const UINT uNodeIndex = getNodeIndex(uLevel, uNodeX, uNodeZ);
+
+        FLOAT minX = m_origin.x + 1.0f + 2.0f * static_cast<FLOAT>(uNodeX * uNodeColumns);
+        FLOAT minZ = m_origin.z + 1.0f + 2.0f * static_cast<FLOAT>(uNodeZ * uNodeColumns);
+        FLOAT maxX = m_origin.x + 1.0f + 2.0f * static_cast<FLOAT>(std::min((uNodeX + 1u) * uNodeColumns, m_heightMap.GetWidth() - 1u));
+        FLOAT maxZ = m_origin.z + 1.0f + 2.0f * static_cast<FLOAT>(std::min((uNodeZ + 1u) * uNodeColumns, m_heightMap.GetDepth() - 1u));
+        FLOAT minY = m_origin.y + 2.0f * static_cast<FLOAT>(m_aMinHeights[uNodeIndex]);
+        FLOAT maxY = m_origin.y + 2.0f * static_cast<FLOAT>(m_aMaxHeights[uNodeIndex]);
+
+        FLOAT dx = std::max({ minX - eye.x, 0.0f, eye.x - maxX });
+        FLOAT dy = std::max({ minY - eye.y, 0.0f, eye.y - maxY });
+        FLOAT dz = std::max({ minZ - eye.z, 0.0f, eye.z - maxZ });
+
+        return dx * dx + dy * dy + dz * dz;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainLodTree::selectNode
+      Summary:  Selects the patches of a node and its children
+      Args:     UINT uLevel
+                  Level of the node
+                UINT uNodeX
+                  Coordinate of the node
+                UINT uNodeZ
+                  Coordinate of the node
+                const XMFLOAT3& eye
+                  Position of the camera
+                std::vector<TerrainPatchData>& aOutPatches
+                  Patches to draw
+      Modifies: [m_stats].
+      Returns:  BOOL
+                  FALSE when the node is out of its range and left to
+                  its parent
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL TerrainLodTree::selectNode(_In_ UINT uLevel, _In_ UINT uNodeX, _In_ UINT uNodeZ, _In_ const XMFLOAT3& eye, _Inout_ std::vector<TerrainPatchData>& aOutPatches)
+    {
+        ++m_stats.uNumVisitedNodes;
+
+        FLOAT squaredDistance = getSquaredDistance(uLevel, uNodeX, uNodeZ, eye);
+        if (m_aRanges[uLevel] != FLT_MAX && squaredDistance > m_aRanges[uLevel] * m_aRanges[uLevel])
+        {
+            return FALSE;
+        }
+
+        const UINT uHalfColumns = (LEAF_SIZE << uLevel) / 2u;
+        const BOOL bLeaf = uLevel == 0u || squaredDistance > m_aRanges[uLevel - 1u] * m_aRanges[uLevel - 1u];
+
+        // Quarters starting past the edge of the map have nothing to draw
+        for (UINT uChildZ = 2u * uNodeZ; uChildZ < 2u * uNodeZ + 2u && uChildZ * uHalfColumns < m_heightMap.GetDepth(); ++uChildZ)
+        {
+            for (UINT uChildX = 2u * uNodeX; uChildX < 2u * uNodeX + 2u && uChildX * uHalfColumns < m_heightMap.GetWidth(); ++uChildX)
+            {
+                if (bLeaf || !selectNode(uLevel - 1u, uChildX, uChildZ, eye, aOutPatches))
+                {
+                    addPatch(uLevel, uChildX * uHalfColumns, uChildZ * uHalfColumns, aOutPatches);
+                }
+            }
+        }
+
+        return TRUE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TerrainLodTree::addPatch
+      Summary:  Adds a patch to the selection
+      Args:     UINT uLevel
+                  Level of the patch
+                UINT uColumnX
+                  Column of the corner of the patch
+                UINT uColumnZ
+                  Row of the corner of the patch
+                std::vector<TerrainPatchData>& aOutPatches
+                  Patches to draw
+      Modifies: [m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void TerrainLodTree::addPatch(_In_ UINT uLevel, _In_ UINT uColumnX, _In_ UINT uColumnZ, _Inout_ std::vector<TerrainPatchData>& aOutPatches)
+    {
+        aOutPatches.push_back(
+            TerrainPatchData
+            {
+                .X = uColumnX,
+                .Z = uColumnZ,
+                .Level = uLevel,
+                .Padding = 0u
+            }
+        );
+
+        ++m_stats.aLevels[uLevel].uNumPatches;
+        m_stats.aLevels[uLevel].uNumTriangles += PATCH_TRIANGLES;
+    }
+}
\ No newline at end of file
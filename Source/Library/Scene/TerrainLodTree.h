@@ -0,0 +1,143 @@
+/*+===================================================================
+  File:      TERRAINLODTREE.H
+
+  Summary:   TerrainLodTree header file contains declarations of
+             TerrainLodTree class used to draw the height map as a
+             smooth continuous level of detail heightfield.
+
+  Classes: TerrainLodTree
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Renderer/DataTypes.h"
+#include "Scene/HeightMap.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   TerrainLodLevelStats
+
+        Summary:  Patches selected at one level of detail
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct TerrainLodLevelStats
+    {
+        UINT64 uNumPatches;
+        UINT64 uNumTriangles;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   TerrainLodStats
+
+        Summary:  Result of the last selection. Every patch is drawn by
+                  the same instanced draw
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct TerrainLodStats
+    {
+        TerrainLodLevelStats aLevels[MAX_NUM_TERRAIN_LEVELS];
+        UINT64 uNumPatches;
+        UINT64 uNumTriangles;
+        UINT64 uNumVisitedNodes;
+        DOUBLE selectTime;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    TerrainLodTree
+
+      Summary:  CDLOD quadtree over the height map, drawing the tops of
+                the columns as one smooth surface. A node of level l
+                spans LEAF_SIZE * 2^l columns and keeps the lowest and
+                highest column under it. Every level is drawn within a
+                distance range twice as far as the one of the level
+                below, and Select walks down from the root keeping a
+                node where the finer level is out of range. The nodes
+                are drawn as quarters, patches of PATCH_SIZE x
+                PATCH_SIZE quads whose vertices are 2^l columns apart,
+                so a node half covered by finer nodes draws the other
+                half without overlap. Near the end of its range a
+                vertex slides onto the grid of the next level, which
+                joins the levels without cracks and without popping.
+                The ranges are widened where needed so that neighbors
+                differ by one level at most and the coarser one is
+                not morphing along their shared edge. Runs on the CPU
+                only so it can be used without a device, the vertex
+                shader repeats GetVertexPosition
+
+      Methods:  BuildPatchMesh
+                  Builds the grid of quads shared by every patch
+                Build
+                  Finds the height bounds of every node
+                Select
+                  Picks the patches to draw from the camera position
+                GetVertexPosition
+                  Returns the position of a patch vertex once morphed
+                GetMorphFactor
+                  Returns how far a level is morphed at a distance
+                GetShaderConstants
+                  Fills the constants of the terrain vertex shader
+                GetNumLevels
+                  Returns the number of levels of the tree
+                GetRange
+                  Returns the distance a level is drawn within
+                GetStats
+                  Returns the result of the last selection
+                TerrainLodTree
+                  Constructor.
+                ~TerrainLodTree
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class TerrainLodTree
+    {
+    public:
+        static constexpr const UINT LEAF_SIZE = 32u;
+        static constexpr const UINT PATCH_SIZE = LEAF_SIZE / 2u;
+        static constexpr const UINT PATCH_TRIANGLES = 2u * PATCH_SIZE * PATCH_SIZE;
+        static constexpr const FLOAT MORPH_START_RATIO = 0.7f;
+
+        static void BuildPatchMesh(_Out_ std::vector<SimpleVertex>& aOutVertices, _Out_ std::vector<WORD>& aOutIndices);
+
+        TerrainLodTree() = delete;
+        TerrainLodTree(_In_ const HeightMap& heightMap, _In_ FLOAT detailDistance);
+        TerrainLodTree(const TerrainLodTree& other) = delete;
+        TerrainLodTree(TerrainLodTree&& other) = delete;
+        TerrainLodTree& operator=(const TerrainLodTree& other) = delete;
+        TerrainLodTree& operator=(TerrainLodTree&& other) = delete;
+        ~TerrainLodTree() = default;
+
+        void Build(_In_ BOOL bParallel = TRUE);
+        void Select(_In_ const XMVECTOR& eye, _Out_ std::vector<TerrainPatchData>& aOutPatches);
+
+        XMFLOAT3 GetVertexPosition(_In_ const TerrainPatchData& patch, _In_ UINT uGridX, _In_ UINT uGridZ, _In_ const XMFLOAT3& eye) const;
+        FLOAT GetMorphFactor(_In_ UINT uLevel, _In_ FLOAT distance) const;
+        void GetShaderConstants(_Out_ CBTerrain& outConstants) const;
+
+        UINT GetNumLevels() const;
+        FLOAT GetRange(_In_ UINT uLevel) const;
+        const TerrainLodStats& GetStats() const;
+
+    private:
+        UINT getNodeIndex(_In_ UINT uLevel, _In_ UINT uNodeX, _In_ UINT uNodeZ) const;
+        void buildLeaf(_In_ UINT uNodeX, _In_ UINT uNodeZ);
+        void buildRanges(_In_ FLOAT detailDistance);
+        FLOAT getHeight(_In_ FLOAT columnX, _In_ FLOAT columnZ) const;
+        FLOAT getSquaredDistance(_In_ UINT uLevel, _In_ UINT uNodeX, _In_ UINT uNodeZ, _In_ const XMFLOAT3& eye) const;
+        BOOL selectNode(_In_ UINT uLevel, _In_ UINT uNodeX, _In_ UINT uNodeZ, _In_ const XMFLOAT3& eye, _Inout_ std::vector<TerrainPatchData>& aOutPatches);
+        void addPatch(_In_ UINT uLevel, _In_ UINT uColumnX, _In_ UINT uColumnZ, _Inout_ std::vector<TerrainPatchData>& aOutPatches);
+
+    private:
+        const HeightMap& m_heightMap;
+        XMFLOAT3 m_origin;
+        UINT m_uNumLevels;
+        UINT m_auNumNodesX[MAX_NUM_TERRAIN_LEVELS];
+        UINT m_auNumNodesZ[MAX_NUM_TERRAIN_LEVELS];
+        UINT m_auFirstNodes[MAX_NUM_TERRAIN_LEVELS];
+        std::vector<WORD> m_aMinHeights;
+        std::vector<WORD> m_aMaxHeights;
+        FLOAT m_aRanges[MAX_NUM_TERRAIN_LEVELS];
+        FLOAT m_aMorphStarts[MAX_NUM_TERRAIN_LEVELS];
+        TerrainLodStats m_stats;
+    };
+}
\ No newline at end of file
@@ -27,21 +27,19 @@ namespace library
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Voxel::Initialize
       Summary:  Initializes a voxel
-      Args:     ID3D11Device* pDevice
-                  The Direct3D device to create the buffers
-                ID3D11DeviceContext* pImmediateContext
-                  The Direct3D context to set buffers
+      Args:     RenderDevice* pDevice
+                  The render device to create the buffers
       Returns:  HRESULT
                   Status code
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    HRESULT Voxel::Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext)
+    HRESULT Voxel::Initialize(_In_ RenderDevice* pDevice)
     {
         BasicMeshEntry basicMeshEntry;
         basicMeshEntry.uNumIndices = NUM_INDICES;
 
         m_aMeshes.push_back(basicMeshEntry);
 
-        HRESULT hr = initialize(pDevice, pImmediateContext);
+        HRESULT hr = initialize(pDevice);
         if (FAILED(hr))
         {
             return hr;
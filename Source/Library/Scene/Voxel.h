@@ -39,7 +39,7 @@ namespace library
         Voxel& operator=(Voxel&& other) = delete;
         ~Voxel() = default;
 
-        virtual HRESULT Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext) override;
+        virtual HRESULT Initialize(_In_ RenderDevice* pDevice) override;
         virtual void Update(_In_ FLOAT deltaTime) override;
 
         UINT GetNumVertices() const override;
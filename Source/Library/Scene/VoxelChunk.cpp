@@ -0,0 +1,197 @@
+#include "Scene/VoxelChunk.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunk::VoxelChunk
+      Summary:  Constructor
+      Args:     VoxelChunkMesh&& mesh
+                  Mesh of the chunk
+                const std::vector<XMFLOAT4>& aPalette
+                  Colors of the block types, starting at GRASSLAND.
+                  The alpha of a vertex color is its baked brightness,
+                  0 when the mesh is not shaded
+      Modifies: [m_colorBuffer, m_mesh, m_aColors].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    VoxelChunk::VoxelChunk(_In_ VoxelChunkMesh&& mesh, _In_ const std::vector<XMFLOAT4>& aPalette)
+        : Renderable(XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f))
+        , m_colorBuffer()
+        , m_mesh(std::move(mesh))
+        , m_aColors()
+    {
+        m_aColors.reserve(m_mesh.aBlockTypes.size());
+        for (size_t i = 0u; i < m_mesh.aBlockTypes.size(); ++i)
+        {
+            size_t uColorIdx = static_cast<size_t>(m_mesh.aBlockTypes[i]) - static_cast<size_t>(eBlockType::GRASSLAND);
+            XMFLOAT4 color = uColorIdx < aPalette.size() ? aPalette[uColorIdx] : m_outputColor;
+            color.w = i < m_mesh.aShades.size() ? VoxelLightMap::GetBrightness(m_mesh.aShades[i]) : 0.0f;
+            m_aColors.push_back(color);
+        }
+
+        for (const VoxelMeshSection& section : m_mesh.aSections)
+        {
+            BasicMeshEntry basicMeshEntry;
+            basicMeshEntry.uNumIndices = section.uNumIndices;
+            basicMeshEntry.uBaseVertex = section.uBaseVertex;
+            basicMeshEntry.uBaseIndex = section.uBaseIndex;
+
+            m_aMeshes.push_back(basicMeshEntry);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunk::Initialize
+      Summary:  Creates the vertex, color and index buffers of the
+                chunk
+      Args:     RenderDevice* pDevice
+                  The render device to create the buffers
+      Modifies: [m_vertexBuffer, m_colorBuffer, m_indexBuffer].
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT VoxelChunk::Initialize(_In_ RenderDevice* pDevice)
+    {
+        if (m_mesh.aVertices.empty())
+        {
+            return E_FAIL;
+        }
+
+        D3D11_BUFFER_DESC bd =
+        {
+            .ByteWidth = static_cast<UINT>(sizeof(SimpleVertex) * m_mesh.aVertices.size()),
+            .Usage = D3D11_USAGE_IMMUTABLE,
+            .BindFlags = D3D11_BIND_VERTEX_BUFFER,
+            .CPUAccessFlags = 0u
+        };
+        D3D11_SUBRESOURCE_DATA initData =
+        {
+            .pSysMem = m_mesh.aVertices.data()
+        };
+
+        HRESULT hr = pDevice->CreateBuffer(&bd, &initData, m_vertexBuffer.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        bd.ByteWidth = static_cast<UINT>(sizeof(XMFLOAT4) * m_aColors.size());
+        initData.pSysMem = m_aColors.data();
+
+        hr = pDevice->CreateBuffer(&bd, &initData, m_colorBuffer.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        bd.ByteWidth = static_cast<UINT>(sizeof(WORD) * m_mesh.aIndices.size());
+        bd.BindFlags = D3D11_BIND_INDEX_BUFFER;
+        initData.pSysMem = m_mesh.aIndices.data();
+
+        hr = pDevice->CreateBuffer(&bd, &initData, m_indexBuffer.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunk::Update
+      Summary:  Updates the chunk every frame
+      Args:     FLOAT deltaTime
+                  Elapsed time
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelChunk::Update(_In_ FLOAT deltaTime)
+    {
+        UNREFERENCED_PARAMETER(deltaTime);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunk::GetColorBuffer
+      Summary:  Returns the per-vertex color buffer
+      Returns:  ComPtr<ID3D11Buffer>&
+                  Color buffer
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ComPtr<ID3D11Buffer>& VoxelChunk::GetColorBuffer()
+    {
+        return m_colorBuffer;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunk::GetChunkX
+      Summary:  Returns the x coordinate of the chunk
+      Returns:  UINT
+                  Chunk coordinate
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT VoxelChunk::GetChunkX() const
+    {
+        return m_mesh.uChunkX;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunk::GetChunkY
+      Summary:  Returns the y coordinate of the chunk
+      Returns:  UINT
+                  Chunk coordinate
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT VoxelChunk::GetChunkY() const
+    {
+        return m_mesh.uChunkY;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunk::GetChunkZ
+      Summary:  Returns the z coordinate of the chunk
+      Returns:  UINT
+                  Chunk coordinate
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT VoxelChunk::GetChunkZ() const
+    {
+        return m_mesh.uChunkZ;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunk::GetNumVertices
+      Summary:  Returns the number of vertices in the chunk
+      Returns:  UINT
+                  Number of vertices
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT VoxelChunk::GetNumVertices() const
+    {
+        return static_cast<UINT>(m_mesh.aVertices.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunk::GetNumIndices
+      Summary:  Returns the number of indices in the chunk
+      Returns:  UINT
+                  Number of indices
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT VoxelChunk::GetNumIndices() const
+    {
+        return static_cast<UINT>(m_mesh.aIndices.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunk::getVertices
+      Summary:  Returns the pointer to the vertices data
+      Returns:  const library::SimpleVertex*
+                  Pointer to the vertices data
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const SimpleVertex* VoxelChunk::getVertices() const
+    {
+        return m_mesh.aVertices.data();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunk::getIndices
+      Summary:  Returns the pointer to the indices data
+      Returns:  const WORD*
+                  Pointer to the indices data
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const WORD* VoxelChunk::getIndices() const
+    {
+        return m_mesh.aIndices.data();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+/*+===================================================================
+  File:      VOXELCHUNK.H
+
+  Summary:   VoxelChunk header file contains declarations of
+             VoxelChunk class, the renderable of one meshed chunk of
+             the voxel map.
+
+  Classes: VoxelChunk
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Renderer/DataTypes.h"
+#include "Renderer/Renderable.h"
+#include "Scene/VoxelChunkMesher.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    VoxelChunk
+
+      Summary:  Renderable of a chunk mesh built by VoxelChunkMesher.
+                The block color is stored per vertex in a second
+                vertex buffer so the whole chunk is drawn at once,
+                with the baked brightness of the vertex in its alpha
+
+      Methods:  Initialize
+                  Creates the vertex, color, index and constant
+                  buffers
+                Update
+                  Does nothing, chunks are static
+                GetColorBuffer
+                  Returns the per-vertex color buffer
+                GetChunkX / GetChunkY / GetChunkZ
+                  Return the coordinates of the chunk
+                GetNumVertices
+                  Returns the number of vertices
+                GetNumIndices
+                  Returns the number of indices
+                VoxelChunk
+                  Constructor.
+                ~VoxelChunk
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class VoxelChunk : public Renderable
+    {
+    public:
+        VoxelChunk(_In_ VoxelChunkMesh&& mesh, _In_ const std::vector<XMFLOAT4>& aPalette);
+        VoxelChunk(const VoxelChunk& other) = delete;
+        VoxelChunk(VoxelChunk&& other) = delete;
+        VoxelChunk& operator=(const VoxelChunk& other) = delete;
+        VoxelChunk& operator=(VoxelChunk&& other) = delete;
+        ~VoxelChunk() = default;
+
+        virtual HRESULT Initialize(_In_ RenderDevice* pDevice) override;
+        virtual void Update(_In_ FLOAT deltaTime) override;
+
+        ComPtr<ID3D11Buffer>& GetColorBuffer();
+
+        UINT GetChunkX() const;
+        UINT GetChunkY() const;
+        UINT GetChunkZ() const;
+
+        UINT GetNumVertices() const override;
+        UINT GetNumIndices() const override;
+
+    protected:
+        const SimpleVertex* getVertices() const override;
+        const WORD* getIndices() const override;
+
+    protected:
+        ComPtr<ID3D11Buffer> m_colorBuffer;
+        VoxelChunkMesh m_mesh;
+        std::vector<XMFLOAT4> m_aColors;
+    };
+}
\ No newline at end of file
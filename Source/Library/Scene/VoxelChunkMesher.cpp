@@ -0,0 +1,560 @@
+#include "Scene/VoxelChunkMesher.h"
+
+#include <algorithm>
+#include <execution>
+#include <numeric>
+
+namespace library
+{
+    namespace
+    {
+        constexpr const UINT MAX_SECTION_VERTICES = 65536u;
+
+        BOOL isSolidBlockType(_In_ CHAR blockType)
+        {
+            return static_cast<CHAR>(eBlockType::GRASSLAND) <= blockType && blockType < static_cast<CHAR>(eBlockType::COUNT);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkMesher::VoxelChunkMesher
+      Summary:  Constructor. Places the blocks like the instanced
+                voxels, the map centered on the origin
+      Args:     const VoxelGrid& grid
+                  Blocks to mesh, must outlive the mesher
+                eVoxelMeshing meshing
+                  Meshing algorithm
+      Modifies: [m_grid, m_meshing, m_origin, m_uBorder, m_pLightMap].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    VoxelChunkMesher::VoxelChunkMesher(_In_ const VoxelGrid& grid, _In_ eVoxelMeshing meshing)
+        // The grid places the blocks like the instanced voxels: block
+        // (x, y, z) is a 2-unit cube centered on 2 * (x - W / 2),
+        // 2 * (y - H) + 0.75 * H, 2 * (z - D / 2)
+        : VoxelChunkMesher(grid, meshing, grid.GetOrigin(), 0u)
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkMesher::VoxelChunkMesher
+      Summary:  Constructor
+      Args:     const VoxelGrid& grid
+                  Blocks to mesh, must outlive the mesher
+                eVoxelMeshing meshing
+                  Meshing algorithm
+                const XMFLOAT3& origin
+                  World position of the minimum corner of the first
+                  meshed block
+                UINT uBorder
+                  Number of cells on each side of the grid that
+                  are only read as neighbors. The cells in between
+                  must span whole chunks when it is not 0
+      Modifies: [m_grid, m_meshing, m_origin, m_uBorder, m_pLightMap].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    VoxelChunkMesher::VoxelChunkMesher(_In_ const VoxelGrid& grid, _In_ eVoxelMeshing meshing, _In_ const XMFLOAT3& origin, _In_ UINT uBorder)
+        : m_grid(grid)
+        , m_meshing(meshing)
+        , m_origin(origin)
+        , m_uBorder(uBorder)
+        , m_pLightMap(nullptr)
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkMesher::VoxelChunkMesher
+      Summary:  Constructor. Places the blocks like the instanced
+                voxels and shades the vertices from a baked light map
+      Args:     const VoxelGrid& grid
+                  Blocks to mesh, must outlive the mesher
+                eVoxelMeshing meshing
+                  Meshing algorithm
+                const VoxelLightMap& lightMap
+                  Light of the cells of the grid, must outlive the
+                  mesher
+      Modifies: [m_grid, m_meshing, m_origin, m_uBorder, m_pLightMap].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    VoxelChunkMesher::VoxelChunkMesher(_In_ const VoxelGrid& grid, _In_ eVoxelMeshing meshing, _In_ const VoxelLightMap& lightMap)
+        : VoxelChunkMesher(grid, meshing, grid.GetOrigin(), 0u)
+    {
+        m_pLightMap = &lightMap;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkMesher::MeshChunk
+      Summary:  Builds the mesh of one chunk. For every axis and
+                direction, each slice of the chunk is turned into a
+                mask of the visible faces, then the mask is covered
+                with the largest rectangles of a single block type and
+                shade
+      Args:     UINT uChunkX
+                UINT uChunkY
+                UINT uChunkZ
+                  Coordinates of the chunk
+                VoxelChunkMesh& outMesh
+                  Mesh of the chunk
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelChunkMesher::MeshChunk(_In_ UINT uChunkX, _In_ UINT uChunkY, _In_ UINT uChunkZ, _Out_ VoxelChunkMesh& outMesh) const
+    {
+        outMesh = VoxelChunkMesh
+        {
+            .uChunkX = uChunkX,
+            .uChunkY = uChunkY,
+            .uChunkZ = uChunkZ,
+            .uNumBlocks = 0u
+        };
+
+        std::vector<CHAR> aBlocks(static_cast<size_t>(PADDED_SIZE) * PADDED_SIZE * PADDED_SIZE);
+        fillChunk(uChunkX, uChunkY, uChunkZ, aBlocks.data());
+
+        // Strides of the padded array along x, y and z, and the index of the first inner block
+        const size_t aStrides[3] = { 1u, static_cast<size_t>(PADDED_SIZE) * PADDED_SIZE, PADDED_SIZE };
+        const size_t uOrigin = aStrides[0] + aStrides[1] + aStrides[2];
+
+        for (UINT y = 0u; y < CHUNK_SIZE; ++y)
+        {
+            for (UINT z = 0u; z < CHUNK_SIZE; ++z)
+            {
+                const CHAR* pRow = &aBlocks[uOrigin + y * aStrides[1] + z * aStrides[2]];
+                outMesh.uNumBlocks += static_cast<UINT64>(std::count_if(pRow, pRow + CHUNK_SIZE, [](CHAR blockType) { return blockType != HeightMap::EMPTY_BLOCK; }));
+            }
+        }
+
+        if (outMesh.uNumBlocks == 0u)
+        {
+            return;
+        }
+
+        FLOAT aChunkBase[3] =
+        {
+            static_cast<FLOAT>(uChunkX * CHUNK_SIZE),
+            static_cast<FLOAT>(uChunkY * CHUNK_SIZE),
+            static_cast<FLOAT>(uChunkZ * CHUNK_SIZE)
+        };
+        const INT aCellBase[3] =
+        {
+            static_cast<INT>(m_uBorder + uChunkX * CHUNK_SIZE),
+            static_cast<INT>(uChunkY * CHUNK_SIZE),
+            static_cast<INT>(m_uBorder + uChunkZ * CHUNK_SIZE)
+        };
+        BOOL bGreedy = m_meshing == eVoxelMeshing::GREEDY;
+
+        CHAR aMask[CHUNK_SIZE * CHUNK_SIZE];
+        WORD aShadeMask[CHUNK_SIZE * CHUNK_SIZE];
+        for (UINT uAxis = 0u; uAxis < 3u; ++uAxis)
+        {
+            UINT uAxisU = (uAxis + 1u) % 3u;
+            UINT uAxisV = (uAxis + 2u) % 3u;
+
+            for (BOOL bPositive : { FALSE, TRUE })
+            {
+                const ptrdiff_t neighborOffset = bPositive ? static_cast<ptrdiff_t>(aStrides[uAxis]) : -static_cast<ptrdiff_t>(aStrides[uAxis]);
+
+                for (UINT uSlice = 0u; uSlice < CHUNK_SIZE; ++uSlice)
+                {
+                    // A face is visible when its block is solid and the neighbor it faces is empty
+                    BOOL bHasFaces = FALSE;
+                    for (UINT v = 0u; v < CHUNK_SIZE; ++v)
+                    {
+                        const CHAR* pBlock = &aBlocks[uOrigin + uSlice * aStrides[uAxis] + v * aStrides[uAxisV]];
+                        for (UINT u = 0u; u < CHUNK_SIZE; ++u, pBlock += aStrides[uAxisU])
+                        {
+                            CHAR blockType = pBlock[neighborOffset] == HeightMap::EMPTY_BLOCK ? *pBlock : HeightMap::EMPTY_BLOCK;
+                            aMask[v * CHUNK_SIZE + u] = blockType;
+                            aShadeMask[v * CHUNK_SIZE + u] = 0u;
+                            bHasFaces |= blockType != HeightMap::EMPTY_BLOCK;
+
+                            if (m_pLightMap && blockType != HeightMap::EMPTY_BLOCK)
+                            {
+                                INT aCell[3];
+                                aCell[uAxis] = aCellBase[uAxis] + static_cast<INT>(uSlice);
+                                aCell[uAxisU] = aCellBase[uAxisU] + static_cast<INT>(u);
+                                aCell[uAxisV] = aCellBase[uAxisV] + static_cast<INT>(v);
+                                aShadeMask[v * CHUNK_SIZE + u] = shadeFace(aBlocks.data(), static_cast<size_t>(pBlock - aBlocks.data()), aCell, uAxis, bPositive);
+                            }
+                        }
+                    }
+
+                    if (!bHasFaces)
+                    {
+                        continue;
+                    }
+
+                    for (UINT v = 0u; v < CHUNK_SIZE; ++v)
+                    {
+                        for (UINT u = 0u; u < CHUNK_SIZE; )
+                        {
+                            CHAR blockType = aMask[v * CHUNK_SIZE + u];
+                            if (blockType == HeightMap::EMPTY_BLOCK)
+                            {
+                                ++u;
+                                continue;
+                            }
+
+                            // Faces of the same type but another shade would smear the light across the merged quad
+                            WORD uShade = aShadeMask[v * CHUNK_SIZE + u];
+                            auto isSameFace = [&](UINT uMaskIndex) { return aMask[uMaskIndex] == blockType && aShadeMask[uMaskIndex] == uShade; };
+
+                            UINT uWidth = 1u;
+                            UINT uHeight = 1u;
+                            if (bGreedy)
+                            {
+                                while (u + uWidth < CHUNK_SIZE && isSameFace(v * CHUNK_SIZE + u + uWidth))
+                                {
+                                    ++uWidth;
+                                }
+
+                                while (v + uHeight < CHUNK_SIZE)
+                                {
+                                    BOOL bSameRow = TRUE;
+                                    for (UINT uColumn = 0u; uColumn < uWidth && bSameRow; ++uColumn)
+                                    {
+                                        bSameRow = isSameFace((v + uHeight) * CHUNK_SIZE + u + uColumn);
+                                    }
+                                    if (!bSameRow)
+                                    {
+                                        break;
+                                    }
+                                    ++uHeight;
+                                }
+                            }
+
+                            for (UINT uRow = 0u; uRow < uHeight; ++uRow)
+                            {
+                                std::fill_n(&aMask[(v + uRow) * CHUNK_SIZE + u], uWidth, HeightMap::EMPTY_BLOCK);
+                            }
+
+                            FLOAT aCorners[4][3];
+                            const UINT aOffsetsU[4] = { 0u, uWidth, uWidth, 0u };
+                            const UINT aOffsetsV[4] = { 0u, 0u, uHeight, uHeight };
+                            for (UINT uCorner = 0u; uCorner < 4u; ++uCorner)
+                            {
+                                aCorners[uCorner][uAxis] = aChunkBase[uAxis] + static_cast<FLOAT>(uSlice + (bPositive ? 1u : 0u));
+                                aCorners[uCorner][uAxisU] = aChunkBase[uAxisU] + static_cast<FLOAT>(u + aOffsetsU[uCorner]);
+                                aCorners[uCorner][uAxisV] = aChunkBase[uAxisV] + static_cast<FLOAT>(v + aOffsetsV[uCorner]);
+                            }
+
+                            addQuad(aCorners, uAxis, bPositive, uWidth, uHeight, blockType, uShade, outMesh);
+
+                            u += uWidth;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkMesher::MeshAll
+      Summary:  Builds the meshes of every chunk of the grid.
+                Empty chunks are left out
+      Args:     std::vector<VoxelChunkMesh>& aOutMeshes
+                  Meshes of the non-empty chunks
+                BOOL bParallel
+                  Whether the chunks are meshed on all cores
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelChunkMesher::MeshAll(_Out_ std::vector<VoxelChunkMesh>& aOutMeshes, _In_ BOOL bParallel) const
+    {
+        UINT uNumChunksX = GetNumChunksX();
+        UINT uNumChunksY = GetNumChunksY();
+        UINT uNumChunksZ = GetNumChunksZ();
+
+        aOutMeshes.clear();
+        aOutMeshes.resize(static_cast<size_t>(uNumChunksX) * uNumChunksY * uNumChunksZ);
+
+        std::vector<UINT> aChunkIndices(aOutMeshes.size());
+        std::iota(aChunkIndices.begin(), aChunkIndices.end(), 0u);
+
+        auto meshChunk = [&](UINT uChunkIndex)
+        {
+            UINT uChunkX = uChunkIndex % uNumChunksX;
+            UINT uChunkZ = (uChunkIndex / uNumChunksX) % uNumChunksZ;
+            UINT uChunkY = uChunkIndex / (uNumChunksX * uNumChunksZ);
+
+            MeshChunk(uChunkX, uChunkY, uChunkZ, aOutMeshes[uChunkIndex]);
+        };
+
+        if (bParallel)
+        {
+            std::for_each(std::execution::par, aChunkIndices.begin(), aChunkIndices.end(), meshChunk);
+        }
+        else
+        {
+            std::for_each(aChunkIndices.begin(), aChunkIndices.end(), meshChunk);
+        }
+
+        std::erase_if(aOutMeshes, [](const VoxelChunkMesh& mesh) { return mesh.aVertices.empty(); });
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkMesher::GetStats
+      Summary:  Counts the geometry drawn by the instanced path, one
+                24-vertex cube per block and one draw per block type,
+                and the geometry of the given chunk meshes
+      Args:     const std::vector<VoxelChunkMesh>& aMeshes
+                  Meshes built by this mesher
+      Returns:  VoxelMeshStats
+                  Geometry counts
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    VoxelMeshStats VoxelChunkMesher::GetStats(_In_ const std::vector<VoxelChunkMesh>& aMeshes) const
+    {
+        VoxelMeshStats stats = {};
+
+        BOOL abHasBlockType[static_cast<size_t>(eBlockType::COUNT)] = { FALSE, };
+        std::vector<VoxelRun> aRuns;
+        for (UINT z = 0u; z < m_grid.GetDepth(); ++z)
+        {
+            for (UINT x = 0u; x < m_grid.GetWidth(); ++x)
+            {
+                m_grid.GetColumnRuns(x, z, aRuns);
+                UINT uRunStart = 0u;
+                for (const VoxelRun& run : aRuns)
+                {
+                    if (isSolidBlockType(run.blockType))
+                    {
+                        stats.uNumBlocks += run.uEnd - uRunStart;
+                        abHasBlockType[static_cast<size_t>(run.blockType)] = TRUE;
+                    }
+                    uRunStart = run.uEnd;
+                }
+            }
+        }
+
+        stats.uNumInstancedVertices = stats.uNumBlocks * 24u;
+        stats.uNumInstancedTriangles = stats.uNumBlocks * 12u;
+        stats.uNumInstancedDraws = static_cast<UINT64>(std::count(std::begin(abHasBlockType), std::end(abHasBlockType), TRUE));
+
+        for (const VoxelChunkMesh& mesh : aMeshes)
+        {
+            ++stats.uNumChunks;
+            stats.uNumVertices += mesh.aVertices.size();
+            stats.uNumTriangles += mesh.aIndices.size() / 3u;
+            stats.uNumDraws += mesh.aSections.size();
+        }
+
+        return stats;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkMesher::GetNumChunksX
+      Summary:  Returns the number of chunks along the x axis
+      Returns:  UINT
+                  Number of chunks
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT VoxelChunkMesher::GetNumChunksX() const
+    {
+        return (m_grid.GetWidth() - std::min(m_grid.GetWidth(), 2u * m_uBorder) + CHUNK_SIZE - 1u) / CHUNK_SIZE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkMesher::GetNumChunksY
+      Summary:  Returns the number of chunks along the y axis
+      Returns:  UINT
+                  Number of chunks
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT VoxelChunkMesher::GetNumChunksY() const
+    {
+        return (m_grid.GetHeight() + CHUNK_SIZE - 1u) / CHUNK_SIZE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkMesher::GetNumChunksZ
+      Summary:  Returns the number of chunks along the z axis
+      Returns:  UINT
+                  Number of chunks
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT VoxelChunkMesher::GetNumChunksZ() const
+    {
+        return (m_grid.GetDepth() - std::min(m_grid.GetDepth(), 2u * m_uBorder) + CHUNK_SIZE - 1u) / CHUNK_SIZE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkMesher::fillChunk
+      Summary:  Expands the runs of the columns of a chunk and of its
+                one-block border into a dense array. Blocks outside of
+                the grid are empty, the border cells of the grid are
+                read as neighbors
+      Args:     UINT uChunkX
+                UINT uChunkY
+                UINT uChunkZ
+                  Coordinates of the chunk
+                CHAR* aBlocks
+                  PADDED_SIZE^3 block types indexed by (y, z, x)
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelChunkMesher::fillChunk(_In_ UINT uChunkX, _In_ UINT uChunkY, _In_ UINT uChunkZ, _Out_writes_(PADDED_SIZE * PADDED_SIZE * PADDED_SIZE) CHAR* aBlocks) const
+    {
+        const INT firstY = static_cast<INT>(uChunkY * CHUNK_SIZE) - 1;
+        std::fill_n(aBlocks, static_cast<size_t>(PADDED_SIZE) * PADDED_SIZE * PADDED_SIZE, HeightMap::EMPTY_BLOCK);
+
+        std::vector<VoxelRun> aRuns;
+        for (UINT uPaddedZ = 0u; uPaddedZ < PADDED_SIZE; ++uPaddedZ)
+        {
+            for (UINT uPaddedX = 0u; uPaddedX < PADDED_SIZE; ++uPaddedX)
+            {
+                // Wraps around below 0 so that the grid returns no runs
+                UINT x = m_uBorder + uChunkX * CHUNK_SIZE + uPaddedX - 1u;
+                UINT z = m_uBorder + uChunkZ * CHUNK_SIZE + uPaddedZ - 1u;
+                m_grid.GetColumnRuns(x, z, aRuns);
+
+                INT runStart = 0;
+                for (const VoxelRun& run : aRuns)
+                {
+                    INT first = std::max(runStart, firstY) - firstY;
+                    INT last = std::min(static_cast<INT>(run.uEnd), firstY + static_cast<INT>(PADDED_SIZE)) - firstY;
+                    runStart = static_cast<INT>(run.uEnd);
+                    if (!isSolidBlockType(run.blockType))
+                    {
+                        continue;
+                    }
+
+                    for (INT paddedY = first; paddedY < last; ++paddedY)
+                    {
+                        aBlocks[(static_cast<size_t>(paddedY) * PADDED_SIZE + uPaddedZ) * PADDED_SIZE + uPaddedX] = run.blockType;
+                    }
+                }
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkMesher::shadeFace
+      Summary:  Returns the shade of a visible face: the light of the
+                cell it looks into, and for every corner the number of
+                solid blocks among the two sides and the diagonal in
+                front of it, the occlusion of ambient occlusion
+      Args:     const CHAR* aBlocks
+                  Padded blocks of the chunk
+                size_t uBlock
+                  Index of the block of the face in aBlocks
+                const INT aCell[3]
+                  Cell of the block in the grid
+                UINT uAxis
+                  Axis of the normal
+                BOOL bPositive
+                  Whether the normal points toward the positive axis
+      Returns:  WORD
+                  Light in the low byte, 2 bits of occlusion per corner
+                  in the high byte, in the order of the quad corners
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    WORD VoxelChunkMesher::shadeFace(_In_reads_(PADDED_SIZE * PADDED_SIZE * PADDED_SIZE) const CHAR* aBlocks, _In_ size_t uBlock, _In_ const INT aCell[3], _In_ UINT uAxis, _In_ BOOL bPositive) const
+    {
+        const ptrdiff_t aStrides[3] = { 1, static_cast<ptrdiff_t>(PADDED_SIZE) * PADDED_SIZE, PADDED_SIZE };
+        const ptrdiff_t strideU = aStrides[(uAxis + 1u) % 3u];
+        const ptrdiff_t strideV = aStrides[(uAxis + 2u) % 3u];
+        const CHAR* pFront = aBlocks + uBlock + (bPositive ? aStrides[uAxis] : -aStrides[uAxis]);
+
+        INT aFrontCell[3] = { aCell[0], aCell[1], aCell[2] };
+        aFrontCell[uAxis] += bPositive ? 1 : -1;
+        WORD uShade = m_pLightMap->GetLight(aFrontCell[0], aFrontCell[1], aFrontCell[2]);
+
+        // Corners 0 to 3 are at (-u, -v), (+u, -v), (+u, +v), (-u, +v)
+        const ptrdiff_t aCornerSignsU[4] = { -1, 1, 1, -1 };
+        const ptrdiff_t aCornerSignsV[4] = { -1, -1, 1, 1 };
+        for (UINT uCorner = 0u; uCorner < 4u; ++uCorner)
+        {
+            BOOL bSideU = pFront[aCornerSignsU[uCorner] * strideU] != HeightMap::EMPTY_BLOCK;
+            BOOL bSideV = pFront[aCornerSignsV[uCorner] * strideV] != HeightMap::EMPTY_BLOCK;
+            BOOL bDiagonal = pFront[aCornerSignsU[uCorner] * strideU + aCornerSignsV[uCorner] * strideV] != HeightMap::EMPTY_BLOCK;
+
+            // Two sides hide the diagonal, the corner is fully occluded
+            UINT uOcclusion = bSideU && bSideV ? VoxelLightMap::MAX_OCCLUSION : static_cast<UINT>(bSideU) + static_cast<UINT>(bSideV) + static_cast<UINT>(bDiagonal);
+            uShade |= static_cast<WORD>(uOcclusion << (8u + 2u * uCorner));
+        }
+
+        return uShade;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkMesher::addQuad
+      Summary:  Appends a quad in world space to the mesh, starting a
+                new section when 16-bit indices would overflow
+      Args:     const FLOAT aCorners[4][3]
+                  Corners of the quad in blocks, counter-clockwise
+                  around the positive axis
+                UINT uAxis
+                  Axis of the normal
+                BOOL bPositive
+                  Whether the normal points toward the positive axis
+                UINT uWidth
+                UINT uHeight
+                  Size of the quad in blocks, used to tile the texture
+                CHAR blockType
+                  Block type of the quad
+                WORD uFaceShade
+                  Shade returned by shadeFace, ignored without a
+                  light map
+                VoxelChunkMesh& mesh
+                  Mesh to append to
+      Modifies: [mesh].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelChunkMesher::addQuad(_In_ const FLOAT aCorners[4][3], _In_ UINT uAxis, _In_ BOOL bPositive, _In_ UINT uWidth, _In_ UINT uHeight, _In_ CHAR blockType, _In_ WORD uFaceShade, _Inout_ VoxelChunkMesh& mesh) const
+    {
+        if (mesh.aSections.empty() || mesh.aVertices.size() + 4u - mesh.aSections.back().uBaseVertex > MAX_SECTION_VERTICES)
+        {
+            mesh.aSections.push_back(
+                VoxelMeshSection
+                {
+                    .uBaseVertex = static_cast<UINT>(mesh.aVertices.size()),
+                    .uBaseIndex = static_cast<UINT>(mesh.aIndices.size()),
+                    .uNumIndices = 0u
+                }
+            );
+        }
+
+        VoxelMeshSection& section = mesh.aSections.back();
+        WORD uFirstIndex = static_cast<WORD>(mesh.aVertices.size() - section.uBaseVertex);
+
+        FLOAT aNormal[3] = { 0.0f, 0.0f, 0.0f };
+        aNormal[uAxis] = bPositive ? 1.0f : -1.0f;
+
+        const XMFLOAT2 aTexCoords[4] =
+        {
+            XMFLOAT2(0.0f, 0.0f),
+            XMFLOAT2(static_cast<FLOAT>(uWidth), 0.0f),
+            XMFLOAT2(static_cast<FLOAT>(uWidth), static_cast<FLOAT>(uHeight)),
+            XMFLOAT2(0.0f, static_cast<FLOAT>(uHeight)),
+        };
+
+        for (UINT uCorner = 0u; uCorner < 4u; ++uCorner)
+        {
+            mesh.aVertices.push_back(
+                SimpleVertex
+                {
+                    .Position = XMFLOAT3(
+                        m_origin.x + 2.0f * aCorners[uCorner][0],
+                        m_origin.y + 2.0f * aCorners[uCorner][1],
+                        m_origin.z + 2.0f * aCorners[uCorner][2]
+                    ),
+                    .TexCoord = aTexCoords[uCorner],
+                    .Normal = XMFLOAT3(aNormal[0], aNormal[1], aNormal[2])
+                }
+            );
+            mesh.aBlockTypes.push_back(blockType);
+        }
+
+        BYTE aOcclusions[4] = { 0u, 0u, 0u, 0u };
+        if (m_pLightMap)
+        {
+            for (UINT uCorner = 0u; uCorner < 4u; ++uCorner)
+            {
+                aOcclusions[uCorner] = static_cast<BYTE>((uFaceShade >> (8u + 2u * uCorner)) & VoxelLightMap::MAX_OCCLUSION);
+                mesh.aShades.push_back(VoxelLightMap::PackShade(static_cast<BYTE>(uFaceShade & 0xFFu), aOcclusions[uCorner]));
+            }
+        }
+
+        // The corners wind around the positive axis, so faces looking
+        // down the negative axis are flipped to stay clockwise. The
+        // quad is split along the diagonal of the most alike corners,
+        // which keeps the occlusion gradient symmetric
+        const WORD aPositiveIndices[6] = { 0u, 1u, 2u, 0u, 2u, 3u };
+        const WORD aNegativeIndices[6] = { 0u, 2u, 1u, 0u, 3u, 2u };
+        const WORD aFlippedPositiveIndices[6] = { 0u, 1u, 3u, 1u, 2u, 3u };
+        const WORD aFlippedNegativeIndices[6] = { 0u, 3u, 1u, 1u, 3u, 2u };
+        BOOL bFlipped = aOcclusions[0] + aOcclusions[2] < aOcclusions[1] + aOcclusions[3];
+        const WORD* aIndices = bFlipped ? (bPositive ? aFlippedPositiveIndices : aFlippedNegativeIndices) : (bPositive ? aPositiveIndices : aNegativeIndices);
+        for (UINT i = 0u; i < 6u; ++i)
+        {
+            mesh.aIndices.push_back(static_cast<WORD>(uFirstIndex + aIndices[i]));
+        }
+
+        section.uNumIndices += 6u;
+    }
+}
\ No newline at end of file
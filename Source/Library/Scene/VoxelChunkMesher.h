@@ -0,0 +1,153 @@
+/*+===================================================================
+  File:      VOXELCHUNKMESHER.H
+
+  Summary:   VoxelChunkMesher header file contains declarations of
+             VoxelChunkMesher class used to turn the blocks of a voxel
+             grid into chunk meshes with hidden faces removed and coplanar
+             faces greedily merged.
+
+  Classes: VoxelChunkMesher
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Renderer/DataTypes.h"
+#include "Scene/VoxelGrid.h"
+#include "Scene/VoxelLightMap.h"
+
+namespace library
+{
+    /*E+E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E
+        Enum:     eVoxelMeshing
+
+        Summary:  Enumeration of meshing algorithms. CULLED only
+                  removes the faces between solid blocks, GREEDY also
+                  merges coplanar faces of the same block type
+    E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E-E*/
+    enum class eVoxelMeshing
+    {
+        CULLED,
+        GREEDY,
+        COUNT,
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   VoxelMeshSection
+
+        Summary:  Range of a chunk mesh addressable with 16-bit indices,
+                  drawn with a single DrawIndexed call
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct VoxelMeshSection
+    {
+        UINT uBaseVertex;
+        UINT uBaseIndex;
+        UINT uNumIndices;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   VoxelChunkMesh
+
+        Summary:  Mesh of one chunk in world space, with the block type
+                  of every vertex, and its shade packed by
+                  VoxelLightMap::PackShade when the mesher has a light
+                  map
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct VoxelChunkMesh
+    {
+        UINT uChunkX;
+        UINT uChunkY;
+        UINT uChunkZ;
+        UINT64 uNumBlocks;
+        std::vector<SimpleVertex> aVertices;
+        std::vector<CHAR> aBlockTypes;
+        std::vector<WORD> aShades;
+        std::vector<WORD> aIndices;
+        std::vector<VoxelMeshSection> aSections;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   VoxelMeshStats
+
+        Summary:  Geometry of the per-block instanced path compared to
+                  the geometry of the chunk meshes
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct VoxelMeshStats
+    {
+        UINT64 uNumBlocks;
+        UINT64 uNumInstancedVertices;
+        UINT64 uNumInstancedTriangles;
+        UINT64 uNumInstancedDraws;
+        UINT64 uNumChunks;
+        UINT64 uNumVertices;
+        UINT64 uNumTriangles;
+        UINT64 uNumDraws;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    VoxelChunkMesher
+
+      Summary:  Splits the voxel grid into CHUNK_SIZE^3 chunks and
+                builds one mesh per non-empty chunk, reading the runs of
+                the columns of the grid. Runs on the CPU only so it can
+                be used without a device. A grid paged in from a larger
+                world can carry a border of neighbor cells, which hides
+                the faces between pages without being meshed. With a
+                light map, every vertex gets the light in front of its
+                face and the occlusion of the blocks around its corner,
+                and only faces of the same shade are merged
+
+      Methods:  MeshChunk
+                  Builds the mesh of one chunk
+                MeshAll
+                  Builds the meshes of every chunk, in parallel
+                GetStats
+                  Returns the geometry counts of the given meshes
+                GetNumChunksX / GetNumChunksY / GetNumChunksZ
+                  Return the number of chunks along each axis
+                VoxelChunkMesher
+                  Constructor.
+                ~VoxelChunkMesher
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class VoxelChunkMesher
+    {
+    public:
+        static constexpr const UINT CHUNK_SIZE = 32u;
+
+        VoxelChunkMesher() = delete;
+        VoxelChunkMesher(_In_ const VoxelGrid& grid, _In_ eVoxelMeshing meshing);
+        VoxelChunkMesher(_In_ const VoxelGrid& grid, _In_ eVoxelMeshing meshing, _In_ const XMFLOAT3& origin, _In_ UINT uBorder);
+        VoxelChunkMesher(_In_ const VoxelGrid& grid, _In_ eVoxelMeshing meshing, _In_ const VoxelLightMap& lightMap);
+        VoxelChunkMesher(const VoxelChunkMesher& other) = delete;
+        VoxelChunkMesher(VoxelChunkMesher&& other) = delete;
+        VoxelChunkMesher& operator=(const VoxelChunkMesher& other) = delete;
+        VoxelChunkMesher& operator=(VoxelChunkMesher&& other) = delete;
+        ~VoxelChunkMesher() = default;
+
+        void MeshChunk(_In_ UINT uChunkX, _In_ UINT uChunkY, _In_ UINT uChunkZ, _Out_ VoxelChunkMesh& outMesh) const;
+        void MeshAll(_Out_ std::vector<VoxelChunkMesh>& aOutMeshes, _In_ BOOL bParallel = TRUE) const;
+
+        VoxelMeshStats GetStats(_In_ const std::vector<VoxelChunkMesh>& aMeshes) const;
+
+        UINT GetNumChunksX() const;
+        UINT GetNumChunksY() const;
+        UINT GetNumChunksZ() const;
+
+    private:
+        static constexpr const UINT PADDED_SIZE = CHUNK_SIZE + 2u;
+
+        void fillChunk(_In_ UINT uChunkX, _In_ UINT uChunkY, _In_ UINT uChunkZ, _Out_writes_(PADDED_SIZE * PADDED_SIZE * PADDED_SIZE) CHAR* aBlocks) const;
+        WORD shadeFace(_In_reads_(PADDED_SIZE * PADDED_SIZE * PADDED_SIZE) const CHAR* aBlocks, _In_ size_t uBlock, _In_ const INT aCell[3], _In_ UINT uAxis, _In_ BOOL bPositive) const;
+        void addQuad(_In_ const FLOAT aCorners[4][3], _In_ UINT uAxis, _In_ BOOL bPositive, _In_ UINT uWidth, _In_ UINT uHeight, _In_ CHAR blockType, _In_ WORD uFaceShade, _Inout_ VoxelChunkMesh& mesh) const;
+
+    private:
+        const VoxelGrid& m_grid;
+        eVoxelMeshing m_meshing;
+        XMFLOAT3 m_origin;
+        UINT m_uBorder;
+        const VoxelLightMap* m_pLightMap;
+    };
+}
\ No newline at end of file
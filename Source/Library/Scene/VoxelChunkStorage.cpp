@@ -0,0 +1,609 @@
+#include "Scene/VoxelChunkStorage.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace library
+{
+    namespace
+    {
+        // Palette indices never straddle two words
+        UINT getBitsPerIndex(_In_ size_t uNumPaletteEntries)
+        {
+            UINT uBitsPerIndex = 1u;
+            while ((static_cast<size_t>(1u) << uBitsPerIndex) < uNumPaletteEntries)
+            {
+                uBitsPerIndex *= 2u;
+            }
+            return uBitsPerIndex;
+        }
+
+        // Appends raw bytes, then zeros up to a multiple of 4 bytes
+        void appendBytes(_Inout_ std::vector<BYTE>& aBytes, _In_reads_bytes_(uSize) const void* pData, _In_ size_t uSize)
+        {
+            const BYTE* pFirst = static_cast<const BYTE*>(pData);
+            aBytes.insert(aBytes.end(), pFirst, pFirst + uSize);
+            aBytes.resize((aBytes.size() + 3u) & ~static_cast<size_t>(3u), 0u);
+        }
+
+        // Reads raw bytes written by appendBytes, FALSE when the data is too short
+        BOOL readBytes(_In_reads_bytes_(uSize) const BYTE* pBytes, _In_ size_t uSize, _Inout_ size_t& uOffset, _Out_writes_bytes_(uDataSize) void* pData, _In_ size_t uDataSize)
+        {
+            size_t uPaddedSize = (uDataSize + 3u) & ~static_cast<size_t>(3u);
+            if (uSize - std::min(uSize, uOffset) < uPaddedSize)
+            {
+                return FALSE;
+            }
+
+            std::memcpy(pData, pBytes + uOffset, uDataSize);
+            uOffset += uPaddedSize;
+            return TRUE;
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkStorage::VoxelChunkStorage
+      Summary:  Constructor. Every column is empty
+      Args:     UINT uHeight
+                  Number of blocks of a column
+      Modifies: [m_uHeight, m_uBitsPerIndex, m_aPalette,
+                 m_auColumnStarts, m_auRunEnds, m_auPackedIndices].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    VoxelChunkStorage::VoxelChunkStorage(_In_ UINT uHeight)
+        : m_uHeight(uHeight)
+        , m_uBitsPerIndex(1u)
+        , m_aPalette(1u, HeightMap::EMPTY_BLOCK)
+        , m_auColumnStarts(NUM_COLUMNS + 1u, 0u)
+        , m_auRunEnds()
+        , m_auPackedIndices()
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkStorage::VoxelChunkStorage
+      Summary:  Constructor. Every column of the height map in the
+                chunk becomes a single run of its block type, the
+                columns outside of the map are empty
+      Args:     const HeightMap& heightMap
+                  Height map of the blocks
+                UINT uFirstX
+                UINT uFirstZ
+                  Cell of the height map of the first column
+      Modifies: [m_uHeight, m_uBitsPerIndex, m_aPalette,
+                 m_auColumnStarts, m_auRunEnds, m_auPackedIndices].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    VoxelChunkStorage::VoxelChunkStorage(_In_ const HeightMap& heightMap, _In_ UINT uFirstX, _In_ UINT uFirstZ)
+        : VoxelChunkStorage(heightMap.GetHeight())
+    {
+        std::vector<BYTE> auPaletteIndices;
+        auPaletteIndices.reserve(NUM_COLUMNS);
+        m_auRunEnds.reserve(NUM_COLUMNS);
+
+        for (UINT z = 0u; z < CHUNK_SIZE; ++z)
+        {
+            for (UINT x = 0u; x < CHUNK_SIZE; ++x)
+            {
+                UINT uColumn = z * CHUNK_SIZE + x;
+                m_auColumnStarts[uColumn] = static_cast<UINT>(m_auRunEnds.size());
+
+                UINT uMapX = uFirstX + x;
+                UINT uMapZ = uFirstZ + z;
+                if (uMapX >= heightMap.GetWidth() || uMapZ >= heightMap.GetDepth())
+                {
+                    continue;
+                }
+
+                CHAR blockType = heightMap.GetBlockType(uMapX, uMapZ);
+                UINT uColumnHeight = std::min(heightMap.GetColumnHeight(uMapX, uMapZ), m_uHeight);
+                if (blockType == HeightMap::EMPTY_BLOCK || uColumnHeight == 0u)
+                {
+                    continue;
+                }
+
+                auto it = std::find(m_aPalette.begin(), m_aPalette.end(), blockType);
+                if (it == m_aPalette.end())
+                {
+                    it = m_aPalette.insert(m_aPalette.end(), blockType);
+                }
+
+                m_auRunEnds.push_back(static_cast<UINT16>(uColumnHeight));
+                auPaletteIndices.push_back(static_cast<BYTE>(it - m_aPalette.begin()));
+            }
+        }
+        m_auColumnStarts[NUM_COLUMNS] = static_cast<UINT>(m_auRunEnds.size());
+        m_auRunEnds.shrink_to_fit();
+
+        m_uBitsPerIndex = getBitsPerIndex(m_aPalette.size());
+        const UINT uIndicesPerWord = 32u / m_uBitsPerIndex;
+        m_auPackedIndices.assign((auPaletteIndices.size() + uIndicesPerWord - 1u) / uIndicesPerWord, 0u);
+        for (UINT uRun = 0u; uRun < static_cast<UINT>(auPaletteIndices.size()); ++uRun)
+        {
+            setPaletteIndex(uRun, auPaletteIndices[uRun]);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkStorage::VoxelChunkStorage
+      Summary:  Constructor. Encodes a dense array of blocks, column by
+                column in storage order, so no run ever moves
+      Args:     UINT uHeight
+                  Number of blocks of a column
+                const CHAR* aBlocks
+                  Types of the blocks, indexed by
+                  (z * CHUNK_SIZE + x) * uHeight + y
+      Modifies: [m_uHeight, m_uBitsPerIndex, m_aPalette,
+                 m_auColumnStarts, m_auRunEnds, m_auPackedIndices].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    VoxelChunkStorage::VoxelChunkStorage(_In_ UINT uHeight, _In_reads_(CHUNK_SIZE * CHUNK_SIZE * uHeight) const CHAR* aBlocks)
+        : VoxelChunkStorage(uHeight)
+    {
+        std::vector<BYTE> auPaletteIndices;
+
+        for (UINT uColumn = 0u; uColumn < NUM_COLUMNS; ++uColumn)
+        {
+            m_auColumnStarts[uColumn] = static_cast<UINT>(m_auRunEnds.size());
+
+            // Neighboring blocks of the same type share a run, the empty blocks on top have none
+            const CHAR* pColumn = aBlocks + static_cast<size_t>(uColumn) * m_uHeight;
+            const UINT uFirstRun = static_cast<UINT>(m_auRunEnds.size());
+            for (UINT uY = 0u; uY < m_uHeight; ++uY)
+            {
+                if (uY > 0u && pColumn[uY] == pColumn[uY - 1u])
+                {
+                    m_auRunEnds.back() = static_cast<UINT16>(uY + 1u);
+                    continue;
+                }
+
+                auto it = std::find(m_aPalette.begin(), m_aPalette.end(), pColumn[uY]);
+                if (it == m_aPalette.end())
+                {
+                    it = m_aPalette.insert(m_aPalette.end(), pColumn[uY]);
+                }
+
+                m_auRunEnds.push_back(static_cast<UINT16>(uY + 1u));
+                auPaletteIndices.push_back(static_cast<BYTE>(it - m_aPalette.begin()));
+            }
+            if (m_auRunEnds.size() > uFirstRun && auPaletteIndices.back() == 0u)
+            {
+                m_auRunEnds.pop_back();
+                auPaletteIndices.pop_back();
+            }
+        }
+        m_auColumnStarts[NUM_COLUMNS] = static_cast<UINT>(m_auRunEnds.size());
+        m_auRunEnds.shrink_to_fit();
+
+        m_uBitsPerIndex = getBitsPerIndex(m_aPalette.size());
+        const UINT uIndicesPerWord = 32u / m_uBitsPerIndex;
+        m_auPackedIndices.assign((auPaletteIndices.size() + uIndicesPerWord - 1u) / uIndicesPerWord, 0u);
+        for (UINT uRun = 0u; uRun < static_cast<UINT>(auPaletteIndices.size()); ++uRun)
+        {
+            setPaletteIndex(uRun, auPaletteIndices[uRun]);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkStorage::GetBlock
+      Summary:  Returns the type of a block, found by walking the runs
+                of its column
+      Args:     UINT x
+                UINT y
+                UINT z
+                  Block in the chunk, x and z below CHUNK_SIZE
+      Returns:  CHAR
+                  Type of the block, EMPTY_BLOCK above the last run
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    CHAR VoxelChunkStorage::GetBlock(_In_ UINT x, _In_ UINT y, _In_ UINT z) const
+    {
+        UINT uColumn = z * CHUNK_SIZE + x;
+        for (UINT uRun = m_auColumnStarts[uColumn]; uRun < m_auColumnStarts[uColumn + 1u]; ++uRun)
+        {
+            if (y < m_auRunEnds[uRun])
+            {
+                return m_aPalette[getPaletteIndex(uRun)];
+            }
+        }
+
+        return HeightMap::EMPTY_BLOCK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkStorage::SetBlock
+      Summary:  Sets the type of a block. The column is expanded,
+                changed and encoded again, a new block type is added to
+                the palette
+      Args:     UINT x
+                UINT y
+                UINT z
+                  Block in the chunk, x and z below CHUNK_SIZE and y
+                  below the height
+                CHAR blockType
+                  Type of the block, EMPTY_BLOCK to remove it
+      Modifies: [m_uBitsPerIndex, m_aPalette, m_auColumnStarts,
+                 m_auRunEnds, m_auPackedIndices].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelChunkStorage::SetBlock(_In_ UINT x, _In_ UINT y, _In_ UINT z, _In_ CHAR blockType)
+    {
+        if (y >= m_uHeight || GetBlock(x, y, z) == blockType)
+        {
+            return;
+        }
+
+        std::vector<VoxelRun> aRuns;
+        GetColumnRuns(x, z, aRuns);
+
+        std::vector<CHAR> aBlocks(m_uHeight, HeightMap::EMPTY_BLOCK);
+        UINT uStart = 0u;
+        for (const VoxelRun& run : aRuns)
+        {
+            std::fill(aBlocks.begin() + uStart, aBlocks.begin() + run.uEnd, run.blockType);
+            uStart = run.uEnd;
+        }
+        aBlocks[y] = blockType;
+
+        // Neighboring blocks of the same type share a run, the empty blocks on top have none
+        aRuns.clear();
+        for (UINT uY = 0u; uY < m_uHeight; ++uY)
+        {
+            if (!aRuns.empty() && aRuns.back().blockType == aBlocks[uY])
+            {
+                aRuns.back().uEnd = uY + 1u;
+            }
+            else
+            {
+                aRuns.push_back(VoxelRun{ .uEnd = uY + 1u, .blockType = aBlocks[uY] });
+            }
+        }
+        if (!aRuns.empty() && aRuns.back().blockType == HeightMap::EMPTY_BLOCK)
+        {
+            aRuns.pop_back();
+        }
+
+        setColumnRuns(z * CHUNK_SIZE + x, aRuns);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkStorage::GetColumnRuns
+      Summary:  Returns the runs of a column, from the bottom up
+      Args:     UINT x
+                UINT z
+                  Column in the chunk, below CHUNK_SIZE
+                std::vector<VoxelRun>& aOutRuns
+                  Runs of the column, the blocks above the last one
+                  are empty
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelChunkStorage::GetColumnRuns(_In_ UINT x, _In_ UINT z, _Out_ std::vector<VoxelRun>& aOutRuns) const
+    {
+        UINT uColumn = z * CHUNK_SIZE + x;
+
+        aOutRuns.clear();
+        for (UINT uRun = m_auColumnStarts[uColumn]; uRun < m_auColumnStarts[uColumn + 1u]; ++uRun)
+        {
+            aOutRuns.push_back(VoxelRun{ .uEnd = m_auRunEnds[uRun], .blockType = m_aPalette[getPaletteIndex(uRun)] });
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkStorage::Serialize
+      Summary:  Appends the header, the palette, the number of runs of
+                every column, the run ends and the packed palette
+                indices to a byte array
+      Args:     std::vector<BYTE>& aBytes
+                  Bytes to append to
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelChunkStorage::Serialize(_Inout_ std::vector<BYTE>& aBytes) const
+    {
+        VoxelChunkStorageHeader header =
+        {
+            .uHeight = static_cast<UINT16>(m_uHeight),
+            .uNumPaletteEntries = static_cast<UINT8>(m_aPalette.size()),
+            .uBitsPerIndex = static_cast<UINT8>(m_uBitsPerIndex),
+            .uNumRuns = GetNumRuns()
+        };
+
+        std::vector<UINT16> auNumRuns(NUM_COLUMNS);
+        for (UINT uColumn = 0u; uColumn < NUM_COLUMNS; ++uColumn)
+        {
+            auNumRuns[uColumn] = static_cast<UINT16>(m_auColumnStarts[uColumn + 1u] - m_auColumnStarts[uColumn]);
+        }
+
+        appendBytes(aBytes, &header, sizeof(header));
+        appendBytes(aBytes, m_aPalette.data(), m_aPalette.size());
+        appendBytes(aBytes, auNumRuns.data(), auNumRuns.size() * sizeof(UINT16));
+        appendBytes(aBytes, m_auRunEnds.data(), m_auRunEnds.size() * sizeof(UINT16));
+        appendBytes(aBytes, m_auPackedIndices.data(), m_auPackedIndices.size() * sizeof(UINT));
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkStorage::Deserialize
+      Summary:  Reads a chunk written by Serialize. The chunk is left
+                unchanged when the bytes are not a valid chunk
+      Args:     const BYTE* pBytes
+                  Serialized chunk
+                size_t uSize
+                  Number of bytes available
+                size_t* puNumBytesRead
+                  Number of bytes of the chunk, can be nullptr
+      Modifies: [m_uHeight, m_uBitsPerIndex, m_aPalette,
+                 m_auColumnStarts, m_auRunEnds, m_auPackedIndices].
+      Returns:  HRESULT
+                  Status code, E_FAIL when the bytes are not a valid
+                  chunk
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT VoxelChunkStorage::Deserialize(_In_reads_bytes_(uSize) const BYTE* pBytes, _In_ size_t uSize, _Out_opt_ size_t* puNumBytesRead)
+    {
+        size_t uOffset = 0u;
+        VoxelChunkStorageHeader header;
+        if (!readBytes(pBytes, uSize, uOffset, &header, sizeof(header)) || header.uHeight == 0u ||
+            header.uNumPaletteEntries == 0u || header.uBitsPerIndex != getBitsPerIndex(header.uNumPaletteEntries))
+        {
+            return E_FAIL;
+        }
+
+        const UINT uIndicesPerWord = 32u / header.uBitsPerIndex;
+        std::vector<CHAR> aPalette(header.uNumPaletteEntries);
+        std::vector<UINT16> auNumRuns(NUM_COLUMNS);
+        std::vector<UINT16> auRunEnds(header.uNumRuns);
+        std::vector<UINT> auPackedIndices((static_cast<size_t>(header.uNumRuns) + uIndicesPerWord - 1u) / uIndicesPerWord);
+        if (!readBytes(pBytes, uSize, uOffset, aPalette.data(), aPalette.size()) ||
+            !readBytes(pBytes, uSize, uOffset, auNumRuns.data(), auNumRuns.size() * sizeof(UINT16)) ||
+            !readBytes(pBytes, uSize, uOffset, auRunEnds.data(), auRunEnds.size() * sizeof(UINT16)) ||
+            !readBytes(pBytes, uSize, uOffset, auPackedIndices.data(), auPackedIndices.size() * sizeof(UINT)) ||
+            aPalette[0] != HeightMap::EMPTY_BLOCK)
+        {
+            return E_FAIL;
+        }
+
+        // Runs must go up inside of the column, and stay below its top
+        std::vector<UINT> auColumnStarts(NUM_COLUMNS + 1u, 0u);
+        for (UINT uColumn = 0u; uColumn < NUM_COLUMNS; ++uColumn)
+        {
+            auColumnStarts[uColumn + 1u] = auColumnStarts[uColumn] + auNumRuns[uColumn];
+            if (auColumnStarts[uColumn + 1u] > header.uNumRuns)
+            {
+                return E_FAIL;
+            }
+
+            UINT uPreviousEnd = 0u;
+            for (UINT uRun = auColumnStarts[uColumn]; uRun < auColumnStarts[uColumn + 1u]; ++uRun)
+            {
+                if (auRunEnds[uRun] <= uPreviousEnd || auRunEnds[uRun] > header.uHeight)
+                {
+                    return E_FAIL;
+                }
+                uPreviousEnd = auRunEnds[uRun];
+            }
+        }
+
+        if (auColumnStarts[NUM_COLUMNS] != header.uNumRuns)
+        {
+            return E_FAIL;
+        }
+
+        for (UINT uRun = 0u; uRun < header.uNumRuns; ++uRun)
+        {
+            UINT uShift = (uRun % uIndicesPerWord) * header.uBitsPerIndex;
+            if (((auPackedIndices[uRun / uIndicesPerWord] >> uShift) & ((1u << header.uBitsPerIndex) - 1u)) >= header.uNumPaletteEntries)
+            {
+                return E_FAIL;
+            }
+        }
+
+        m_uHeight = header.uHeight;
+        m_uBitsPerIndex = header.uBitsPerIndex;
+        m_aPalette = std::move(aPalette);
+        m_auColumnStarts = std::move(auColumnStarts);
+        m_auRunEnds = std::move(auRunEnds);
+        m_auPackedIndices = std::move(auPackedIndices);
+
+        if (puNumBytesRead)
+        {
+            *puNumBytesRead = uOffset;
+        }
+
+        return S_OK;
+    }
+
+    UINT VoxelChunkStorage::GetHeight() const
+    {
+        return m_uHeight;
+    }
+
+    UINT VoxelChunkStorage::GetNumRuns() const
+    {
+        return static_cast<UINT>(m_auRunEnds.size());
+    }
+
+    UINT VoxelChunkStorage::GetNumPaletteEntries() const
+    {
+        return static_cast<UINT>(m_aPalette.size());
+    }
+
+    UINT VoxelChunkStorage::GetBitsPerIndex() const
+    {
+        return m_uBitsPerIndex;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkStorage::GetMemoryUsage
+      Summary:  Returns the bytes used by the chunk, including the
+                capacity of its arrays
+      Returns:  size_t
+                  Bytes used by the chunk
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    size_t VoxelChunkStorage::GetMemoryUsage() const
+    {
+        return sizeof(*this) +
+            m_aPalette.capacity() * sizeof(CHAR) +
+            m_auColumnStarts.capacity() * sizeof(UINT) +
+            m_auRunEnds.capacity() * sizeof(UINT16) +
+            m_auPackedIndices.capacity() * sizeof(UINT);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkStorage::GetSerializedSize
+      Summary:  Returns the bytes Serialize appends, without
+                serializing the chunk
+      Returns:  size_t
+                  Bytes of the serialized chunk
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    size_t VoxelChunkStorage::GetSerializedSize() const
+    {
+        return sizeof(VoxelChunkStorageHeader) +
+            ((m_aPalette.size() + 3u) & ~static_cast<size_t>(3u)) +
+            NUM_COLUMNS * sizeof(UINT16) +
+            ((m_auRunEnds.size() * sizeof(UINT16) + 3u) & ~static_cast<size_t>(3u)) +
+            m_auPackedIndices.size() * sizeof(UINT);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkStorage::GetMaxSerializedSize
+      Summary:  Returns the most bytes Serialize writes for a chunk of
+                a height: a full palette, one run per block of every
+                column and palette indices of 8 bits
+      Args:     UINT uHeight
+                  Number of blocks of a column
+      Returns:  size_t
+                  Bytes of the largest serialized chunk
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    size_t VoxelChunkStorage::GetMaxSerializedSize(_In_ UINT uHeight)
+    {
+        const size_t uMaxNumRuns = static_cast<size_t>(NUM_COLUMNS) * uHeight;
+        return sizeof(VoxelChunkStorageHeader) +
+            ((UINT8_MAX + 3u) & ~3u) +
+            NUM_COLUMNS * sizeof(UINT16) +
+            ((uMaxNumRuns * sizeof(UINT16) + 3u) & ~static_cast<size_t>(3u)) +
+            ((uMaxNumRuns + 3u) & ~static_cast<size_t>(3u));
+    }
+
+    UINT VoxelChunkStorage::getPaletteIndex(_In_ UINT uRun) const
+    {
+        const UINT uBit = uRun * m_uBitsPerIndex;
+        return (m_auPackedIndices[uBit / 32u] >> (uBit % 32u)) & ((1u << m_uBitsPerIndex) - 1u);
+    }
+
+    void VoxelChunkStorage::setPaletteIndex(_In_ UINT uRun, _In_ UINT uPaletteIndex)
+    {
+        const UINT uBit = uRun * m_uBitsPerIndex;
+        UINT& uWord = m_auPackedIndices[uBit / 32u];
+        uWord = (uWord & ~(((1u << m_uBitsPerIndex) - 1u) << (uBit % 32u))) | (uPaletteIndex << (uBit % 32u));
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkStorage::findOrAddPaletteEntry
+      Summary:  Returns the palette index of a block type, adding the
+                type to the palette and widening the packed indices
+                when needed
+      Args:     CHAR blockType
+                  Type of block
+      Modifies: [m_aPalette, m_uBitsPerIndex, m_auPackedIndices].
+      Returns:  UINT
+                  Palette index of the block type
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT VoxelChunkStorage::findOrAddPaletteEntry(_In_ CHAR blockType)
+    {
+        auto it = std::find(m_aPalette.begin(), m_aPalette.end(), blockType);
+        if (it != m_aPalette.end())
+        {
+            return static_cast<UINT>(it - m_aPalette.begin());
+        }
+
+        m_aPalette.push_back(blockType);
+        if (getBitsPerIndex(m_aPalette.size()) != m_uBitsPerIndex)
+        {
+            repack(getBitsPerIndex(m_aPalette.size()));
+        }
+
+        return static_cast<UINT>(m_aPalette.size() - 1u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkStorage::repack
+      Summary:  Packs the palette indices of every run on a new number
+                of bits
+      Args:     UINT uBitsPerIndex
+                  Bits of a palette index, 1, 2, 4 or 8
+      Modifies: [m_uBitsPerIndex, m_auPackedIndices].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelChunkStorage::repack(_In_ UINT uBitsPerIndex)
+    {
+        std::vector<BYTE> auPaletteIndices(m_auRunEnds.size());
+        for (UINT uRun = 0u; uRun < static_cast<UINT>(auPaletteIndices.size()); ++uRun)
+        {
+            auPaletteIndices[uRun] = static_cast<BYTE>(getPaletteIndex(uRun));
+        }
+
+        m_uBitsPerIndex = uBitsPerIndex;
+        const UINT uIndicesPerWord = 32u / m_uBitsPerIndex;
+        m_auPackedIndices.assign((auPaletteIndices.size() + uIndicesPerWord - 1u) / uIndicesPerWord, 0u);
+        for (UINT uRun = 0u; uRun < static_cast<UINT>(auPaletteIndices.size()); ++uRun)
+        {
+            setPaletteIndex(uRun, auPaletteIndices[uRun]);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkStorage::setColumnRuns
+      Summary:  Replaces the runs of a column. The runs of the
+                following columns move when the number of runs
+                changes, so the cost grows with the number of runs of
+                the chunk
+      Args:     UINT uColumn
+                  Column in the chunk, z * CHUNK_SIZE + x
+                const std::vector<VoxelRun>& aRuns
+                  New runs of the column
+      Modifies: [m_aPalette, m_uBitsPerIndex, m_auColumnStarts,
+                 m_auRunEnds, m_auPackedIndices].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelChunkStorage::setColumnRuns(_In_ UINT uColumn, _In_ const std::vector<VoxelRun>& aRuns)
+    {
+        std::vector<BYTE> auNewIndices(aRuns.size());
+        for (size_t i = 0u; i < aRuns.size(); ++i)
+        {
+            auNewIndices[i] = static_cast<BYTE>(findOrAddPaletteEntry(aRuns[i].blockType));
+        }
+
+        const UINT uFirst = m_auColumnStarts[uColumn];
+        const UINT uOldCount = m_auColumnStarts[uColumn + 1u] - uFirst;
+        const UINT uNewCount = static_cast<UINT>(aRuns.size());
+        const UINT uNumRuns = GetNumRuns() - uOldCount + uNewCount;
+
+        // Most edits move the top of a run, the runs stay in place
+        if (uNewCount == uOldCount)
+        {
+            for (UINT i = 0u; i < uNewCount; ++i)
+            {
+                m_auRunEnds[uFirst + i] = static_cast<UINT16>(aRuns[i].uEnd);
+                setPaletteIndex(uFirst + i, auNewIndices[i]);
+            }
+            return;
+        }
+
+        // Indices of the following runs, read before their runs move
+        std::vector<BYTE> auTailIndices(GetNumRuns() - uFirst - uOldCount);
+        for (UINT i = 0u; i < static_cast<UINT>(auTailIndices.size()); ++i)
+        {
+            auTailIndices[i] = static_cast<BYTE>(getPaletteIndex(uFirst + uOldCount + i));
+        }
+
+        m_auRunEnds.erase(m_auRunEnds.begin() + uFirst, m_auRunEnds.begin() + uFirst + uOldCount);
+        std::vector<UINT16> auNewEnds(aRuns.size());
+        std::transform(aRuns.begin(), aRuns.end(), auNewEnds.begin(), [](const VoxelRun& run) { return static_cast<UINT16>(run.uEnd); });
+        m_auRunEnds.insert(m_auRunEnds.begin() + uFirst, auNewEnds.begin(), auNewEnds.end());
+
+        const UINT uIndicesPerWord = 32u / m_uBitsPerIndex;
+        m_auPackedIndices.resize((static_cast<size_t>(uNumRuns) + uIndicesPerWord - 1u) / uIndicesPerWord, 0u);
+        for (UINT i = 0u; i < uNewCount; ++i)
+        {
+            setPaletteIndex(uFirst + i, auNewIndices[i]);
+        }
+        for (UINT i = 0u; i < static_cast<UINT>(auTailIndices.size()); ++i)
+        {
+            setPaletteIndex(uFirst + uNewCount + i, auTailIndices[i]);
+        }
+
+        for (UINT uNext = uColumn + 1u; uNext <= NUM_COLUMNS; ++uNext)
+        {
+            m_auColumnStarts[uNext] = m_auColumnStarts[uNext] - uOldCount + uNewCount;
+        }
+    }
+}
\ No newline at end of file
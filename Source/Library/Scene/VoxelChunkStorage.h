@@ -0,0 +1,140 @@
+/*+===================================================================
+  File:      VOXELCHUNKSTORAGE.H
+
+  Summary:   VoxelChunkStorage header file contains declarations of
+             VoxelChunkStorage class used to store the blocks of a
+             chunk of columns with a palette and run-length encoded
+             columns.
+
+  Classes: VoxelChunkStorage
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Scene/HeightMap.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   VoxelRun
+
+        Summary:  Blocks of a column of the same type, from the end of
+                  the previous run, or 0, up to uEnd excluded
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct VoxelRun
+    {
+        UINT uEnd;
+        CHAR blockType;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   VoxelChunkStorageHeader
+
+        Summary:  Header of a serialized chunk. It is followed by the
+                  palette (uNumPaletteEntries CHARs, padded to 4
+                  bytes), the number of runs of every column
+                  (CHUNK_SIZE^2 UINT16s), the end of every run
+                  (uNumRuns UINT16s, padded to 4 bytes) and the packed
+                  palette indices of the runs (UINT32s)
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct VoxelChunkStorageHeader
+    {
+        UINT16 uHeight;
+        UINT8 uNumPaletteEntries;
+        UINT8 uBitsPerIndex;
+        UINT32 uNumRuns;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    VoxelChunkStorage
+
+      Summary:  Blocks of CHUNK_SIZE x CHUNK_SIZE columns. The block
+                types of the chunk are kept in a small palette whose
+                first entry is EMPTY_BLOCK. Every column is a list of
+                runs, each run stores its end height and its palette
+                index packed on 1, 2, 4 or 8 bits. Blocks above the
+                last run are empty, so a terrain column usually takes
+                a single run. Looking a block up walks the runs of its
+                column only
+
+      Methods:  GetBlock
+                  Returns the type of a block
+                SetBlock
+                  Sets the type of a block
+                GetColumnRuns
+                  Returns the runs of a column
+                Serialize
+                  Appends the chunk to a byte array
+                Deserialize
+                  Reads a chunk written by Serialize
+                GetHeight
+                  Returns the number of blocks of a column
+                GetNumRuns
+                  Returns the number of runs of the chunk
+                GetNumPaletteEntries
+                  Returns the number of block types of the chunk
+                GetBitsPerIndex
+                  Returns the size of a packed palette index
+                GetMemoryUsage
+                  Returns the bytes used by the chunk
+                GetSerializedSize
+                  Returns the bytes Serialize appends
+                GetMaxSerializedSize
+                  Returns the most bytes a chunk serializes to
+                VoxelChunkStorage
+                  Constructor.
+                ~VoxelChunkStorage
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class VoxelChunkStorage
+    {
+    public:
+        static constexpr const UINT CHUNK_SIZE = 32u;
+
+        VoxelChunkStorage() = delete;
+        VoxelChunkStorage(_In_ UINT uHeight);
+        VoxelChunkStorage(_In_ const HeightMap& heightMap, _In_ UINT uFirstX, _In_ UINT uFirstZ);
+        VoxelChunkStorage(_In_ UINT uHeight, _In_reads_(CHUNK_SIZE * CHUNK_SIZE * uHeight) const CHAR* aBlocks);
+        VoxelChunkStorage(const VoxelChunkStorage& other) = default;
+        VoxelChunkStorage(VoxelChunkStorage&& other) = default;
+        VoxelChunkStorage& operator=(const VoxelChunkStorage& other) = default;
+        VoxelChunkStorage& operator=(VoxelChunkStorage&& other) = default;
+        ~VoxelChunkStorage() = default;
+
+        CHAR GetBlock(_In_ UINT x, _In_ UINT y, _In_ UINT z) const;
+        void SetBlock(_In_ UINT x, _In_ UINT y, _In_ UINT z, _In_ CHAR blockType);
+        void GetColumnRuns(_In_ UINT x, _In_ UINT z, _Out_ std::vector<VoxelRun>& aOutRuns) const;
+
+        void Serialize(_Inout_ std::vector<BYTE>& aBytes) const;
+        HRESULT Deserialize(_In_reads_bytes_(uSize) const BYTE* pBytes, _In_ size_t uSize, _Out_opt_ size_t* puNumBytesRead);
+
+        UINT GetHeight() const;
+        UINT GetNumRuns() const;
+        UINT GetNumPaletteEntries() const;
+        UINT GetBitsPerIndex() const;
+        size_t GetMemoryUsage() const;
+        size_t GetSerializedSize() const;
+
+        static size_t GetMaxSerializedSize(_In_ UINT uHeight);
+
+    private:
+        static constexpr const UINT NUM_COLUMNS = CHUNK_SIZE * CHUNK_SIZE;
+
+        UINT getPaletteIndex(_In_ UINT uRun) const;
+        void setPaletteIndex(_In_ UINT uRun, _In_ UINT uPaletteIndex);
+        UINT findOrAddPaletteEntry(_In_ CHAR blockType);
+        void repack(_In_ UINT uBitsPerIndex);
+        void setColumnRuns(_In_ UINT uColumn, _In_ const std::vector<VoxelRun>& aRuns);
+
+    private:
+        UINT m_uHeight;
+        UINT m_uBitsPerIndex;
+        std::vector<CHAR> m_aPalette;
+        std::vector<UINT> m_auColumnStarts;
+        std::vector<UINT16> m_auRunEnds;
+        std::vector<UINT> m_auPackedIndices;
+    };
+}
\ No newline at end of file
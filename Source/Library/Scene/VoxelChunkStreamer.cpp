@@ -0,0 +1,635 @@
+#include "Scene/VoxelChunkStreamer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+namespace library
+{
+    namespace
+    {
+        LONGLONG getPerformanceCounter()
+        {
+            LARGE_INTEGER counter;
+            QueryPerformanceCounter(&counter);
+            return counter.QuadPart;
+        }
+
+        DOUBLE getElapsedMilliseconds(_In_ LONGLONG startCounter)
+        {
+            LARGE_INTEGER frequency;
+            QueryPerformanceFrequency(&frequency);
+            return static_cast<DOUBLE>(getPerformanceCounter() - startCounter) * 1000.0 / static_cast<DOUBLE>(frequency.QuadPart);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkStreamer::GetColumnBytes
+      Summary:  Returns the memory of a column of chunks: the mesh,
+                block types and colors kept on the CPU, and the vertex,
+                color and index buffers on the GPU. The constants of its
+                draws go to the renderer's constant buffer ring, which
+                the chunks do not own
+      Args:     const std::vector<std::shared_ptr<VoxelChunk>>& aChunks
+                  Chunks of the column
+      Returns:  UINT64
+                  Number of bytes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT64 VoxelChunkStreamer::GetColumnBytes(_In_ const std::vector<std::shared_ptr<VoxelChunk>>& aChunks)
+    {
+        UINT64 uBytes = 0u;
+        for (const std::shared_ptr<VoxelChunk>& chunk : aChunks)
+        {
+            UINT64 uNumVertices = chunk->GetNumVertices();
+            UINT64 uNumIndices = chunk->GetNumIndices();
+
+            UINT64 uCpuBytes = uNumVertices * (sizeof(SimpleVertex) + sizeof(CHAR) + sizeof(XMFLOAT4)) + uNumIndices * sizeof(WORD);
+            UINT64 uGpuBytes = uNumVertices * (sizeof(SimpleVertex) + sizeof(XMFLOAT4)) + uNumIndices * sizeof(WORD);
+
+            uBytes += uCpuBytes + uGpuBytes;
+        }
+
+        return uBytes;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkStreamer::VoxelChunkStreamer
+      Summary:  Constructor
+      Args:     const ChunkStreamingDesc& desc
+                  Source and limits of the streamed world
+      Modifies: [m_desc, m_generator, m_aPalette, m_pDevice,
+                 m_vertexShader, m_pixelShader, m_residentColumns,
+                 m_aResidentChunks, m_bResidentChunksDirty,
+                 m_cameraColumnX, m_cameraColumnZ, m_uStreamRadius,
+                 m_stats, m_aRequests, m_inFlightKeys, m_loadedColumns,
+                 m_aRetiredColumns, m_bStopping, m_workers].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    VoxelChunkStreamer::VoxelChunkStreamer(_In_ const ChunkStreamingDesc& desc)
+        : m_desc(desc)
+        , m_generator(desc.terrain)
+        , m_aPalette(TerrainGenerator::GetPalette())
+        , m_pDevice(nullptr)
+        , m_vertexShader()
+        , m_pixelShader()
+        , m_residentColumns()
+        , m_aResidentChunks()
+        , m_bResidentChunksDirty(FALSE)
+        , m_cameraColumnX(-1)
+        , m_cameraColumnZ(-1)
+        , m_uStreamRadius(1u)
+        , m_stats()
+        , m_mutex()
+        , m_workAvailable()
+        , m_aRequests()
+        , m_inFlightKeys()
+        , m_loadedColumns()
+        , m_aRetiredColumns()
+        , m_bStopping(FALSE)
+        , m_workers()
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkStreamer::~VoxelChunkStreamer
+      Summary:  Destructor. Stops the workers, a column being loaded
+                is finished first
+      Modifies: [m_bStopping, m_workers].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    VoxelChunkStreamer::~VoxelChunkStreamer()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_bStopping = TRUE;
+        }
+        m_workAvailable.notify_all();
+
+        for (std::thread& worker : m_workers)
+        {
+            worker.join();
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkStreamer::Initialize
+      Summary:  Starts the worker threads. Without a device the chunks
+                are only meshed, which is enough to measure the
+                streaming headless
+      Args:     RenderDevice* pDevice
+                  The render device to create the buffers on the
+                  workers, or nullptr
+      Modifies: [m_pDevice, m_workers].
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT VoxelChunkStreamer::Initialize(_In_opt_ RenderDevice* pDevice)
+    {
+        if (!m_workers.empty())
+        {
+            return S_OK;
+        }
+
+        m_pDevice = pDevice;
+
+        UINT uNumWorkers = m_desc.uNumWorkers;
+        if (uNumWorkers == 0u)
+        {
+            uNumWorkers = std::max(std::thread::hardware_concurrency(), 2u) - 1u;
+        }
+
+        m_workers.reserve(uNumWorkers);
+        for (UINT i = 0u; i < uNumWorkers; ++i)
+        {
+            m_workers.emplace_back(&VoxelChunkStreamer::runWorker, this);
+        }
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkStreamer::Update
+      Summary:  Streams the chunks around the camera. When the camera
+                enters a new column, the missing columns in the stream
+                radius are queued nearest first. Then at most
+                uMaxLoadsPerFrame finished columns become resident and
+                at most uMaxEvictionsPerFrame columns are evicted, the
+                farthest first. Columns are kept one column past the
+                radius so moving back and forth does not reload them.
+                The radius starts at one column and widens one column
+                at a time, after the previous radius is loaded, up to
+                uLoadRadius or to the radius the budget can hold
+      Args:     const XMVECTOR& eye
+                  Position of the camera
+      Modifies: [m_residentColumns, m_aResidentChunks,
+                 m_bResidentChunksDirty, m_cameraColumnX,
+                 m_cameraColumnZ, m_uStreamRadius, m_stats,
+                 m_inFlightKeys, m_loadedColumns, m_aRetiredColumns].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelChunkStreamer::Update(_In_ const XMVECTOR& eye)
+    {
+        LONGLONG startCounter = getPerformanceCounter();
+
+        // Block x is centered on 2 * (x - WORLD_ORIGIN)
+        const DOUBLE maxCell = static_cast<DOUBLE>(WORLD_SIZE - 1u);
+        DOUBLE cellX = std::clamp(std::round(static_cast<DOUBLE>(XMVectorGetX(eye)) * 0.5) + WORLD_ORIGIN, 0.0, maxCell);
+        DOUBLE cellZ = std::clamp(std::round(static_cast<DOUBLE>(XMVectorGetZ(eye)) * 0.5) + WORLD_ORIGIN, 0.0, maxCell);
+
+        INT cameraColumnX = static_cast<INT>(cellX) / static_cast<INT>(CHUNK_SIZE);
+        INT cameraColumnZ = static_cast<INT>(cellZ) / static_cast<INT>(CHUNK_SIZE);
+
+        BOOL bRequest = cameraColumnX != m_cameraColumnX || cameraColumnZ != m_cameraColumnZ;
+        m_cameraColumnX = cameraColumnX;
+        m_cameraColumnZ = cameraColumnZ;
+
+        UINT64 uKeepRadiusSquared = static_cast<UINT64>(m_uStreamRadius + 1u) * (m_uStreamRadius + 1u);
+
+        // Integrate the columns finished by the workers
+        std::vector<LoadedColumn> aLoadedColumns;
+        BOOL bIdle = FALSE;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            size_t uNumLoaded = std::min(m_loadedColumns.size(), static_cast<size_t>(m_desc.uMaxLoadsPerFrame));
+            aLoadedColumns.reserve(uNumLoaded);
+            for (size_t i = 0u; i < uNumLoaded; ++i)
+            {
+                m_inFlightKeys.erase(m_loadedColumns.front().uKey);
+                aLoadedColumns.push_back(std::move(m_loadedColumns.front()));
+                m_loadedColumns.pop_front();
+            }
+
+            bIdle = m_aRequests.empty() && m_inFlightKeys.empty();
+        }
+
+        std::vector<Column> aRetiredColumns;
+        UINT64 uNumDiscarded = 0u;
+        for (LoadedColumn& loadedColumn : aLoadedColumns)
+        {
+            if (getDistanceSquared(loadedColumn.uKey) > uKeepRadiusSquared)
+            {
+                aRetiredColumns.push_back(std::move(loadedColumn.column));
+                ++uNumDiscarded;
+                continue;
+            }
+
+            for (std::shared_ptr<VoxelChunk>& chunk : loadedColumn.column.aChunks)
+            {
+                chunk->SetVertexShader(m_vertexShader);
+                chunk->SetPixelShader(m_pixelShader);
+            }
+
+            m_stats.uResidentBytes += loadedColumn.column.uBytes;
+            m_residentColumns.emplace(loadedColumn.uKey, std::move(loadedColumn.column));
+            m_bResidentChunksDirty = TRUE;
+        }
+
+        // Fit the radius to the budget right away, but only widen it once the current one is loaded
+        UINT uBudgetRadius = getBudgetRadius();
+        if (uBudgetRadius < m_uStreamRadius || (uBudgetRadius > m_uStreamRadius && bIdle))
+        {
+            m_uStreamRadius = uBudgetRadius < m_uStreamRadius ? uBudgetRadius : m_uStreamRadius + 1u;
+            uKeepRadiusSquared = static_cast<UINT64>(m_uStreamRadius + 1u) * (m_uStreamRadius + 1u);
+            bRequest = TRUE;
+        }
+
+        // Evict the columns out of range, the farthest first
+        std::vector<std::pair<UINT64, UINT64>> aCandidates;
+        for (const auto& [uKey, column] : m_residentColumns)
+        {
+            UINT64 uDistanceSquared = getDistanceSquared(uKey);
+            if (uDistanceSquared > uKeepRadiusSquared)
+            {
+                aCandidates.emplace_back(uDistanceSquared, uKey);
+            }
+        }
+
+        UINT uNumEvicted = 0u;
+        std::sort(aCandidates.begin(), aCandidates.end(), std::greater<>());
+        for (const auto& [uDistanceSquared, uKey] : aCandidates)
+        {
+            if (uNumEvicted == m_desc.uMaxEvictionsPerFrame)
+            {
+                break;
+            }
+
+            evictColumn(uKey, aRetiredColumns);
+            ++uNumEvicted;
+        }
+
+        // The estimate was too optimistic: once everything past the radius is gone, pull the radius in
+        if (m_stats.uResidentBytes > m_desc.uMemoryBudget && uNumEvicted == aCandidates.size() && m_uStreamRadius > 1u)
+        {
+            --m_uStreamRadius;
+            bRequest = TRUE;
+        }
+
+        if (m_bResidentChunksDirty)
+        {
+            m_aResidentChunks.clear();
+            for (const auto& [uKey, column] : m_residentColumns)
+            {
+                m_aResidentChunks.insert(m_aResidentChunks.end(), column.aChunks.begin(), column.aChunks.end());
+            }
+            m_bResidentChunksDirty = FALSE;
+        }
+
+        // The retired chunks are no longer referenced by the resident list, the workers hold the last reference
+        if (!aRetiredColumns.empty())
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                std::move(aRetiredColumns.begin(), aRetiredColumns.end(), std::back_inserter(m_aRetiredColumns));
+            }
+            m_workAvailable.notify_one();
+        }
+
+        if (bRequest)
+        {
+            requestColumns();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stats.uNumQueuedColumns = static_cast<UINT>(m_aRequests.size() + m_inFlightKeys.size());
+        }
+
+        m_stats.uNumResidentColumns = static_cast<UINT>(m_residentColumns.size());
+        m_stats.uNumResidentChunks = static_cast<UINT>(m_aResidentChunks.size());
+        m_stats.uNumLoadedColumns = static_cast<UINT>(aLoadedColumns.size() - uNumDiscarded);
+        m_stats.uNumEvictedColumns = uNumEvicted;
+        m_stats.uStreamRadius = m_uStreamRadius;
+        m_stats.uPeakResidentBytes = std::max(m_stats.uPeakResidentBytes, m_stats.uResidentBytes);
+        m_stats.uTotalLoadedColumns += aLoadedColumns.size() - uNumDiscarded;
+        m_stats.uTotalDiscardedColumns += uNumDiscarded;
+        m_stats.uTotalEvictedColumns += uNumEvicted;
+        m_stats.updateMilliseconds = getElapsedMilliseconds(startCounter);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkStreamer::SetVertexShader
+      Summary:  Sets the vertex shader of the resident chunks and of
+                the chunks streamed in later
+      Args:     const std::shared_ptr<VertexShader>& vertexShader
+                  Vertex shader
+      Modifies: [m_vertexShader, m_residentColumns].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelChunkStreamer::SetVertexShader(_In_ const std::shared_ptr<VertexShader>& vertexShader)
+    {
+        m_vertexShader = vertexShader;
+        for (std::shared_ptr<VoxelChunk>& chunk : m_aResidentChunks)
+        {
+            chunk->SetVertexShader(vertexShader);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkStreamer::SetPixelShader
+      Summary:  Sets the pixel shader of the resident chunks and of
+                the chunks streamed in later
+      Args:     const std::shared_ptr<PixelShader>& pixelShader
+                  Pixel shader
+      Modifies: [m_pixelShader, m_residentColumns].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelChunkStreamer::SetPixelShader(_In_ const std::shared_ptr<PixelShader>& pixelShader)
+    {
+        m_pixelShader = pixelShader;
+        for (std::shared_ptr<VoxelChunk>& chunk : m_aResidentChunks)
+        {
+            chunk->SetPixelShader(pixelShader);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkStreamer::GetResidentChunks
+      Summary:  Returns the chunks ready to be drawn, valid until the
+                next update
+      Returns:  std::vector<std::shared_ptr<VoxelChunk>>&
+                  Resident chunks
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    std::vector<std::shared_ptr<VoxelChunk>>& VoxelChunkStreamer::GetResidentChunks()
+    {
+        return m_aResidentChunks;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkStreamer::GetStats
+      Summary:  Returns the state of the streamer after the last update
+      Returns:  const ChunkStreamingStats&
+                  Streaming statistics
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const ChunkStreamingStats& VoxelChunkStreamer::GetStats() const
+    {
+        return m_stats;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkStreamer::makeKey
+      Summary:  Packs the coordinates of a column into a key
+      Args:     UINT uColumnX
+                UINT uColumnZ
+                  Coordinates of the column
+      Returns:  UINT64
+                  Key of the column
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT64 VoxelChunkStreamer::makeKey(_In_ UINT uColumnX, _In_ UINT uColumnZ)
+    {
+        return (static_cast<UINT64>(uColumnX) << 32u) | uColumnZ;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkStreamer::getColumnX
+      Summary:  Returns the x coordinate of a column
+      Args:     UINT64 uKey
+                  Key of the column
+      Returns:  UINT
+                  Column coordinate
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT VoxelChunkStreamer::getColumnX(_In_ UINT64 uKey)
+    {
+        return static_cast<UINT>(uKey >> 32u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkStreamer::getColumnZ
+      Summary:  Returns the z coordinate of a column
+      Args:     UINT64 uKey
+                  Key of the column
+      Returns:  UINT
+                  Column coordinate
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT VoxelChunkStreamer::getColumnZ(_In_ UINT64 uKey)
+    {
+        return static_cast<UINT>(uKey & 0xFFFFFFFFull);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkStreamer::runWorker
+      Summary:  Releases the evicted columns and loads the nearest
+                requested column until the streamer is destroyed
+      Modifies: [m_aRequests, m_inFlightKeys, m_loadedColumns,
+                 m_aRetiredColumns].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelChunkStreamer::runWorker()
+    {
+        for (;;)
+        {
+            std::vector<Column> aRetiredColumns;
+            UINT64 uKey = 0u;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_workAvailable.wait(lock, [this]() { return m_bStopping || !m_aRequests.empty() || !m_aRetiredColumns.empty(); });
+                if (m_bStopping)
+                {
+                    return;
+                }
+
+                aRetiredColumns.swap(m_aRetiredColumns);
+                if (m_aRequests.empty())
+                {
+                    continue;
+                }
+
+                uKey = m_aRequests.back();
+                m_aRequests.pop_back();
+                m_inFlightKeys.insert(uKey);
+            }
+
+            // The buffers of the evicted columns are released here rather than in the frame
+            aRetiredColumns.clear();
+
+            LoadedColumn loadedColumn =
+            {
+                .uKey = uKey
+            };
+            HRESULT hr = loadColumn(uKey, loadedColumn.column);
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (FAILED(hr))
+            {
+                m_inFlightKeys.erase(uKey);
+                continue;
+            }
+            m_loadedColumns.push_back(std::move(loadedColumn));
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkStreamer::loadColumn
+      Summary:  Generates a column of cells with a one-cell border,
+                meshes its chunks and creates their buffers when there
+                is a device
+      Args:     UINT64 uKey
+                  Key of the column
+                Column& outColumn
+                  Chunks of the column
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT VoxelChunkStreamer::loadColumn(_In_ UINT64 uKey, _Out_ Column& outColumn) const
+    {
+        outColumn = Column
+        {
+            .aChunks = {},
+            .uBytes = 0u
+        };
+
+        UINT uColumnX = getColumnX(uKey);
+        UINT uColumnZ = getColumnZ(uKey);
+
+        HeightMap heightMap;
+        HRESULT hr = m_generator.GenerateRegion(uColumnX * CHUNK_SIZE - 1u, uColumnZ * CHUNK_SIZE - 1u, CHUNK_SIZE + 2u, CHUNK_SIZE + 2u, heightMap);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        // Same vertical placement as the instanced voxels, horizontally block x is centered on 2 * (x - WORLD_ORIGIN)
+        FLOAT height = static_cast<FLOAT>(heightMap.GetHeight());
+        XMFLOAT3 origin(
+            2.0f * static_cast<FLOAT>(static_cast<INT>(uColumnX * CHUNK_SIZE) - static_cast<INT>(WORLD_ORIGIN)) - 1.0f,
+            -2.0f * height + 0.75f * height - 1.0f,
+            2.0f * static_cast<FLOAT>(static_cast<INT>(uColumnZ * CHUNK_SIZE) - static_cast<INT>(WORLD_ORIGIN)) - 1.0f
+        );
+        VoxelGrid grid(heightMap);
+        VoxelChunkMesher mesher(grid, m_desc.meshing, origin, 1u);
+
+        for (UINT uChunkY = 0u; uChunkY < mesher.GetNumChunksY(); ++uChunkY)
+        {
+            VoxelChunkMesh mesh;
+            mesher.MeshChunk(0u, uChunkY, 0u, mesh);
+            if (mesh.aVertices.empty())
+            {
+                continue;
+            }
+
+            mesh.uChunkX = uColumnX;
+            mesh.uChunkZ = uColumnZ;
+
+            std::shared_ptr<VoxelChunk> chunk = std::make_shared<VoxelChunk>(std::move(mesh), m_aPalette);
+            if (m_pDevice)
+            {
+                hr = chunk->Initialize(m_pDevice);
+                if (FAILED(hr))
+                {
+                    return hr;
+                }
+            }
+
+            outColumn.aChunks.push_back(chunk);
+        }
+
+        outColumn.uBytes = GetColumnBytes(outColumn.aChunks);
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkStreamer::getDistanceSquared
+      Summary:  Returns the squared distance in columns between a
+                column and the column of the camera
+      Args:     UINT64 uKey
+                  Key of the column
+      Returns:  UINT64
+                  Squared distance
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT64 VoxelChunkStreamer::getDistanceSquared(_In_ UINT64 uKey) const
+    {
+        INT64 dx = static_cast<INT64>(getColumnX(uKey)) - m_cameraColumnX;
+        INT64 dz = static_cast<INT64>(getColumnZ(uKey)) - m_cameraColumnZ;
+
+        return static_cast<UINT64>(dx * dx + dz * dz);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkStreamer::getBudgetRadius
+      Summary:  Returns the largest radius whose kept disc of columns
+                fits in the memory budget at the average size of the
+                resident columns
+      Returns:  UINT
+                  Radius in columns, between 1 and uLoadRadius
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT VoxelChunkStreamer::getBudgetRadius() const
+    {
+        UINT uMaxRadius = std::max(m_desc.uLoadRadius, 1u);
+        if (m_residentColumns.empty())
+        {
+            return uMaxRadius;
+        }
+
+        // About pi * (radius + 1)^2 columns are kept
+        DOUBLE averageBytes = static_cast<DOUBLE>(m_stats.uResidentBytes) / static_cast<DOUBLE>(m_residentColumns.size());
+        DOUBLE maxColumns = static_cast<DOUBLE>(m_desc.uMemoryBudget) / std::max(averageBytes, 1.0);
+        DOUBLE radius = std::floor(std::sqrt(maxColumns / 3.14159265358979323846)) - 1.0;
+
+        return static_cast<UINT>(std::clamp(radius, 1.0, static_cast<DOUBLE>(uMaxRadius)));
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkStreamer::requestColumns
+      Summary:  Replaces the queue of the workers with the columns in
+                the stream radius that are neither resident nor being
+                loaded, the nearest at the back
+      Modifies: [m_aRequests].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelChunkStreamer::requestColumns()
+    {
+        const INT radius = static_cast<INT>(m_uStreamRadius);
+        const UINT64 uRadiusSquared = static_cast<UINT64>(m_uStreamRadius) * m_uStreamRadius;
+
+        // The border cells of a column must stay inside the world
+        const INT minColumn = 1;
+        const INT maxColumn = static_cast<INT>(WORLD_SIZE / CHUNK_SIZE) - 2;
+
+        std::vector<std::pair<UINT64, UINT64>> aCandidates;
+        for (INT columnZ = std::max(m_cameraColumnZ - radius, minColumn); columnZ <= std::min(m_cameraColumnZ + radius, maxColumn); ++columnZ)
+        {
+            for (INT columnX = std::max(m_cameraColumnX - radius, minColumn); columnX <= std::min(m_cameraColumnX + radius, maxColumn); ++columnX)
+            {
+                UINT64 uKey = makeKey(static_cast<UINT>(columnX), static_cast<UINT>(columnZ));
+                UINT64 uDistanceSquared = getDistanceSquared(uKey);
+                if (uDistanceSquared <= uRadiusSquared && !m_residentColumns.contains(uKey))
+                {
+                    aCandidates.emplace_back(uDistanceSquared, uKey);
+                }
+            }
+        }
+        std::sort(aCandidates.begin(), aCandidates.end(), std::greater<>());
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            m_aRequests.clear();
+            for (const auto& [uDistanceSquared, uKey] : aCandidates)
+            {
+                if (!m_inFlightKeys.contains(uKey))
+                {
+                    m_aRequests.push_back(uKey);
+                }
+            }
+        }
+        m_workAvailable.notify_all();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelChunkStreamer::evictColumn
+      Summary:  Removes a column from the resident set
+      Args:     UINT64 uKey
+                  Key of the column
+                std::vector<Column>& aRetiredColumns
+                  Columns to be released by the workers
+      Modifies: [m_residentColumns, m_bResidentChunksDirty, m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelChunkStreamer::evictColumn(_In_ UINT64 uKey, _Inout_ std::vector<Column>& aRetiredColumns)
+    {
+        auto it = m_residentColumns.find(uKey);
+        if (it == m_residentColumns.end())
+        {
+            return;
+        }
+
+        m_stats.uResidentBytes -= it->second.uBytes;
+
+        aRetiredColumns.push_back(std::move(it->second));
+        m_residentColumns.erase(it);
+        m_bResidentChunksDirty = TRUE;
+    }
+}
\ No newline at end of file
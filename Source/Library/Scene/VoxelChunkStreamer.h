@@ -0,0 +1,183 @@
+/*+===================================================================
+  File:      VOXELCHUNKSTREAMER.H
+
+  Summary:   VoxelChunkStreamer header file contains declarations of
+             VoxelChunkStreamer class used to page the chunks of an
+             unbounded voxel world in and out around the camera.
+
+  Classes: VoxelChunkStreamer
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "Scene/TerrainGenerator.h"
+#include "Scene/VoxelChunk.h"
+#include "Scene/VoxelChunkMesher.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   ChunkStreamingDesc
+
+        Summary:  Source and limits of the streamed world. The width
+                  and the depth of the terrain are ignored, the world
+                  spans WORLD_SIZE cells along the x and the z axes
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct ChunkStreamingDesc
+    {
+        TerrainDesc terrain;
+        eVoxelMeshing meshing;
+        UINT uLoadRadius;
+        UINT64 uMemoryBudget;
+        UINT uMaxLoadsPerFrame;
+        UINT uMaxEvictionsPerFrame;
+        UINT uNumWorkers;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   ChunkStreamingStats
+
+        Summary:  State of the streamer after the last update. Memory
+                  counts the CPU copy and the GPU buffers of the
+                  resident chunks. Discarded columns were out of
+                  range by the time they were loaded
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct ChunkStreamingStats
+    {
+        UINT uNumResidentColumns;
+        UINT uNumResidentChunks;
+        UINT uNumQueuedColumns;
+        UINT uNumLoadedColumns;
+        UINT uNumEvictedColumns;
+        UINT uStreamRadius;
+        UINT64 uResidentBytes;
+        UINT64 uPeakResidentBytes;
+        UINT64 uTotalLoadedColumns;
+        UINT64 uTotalEvictedColumns;
+        UINT64 uTotalDiscardedColumns;
+        DOUBLE updateMilliseconds;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    VoxelChunkStreamer
+
+      Summary:  Keeps the chunk columns around the camera resident.
+                Worker threads generate, mesh and, when a device is
+                given, create the immutable buffers of the columns
+                nearest to the camera first. Update only moves
+                finished columns into the resident set and evicts the
+                columns out of range or over the memory budget, a
+                bounded number per frame. Evicted columns are
+                released by the workers
+
+      Methods:  Initialize
+                  Starts the worker threads
+                Update
+                  Streams the chunks around the camera
+                SetVertexShader / SetPixelShader
+                  Set the shaders of the current and future chunks
+                GetResidentChunks
+                  Returns the chunks ready to be drawn
+                GetStats
+                  Returns the state after the last update
+                GetColumnBytes
+                  Returns the memory of a column of chunks
+                VoxelChunkStreamer
+                  Constructor.
+                ~VoxelChunkStreamer
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class VoxelChunkStreamer
+    {
+    public:
+        static constexpr const UINT CHUNK_SIZE = VoxelChunkMesher::CHUNK_SIZE;
+        static constexpr const UINT WORLD_SIZE = 1u << 24u;
+        static constexpr const UINT WORLD_ORIGIN = WORLD_SIZE / 2u;
+
+        static UINT64 GetColumnBytes(_In_ const std::vector<std::shared_ptr<VoxelChunk>>& aChunks);
+
+        VoxelChunkStreamer() = delete;
+        explicit VoxelChunkStreamer(_In_ const ChunkStreamingDesc& desc);
+        VoxelChunkStreamer(const VoxelChunkStreamer& other) = delete;
+        VoxelChunkStreamer(VoxelChunkStreamer&& other) = delete;
+        VoxelChunkStreamer& operator=(const VoxelChunkStreamer& other) = delete;
+        VoxelChunkStreamer& operator=(VoxelChunkStreamer&& other) = delete;
+        ~VoxelChunkStreamer();
+
+        HRESULT Initialize(_In_opt_ RenderDevice* pDevice);
+        void Update(_In_ const XMVECTOR& eye);
+
+        void SetVertexShader(_In_ const std::shared_ptr<VertexShader>& vertexShader);
+        void SetPixelShader(_In_ const std::shared_ptr<PixelShader>& pixelShader);
+
+        std::vector<std::shared_ptr<VoxelChunk>>& GetResidentChunks();
+        const ChunkStreamingStats& GetStats() const;
+
+    private:
+        /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+            Struct:   Column
+
+            Summary:  Chunks of a resident column and their memory
+        S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+        struct Column
+        {
+            std::vector<std::shared_ptr<VoxelChunk>> aChunks;
+            UINT64 uBytes;
+        };
+
+        /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+            Struct:   LoadedColumn
+
+            Summary:  Column finished by a worker, waiting for Update
+        S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+        struct LoadedColumn
+        {
+            UINT64 uKey;
+            Column column;
+        };
+
+        static UINT64 makeKey(_In_ UINT uColumnX, _In_ UINT uColumnZ);
+        static UINT getColumnX(_In_ UINT64 uKey);
+        static UINT getColumnZ(_In_ UINT64 uKey);
+
+        void runWorker();
+        HRESULT loadColumn(_In_ UINT64 uKey, _Out_ Column& outColumn) const;
+        UINT64 getDistanceSquared(_In_ UINT64 uKey) const;
+        UINT getBudgetRadius() const;
+        void requestColumns();
+        void evictColumn(_In_ UINT64 uKey, _Inout_ std::vector<Column>& aRetiredColumns);
+
+    private:
+        ChunkStreamingDesc m_desc;
+        TerrainGenerator m_generator;
+        std::vector<XMFLOAT4> m_aPalette;
+        RenderDevice* m_pDevice;
+        std::shared_ptr<VertexShader> m_vertexShader;
+        std::shared_ptr<PixelShader> m_pixelShader;
+
+        std::unordered_map<UINT64, Column> m_residentColumns;
+        std::vector<std::shared_ptr<VoxelChunk>> m_aResidentChunks;
+        BOOL m_bResidentChunksDirty;
+        INT m_cameraColumnX;
+        INT m_cameraColumnZ;
+        UINT m_uStreamRadius;
+        ChunkStreamingStats m_stats;
+
+        std::mutex m_mutex;
+        std::condition_variable m_workAvailable;
+        std::vector<UINT64> m_aRequests;
+        std::unordered_set<UINT64> m_inFlightKeys;
+        std::deque<LoadedColumn> m_loadedColumns;
+        std::vector<Column> m_aRetiredColumns;
+        BOOL m_bStopping;
+        std::vector<std::thread> m_workers;
+    };
+}
\ No newline at end of file
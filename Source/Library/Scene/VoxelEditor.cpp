@@ -0,0 +1,543 @@
+#include "Scene/VoxelEditor.h"
+
+#include <cmath>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelEditor::VoxelEditor
+      Summary:  Constructor. The edits go to the given grid, so that
+                the raycasts see them too
+      Args:     VoxelGrid& grid
+                  Blocks of the world
+                eInstanceFormat instanceFormat
+                  Format of the instances of the voxels
+                BOOL bExposedOnly
+                  Whether only the blocks with an exposed face have an
+                  instance, as in INSTANCED_EXPOSED
+      Modifies: [m_grid, m_uWidth, m_uHeight, m_uDepth,
+                 m_instanceFormat, m_bExposedOnly].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    VoxelEditor::VoxelEditor(_In_ VoxelGrid& grid, _In_ eInstanceFormat instanceFormat, _In_ BOOL bExposedOnly)
+        : m_grid(grid)
+        , m_uWidth(grid.GetWidth())
+        , m_uHeight(grid.GetHeight())
+        , m_uDepth(grid.GetDepth())
+        , m_instanceFormat(instanceFormat)
+        , m_bExposedOnly(bExposedOnly)
+        , m_instanceIndices()
+        , m_aauInstanceCells()
+        , m_aVoxels()
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelEditor::Build
+      Summary:  Creates one voxel per block type, or one voxel of
+                every type with compact instances, and the instances of
+                every block of the grid, or of every exposed block.
+                This is the full rebuild the edits avoid
+      Args:     std::vector<std::shared_ptr<Voxel>>& aOutVoxels
+                  Voxels that have at least one instance
+                std::vector<VoxelInstanceStats>& aOutStats
+                  Blocks of each block type that got an instance and
+                  enclosed blocks that were culled
+      Modifies: [m_instanceIndices, m_aauInstanceCells, m_aVoxels].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelEditor::Build(_Out_ std::vector<std::shared_ptr<Voxel>>& aOutVoxels, _Out_ std::vector<VoxelInstanceStats>& aOutStats)
+    {
+        aOutVoxels.clear();
+        aOutStats.assign(m_grid.GetPalette().size(), VoxelInstanceStats{ .uNumKept = 0u, .uNumCulled = 0u });
+        m_instanceIndices.clear();
+        m_aauInstanceCells.assign(getNumVoxels(), std::vector<UINT64>());
+        m_aVoxels.assign(getNumVoxels(), nullptr);
+
+        BOOL bCompact = m_instanceFormat == eInstanceFormat::COMPACT;
+        std::vector<std::vector<InstanceData>> aInstanceData(getNumVoxels());
+        std::vector<std::vector<CompactInstanceData>> aCompactInstanceData(getNumVoxels());
+        std::vector<VoxelRun> aRuns;
+        for (UINT z = 0u; z < m_uDepth; ++z)
+        {
+            for (UINT x = 0u; x < m_uWidth; ++x)
+            {
+                // Only the runs of blocks are visited, the empty cells above the column are skipped
+                m_grid.GetColumnRuns(x, z, aRuns);
+                UINT uRunStart = 0u;
+                for (const VoxelRun& run : aRuns)
+                {
+                    size_t uVoxelIdx = getVoxelIndex(run.blockType);
+                    size_t uTypeIdx = static_cast<size_t>(run.blockType) - static_cast<size_t>(eBlockType::GRASSLAND);
+                    for (UINT y = uRunStart; y < run.uEnd && run.blockType != HeightMap::EMPTY_BLOCK && uVoxelIdx < m_aVoxels.size(); ++y)
+                    {
+                        if (m_bExposedOnly && !isExposed(x, y, z))
+                        {
+                            ++aOutStats[uTypeIdx].uNumCulled;
+                            continue;
+                        }
+
+                        ++aOutStats[uTypeIdx].uNumKept;
+
+                        UINT64 uCellIndex = getCellIndex(x, y, z);
+                        m_instanceIndices[uCellIndex] = static_cast<UINT>(m_aauInstanceCells[uVoxelIdx].size());
+                        m_aauInstanceCells[uVoxelIdx].push_back(uCellIndex);
+                        if (bCompact)
+                        {
+                            aCompactInstanceData[uVoxelIdx].push_back(getCompactInstanceData(x, y, z));
+                        }
+                        else
+                        {
+                            aInstanceData[uVoxelIdx].push_back(getInstanceData(x, y, z));
+                        }
+                    }
+                    uRunStart = run.uEnd;
+                }
+            }
+        }
+
+        const FLOAT width = static_cast<FLOAT>(m_uWidth);
+        const FLOAT height = static_cast<FLOAT>(m_uHeight);
+        const FLOAT depth = static_cast<FLOAT>(m_uDepth);
+        for (size_t uVoxelIdx = 0u; uVoxelIdx < m_aVoxels.size(); ++uVoxelIdx)
+        {
+            if (m_aauInstanceCells[uVoxelIdx].empty())
+            {
+                continue;
+            }
+
+            // The shared voxel takes the color of each block from the material of its type
+            m_aVoxels[uVoxelIdx] = std::make_shared<Voxel>(bCompact ? XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f) : m_grid.GetPalette()[uVoxelIdx]);
+            if (bCompact)
+            {
+                m_aVoxels[uVoxelIdx]->SetCompactInstanceData(std::move(aCompactInstanceData[uVoxelIdx]));
+                m_aVoxels[uVoxelIdx]->Translate(XMVectorSet(-width, -2.0f * height + height * 0.75f, -depth, 0.0f));
+            }
+            else
+            {
+                m_aVoxels[uVoxelIdx]->SetInstanceData(std::move(aInstanceData[uVoxelIdx]));
+            }
+            aOutVoxels.push_back(m_aVoxels[uVoxelIdx]);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelEditor::Attach
+      Summary:  Finds the cell of every instance of voxels built from
+                the same height map, so that they can be edited. Each
+                voxel holds the blocks of one type, or of every type
+                with compact instances
+      Args:     const std::vector<std::shared_ptr<Voxel>>& aVoxels
+                  Voxels built by the scene
+      Modifies: [m_instanceIndices, m_aauInstanceCells, m_aVoxels].
+      Returns:  HRESULT
+                  Status code, E_INVALIDARG when an instance is not on
+                  a block of the type of its voxel
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT VoxelEditor::Attach(_In_ const std::vector<std::shared_ptr<Voxel>>& aVoxels)
+    {
+        m_instanceIndices.clear();
+        m_aauInstanceCells.assign(getNumVoxels(), std::vector<UINT64>());
+        m_aVoxels.assign(getNumVoxels(), nullptr);
+
+        const FLOAT width = static_cast<FLOAT>(m_uWidth);
+        const FLOAT height = static_cast<FLOAT>(m_uHeight);
+        const FLOAT depth = static_cast<FLOAT>(m_uDepth);
+        for (const std::shared_ptr<Voxel>& voxel : aVoxels)
+        {
+            if (voxel->GetInstanceFormat() != m_instanceFormat)
+            {
+                return E_INVALIDARG;
+            }
+
+            std::vector<UINT64> auCells;
+            auCells.reserve(voxel->GetNumInstances());
+            for (const CompactInstanceData& instance : voxel->GetCompactInstanceData())
+            {
+                if (instance.X >= m_uWidth || instance.Y >= m_uHeight || instance.Z >= m_uDepth)
+                {
+                    return E_INVALIDARG;
+                }
+
+                auCells.push_back(getCellIndex(instance.X, instance.Y, instance.Z));
+            }
+
+            // Inverse of the placement of buildInstances
+            for (const InstanceData& instance : voxel->GetInstanceData())
+            {
+                XMFLOAT4X4 transform;
+                XMStoreFloat4x4(&transform, instance.Transformation);
+
+                LONG x = std::lround(transform.m[3][0] / 2.0f + width / 2.0f);
+                LONG y = std::lround((transform.m[3][1] - height * 0.75f) / 2.0f + height);
+                LONG z = std::lround(transform.m[3][2] / 2.0f + depth / 2.0f);
+                if (x < 0 || y < 0 || z < 0 || x >= static_cast<LONG>(m_uWidth) || y >= static_cast<LONG>(m_uHeight) || z >= static_cast<LONG>(m_uDepth))
+                {
+                    return E_INVALIDARG;
+                }
+
+                auCells.push_back(getCellIndex(static_cast<UINT>(x), static_cast<UINT>(y), static_cast<UINT>(z)));
+            }
+
+            if (auCells.empty())
+            {
+                continue;
+            }
+
+            size_t uVoxelIdx = getVoxelIndex(getBlock(auCells[0]));
+            if (uVoxelIdx >= m_aVoxels.size() || m_aVoxels[uVoxelIdx])
+            {
+                return E_INVALIDARG;
+            }
+
+            for (UINT uIndex = 0u; uIndex < auCells.size(); ++uIndex)
+            {
+                if (getVoxelIndex(getBlock(auCells[uIndex])) != uVoxelIdx)
+                {
+                    return E_INVALIDARG;
+                }
+                m_instanceIndices[auCells[uIndex]] = uIndex;
+            }
+
+            m_aauInstanceCells[uVoxelIdx] = std::move(auCells);
+            m_aVoxels[uVoxelIdx] = voxel;
+        }
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelEditor::SetBlock
+      Summary:  Sets the type of a block, moving its instance to the
+                voxel of the new type. A new block may cover the last
+                exposed face of its neighbors, whose instances go away
+      Args:     UINT x
+                  Index of the block along the x axis
+                UINT y
+                  Index of the block along the y axis
+                UINT z
+                  Index of the block along the z axis
+                CHAR blockType
+                  Type of the block
+      Modifies: [m_grid, m_instanceIndices, m_aauInstanceCells,
+                 m_aVoxels].
+      Returns:  HRESULT
+                  Status code, E_INVALIDARG outside of the grid or for
+                  a block type without a voxel
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT VoxelEditor::SetBlock(_In_ UINT x, _In_ UINT y, _In_ UINT z, _In_ CHAR blockType)
+    {
+        size_t uVoxelIdx = getVoxelIndex(blockType);
+        if (x >= m_uWidth || y >= m_uHeight || z >= m_uDepth || uVoxelIdx >= m_aVoxels.size() || !m_aVoxels[uVoxelIdx])
+        {
+            return E_INVALIDARG;
+        }
+
+        UINT64 uCellIndex = getCellIndex(x, y, z);
+        CHAR previousType = m_grid.GetBlock(x, y, z);
+        if (previousType == blockType)
+        {
+            return S_OK;
+        }
+
+        if (hasInstance(uCellIndex))
+        {
+            removeInstance(uCellIndex);
+        }
+
+        m_grid.SetBlock(x, y, z, blockType);
+        if (!m_bExposedOnly || isExposed(x, y, z))
+        {
+            addInstance(x, y, z);
+        }
+
+        if (previousType == HeightMap::EMPTY_BLOCK)
+        {
+            updateNeighbors(x, y, z);
+        }
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelEditor::ClearBlock
+      Summary:  Removes a block and its instance. The neighbors it
+                covered get an instance if they had none
+      Args:     UINT x
+                  Index of the block along the x axis
+                UINT y
+                  Index of the block along the y axis
+                UINT z
+                  Index of the block along the z axis
+      Modifies: [m_grid, m_instanceIndices, m_aauInstanceCells,
+                 m_aVoxels].
+      Returns:  HRESULT
+                  Status code, E_INVALIDARG outside of the grid
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT VoxelEditor::ClearBlock(_In_ UINT x, _In_ UINT y, _In_ UINT z)
+    {
+        if (x >= m_uWidth || y >= m_uHeight || z >= m_uDepth)
+        {
+            return E_INVALIDARG;
+        }
+
+        UINT64 uCellIndex = getCellIndex(x, y, z);
+        if (m_grid.GetBlock(x, y, z) == HeightMap::EMPTY_BLOCK)
+        {
+            return S_OK;
+        }
+
+        if (hasInstance(uCellIndex))
+        {
+            removeInstance(uCellIndex);
+        }
+
+        m_grid.SetBlock(x, y, z, HeightMap::EMPTY_BLOCK);
+        updateNeighbors(x, y, z);
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelEditor::GetBlock
+      Summary:  Returns the type of a block
+      Args:     UINT x
+                  Index of the block along the x axis
+                UINT y
+                  Index of the block along the y axis
+                UINT z
+                  Index of the block along the z axis
+      Returns:  CHAR
+                  Type of the block, EMPTY_BLOCK outside of the grid
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    CHAR VoxelEditor::GetBlock(_In_ UINT x, _In_ UINT y, _In_ UINT z) const
+    {
+        if (x >= m_uWidth || y >= m_uHeight || z >= m_uDepth)
+        {
+            return HeightMap::EMPTY_BLOCK;
+        }
+
+        return m_grid.GetBlock(x, y, z);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelEditor::GetVoxels
+      Summary:  Returns the voxel of every block type
+      Returns:  const std::vector<std::shared_ptr<Voxel>>&
+                  Voxels in the order of the palette, nullptr for the
+                  types without one, or the single voxel of every type
+                  with compact instances
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const std::vector<std::shared_ptr<Voxel>>& VoxelEditor::GetVoxels() const
+    {
+        return m_aVoxels;
+    }
+
+    UINT64 VoxelEditor::getCellIndex(_In_ UINT x, _In_ UINT y, _In_ UINT z) const
+    {
+        return (static_cast<UINT64>(z) * m_uWidth + x) * m_uHeight + y;
+    }
+
+    CHAR VoxelEditor::getBlock(_In_ UINT64 uCellIndex) const
+    {
+        return m_grid.GetBlock(
+            static_cast<UINT>((uCellIndex / m_uHeight) % m_uWidth),
+            static_cast<UINT>(uCellIndex % m_uHeight),
+            static_cast<UINT>(uCellIndex / (static_cast<UINT64>(m_uHeight) * m_uWidth))
+        );
+    }
+
+    size_t VoxelEditor::getNumVoxels() const
+    {
+        return m_instanceFormat == eInstanceFormat::COMPACT ? 1u : m_grid.GetPalette().size();
+    }
+
+    size_t VoxelEditor::getVoxelIndex(_In_ CHAR blockType) const
+    {
+        size_t uTypeIdx = static_cast<size_t>(blockType) - static_cast<size_t>(eBlockType::GRASSLAND);
+        if (m_instanceFormat == eInstanceFormat::COMPACT && uTypeIdx < m_grid.GetPalette().size())
+        {
+            return 0u;
+        }
+
+        return uTypeIdx;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelEditor::getInstanceData
+      Summary:  Returns the matrix instance of a block, placed as in
+                Scene::buildInstances
+      Args:     UINT x
+                  Index of the block along the x axis
+                UINT y
+                  Index of the block along the y axis
+                UINT z
+                  Index of the block along the z axis
+      Returns:  InstanceData
+                  Translation of the block
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    InstanceData VoxelEditor::getInstanceData(_In_ UINT x, _In_ UINT y, _In_ UINT z) const
+    {
+        const FLOAT width = static_cast<FLOAT>(m_uWidth);
+        const FLOAT height = static_cast<FLOAT>(m_uHeight);
+        const FLOAT depth = static_cast<FLOAT>(m_uDepth);
+
+        return InstanceData
+        {
+            .Transformation = XMMatrixTranslation(
+                2.0f * (static_cast<FLOAT>(x) - width / 2.0f),
+                2.0f * (static_cast<FLOAT>(y) - height) + (height * 0.75f),
+                2.0f * (static_cast<FLOAT>(z) - depth / 2.0f)
+                )
+        };
+    }
+
+    CompactInstanceData VoxelEditor::getCompactInstanceData(_In_ UINT x, _In_ UINT y, _In_ UINT z) const
+    {
+        return CompactInstanceData
+        {
+            .X = static_cast<USHORT>(x),
+            .Y = static_cast<USHORT>(y),
+            .Z = static_cast<USHORT>(z),
+            .BlockType = static_cast<USHORT>(m_grid.GetBlock(x, y, z))
+        };
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelEditor::isExposed
+      Summary:  Returns whether a block has a face not covered by a
+                block, the same rule as HeightMap::GetExposedHeight.
+                The top of the grid and its sides are open, its bottom
+                is not seen
+      Args:     UINT x
+                  Index of the block along the x axis
+                UINT y
+                  Index of the block along the y axis
+                UINT z
+                  Index of the block along the z axis
+      Returns:  BOOL
+                  TRUE if the block is exposed
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL VoxelEditor::isExposed(_In_ UINT x, _In_ UINT y, _In_ UINT z) const
+    {
+        if (x == 0u || z == 0u || x + 1u >= m_uWidth || z + 1u >= m_uDepth || y + 1u >= m_uHeight)
+        {
+            return TRUE;
+        }
+
+        return m_grid.GetBlock(x, y + 1u, z) == HeightMap::EMPTY_BLOCK ||
+            m_grid.GetBlock(x - 1u, y, z) == HeightMap::EMPTY_BLOCK ||
+            m_grid.GetBlock(x + 1u, y, z) == HeightMap::EMPTY_BLOCK ||
+            m_grid.GetBlock(x, y, z - 1u) == HeightMap::EMPTY_BLOCK ||
+            m_grid.GetBlock(x, y, z + 1u) == HeightMap::EMPTY_BLOCK;
+    }
+
+    BOOL VoxelEditor::hasInstance(_In_ UINT64 uCellIndex) const
+    {
+        return m_instanceIndices.contains(uCellIndex);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelEditor::addInstance
+      Summary:  Appends the instance of a block to the voxel of its
+                type, uploaded with the other edits of the frame
+      Args:     UINT x
+                  Index of the block along the x axis
+                UINT y
+                  Index of the block along the y axis
+                UINT z
+                  Index of the block along the z axis
+      Modifies: [m_instanceIndices, m_aauInstanceCells, m_aVoxels].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelEditor::addInstance(_In_ UINT x, _In_ UINT y, _In_ UINT z)
+    {
+        UINT64 uCellIndex = getCellIndex(x, y, z);
+        size_t uVoxelIdx = getVoxelIndex(m_grid.GetBlock(x, y, z));
+        if (uVoxelIdx >= m_aVoxels.size() || !m_aVoxels[uVoxelIdx])
+        {
+            return;
+        }
+
+        UINT uIndex = m_instanceFormat == eInstanceFormat::COMPACT ?
+            m_aVoxels[uVoxelIdx]->AddInstance(getCompactInstanceData(x, y, z)) : m_aVoxels[uVoxelIdx]->AddInstance(getInstanceData(x, y, z));
+        m_instanceIndices[uCellIndex] = uIndex;
+        m_aauInstanceCells[uVoxelIdx].push_back(uCellIndex);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelEditor::removeInstance
+      Summary:  Removes the instance of a block from the voxel of its
+                type. The last instance of the voxel takes its place
+      Args:     UINT64 uCellIndex
+                  Cell of the block, which has an instance
+      Modifies: [m_instanceIndices, m_aauInstanceCells, m_aVoxels].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelEditor::removeInstance(_In_ UINT64 uCellIndex)
+    {
+        size_t uVoxelIdx = getVoxelIndex(getBlock(uCellIndex));
+        std::vector<UINT64>& auCells = m_aauInstanceCells[uVoxelIdx];
+
+        UINT uIndex = m_instanceIndices[uCellIndex];
+        UINT uMovedIndex = m_aVoxels[uVoxelIdx]->RemoveInstance(uIndex);
+        if (uMovedIndex != uIndex)
+        {
+            auCells[uIndex] = auCells[uMovedIndex];
+            m_instanceIndices[auCells[uIndex]] = uIndex;
+        }
+
+        auCells.pop_back();
+        m_instanceIndices.erase(uCellIndex);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelEditor::updateNeighbors
+      Summary:  Adds or removes the instances of the six neighbors of
+                a changed block whose exposure changed with it. Every
+                block has an instance unless only the exposed ones do
+      Args:     UINT x
+                  Index of the block along the x axis
+                UINT y
+                  Index of the block along the y axis
+                UINT z
+                  Index of the block along the z axis
+      Modifies: [m_instanceIndices, m_aauInstanceCells, m_aVoxels].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelEditor::updateNeighbors(_In_ UINT x, _In_ UINT y, _In_ UINT z)
+    {
+        if (!m_bExposedOnly)
+        {
+            return;
+        }
+
+        static constexpr const INT NEIGHBORS[6][3] =
+        {
+            { -1, 0, 0 }, { 1, 0, 0 }, { 0, -1, 0 }, { 0, 1, 0 }, { 0, 0, -1 }, { 0, 0, 1 }
+        };
+
+        for (const INT* neighbor : NEIGHBORS)
+        {
+            // Wraps around below zero, which the bounds test rejects
+            UINT uNeighborX = x + static_cast<UINT>(neighbor[0]);
+            UINT uNeighborY = y + static_cast<UINT>(neighbor[1]);
+            UINT uNeighborZ = z + static_cast<UINT>(neighbor[2]);
+            if (uNeighborX >= m_uWidth || uNeighborY >= m_uHeight || uNeighborZ >= m_uDepth)
+            {
+                continue;
+            }
+
+            UINT64 uCellIndex = getCellIndex(uNeighborX, uNeighborY, uNeighborZ);
+            if (m_grid.GetBlock(uNeighborX, uNeighborY, uNeighborZ) == HeightMap::EMPTY_BLOCK)
+            {
+                continue;
+            }
+
+            BOOL bExposed = isExposed(uNeighborX, uNeighborY, uNeighborZ);
+            if (bExposed && !hasInstance(uCellIndex))
+            {
+                addInstance(uNeighborX, uNeighborY, uNeighborZ);
+            }
+            else if (!bExposed && hasInstance(uCellIndex))
+            {
+                removeInstance(uCellIndex);
+            }
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,104 @@
+/*+===================================================================
+  File:      VOXELEDITOR.H
+
+  Summary:   VoxelEditor header file contains declarations of
+             VoxelEditor class used to set and clear single blocks of
+             the instanced voxels without building them again.
+
+  Classes: VoxelEditor
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Scene/Voxel.h"
+#include "Scene/VoxelGrid.h"
+
+namespace library
+{
+    struct VoxelInstanceStats
+    {
+        UINT64 uNumKept;
+        UINT64 uNumCulled;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    VoxelEditor
+
+      Summary:  Instance of every block of the grid in the instanced
+                voxels, one voxel per block type. Setting or clearing a
+                block changes the grid and adds or removes its
+                instance, and in the exposed mode the instances of the
+                neighbors it covers or uncovers, so that the voxels
+                always hold the instances a full build would. The
+                compact instances carry their block type, so in that
+                format every type shares a single voxel. Only the
+                changed instances are marked dirty, the voxels upload
+                them once per frame with UpdateInstanceBuffer. Runs on
+                the CPU only so it can be used without a device
+
+      Methods:  Build
+                  Creates the voxels of every block type from the grid
+                  and counts the blocks it keeps and culls
+                Attach
+                  Indexes the instances of voxels built by the scene
+                SetBlock
+                  Sets the type of a block
+                ClearBlock
+                  Removes a block
+                GetBlock
+                  Returns the type of a block
+                GetVoxels
+                  Returns the voxel of every block type
+                VoxelEditor
+                  Constructor.
+                ~VoxelEditor
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class VoxelEditor
+    {
+    public:
+        VoxelEditor() = delete;
+        VoxelEditor(_In_ VoxelGrid& grid, _In_ eInstanceFormat instanceFormat, _In_ BOOL bExposedOnly);
+        VoxelEditor(const VoxelEditor& other) = delete;
+        VoxelEditor(VoxelEditor&& other) = delete;
+        VoxelEditor& operator=(const VoxelEditor& other) = delete;
+        VoxelEditor& operator=(VoxelEditor&& other) = delete;
+        ~VoxelEditor() = default;
+
+        void Build(_Out_ std::vector<std::shared_ptr<Voxel>>& aOutVoxels, _Out_ std::vector<VoxelInstanceStats>& aOutStats);
+        HRESULT Attach(_In_ const std::vector<std::shared_ptr<Voxel>>& aVoxels);
+
+        HRESULT SetBlock(_In_ UINT x, _In_ UINT y, _In_ UINT z, _In_ CHAR blockType);
+        HRESULT ClearBlock(_In_ UINT x, _In_ UINT y, _In_ UINT z);
+
+        CHAR GetBlock(_In_ UINT x, _In_ UINT y, _In_ UINT z) const;
+        const std::vector<std::shared_ptr<Voxel>>& GetVoxels() const;
+
+    private:
+        UINT64 getCellIndex(_In_ UINT x, _In_ UINT y, _In_ UINT z) const;
+        CHAR getBlock(_In_ UINT64 uCellIndex) const;
+        size_t getNumVoxels() const;
+        size_t getVoxelIndex(_In_ CHAR blockType) const;
+        InstanceData getInstanceData(_In_ UINT x, _In_ UINT y, _In_ UINT z) const;
+        CompactInstanceData getCompactInstanceData(_In_ UINT x, _In_ UINT y, _In_ UINT z) const;
+        BOOL isExposed(_In_ UINT x, _In_ UINT y, _In_ UINT z) const;
+        BOOL hasInstance(_In_ UINT64 uCellIndex) const;
+        void addInstance(_In_ UINT x, _In_ UINT y, _In_ UINT z);
+        void removeInstance(_In_ UINT64 uCellIndex);
+        void updateNeighbors(_In_ UINT x, _In_ UINT y, _In_ UINT z);
+
+    private:
+        VoxelGrid& m_grid;
+        UINT m_uWidth;
+        UINT m_uHeight;
+        UINT m_uDepth;
+        eInstanceFormat m_instanceFormat;
+        BOOL m_bExposedOnly;
+        std::unordered_map<UINT64, UINT> m_instanceIndices;
+        std::vector<std::vector<UINT64>> m_aauInstanceCells;
+        std::vector<std::shared_ptr<Voxel>> m_aVoxels;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,471 @@
+#include "Scene/VoxelGrid.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <execution>
+#include <numeric>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelGrid::VoxelGrid
+      Summary:  Constructor. Encodes the columns of every chunk, on
+                all cores. Each column of the height map becomes a
+                single run of its block type
+      Args:     const HeightMap& heightMap
+                  Height map of the blocks
+      Modifies: [m_uWidth, m_uHeight, m_uDepth, m_origin,
+                 m_uNumChunksX, m_uNumChunksZ, m_aPalette, m_aChunks].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    VoxelGrid::VoxelGrid(_In_ const HeightMap& heightMap)
+        : m_uWidth(heightMap.GetWidth())
+        , m_uHeight(heightMap.GetHeight())
+        , m_uDepth(heightMap.GetDepth())
+        , m_origin()
+        , m_uNumChunksX((heightMap.GetWidth() + CHUNK_SIZE - 1u) / CHUNK_SIZE)
+        , m_uNumChunksZ((heightMap.GetDepth() + CHUNK_SIZE - 1u) / CHUNK_SIZE)
+        , m_aPalette(heightMap.GetPalette())
+        , m_aChunks(static_cast<size_t>(m_uNumChunksX) * m_uNumChunksZ, VoxelChunkStorage(heightMap.GetHeight()))
+    {
+        const FLOAT width = static_cast<FLOAT>(m_uWidth);
+        const FLOAT height = static_cast<FLOAT>(m_uHeight);
+        const FLOAT depth = static_cast<FLOAT>(m_uDepth);
+        m_origin = XMFLOAT3(-width - 1.0f, -2.0f * height + height * 0.75f - 1.0f, -depth - 1.0f);
+
+        std::vector<UINT> aChunkIndices(m_aChunks.size());
+        std::iota(aChunkIndices.begin(), aChunkIndices.end(), 0u);
+
+        auto encodeChunk = [&](UINT uChunkIndex)
+        {
+            m_aChunks[uChunkIndex] = VoxelChunkStorage(heightMap, (uChunkIndex % m_uNumChunksX) * CHUNK_SIZE, (uChunkIndex / m_uNumChunksX) * CHUNK_SIZE);
+        };
+
+        std::for_each(std::execution::par, aChunkIndices.begin(), aChunkIndices.end(), encodeChunk);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelGrid::VoxelGrid
+      Summary:  Constructor. Creates an empty grid at the same place as
+                the grid of a height map of the same dimensions, its
+                chunks are filled with SetChunk
+      Args:     UINT uWidth
+                UINT uHeight
+                UINT uDepth
+                  Dimensions of the grid in blocks
+                std::vector<XMFLOAT4>&& aPalette
+                  Colors of the block types
+      Modifies: [m_uWidth, m_uHeight, m_uDepth, m_origin,
+                 m_uNumChunksX, m_uNumChunksZ, m_aPalette, m_aChunks].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    VoxelGrid::VoxelGrid(_In_ UINT uWidth, _In_ UINT uHeight, _In_ UINT uDepth, _In_ std::vector<XMFLOAT4>&& aPalette)
+        : m_uWidth(uWidth)
+        , m_uHeight(uHeight)
+        , m_uDepth(uDepth)
+        , m_origin()
+        , m_uNumChunksX((uWidth + CHUNK_SIZE - 1u) / CHUNK_SIZE)
+        , m_uNumChunksZ((uDepth + CHUNK_SIZE - 1u) / CHUNK_SIZE)
+        , m_aPalette(std::move(aPalette))
+        , m_aChunks(static_cast<size_t>(m_uNumChunksX) * m_uNumChunksZ, VoxelChunkStorage(uHeight))
+    {
+        const FLOAT width = static_cast<FLOAT>(m_uWidth);
+        const FLOAT height = static_cast<FLOAT>(m_uHeight);
+        const FLOAT depth = static_cast<FLOAT>(m_uDepth);
+        m_origin = XMFLOAT3(-width - 1.0f, -2.0f * height + height * 0.75f - 1.0f, -depth - 1.0f);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelGrid::Raycast
+      Summary:  Finds the first block along a ray. The ray is clipped
+                to the bounds of the grid, then the DDA steps to the
+                neighboring cell whose boundary the ray crosses first
+                until it reaches a block or leaves the grid
+      Args:     const VoxelRay& ray
+                  Ray in world space
+                VoxelRayHit& outHit
+                  First block, bHit is FALSE when there is none
+      Returns:  BOOL
+                  TRUE if the ray hits a block within its distance
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL VoxelGrid::Raycast(_In_ const VoxelRay& ray, _Out_ VoxelRayHit& outHit) const
+    {
+        outHit = VoxelRayHit
+        {
+            .bHit = FALSE,
+            .uX = 0u,
+            .uY = 0u,
+            .uZ = 0u,
+            .normal = XMINT3(0, 0, 0),
+            .blockType = static_cast<eBlockType>(HeightMap::EMPTY_BLOCK),
+            .distance = ray.maxDistance
+        };
+
+        FLOAT length = std::sqrt(ray.direction.x * ray.direction.x + ray.direction.y * ray.direction.y + ray.direction.z * ray.direction.z);
+        if (length <= 0.0f || m_aChunks.empty())
+        {
+            return FALSE;
+        }
+
+        // Origin in cells, t in world units along the normalized direction
+        const FLOAT afOrigin[3] = { (ray.origin.x - m_origin.x) / CELL_SIZE, (ray.origin.y - m_origin.y) / CELL_SIZE, (ray.origin.z - m_origin.z) / CELL_SIZE };
+        const FLOAT afDirection[3] = { ray.direction.x / length, ray.direction.y / length, ray.direction.z / length };
+        const INT aiSize[3] = { static_cast<INT>(m_uWidth), static_cast<INT>(m_uHeight), static_cast<INT>(m_uDepth) };
+
+        // Slabs of the grid bounds
+        FLOAT tEnter = 0.0f;
+        FLOAT tExit = ray.maxDistance;
+        INT iEnterAxis = -1;
+        for (INT i = 0; i < 3; ++i)
+        {
+            if (afDirection[i] == 0.0f)
+            {
+                if (afOrigin[i] < 0.0f || afOrigin[i] >= static_cast<FLOAT>(aiSize[i]))
+                {
+                    return FALSE;
+                }
+                continue;
+            }
+
+            FLOAT t0 = -afOrigin[i] * CELL_SIZE / afDirection[i];
+            FLOAT t1 = (static_cast<FLOAT>(aiSize[i]) - afOrigin[i]) * CELL_SIZE / afDirection[i];
+            if (t0 > t1)
+            {
+                std::swap(t0, t1);
+            }
+
+            if (t0 > tEnter)
+            {
+                tEnter = t0;
+                iEnterAxis = i;
+            }
+            tExit = std::min(tExit, t1);
+        }
+
+        if (tEnter > tExit)
+        {
+            return FALSE;
+        }
+
+        INT aiCell[3];
+        INT aiStep[3];
+        FLOAT afNextBoundary[3];
+        FLOAT afBoundaryDelta[3];
+        for (INT i = 0; i < 3; ++i)
+        {
+            // The entry axis is on the boundary, rounding must not put it outside
+            if (i == iEnterAxis)
+            {
+                aiCell[i] = afDirection[i] > 0.0f ? 0 : aiSize[i] - 1;
+            }
+            else
+            {
+                FLOAT cell = std::floor(afOrigin[i] + afDirection[i] * tEnter / CELL_SIZE);
+                aiCell[i] = std::clamp(static_cast<INT>(cell), 0, aiSize[i] - 1);
+            }
+
+            if (afDirection[i] > 0.0f)
+            {
+                aiStep[i] = 1;
+                afNextBoundary[i] = (static_cast<FLOAT>(aiCell[i] + 1) - afOrigin[i]) * CELL_SIZE / afDirection[i];
+                afBoundaryDelta[i] = CELL_SIZE / afDirection[i];
+            }
+            else if (afDirection[i] < 0.0f)
+            {
+                aiStep[i] = -1;
+                afNextBoundary[i] = (static_cast<FLOAT>(aiCell[i]) - afOrigin[i]) * CELL_SIZE / afDirection[i];
+                afBoundaryDelta[i] = -CELL_SIZE / afDirection[i];
+            }
+            else
+            {
+                aiStep[i] = 0;
+                afNextBoundary[i] = FLT_MAX;
+                afBoundaryDelta[i] = FLT_MAX;
+            }
+        }
+
+        INT aiNormal[3] = { 0, 0, 0 };
+        if (iEnterAxis >= 0)
+        {
+            aiNormal[iEnterAxis] = -aiStep[iEnterAxis];
+        }
+
+        FLOAT t = tEnter;
+        for (;;)
+        {
+            CHAR blockType = getBlock(static_cast<UINT>(aiCell[0]), static_cast<UINT>(aiCell[1]), static_cast<UINT>(aiCell[2]));
+            if (blockType != HeightMap::EMPTY_BLOCK)
+            {
+                outHit = VoxelRayHit
+                {
+                    .bHit = TRUE,
+                    .uX = static_cast<UINT>(aiCell[0]),
+                    .uY = static_cast<UINT>(aiCell[1]),
+                    .uZ = static_cast<UINT>(aiCell[2]),
+                    .normal = XMINT3(aiNormal[0], aiNormal[1], aiNormal[2]),
+                    .blockType = static_cast<eBlockType>(blockType),
+                    .distance = t
+                };
+                return TRUE;
+            }
+
+            INT iAxis = afNextBoundary[0] < afNextBoundary[1] ?
+                (afNextBoundary[0] < afNextBoundary[2] ? 0 : 2) : (afNextBoundary[1] < afNextBoundary[2] ? 1 : 2);
+
+            t = afNextBoundary[iAxis];
+            aiCell[iAxis] += aiStep[iAxis];
+            if (t > tExit || aiCell[iAxis] < 0 || aiCell[iAxis] >= aiSize[iAxis])
+            {
+                return FALSE;
+            }
+            afNextBoundary[iAxis] += afBoundaryDelta[iAxis];
+
+            aiNormal[0] = 0;
+            aiNormal[1] = 0;
+            aiNormal[2] = 0;
+            aiNormal[iAxis] = -aiStep[iAxis];
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelGrid::RaycastBatch
+      Summary:  Answers every ray of a batch, the rays are independent
+                so they are spread over all cores
+      Args:     const std::vector<VoxelRay>& aRays
+                  Rays in world space
+                std::vector<VoxelRayHit>& aOutHits
+                  First block along each ray, in the order of the rays
+                BOOL bParallel
+                  Whether the rays are answered on all cores
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelGrid::RaycastBatch(_In_ const std::vector<VoxelRay>& aRays, _Out_ std::vector<VoxelRayHit>& aOutHits, _In_ BOOL bParallel) const
+    {
+        aOutHits.resize(aRays.size());
+
+        std::vector<UINT> aRayIndices(aRays.size());
+        std::iota(aRayIndices.begin(), aRayIndices.end(), 0u);
+
+        auto raycastOne = [&](UINT uRayIndex)
+        {
+            Raycast(aRays[uRayIndex], aOutHits[uRayIndex]);
+        };
+
+        if (bParallel)
+        {
+            std::for_each(std::execution::par, aRayIndices.begin(), aRayIndices.end(), raycastOne);
+        }
+        else
+        {
+            std::for_each(aRayIndices.begin(), aRayIndices.end(), raycastOne);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelGrid::GetBlock
+      Summary:  Returns the type of a block
+      Args:     UINT x
+                  Index of the block along the x axis
+                UINT y
+                  Index of the block along the y axis
+                UINT z
+                  Index of the block along the z axis
+      Returns:  CHAR
+                  Type of the block, EMPTY_BLOCK outside of the grid
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    CHAR VoxelGrid::GetBlock(_In_ UINT x, _In_ UINT y, _In_ UINT z) const
+    {
+        if (x >= m_uWidth || y >= m_uHeight || z >= m_uDepth)
+        {
+            return HeightMap::EMPTY_BLOCK;
+        }
+
+        return getBlock(x, y, z);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelGrid::SetBlock
+      Summary:  Sets the type of a block, ignored outside of the grid
+      Args:     UINT x
+                  Index of the block along the x axis
+                UINT y
+                  Index of the block along the y axis
+                UINT z
+                  Index of the block along the z axis
+                CHAR blockType
+                  Type of the block, EMPTY_BLOCK to remove it
+      Modifies: [m_aChunks].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelGrid::SetBlock(_In_ UINT x, _In_ UINT y, _In_ UINT z, _In_ CHAR blockType)
+    {
+        if (x >= m_uWidth || y >= m_uHeight || z >= m_uDepth)
+        {
+            return;
+        }
+
+        m_aChunks[static_cast<size_t>(z / CHUNK_SIZE) * m_uNumChunksX + x / CHUNK_SIZE].SetBlock(x % CHUNK_SIZE, y, z % CHUNK_SIZE, blockType);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelGrid::GetColumnRuns
+      Summary:  Returns the runs of blocks of a column, from the bottom
+                up. Reading the runs is much faster than reading every
+                block of the column
+      Args:     UINT x
+                  Index of the column along the x axis
+                UINT z
+                  Index of the column along the z axis
+                std::vector<VoxelRun>& aOutRuns
+                  Runs of the column, empty outside of the grid. The
+                  blocks above the last run are empty
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelGrid::GetColumnRuns(_In_ UINT x, _In_ UINT z, _Out_ std::vector<VoxelRun>& aOutRuns) const
+    {
+        if (x >= m_uWidth || z >= m_uDepth)
+        {
+            aOutRuns.clear();
+            return;
+        }
+
+        m_aChunks[static_cast<size_t>(z / CHUNK_SIZE) * m_uNumChunksX + x / CHUNK_SIZE].GetColumnRuns(x % CHUNK_SIZE, z % CHUNK_SIZE, aOutRuns);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelGrid::SerializeChunk
+      Summary:  Appends a chunk to a byte array
+      Args:     UINT uChunkX
+                UINT uChunkZ
+                  Coordinates of the chunk
+                std::vector<BYTE>& aBytes
+                  Bytes to append to
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelGrid::SerializeChunk(_In_ UINT uChunkX, _In_ UINT uChunkZ, _Inout_ std::vector<BYTE>& aBytes) const
+    {
+        GetChunk(uChunkX, uChunkZ).Serialize(aBytes);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelGrid::DeserializeChunk
+      Summary:  Replaces a chunk with one written by SerializeChunk
+      Args:     UINT uChunkX
+                UINT uChunkZ
+                  Coordinates of the chunk
+                const BYTE* pBytes
+                  Serialized chunk
+                size_t uSize
+                  Number of bytes available
+                size_t* puNumBytesRead
+                  Number of bytes of the chunk, can be nullptr
+      Modifies: [m_aChunks].
+      Returns:  HRESULT
+                  Status code, E_INVALIDARG outside of the grid, E_FAIL
+                  when the bytes are not a chunk of the height of the
+                  grid
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT VoxelGrid::DeserializeChunk(_In_ UINT uChunkX, _In_ UINT uChunkZ, _In_reads_bytes_(uSize) const BYTE* pBytes, _In_ size_t uSize, _Out_opt_ size_t* puNumBytesRead)
+    {
+        if (uChunkX >= m_uNumChunksX || uChunkZ >= m_uNumChunksZ)
+        {
+            return E_INVALIDARG;
+        }
+
+        VoxelChunkStorage chunk(m_uHeight);
+        HRESULT hr = chunk.Deserialize(pBytes, uSize, puNumBytesRead);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        return SetChunk(uChunkX, uChunkZ, std::move(chunk));
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelGrid::SetChunk
+      Summary:  Replaces the storage of a chunk
+      Args:     UINT uChunkX
+                UINT uChunkZ
+                  Coordinates of the chunk
+                VoxelChunkStorage&& chunk
+                  New blocks of the chunk
+      Modifies: [m_aChunks].
+      Returns:  HRESULT
+                  Status code, E_INVALIDARG outside of the grid, E_FAIL
+                  when the chunk is not of the height of the grid
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT VoxelGrid::SetChunk(_In_ UINT uChunkX, _In_ UINT uChunkZ, _In_ VoxelChunkStorage&& chunk)
+    {
+        if (uChunkX >= m_uNumChunksX || uChunkZ >= m_uNumChunksZ)
+        {
+            return E_INVALIDARG;
+        }
+
+        if (chunk.GetHeight() != m_uHeight)
+        {
+            return E_FAIL;
+        }
+
+        m_aChunks[static_cast<size_t>(uChunkZ) * m_uNumChunksX + uChunkX] = std::move(chunk);
+
+        return S_OK;
+    }
+
+    const VoxelChunkStorage& VoxelGrid::GetChunk(_In_ UINT uChunkX, _In_ UINT uChunkZ) const
+    {
+        return m_aChunks[static_cast<size_t>(uChunkZ) * m_uNumChunksX + uChunkX];
+    }
+
+    UINT VoxelGrid::GetNumChunksX() const
+    {
+        return m_uNumChunksX;
+    }
+
+    UINT VoxelGrid::GetNumChunksZ() const
+    {
+        return m_uNumChunksZ;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelGrid::GetMemoryUsage
+      Summary:  Returns the bytes used by the chunks of the grid
+      Returns:  size_t
+                  Bytes used by the blocks
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    size_t VoxelGrid::GetMemoryUsage() const
+    {
+        size_t uMemoryUsage = 0u;
+        for (const VoxelChunkStorage& chunk : m_aChunks)
+        {
+            uMemoryUsage += chunk.GetMemoryUsage();
+        }
+
+        return uMemoryUsage;
+    }
+
+    UINT VoxelGrid::GetWidth() const
+    {
+        return m_uWidth;
+    }
+
+    UINT VoxelGrid::GetHeight() const
+    {
+        return m_uHeight;
+    }
+
+    UINT VoxelGrid::GetDepth() const
+    {
+        return m_uDepth;
+    }
+
+    const XMFLOAT3& VoxelGrid::GetOrigin() const
+    {
+        return m_origin;
+    }
+
+    const std::vector<XMFLOAT4>& VoxelGrid::GetPalette() const
+    {
+        return m_aPalette;
+    }
+
+    CHAR VoxelGrid::getBlock(_In_ UINT x, _In_ UINT y, _In_ UINT z) const
+    {
+        return m_aChunks[static_cast<size_t>(z / CHUNK_SIZE) * m_uNumChunksX + x / CHUNK_SIZE].GetBlock(x % CHUNK_SIZE, y, z % CHUNK_SIZE);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,147 @@
+/*+===================================================================
+  File:      VOXELGRID.H
+
+  Summary:   VoxelGrid header file contains declarations of VoxelGrid
+             class used to look up and raycast the blocks of the voxel
+             world.
+
+  Classes: VoxelGrid
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Scene/HeightMap.h"
+#include "Scene/VoxelChunkStorage.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   VoxelRay
+
+        Summary:  Ray in world space. The direction does not need to be
+                  normalized, the distances are in world units
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct VoxelRay
+    {
+        XMFLOAT3 origin;
+        XMFLOAT3 direction;
+        FLOAT maxDistance;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   VoxelRayHit
+
+        Summary:  First block along a ray. The normal is the face the
+                  ray entered through, zero when the ray starts inside
+                  the block
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct VoxelRayHit
+    {
+        BOOL bHit;
+        UINT uX;
+        UINT uY;
+        UINT uZ;
+        XMINT3 normal;
+        eBlockType blockType;
+        FLOAT distance;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    VoxelGrid
+
+      Summary:  Block type of every cell of the world, built from the
+                height map. Cells are 2 units wide and placed like the
+                voxel instances, block (x, y, z) is centered at
+                (2x - W, 2y - 2H + 0.75H, 2z - D). The blocks are
+                stored in VoxelChunkStorage chunks of CHUNK_SIZE x
+                CHUNK_SIZE columns, with a palette and run-length
+                encoded columns. Raycast walks the cells along the ray
+                with the Amanatides-Woo DDA, one cell per step, after
+                the ray is clipped to the grid
+
+      Methods:  Raycast
+                  Returns the first block along a ray
+                RaycastBatch
+                  Answers many rays, on all cores
+                GetBlock
+                  Returns the type of a block
+                SetBlock
+                  Sets the type of a block
+                GetColumnRuns
+                  Returns the runs of blocks of a column
+                SerializeChunk
+                  Appends a chunk to a byte array
+                DeserializeChunk
+                  Replaces a chunk with a serialized one
+                SetChunk
+                  Replaces a chunk
+                GetChunk
+                  Returns the storage of a chunk
+                GetNumChunksX / GetNumChunksZ
+                  Return the number of chunks along each axis
+                GetMemoryUsage
+                  Returns the bytes used by the blocks
+                GetWidth / GetHeight / GetDepth
+                  Return the dimensions of the grid
+                GetOrigin
+                  Returns the corner of the cell (0, 0, 0)
+                GetPalette
+                  Returns the colors of the block types
+                VoxelGrid
+                  Constructor.
+                ~VoxelGrid
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class VoxelGrid
+    {
+    public:
+        static constexpr const FLOAT CELL_SIZE = 2.0f;
+        static constexpr const UINT CHUNK_SIZE = VoxelChunkStorage::CHUNK_SIZE;
+
+        VoxelGrid() = delete;
+        VoxelGrid(_In_ const HeightMap& heightMap);
+        VoxelGrid(_In_ UINT uWidth, _In_ UINT uHeight, _In_ UINT uDepth, _In_ std::vector<XMFLOAT4>&& aPalette);
+        VoxelGrid(const VoxelGrid& other) = delete;
+        VoxelGrid(VoxelGrid&& other) = delete;
+        VoxelGrid& operator=(const VoxelGrid& other) = delete;
+        VoxelGrid& operator=(VoxelGrid&& other) = delete;
+        ~VoxelGrid() = default;
+
+        BOOL Raycast(_In_ const VoxelRay& ray, _Out_ VoxelRayHit& outHit) const;
+        void RaycastBatch(_In_ const std::vector<VoxelRay>& aRays, _Out_ std::vector<VoxelRayHit>& aOutHits, _In_ BOOL bParallel = TRUE) const;
+
+        CHAR GetBlock(_In_ UINT x, _In_ UINT y, _In_ UINT z) const;
+        void SetBlock(_In_ UINT x, _In_ UINT y, _In_ UINT z, _In_ CHAR blockType);
+        void GetColumnRuns(_In_ UINT x, _In_ UINT z, _Out_ std::vector<VoxelRun>& aOutRuns) const;
+
+        void SerializeChunk(_In_ UINT uChunkX, _In_ UINT uChunkZ, _Inout_ std::vector<BYTE>& aBytes) const;
+        HRESULT DeserializeChunk(_In_ UINT uChunkX, _In_ UINT uChunkZ, _In_reads_bytes_(uSize) const BYTE* pBytes, _In_ size_t uSize, _Out_opt_ size_t* puNumBytesRead);
+        HRESULT SetChunk(_In_ UINT uChunkX, _In_ UINT uChunkZ, _In_ VoxelChunkStorage&& chunk);
+        const VoxelChunkStorage& GetChunk(_In_ UINT uChunkX, _In_ UINT uChunkZ) const;
+        UINT GetNumChunksX() const;
+        UINT GetNumChunksZ() const;
+        size_t GetMemoryUsage() const;
+
+        UINT GetWidth() const;
+        UINT GetHeight() const;
+        UINT GetDepth() const;
+        const XMFLOAT3& GetOrigin() const;
+        const std::vector<XMFLOAT4>& GetPalette() const;
+
+    private:
+        CHAR getBlock(_In_ UINT x, _In_ UINT y, _In_ UINT z) const;
+
+    private:
+        UINT m_uWidth;
+        UINT m_uHeight;
+        UINT m_uDepth;
+        XMFLOAT3 m_origin;
+        UINT m_uNumChunksX;
+        UINT m_uNumChunksZ;
+        std::vector<XMFLOAT4> m_aPalette;
+        std::vector<VoxelChunkStorage> m_aChunks;
+    };
+}
\ No newline at end of file
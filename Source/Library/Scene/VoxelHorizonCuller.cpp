@@ -0,0 +1,645 @@
+#include "Scene/VoxelHorizonCuller.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <climits>
+#include <cmath>
+#include <execution>
+#include <numeric>
+
+namespace library
+{
+    static_assert(VoxelHorizonCuller::CHUNK_SIZE == 1u << VoxelHorizonCuller::CHUNK_LEVEL, "Chunks must be tiles of the quadtree");
+
+    namespace
+    {
+        // Slack of the angle and slope comparisons, a tile on the edge of the horizon is kept
+        constexpr const FLOAT HORIZON_EPSILON = 1e-4f;
+
+        BOOL isSolidBlockType(_In_ CHAR blockType)
+        {
+            return static_cast<CHAR>(eBlockType::GRASSLAND) <= blockType && blockType < static_cast<CHAR>(eBlockType::COUNT);
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+
+          Function: getPseudoAngle
+
+          Summary:  Returns a value growing with the angle of a direction
+                    around the y axis, cheaper than atan2 and enough to
+                    sort directions into bins
+
+          Args:     FLOAT x
+                    FLOAT z
+                      Direction, not zero
+
+          Returns:  FLOAT
+                      0 along +x, 1 along +z, 2 along -x, 3 along -z, up
+                      to 4
+
+        F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+        FLOAT getPseudoAngle(_In_ FLOAT x, _In_ FLOAT z)
+        {
+            if (z >= 0.0f)
+            {
+                return x >= 0.0f ? z / (x + z) : 1.0f - x / (z - x);
+            }
+
+            return x < 0.0f ? 2.0f - z / (-x - z) : 3.0f + x / (x - z);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelHorizonCuller::VoxelHorizonCuller
+      Summary:  Constructor. Sizes the levels of the quadtree up to the
+                one of a single tile, at least up to the chunk level,
+                every tile visible until the first cull
+      Args:     const VoxelGrid& grid
+                  Grid to cull, must outlive the culler
+      Modifies: [m_grid, m_uNumLevels, m_auLevelWidths,
+                 m_auLevelDepths, m_auFirstNodes, m_aMinHeights,
+                 m_aMaxHeights, m_aNumBlocks, m_aVisibleFrames,
+                 m_uFrame, m_eye, m_aHorizon, m_aOccluders,
+                 m_aChunkOrder, m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    VoxelHorizonCuller::VoxelHorizonCuller(_In_ const VoxelGrid& grid)
+        : m_grid(grid)
+        , m_uNumLevels(CHUNK_LEVEL + 1u)
+        , m_auLevelWidths()
+        , m_auLevelDepths()
+        , m_auFirstNodes()
+        , m_aMinHeights()
+        , m_aMaxHeights()
+        , m_aNumBlocks()
+        , m_aVisibleFrames()
+        , m_uFrame(0u)
+        , m_eye()
+        , m_aHorizon(NUM_HORIZON_BINS)
+        , m_aOccluders()
+        , m_aChunkOrder()
+        , m_stats()
+    {
+        while ((std::max(grid.GetWidth(), grid.GetDepth()) - 1u) >> (m_uNumLevels - 1u) > 0u)
+        {
+            ++m_uNumLevels;
+        }
+
+        UINT uNumNodes = 0u;
+        for (UINT uLevel = 0u; uLevel < m_uNumLevels; ++uLevel)
+        {
+            const UINT uTileSize = 1u << uLevel;
+            m_auLevelWidths.push_back((grid.GetWidth() + uTileSize - 1u) / uTileSize);
+            m_auLevelDepths.push_back((grid.GetDepth() + uTileSize - 1u) / uTileSize);
+            m_auFirstNodes.push_back(uNumNodes);
+            uNumNodes += m_auLevelWidths.back() * m_auLevelDepths.back();
+        }
+
+        m_aMinHeights.resize(uNumNodes, 0u);
+        m_aMaxHeights.resize(uNumNodes, 0u);
+        m_aVisibleFrames.resize(uNumNodes, 0u);
+
+        // Block counts only go up to the chunks, the levels above them could overflow and are never culled themselves
+        m_aNumBlocks.resize(m_auFirstNodes[CHUNK_LEVEL] + m_auLevelWidths[CHUNK_LEVEL] * m_auLevelDepths[CHUNK_LEVEL], 0u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelHorizonCuller::Build
+      Summary:  Reads the heights of every column from the grid, then
+                fills the levels above them
+      Args:     BOOL bParallel
+                  Whether the rows of columns are read on all cores
+      Modifies: [m_aMinHeights, m_aMaxHeights, m_aNumBlocks].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelHorizonCuller::Build(_In_ BOOL bParallel)
+    {
+        std::vector<UINT> aRows(m_grid.GetDepth());
+        std::iota(aRows.begin(), aRows.end(), 0u);
+
+        auto buildRow = [this](UINT z)
+        {
+            std::vector<VoxelRun> aRuns;
+            for (UINT x = 0u; x < m_grid.GetWidth(); ++x)
+            {
+                buildColumn(x, z, aRuns);
+            }
+        };
+
+        if (bParallel)
+        {
+            std::for_each(std::execution::par, aRows.begin(), aRows.end(), buildRow);
+        }
+        else
+        {
+            std::for_each(aRows.begin(), aRows.end(), buildRow);
+        }
+
+        for (UINT uLevel = 1u; uLevel < m_uNumLevels; ++uLevel)
+        {
+            for (UINT uTileZ = 0u; uTileZ < m_auLevelDepths[uLevel]; ++uTileZ)
+            {
+                for (UINT uTileX = 0u; uTileX < m_auLevelWidths[uLevel]; ++uTileX)
+                {
+                    buildNode(uLevel, uTileX, uTileZ);
+                }
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelHorizonCuller::UpdateColumn
+      Summary:  Reads a column again after one of its blocks changed
+                and refreshes the tiles over it
+      Args:     UINT x
+                  Index of the column along the x axis
+                UINT z
+                  Index of the column along the z axis
+      Modifies: [m_aMinHeights, m_aMaxHeights, m_aNumBlocks].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelHorizonCuller::UpdateColumn(_In_ UINT x, _In_ UINT z)
+    {
+        if (x >= m_grid.GetWidth() || z >= m_grid.GetDepth())
+        {
+            return;
+        }
+
+        std::vector<VoxelRun> aRuns;
+        buildColumn(x, z, aRuns);
+        for (UINT uLevel = 1u; uLevel < m_uNumLevels; ++uLevel)
+        {
+            buildNode(uLevel, x >> uLevel, z >> uLevel);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelHorizonCuller::Cull
+      Summary:  Sweeps the chunks from the nearest to the farthest. The
+                occluders closer than a chunk raise the horizon before
+                it is tested, so only terrain fully in front of a tile
+                can hide it. A kept chunk has its columns tested down
+                the quadtree and adds its tiles as occluders. The tiles
+                above the chunks are kept when one of their chunks is
+      Args:     const XMVECTOR& eye
+                  Position of the camera
+                BOOL bColumns
+                  Whether the columns of the kept chunks are tested too,
+                  the chunk meshes only need the chunks
+      Modifies: [m_aVisibleFrames, m_uFrame, m_eye, m_aHorizon,
+                 m_aOccluders, m_aChunkOrder, m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelHorizonCuller::Cull(_In_ const XMVECTOR& eye, _In_ BOOL bColumns)
+    {
+        LARGE_INTEGER frequency;
+        LARGE_INTEGER start;
+        LARGE_INTEGER end;
+        QueryPerformanceFrequency(&frequency);
+        QueryPerformanceCounter(&start);
+
+        // Tiles are visible when they hold the frame of the last cull
+        if (++m_uFrame == 0u)
+        {
+            std::fill(m_aVisibleFrames.begin(), m_aVisibleFrames.end(), 0u);
+            m_uFrame = 1u;
+        }
+
+        const XMFLOAT3& origin = m_grid.GetOrigin();
+        XMFLOAT3 eyePosition;
+        XMStoreFloat3(&eyePosition, eye);
+        m_eye = XMFLOAT3(
+            (eyePosition.x - origin.x) / VoxelGrid::CELL_SIZE,
+            (eyePosition.y - origin.y) / VoxelGrid::CELL_SIZE,
+            (eyePosition.z - origin.z) / VoxelGrid::CELL_SIZE
+        );
+
+        std::fill(m_aHorizon.begin(), m_aHorizon.end(), -FLT_MAX);
+        m_aOccluders.clear();
+        m_stats = VoxelHorizonStats{ .uNumColumns = static_cast<UINT64>(m_grid.GetWidth()) * m_grid.GetDepth() };
+
+        const UINT uNumChunksX = m_auLevelWidths[CHUNK_LEVEL];
+        const UINT uNumChunksZ = m_auLevelDepths[CHUNK_LEVEL];
+        m_aChunkOrder.clear();
+        for (UINT uChunkZ = 0u; uChunkZ < uNumChunksZ; ++uChunkZ)
+        {
+            for (UINT uChunkX = 0u; uChunkX < uNumChunksX; ++uChunkX)
+            {
+                m_aChunkOrder.emplace_back(getTileBounds(CHUNK_LEVEL, uChunkX, uChunkZ).minDistance, uChunkZ * uNumChunksX + uChunkX);
+            }
+        }
+        std::sort(m_aChunkOrder.begin(), m_aChunkOrder.end());
+
+        for (const std::pair<FLOAT, UINT>& chunk : m_aChunkOrder)
+        {
+            commitOccluders(chunk.first);
+
+            const UINT uChunkX = chunk.second % uNumChunksX;
+            const UINT uChunkZ = chunk.second / uNumChunksX;
+            m_stats.uNumBlocks += m_aNumBlocks[getNodeIndex(CHUNK_LEVEL, uChunkX, uChunkZ)];
+            if (bColumns)
+            {
+                cullTile(CHUNK_LEVEL, uChunkX, uChunkZ);
+                continue;
+            }
+
+            const UINT uNodeIndex = getNodeIndex(CHUNK_LEVEL, uChunkX, uChunkZ);
+            ++m_stats.uNumTests;
+            if (isHidden(uNodeIndex, getTileBounds(CHUNK_LEVEL, uChunkX, uChunkZ)))
+            {
+                const UINT uNumColumnsX = std::min(CHUNK_SIZE, m_grid.GetWidth() - uChunkX * CHUNK_SIZE);
+                const UINT uNumColumnsZ = std::min(CHUNK_SIZE, m_grid.GetDepth() - uChunkZ * CHUNK_SIZE);
+                m_stats.uNumCulledColumns += static_cast<UINT64>(uNumColumnsX) * uNumColumnsZ;
+                m_stats.uNumCulledBlocks += m_aNumBlocks[uNodeIndex];
+                ++m_stats.uNumCulledChunks;
+                continue;
+            }
+
+            // Without the columns tested, every occluder tile of the chunk is added
+            m_aVisibleFrames[uNodeIndex] = m_uFrame;
+            const UINT uNumTiles = 1u << (CHUNK_LEVEL - OCCLUDER_LEVEL);
+            for (UINT uTileZ = uChunkZ * uNumTiles; uTileZ < std::min((uChunkZ + 1u) * uNumTiles, m_auLevelDepths[OCCLUDER_LEVEL]); ++uTileZ)
+            {
+                for (UINT uTileX = uChunkX * uNumTiles; uTileX < std::min((uChunkX + 1u) * uNumTiles, m_auLevelWidths[OCCLUDER_LEVEL]); ++uTileX)
+                {
+                    addOccluder(getNodeIndex(OCCLUDER_LEVEL, uTileX, uTileZ), getTileBounds(OCCLUDER_LEVEL, uTileX, uTileZ));
+                }
+            }
+        }
+
+        m_stats.uNumChunks = uNumChunksX * uNumChunksZ;
+        for (UINT uLevel = CHUNK_LEVEL + 1u; uLevel < m_uNumLevels; ++uLevel)
+        {
+            for (UINT uTileZ = 0u; uTileZ < m_auLevelDepths[uLevel]; ++uTileZ)
+            {
+                for (UINT uTileX = 0u; uTileX < m_auLevelWidths[uLevel]; ++uTileX)
+                {
+                    BOOL bVisible = FALSE;
+                    for (UINT uChild = 0u; uChild < 4u && !bVisible; ++uChild)
+                    {
+                        bVisible = IsTileVisible(uLevel - 1u, uTileX * 2u + (uChild & 1u), uTileZ * 2u + (uChild >> 1u));
+                    }
+
+                    m_aVisibleFrames[getNodeIndex(uLevel, uTileX, uTileZ)] = bVisible ? m_uFrame : 0u;
+                }
+            }
+        }
+
+        QueryPerformanceCounter(&end);
+        m_stats.cullTime = static_cast<DOUBLE>(end.QuadPart - start.QuadPart) / static_cast<DOUBLE>(frequency.QuadPart);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelHorizonCuller::IsTileVisible
+      Summary:  Returns whether a tile was kept by the last cull, the
+                columns are level 0 and the chunks CHUNK_LEVEL. Below
+                a kept chunk, the columns are only kept when they were
+                tested
+      Args:     UINT uLevel
+                  Level of the tile
+                UINT uTileX
+                  Index of the tile along the x axis
+                UINT uTileZ
+                  Index of the tile along the z axis
+      Returns:  BOOL
+                  TRUE when the tile may be seen, FALSE when it is
+                  hidden or outside the grid
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL VoxelHorizonCuller::IsTileVisible(_In_ UINT uLevel, _In_ UINT uTileX, _In_ UINT uTileZ) const
+    {
+        if (uLevel >= m_uNumLevels || uTileX >= m_auLevelWidths[uLevel] || uTileZ >= m_auLevelDepths[uLevel])
+        {
+            return FALSE;
+        }
+
+        return m_aVisibleFrames[getNodeIndex(uLevel, uTileX, uTileZ)] == m_uFrame;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelHorizonCuller::GetNumLevels
+      Summary:  Returns the number of levels of the quadtree
+      Returns:  UINT
+                  Number of levels, the last one is a single tile
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT VoxelHorizonCuller::GetNumLevels() const
+    {
+        return m_uNumLevels;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelHorizonCuller::GetStats
+      Summary:  Returns the result of the last cull
+      Returns:  const VoxelHorizonStats&
+                  Chunks, columns and blocks culled
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const VoxelHorizonStats& VoxelHorizonCuller::GetStats() const
+    {
+        return m_stats;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelHorizonCuller::getNodeIndex
+      Summary:  Returns the index of a tile in the node arrays
+      Args:     UINT uLevel
+                  Level of the tile
+                UINT uTileX
+                  Index of the tile along the x axis
+                UINT uTileZ
+                  Index of the tile along the z axis
+      Returns:  UINT
+                  Index of the node
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT VoxelHorizonCuller::getNodeIndex(_In_ UINT uLevel, _In_ UINT uTileX, _In_ UINT uTileZ) const
+    {
+        return m_auFirstNodes[uLevel] + uTileZ * m_auLevelWidths[uLevel] + uTileX;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelHorizonCuller::buildColumn
+      Summary:  Reads the heights and the number of blocks of a column.
+                Runs of different solid types stacked on each other
+                all count in the min height
+      Args:     UINT x
+                  Index of the column along the x axis
+                UINT z
+                  Index of the column along the z axis
+                std::vector<VoxelRun>& aRuns
+                  Scratch array of the runs
+      Modifies: [m_aMinHeights, m_aMaxHeights, m_aNumBlocks].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelHorizonCuller::buildColumn(_In_ UINT x, _In_ UINT z, _Inout_ std::vector<VoxelRun>& aRuns)
+    {
+        m_grid.GetColumnRuns(x, z, aRuns);
+
+        UINT uMinHeight = 0u;
+        UINT uMaxHeight = 0u;
+        UINT uNumBlocks = 0u;
+        BOOL bGround = TRUE;
+        UINT uRunStart = 0u;
+        for (const VoxelRun& run : aRuns)
+        {
+            const BOOL bSolid = isSolidBlockType(run.blockType);
+            bGround &= bSolid;
+            if (bSolid)
+            {
+                uMinHeight = bGround ? run.uEnd : uMinHeight;
+                uMaxHeight = run.uEnd;
+                uNumBlocks += run.uEnd - uRunStart;
+            }
+            uRunStart = run.uEnd;
+        }
+
+        const UINT uNodeIndex = getNodeIndex(0u, x, z);
+        m_aMinHeights[uNodeIndex] = static_cast<WORD>(uMinHeight);
+        m_aMaxHeights[uNodeIndex] = static_cast<WORD>(uMaxHeight);
+        m_aNumBlocks[uNodeIndex] = uNumBlocks;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelHorizonCuller::buildNode
+      Summary:  Fills a tile from the up to 4 tiles of the level below
+      Args:     UINT uLevel
+                  Level of the tile, above 0
+                UINT uTileX
+                  Index of the tile along the x axis
+                UINT uTileZ
+                  Index of the tile along the z axis
+      Modifies: [m_aMinHeights, m_aMaxHeights, m_aNumBlocks].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelHorizonCuller::buildNode(_In_ UINT uLevel, _In_ UINT uTileX, _In_ UINT uTileZ)
+    {
+        WORD uMinHeight = USHRT_MAX;
+        WORD uMaxHeight = 0u;
+        UINT uNumBlocks = 0u;
+        for (UINT uChildZ = uTileZ * 2u; uChildZ < std::min(uTileZ * 2u + 2u, m_auLevelDepths[uLevel - 1u]); ++uChildZ)
+        {
+            for (UINT uChildX = uTileX * 2u; uChildX < std::min(uTileX * 2u + 2u, m_auLevelWidths[uLevel - 1u]); ++uChildX)
+            {
+                const UINT uChildIndex = getNodeIndex(uLevel - 1u, uChildX, uChildZ);
+                uMinHeight = std::min(uMinHeight, m_aMinHeights[uChildIndex]);
+                uMaxHeight = std::max(uMaxHeight, m_aMaxHeights[uChildIndex]);
+                uNumBlocks += uLevel <= CHUNK_LEVEL ? m_aNumBlocks[uChildIndex] : 0u;
+            }
+        }
+
+        const UINT uNodeIndex = getNodeIndex(uLevel, uTileX, uTileZ);
+        m_aMinHeights[uNodeIndex] = uMinHeight;
+        m_aMaxHeights[uNodeIndex] = uMaxHeight;
+        if (uLevel <= CHUNK_LEVEL)
+        {
+            m_aNumBlocks[uNodeIndex] = uNumBlocks;
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelHorizonCuller::getTileBounds
+      Summary:  Measures a tile from the camera. The directions that
+                cross a rectangle are the ones between its corners,
+                taken around the direction of its center so that they
+                never wrap around the camera
+      Args:     UINT uLevel
+                  Level of the tile
+                UINT uTileX
+                  Index of the tile along the x axis
+                UINT uTileZ
+                  Index of the tile along the z axis
+      Returns:  TileBounds
+                  Distances and directions of the tile, in cells
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    VoxelHorizonCuller::TileBounds VoxelHorizonCuller::getTileBounds(_In_ UINT uLevel, _In_ UINT uTileX, _In_ UINT uTileZ) const
+    {
+        const FLOAT afX[2] =
+        {
+            static_cast<FLOAT>(uTileX << uLevel) - m_eye.x,
+            static_cast<FLOAT>(std::min((uTileX + 1u) << uLevel, m_grid.GetWidth())) - m_eye.x
+        };
+        const FLOAT afZ[2] =
+        {
+            static_cast<FLOAT>(uTileZ << uLevel) - m_eye.z,
+            static_cast<FLOAT>(std::min((uTileZ + 1u) << uLevel, m_grid.GetDepth())) - m_eye.z
+        };
+
+        const FLOAT nearX = afX[0] > 0.0f ? afX[0] : std::min(afX[1], 0.0f);
+        const FLOAT nearZ = afZ[0] > 0.0f ? afZ[0] : std::min(afZ[1], 0.0f);
+        const FLOAT farX = std::max(std::abs(afX[0]), std::abs(afX[1]));
+        const FLOAT farZ = std::max(std::abs(afZ[0]), std::abs(afZ[1]));
+
+        TileBounds bounds =
+        {
+            .minDistance = std::sqrt(nearX * nearX + nearZ * nearZ),
+            .maxDistance = std::sqrt(farX * farX + farZ * farZ),
+            .minAngle = 0.0f,
+            .maxAngle = 4.0f,
+        };
+        if (bounds.minDistance <= 0.0f)
+        {
+            return bounds;
+        }
+
+        const FLOAT centerAngle = getPseudoAngle(0.5f * (afX[0] + afX[1]), 0.5f * (afZ[0] + afZ[1]));
+        FLOAT minDelta = 0.0f;
+        FLOAT maxDelta = 0.0f;
+        for (UINT uCorner = 0u; uCorner < 4u; ++uCorner)
+        {
+            FLOAT delta = getPseudoAngle(afX[uCorner & 1u], afZ[uCorner >> 1u]) - centerAngle;
+            delta += delta > 2.0f ? -4.0f : (delta <= -2.0f ? 4.0f : 0.0f);
+            minDelta = std::min(minDelta, delta);
+            maxDelta = std::max(maxDelta, delta);
+        }
+
+        bounds.minAngle = centerAngle + minDelta;
+        bounds.maxAngle = centerAngle + maxDelta;
+
+        return bounds;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelHorizonCuller::isHidden
+      Summary:  Returns whether the steepest line from the camera to
+                the top of a tile stays under the horizon of every bin
+                the tile touches. Above the camera the steepest line
+                goes to the nearest point, below it to the farthest
+      Args:     UINT uNodeIndex
+                  Node of the tile
+                const TileBounds& bounds
+                  Distances and directions of the tile
+      Returns:  BOOL
+                  TRUE when nothing of the tile can be seen
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL VoxelHorizonCuller::isHidden(_In_ UINT uNodeIndex, _In_ const TileBounds& bounds) const
+    {
+        if (bounds.minDistance <= 0.0f)
+        {
+            return FALSE;
+        }
+
+        const FLOAT top = static_cast<FLOAT>(m_aMaxHeights[uNodeIndex]);
+        const FLOAT slope = (top - m_eye.y) / (top >= m_eye.y ? bounds.minDistance : bounds.maxDistance) + HORIZON_EPSILON;
+
+        constexpr const FLOAT BINS_PER_ANGLE = static_cast<FLOAT>(NUM_HORIZON_BINS) / 4.0f;
+        const INT iFirstBin = static_cast<INT>(std::floor((bounds.minAngle - HORIZON_EPSILON) * BINS_PER_ANGLE));
+        const INT iLastBin = static_cast<INT>(std::floor((bounds.maxAngle + HORIZON_EPSILON) * BINS_PER_ANGLE));
+        for (INT iBin = iFirstBin; iBin <= iLastBin; ++iBin)
+        {
+            if (m_aHorizon[(iBin + NUM_HORIZON_BINS) % NUM_HORIZON_BINS] < slope)
+            {
+                return FALSE;
+            }
+        }
+
+        return TRUE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelHorizonCuller::cullTile
+      Summary:  Tests a tile, then its children down to the columns
+                when it is kept. Kept tiles of the occluder level are
+                added as occluders, the hidden ones could not raise the
+                horizon anyway
+      Args:     UINT uLevel
+                  Level of the tile
+                UINT uTileX
+                  Index of the tile along the x axis
+                UINT uTileZ
+                  Index of the tile along the z axis
+      Modifies: [m_aVisibleFrames, m_aOccluders, m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelHorizonCuller::cullTile(_In_ UINT uLevel, _In_ UINT uTileX, _In_ UINT uTileZ)
+    {
+        const UINT uNodeIndex = getNodeIndex(uLevel, uTileX, uTileZ);
+        const TileBounds bounds = getTileBounds(uLevel, uTileX, uTileZ);
+        ++m_stats.uNumTests;
+        if (isHidden(uNodeIndex, bounds))
+        {
+            const UINT uNumColumnsX = std::min(1u << uLevel, m_grid.GetWidth() - (uTileX << uLevel));
+            const UINT uNumColumnsZ = std::min(1u << uLevel, m_grid.GetDepth() - (uTileZ << uLevel));
+            m_stats.uNumCulledColumns += static_cast<UINT64>(uNumColumnsX) * uNumColumnsZ;
+            m_stats.uNumCulledBlocks += m_aNumBlocks[uNodeIndex];
+            m_stats.uNumCulledChunks += uLevel == CHUNK_LEVEL ? 1u : 0u;
+            return;
+        }
+
+        m_aVisibleFrames[uNodeIndex] = m_uFrame;
+        if (uLevel == OCCLUDER_LEVEL)
+        {
+            addOccluder(uNodeIndex, bounds);
+        }
+
+        if (uLevel == 0u)
+        {
+            return;
+        }
+
+        for (UINT uChildZ = uTileZ * 2u; uChildZ < std::min(uTileZ * 2u + 2u, m_auLevelDepths[uLevel - 1u]); ++uChildZ)
+        {
+            for (UINT uChildX = uTileX * 2u; uChildX < std::min(uTileX * 2u + 2u, m_auLevelWidths[uLevel - 1u]); ++uChildX)
+            {
+                cullTile(uLevel - 1u, uChildX, uChildZ);
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelHorizonCuller::addOccluder
+      Summary:  Queues a tile as an occluder. Its columns are solid up
+                to its min height, so every line entering it under the
+                flattest slope to that height is blocked: to its
+                farthest point above the camera, to its nearest below.
+                Only the bins whose every direction crosses the tile
+                are raised
+      Args:     UINT uNodeIndex
+                  Node of the tile
+                const TileBounds& bounds
+                  Distances and directions of the tile
+      Modifies: [m_aOccluders].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelHorizonCuller::addOccluder(_In_ UINT uNodeIndex, _In_ const TileBounds& bounds)
+    {
+        const FLOAT bottom = static_cast<FLOAT>(m_aMinHeights[uNodeIndex]);
+        if (bottom <= 0.0f || bounds.minDistance <= 0.0f)
+        {
+            return;
+        }
+
+        constexpr const FLOAT BINS_PER_ANGLE = static_cast<FLOAT>(NUM_HORIZON_BINS) / 4.0f;
+        const INT iFirstBin = static_cast<INT>(std::ceil((bounds.minAngle + HORIZON_EPSILON) * BINS_PER_ANGLE));
+        const INT iEndBin = static_cast<INT>(std::floor((bounds.maxAngle - HORIZON_EPSILON) * BINS_PER_ANGLE));
+        if (iEndBin <= iFirstBin)
+        {
+            return;
+        }
+
+        m_aOccluders.push_back(
+            Occluder
+            {
+                .maxDistance = bounds.maxDistance,
+                .slope = (bottom - m_eye.y) / (bottom >= m_eye.y ? bounds.maxDistance : bounds.minDistance),
+                .uFirstBin = static_cast<UINT>((iFirstBin + static_cast<INT>(NUM_HORIZON_BINS)) % static_cast<INT>(NUM_HORIZON_BINS)),
+                .uNumBins = static_cast<UINT>(iEndBin - iFirstBin),
+            }
+        );
+        std::push_heap(m_aOccluders.begin(), m_aOccluders.end(), [](const Occluder& a, const Occluder& b) { return a.maxDistance > b.maxDistance; });
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelHorizonCuller::commitOccluders
+      Summary:  Raises the horizon with the queued occluders that end
+                before a distance, in front of everything farther
+      Args:     FLOAT distance
+                  Nearest distance of the next tested chunk
+      Modifies: [m_aHorizon, m_aOccluders, m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelHorizonCuller::commitOccluders(_In_ FLOAT distance)
+    {
+        auto isFarther = [](const Occluder& a, const Occluder& b) { return a.maxDistance > b.maxDistance; };
+        while (!m_aOccluders.empty() && m_aOccluders.front().maxDistance <= distance)
+        {
+            const Occluder& occluder = m_aOccluders.front();
+            for (UINT uBin = 0u; uBin < occluder.uNumBins; ++uBin)
+            {
+                FLOAT& horizon = m_aHorizon[(occluder.uFirstBin + uBin) % NUM_HORIZON_BINS];
+                horizon = std::max(horizon, occluder.slope);
+            }
+
+            ++m_stats.uNumOccluders;
+            std::pop_heap(m_aOccluders.begin(), m_aOccluders.end(), isFarther);
+            m_aOccluders.pop_back();
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,160 @@
+/*+===================================================================
+  File:      VOXELHORIZONCULLER.H
+
+  Summary:   VoxelHorizonCuller header file contains declarations of
+             VoxelHorizonCuller class used to reject the chunks and
+             columns of a voxel grid hidden behind the terrain in front
+             of the camera.
+
+  Classes: VoxelHorizonCuller
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Scene/VoxelGrid.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   VoxelHorizonStats
+
+        Summary:  Result of the last cull. Blocks are the solid cells of
+                  the culled columns, one instance each when the voxels
+                  are instanced one block per instance. Tests are the
+                  tiles of every level compared to the horizon
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct VoxelHorizonStats
+    {
+        UINT uNumChunks;
+        UINT uNumCulledChunks;
+        UINT64 uNumColumns;
+        UINT64 uNumCulledColumns;
+        UINT64 uNumBlocks;
+        UINT64 uNumCulledBlocks;
+        UINT64 uNumTests;
+        UINT64 uNumOccluders;
+        DOUBLE cullTime;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    VoxelHorizonCuller
+
+      Summary:  Min/max height quadtree over the columns of a grid,
+                level l holding tiles of 2^l x 2^l columns. The max
+                height is the top of the highest block of the tile and
+                bounds what it draws, the min height is the top of the
+                blocks stacked without a gap from the bottom of every
+                column and bounds what surely blocks the view, so caves
+                and dug tunnels never hide anything. Cull sweeps the
+                chunks outward from the camera and keeps, for every
+                direction around it, the slope of the highest terrain
+                already passed. A tile is culled when no point of it
+                rises above that horizon, and its columns are only
+                tested when the whole chunk is not culled. Tiles of the
+                chunks kept raise the horizon once the sweep is past
+                them. Runs on the CPU only so it can be used without a
+                device
+
+      Methods:  Build
+                  Fills the quadtree from the grid
+                UpdateColumn
+                  Refreshes the tiles over an edited column
+                Cull
+                  Culls the tiles hidden from the camera position
+                IsTileVisible
+                  Returns whether a tile was kept by the last cull
+                GetNumLevels
+                  Returns the number of levels of the quadtree
+                GetStats
+                  Returns the result of the last cull
+                VoxelHorizonCuller
+                  Constructor.
+                ~VoxelHorizonCuller
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class VoxelHorizonCuller
+    {
+    public:
+        static constexpr const UINT CHUNK_SIZE = VoxelGrid::CHUNK_SIZE;
+        static constexpr const UINT CHUNK_LEVEL = 5u;
+        static constexpr const UINT OCCLUDER_LEVEL = 2u;
+        static constexpr const UINT NUM_HORIZON_BINS = 2048u;
+
+        VoxelHorizonCuller() = delete;
+        VoxelHorizonCuller(_In_ const VoxelGrid& grid);
+        VoxelHorizonCuller(const VoxelHorizonCuller& other) = delete;
+        VoxelHorizonCuller(VoxelHorizonCuller&& other) = delete;
+        VoxelHorizonCuller& operator=(const VoxelHorizonCuller& other) = delete;
+        VoxelHorizonCuller& operator=(VoxelHorizonCuller&& other) = delete;
+        ~VoxelHorizonCuller() = default;
+
+        void Build(_In_ BOOL bParallel = TRUE);
+        void UpdateColumn(_In_ UINT x, _In_ UINT z);
+        void Cull(_In_ const XMVECTOR& eye, _In_ BOOL bColumns = TRUE);
+
+        BOOL IsTileVisible(_In_ UINT uLevel, _In_ UINT uTileX, _In_ UINT uTileZ) const;
+        UINT GetNumLevels() const;
+        const VoxelHorizonStats& GetStats() const;
+
+    private:
+        /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+            Struct:   TileBounds
+
+            Summary:  Horizontal distances from the camera to a tile and
+                      the directions it covers, in pseudo-angles of 0 to
+                      4 around the camera. The distances are 0 when the
+                      camera stands over the tile
+        S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+        struct TileBounds
+        {
+            FLOAT minDistance;
+            FLOAT maxDistance;
+            FLOAT minAngle;
+            FLOAT maxAngle;
+        };
+
+        /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+            Struct:   Occluder
+
+            Summary:  Tile of a kept chunk waiting for the sweep to pass
+                      its far distance before it raises the horizon of
+                      the bins it fully covers
+        S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+        struct Occluder
+        {
+            FLOAT maxDistance;
+            FLOAT slope;
+            UINT uFirstBin;
+            UINT uNumBins;
+        };
+
+        UINT getNodeIndex(_In_ UINT uLevel, _In_ UINT uTileX, _In_ UINT uTileZ) const;
+        void buildColumn(_In_ UINT x, _In_ UINT z, _Inout_ std::vector<VoxelRun>& aRuns);
+        void buildNode(_In_ UINT uLevel, _In_ UINT uTileX, _In_ UINT uTileZ);
+        TileBounds getTileBounds(_In_ UINT uLevel, _In_ UINT uTileX, _In_ UINT uTileZ) const;
+        BOOL isHidden(_In_ UINT uNodeIndex, _In_ const TileBounds& bounds) const;
+        void cullTile(_In_ UINT uLevel, _In_ UINT uTileX, _In_ UINT uTileZ);
+        void addOccluder(_In_ UINT uNodeIndex, _In_ const TileBounds& bounds);
+        void commitOccluders(_In_ FLOAT distance);
+
+    private:
+        const VoxelGrid& m_grid;
+        UINT m_uNumLevels;
+        std::vector<UINT> m_auLevelWidths;
+        std::vector<UINT> m_auLevelDepths;
+        std::vector<UINT> m_auFirstNodes;
+        std::vector<WORD> m_aMinHeights;
+        std::vector<WORD> m_aMaxHeights;
+        std::vector<UINT> m_aNumBlocks;
+        std::vector<UINT> m_aVisibleFrames;
+        UINT m_uFrame;
+        XMFLOAT3 m_eye;
+        std::vector<FLOAT> m_aHorizon;
+        std::vector<Occluder> m_aOccluders;
+        std::vector<std::pair<FLOAT, UINT>> m_aChunkOrder;
+        VoxelHorizonStats m_stats;
+    };
+}
\ No newline at end of file
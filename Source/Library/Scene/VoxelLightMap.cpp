@@ -0,0 +1,614 @@
+#include "Scene/VoxelLightMap.h"
+
+#include <algorithm>
+#include <cmath>
+#include <execution>
+#include <numeric>
+
+namespace library
+{
+    namespace
+    {
+        // Brightness kept per level of light, a light of MAX_LIGHT is 1
+        constexpr const FLOAT LIGHT_FALLOFF = 0.8f;
+
+        // Brightness of full sky light next to a block light of the same level
+        constexpr const FLOAT SKY_BRIGHTNESS = 0.9f;
+
+        // Brightness of a vertex touched by 0 to 3 solid neighbors
+        constexpr const FLOAT OCCLUSION_BRIGHTNESS[VoxelLightMap::MAX_OCCLUSION + 1u] = { 1.0f, 0.8f, 0.6f, 0.4f };
+
+        // Offsets of the 6 neighbors of a cell, the sky light goes down without loss along the first one
+        constexpr const INT NEIGHBOR_OFFSETS[6][3] =
+        {
+            { 0, -1, 0 }, { 0, 1, 0 }, { -1, 0, 0 }, { 1, 0, 0 }, { 0, 0, -1 }, { 0, 0, 1 },
+        };
+
+        BOOL isSolidBlockType(_In_ CHAR blockType)
+        {
+            return static_cast<CHAR>(eBlockType::GRASSLAND) <= blockType && blockType < static_cast<CHAR>(eBlockType::COUNT);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelLightMap::PackShade
+      Summary:  Packs the light of the cell a face looks into and the
+                occlusion of one of its vertices
+      Args:     BYTE uLight
+                  Light returned by GetLight
+                BYTE uOcclusion
+                  Solid neighbors of the vertex, 0 to MAX_OCCLUSION
+      Returns:  WORD
+                  Light in the low byte, occlusion in the high byte
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    WORD VoxelLightMap::PackShade(_In_ BYTE uLight, _In_ BYTE uOcclusion)
+    {
+        return static_cast<WORD>(uLight | (std::min(uOcclusion, MAX_OCCLUSION) << 8u));
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelLightMap::GetBrightness
+      Summary:  Turns a packed shade into the brightness added to the
+                dynamic lights, the brighter of the sky and the block
+                light, darkened by the occlusion
+      Args:     WORD uShade
+                  Shade packed by PackShade
+      Returns:  FLOAT
+                  Brightness, 0 to 1
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT VoxelLightMap::GetBrightness(_In_ WORD uShade)
+    {
+        static const std::vector<FLOAT> s_aLevelBrightness = []()
+        {
+            std::vector<FLOAT> aLevelBrightness(MAX_LIGHT + 1u, 0.0f);
+            for (UINT uLevel = 1u; uLevel <= MAX_LIGHT; ++uLevel)
+            {
+                aLevelBrightness[uLevel] = std::pow(LIGHT_FALLOFF, static_cast<FLOAT>(MAX_LIGHT - uLevel));
+            }
+            return aLevelBrightness;
+        }();
+
+        BYTE uLight = static_cast<BYTE>(uShade & 0xFFu);
+        BYTE uOcclusion = static_cast<BYTE>(std::min<UINT>(uShade >> 8u, MAX_OCCLUSION));
+
+        FLOAT skyBrightness = SKY_BRIGHTNESS * s_aLevelBrightness[(uLight >> SKY_SHIFT) & MAX_LIGHT];
+        FLOAT blockBrightness = s_aLevelBrightness[(uLight >> BLOCK_SHIFT) & MAX_LIGHT];
+
+        return std::max(skyBrightness, blockBrightness) * OCCLUSION_BRIGHTNESS[uOcclusion];
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelLightMap::VoxelLightMap
+      Summary:  Constructor. Every cell is dark until Bake
+      Args:     const VoxelGrid& grid
+                  Blocks to light, must outlive the light map
+      Modifies: [m_grid, m_uWidth, m_uHeight, m_uDepth, m_aLights,
+                 m_uNumColumnWords, m_aSolidBits, m_lightLevels,
+                 m_bBaked].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    VoxelLightMap::VoxelLightMap(_In_ const VoxelGrid& grid)
+        : m_grid(grid)
+        , m_uWidth(grid.GetWidth())
+        , m_uHeight(grid.GetHeight())
+        , m_uDepth(grid.GetDepth())
+        , m_aLights(static_cast<size_t>(grid.GetWidth()) * grid.GetHeight() * grid.GetDepth(), 0u)
+        , m_uNumColumnWords((grid.GetHeight() + 63u) / 64u)
+        , m_aSolidBits(static_cast<size_t>(grid.GetWidth()) * grid.GetDepth() * ((grid.GetHeight() + 63u) / 64u), 0u)
+        , m_lightLevels()
+        , m_bBaked(FALSE)
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelLightMap::AddLight
+      Summary:  Adds a static block light. Once baked, the light is
+                flooded right away. A light inside a solid block is
+                kept and shines when the block is cleared
+      Args:     UINT x
+                UINT y
+                UINT z
+                  Cell of the light
+                BYTE uLevel
+                  Level of the light, 1 to MAX_LIGHT
+      Modifies: [m_lightLevels, m_aLights].
+      Returns:  HRESULT
+                  Status code, E_INVALIDARG outside of the grid
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT VoxelLightMap::AddLight(_In_ UINT x, _In_ UINT y, _In_ UINT z, _In_ BYTE uLevel)
+    {
+        if (x >= m_uWidth || y >= m_uHeight || z >= m_uDepth || uLevel == 0u || uLevel > MAX_LIGHT)
+        {
+            return E_INVALIDARG;
+        }
+
+        UINT uCell = getCellIndex(x, y, z);
+        BYTE& uLightLevel = m_lightLevels[uCell];
+        uLightLevel = std::max(uLightLevel, uLevel);
+
+        if (m_bBaked && !isSolid(uCell) && getLevel(uCell, BLOCK_SHIFT) < uLightLevel)
+        {
+            VoxelLightUpdate update = {};
+            std::vector<LightNode> aQueue;
+            setLevel(uCell, BLOCK_SHIFT, uLightLevel, update);
+            aQueue.push_back(LightNode{ .uCell = uCell, .uLevel = uLightLevel });
+            flood(BLOCK_SHIFT, aQueue, update);
+        }
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelLightMap::Bake
+      Summary:  Reads the solid cells of the grid, lights the cells
+                open to the sky, then floods the sky light from the
+                ones next to a darker column, and the block light from
+                every light
+      Args:     BOOL bParallel
+                  Whether the columns are read on all cores, the
+                  floods run on the calling thread
+      Modifies: [m_aLights, m_aSolidBits, m_bBaked].
+      Returns:  VoxelLightUpdate
+                  Lit cells and the whole grid
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    VoxelLightUpdate VoxelLightMap::Bake(_In_ BOOL bParallel)
+    {
+        VoxelLightUpdate update =
+        {
+            .uNumChangedCells = 0u,
+            .uNumVisitedCells = 0u,
+            .uMinX = 0u,
+            .uMinY = 0u,
+            .uMinZ = 0u,
+            .uMaxX = m_uWidth,
+            .uMaxY = m_uHeight,
+            .uMaxZ = m_uDepth
+        };
+
+        std::fill(m_aLights.begin(), m_aLights.end(), static_cast<BYTE>(0u));
+        std::fill(m_aSolidBits.begin(), m_aSolidBits.end(), 0ull);
+
+        // Lowest cell of every column with nothing solid above it
+        std::vector<UINT> auSkyBottoms(static_cast<size_t>(m_uWidth) * m_uDepth, 0u);
+
+        std::vector<UINT> aRowIndices(m_uDepth);
+        std::iota(aRowIndices.begin(), aRowIndices.end(), 0u);
+
+        auto readRow = [&](UINT z)
+        {
+            std::vector<VoxelRun> aRuns;
+            for (UINT x = 0u; x < m_uWidth; ++x)
+            {
+                const size_t uColumn = static_cast<size_t>(z) * m_uWidth + x;
+                m_grid.GetColumnRuns(x, z, aRuns);
+
+                UINT uRunStart = 0u;
+                UINT uSkyBottom = 0u;
+                for (const VoxelRun& run : aRuns)
+                {
+                    if (isSolidBlockType(run.blockType))
+                    {
+                        for (UINT y = uRunStart; y < run.uEnd; ++y)
+                        {
+                            m_aSolidBits[uColumn * m_uNumColumnWords + y / 64u] |= 1ull << (y % 64u);
+                        }
+                        uSkyBottom = run.uEnd;
+                    }
+                    uRunStart = run.uEnd;
+                }
+
+                auSkyBottoms[uColumn] = uSkyBottom;
+                std::fill(m_aLights.begin() + uColumn * m_uHeight + uSkyBottom, m_aLights.begin() + (uColumn + 1u) * m_uHeight, static_cast<BYTE>(MAX_LIGHT << SKY_SHIFT));
+            }
+        };
+
+        if (bParallel)
+        {
+            std::for_each(std::execution::par, aRowIndices.begin(), aRowIndices.end(), readRow);
+        }
+        else
+        {
+            std::for_each(aRowIndices.begin(), aRowIndices.end(), readRow);
+        }
+
+        // Only the sky cells beside a column that is dark at their height have anywhere to go
+        std::vector<LightNode> aQueue;
+        for (UINT z = 0u; z < m_uDepth; ++z)
+        {
+            for (UINT x = 0u; x < m_uWidth; ++x)
+            {
+                const size_t uColumn = static_cast<size_t>(z) * m_uWidth + x;
+                UINT uNeighborBottom = 0u;
+                uNeighborBottom = std::max(uNeighborBottom, x > 0u ? auSkyBottoms[uColumn - 1u] : 0u);
+                uNeighborBottom = std::max(uNeighborBottom, x + 1u < m_uWidth ? auSkyBottoms[uColumn + 1u] : 0u);
+                uNeighborBottom = std::max(uNeighborBottom, z > 0u ? auSkyBottoms[uColumn - m_uWidth] : 0u);
+                uNeighborBottom = std::max(uNeighborBottom, z + 1u < m_uDepth ? auSkyBottoms[uColumn + m_uWidth] : 0u);
+
+                for (UINT y = auSkyBottoms[uColumn]; y < uNeighborBottom; ++y)
+                {
+                    aQueue.push_back(LightNode{ .uCell = getCellIndex(x, y, z), .uLevel = MAX_LIGHT });
+                }
+            }
+        }
+        flood(SKY_SHIFT, aQueue, update);
+
+        for (const auto& [uCell, uLevel] : m_lightLevels)
+        {
+            if (!isSolid(uCell) && getLevel(uCell, BLOCK_SHIFT) < uLevel)
+            {
+                setLevel(uCell, BLOCK_SHIFT, uLevel, update);
+                aQueue.push_back(LightNode{ .uCell = uCell, .uLevel = uLevel });
+            }
+        }
+        flood(BLOCK_SHIFT, aQueue, update);
+
+        update.uNumChangedCells = static_cast<UINT64>(m_aLights.size()) - static_cast<UINT64>(std::count(m_aLights.begin(), m_aLights.end(), static_cast<BYTE>(0u)));
+        m_bBaked = TRUE;
+
+        return update;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelLightMap::Relight
+      Summary:  Relights the cells around a block of the grid that was
+                set or cleared since the last bake or relight. A new
+                solid block removes the light that went through its
+                cell, then the cells lit from elsewhere flood the hole
+                back. A cleared block is flooded from its neighbors
+      Args:     UINT x
+                UINT y
+                UINT z
+                  Cell of the changed block
+      Modifies: [m_aLights, m_aSolidBits].
+      Returns:  VoxelLightUpdate
+                  Cells whose light changed, the chunks meshed from
+                  them and from their neighbors must be meshed again
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    VoxelLightUpdate VoxelLightMap::Relight(_In_ UINT x, _In_ UINT y, _In_ UINT z)
+    {
+        VoxelLightUpdate update =
+        {
+            .uNumChangedCells = 0u,
+            .uNumVisitedCells = 0u,
+            .uMinX = m_uWidth,
+            .uMinY = m_uHeight,
+            .uMinZ = m_uDepth,
+            .uMaxX = 0u,
+            .uMaxY = 0u,
+            .uMaxZ = 0u
+        };
+
+        if (!m_bBaked || x >= m_uWidth || y >= m_uHeight || z >= m_uDepth)
+        {
+            return update;
+        }
+
+        // Changing the type of a solid block changes no light
+        const UINT uCell = getCellIndex(x, y, z);
+        const BOOL bSolid = isSolidBlockType(m_grid.GetBlock(x, y, z));
+        if (bSolid == isSolid(uCell))
+        {
+            return update;
+        }
+        setSolid(uCell, bSolid);
+
+        std::vector<LightNode> aRemovals;
+        std::vector<LightNode> aRefills;
+        for (UINT uShift : { SKY_SHIFT, BLOCK_SHIFT })
+        {
+            if (bSolid)
+            {
+                BYTE uLevel = getLevel(uCell, uShift);
+                if (uLevel > 0u)
+                {
+                    setLevel(uCell, uShift, 0u, update);
+                    aRemovals.push_back(LightNode{ .uCell = uCell, .uLevel = uLevel });
+                    unflood(uShift, aRemovals, aRefills, update);
+                }
+            }
+            else
+            {
+                for (const INT (&offset)[3] : NEIGHBOR_OFFSETS)
+                {
+                    INT neighborX = static_cast<INT>(x) + offset[0];
+                    INT neighborY = static_cast<INT>(y) + offset[1];
+                    INT neighborZ = static_cast<INT>(z) + offset[2];
+                    if (neighborX < 0 || neighborY < 0 || neighborZ < 0 ||
+                        neighborX >= static_cast<INT>(m_uWidth) || neighborY >= static_cast<INT>(m_uHeight) || neighborZ >= static_cast<INT>(m_uDepth))
+                    {
+                        continue;
+                    }
+
+                    UINT uNeighbor = getCellIndex(static_cast<UINT>(neighborX), static_cast<UINT>(neighborY), static_cast<UINT>(neighborZ));
+                    BYTE uLevel = getLevel(uNeighbor, uShift);
+                    if (uLevel > 0u)
+                    {
+                        aRefills.push_back(LightNode{ .uCell = uNeighbor, .uLevel = uLevel });
+                    }
+                }
+
+                // The top cells see the sky, and a light buried in the block shines again
+                BYTE uLevel = 0u;
+                if (uShift == SKY_SHIFT && y + 1u == m_uHeight)
+                {
+                    uLevel = MAX_LIGHT;
+                }
+                else if (uShift == BLOCK_SHIFT)
+                {
+                    auto it = m_lightLevels.find(uCell);
+                    uLevel = it != m_lightLevels.end() ? it->second : 0u;
+                }
+
+                if (uLevel > 0u)
+                {
+                    setLevel(uCell, uShift, uLevel, update);
+                    aRefills.push_back(LightNode{ .uCell = uCell, .uLevel = uLevel });
+                }
+            }
+
+            flood(uShift, aRefills, update);
+        }
+
+        return update;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelLightMap::GetLight
+      Summary:  Returns the packed light of a cell. The cells above
+                and beside the grid are open to the sky, the ones below
+                are dark
+      Args:     INT x
+                INT y
+                INT z
+                  Cell, can be outside of the grid
+      Returns:  BYTE
+                  Sky light in the high nibble, block light in the low
+                  nibble
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BYTE VoxelLightMap::GetLight(_In_ INT x, _In_ INT y, _In_ INT z) const
+    {
+        if (y < 0)
+        {
+            return 0u;
+        }
+
+        if (x < 0 || z < 0 || x >= static_cast<INT>(m_uWidth) || y >= static_cast<INT>(m_uHeight) || z >= static_cast<INT>(m_uDepth))
+        {
+            return static_cast<BYTE>(MAX_LIGHT << SKY_SHIFT);
+        }
+
+        return m_aLights[getCellIndex(static_cast<UINT>(x), static_cast<UINT>(y), static_cast<UINT>(z))];
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelLightMap::GetSkyLight
+      Summary:  Returns the sky light of a cell
+      Args:     INT x
+                INT y
+                INT z
+                  Cell, can be outside of the grid
+      Returns:  BYTE
+                  Sky light, 0 to MAX_LIGHT
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BYTE VoxelLightMap::GetSkyLight(_In_ INT x, _In_ INT y, _In_ INT z) const
+    {
+        return static_cast<BYTE>((GetLight(x, y, z) >> SKY_SHIFT) & MAX_LIGHT);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelLightMap::GetBlockLight
+      Summary:  Returns the block light of a cell
+      Args:     INT x
+                INT y
+                INT z
+                  Cell, can be outside of the grid
+      Returns:  BYTE
+                  Block light, 0 to MAX_LIGHT
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BYTE VoxelLightMap::GetBlockLight(_In_ INT x, _In_ INT y, _In_ INT z) const
+    {
+        return static_cast<BYTE>((GetLight(x, y, z) >> BLOCK_SHIFT) & MAX_LIGHT);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelLightMap::GetNumLights
+      Summary:  Returns the number of block lights
+      Returns:  UINT
+                  Number of block lights
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT VoxelLightMap::GetNumLights() const
+    {
+        return static_cast<UINT>(m_lightLevels.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelLightMap::GetMemoryUsage
+      Summary:  Returns the bytes of the light levels and of the solid
+                cells
+      Returns:  UINT64
+                  Bytes held by the light map
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT64 VoxelLightMap::GetMemoryUsage() const
+    {
+        return static_cast<UINT64>(m_aLights.capacity()) + static_cast<UINT64>(m_aSolidBits.capacity()) * sizeof(UINT64);
+    }
+
+    UINT VoxelLightMap::getCellIndex(_In_ UINT x, _In_ UINT y, _In_ UINT z) const
+    {
+        return (z * m_uWidth + x) * m_uHeight + y;
+    }
+
+    BOOL VoxelLightMap::isSolid(_In_ UINT uCell) const
+    {
+        const UINT uColumn = uCell / m_uHeight;
+        const UINT y = uCell % m_uHeight;
+
+        return (m_aSolidBits[static_cast<size_t>(uColumn) * m_uNumColumnWords + y / 64u] >> (y % 64u)) & 1u;
+    }
+
+    void VoxelLightMap::setSolid(_In_ UINT uCell, _In_ BOOL bSolid)
+    {
+        const UINT uColumn = uCell / m_uHeight;
+        const UINT y = uCell % m_uHeight;
+        UINT64& uWord = m_aSolidBits[static_cast<size_t>(uColumn) * m_uNumColumnWords + y / 64u];
+
+        uWord = bSolid ? uWord | (1ull << (y % 64u)) : uWord & ~(1ull << (y % 64u));
+    }
+
+    BYTE VoxelLightMap::getLevel(_In_ UINT uCell, _In_ UINT uShift) const
+    {
+        return static_cast<BYTE>((m_aLights[uCell] >> uShift) & MAX_LIGHT);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelLightMap::setLevel
+      Summary:  Sets one light of a cell and grows the box of the
+                update around it
+      Args:     UINT uCell
+                  Index of the cell
+                UINT uShift
+                  SKY_SHIFT or BLOCK_SHIFT
+                BYTE uLevel
+                  New level
+                VoxelLightUpdate& update
+                  Update of the bake or relight
+      Modifies: [m_aLights, update].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelLightMap::setLevel(_In_ UINT uCell, _In_ UINT uShift, _In_ BYTE uLevel, _Inout_ VoxelLightUpdate& update)
+    {
+        m_aLights[uCell] = static_cast<BYTE>((m_aLights[uCell] & ~(MAX_LIGHT << uShift)) | (uLevel << uShift));
+
+        const UINT y = uCell % m_uHeight;
+        const UINT x = (uCell / m_uHeight) % m_uWidth;
+        const UINT z = uCell / m_uHeight / m_uWidth;
+        ++update.uNumChangedCells;
+        update.uMinX = std::min(update.uMinX, x);
+        update.uMinY = std::min(update.uMinY, y);
+        update.uMinZ = std::min(update.uMinZ, z);
+        update.uMaxX = std::max(update.uMaxX, x + 1u);
+        update.uMaxY = std::max(update.uMaxY, y + 1u);
+        update.uMaxZ = std::max(update.uMaxZ, z + 1u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelLightMap::flood
+      Summary:  Spreads one light from the queued cells, breadth
+                first, to every empty cell it makes brighter. Cells
+                that got brighter after they were queued are skipped,
+                their newer node spreads instead
+      Args:     UINT uShift
+                  SKY_SHIFT or BLOCK_SHIFT
+                std::vector<LightNode>& aQueue
+                  Lit cells to spread from, emptied
+                VoxelLightUpdate& update
+                  Update of the bake or relight
+      Modifies: [m_aLights, aQueue, update].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelLightMap::flood(_In_ UINT uShift, _Inout_ std::vector<LightNode>& aQueue, _Inout_ VoxelLightUpdate& update)
+    {
+        for (size_t i = 0u; i < aQueue.size(); ++i)
+        {
+            const LightNode node = aQueue[i];
+            if (getLevel(node.uCell, uShift) != node.uLevel)
+            {
+                continue;
+            }
+            ++update.uNumVisitedCells;
+
+            const INT y = static_cast<INT>(node.uCell % m_uHeight);
+            const INT x = static_cast<INT>((node.uCell / m_uHeight) % m_uWidth);
+            const INT z = static_cast<INT>(node.uCell / m_uHeight / m_uWidth);
+            for (UINT uNeighbor = 0u; uNeighbor < ARRAYSIZE(NEIGHBOR_OFFSETS); ++uNeighbor)
+            {
+                BYTE uLevel = uShift == SKY_SHIFT && uNeighbor == 0u && node.uLevel == MAX_LIGHT ? MAX_LIGHT : static_cast<BYTE>(node.uLevel - 1u);
+                INT neighborX = x + NEIGHBOR_OFFSETS[uNeighbor][0];
+                INT neighborY = y + NEIGHBOR_OFFSETS[uNeighbor][1];
+                INT neighborZ = z + NEIGHBOR_OFFSETS[uNeighbor][2];
+                if (uLevel == 0u || neighborX < 0 || neighborY < 0 || neighborZ < 0 ||
+                    neighborX >= static_cast<INT>(m_uWidth) || neighborY >= static_cast<INT>(m_uHeight) || neighborZ >= static_cast<INT>(m_uDepth))
+                {
+                    continue;
+                }
+
+                UINT uCell = getCellIndex(static_cast<UINT>(neighborX), static_cast<UINT>(neighborY), static_cast<UINT>(neighborZ));
+                if (!isSolid(uCell) && getLevel(uCell, uShift) < uLevel)
+                {
+                    setLevel(uCell, uShift, uLevel, update);
+                    aQueue.push_back(LightNode{ .uCell = uCell, .uLevel = uLevel });
+                }
+            }
+        }
+
+        aQueue.clear();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelLightMap::unflood
+      Summary:  Darkens, breadth first, the cells that were lit
+                through the queued cells, which are already dark. The
+                neighbors lit from elsewhere are queued to flood the
+                darkened cells back, and so are the lights found on the
+                way
+      Args:     UINT uShift
+                  SKY_SHIFT or BLOCK_SHIFT
+                std::vector<LightNode>& aRemovals
+                  Darkened cells with their level before, emptied
+                std::vector<LightNode>& aRefills
+                  Cells to flood from afterwards
+                VoxelLightUpdate& update
+                  Update of the relight
+      Modifies: [m_aLights, aRemovals, aRefills, update].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelLightMap::unflood(_In_ UINT uShift, _Inout_ std::vector<LightNode>& aRemovals, _Inout_ std::vector<LightNode>& aRefills, _Inout_ VoxelLightUpdate& update)
+    {
+        for (size_t i = 0u; i < aRemovals.size(); ++i)
+        {
+            const LightNode node = aRemovals[i];
+            ++update.uNumVisitedCells;
+
+            const INT y = static_cast<INT>(node.uCell % m_uHeight);
+            const INT x = static_cast<INT>((node.uCell / m_uHeight) % m_uWidth);
+            const INT z = static_cast<INT>(node.uCell / m_uHeight / m_uWidth);
+            for (UINT uNeighbor = 0u; uNeighbor < ARRAYSIZE(NEIGHBOR_OFFSETS); ++uNeighbor)
+            {
+                INT neighborX = x + NEIGHBOR_OFFSETS[uNeighbor][0];
+                INT neighborY = y + NEIGHBOR_OFFSETS[uNeighbor][1];
+                INT neighborZ = z + NEIGHBOR_OFFSETS[uNeighbor][2];
+                if (neighborX < 0 || neighborY < 0 || neighborZ < 0 ||
+                    neighborX >= static_cast<INT>(m_uWidth) || neighborY >= static_cast<INT>(m_uHeight) || neighborZ >= static_cast<INT>(m_uDepth))
+                {
+                    continue;
+                }
+
+                UINT uCell = getCellIndex(static_cast<UINT>(neighborX), static_cast<UINT>(neighborY), static_cast<UINT>(neighborZ));
+                BYTE uLevel = getLevel(uCell, uShift);
+                if (uLevel == 0u || isSolid(uCell))
+                {
+                    continue;
+                }
+
+                // A dimmer neighbor, or the full sky light below, was lit through the node
+                BOOL bLitThroughNode = uLevel < node.uLevel || (uShift == SKY_SHIFT && uNeighbor == 0u && node.uLevel == MAX_LIGHT);
+                if (!bLitThroughNode)
+                {
+                    aRefills.push_back(LightNode{ .uCell = uCell, .uLevel = uLevel });
+                    continue;
+                }
+
+                setLevel(uCell, uShift, 0u, update);
+                aRemovals.push_back(LightNode{ .uCell = uCell, .uLevel = uLevel });
+
+                if (uShift == BLOCK_SHIFT)
+                {
+                    auto it = m_lightLevels.find(uCell);
+                    if (it != m_lightLevels.end())
+                    {
+                        setLevel(uCell, uShift, it->second, update);
+                        aRefills.push_back(LightNode{ .uCell = uCell, .uLevel = it->second });
+                    }
+                }
+            }
+        }
+
+        aRemovals.clear();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,141 @@
+/*+===================================================================
+  File:      VOXELLIGHTMAP.H
+
+  Summary:   VoxelLightMap header file contains declarations of
+             VoxelLightMap class used to bake the sky light and the
+             light of static block lights of a voxel grid on the CPU,
+             and to relight the cells around an edited block.
+
+  Classes: VoxelLightMap
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Scene/VoxelGrid.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   VoxelLightUpdate
+
+        Summary:  Cells whose light changed in a bake or a relight, and
+                  the box that contains them, min included and max
+                  excluded. The box is empty when no light changed
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct VoxelLightUpdate
+    {
+        UINT64 uNumChangedCells;
+        UINT64 uNumVisitedCells;
+        UINT uMinX;
+        UINT uMinY;
+        UINT uMinZ;
+        UINT uMaxX;
+        UINT uMaxY;
+        UINT uMaxZ;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    VoxelLightMap
+
+      Summary:  Sky and block light of every cell of a grid, 0 to
+                MAX_LIGHT each, packed in one byte per cell. Sky light
+                is MAX_LIGHT in the cells open to the sky and goes down
+                without loss, block light starts at the level of its
+                light. Both lose one level per step everywhere else
+                and are flooded breadth first through the empty cells.
+                After a block of the grid changes, Relight removes the
+                light that went through the cell and floods the
+                neighbors back in, so only the cells around the edit
+                are visited. Runs on the CPU only so it can be used
+                without a device
+
+      Methods:  PackShade
+                  Packs the light of a cell and the occlusion of a
+                  vertex
+                GetBrightness
+                  Returns the brightness of a packed shade
+                AddLight
+                  Adds a static block light
+                Bake
+                  Lights every cell of the grid
+                Relight
+                  Relights the cells around a changed block
+                GetLight
+                  Returns the packed light of a cell
+                GetSkyLight / GetBlockLight
+                  Return the light levels of a cell
+                GetNumLights
+                  Returns the number of block lights
+                GetMemoryUsage
+                  Returns the bytes held by the light map
+                VoxelLightMap
+                  Constructor.
+                ~VoxelLightMap
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class VoxelLightMap
+    {
+    public:
+        static constexpr const BYTE MAX_LIGHT = 15u;
+        static constexpr const BYTE MAX_OCCLUSION = 3u;
+
+        static WORD PackShade(_In_ BYTE uLight, _In_ BYTE uOcclusion);
+        static FLOAT GetBrightness(_In_ WORD uShade);
+
+        VoxelLightMap() = delete;
+        VoxelLightMap(_In_ const VoxelGrid& grid);
+        VoxelLightMap(const VoxelLightMap& other) = delete;
+        VoxelLightMap(VoxelLightMap&& other) = delete;
+        VoxelLightMap& operator=(const VoxelLightMap& other) = delete;
+        VoxelLightMap& operator=(VoxelLightMap&& other) = delete;
+        ~VoxelLightMap() = default;
+
+        HRESULT AddLight(_In_ UINT x, _In_ UINT y, _In_ UINT z, _In_ BYTE uLevel);
+        VoxelLightUpdate Bake(_In_ BOOL bParallel = TRUE);
+        VoxelLightUpdate Relight(_In_ UINT x, _In_ UINT y, _In_ UINT z);
+
+        BYTE GetLight(_In_ INT x, _In_ INT y, _In_ INT z) const;
+        BYTE GetSkyLight(_In_ INT x, _In_ INT y, _In_ INT z) const;
+        BYTE GetBlockLight(_In_ INT x, _In_ INT y, _In_ INT z) const;
+        UINT GetNumLights() const;
+        UINT64 GetMemoryUsage() const;
+
+    private:
+        static constexpr const UINT SKY_SHIFT = 4u;
+        static constexpr const UINT BLOCK_SHIFT = 0u;
+
+        /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+            Struct:   LightNode
+
+            Summary:  Cell waiting in a flood and its level when it was
+                      queued
+        S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+        struct LightNode
+        {
+            UINT uCell;
+            BYTE uLevel;
+        };
+
+        UINT getCellIndex(_In_ UINT x, _In_ UINT y, _In_ UINT z) const;
+        BOOL isSolid(_In_ UINT uCell) const;
+        void setSolid(_In_ UINT uCell, _In_ BOOL bSolid);
+        BYTE getLevel(_In_ UINT uCell, _In_ UINT uShift) const;
+        void setLevel(_In_ UINT uCell, _In_ UINT uShift, _In_ BYTE uLevel, _Inout_ VoxelLightUpdate& update);
+        void flood(_In_ UINT uShift, _Inout_ std::vector<LightNode>& aQueue, _Inout_ VoxelLightUpdate& update);
+        void unflood(_In_ UINT uShift, _Inout_ std::vector<LightNode>& aRemovals, _Inout_ std::vector<LightNode>& aRefills, _Inout_ VoxelLightUpdate& update);
+
+    private:
+        const VoxelGrid& m_grid;
+        UINT m_uWidth;
+        UINT m_uHeight;
+        UINT m_uDepth;
+        std::vector<BYTE> m_aLights;
+        UINT m_uNumColumnWords;
+        std::vector<UINT64> m_aSolidBits;
+        std::unordered_map<UINT, BYTE> m_lightLevels;
+        BOOL m_bBaked;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,406 @@
+#include "Scene/VoxelLodTree.h"
+
+#include <algorithm>
+#include <execution>
+
+namespace library
+{
+    namespace
+    {
+        // A refined node merges back only once its error falls below this fraction of the limit
+        constexpr const FLOAT LOD_HYSTERESIS = 0.75f;
+
+        FLOAT distanceToBounds(_In_ const XMFLOAT3& point, _In_ const XMFLOAT3& boundsMin, _In_ const XMFLOAT3& boundsMax)
+        {
+            FLOAT dx = std::max({ boundsMin.x - point.x, 0.0f, point.x - boundsMax.x });
+            FLOAT dy = std::max({ boundsMin.y - point.y, 0.0f, point.y - boundsMax.y });
+            FLOAT dz = std::max({ boundsMin.z - point.z, 0.0f, point.z - boundsMax.z });
+
+            return std::sqrt(dx * dx + dy * dy + dz * dz);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelLodTree::GetGeometricError
+      Summary:  Returns how far the surface of a level can be from the
+                full detail surface. A merged block is up to 2^l - 1
+                blocks taller or wider than the blocks it replaces
+      Args:     UINT uLevel
+                  Level of detail
+      Returns:  FLOAT
+                  Error in world units, blocks are 2 units wide
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    FLOAT VoxelLodTree::GetGeometricError(_In_ UINT uLevel)
+    {
+        return 2.0f * static_cast<FLOAT>((1u << uLevel) - 1u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelLodTree::VoxelLodTree
+      Summary:  Constructor. Lays out the nodes of every level, the
+                map placed like the instanced voxels. Build meshes them
+      Args:     const HeightMap& heightMap
+                  Height map, must outlive the tree
+                eVoxelMeshing meshing
+                  Meshing algorithm of the nodes
+                FLOAT maxScreenError
+                  Largest error allowed on screen, in pixels
+      Modifies: [m_heightMap, m_meshing, m_maxScreenError, m_origin,
+                 m_auNumNodesX, m_auNumNodesZ, m_auFirstNodes,
+                 m_aNodes, m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    VoxelLodTree::VoxelLodTree(_In_ const HeightMap& heightMap, _In_ eVoxelMeshing meshing, _In_ FLOAT maxScreenError)
+        : m_heightMap(heightMap)
+        , m_meshing(meshing)
+        , m_maxScreenError(maxScreenError)
+        , m_origin(
+            -static_cast<FLOAT>(heightMap.GetWidth()) - 1.0f,
+            -2.0f * static_cast<FLOAT>(heightMap.GetHeight()) + 0.75f * static_cast<FLOAT>(heightMap.GetHeight()) - 1.0f,
+            -static_cast<FLOAT>(heightMap.GetDepth()) - 1.0f
+        )
+        , m_auNumNodesX()
+        , m_auNumNodesZ()
+        , m_auFirstNodes()
+        , m_aNodes()
+        , m_stats()
+    {
+        for (UINT uLevel = 0u; uLevel < NUM_VOXEL_LOD_LEVELS; ++uLevel)
+        {
+            UINT uNodeColumns = CHUNK_SIZE << uLevel;
+            m_auNumNodesX[uLevel] = (m_heightMap.GetWidth() + uNodeColumns - 1u) / uNodeColumns;
+            m_auNumNodesZ[uLevel] = (m_heightMap.GetDepth() + uNodeColumns - 1u) / uNodeColumns;
+            m_auFirstNodes[uLevel] = static_cast<UINT>(m_aNodes.size());
+
+            for (UINT uNodeZ = 0u; uNodeZ < m_auNumNodesZ[uLevel]; ++uNodeZ)
+            {
+                for (UINT uNodeX = 0u; uNodeX < m_auNumNodesX[uLevel]; ++uNodeX)
+                {
+                    m_aNodes.push_back(
+                        VoxelLodNode
+                        {
+                            .uLevel = uLevel,
+                            .uNodeX = uNodeX,
+                            .uNodeZ = uNodeZ
+                        }
+                    );
+                }
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelLodTree::Build
+      Summary:  Meshes every node of every level
+      Args:     BOOL bParallel
+                  Whether the nodes are meshed on all cores
+      Modifies: [m_aNodes].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelLodTree::Build(_In_ BOOL bParallel)
+    {
+        auto buildOne = [this](VoxelLodNode& node)
+        {
+            buildNode(node);
+        };
+
+        if (bParallel)
+        {
+            std::for_each(std::execution::par, m_aNodes.begin(), m_aNodes.end(), buildOne);
+        }
+        else
+        {
+            std::for_each(m_aNodes.begin(), m_aNodes.end(), buildOne);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelLodTree::Select
+      Summary:  Picks the nodes to draw. Starting from the coarsest
+                level, a node is split into its four children while
+                its geometric error, projected at the distance of its
+                bounds, covers more than the allowed number of pixels
+      Args:     const XMVECTOR& eye
+                  Position of the camera
+                FLOAT projectionScale
+                  Pixels covered by one world unit at a distance of one
+                  unit, the viewport height / (2 tan(fovY / 2))
+                std::vector<UINT>& aOutNodeIndices
+                  Indices of the non-empty nodes to draw
+      Modifies: [m_aNodes, m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelLodTree::Select(_In_ const XMVECTOR& eye, _In_ FLOAT projectionScale, _Out_ std::vector<UINT>& aOutNodeIndices)
+    {
+        aOutNodeIndices.clear();
+        m_stats = {};
+
+        XMFLOAT3 eyePosition(XMVectorGetX(eye), XMVectorGetY(eye), XMVectorGetZ(eye));
+
+        constexpr const UINT uRootLevel = NUM_VOXEL_LOD_LEVELS - 1u;
+        for (UINT uNodeZ = 0u; uNodeZ < m_auNumNodesZ[uRootLevel]; ++uNodeZ)
+        {
+            for (UINT uNodeX = 0u; uNodeX < m_auNumNodesX[uRootLevel]; ++uNodeX)
+            {
+                selectNode(getNodeIndex(uRootLevel, uNodeX, uNodeZ), eyePosition, projectionScale, aOutNodeIndices);
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelLodTree::GetNode
+      Summary:  Returns a node, its meshes can be moved out once built
+      Args:     UINT uNodeIndex
+                  Index of the node, as returned by Select
+      Returns:  VoxelLodNode&
+                  Node
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    VoxelLodNode& VoxelLodTree::GetNode(_In_ UINT uNodeIndex)
+    {
+        return m_aNodes[uNodeIndex];
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelLodTree::GetNumNodes
+      Summary:  Returns the number of nodes of every level
+      Returns:  UINT
+                  Number of nodes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT VoxelLodTree::GetNumNodes() const
+    {
+        return static_cast<UINT>(m_aNodes.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelLodTree::GetStats
+      Summary:  Returns the geometry picked by the last selection
+      Returns:  const VoxelLodStats&
+                  Selection statistics
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const VoxelLodStats& VoxelLodTree::GetStats() const
+    {
+        return m_stats;
+    }
+
+    UINT VoxelLodTree::getNodeIndex(_In_ UINT uLevel, _In_ UINT uNodeX, _In_ UINT uNodeZ) const
+    {
+        return m_auFirstNodes[uLevel] + uNodeZ * m_auNumNodesX[uLevel] + uNodeX;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelLodTree::buildNode
+      Summary:  Merges the columns of the node into 2^l x 2^l cells as
+                tall as their highest column, rounded up to whole
+                merged blocks, meshes them and scales the meshes back
+                to world space. Full detail nodes carry a border of
+                neighbor cells to hide the faces between nodes, coarse
+                nodes are meshed alone so their borders keep the side
+                faces that close the gaps to finer neighbors
+      Args:     VoxelLodNode& node
+                  Node to mesh
+      Modifies: [node].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelLodTree::buildNode(_Inout_ VoxelLodNode& node) const
+    {
+        const UINT uScale = 1u << node.uLevel;
+        const UINT uBorder = node.uLevel == 0u ? 1u : 0u;
+        const UINT uRegionSize = CHUNK_SIZE + 2u * uBorder;
+        const UINT uLevelHeight = (m_heightMap.GetHeight() + uScale - 1u) / uScale;
+
+        HeightMap region(uRegionSize, uLevelHeight, uRegionSize, std::vector<XMFLOAT4>(m_heightMap.GetPalette()));
+
+        UINT uMaxHeight = 0u;
+        for (UINT uRegionZ = 0u; uRegionZ < uRegionSize; ++uRegionZ)
+        {
+            for (UINT uRegionX = 0u; uRegionX < uRegionSize; ++uRegionX)
+            {
+                INT cellX = static_cast<INT>(node.uNodeX * CHUNK_SIZE + uRegionX) - static_cast<INT>(uBorder);
+                INT cellZ = static_cast<INT>(node.uNodeZ * CHUNK_SIZE + uRegionZ) - static_cast<INT>(uBorder);
+                if (cellX < 0 || cellZ < 0)
+                {
+                    continue;
+                }
+
+                UINT uFirstX = static_cast<UINT>(cellX) * uScale;
+                UINT uFirstZ = static_cast<UINT>(cellZ) * uScale;
+                UINT uLastX = std::min(uFirstX + uScale, m_heightMap.GetWidth());
+                UINT uLastZ = std::min(uFirstZ + uScale, m_heightMap.GetDepth());
+
+                // The tallest column gives its height and its block type to the merged cell
+                UINT uColumnHeight = 0u;
+                CHAR blockType = HeightMap::EMPTY_BLOCK;
+                for (UINT z = uFirstZ; z < uLastZ; ++z)
+                {
+                    for (UINT x = uFirstX; x < uLastX; ++x)
+                    {
+                        UINT uHeight = m_heightMap.GetColumnHeight(x, z);
+                        if (uHeight > uColumnHeight)
+                        {
+                            uColumnHeight = uHeight;
+                            blockType = m_heightMap.GetBlockType(x, z);
+                        }
+                    }
+                }
+
+                if (uColumnHeight == 0u)
+                {
+                    continue;
+                }
+
+                UINT uMergedHeight = (uColumnHeight + uScale - 1u) / uScale;
+                region.SetCell(uRegionX, uRegionZ, blockType, (static_cast<FLOAT>(uMergedHeight) + 0.5f) / static_cast<FLOAT>(uLevelHeight));
+
+                if (uRegionX >= uBorder && uRegionX < uBorder + CHUNK_SIZE && uRegionZ >= uBorder && uRegionZ < uBorder + CHUNK_SIZE)
+                {
+                    uMaxHeight = std::max(uMaxHeight, uMergedHeight * uScale);
+                }
+            }
+        }
+
+        const FLOAT nodeSize = 2.0f * static_cast<FLOAT>(CHUNK_SIZE * uScale);
+        const XMFLOAT3 nodeOrigin(
+            m_origin.x + nodeSize * static_cast<FLOAT>(node.uNodeX),
+            m_origin.y,
+            m_origin.z + nodeSize * static_cast<FLOAT>(node.uNodeZ)
+        );
+
+        node.boundsMin = nodeOrigin;
+        node.boundsMax = XMFLOAT3(nodeOrigin.x + nodeSize, nodeOrigin.y + 2.0f * static_cast<FLOAT>(uMaxHeight), nodeOrigin.z + nodeSize);
+        node.aMeshes.clear();
+        node.uNumVertices = 0u;
+        node.uNumTriangles = 0u;
+        node.uNumDraws = 0u;
+
+        if (uMaxHeight == 0u)
+        {
+            return;
+        }
+
+        VoxelGrid regionGrid(region);
+        VoxelChunkMesher mesher(regionGrid, m_meshing, nodeOrigin, uBorder);
+        for (UINT uChunkY = 0u; uChunkY < mesher.GetNumChunksY(); ++uChunkY)
+        {
+            VoxelChunkMesh mesh;
+            mesher.MeshChunk(0u, uChunkY, 0u, mesh);
+            if (mesh.aVertices.empty())
+            {
+                continue;
+            }
+
+            // Merged blocks are 2^l blocks wide, the texture keeps tiling once per block
+            const FLOAT scale = static_cast<FLOAT>(uScale);
+            for (SimpleVertex& vertex : mesh.aVertices)
+            {
+                vertex.Position.x = nodeOrigin.x + (vertex.Position.x - nodeOrigin.x) * scale;
+                vertex.Position.y = nodeOrigin.y + (vertex.Position.y - nodeOrigin.y) * scale;
+                vertex.Position.z = nodeOrigin.z + (vertex.Position.z - nodeOrigin.z) * scale;
+                vertex.TexCoord.x *= scale;
+                vertex.TexCoord.y *= scale;
+            }
+
+            mesh.uChunkX = node.uNodeX;
+            mesh.uChunkZ = node.uNodeZ;
+
+            node.uNumVertices += mesh.aVertices.size();
+            node.uNumTriangles += mesh.aIndices.size() / 3u;
+            node.uNumDraws += mesh.aSections.size();
+            node.aMeshes.push_back(std::move(mesh));
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelLodTree::mergeNode
+      Summary:  Clears the refined flag of the node and of all of its
+                descendants
+      Args:     UINT uNodeIndex
+                  Index of the node
+      Modifies: [m_aNodes].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelLodTree::mergeNode(_In_ UINT uNodeIndex)
+    {
+        VoxelLodNode& node = m_aNodes[uNodeIndex];
+        if (!node.bRefined)
+        {
+            return;
+        }
+
+        node.bRefined = FALSE;
+        if (node.uLevel == 0u)
+        {
+            return;
+        }
+
+        UINT uChildLevel = node.uLevel - 1u;
+        for (UINT uChildZ = node.uNodeZ * 2u; uChildZ < std::min(node.uNodeZ * 2u + 2u, m_auNumNodesZ[uChildLevel]); ++uChildZ)
+        {
+            for (UINT uChildX = node.uNodeX * 2u; uChildX < std::min(node.uNodeX * 2u + 2u, m_auNumNodesX[uChildLevel]); ++uChildX)
+            {
+                mergeNode(getNodeIndex(uChildLevel, uChildX, uChildZ));
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelLodTree::selectNode
+      Summary:  Selects the node, or its children when it is refined.
+                A node is refined above the error limit and merged
+                back only below LOD_HYSTERESIS of it, so a camera
+                hovering around the limit does not flip the node every
+                frame
+      Args:     UINT uNodeIndex
+                  Index of the node
+                const XMFLOAT3& eye
+                  Position of the camera
+                FLOAT projectionScale
+                  Pixels covered by one world unit at a distance of one
+                  unit
+                std::vector<UINT>& aOutNodeIndices
+                  Indices of the nodes to draw
+      Modifies: [m_aNodes, m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelLodTree::selectNode(_In_ UINT uNodeIndex, _In_ const XMFLOAT3& eye, _In_ FLOAT projectionScale, _Inout_ std::vector<UINT>& aOutNodeIndices)
+    {
+        VoxelLodNode& node = m_aNodes[uNodeIndex];
+
+        if (node.uLevel > 0u)
+        {
+            FLOAT distance = std::max(distanceToBounds(eye, node.boundsMin, node.boundsMax), 1.0f);
+            FLOAT screenError = GetGeometricError(node.uLevel) * projectionScale / distance;
+            BOOL bRefine = screenError > (node.bRefined ? m_maxScreenError * LOD_HYSTERESIS : m_maxScreenError);
+
+            if (bRefine != node.bRefined)
+            {
+                // Merged children start unrefined the next time the node is split
+                if (!bRefine)
+                {
+                    mergeNode(uNodeIndex);
+                }
+                node.bRefined = bRefine;
+                ++m_stats.uNumChangedNodes;
+            }
+
+            if (bRefine)
+            {
+                UINT uChildLevel = node.uLevel - 1u;
+                for (UINT uChildZ = node.uNodeZ * 2u; uChildZ < std::min(node.uNodeZ * 2u + 2u, m_auNumNodesZ[uChildLevel]); ++uChildZ)
+                {
+                    for (UINT uChildX = node.uNodeX * 2u; uChildX < std::min(node.uNodeX * 2u + 2u, m_auNumNodesX[uChildLevel]); ++uChildX)
+                    {
+                        selectNode(getNodeIndex(uChildLevel, uChildX, uChildZ), eye, projectionScale, aOutNodeIndices);
+                    }
+                }
+                return;
+            }
+        }
+
+        if (node.uNumDraws == 0u)
+        {
+            return;
+        }
+
+        VoxelLodLevelStats& levelStats = m_stats.aLevels[node.uLevel];
+        ++levelStats.uNumNodes;
+        levelStats.uNumVertices += node.uNumVertices;
+        levelStats.uNumTriangles += node.uNumTriangles;
+        levelStats.uNumDraws += node.uNumDraws;
+
+        aOutNodeIndices.push_back(uNodeIndex);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,141 @@
+/*+===================================================================
+  File:      VOXELLODTREE.H
+
+  Summary:   VoxelLodTree header file contains declarations of
+             VoxelLodTree class used to draw distant voxel terrain
+             with merged 2x, 4x and 8x blocks.
+
+  Classes: VoxelLodTree
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Scene/HeightMap.h"
+#include "Scene/VoxelChunkMesher.h"
+
+namespace library
+{
+    constexpr const UINT NUM_VOXEL_LOD_LEVELS = 4u;
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   VoxelLodNode
+
+        Summary:  Node of the tree, a square of CHUNK_SIZE x CHUNK_SIZE
+                  blocks of 2^uLevel x 2^uLevel columns. The meshes are
+                  in world space, one per vertical chunk
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct VoxelLodNode
+    {
+        UINT uLevel;
+        UINT uNodeX;
+        UINT uNodeZ;
+        XMFLOAT3 boundsMin;
+        XMFLOAT3 boundsMax;
+        std::vector<VoxelChunkMesh> aMeshes;
+        UINT64 uNumVertices;
+        UINT64 uNumTriangles;
+        UINT64 uNumDraws;
+        BOOL bRefined;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   VoxelLodLevelStats
+
+        Summary:  Geometry selected at one level of detail
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct VoxelLodLevelStats
+    {
+        UINT64 uNumNodes;
+        UINT64 uNumVertices;
+        UINT64 uNumTriangles;
+        UINT64 uNumDraws;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   VoxelLodStats
+
+        Summary:  Result of the last selection. Changed nodes are the
+                  ones refined or merged since the previous selection
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct VoxelLodStats
+    {
+        VoxelLodLevelStats aLevels[NUM_VOXEL_LOD_LEVELS];
+        UINT64 uNumChangedNodes;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    VoxelLodTree
+
+      Summary:  Quadtree of voxel meshes over the height map, the
+                octree of a 2.5D map since every node spans the whole
+                height. Level l merges 2^l x 2^l x 2^l blocks into one,
+                as tall as the highest of them so that a coarse node
+                always covers the blocks it replaces. Coarse nodes keep
+                their side faces on their borders, which hides the
+                cracks against finer neighbors. Select walks down from
+                the coarsest level and refines a node while its
+                geometric error projects to more than the allowed
+                number of pixels, with hysteresis against popping.
+                Runs on the CPU only so it can be used without a
+                device
+
+      Methods:  Build
+                  Meshes every node of every level
+                Select
+                  Picks the nodes to draw from the camera position
+                GetNode
+                  Returns a node
+                GetNumNodes
+                  Returns the number of nodes of every level
+                GetStats
+                  Returns the result of the last selection
+                GetGeometricError
+                  Returns the height error of a level in world units
+                VoxelLodTree
+                  Constructor.
+                ~VoxelLodTree
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class VoxelLodTree
+    {
+    public:
+        static constexpr const UINT CHUNK_SIZE = VoxelChunkMesher::CHUNK_SIZE;
+
+        static FLOAT GetGeometricError(_In_ UINT uLevel);
+
+        VoxelLodTree() = delete;
+        VoxelLodTree(_In_ const HeightMap& heightMap, _In_ eVoxelMeshing meshing, _In_ FLOAT maxScreenError);
+        VoxelLodTree(const VoxelLodTree& other) = delete;
+        VoxelLodTree(VoxelLodTree&& other) = delete;
+        VoxelLodTree& operator=(const VoxelLodTree& other) = delete;
+        VoxelLodTree& operator=(VoxelLodTree&& other) = delete;
+        ~VoxelLodTree() = default;
+
+        void Build(_In_ BOOL bParallel = TRUE);
+        void Select(_In_ const XMVECTOR& eye, _In_ FLOAT projectionScale, _Out_ std::vector<UINT>& aOutNodeIndices);
+
+        VoxelLodNode& GetNode(_In_ UINT uNodeIndex);
+        UINT GetNumNodes() const;
+        const VoxelLodStats& GetStats() const;
+
+    private:
+        UINT getNodeIndex(_In_ UINT uLevel, _In_ UINT uNodeX, _In_ UINT uNodeZ) const;
+        void buildNode(_Inout_ VoxelLodNode& node) const;
+        void mergeNode(_In_ UINT uNodeIndex);
+        void selectNode(_In_ UINT uNodeIndex, _In_ const XMFLOAT3& eye, _In_ FLOAT projectionScale, _Inout_ std::vector<UINT>& aOutNodeIndices);
+
+    private:
+        const HeightMap& m_heightMap;
+        eVoxelMeshing m_meshing;
+        FLOAT m_maxScreenError;
+        XMFLOAT3 m_origin;
+        UINT m_auNumNodesX[NUM_VOXEL_LOD_LEVELS];
+        UINT m_auNumNodesZ[NUM_VOXEL_LOD_LEVELS];
+        UINT m_auFirstNodes[NUM_VOXEL_LOD_LEVELS];
+        std::vector<VoxelLodNode> m_aNodes;
+        VoxelLodStats m_stats;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,552 @@
+#include "Scene/VoxelRegionFile.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace library
+{
+    namespace
+    {
+        // Shortest match worth an offset, and the hash table of the last position of every 4-byte sequence
+        constexpr const size_t MIN_MATCH = 4u;
+        constexpr const size_t MAX_OFFSET = 65535u;
+        constexpr const UINT HASH_BITS = 12u;
+
+        // Token nibbles saturate at 15, the rest of the length follows in bytes of 255
+        constexpr const size_t MAX_NIBBLE = 15u;
+
+        UINT32 read32(_In_reads_bytes_(4) const BYTE* pBytes)
+        {
+            UINT32 uValue;
+            std::memcpy(&uValue, pBytes, sizeof(uValue));
+            return uValue;
+        }
+
+        void appendLength(_In_ size_t uLength, _Inout_ std::vector<BYTE>& aBytes)
+        {
+            while (uLength >= 255u)
+            {
+                aBytes.push_back(255u);
+                uLength -= 255u;
+            }
+            aBytes.push_back(static_cast<BYTE>(uLength));
+        }
+
+        // Reads the rest of a saturated length, FALSE when the data ends first
+        BOOL readLength(_In_reads_bytes_(uSize) const BYTE* pBytes, _In_ size_t uSize, _Inout_ size_t& uOffset, _Inout_ size_t& uLength)
+        {
+            BYTE byte = 255u;
+            while (byte == 255u)
+            {
+                if (uOffset >= uSize)
+                {
+                    return FALSE;
+                }
+                byte = pBytes[uOffset++];
+                uLength += byte;
+            }
+            return TRUE;
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: appendSequence
+
+          Summary:  Appends a token, its literals and, unless it is the
+                    last sequence, the offset and the length of its match
+
+          Args:     const BYTE* pLiterals
+                      First literal
+                    size_t uNumLiterals
+                      Number of literals
+                    size_t uOffset
+                      Distance back to the match, 0 for the last sequence
+                    size_t uMatchLength
+                      Length of the match, at least MIN_MATCH
+                    std::vector<BYTE>& aBytes
+                      Compressed bytes
+
+          Modifies: [aBytes].
+        F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+        void appendSequence(_In_reads_bytes_(uNumLiterals) const BYTE* pLiterals, _In_ size_t uNumLiterals, _In_ size_t uOffset, _In_ size_t uMatchLength, _Inout_ std::vector<BYTE>& aBytes)
+        {
+            size_t uMatchCode = uOffset > 0u ? uMatchLength - MIN_MATCH : 0u;
+            aBytes.push_back(static_cast<BYTE>((std::min(uNumLiterals, MAX_NIBBLE) << 4u) | std::min(uMatchCode, MAX_NIBBLE)));
+            if (uNumLiterals >= MAX_NIBBLE)
+            {
+                appendLength(uNumLiterals - MAX_NIBBLE, aBytes);
+            }
+            aBytes.insert(aBytes.end(), pLiterals, pLiterals + uNumLiterals);
+
+            if (uOffset == 0u)
+            {
+                return;
+            }
+
+            aBytes.push_back(static_cast<BYTE>(uOffset & 0xFFu));
+            aBytes.push_back(static_cast<BYTE>(uOffset >> 8u));
+            if (uMatchCode >= MAX_NIBBLE)
+            {
+                appendLength(uMatchCode - MAX_NIBBLE, aBytes);
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelRegionFile::Compress
+      Summary:  Compresses bytes into sequences of literals followed by
+                a match in the previous 64 KB, found through a hash
+                table of 4-byte sequences. The run counts, run ends and
+                palette indices of a chunk repeat a lot, so a greedy
+                single pass is enough
+      Args:     const BYTE* pBytes
+                  Bytes to compress
+                size_t uSize
+                  Number of bytes
+                std::vector<BYTE>& aOutBytes
+                  Compressed bytes
+      Modifies: [aOutBytes].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelRegionFile::Compress(_In_reads_bytes_(uSize) const BYTE* pBytes, _In_ size_t uSize, _Out_ std::vector<BYTE>& aOutBytes)
+    {
+        aOutBytes.clear();
+        aOutBytes.reserve(uSize / 2u + 16u);
+
+        std::vector<INT> aiLastPositions(static_cast<size_t>(1u) << HASH_BITS, -1);
+        size_t uAnchor = 0u;
+        size_t i = 0u;
+        while (i + MIN_MATCH <= uSize)
+        {
+            UINT32 uSequence = read32(pBytes + i);
+            UINT32 uHash = (uSequence * 2654435761u) >> (32u - HASH_BITS);
+            INT iCandidate = aiLastPositions[uHash];
+            aiLastPositions[uHash] = static_cast<INT>(i);
+
+            if (iCandidate < 0 || i - static_cast<size_t>(iCandidate) > MAX_OFFSET || read32(pBytes + iCandidate) != uSequence)
+            {
+                ++i;
+                continue;
+            }
+
+            size_t uMatchLength = MIN_MATCH;
+            while (i + uMatchLength < uSize && pBytes[iCandidate + uMatchLength] == pBytes[i + uMatchLength])
+            {
+                ++uMatchLength;
+            }
+
+            appendSequence(pBytes + uAnchor, i - uAnchor, i - static_cast<size_t>(iCandidate), uMatchLength, aOutBytes);
+            i += uMatchLength;
+            uAnchor = i;
+        }
+
+        appendSequence(pBytes + uAnchor, uSize - uAnchor, 0u, 0u, aOutBytes);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelRegionFile::Decompress
+      Summary:  Restores bytes written by Compress. Every length and
+                offset is checked, so a damaged chunk fails instead of
+                reading or writing out of bounds
+      Args:     const BYTE* pBytes
+                  Compressed bytes
+                size_t uSize
+                  Number of compressed bytes
+                size_t uRawSize
+                  Number of bytes before the compression
+                std::vector<BYTE>& aOutBytes
+                  Restored bytes
+      Modifies: [aOutBytes].
+      Returns:  BOOL
+                  FALSE when the bytes are not a compressed block of
+                  uRawSize bytes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL VoxelRegionFile::Decompress(_In_reads_bytes_(uSize) const BYTE* pBytes, _In_ size_t uSize, _In_ size_t uRawSize, _Out_ std::vector<BYTE>& aOutBytes)
+    {
+        aOutBytes.resize(uRawSize);
+
+        size_t uIn = 0u;
+        size_t uOut = 0u;
+        while (uIn < uSize)
+        {
+            BYTE token = pBytes[uIn++];
+
+            size_t uNumLiterals = token >> 4u;
+            if (uNumLiterals == MAX_NIBBLE && !readLength(pBytes, uSize, uIn, uNumLiterals))
+            {
+                return FALSE;
+            }
+            if (uSize - uIn < uNumLiterals || uRawSize - uOut < uNumLiterals)
+            {
+                return FALSE;
+            }
+            std::memcpy(aOutBytes.data() + uOut, pBytes + uIn, uNumLiterals);
+            uIn += uNumLiterals;
+            uOut += uNumLiterals;
+
+            // The last sequence has no match
+            if (uIn == uSize)
+            {
+                break;
+            }
+
+            if (uSize - uIn < 2u)
+            {
+                return FALSE;
+            }
+            size_t uOffset = static_cast<size_t>(pBytes[uIn]) | (static_cast<size_t>(pBytes[uIn + 1u]) << 8u);
+            uIn += 2u;
+
+            size_t uMatchLength = token & 0x0Fu;
+            if (uMatchLength == MAX_NIBBLE && !readLength(pBytes, uSize, uIn, uMatchLength))
+            {
+                return FALSE;
+            }
+            uMatchLength += MIN_MATCH;
+            if (uOffset == 0u || uOffset > uOut || uRawSize - uOut < uMatchLength)
+            {
+                return FALSE;
+            }
+
+            // Matches may overlap their own output, so they are copied one byte at a time
+            for (size_t j = 0u; j < uMatchLength; ++j, ++uOut)
+            {
+                aOutBytes[uOut] = aOutBytes[uOut - uOffset];
+            }
+        }
+
+        return uOut == uRawSize;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelRegionFile::VoxelRegionFile
+      Summary:  Constructor
+      Modifies: [m_file, m_uChunkHeight, m_aEntries,
+                 m_abRejectedEntries, m_abUsedSectors,
+                 m_aCompressedBytes, m_aRawBytes].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    VoxelRegionFile::VoxelRegionFile()
+        : m_file()
+        , m_uChunkHeight(0u)
+        , m_aEntries()
+        , m_abRejectedEntries()
+        , m_abUsedSectors()
+        , m_aCompressedBytes()
+        , m_aRawBytes()
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelRegionFile::Open
+      Summary:  Opens a region file and reads its entries, or creates
+                it with no chunk. An entry whose sectors or sizes do
+                not fit the file is rejected, it is cleared and its
+                sectors are never trusted
+      Args:     const std::filesystem::path& filePath
+                  Path to the region file
+                UINT uChunkHeight
+                  Number of blocks of a column of the chunks
+      Modifies: [m_file, m_uChunkHeight, m_aEntries,
+                 m_abRejectedEntries, m_abUsedSectors].
+      Returns:  HRESULT
+                  Status code, E_FAIL when the file can't be opened or
+                  is not a region of chunks of this height
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT VoxelRegionFile::Open(_In_ const std::filesystem::path& filePath, _In_ UINT uChunkHeight)
+    {
+        m_file.close();
+        m_uChunkHeight = uChunkHeight;
+        std::fill(std::begin(m_aEntries), std::end(m_aEntries), VoxelRegionEntry{ .uFirstSector = 0u, .uNumSectors = 0u, .uCompressedSize = 0u, .uRawSize = 0u });
+        std::fill(std::begin(m_abRejectedEntries), std::end(m_abRejectedEntries), FALSE);
+        m_abUsedSectors.assign(FIRST_DATA_SECTOR, TRUE);
+
+        VoxelRegionHeader header =
+        {
+            .uMagic = MAGIC,
+            .uVersion = VERSION,
+            .uRegionSize = static_cast<UINT16>(REGION_SIZE),
+            .uChunkHeight = uChunkHeight,
+            .uReserved = 0u
+        };
+
+        if (!std::filesystem::exists(filePath))
+        {
+            std::ofstream newFile(filePath, std::ios::binary);
+            std::vector<BYTE> aHeaderSectors(static_cast<size_t>(FIRST_DATA_SECTOR) * SECTOR_SIZE, 0u);
+            std::memcpy(aHeaderSectors.data(), &header, sizeof(header));
+            std::memcpy(aHeaderSectors.data() + sizeof(header), m_aEntries, sizeof(m_aEntries));
+            newFile.write(reinterpret_cast<const char*>(aHeaderSectors.data()), static_cast<std::streamsize>(aHeaderSectors.size()));
+            if (!newFile.good())
+            {
+                return E_FAIL;
+            }
+        }
+
+        m_file.open(filePath, std::ios::binary | std::ios::in | std::ios::out);
+        if (!m_file.is_open())
+        {
+            return E_FAIL;
+        }
+
+        VoxelRegionHeader fileHeader;
+        m_file.read(reinterpret_cast<char*>(&fileHeader), sizeof(fileHeader));
+        m_file.read(reinterpret_cast<char*>(m_aEntries), sizeof(m_aEntries));
+        if (!m_file.good() || fileHeader.uMagic != MAGIC || fileHeader.uVersion != VERSION ||
+            fileHeader.uRegionSize != REGION_SIZE || fileHeader.uChunkHeight != uChunkHeight)
+        {
+            m_file.close();
+            return E_FAIL;
+        }
+
+        m_file.seekg(0, std::ios::end);
+        const UINT64 uFileSize = static_cast<UINT64>(m_file.tellg());
+        for (UINT i = 0u; i < NUM_ENTRIES; ++i)
+        {
+            VoxelRegionEntry& entry = m_aEntries[i];
+            if (entry.uNumSectors == 0u)
+            {
+                continue;
+            }
+
+            if (!isEntryValid(entry, uFileSize))
+            {
+                entry = VoxelRegionEntry{ .uFirstSector = 0u, .uNumSectors = 0u, .uCompressedSize = 0u, .uRawSize = 0u };
+                m_abRejectedEntries[i] = TRUE;
+                continue;
+            }
+
+            setSectorsUsed(entry.uFirstSector, entry.uNumSectors, TRUE);
+        }
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelRegionFile::LoadChunk
+      Summary:  Reads, decompresses and deserializes a chunk
+      Args:     UINT uLocalX
+                UINT uLocalZ
+                  Chunk in the region, below REGION_SIZE
+                VoxelChunkStorage& outChunk
+                  Blocks of the chunk, unchanged when it has never been
+                  saved
+      Modifies: [m_file, m_aCompressedBytes, m_aRawBytes, outChunk].
+      Returns:  HRESULT
+                  Status code, S_FALSE when the chunk has never been
+                  saved, E_FAIL when it or its entry is damaged
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT VoxelRegionFile::LoadChunk(_In_ UINT uLocalX, _In_ UINT uLocalZ, _Out_ VoxelChunkStorage& outChunk)
+    {
+        if (uLocalX >= REGION_SIZE || uLocalZ >= REGION_SIZE || !m_file.is_open())
+        {
+            return E_INVALIDARG;
+        }
+
+        if (m_abRejectedEntries[uLocalZ * REGION_SIZE + uLocalX])
+        {
+            return E_FAIL;
+        }
+
+        const VoxelRegionEntry& entry = m_aEntries[uLocalZ * REGION_SIZE + uLocalX];
+        if (entry.uNumSectors == 0u)
+        {
+            return S_FALSE;
+        }
+
+        m_aCompressedBytes.resize(entry.uCompressedSize);
+        m_file.seekg(static_cast<std::streamoff>(entry.uFirstSector) * SECTOR_SIZE);
+        m_file.read(reinterpret_cast<char*>(m_aCompressedBytes.data()), static_cast<std::streamsize>(m_aCompressedBytes.size()));
+        if (!m_file.good() || !Decompress(m_aCompressedBytes.data(), m_aCompressedBytes.size(), entry.uRawSize, m_aRawBytes))
+        {
+            m_file.clear();
+            return E_FAIL;
+        }
+
+        VoxelChunkStorage chunk(m_uChunkHeight);
+        HRESULT hr = chunk.Deserialize(m_aRawBytes.data(), m_aRawBytes.size(), nullptr);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+        if (chunk.GetHeight() != m_uChunkHeight)
+        {
+            return E_FAIL;
+        }
+
+        outChunk = std::move(chunk);
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelRegionFile::SaveChunk
+      Summary:  Compresses a serialized chunk and writes its sectors,
+                then its entry. The entry is written last, so an
+                interrupted save leaves the previous chunk readable
+                unless it was rewritten in place. A rejected entry is
+                replaced
+      Args:     UINT uLocalX
+                UINT uLocalZ
+                  Chunk in the region, below REGION_SIZE
+                const BYTE* pBytes
+                  Chunk written by VoxelChunkStorage::Serialize
+                size_t uSize
+                  Number of bytes
+                size_t* puNumCompressedBytes
+                  Size of the compressed chunk, can be nullptr
+      Modifies: [m_file, m_aEntries, m_abRejectedEntries,
+                 m_abUsedSectors, m_aCompressedBytes].
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT VoxelRegionFile::SaveChunk(_In_ UINT uLocalX, _In_ UINT uLocalZ, _In_reads_bytes_(uSize) const BYTE* pBytes, _In_ size_t uSize, _Out_opt_ size_t* puNumCompressedBytes)
+    {
+        if (uLocalX >= REGION_SIZE || uLocalZ >= REGION_SIZE || !m_file.is_open() || uSize > UINT_MAX)
+        {
+            return E_INVALIDARG;
+        }
+
+        Compress(pBytes, uSize, m_aCompressedBytes);
+        const UINT32 uCompressedSize = static_cast<UINT32>(m_aCompressedBytes.size());
+        UINT uNumSectors = static_cast<UINT>((m_aCompressedBytes.size() + SECTOR_SIZE - 1u) / SECTOR_SIZE);
+
+        VoxelRegionEntry& entry = m_aEntries[uLocalZ * REGION_SIZE + uLocalX];
+        UINT uFirstSector = entry.uFirstSector;
+        if (entry.uNumSectors >= uNumSectors)
+        {
+            setSectorsUsed(entry.uFirstSector + uNumSectors, entry.uNumSectors - uNumSectors, FALSE);
+        }
+        else
+        {
+            setSectorsUsed(entry.uFirstSector, entry.uNumSectors, FALSE);
+            uFirstSector = allocateSectors(uNumSectors);
+        }
+        setSectorsUsed(uFirstSector, uNumSectors, TRUE);
+
+        // The last sector is padded so that the file always ends on a sector
+        m_aCompressedBytes.resize(static_cast<size_t>(uNumSectors) * SECTOR_SIZE, 0u);
+        m_file.seekp(static_cast<std::streamoff>(uFirstSector) * SECTOR_SIZE);
+        m_file.write(reinterpret_cast<const char*>(m_aCompressedBytes.data()), static_cast<std::streamsize>(m_aCompressedBytes.size()));
+
+        entry = VoxelRegionEntry
+        {
+            .uFirstSector = uFirstSector,
+            .uNumSectors = uNumSectors,
+            .uCompressedSize = uCompressedSize,
+            .uRawSize = static_cast<UINT32>(uSize)
+        };
+        m_file.seekp(static_cast<std::streamoff>(sizeof(VoxelRegionHeader) + (static_cast<size_t>(uLocalZ) * REGION_SIZE + uLocalX) * sizeof(VoxelRegionEntry)));
+        m_file.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+        m_file.flush();
+        if (!m_file.good())
+        {
+            m_file.clear();
+            return E_FAIL;
+        }
+
+        m_abRejectedEntries[uLocalZ * REGION_SIZE + uLocalX] = FALSE;
+
+        if (puNumCompressedBytes)
+        {
+            *puNumCompressedBytes = uCompressedSize;
+        }
+
+        return S_OK;
+    }
+
+    BOOL VoxelRegionFile::HasChunk(_In_ UINT uLocalX, _In_ UINT uLocalZ) const
+    {
+        return uLocalX < REGION_SIZE && uLocalZ < REGION_SIZE && m_aEntries[uLocalZ * REGION_SIZE + uLocalX].uNumSectors > 0u;
+    }
+
+    UINT VoxelRegionFile::GetNumSectors() const
+    {
+        return static_cast<UINT>(m_abUsedSectors.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelRegionFile::isEntryValid
+      Summary:  Checks an entry read from disk: its sectors follow the
+                header, lie in the file and are not claimed by an
+                earlier entry, its compressed chunk fits them and its
+                serialized size is at most that of the largest chunk
+      Args:     const VoxelRegionEntry& entry
+                  Entry with sectors
+                UINT64 uFileSize
+                  Size of the file in bytes
+      Returns:  BOOL
+                  TRUE if the chunk of the entry can be read
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL VoxelRegionFile::isEntryValid(_In_ const VoxelRegionEntry& entry, _In_ UINT64 uFileSize) const
+    {
+        const UINT64 uEndSector = static_cast<UINT64>(entry.uFirstSector) + entry.uNumSectors;
+        if (entry.uFirstSector < FIRST_DATA_SECTOR || uEndSector * SECTOR_SIZE > uFileSize)
+        {
+            return FALSE;
+        }
+
+        if (entry.uCompressedSize == 0u || entry.uCompressedSize > static_cast<UINT64>(entry.uNumSectors) * SECTOR_SIZE
+            || entry.uRawSize > VoxelChunkStorage::GetMaxSerializedSize(m_uChunkHeight))
+        {
+            return FALSE;
+        }
+
+        for (UINT64 uSector = entry.uFirstSector; uSector < uEndSector && uSector < m_abUsedSectors.size(); ++uSector)
+        {
+            if (m_abUsedSectors[static_cast<size_t>(uSector)])
+            {
+                return FALSE;
+            }
+        }
+
+        return TRUE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelRegionFile::allocateSectors
+      Summary:  Finds the first free sectors large enough, or the end of
+                the file
+      Args:     UINT uNumSectors
+                  Number of sectors to allocate
+      Returns:  UINT
+                  First sector of the allocation
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT VoxelRegionFile::allocateSectors(_In_ UINT uNumSectors)
+    {
+        UINT uNumFree = 0u;
+        for (UINT uSector = FIRST_DATA_SECTOR; uSector < static_cast<UINT>(m_abUsedSectors.size()); ++uSector)
+        {
+            uNumFree = m_abUsedSectors[uSector] ? 0u : uNumFree + 1u;
+            if (uNumFree == uNumSectors)
+            {
+                return uSector + 1u - uNumSectors;
+            }
+        }
+
+        // Free sectors at the end of the file are extended
+        return static_cast<UINT>(m_abUsedSectors.size()) - uNumFree;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelRegionFile::setSectorsUsed
+      Summary:  Marks sectors as used or free, the map grows with the
+                file
+      Args:     UINT uFirstSector
+                  First sector
+                UINT uNumSectors
+                  Number of sectors
+                BOOL bUsed
+                  Whether the sectors hold a chunk
+      Modifies: [m_abUsedSectors].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelRegionFile::setSectorsUsed(_In_ UINT uFirstSector, _In_ UINT uNumSectors, _In_ BOOL bUsed)
+    {
+        if (bUsed && uFirstSector + uNumSectors > m_abUsedSectors.size())
+        {
+            m_abUsedSectors.resize(static_cast<size_t>(uFirstSector) + uNumSectors, FALSE);
+        }
+
+        for (UINT uSector = uFirstSector; uSector < uFirstSector + uNumSectors && uSector < m_abUsedSectors.size(); ++uSector)
+        {
+            m_abUsedSectors[uSector] = bUsed;
+        }
+    }
+}
\ No newline at end of file
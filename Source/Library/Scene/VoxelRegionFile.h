@@ -0,0 +1,128 @@
+/*+===================================================================
+  File:      VOXELREGIONFILE.H
+
+  Summary:   VoxelRegionFile header file contains declarations of
+             VoxelRegionFile class used to keep REGION_SIZE^2 chunks
+             in one file, each compressed on its own, so that a single
+             chunk is loaded or saved without rewriting the file.
+
+  Classes: VoxelRegionFile
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include <fstream>
+
+#include "Scene/VoxelChunkStorage.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   VoxelRegionHeader
+
+        Summary:  Header of a region file. It is followed by the
+                  REGION_SIZE^2 entries of the chunks, z * REGION_SIZE
+                  + x, then by the sectors of the chunks
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct VoxelRegionHeader
+    {
+        UINT32 uMagic;
+        UINT16 uVersion;
+        UINT16 uRegionSize;
+        UINT32 uChunkHeight;
+        UINT32 uReserved;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   VoxelRegionEntry
+
+        Summary:  Place of a compressed chunk in the region file, in
+                  sectors, and its compressed and serialized sizes. A
+                  chunk without sectors has never been saved
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct VoxelRegionEntry
+    {
+        UINT32 uFirstSector;
+        UINT32 uNumSectors;
+        UINT32 uCompressedSize;
+        UINT32 uRawSize;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    VoxelRegionFile
+
+      Summary:  File of REGION_SIZE x REGION_SIZE chunks. Every chunk
+                is serialized by VoxelChunkStorage, compressed with a
+                byte-oriented LZ77 and stored in whole SECTOR_SIZE
+                sectors. A chunk that still fits its sectors is
+                rewritten in place, otherwise it moves to the first
+                free sectors large enough. Only the sectors of the
+                chunk and its entry are written. Entries read from
+                disk are checked against the file when it is opened,
+                and the chunks of damaged ones fail to load until they
+                are saved again. Not thread safe
+
+      Methods:  Compress
+                  Compresses bytes
+                Decompress
+                  Restores bytes written by Compress
+                Open
+                  Opens or creates a region file
+                LoadChunk
+                  Reads a chunk
+                SaveChunk
+                  Writes a chunk
+                HasChunk
+                  Returns whether a chunk has been saved
+                GetNumSectors
+                  Returns the size of the file in sectors
+                VoxelRegionFile
+                  Constructor.
+                ~VoxelRegionFile
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class VoxelRegionFile
+    {
+    public:
+        static constexpr const UINT32 MAGIC = 0x4E475256u; // "VRGN"
+        static constexpr const UINT16 VERSION = 1u;
+        static constexpr const UINT REGION_SIZE = 16u;
+        static constexpr const UINT SECTOR_SIZE = 4096u;
+
+        static void Compress(_In_reads_bytes_(uSize) const BYTE* pBytes, _In_ size_t uSize, _Out_ std::vector<BYTE>& aOutBytes);
+        static BOOL Decompress(_In_reads_bytes_(uSize) const BYTE* pBytes, _In_ size_t uSize, _In_ size_t uRawSize, _Out_ std::vector<BYTE>& aOutBytes);
+
+        VoxelRegionFile();
+        VoxelRegionFile(const VoxelRegionFile& other) = delete;
+        VoxelRegionFile(VoxelRegionFile&& other) = delete;
+        VoxelRegionFile& operator=(const VoxelRegionFile& other) = delete;
+        VoxelRegionFile& operator=(VoxelRegionFile&& other) = delete;
+        ~VoxelRegionFile() = default;
+
+        HRESULT Open(_In_ const std::filesystem::path& filePath, _In_ UINT uChunkHeight);
+        HRESULT LoadChunk(_In_ UINT uLocalX, _In_ UINT uLocalZ, _Out_ VoxelChunkStorage& outChunk);
+        HRESULT SaveChunk(_In_ UINT uLocalX, _In_ UINT uLocalZ, _In_reads_bytes_(uSize) const BYTE* pBytes, _In_ size_t uSize, _Out_opt_ size_t* puNumCompressedBytes);
+        BOOL HasChunk(_In_ UINT uLocalX, _In_ UINT uLocalZ) const;
+        UINT GetNumSectors() const;
+
+    private:
+        static constexpr const UINT NUM_ENTRIES = REGION_SIZE * REGION_SIZE;
+        static constexpr const UINT FIRST_DATA_SECTOR = static_cast<UINT>((sizeof(VoxelRegionHeader) + NUM_ENTRIES * sizeof(VoxelRegionEntry) + SECTOR_SIZE - 1u) / SECTOR_SIZE);
+
+        BOOL isEntryValid(_In_ const VoxelRegionEntry& entry, _In_ UINT64 uFileSize) const;
+        UINT allocateSectors(_In_ UINT uNumSectors);
+        void setSectorsUsed(_In_ UINT uFirstSector, _In_ UINT uNumSectors, _In_ BOOL bUsed);
+
+    private:
+        std::fstream m_file;
+        UINT m_uChunkHeight;
+        VoxelRegionEntry m_aEntries[NUM_ENTRIES];
+        BOOL m_abRejectedEntries[NUM_ENTRIES];
+        std::vector<BOOL> m_abUsedSectors;
+        std::vector<BYTE> m_aCompressedBytes;
+        std::vector<BYTE> m_aRawBytes;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,491 @@
+#include "Scene/VoxelRegionStore.h"
+
+#include <algorithm>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelRegionStore::VoxelRegionStore
+      Summary:  Constructor
+      Args:     const std::filesystem::path& directoryPath
+                  Directory of the region files
+                UINT uChunkHeight
+                  Number of blocks of a column of the chunks
+                UINT64 uMaxBytesPerFrame
+                  Serialized bytes QueueDirtyChunks hands to the writer
+                  per frame, at least one chunk is handed
+      Modifies: [m_directoryPath, m_uChunkHeight, m_uMaxBytesPerFrame,
+                 m_aDirtyKeys, m_dirtyKeys, m_regionFiles,
+                 m_pendingChunks, m_uNumWritingChunks, m_writeResult,
+                 m_stats, m_bStopping, m_writer].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    VoxelRegionStore::VoxelRegionStore(_In_ const std::filesystem::path& directoryPath, _In_ UINT uChunkHeight, _In_ UINT64 uMaxBytesPerFrame)
+        : m_directoryPath(directoryPath)
+        , m_uChunkHeight(uChunkHeight)
+        , m_uMaxBytesPerFrame(uMaxBytesPerFrame)
+        , m_aDirtyKeys()
+        , m_dirtyKeys()
+        , m_fileMutex()
+        , m_regionFiles()
+        , m_mutex()
+        , m_workAvailable()
+        , m_workDone()
+        , m_pendingChunks()
+        , m_uNumWritingChunks(0u)
+        , m_writeResult(S_OK)
+        , m_stats()
+        , m_bStopping(FALSE)
+        , m_writer()
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelRegionStore::~VoxelRegionStore
+      Summary:  Destructor. Stops the writer once the queued chunks are
+                written, the chunks still dirty are not saved
+      Modifies: [m_bStopping, m_writer].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    VoxelRegionStore::~VoxelRegionStore()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_bStopping = TRUE;
+        }
+        m_workAvailable.notify_all();
+
+        if (m_writer.joinable())
+        {
+            m_writer.join();
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelRegionStore::Initialize
+      Summary:  Creates the directory of the region files and starts
+                the writer thread
+      Modifies: [m_writer].
+      Returns:  HRESULT
+                  Status code, E_FAIL when the directory can't be
+                  created
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT VoxelRegionStore::Initialize()
+    {
+        if (m_writer.joinable())
+        {
+            return S_OK;
+        }
+
+        std::error_code error;
+        std::filesystem::create_directories(m_directoryPath, error);
+        if (error || !std::filesystem::is_directory(m_directoryPath))
+        {
+            return E_FAIL;
+        }
+
+        m_writer = std::thread(&VoxelRegionStore::runWriter, this);
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelRegionStore::LoadChunk
+      Summary:  Reads a chunk from its region file
+      Args:     UINT uChunkX
+                UINT uChunkZ
+                  Coordinates of the chunk
+                VoxelChunkStorage& outChunk
+                  Blocks of the chunk, unchanged when it has never been
+                  saved
+      Modifies: [m_regionFiles, m_stats, outChunk].
+      Returns:  HRESULT
+                  Status code, S_FALSE when the chunk has never been
+                  saved
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT VoxelRegionStore::LoadChunk(_In_ UINT uChunkX, _In_ UINT uChunkZ, _Out_ VoxelChunkStorage& outChunk)
+    {
+        HRESULT hr = S_FALSE;
+        {
+            std::lock_guard<std::mutex> lock(m_fileMutex);
+
+            // Loading never creates a region file
+            std::filesystem::path filePath = getRegionFilePath(uChunkX / REGION_SIZE, uChunkZ / REGION_SIZE);
+            if (!m_regionFiles.contains(makeKey(uChunkX / REGION_SIZE, uChunkZ / REGION_SIZE)) && !std::filesystem::exists(filePath))
+            {
+                return S_FALSE;
+            }
+
+            VoxelRegionFile* pRegionFile = nullptr;
+            hr = getRegionFile(uChunkX, uChunkZ, pRegionFile);
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+
+            hr = pRegionFile->LoadChunk(uChunkX % REGION_SIZE, uChunkZ % REGION_SIZE, outChunk);
+        }
+
+        if (hr == S_OK)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ++m_stats.uNumChunksLoaded;
+        }
+
+        return hr;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelRegionStore::SaveChunk
+      Summary:  Writes a chunk to its region file on the calling thread
+      Args:     UINT uChunkX
+                UINT uChunkZ
+                  Coordinates of the chunk
+                const VoxelChunkStorage& chunk
+                  Blocks of the chunk
+      Modifies: [m_regionFiles, m_stats].
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT VoxelRegionStore::SaveChunk(_In_ UINT uChunkX, _In_ UINT uChunkZ, _In_ const VoxelChunkStorage& chunk)
+    {
+        std::vector<BYTE> aBytes;
+        chunk.Serialize(aBytes);
+
+        return saveChunkBytes(uChunkX, uChunkZ, aBytes);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelRegionStore::LoadGrid
+      Summary:  Replaces every chunk of the grid that has been saved
+      Args:     VoxelGrid& grid
+                  Grid whose chunks are replaced
+                UINT* puNumLoaded
+                  Number of chunks loaded, can be nullptr
+      Modifies: [m_regionFiles, m_stats, grid].
+      Returns:  HRESULT
+                  Status code, the chunks loaded before a failure are
+                  kept
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT VoxelRegionStore::LoadGrid(_Inout_ VoxelGrid& grid, _Out_opt_ UINT* puNumLoaded)
+    {
+        UINT uNumLoaded = 0u;
+        HRESULT hr = S_OK;
+        for (UINT uChunkZ = 0u; uChunkZ < grid.GetNumChunksZ() && SUCCEEDED(hr); ++uChunkZ)
+        {
+            for (UINT uChunkX = 0u; uChunkX < grid.GetNumChunksX() && SUCCEEDED(hr); ++uChunkX)
+            {
+                VoxelChunkStorage chunk(m_uChunkHeight);
+                hr = LoadChunk(uChunkX, uChunkZ, chunk);
+                if (hr == S_OK)
+                {
+                    hr = grid.SetChunk(uChunkX, uChunkZ, std::move(chunk));
+                    uNumLoaded += SUCCEEDED(hr) ? 1u : 0u;
+                }
+            }
+        }
+
+        if (puNumLoaded)
+        {
+            *puNumLoaded = uNumLoaded;
+        }
+
+        return FAILED(hr) ? hr : S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelRegionStore::SaveGrid
+      Summary:  Writes every chunk of the grid on the calling thread
+      Args:     const VoxelGrid& grid
+                  Grid to save
+      Modifies: [m_regionFiles, m_stats].
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT VoxelRegionStore::SaveGrid(_In_ const VoxelGrid& grid)
+    {
+        std::vector<BYTE> aBytes;
+        for (UINT uChunkZ = 0u; uChunkZ < grid.GetNumChunksZ(); ++uChunkZ)
+        {
+            for (UINT uChunkX = 0u; uChunkX < grid.GetNumChunksX(); ++uChunkX)
+            {
+                aBytes.clear();
+                grid.SerializeChunk(uChunkX, uChunkZ, aBytes);
+
+                HRESULT hr = saveChunkBytes(uChunkX, uChunkZ, aBytes);
+                if (FAILED(hr))
+                {
+                    return hr;
+                }
+            }
+        }
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelRegionStore::MarkDirty
+      Summary:  Marks a chunk to be saved by a later QueueDirtyChunks,
+                the chunks are queued in the order of their first edit
+      Args:     UINT uChunkX
+                UINT uChunkZ
+                  Coordinates of the chunk
+      Modifies: [m_aDirtyKeys, m_dirtyKeys].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelRegionStore::MarkDirty(_In_ UINT uChunkX, _In_ UINT uChunkZ)
+    {
+        UINT64 uKey = makeKey(uChunkX, uChunkZ);
+        if (m_dirtyKeys.insert(uKey).second)
+        {
+            m_aDirtyKeys.push_back(uKey);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelRegionStore::QueueDirtyChunks
+      Summary:  Serializes the oldest dirty chunks until the next one
+                would exceed the bytes of a frame, and hands the copies
+                to the writer. The size of a chunk is known before it
+                is serialized, so the chunk left for the next frame is
+                not serialized this one. Called once per frame, so the
+                writer never has more than the budget of a frame to
+                write per frame on average
+      Args:     const VoxelGrid& grid
+                  Grid of the dirty chunks
+      Modifies: [m_aDirtyKeys, m_dirtyKeys, m_pendingChunks, m_stats].
+      Returns:  UINT
+                  Number of chunks handed to the writer
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT VoxelRegionStore::QueueDirtyChunks(_In_ const VoxelGrid& grid)
+    {
+        std::vector<PendingChunk> aChunks;
+        UINT64 uNumBytes = 0u;
+        size_t uNumTaken = 0u;
+        for (; uNumTaken < m_aDirtyKeys.size(); ++uNumTaken)
+        {
+            PendingChunk chunk =
+            {
+                .uChunkX = static_cast<UINT>(m_aDirtyKeys[uNumTaken] >> 32u),
+                .uChunkZ = static_cast<UINT>(m_aDirtyKeys[uNumTaken] & 0xFFFFFFFFu),
+                .aBytes = std::vector<BYTE>()
+            };
+            const size_t uSize = grid.GetChunk(chunk.uChunkX, chunk.uChunkZ).GetSerializedSize();
+            if (!aChunks.empty() && uNumBytes + uSize > m_uMaxBytesPerFrame)
+            {
+                break;
+            }
+
+            chunk.aBytes.reserve(uSize);
+            grid.SerializeChunk(chunk.uChunkX, chunk.uChunkZ, chunk.aBytes);
+            uNumBytes += chunk.aBytes.size();
+            m_dirtyKeys.erase(m_aDirtyKeys[uNumTaken]);
+            aChunks.push_back(std::move(chunk));
+        }
+        m_aDirtyKeys.erase(m_aDirtyKeys.begin(), m_aDirtyKeys.begin() + static_cast<std::ptrdiff_t>(uNumTaken));
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (PendingChunk& chunk : aChunks)
+            {
+                m_pendingChunks.push_back(std::move(chunk));
+            }
+            m_stats.uNumBytesQueuedLastFrame = uNumBytes;
+        }
+        if (!aChunks.empty())
+        {
+            m_workAvailable.notify_one();
+        }
+
+        return static_cast<UINT>(aChunks.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelRegionStore::Flush
+      Summary:  Queues every dirty chunk, whatever the budget, and waits
+                until the writer has written them
+      Args:     const VoxelGrid& grid
+                  Grid of the dirty chunks
+      Modifies: [m_aDirtyKeys, m_dirtyKeys, m_pendingChunks,
+                 m_writeResult, m_stats].
+      Returns:  HRESULT
+                  Status code of the writes since the last flush
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT VoxelRegionStore::Flush(_In_ const VoxelGrid& grid)
+    {
+        while (!m_aDirtyKeys.empty())
+        {
+            QueueDirtyChunks(grid);
+        }
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (!m_writer.joinable())
+        {
+            return E_FAIL;
+        }
+        m_workDone.wait(lock, [this]() { return m_pendingChunks.empty() && m_uNumWritingChunks == 0u; });
+
+        HRESULT hr = m_writeResult;
+        m_writeResult = S_OK;
+
+        return hr;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelRegionStore::GetStats
+      Summary:  Returns the loads and saves so far
+      Returns:  VoxelRegionStats
+                  Loads, saves, dirty and pending chunks
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    VoxelRegionStats VoxelRegionStore::GetStats()
+    {
+        VoxelRegionStats stats;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            stats = m_stats;
+            stats.uNumPendingChunks = static_cast<UINT>(m_pendingChunks.size()) + m_uNumWritingChunks;
+        }
+        stats.uNumDirtyChunks = static_cast<UINT>(m_aDirtyKeys.size());
+        {
+            std::lock_guard<std::mutex> lock(m_fileMutex);
+            stats.uNumRegionFiles = static_cast<UINT>(m_regionFiles.size());
+        }
+
+        return stats;
+    }
+
+    UINT64 VoxelRegionStore::makeKey(_In_ UINT uX, _In_ UINT uZ)
+    {
+        return (static_cast<UINT64>(uX) << 32u) | uZ;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelRegionStore::runWriter
+      Summary:  Writes the queued chunks in order until the store is
+                destroyed and the queue is empty
+      Modifies: [m_pendingChunks, m_uNumWritingChunks, m_writeResult,
+                 m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelRegionStore::runWriter()
+    {
+        for (;;)
+        {
+            PendingChunk chunk;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_workAvailable.wait(lock, [this]() { return m_bStopping || !m_pendingChunks.empty(); });
+                if (m_pendingChunks.empty())
+                {
+                    return;
+                }
+
+                chunk = std::move(m_pendingChunks.front());
+                m_pendingChunks.pop_front();
+                ++m_uNumWritingChunks;
+            }
+
+            HRESULT hr = saveChunkBytes(chunk.uChunkX, chunk.uChunkZ, chunk.aBytes);
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                --m_uNumWritingChunks;
+                if (FAILED(hr))
+                {
+                    m_writeResult = hr;
+                }
+            }
+            m_workDone.notify_all();
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelRegionStore::getRegionFilePath
+      Summary:  Returns the path of the region file of a region
+      Args:     UINT uRegionX
+                UINT uRegionZ
+                  Coordinates of the region
+      Returns:  std::filesystem::path
+                  r.<x>.<z>.vxr in the directory of the store
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    std::filesystem::path VoxelRegionStore::getRegionFilePath(_In_ UINT uRegionX, _In_ UINT uRegionZ) const
+    {
+        WCHAR szFileName[64];
+        swprintf_s(szFileName, L"r.%u.%u.vxr", uRegionX, uRegionZ);
+
+        return m_directoryPath / szFileName;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelRegionStore::getRegionFile
+      Summary:  Returns the open region file of a chunk, the file is
+                opened, or created, on first use. The file mutex must
+                be held
+      Args:     UINT uChunkX
+                UINT uChunkZ
+                  Coordinates of the chunk
+                VoxelRegionFile*& pOutRegionFile
+                  Region file of the chunk
+      Modifies: [m_regionFiles, pOutRegionFile].
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT VoxelRegionStore::getRegionFile(_In_ UINT uChunkX, _In_ UINT uChunkZ, _Out_ VoxelRegionFile*& pOutRegionFile)
+    {
+        pOutRegionFile = nullptr;
+
+        UINT64 uKey = makeKey(uChunkX / REGION_SIZE, uChunkZ / REGION_SIZE);
+        auto it = m_regionFiles.find(uKey);
+        if (it == m_regionFiles.end())
+        {
+            std::unique_ptr<VoxelRegionFile> regionFile = std::make_unique<VoxelRegionFile>();
+            HRESULT hr = regionFile->Open(getRegionFilePath(uChunkX / REGION_SIZE, uChunkZ / REGION_SIZE), m_uChunkHeight);
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+            it = m_regionFiles.emplace(uKey, std::move(regionFile)).first;
+        }
+
+        pOutRegionFile = it->second.get();
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelRegionStore::saveChunkBytes
+      Summary:  Writes a serialized chunk to its region file, on the
+                calling thread or on the writer
+      Args:     UINT uChunkX
+                UINT uChunkZ
+                  Coordinates of the chunk
+                const std::vector<BYTE>& aBytes
+                  Chunk written by VoxelChunkStorage::Serialize
+      Modifies: [m_regionFiles, m_stats].
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT VoxelRegionStore::saveChunkBytes(_In_ UINT uChunkX, _In_ UINT uChunkZ, _In_ const std::vector<BYTE>& aBytes)
+    {
+        size_t uNumCompressedBytes = 0u;
+        {
+            std::lock_guard<std::mutex> lock(m_fileMutex);
+
+            VoxelRegionFile* pRegionFile = nullptr;
+            HRESULT hr = getRegionFile(uChunkX, uChunkZ, pRegionFile);
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+
+            hr = pRegionFile->SaveChunk(uChunkX % REGION_SIZE, uChunkZ % REGION_SIZE, aBytes.data(), aBytes.size(), &uNumCompressedBytes);
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_stats.uNumChunksSaved;
+        m_stats.uNumRawBytesSaved += aBytes.size();
+        m_stats.uNumCompressedBytesSaved += uNumCompressedBytes;
+
+        return S_OK;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,150 @@
+/*+===================================================================
+  File:      VOXELREGIONSTORE.H
+
+  Summary:   VoxelRegionStore header file contains declarations of
+             VoxelRegionStore class used to persist the chunks of a
+             voxel grid in region files, saving the edited chunks on a
+             background thread.
+
+  Classes: VoxelRegionStore
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "Scene/VoxelGrid.h"
+#include "Scene/VoxelRegionFile.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   VoxelRegionStats
+
+        Summary:  Chunks and bytes loaded and saved since the store was
+                  created. Raw bytes are serialized chunks, compressed
+                  bytes are what the region files hold. Queued bytes
+                  are the raw bytes handed to the writer by the last
+                  QueueDirtyChunks
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct VoxelRegionStats
+    {
+        UINT64 uNumChunksLoaded;
+        UINT64 uNumChunksSaved;
+        UINT64 uNumRawBytesSaved;
+        UINT64 uNumCompressedBytesSaved;
+        UINT64 uNumBytesQueuedLastFrame;
+        UINT uNumDirtyChunks;
+        UINT uNumPendingChunks;
+        UINT uNumRegionFiles;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    VoxelRegionStore
+
+      Summary:  Directory of region files, one per REGION_SIZE^2
+                chunks, opened on first use. Loads and full saves run
+                on the calling thread. Edited chunks are marked dirty
+                and QueueDirtyChunks, called once per frame, serializes
+                them until the bytes of the frame reach the budget and
+                hands the copies to a writer thread, which compresses
+                and writes them. The grid can keep changing while the
+                copies are written
+
+      Methods:  Initialize
+                  Creates the directory and starts the writer
+                LoadChunk
+                  Reads a chunk
+                SaveChunk
+                  Writes a chunk
+                LoadGrid
+                  Replaces the chunks of a grid by the saved ones
+                SaveGrid
+                  Writes every chunk of a grid
+                MarkDirty
+                  Marks the chunk of an edited block
+                QueueDirtyChunks
+                  Hands the dirty chunks of a frame to the writer
+                Flush
+                  Queues every dirty chunk and waits for the writer
+                GetStats
+                  Returns the loads and saves so far
+                VoxelRegionStore
+                  Constructor.
+                ~VoxelRegionStore
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class VoxelRegionStore
+    {
+    public:
+        static constexpr const UINT CHUNK_SIZE = VoxelGrid::CHUNK_SIZE;
+        static constexpr const UINT REGION_SIZE = VoxelRegionFile::REGION_SIZE;
+
+        VoxelRegionStore() = delete;
+        VoxelRegionStore(_In_ const std::filesystem::path& directoryPath, _In_ UINT uChunkHeight, _In_ UINT64 uMaxBytesPerFrame);
+        VoxelRegionStore(const VoxelRegionStore& other) = delete;
+        VoxelRegionStore(VoxelRegionStore&& other) = delete;
+        VoxelRegionStore& operator=(const VoxelRegionStore& other) = delete;
+        VoxelRegionStore& operator=(VoxelRegionStore&& other) = delete;
+        ~VoxelRegionStore();
+
+        HRESULT Initialize();
+
+        HRESULT LoadChunk(_In_ UINT uChunkX, _In_ UINT uChunkZ, _Out_ VoxelChunkStorage& outChunk);
+        HRESULT SaveChunk(_In_ UINT uChunkX, _In_ UINT uChunkZ, _In_ const VoxelChunkStorage& chunk);
+        HRESULT LoadGrid(_Inout_ VoxelGrid& grid, _Out_opt_ UINT* puNumLoaded);
+        HRESULT SaveGrid(_In_ const VoxelGrid& grid);
+
+        void MarkDirty(_In_ UINT uChunkX, _In_ UINT uChunkZ);
+        UINT QueueDirtyChunks(_In_ const VoxelGrid& grid);
+        HRESULT Flush(_In_ const VoxelGrid& grid);
+
+        VoxelRegionStats GetStats();
+
+    private:
+        /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+            Struct:   PendingChunk
+
+            Summary:  Copy of a dirty chunk waiting for the writer
+        S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+        struct PendingChunk
+        {
+            UINT uChunkX;
+            UINT uChunkZ;
+            std::vector<BYTE> aBytes;
+        };
+
+        static UINT64 makeKey(_In_ UINT uX, _In_ UINT uZ);
+
+        void runWriter();
+        std::filesystem::path getRegionFilePath(_In_ UINT uRegionX, _In_ UINT uRegionZ) const;
+        HRESULT getRegionFile(_In_ UINT uChunkX, _In_ UINT uChunkZ, _Out_ VoxelRegionFile*& pOutRegionFile);
+        HRESULT saveChunkBytes(_In_ UINT uChunkX, _In_ UINT uChunkZ, _In_ const std::vector<BYTE>& aBytes);
+
+    private:
+        std::filesystem::path m_directoryPath;
+        UINT m_uChunkHeight;
+        UINT64 m_uMaxBytesPerFrame;
+        std::vector<UINT64> m_aDirtyKeys;
+        std::unordered_set<UINT64> m_dirtyKeys;
+
+        std::mutex m_fileMutex;
+        std::unordered_map<UINT64, std::unique_ptr<VoxelRegionFile>> m_regionFiles;
+
+        std::mutex m_mutex;
+        std::condition_variable m_workAvailable;
+        std::condition_variable m_workDone;
+        std::deque<PendingChunk> m_pendingChunks;
+        UINT m_uNumWritingChunks;
+        HRESULT m_writeResult;
+        VoxelRegionStats m_stats;
+        BOOL m_bStopping;
+        std::thread m_writer;
+    };
+}
\ No newline at end of file
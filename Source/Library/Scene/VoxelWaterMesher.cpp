@@ -0,0 +1,269 @@
+#include "Scene/VoxelWaterMesher.h"
+
+#include <algorithm>
+
+namespace library
+{
+    namespace
+    {
+        constexpr const UINT MAX_SECTION_VERTICES = 65536u;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelWaterMesher::IsWater
+      Summary:  Returns whether the block type is drawn as water
+      Args:     CHAR blockType
+                  Block type of a cell
+      Returns:  BOOL
+                  TRUE for the water block type
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    BOOL VoxelWaterMesher::IsWater(_In_ CHAR blockType)
+    {
+        return blockType == WATER_BLOCK_TYPE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelWaterMesher::VoxelWaterMesher
+      Summary:  Constructor
+      Args:     const HeightMap& heightMap
+                  Height map of the water cells, must outlive the
+                  mesher
+                const XMFLOAT3& origin
+                  World position of the minimum corner of the block
+                  (0, 0, 0)
+      Modifies: [m_heightMap, m_origin].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    VoxelWaterMesher::VoxelWaterMesher(_In_ const HeightMap& heightMap, _In_ const XMFLOAT3& origin)
+        : m_heightMap(heightMap)
+        , m_origin(origin)
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelWaterMesher::Mesh
+      Summary:  Builds the water surface in world space and counts the
+                water blocks it replaces, for every block, for the
+                exposed blocks and for the columns
+      Args:     VoxelChunkMesh& outMesh
+                  Upward quads of the water surface
+                VoxelWaterStats& outStats
+                  Water cells, regions and quads, and the replaced
+                  instances
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelWaterMesher::Mesh(_Out_ VoxelChunkMesh& outMesh, _Out_ VoxelWaterStats& outStats) const
+    {
+        outMesh = VoxelChunkMesh
+        {
+            .uChunkX = 0u,
+            .uChunkY = 0u,
+            .uChunkZ = 0u,
+            .uNumBlocks = 0u
+        };
+        outStats = VoxelWaterStats{};
+
+        const UINT uWidth = m_heightMap.GetWidth();
+        const UINT uDepth = m_heightMap.GetDepth();
+        for (UINT z = 0u; z < uDepth; ++z)
+        {
+            for (UINT x = 0u; x < uWidth; ++x)
+            {
+                if (!IsWater(m_heightMap.GetBlockType(x, z)))
+                {
+                    continue;
+                }
+
+                UINT uColumnHeight = m_heightMap.GetColumnHeight(x, z);
+                ++outStats.uNumCells;
+                outStats.uNumBlocks += uColumnHeight;
+                outStats.uNumExposedBlocks += uColumnHeight - m_heightMap.GetExposedHeight(x, z);
+                outStats.uNumColumns += uColumnHeight > 0u ? 1u : 0u;
+            }
+        }
+        outMesh.uNumBlocks = outStats.uNumBlocks;
+
+        if (outStats.uNumCells == 0u)
+        {
+            return;
+        }
+
+        std::vector<UINT> auLevels;
+        outStats.uNumRegions = findRegionLevels(auLevels);
+
+        // Cells of a row or of a column next to each other are in the same region, so a rectangle only checks that its cells are water
+        for (UINT z = 0u; z < uDepth; ++z)
+        {
+            for (UINT x = 0u; x < uWidth; )
+            {
+                UINT uLevel = auLevels[static_cast<size_t>(z) * uWidth + x];
+                if (uLevel == 0u)
+                {
+                    ++x;
+                    continue;
+                }
+
+                UINT uNumX = 1u;
+                while (x + uNumX < uWidth && auLevels[static_cast<size_t>(z) * uWidth + x + uNumX] == uLevel)
+                {
+                    ++uNumX;
+                }
+
+                UINT uNumZ = 1u;
+                while (z + uNumZ < uDepth)
+                {
+                    const UINT* pRow = &auLevels[static_cast<size_t>(z + uNumZ) * uWidth + x];
+                    if (std::any_of(pRow, pRow + uNumX, [uLevel](UINT uOther) { return uOther != uLevel; }))
+                    {
+                        break;
+                    }
+                    ++uNumZ;
+                }
+
+                for (UINT uRow = 0u; uRow < uNumZ; ++uRow)
+                {
+                    std::fill_n(&auLevels[static_cast<size_t>(z + uRow) * uWidth + x], uNumX, 0u);
+                }
+
+                addQuad(x, z, uNumX, uNumZ, uLevel, outMesh);
+                ++outStats.uNumQuads;
+
+                x += uNumX;
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelWaterMesher::findRegionLevels
+      Summary:  Flood fills the 4-connected regions of water cells and
+                gives every cell of a region the height of its highest
+                column, so the surface of a region is flat
+      Args:     std::vector<UINT>& auLevels
+                  Water level of every cell in blocks, 0 for the cells
+                  that are not water and the regions without blocks
+      Returns:  UINT
+                  Number of regions
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT VoxelWaterMesher::findRegionLevels(_Out_ std::vector<UINT>& auLevels) const
+    {
+        const UINT uWidth = m_heightMap.GetWidth();
+        const UINT uDepth = m_heightMap.GetDepth();
+        auLevels.assign(static_cast<size_t>(uWidth) * uDepth, 0u);
+
+        std::vector<BOOL> abVisited(auLevels.size(), FALSE);
+        std::vector<UINT> auStack;
+        std::vector<UINT> auRegion;
+        UINT uNumRegions = 0u;
+        for (UINT uSeed = 0u; uSeed < auLevels.size(); ++uSeed)
+        {
+            if (abVisited[uSeed] || !IsWater(m_heightMap.GetBlockType(uSeed % uWidth, uSeed / uWidth)))
+            {
+                continue;
+            }
+
+            UINT uLevel = 0u;
+            auRegion.clear();
+            auStack.push_back(uSeed);
+            abVisited[uSeed] = TRUE;
+            while (!auStack.empty())
+            {
+                UINT uCell = auStack.back();
+                auStack.pop_back();
+                auRegion.push_back(uCell);
+
+                UINT x = uCell % uWidth;
+                UINT z = uCell / uWidth;
+                uLevel = std::max(uLevel, m_heightMap.GetColumnHeight(x, z));
+
+                const UINT auNeighbors[4] = { uCell - 1u, uCell + 1u, uCell - uWidth, uCell + uWidth };
+                const BOOL abInside[4] = { x > 0u, x + 1u < uWidth, z > 0u, z + 1u < uDepth };
+                for (UINT i = 0u; i < 4u; ++i)
+                {
+                    UINT uNeighbor = auNeighbors[i];
+                    if (abInside[i] && !abVisited[uNeighbor] && IsWater(m_heightMap.GetBlockType(uNeighbor % uWidth, uNeighbor / uWidth)))
+                    {
+                        abVisited[uNeighbor] = TRUE;
+                        auStack.push_back(uNeighbor);
+                    }
+                }
+            }
+
+            for (UINT uCell : auRegion)
+            {
+                auLevels[uCell] = uLevel;
+            }
+            ++uNumRegions;
+        }
+
+        return uNumRegions;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelWaterMesher::addQuad
+      Summary:  Appends an upward quad over a rectangle of cells to the
+                mesh, starting a new section when 16-bit indices would
+                overflow. The corners wind like the upward faces of
+                VoxelChunkMesher
+      Args:     UINT uFirstX
+                UINT uFirstZ
+                  First cell of the rectangle
+                UINT uNumX
+                UINT uNumZ
+                  Size of the rectangle in cells
+                UINT uLevel
+                  Water level in blocks
+                VoxelChunkMesh& mesh
+                  Mesh to append to
+      Modifies: [mesh].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelWaterMesher::addQuad(_In_ UINT uFirstX, _In_ UINT uFirstZ, _In_ UINT uNumX, _In_ UINT uNumZ, _In_ UINT uLevel, _Inout_ VoxelChunkMesh& mesh) const
+    {
+        if (mesh.aSections.empty() || mesh.aVertices.size() + 4u - mesh.aSections.back().uBaseVertex > MAX_SECTION_VERTICES)
+        {
+            mesh.aSections.push_back(
+                VoxelMeshSection
+                {
+                    .uBaseVertex = static_cast<UINT>(mesh.aVertices.size()),
+                    .uBaseIndex = static_cast<UINT>(mesh.aIndices.size()),
+                    .uNumIndices = 0u
+                }
+            );
+        }
+
+        VoxelMeshSection& section = mesh.aSections.back();
+        WORD uFirstIndex = static_cast<WORD>(mesh.aVertices.size() - section.uBaseVertex);
+
+        const UINT aOffsetsX[4] = { 0u, 0u, uNumX, uNumX };
+        const UINT aOffsetsZ[4] = { 0u, uNumZ, uNumZ, 0u };
+        const XMFLOAT2 aTexCoords[4] =
+        {
+            XMFLOAT2(0.0f, 0.0f),
+            XMFLOAT2(static_cast<FLOAT>(uNumZ), 0.0f),
+            XMFLOAT2(static_cast<FLOAT>(uNumZ), static_cast<FLOAT>(uNumX)),
+            XMFLOAT2(0.0f, static_cast<FLOAT>(uNumX)),
+        };
+
+        for (UINT uCorner = 0u; uCorner < 4u; ++uCorner)
+        {
+            mesh.aVertices.push_back(
+                SimpleVertex
+                {
+                    .Position = XMFLOAT3(
+                        m_origin.x + 2.0f * static_cast<FLOAT>(uFirstX + aOffsetsX[uCorner]),
+                        m_origin.y + 2.0f * static_cast<FLOAT>(uLevel),
+                        m_origin.z + 2.0f * static_cast<FLOAT>(uFirstZ + aOffsetsZ[uCorner])
+                    ),
+                    .TexCoord = aTexCoords[uCorner],
+                    .Normal = XMFLOAT3(0.0f, 1.0f, 0.0f)
+                }
+            );
+            mesh.aBlockTypes.push_back(WATER_BLOCK_TYPE);
+        }
+
+        const WORD aIndices[6] = { 0u, 1u, 2u, 0u, 2u, 3u };
+        for (WORD uIndex : aIndices)
+        {
+            mesh.aIndices.push_back(static_cast<WORD>(uFirstIndex + uIndex));
+        }
+
+        section.uNumIndices += 6u;
+    }
+}
\ No newline at end of file
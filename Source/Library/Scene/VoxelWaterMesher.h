@@ -0,0 +1,82 @@
+/*+===================================================================
+  File:      VOXELWATERMESHER.H
+
+  Summary:   VoxelWaterMesher header file contains declarations of
+             VoxelWaterMesher class used to replace the stacked water
+             blocks of the height map by a flat surface mesh.
+
+  Classes: VoxelWaterMesher
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Scene/HeightMap.h"
+#include "Scene/VoxelChunkMesher.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   VoxelWaterStats
+
+        Summary:  Water cells of the height map, the surface built over
+                  them and the block instances it replaces
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct VoxelWaterStats
+    {
+        UINT64 uNumCells;
+        UINT64 uNumRegions;
+        UINT64 uNumQuads;
+        UINT64 uNumBlocks;
+        UINT64 uNumExposedBlocks;
+        UINT64 uNumColumns;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    VoxelWaterMesher
+
+      Summary:  Only the top of the water blocks can be seen, so the
+                water cells of the height map are drawn as one mesh of
+                upward quads instead of block instances. The cells are
+                grouped into 4-connected regions, every region is
+                flat at the top of its highest column, and the cells of
+                a region are covered with the largest rectangles. Runs
+                on the CPU only
+
+      Methods:  Mesh
+                  Builds the water surface and counts what it replaces
+                IsWater
+                  Returns whether the block type is drawn as water
+                VoxelWaterMesher
+                  Constructor.
+                ~VoxelWaterMesher
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class VoxelWaterMesher
+    {
+    public:
+        static constexpr const CHAR WATER_BLOCK_TYPE = static_cast<CHAR>(eBlockType::OCEAN);
+
+        static BOOL IsWater(_In_ CHAR blockType);
+
+        VoxelWaterMesher() = delete;
+        VoxelWaterMesher(_In_ const HeightMap& heightMap, _In_ const XMFLOAT3& origin);
+        VoxelWaterMesher(const VoxelWaterMesher& other) = delete;
+        VoxelWaterMesher(VoxelWaterMesher&& other) = delete;
+        VoxelWaterMesher& operator=(const VoxelWaterMesher& other) = delete;
+        VoxelWaterMesher& operator=(VoxelWaterMesher&& other) = delete;
+        ~VoxelWaterMesher() = default;
+
+        void Mesh(_Out_ VoxelChunkMesh& outMesh, _Out_ VoxelWaterStats& outStats) const;
+
+    private:
+        UINT findRegionLevels(_Out_ std::vector<UINT>& auLevels) const;
+        void addQuad(_In_ UINT uFirstX, _In_ UINT uFirstZ, _In_ UINT uNumX, _In_ UINT uNumZ, _In_ UINT uLevel, _Inout_ VoxelChunkMesh& mesh) const;
+
+    private:
+        const HeightMap& m_heightMap;
+        XMFLOAT3 m_origin;
+    };
+}
\ No newline at end of file
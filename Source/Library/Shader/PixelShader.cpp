@@ -32,8 +32,8 @@ namespace library
 
       Summary:  Initializes the pixel shader
 
-      Args:     ID3D11Device* pDevice
-                  The Direct3D device to create the pixel shader
+      Args:     RenderDevice* pDevice
+                  The render device to create the pixel shader
 
       Returns:  HRESULT
                   Status code
@@ -42,11 +42,11 @@ namespace library
       TODO: PixelShader::Initialize definition (remove the comment)
     --------------------------------------------------------------------*/
     // Compile the pixel shader
-    HRESULT PixelShader::Initialize(_In_ ID3D11Device* pDevice)
+    HRESULT PixelShader::Initialize(_In_ RenderDevice* pDevice)
     {
         HRESULT hr = S_OK;
         ComPtr<ID3DBlob> pPSBlob(nullptr);
-        hr = compile(pPSBlob.GetAddressOf()); // compileShaderFromFile(_In_ PCWSTR pszFileName, _In_ PCSTR pszEntryPoint, _In_ PCSTR szShaderModel, _Outptr_ ID3DBlob** ppBlobOut)
+        hr = compile(pDevice, pPSBlob.GetAddressOf()); // compileShaderFromFile(_In_ PCWSTR pszFileName, _In_ PCSTR pszEntryPoint, _In_ PCSTR szShaderModel, _Outptr_ ID3DBlob** ppBlobOut)
         if (FAILED(hr))
         {
             MessageBox(nullptr,
@@ -55,7 +55,7 @@ namespace library
         }
 
         // Create the pixel shader
-        hr = pDevice->CreatePixelShader(pPSBlob->GetBufferPointer(), pPSBlob->GetBufferSize(), nullptr, m_pixelShader.GetAddressOf());
+        hr = pDevice->CreatePixelShader(pPSBlob->GetBufferPointer(), pPSBlob->GetBufferSize(), m_pixelShader.GetAddressOf());
         //pPSBlob->Release();
         if (FAILED(hr))
             return hr;
@@ -42,7 +42,7 @@ namespace library
         PixelShader& operator=(PixelShader&& other) = delete;
         virtual ~PixelShader() = default;
 
-        virtual HRESULT Initialize(_In_ ID3D11Device* pDevice) override;
+        virtual HRESULT Initialize(_In_ RenderDevice* pDevice) override;
 
         ComPtr<ID3D11PixelShader>& GetPixelShader();
 
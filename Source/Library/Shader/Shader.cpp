@@ -45,14 +45,16 @@ namespace library
 
       Summary:  Compiles the given shader file
 
-      Args:     ID3DBlob** ppOutBlob
+      Args:     RenderDevice* pDevice
+                  The render device to compile with
+                ID3DBlob** ppOutBlob
                   Receives a pointer to the ID3DBlob interface that you
                   can use to access the compiled code
 
       Returns:  HRESULT
                   Status code
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    HRESULT Shader::compile(_Outptr_ ID3DBlob** ppOutBlob)
+    HRESULT Shader::compile(_In_ RenderDevice* pDevice, _Outptr_ ID3DBlob** ppOutBlob)
     {
         HRESULT hr = S_OK;
 
@@ -71,8 +73,7 @@ namespace library
         //comptr  ġ
         //ID3DBlob* pErrorBlob = nullptr;
         ComPtr<ID3DBlob> pErrorBlob(nullptr);
-        hr = D3DCompileFromFile(GetFileName(), nullptr, nullptr, m_pszEntryPoint, m_pszShaderModel, //d3dx?
-            dwShaderFlags, 0, ppOutBlob, pErrorBlob.GetAddressOf());
+        hr = pDevice->CompileShader(GetFileName(), m_pszEntryPoint, m_pszShaderModel, dwShaderFlags, ppOutBlob, pErrorBlob.GetAddressOf());
         //hr = D3DCompileFromFile(GetFileName());
         if (FAILED(hr))
         {
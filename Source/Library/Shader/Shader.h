@@ -13,6 +13,8 @@
 
 #include "Common.h"
 
+#include "Renderer/RenderDevice.h"
+
 namespace library
 {
     /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
@@ -42,11 +44,11 @@ namespace library
         Shader& operator=(Shader&& other) = delete;
         virtual ~Shader() = default;
 
-        virtual HRESULT Initialize(_In_ ID3D11Device* pDevice) = 0;
+        virtual HRESULT Initialize(_In_ RenderDevice* pDevice) = 0;
         PCWSTR GetFileName() const;
 
     protected:
-        HRESULT compile(_Outptr_ ID3DBlob** ppOutBlob);
+        HRESULT compile(_In_ RenderDevice* pDevice, _Outptr_ ID3DBlob** ppOutBlob);
 
         PCWSTR m_pszFileName;
         PCSTR m_pszEntryPoint;
@@ -7,10 +7,10 @@ namespace library
     {
     }
 
-    HRESULT SkinningVertexShader::Initialize(_In_ ID3D11Device* pDevice)
+    HRESULT SkinningVertexShader::Initialize(_In_ RenderDevice* pDevice)
     {
         ComPtr<ID3DBlob> vsBlob;
-        HRESULT hr = compile(vsBlob.GetAddressOf());
+        HRESULT hr = compile(pDevice, vsBlob.GetAddressOf());
         if (FAILED(hr))
         {
             WCHAR szMessage[256];
@@ -28,7 +28,7 @@ namespace library
             return hr;
         }
 
-        hr = pDevice->CreateVertexShader(vsBlob->GetBufferPointer(), vsBlob->GetBufferSize(), nullptr, m_vertexShader.GetAddressOf());
+        hr = pDevice->CreateVertexShader(vsBlob->GetBufferPointer(), vsBlob->GetBufferSize(), m_vertexShader.GetAddressOf());
         if (FAILED(hr))
         {
             return hr;
@@ -28,6 +28,6 @@ namespace library
         SkinningVertexShader& operator=(SkinningVertexShader&& other) = delete;
         virtual ~SkinningVertexShader() = default;
 
-        virtual HRESULT Initialize(_In_ ID3D11Device* pDevice) override;
+        virtual HRESULT Initialize(_In_ RenderDevice* pDevice) override;
     };
 }
\ No newline at end of file
@@ -25,19 +25,19 @@ namespace library
 
       Summary:  Initializes the vertex shader and the input layout
 
-      Args:     ID3D11Device* pDevice
-                  The Direct3D device to create the vertex shader
+      Args:     RenderDevice* pDevice
+                  The render device to create the vertex shader
 
       Returns:  HRESULT
                   Status code
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    HRESULT SkyMapVertexShader::Initialize(_In_ ID3D11Device* pDevice)
+    HRESULT SkyMapVertexShader::Initialize(_In_ RenderDevice* pDevice)
     {
         HRESULT hr = S_OK;
 
         // Compile the vertex shader
         ComPtr<ID3DBlob> pVSBlob = nullptr;
-        hr = compile(pVSBlob.GetAddressOf());
+        hr = compile(pDevice, pVSBlob.GetAddressOf());
 
         if (FAILED(hr))
         {
@@ -46,7 +46,7 @@ namespace library
         }
 
         // Create the vertex shader
-        hr = pDevice->CreateVertexShader(pVSBlob->GetBufferPointer(), pVSBlob->GetBufferSize(), nullptr, m_vertexShader.GetAddressOf());
+        hr = pDevice->CreateVertexShader(pVSBlob->GetBufferPointer(), pVSBlob->GetBufferSize(), m_vertexShader.GetAddressOf());
 
         if (FAILED(hr))
         {
@@ -40,6 +40,6 @@ namespace library
         SkyMapVertexShader& operator=(SkyMapVertexShader&& other) = delete;
         virtual ~SkyMapVertexShader() = default;
 
-        virtual HRESULT Initialize(_In_ ID3D11Device* pDevice) override;
+        virtual HRESULT Initialize(_In_ RenderDevice* pDevice) override;
     };
 }
\ No newline at end of file
@@ -22,18 +22,18 @@ namespace library
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   VertexShader::Initialize
       Summary:  Initializes the vertex shader and the input layout
-      Args:     ID3D11Device* pDevice
-                  The Direct3D device to create the vertex shader
+      Args:     RenderDevice* pDevice
+                  The render device to create the vertex shader
       Returns:  HRESULT
                   Status code
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    HRESULT VertexShader::Initialize(_In_ ID3D11Device* pDevice) {
+    HRESULT VertexShader::Initialize(_In_ RenderDevice* pDevice) {
 
         HRESULT hr = S_OK;
 
         ComPtr<ID3DBlob> pVSBlob(nullptr);
 
-        hr = compile(pVSBlob.GetAddressOf());//..C:\Users\MHC\source\repos\GmG\Library
+        hr = compile(pDevice, pVSBlob.GetAddressOf());//..C:\Users\MHC\source\repos\GmG\Library
         if (FAILED(hr))
         {
             MessageBox(nullptr,
@@ -42,7 +42,7 @@ namespace library
         }
 
 
-        hr = pDevice->CreateVertexShader(pVSBlob->GetBufferPointer(),pVSBlob->GetBufferSize(),nullptr,m_vertexShader.GetAddressOf());
+        hr = pDevice->CreateVertexShader(pVSBlob->GetBufferPointer(),pVSBlob->GetBufferSize(), m_vertexShader.GetAddressOf());
         if (FAILED(hr))
         {
             MessageBox(nullptr,
@@ -44,7 +44,7 @@ namespace library
         VertexShader& operator=(VertexShader&& other) = delete;
         virtual ~VertexShader() = default;
 
-        virtual HRESULT Initialize(_In_ ID3D11Device* pDevice) override;
+        virtual HRESULT Initialize(_In_ RenderDevice* pDevice) override;
 
         ComPtr<ID3D11VertexShader>& GetVertexShader();
         ComPtr<ID3D11InputLayout>& GetVertexLayout();
@@ -0,0 +1,33 @@
+/*+===================================================================
+  File:      VOXELCHUNKVERTEXSHADER.H
+
+  Summary:   VoxelChunkVertexShader header file contains declarations
+             of VoxelChunkVertexShader class used to draw the meshed
+             chunks of the voxel map.
+
+  Classes: VoxelChunkVertexShader
+
+  2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Shader/VertexShader.h"
+
+namespace library
+{
+    class VoxelChunkVertexShader : public VertexShader
+    {
+    public:
+        VoxelChunkVertexShader() = delete;
+        VoxelChunkVertexShader(_In_ PCWSTR pszFileName, _In_ PCSTR pszEntryPoint, _In_ PCSTR pszShaderModel);
+        VoxelChunkVertexShader(const VoxelChunkVertexShader& other) = delete;
+        VoxelChunkVertexShader(VoxelChunkVertexShader&& other) = delete;
+        VoxelChunkVertexShader& operator=(const VoxelChunkVertexShader& other) = delete;
+        VoxelChunkVertexShader& operator=(VoxelChunkVertexShader&& other) = delete;
+        virtual ~VoxelChunkVertexShader() = default;
+
+        virtual HRESULT Initialize(_In_ RenderDevice* pDevice) override;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,33 @@
+/*+===================================================================
+  File:      VOXELCOLUMNVERTEXSHADER.H
+
+  Summary:   VoxelColumnVertexShader header file contains
+             declarations of VoxelColumnVertexShader class used to
+             draw the voxels instanced as whole columns.
+
+  Classes: VoxelColumnVertexShader
+
+  2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Shader/VertexShader.h"
+
+namespace library
+{
+    class VoxelColumnVertexShader : public VertexShader
+    {
+    public:
+        VoxelColumnVertexShader() = delete;
+        VoxelColumnVertexShader(_In_ PCWSTR pszFileName, _In_ PCSTR pszEntryPoint, _In_ PCSTR pszShaderModel);
+        VoxelColumnVertexShader(const VoxelColumnVertexShader& other) = delete;
+        VoxelColumnVertexShader(VoxelColumnVertexShader&& other) = delete;
+        VoxelColumnVertexShader& operator=(const VoxelColumnVertexShader& other) = delete;
+        VoxelColumnVertexShader& operator=(VoxelColumnVertexShader&& other) = delete;
+        virtual ~VoxelColumnVertexShader() = default;
+
+        virtual HRESULT Initialize(_In_ RenderDevice* pDevice) override;
+    };
+}
\ No newline at end of file
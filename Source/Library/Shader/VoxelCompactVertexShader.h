@@ -0,0 +1,33 @@
+/*+===================================================================
+  File:      VOXELCOMPACTVERTEXSHADER.H
+
+  Summary:   VoxelCompactVertexShader header file contains
+             declarations of VoxelCompactVertexShader class used to
+             draw the voxels instanced in the compact format.
+
+  Classes: VoxelCompactVertexShader
+
+  2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Shader/VertexShader.h"
+
+namespace library
+{
+    class VoxelCompactVertexShader : public VertexShader
+    {
+    public:
+        VoxelCompactVertexShader() = delete;
+        VoxelCompactVertexShader(_In_ PCWSTR pszFileName, _In_ PCSTR pszEntryPoint, _In_ PCSTR pszShaderModel);
+        VoxelCompactVertexShader(const VoxelCompactVertexShader& other) = delete;
+        VoxelCompactVertexShader(VoxelCompactVertexShader&& other) = delete;
+        VoxelCompactVertexShader& operator=(const VoxelCompactVertexShader& other) = delete;
+        VoxelCompactVertexShader& operator=(VoxelCompactVertexShader&& other) = delete;
+        virtual ~VoxelCompactVertexShader() = default;
+
+        virtual HRESULT Initialize(_In_ RenderDevice* pDevice) override;
+    };
+}
\ No newline at end of file
@@ -7,17 +7,18 @@ namespace library
 		, pDiffuse()
 		, pSpecularExponent()
 		, pNormal()
+		, bTransparent(FALSE)
 		, m_szName(szName)
 	{
 	}
 
-	HRESULT Material::Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext)
+	HRESULT Material::Initialize(_In_ RenderDevice* pDevice)
 	{
 		HRESULT hr = S_OK;
 
 		if (pDiffuse)
 		{
-			hr = pDiffuse->Initialize(pDevice, pImmediateContext);
+			hr = pDiffuse->Initialize(pDevice);
 			if (FAILED(hr))
 			{
 				return hr;
@@ -26,7 +27,7 @@ namespace library
 
 		if (pSpecularExponent)
 		{
-			hr = pSpecularExponent->Initialize(pDevice, pImmediateContext);
+			hr = pSpecularExponent->Initialize(pDevice);
 			if (FAILED(hr))
 			{
 				return hr;
@@ -35,7 +36,7 @@ namespace library
 
 		if (pNormal)
 		{
-			hr = pNormal->Initialize(pDevice, pImmediateContext);
+			hr = pNormal->Initialize(pDevice);
 			if (FAILED(hr))
 			{
 				return hr;
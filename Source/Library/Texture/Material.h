@@ -27,7 +27,7 @@ namespace library
 		Material& operator=(Material&& other) = default;
 		virtual ~Material() = default;
 
-		virtual HRESULT Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext);
+		virtual HRESULT Initialize(_In_ RenderDevice* pDevice);
 
 		std::wstring GetName() const;
 
@@ -39,5 +39,8 @@ namespace library
 		std::shared_ptr<Texture> pDiffuse;
 		std::shared_ptr<Texture> pSpecularExponent;
 		std::shared_ptr<Texture> pNormal;
+
+		// Blended or alpha tested, drawn back to front after the opaque meshes
+		BOOL bTransparent;
 	};
 }
\ No newline at end of file
@@ -25,8 +25,7 @@ namespace library
 
 	  Summary:  Initialize
 
-	  Args:     ID3D11Device* pDevice
-				ID3D11DeviceContext* pImmediateContext
+	  Args:     RenderDevice* pDevice
 
 	  Modifies: [m_texture2D, m_renderTargetView, m_shaderResourceView,
 				 m_samplerClamp].
@@ -34,7 +33,7 @@ namespace library
 	  Returns:  HRESULT
 				  Status code
 	M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-	HRESULT RenderTexture::Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext)
+	HRESULT RenderTexture::Initialize(_In_ RenderDevice* pDevice)
 	{
 		HRESULT hr = S_OK;
 
@@ -12,6 +12,8 @@
 
 #include "Common.h"
 
+#include "Renderer/RenderDevice.h"
+
 namespace library
 {
 	class RenderTexture
@@ -25,7 +27,7 @@ namespace library
 		RenderTexture& operator=(RenderTexture&& other) = delete;
 		~RenderTexture() = default;
 
-		HRESULT Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext);
+		HRESULT Initialize(_In_ RenderDevice* pDevice);
 
 		ComPtr<ID3D11Texture2D>& GetTexture2D();
 		ComPtr<ID3D11RenderTargetView>& GetRenderTargetView();
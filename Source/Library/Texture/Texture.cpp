@@ -1,8 +1,5 @@
 #include "Texture.h"
 
-#include "Texture/DDSTextureLoader.h"
-#include "Texture/WICTextureLoader.h"
-
 namespace library
 {
     ComPtr<ID3D11SamplerState> Texture::s_samplers[static_cast<size_t>(eTextureSamplerType::COUNT)];
@@ -25,31 +22,19 @@ namespace library
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Texture::Initialize
       Summary:  Initializes the texture and samplers if not initialized
-      Args:     ID3D11Device* pDevice
-                  The Direct3D device to create the buffers
-                ID3D11DeviceContext* pImmediateContext
-                  The Direct3D context to set buffers
+      Args:     RenderDevice* pDevice
+                  The render device to create the buffers
       Modifies: [m_textureRV].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    HRESULT Texture::Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext)
+    HRESULT Texture::Initialize(_In_ RenderDevice* pDevice)
     {
-        HRESULT hr = CreateWICTextureFromFile(
-            pDevice,
-            pImmediateContext,
-            m_filePath.c_str(),
-            nullptr,
-            m_textureRV.GetAddressOf()
-        );
+        HRESULT hr = pDevice->CreateTextureFromFile(m_filePath, m_textureRV.GetAddressOf());
         if (FAILED(hr))
         {
-            hr = CreateDDSTextureFromFile(pDevice, m_filePath.c_str(), nullptr, m_textureRV.GetAddressOf());
-            if (FAILED(hr))
-            {
-                OutputDebugString(L"Can't load texture from \"");
-                OutputDebugString(m_filePath.c_str());
-                OutputDebugString(L"\n");
-                return hr;
-            }
+            OutputDebugString(L"Can't load texture from \"");
+            OutputDebugString(m_filePath.c_str());
+            OutputDebugString(L"\n");
+            return hr;
         }
 
         // Create the sample state
@@ -12,6 +12,8 @@
 
 #include "Common.h"
 
+#include "Renderer/RenderDevice.h"
+
 namespace library
 {
     enum class eTextureSamplerType : size_t
@@ -33,7 +35,7 @@ namespace library
         virtual ~Texture() = default;
 
         // Should be called once to load the texture
-        virtual HRESULT Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext);
+        virtual HRESULT Initialize(_In_ RenderDevice* pDevice);
 
         ComPtr<ID3D11ShaderResourceView>& GetTextureResourceView();
         eTextureSamplerType GetSamplerType() const;
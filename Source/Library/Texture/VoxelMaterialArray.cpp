@@ -0,0 +1,279 @@
+#include "Texture/VoxelMaterialArray.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace library
+{
+    namespace
+    {
+        // Brightness of the rim of a face and how much the speckles darken it
+        constexpr const FLOAT RIM_BRIGHTNESS = 0.75f;
+        constexpr const FLOAT SPECKLE_STRENGTH = 0.15f;
+
+        // Slope of the bevelled rim and of the speckles in the normal map
+        constexpr const FLOAT RIM_SLOPE = 0.6f;
+        constexpr const FLOAT SPECKLE_SLOPE = 0.1f;
+
+        UINT packColor(_In_ FLOAT r, _In_ FLOAT g, _In_ FLOAT b, _In_ FLOAT a)
+        {
+            return static_cast<UINT>(std::clamp(r, 0.0f, 1.0f) * 255.0f + 0.5f) |
+                static_cast<UINT>(std::clamp(g, 0.0f, 1.0f) * 255.0f + 0.5f) << 8u |
+                static_cast<UINT>(std::clamp(b, 0.0f, 1.0f) * 255.0f + 0.5f) << 16u |
+                static_cast<UINT>(std::clamp(a, 0.0f, 1.0f) * 255.0f + 0.5f) << 24u;
+        }
+
+        // Averages 2x2 texels channel by channel
+        UINT averageColors(_In_ UINT uColor0, _In_ UINT uColor1, _In_ UINT uColor2, _In_ UINT uColor3)
+        {
+            UINT uColor = 0u;
+            for (UINT uShift = 0u; uShift < 32u; uShift += 8u)
+            {
+                UINT uSum = ((uColor0 >> uShift) & 0xFFu) + ((uColor1 >> uShift) & 0xFFu) + ((uColor2 >> uShift) & 0xFFu) + ((uColor3 >> uShift) & 0xFFu);
+                uColor |= ((uSum + 2u) / 4u) << uShift;
+            }
+
+            return uColor;
+        }
+
+        // Noise in [0, 1] of a texel, the same for every run
+        FLOAT getSpeckle(_In_ UINT x, _In_ UINT y, _In_ UINT uSlice)
+        {
+            UINT uHash = x * 73856093u ^ y * 19349663u ^ (uSlice + 1u) * 83492791u;
+            uHash ^= uHash >> 13u;
+            uHash *= 0x5BD1E995u;
+            uHash ^= uHash >> 15u;
+
+            return static_cast<FLOAT>(uHash & 0xFFu) / 255.0f;
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelMaterialArray::BuildSlices
+      Summary:  Generates the albedo and the tangent space normal map of
+                every block type, mip level 0 from the palette and the
+                smaller levels by averaging 2x2 texels. The texels are
+                R8G8B8A8, in the order of the subresources: slice by
+                slice, and every slice mip level by mip level
+      Args:     const std::vector<XMFLOAT4>& aPalette
+                  Color of every block type
+                std::vector<UINT>& aOutAlbedos
+                  Albedo texels
+                std::vector<UINT>& aOutNormals
+                  Normal map texels
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    void VoxelMaterialArray::BuildSlices(_In_ const std::vector<XMFLOAT4>& aPalette, _Out_ std::vector<UINT>& aOutAlbedos, _Out_ std::vector<UINT>& aOutNormals)
+    {
+        UINT uNumSliceTexels = 0u;
+        for (UINT uMip = 0u; uMip < NUM_MIP_LEVELS; ++uMip)
+        {
+            uNumSliceTexels += (SLICE_SIZE >> uMip) * (SLICE_SIZE >> uMip);
+        }
+
+        aOutAlbedos.assign(static_cast<size_t>(uNumSliceTexels) * aPalette.size(), 0u);
+        aOutNormals.assign(static_cast<size_t>(uNumSliceTexels) * aPalette.size(), 0u);
+
+        for (UINT uSlice = 0u; uSlice < static_cast<UINT>(aPalette.size()); ++uSlice)
+        {
+            UINT* pAlbedos = aOutAlbedos.data() + static_cast<size_t>(uSlice) * uNumSliceTexels;
+            UINT* pNormals = aOutNormals.data() + static_cast<size_t>(uSlice) * uNumSliceTexels;
+            const XMFLOAT4& color = aPalette[uSlice];
+
+            for (UINT y = 0u; y < SLICE_SIZE; ++y)
+            {
+                for (UINT x = 0u; x < SLICE_SIZE; ++x)
+                {
+                    FLOAT speckle = getSpeckle(x, y, uSlice);
+                    FLOAT slopeX = (x == 0u ? -RIM_SLOPE : 0.0f) + (x + 1u == SLICE_SIZE ? RIM_SLOPE : 0.0f) + (speckle - 0.5f) * SPECKLE_SLOPE;
+                    FLOAT slopeY = (y == 0u ? -RIM_SLOPE : 0.0f) + (y + 1u == SLICE_SIZE ? RIM_SLOPE : 0.0f) + (getSpeckle(y, x, uSlice) - 0.5f) * SPECKLE_SLOPE;
+                    BOOL bRim = x == 0u || y == 0u || x + 1u == SLICE_SIZE || y + 1u == SLICE_SIZE;
+
+                    FLOAT brightness = (1.0f - SPECKLE_STRENGTH * speckle) * (bRim ? RIM_BRIGHTNESS : 1.0f);
+                    pAlbedos[y * SLICE_SIZE + x] = packColor(color.x * brightness, color.y * brightness, color.z * brightness, 1.0f);
+
+                    FLOAT length = std::sqrt(slopeX * slopeX + slopeY * slopeY + 1.0f);
+                    pNormals[y * SLICE_SIZE + x] = packColor(
+                        slopeX / length * 0.5f + 0.5f,
+                        slopeY / length * 0.5f + 0.5f,
+                        1.0f / length * 0.5f + 0.5f,
+                        1.0f
+                    );
+                }
+            }
+
+            UINT uSource = 0u;
+            UINT uTarget = SLICE_SIZE * SLICE_SIZE;
+            for (UINT uMip = 1u; uMip < NUM_MIP_LEVELS; ++uMip)
+            {
+                const UINT uSize = SLICE_SIZE >> uMip;
+                const UINT uSourceSize = uSize * 2u;
+                for (UINT y = 0u; y < uSize; ++y)
+                {
+                    for (UINT x = 0u; x < uSize; ++x)
+                    {
+                        UINT uTopLeft = uSource + 2u * y * uSourceSize + 2u * x;
+                        pAlbedos[uTarget + y * uSize + x] = averageColors(
+                            pAlbedos[uTopLeft], pAlbedos[uTopLeft + 1u], pAlbedos[uTopLeft + uSourceSize], pAlbedos[uTopLeft + uSourceSize + 1u]);
+                        pNormals[uTarget + y * uSize + x] = averageColors(
+                            pNormals[uTopLeft], pNormals[uTopLeft + 1u], pNormals[uTopLeft + uSourceSize], pNormals[uTopLeft + uSourceSize + 1u]);
+                    }
+                }
+
+                uSource = uTarget;
+                uTarget += uSize * uSize;
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelMaterialArray::VoxelMaterialArray
+      Summary:  Constructor
+      Args:     const std::vector<XMFLOAT4>& aPalette
+                  Color of every block type, one slice each
+      Modifies: [m_aPalette, m_albedoView, m_normalView].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    VoxelMaterialArray::VoxelMaterialArray(_In_ const std::vector<XMFLOAT4>& aPalette)
+        : m_aPalette(aPalette)
+        , m_albedoView()
+        , m_normalView()
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelMaterialArray::Initialize
+      Summary:  Generates the slices and creates the albedo and normal
+                map arrays
+      Args:     RenderDevice* pDevice
+                  The render device to create the textures
+      Modifies: [m_albedoView, m_normalView].
+      Returns:  HRESULT
+                  Status code, E_INVALIDARG without a block type or with
+                  more than an array can hold
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT VoxelMaterialArray::Initialize(_In_ RenderDevice* pDevice)
+    {
+        if (m_aPalette.empty() || m_aPalette.size() > D3D11_REQ_TEXTURE2D_ARRAY_AXIS_DIMENSION)
+        {
+            return E_INVALIDARG;
+        }
+
+        std::vector<UINT> aAlbedos;
+        std::vector<UINT> aNormals;
+        BuildSlices(m_aPalette, aAlbedos, aNormals);
+
+        HRESULT hr = createArray(pDevice, aAlbedos, m_albedoView);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        return createArray(pDevice, aNormals, m_normalView);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelMaterialArray::GetAlbedoView
+      Summary:  Returns the view of the albedo array
+      Returns:  ComPtr<ID3D11ShaderResourceView>&
+                  Shader resource view
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ComPtr<ID3D11ShaderResourceView>& VoxelMaterialArray::GetAlbedoView()
+    {
+        return m_albedoView;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelMaterialArray::GetNormalView
+      Summary:  Returns the view of the normal map array
+      Returns:  ComPtr<ID3D11ShaderResourceView>&
+                  Shader resource view
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    ComPtr<ID3D11ShaderResourceView>& VoxelMaterialArray::GetNormalView()
+    {
+        return m_normalView;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelMaterialArray::GetNumSlices
+      Summary:  Returns the number of slices of the arrays
+      Returns:  UINT
+                  Number of block types
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    UINT VoxelMaterialArray::GetNumSlices() const
+    {
+        return static_cast<UINT>(m_aPalette.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VoxelMaterialArray::createArray
+      Summary:  Creates an immutable texture array of one slice per
+                block type with its full mip chain
+      Args:     RenderDevice* pDevice
+                  The render device to create the texture
+                const std::vector<UINT>& aTexels
+                  Texels of every subresource, as BuildSlices lays them
+                ComPtr<ID3D11ShaderResourceView>& outView
+                  View of the whole array
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT VoxelMaterialArray::createArray(_In_ RenderDevice* pDevice, _In_ const std::vector<UINT>& aTexels, _Out_ ComPtr<ID3D11ShaderResourceView>& outView) const
+    {
+        const UINT uNumSlices = GetNumSlices();
+
+        std::vector<D3D11_SUBRESOURCE_DATA> aInitData;
+        aInitData.reserve(static_cast<size_t>(uNumSlices) * NUM_MIP_LEVELS);
+        const UINT* pTexels = aTexels.data();
+        for (UINT uSlice = 0u; uSlice < uNumSlices; ++uSlice)
+        {
+            for (UINT uMip = 0u; uMip < NUM_MIP_LEVELS; ++uMip)
+            {
+                const UINT uSize = SLICE_SIZE >> uMip;
+                aInitData.push_back(
+                    D3D11_SUBRESOURCE_DATA
+                    {
+                        .pSysMem = pTexels,
+                        .SysMemPitch = static_cast<UINT>(sizeof(UINT) * uSize),
+                        .SysMemSlicePitch = 0u
+                    }
+                );
+                pTexels += uSize * uSize;
+            }
+        }
+
+        D3D11_TEXTURE2D_DESC textureDesc =
+        {
+            .Width = SLICE_SIZE,
+            .Height = SLICE_SIZE,
+            .MipLevels = NUM_MIP_LEVELS,
+            .ArraySize = uNumSlices,
+            .Format = DXGI_FORMAT_R8G8B8A8_UNORM,
+            .SampleDesc = {.Count = 1u },
+            .Usage = D3D11_USAGE_IMMUTABLE,
+            .BindFlags = D3D11_BIND_SHADER_RESOURCE,
+            .CPUAccessFlags = 0u,
+            .MiscFlags = 0u
+        };
+
+        ComPtr<ID3D11Texture2D> texture;
+        HRESULT hr = pDevice->CreateTexture2D(&textureDesc, aInitData.data(), texture.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        D3D11_SHADER_RESOURCE_VIEW_DESC viewDesc =
+        {
+            .Format = textureDesc.Format,
+            .ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2DARRAY,
+            .Texture2DArray =
+            {
+                .MostDetailedMip = 0u,
+                .MipLevels = NUM_MIP_LEVELS,
+                .FirstArraySlice = 0u,
+                .ArraySize = uNumSlices
+            }
+        };
+
+        return pDevice->CreateShaderResourceView(texture.Get(), &viewDesc, outView.ReleaseAndGetAddressOf());
+    }
+}
\ No newline at end of file
@@ -0,0 +1,76 @@
+/*+===================================================================
+  File:      VOXELMATERIALARRAY.H
+
+  Summary:   VoxelMaterialArray header file contains declarations of
+             VoxelMaterialArray class, the albedo and normal maps of
+             every block type in two texture arrays.
+
+  Classes: VoxelMaterialArray
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Renderer/RenderDevice.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    VoxelMaterialArray
+
+      Summary:  Albedo and normal maps of the block types, one slice of
+                a Texture2DArray per color of the palette, so that the
+                blocks of every type are drawn by one instanced draw
+                that picks the slice of each instance from its type.
+                The slices are generated from the palette color, a
+                speckled face with a darker rim and a bevelled normal
+                map, with their full mip chains
+
+      Methods:  BuildSlices
+                  Generates the texels of every slice and mip level
+                Initialize
+                  Creates the texture arrays
+                GetAlbedoView
+                  Returns the view of the albedo array
+                GetNormalView
+                  Returns the view of the normal map array
+                GetNumSlices
+                  Returns the number of block types
+                VoxelMaterialArray
+                  Constructor.
+                ~VoxelMaterialArray
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class VoxelMaterialArray
+    {
+    public:
+        static constexpr const UINT SLICE_SIZE = 16u;
+        static constexpr const UINT NUM_MIP_LEVELS = 5u;
+
+        static void BuildSlices(_In_ const std::vector<XMFLOAT4>& aPalette, _Out_ std::vector<UINT>& aOutAlbedos, _Out_ std::vector<UINT>& aOutNormals);
+
+        VoxelMaterialArray() = delete;
+        VoxelMaterialArray(_In_ const std::vector<XMFLOAT4>& aPalette);
+        VoxelMaterialArray(const VoxelMaterialArray& other) = delete;
+        VoxelMaterialArray(VoxelMaterialArray&& other) = delete;
+        VoxelMaterialArray& operator=(const VoxelMaterialArray& other) = delete;
+        VoxelMaterialArray& operator=(VoxelMaterialArray&& other) = delete;
+        ~VoxelMaterialArray() = default;
+
+        HRESULT Initialize(_In_ RenderDevice* pDevice);
+
+        ComPtr<ID3D11ShaderResourceView>& GetAlbedoView();
+        ComPtr<ID3D11ShaderResourceView>& GetNormalView();
+        UINT GetNumSlices() const;
+
+    private:
+        HRESULT createArray(_In_ RenderDevice* pDevice, _In_ const std::vector<UINT>& aTexels, _Out_ ComPtr<ID3D11ShaderResourceView>& outView) const;
+
+    private:
+        std::vector<XMFLOAT4> m_aPalette;
+        ComPtr<ID3D11ShaderResourceView> m_albedoView;
+        ComPtr<ID3D11ShaderResourceView> m_normalView;
+    };
+}
\ No newline at end of file
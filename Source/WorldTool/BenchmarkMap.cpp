@@ -0,0 +1,63 @@
+/*+===================================================================
+  File:      BENCHMARKMAP.CPP
+
+  Summary:   Deterministic height maps the world tool benchmarks run
+             on.
+
+  Functions: CreateBenchmarkMap
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+
+#include "BenchmarkMap.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace worldtool
+{
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: CreateBenchmarkMap
+
+      Summary:  Creates a deterministic height map with rolling
+                hills. TEMPERATE_RAIN_FOREST is left out because
+                its character is a space that the text format
+                cannot represent
+
+      Args:     UINT uSize
+                  Number of cells along the x and the z axes
+
+      Returns:  library::HeightMap
+                  Height map of uSize * BENCH_MAP_HEIGHT * uSize
+    F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+    library::HeightMap CreateBenchmarkMap(_In_ UINT uSize)
+    {
+        constexpr const UINT uNumTypes = static_cast<UINT>(library::eBlockType::COUNT) - static_cast<UINT>(library::eBlockType::GRASSLAND);
+
+        std::vector<XMFLOAT4> aPalette;
+        aPalette.reserve(uNumTypes);
+        for (UINT i = 0u; i < uNumTypes; ++i)
+        {
+            FLOAT t = static_cast<FLOAT>(i) / static_cast<FLOAT>(uNumTypes);
+            aPalette.push_back(XMFLOAT4(t, 1.0f - t, 0.5f, 1.0f));
+        }
+
+        library::HeightMap heightMap(uSize, BENCH_MAP_HEIGHT, uSize, std::move(aPalette));
+        for (UINT z = 0u; z < uSize; ++z)
+        {
+            for (UINT x = 0u; x < uSize; ++x)
+            {
+                FLOAT height = 0.5f + 0.25f * (sinf(static_cast<FLOAT>(x) * 0.05f) + cosf(static_cast<FLOAT>(z) * 0.07f));
+                CHAR blockType = static_cast<CHAR>(static_cast<UINT>(library::eBlockType::GRASSLAND) + (x / 16u + z / 16u) % uNumTypes);
+                if (blockType == static_cast<CHAR>(library::eBlockType::TEMPERATE_RAIN_FOREST))
+                {
+                    blockType = static_cast<CHAR>(library::eBlockType::GRASSLAND);
+                }
+
+                heightMap.SetCell(x, z, blockType, std::clamp(height, 0.0f, 1.0f));
+            }
+        }
+
+        return heightMap;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,23 @@
+/*+===================================================================
+  File:      BENCHMARKMAP.H
+
+  Summary:   BenchmarkMap header file contains declarations of the
+             deterministic height maps the world tool benchmarks run
+             on.
+
+  Functions: CreateBenchmarkMap
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Scene/HeightMap.h"
+
+namespace worldtool
+{
+    constexpr const UINT BENCH_MAP_HEIGHT = 64u;
+
+    library::HeightMap CreateBenchmarkMap(_In_ UINT uSize);
+}
\ No newline at end of file
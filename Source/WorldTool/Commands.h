@@ -0,0 +1,48 @@
+/*+===================================================================
+  File:      COMMANDS.H
+
+  Summary:   Commands header file contains declarations of the
+             command-line commands of the world tool.
+
+  Functions: RunConvert, RunBenchLoad, RunBenchMesh, RunInstanceStats,
+             RunInstanceMemory, RunBenchNoise, RunGenerate,
+             RunSoakStream, RunBenchLod, RunBenchEdit,
+             RunBenchRaycast, RunBenchStorage, RunWaterStats,
+             RunBenchDensity, RunBenchRegion, RunBenchLight,
+             RunBenchHorizon, RunBenchTerrain, RunBenchRender,
+             RunBenchUpload, ParseUint
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+namespace worldtool
+{
+    // Entry point of a command, receives the arguments following the command name
+    using PFN_COMMAND = INT(*)(_In_ INT argc, _In_reads_(argc) PWSTR* argv);
+
+    INT RunConvert(_In_ INT argc, _In_reads_(argc) PWSTR* argv);
+    INT RunBenchLoad(_In_ INT argc, _In_reads_(argc) PWSTR* argv);
+    INT RunBenchMesh(_In_ INT argc, _In_reads_(argc) PWSTR* argv);
+    INT RunInstanceStats(_In_ INT argc, _In_reads_(argc) PWSTR* argv);
+    INT RunInstanceMemory(_In_ INT argc, _In_reads_(argc) PWSTR* argv);
+    INT RunWaterStats(_In_ INT argc, _In_reads_(argc) PWSTR* argv);
+    INT RunBenchNoise(_In_ INT argc, _In_reads_(argc) PWSTR* argv);
+    INT RunGenerate(_In_ INT argc, _In_reads_(argc) PWSTR* argv);
+    INT RunBenchDensity(_In_ INT argc, _In_reads_(argc) PWSTR* argv);
+    INT RunSoakStream(_In_ INT argc, _In_reads_(argc) PWSTR* argv);
+    INT RunBenchLod(_In_ INT argc, _In_reads_(argc) PWSTR* argv);
+    INT RunBenchEdit(_In_ INT argc, _In_reads_(argc) PWSTR* argv);
+    INT RunBenchRaycast(_In_ INT argc, _In_reads_(argc) PWSTR* argv);
+    INT RunBenchStorage(_In_ INT argc, _In_reads_(argc) PWSTR* argv);
+    INT RunBenchRegion(_In_ INT argc, _In_reads_(argc) PWSTR* argv);
+    INT RunBenchLight(_In_ INT argc, _In_reads_(argc) PWSTR* argv);
+    INT RunBenchHorizon(_In_ INT argc, _In_reads_(argc) PWSTR* argv);
+    INT RunBenchTerrain(_In_ INT argc, _In_reads_(argc) PWSTR* argv);
+    INT RunBenchRender(_In_ INT argc, _In_reads_(argc) PWSTR* argv);
+    INT RunBenchUpload(_In_ INT argc, _In_reads_(argc) PWSTR* argv);
+
+    BOOL ParseUint(_In_ INT argc, _In_reads_(argc) PWSTR* argv, _In_ INT iIndex, _In_ UINT uDefault, _Out_ UINT& uOutValue);
+}
\ No newline at end of file
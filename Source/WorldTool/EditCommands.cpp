@@ -0,0 +1,263 @@
+/*+===================================================================
+  File:      EDITCOMMANDS.CPP
+
+  Summary:   Editing commands of the world tool: edits random blocks
+             of the instanced voxels every frame and compares the
+             instances uploaded through the dirty ranges with a full
+             rebuild of every instance buffer.
+
+  Functions: RunBenchEdit
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+
+#include "Commands.h"
+
+#include <cstdio>
+#include <random>
+
+#include "BenchmarkMap.h"
+#include "Scene/VoxelEditor.h"
+#include "Stopwatch.h"
+
+namespace worldtool
+{
+    namespace
+    {
+        constexpr const UINT EDIT_DEFAULT_SIZE = 1024u;
+        constexpr const UINT EDIT_DEFAULT_EDITS = 1000u;
+        constexpr const UINT EDIT_DEFAULT_FRAMES = 60u;
+
+        // Same edits for both formats
+        constexpr const UINT EDIT_SEED = 1234u;
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: EditRandomBlock
+
+          Summary:  Digs the top block of a random column, or piles a
+                    block of the same type on it
+
+          Args:     library::VoxelEditor& editor
+                      Editor of the voxels
+                    const library::HeightMap& heightMap
+                      Height map the editor was created from
+                    std::mt19937& generator
+                      Random number generator
+        F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+        void EditRandomBlock(_Inout_ library::VoxelEditor& editor, _In_ const library::HeightMap& heightMap, _Inout_ std::mt19937& generator)
+        {
+            UINT x = generator() % heightMap.GetWidth();
+            UINT z = generator() % heightMap.GetDepth();
+            BOOL bDig = (generator() & 1u) != 0u;
+
+            UINT uTop = heightMap.GetHeight();
+            while (uTop > 0u && editor.GetBlock(x, uTop - 1u, z) == library::HeightMap::EMPTY_BLOCK)
+            {
+                --uTop;
+            }
+
+            if (uTop == 0u)
+            {
+                return;
+            }
+
+            if (bDig || uTop == heightMap.GetHeight())
+            {
+                editor.ClearBlock(x, uTop - 1u, z);
+                return;
+            }
+
+            editor.SetBlock(x, uTop, z, editor.GetBlock(x, uTop - 1u, z));
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: MatchesHeightMap
+
+          Summary:  Checks the blocks of each type an exposed build kept
+                    and culled against the columns of the height map,
+                    where every block below the exposed height is
+                    enclosed
+
+          Args:     const std::vector<library::VoxelInstanceStats>& aStats
+                      Counts of the build, one per block type
+                    const library::HeightMap& heightMap
+                      Height map the grid was created from
+
+          Returns:  BOOL
+                    TRUE if every block type has the same counts
+        F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+        BOOL MatchesHeightMap(_In_ const std::vector<library::VoxelInstanceStats>& aStats, _In_ const library::HeightMap& heightMap)
+        {
+            std::vector<library::VoxelInstanceStats> aExpected(aStats.size(), library::VoxelInstanceStats{ .uNumKept = 0u, .uNumCulled = 0u });
+            for (UINT z = 0u; z < heightMap.GetDepth(); ++z)
+            {
+                for (UINT x = 0u; x < heightMap.GetWidth(); ++x)
+                {
+                    size_t uTypeIdx = static_cast<size_t>(heightMap.GetBlockType(x, z)) - static_cast<size_t>(library::eBlockType::GRASSLAND);
+                    if (heightMap.GetBlockType(x, z) != library::HeightMap::EMPTY_BLOCK && uTypeIdx < aExpected.size())
+                    {
+                        UINT uExposedHeight = heightMap.GetExposedHeight(x, z);
+                        aExpected[uTypeIdx].uNumKept += heightMap.GetColumnHeight(x, z) - uExposedHeight;
+                        aExpected[uTypeIdx].uNumCulled += uExposedHeight;
+                    }
+                }
+            }
+
+            for (size_t uTypeIdx = 0u; uTypeIdx < aStats.size(); ++uTypeIdx)
+            {
+                if (aStats[uTypeIdx].uNumKept != aExpected[uTypeIdx].uNumKept || aStats[uTypeIdx].uNumCulled != aExpected[uTypeIdx].uNumCulled)
+                {
+                    return FALSE;
+                }
+            }
+
+            return TRUE;
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: PrintEditStats
+
+          Summary:  Builds the exposed instances in the given format,
+                    applies the random edits frame by frame and prints
+                    the time and the bytes of a full rebuild next to
+                    the ones of the edits of a frame. Checks the block
+                    counts of the first build against the height map,
+                    and builds again at the end to check that the
+                    edited instances match
+
+          Args:     PCWSTR pszName
+                      Name of the format in the table
+                    const library::HeightMap& heightMap
+                      Height map to edit
+                    library::eInstanceFormat instanceFormat
+                      Format of the instances
+                    UINT uNumEdits
+                      Edits per frame
+                    UINT uNumFrames
+                      Number of frames
+
+          Returns:  BOOL
+                    TRUE if the counts match the height map and the
+                    edited instances match the rebuild
+        F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+        BOOL PrintEditStats(_In_ PCWSTR pszName, _In_ const library::HeightMap& heightMap, _In_ library::eInstanceFormat instanceFormat, _In_ UINT uNumEdits, _In_ UINT uNumFrames)
+        {
+            library::VoxelGrid grid(heightMap);
+            library::VoxelEditor editor(grid, instanceFormat, TRUE);
+            const UINT uStride = library::InstancedRenderable::GetInstanceStride(instanceFormat);
+
+            std::vector<std::shared_ptr<library::Voxel>> aVoxels;
+            std::vector<library::VoxelInstanceStats> aStats;
+            Stopwatch stopwatch;
+            editor.Build(aVoxels, aStats);
+            DOUBLE rebuildTime = stopwatch.GetElapsedMilliseconds();
+            BOOL bStatsMatch = MatchesHeightMap(aStats, heightMap);
+
+            UINT64 uRebuildBytes = 0u;
+            for (const std::shared_ptr<library::Voxel>& voxel : aVoxels)
+            {
+                uRebuildBytes += static_cast<UINT64>(voxel->GetNumInstances()) * uStride;
+                voxel->ClearDirtyInstances();
+            }
+
+            // Edits of a frame, then the ranges the voxels would upload at the end of it
+            std::mt19937 generator(EDIT_SEED);
+            std::vector<library::InstanceRange> aRanges;
+            DOUBLE editTime = 0.0;
+            UINT64 uNumUpdates = 0u;
+            UINT64 uUploadBytes = 0u;
+            for (UINT uFrame = 0u; uFrame < uNumFrames; ++uFrame)
+            {
+                stopwatch.Restart();
+                for (UINT uEdit = 0u; uEdit < uNumEdits; ++uEdit)
+                {
+                    EditRandomBlock(editor, heightMap, generator);
+                }
+
+                for (const std::shared_ptr<library::Voxel>& voxel : aVoxels)
+                {
+                    voxel->BuildDirtyRanges(aRanges);
+                    for (const library::InstanceRange& range : aRanges)
+                    {
+                        uUploadBytes += static_cast<UINT64>(range.uCount) * uStride;
+                    }
+                    uNumUpdates += aRanges.size();
+                    voxel->ClearDirtyInstances();
+                }
+                editTime += stopwatch.GetElapsedMilliseconds();
+            }
+
+            UINT64 uNumEdited = 0u;
+            for (const std::shared_ptr<library::Voxel>& voxel : aVoxels)
+            {
+                uNumEdited += voxel->GetNumInstances();
+            }
+
+            std::vector<std::shared_ptr<library::Voxel>> aRebuiltVoxels;
+            editor.Build(aRebuiltVoxels, aStats);
+
+            UINT64 uNumRebuilt = 0u;
+            for (const std::shared_ptr<library::Voxel>& voxel : aRebuiltVoxels)
+            {
+                uNumRebuilt += voxel->GetNumInstances();
+            }
+
+            // The kept blocks of the rebuild are its instances
+            UINT64 uNumKept = 0u;
+            for (const library::VoxelInstanceStats& stats : aStats)
+            {
+                uNumKept += stats.uNumKept;
+            }
+            BOOL bMatch = bStatsMatch && uNumEdited == uNumRebuilt && uNumKept == uNumRebuilt;
+
+            const DOUBLE frames = static_cast<DOUBLE>(uNumFrames);
+            wprintf(L"%-8ls %10.2f %10.2f | %10.3f %10.1f %10.1f   %ls\n",
+                pszName, rebuildTime, static_cast<DOUBLE>(uRebuildBytes) / (1024.0 * 1024.0),
+                editTime / frames, static_cast<DOUBLE>(uNumUpdates) / frames, static_cast<DOUBLE>(uUploadBytes) / (1024.0 * frames),
+                bMatch ? L"matches rebuild" : L"MISMATCH");
+
+            return bMatch;
+        }
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: RunBenchEdit
+
+      Summary:  Edits random surface blocks of the exposed instances of
+                a benchmark map, 1000 per frame by default, and
+                compares each frame with a full rebuild: the time on
+                the CPU, the UpdateSubresource calls of the dirty
+                ranges and the bytes uploaded, for both instance
+                formats
+
+      Args:     INT argc
+                  Number of arguments
+                PWSTR* argv
+                  [size] [editsPerFrame] [frames]
+
+      Returns:  INT
+                  0 on success
+    F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+    INT RunBenchEdit(_In_ INT argc, _In_reads_(argc) PWSTR* argv)
+    {
+        UINT uSize = 0u;
+        UINT uNumEdits = 0u;
+        UINT uNumFrames = 0u;
+        if (!ParseUint(argc, argv, 0, EDIT_DEFAULT_SIZE, uSize) || !ParseUint(argc, argv, 1, EDIT_DEFAULT_EDITS, uNumEdits) ||
+            !ParseUint(argc, argv, 2, EDIT_DEFAULT_FRAMES, uNumFrames) || uSize == 0u || uNumFrames == 0u)
+        {
+            wprintf(L"bench-edit [size] [editsPerFrame] [frames]\n");
+            return 1;
+        }
+
+        library::HeightMap heightMap = CreateBenchmarkMap(uSize);
+        wprintf(L"%ux%ux%u map, exposed instances, %u edits per frame for %u frames\n",
+            heightMap.GetWidth(), heightMap.GetHeight(), heightMap.GetDepth(), uNumEdits, uNumFrames);
+        wprintf(L"%-8ls %10ls %10ls | %10ls %10ls %10ls\n", L"format", L"rebuild ms", L"rebuild MB", L"edit ms", L"updates", L"upload KB");
+
+        BOOL bMatches = PrintEditStats(L"matrix", heightMap, library::eInstanceFormat::MATRIX, uNumEdits, uNumFrames);
+        bMatches = PrintEditStats(L"compact", heightMap, library::eInstanceFormat::COMPACT, uNumEdits, uNumFrames) && bMatches;
+
+        return bMatches ? 0 : 1;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,279 @@
+/*+===================================================================
+  File:      GENERATECOMMANDS.CPP
+
+  Summary:   Generation commands of the world tool: pregenerates the
+             binary height map the game loads at startup and measures
+             the density generator.
+
+  Functions: ParseUint, RunGenerate, RunBenchDensity
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+
+#include "Commands.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cwchar>
+#include <thread>
+
+#include "Scene/DensityGenerator.h"
+#include "Scene/TerrainGenerator.h"
+#include "Stopwatch.h"
+
+namespace worldtool
+{
+    namespace
+    {
+        constexpr const UINT GENERATE_DEFAULT_SIZE = 1024u;
+        constexpr const UINT GENERATE_DEFAULT_HEIGHT = 64u;
+        constexpr const UINT GENERATE_DEFAULT_SEED = 0u;
+
+        constexpr const UINT BENCH_DENSITY_DEFAULT_SIZE = 512u;
+        constexpr const UINT BENCH_DENSITY_DEFAULT_HEIGHT = 64u;
+        constexpr const UINT BENCH_DENSITY_RUNS = 3u;
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: serializeGrid
+
+          Summary:  Serializes every chunk of a grid, in order
+
+          Args:     const library::VoxelGrid& grid
+                      Grid to serialize
+
+          Returns:  std::vector<BYTE>
+                      Bytes of all the chunks
+        F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+        std::vector<BYTE> serializeGrid(_In_ const library::VoxelGrid& grid)
+        {
+            std::vector<BYTE> aBytes;
+            for (UINT uChunkZ = 0u; uChunkZ < grid.GetNumChunksZ(); ++uChunkZ)
+            {
+                for (UINT uChunkX = 0u; uChunkX < grid.GetNumChunksX(); ++uChunkX)
+                {
+                    grid.SerializeChunk(uChunkX, uChunkZ, aBytes);
+                }
+            }
+
+            return aBytes;
+        }
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: ParseUint
+
+      Summary:  Parses an optional positive argument
+
+      Args:     INT argc
+                  Number of arguments
+                PWSTR* argv
+                  Arguments
+                INT iIndex
+                  Index of the argument
+                UINT uDefault
+                  Value when the argument is missing
+                UINT& uOutValue
+                  Parsed value
+
+      Modifies: [uOutValue].
+
+      Returns:  BOOL
+                  FALSE if the argument is not a number
+    F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+    BOOL ParseUint(_In_ INT argc, _In_reads_(argc) PWSTR* argv, _In_ INT iIndex, _In_ UINT uDefault, _Out_ UINT& uOutValue)
+    {
+        uOutValue = uDefault;
+        if (iIndex >= argc)
+        {
+            return TRUE;
+        }
+
+        PWSTR pszEnd = nullptr;
+        uOutValue = static_cast<UINT>(wcstoul(argv[iIndex], &pszEnd, 10));
+
+        return pszEnd != argv[iIndex] && *pszEnd == L'\0';
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: RunGenerate
+
+      Summary:  Generates a size^2 world on all cores and writes it in
+                the binary format. The height channel uses the seed
+                and the moisture channel the next one
+
+      Args:     INT argc
+                  Number of arguments
+                PWSTR* argv
+                  <destination> [size] [height] [seed]
+
+      Returns:  INT
+                  0 on success
+    F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+    INT RunGenerate(_In_ INT argc, _In_reads_(argc) PWSTR* argv)
+    {
+        UINT uSize = 0u;
+        UINT uHeight = 0u;
+        UINT uSeed = 0u;
+        if (argc < 1 ||
+            !ParseUint(argc, argv, 1, GENERATE_DEFAULT_SIZE, uSize) ||
+            !ParseUint(argc, argv, 2, GENERATE_DEFAULT_HEIGHT, uHeight) ||
+            !ParseUint(argc, argv, 3, GENERATE_DEFAULT_SEED, uSeed))
+        {
+            wprintf(L"generate <destination> [size] [height] [seed]\n");
+            return 1;
+        }
+
+        library::TerrainDesc desc =
+        {
+            .uWidth = uSize,
+            .uHeight = uHeight,
+            .uDepth = uSize,
+            .uHeightSeed = uSeed,
+            .uMoistureSeed = uSeed + 1u,
+        };
+        library::TerrainGenerator generator(desc);
+
+        Stopwatch stopwatch;
+        library::HeightMap heightMap;
+        HRESULT hr = generator.Generate(heightMap);
+        if (FAILED(hr))
+        {
+            wprintf(L"Failed to generate a %ux%ux%u world (0x%08lX)\n", uSize, uHeight, uSize, static_cast<ULONG>(hr));
+            return 1;
+        }
+        DOUBLE generateTime = stopwatch.GetElapsedMilliseconds();
+
+        stopwatch.Restart();
+        hr = heightMap.SaveToBinary(argv[0]);
+        if (FAILED(hr))
+        {
+            wprintf(L"Failed to save %ls (0x%08lX)\n", argv[0], static_cast<ULONG>(hr));
+            return 1;
+        }
+        DOUBLE saveTime = stopwatch.GetElapsedMilliseconds();
+
+        wprintf(L"Generated %ux%ux%u world, %u tiles, in %.1f ms, saved %ls in %.1f ms\n",
+            uSize, uHeight, uSize, generator.GetNumTilesX() * generator.GetNumTilesZ(),
+            generateTime, argv[0], saveTime);
+
+        return 0;
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: RunBenchDensity
+
+      Summary:  Generates a size^2 density grid on one core and on all
+                cores and reports the throughput in voxels per second
+                per core. Checks that the grid only depends on the
+                seed, whatever the number of cores, and counts the
+                blocks, the columns with air under a block, the cave
+                worms and the runs of the result
+
+      Args:     INT argc
+                  Number of arguments
+                PWSTR* argv
+                  [size] [height]
+
+      Returns:  INT
+                  0 on success
+    F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+    INT RunBenchDensity(_In_ INT argc, _In_reads_(argc) PWSTR* argv)
+    {
+        UINT uSize = 0u;
+        UINT uHeight = 0u;
+        if (!ParseUint(argc, argv, 0, BENCH_DENSITY_DEFAULT_SIZE, uSize) ||
+            !ParseUint(argc, argv, 1, BENCH_DENSITY_DEFAULT_HEIGHT, uHeight))
+        {
+            wprintf(L"bench-density [size] [height]\n");
+            return 1;
+        }
+
+        library::DensityDesc desc =
+        {
+            .uWidth = uSize,
+            .uHeight = uHeight,
+            .uDepth = uSize,
+            .uSeed = GENERATE_DEFAULT_SEED,
+        };
+
+        Stopwatch stopwatch;
+        library::DensityGenerator generator(desc);
+        DOUBLE traceTime = stopwatch.GetElapsedMilliseconds();
+
+        std::unique_ptr<library::VoxelGrid> serialGrid;
+        std::unique_ptr<library::VoxelGrid> parallelGrid;
+        DOUBLE serialTime = MeasureBest(BENCH_DENSITY_RUNS, [&]() { return SUCCEEDED(generator.Generate(serialGrid, FALSE)); });
+        DOUBLE parallelTime = MeasureBest(BENCH_DENSITY_RUNS, [&]() { return SUCCEEDED(generator.Generate(parallelGrid, TRUE)); });
+        if (serialTime < 0.0 || parallelTime < 0.0)
+        {
+            wprintf(L"Failed to generate a %ux%ux%u grid\n", uSize, uHeight, uSize);
+            return 1;
+        }
+
+        // A second generator of the same seed traces its own worms
+        library::DensityGenerator sameSeedGenerator(desc);
+        std::unique_ptr<library::VoxelGrid> sameSeedGrid;
+        sameSeedGenerator.Generate(sameSeedGrid, TRUE);
+
+        library::DensityDesc otherDesc = desc;
+        otherDesc.uSeed = desc.uSeed + 1u;
+        library::DensityGenerator otherSeedGenerator(otherDesc);
+        std::unique_ptr<library::VoxelGrid> otherSeedGrid;
+        otherSeedGenerator.Generate(otherSeedGrid, TRUE);
+
+        std::vector<BYTE> aSerialBytes = serializeGrid(*serialGrid);
+        BOOL bDeterministic = aSerialBytes == serializeGrid(*parallelGrid) && aSerialBytes == serializeGrid(*sameSeedGrid);
+        BOOL bSeedChanges = aSerialBytes != serializeGrid(*otherSeedGrid);
+
+        UINT64 uNumBlocks = 0u;
+        UINT64 uNumSurfaceBlocks = 0u;
+        UINT64 uNumOverhangColumns = 0u;
+        UINT64 uNumRuns = 0u;
+        std::vector<library::VoxelRun> aRuns;
+        for (UINT z = 0u; z < uSize; ++z)
+        {
+            for (UINT x = 0u; x < uSize; ++x)
+            {
+                parallelGrid->GetColumnRuns(x, z, aRuns);
+                BOOL bOverhang = FALSE;
+                UINT uRunStart = 0u;
+                for (const library::VoxelRun& run : aRuns)
+                {
+                    if (run.blockType == library::HeightMap::EMPTY_BLOCK)
+                    {
+                        bOverhang = TRUE;
+                    }
+                    else
+                    {
+                        uNumBlocks += run.uEnd - uRunStart;
+                    }
+                    uRunStart = run.uEnd;
+                }
+                uNumSurfaceBlocks += aRuns.empty() ? 0u : aRuns.back().uEnd;
+                uNumOverhangColumns += bOverhang ? 1u : 0u;
+                uNumRuns += aRuns.size();
+            }
+        }
+
+        const UINT uNumCores = std::max(std::thread::hardware_concurrency(), 1u);
+        const DOUBLE numVoxels = static_cast<DOUBLE>(uSize) * uSize * uHeight;
+        const UINT64 uNumColumns = static_cast<UINT64>(uSize) * uSize;
+
+        wprintf(L"Density %ux%ux%u, seed %u, %u chunks, %u cores, lattice every %u blocks\n",
+            uSize, uHeight, uSize, desc.uSeed, parallelGrid->GetNumChunksX() * parallelGrid->GetNumChunksZ(), uNumCores, library::DensityGenerator::LATTICE_STEP);
+        wprintf(L"Cave worms: %u worms, %llu spheres, traced in %.2f ms\n",
+            generator.GetNumCaveWorms(), static_cast<UINT64>(generator.GetNumCaveSpheres()), traceTime);
+        wprintf(L"%-10ls %10ls %14ls %18ls\n", L"run", L"ms", L"Mvoxels/s", L"Mvoxels/s/core");
+        wprintf(L"%-10ls %10.2f %14.1f %18.1f\n", L"serial", serialTime, numVoxels / serialTime / 1000.0, numVoxels / serialTime / 1000.0);
+        wprintf(L"%-10ls %10.2f %14.1f %18.1f\n", L"parallel", parallelTime, numVoxels / parallelTime / 1000.0, numVoxels / parallelTime / 1000.0 / uNumCores);
+        wprintf(L"Speedup: %.2fx on %u cores\n", serialTime / parallelTime, uNumCores);
+        wprintf(L"Blocks: %llu solid (%.1f%% of the voxels), %llu air below the column tops (caves and overhangs)\n",
+            uNumBlocks, 100.0 * static_cast<DOUBLE>(uNumBlocks) / numVoxels, uNumSurfaceBlocks - uNumBlocks);
+        wprintf(L"Columns: %llu with air under a block (%.1f%%), %.2f runs per column, %.1f MB of chunks\n",
+            uNumOverhangColumns, 100.0 * static_cast<DOUBLE>(uNumOverhangColumns) / static_cast<DOUBLE>(uNumColumns),
+            static_cast<DOUBLE>(uNumRuns) / static_cast<DOUBLE>(uNumColumns), static_cast<DOUBLE>(parallelGrid->GetMemoryUsage()) / (1024.0 * 1024.0));
+        wprintf(L"Deterministic: %ls, next seed differs: %ls\n", bDeterministic ? L"yes" : L"NO", bSeedChanges ? L"yes" : L"NO");
+
+        return bDeterministic && bSeedChanges ? 0 : 1;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,180 @@
+/*+===================================================================
+  File:      HEIGHTMAPCOMMANDS.CPP
+
+  Summary:   Height map commands of the world tool: conversion between
+             the text and the binary formats, and load benchmarks.
+
+  Functions: RunConvert, RunBenchLoad
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+
+#include "Commands.h"
+
+#include <cstdio>
+#include <fstream>
+
+#include "BenchmarkMap.h"
+#include "Scene/HeightMap.h"
+#include "Stopwatch.h"
+
+namespace worldtool
+{
+    namespace
+    {
+        constexpr const UINT BENCH_MAP_SIZES[] = { 256u, 1024u, 4096u };
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: LoadWithStream
+
+          Summary:  Parses the text height map with std::ifstream the
+                    way Scene did before the HeightMap class, used as
+                    the baseline of the load benchmark
+
+          Args:     const std::filesystem::path& filePath
+                      Path to the text height map
+
+          Returns:  size_t
+                      Number of parsed cells
+        F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+        size_t LoadWithStream(_In_ const std::filesystem::path& filePath)
+        {
+            std::ifstream inputFile(filePath);
+
+            UINT aDimension[4] = { 0u, };
+            for (UINT& uDimension : aDimension)
+            {
+                inputFile >> uDimension;
+            }
+
+            XMFLOAT4 color(0.0f, 0.0f, 0.0f, 1.0f);
+            for (UINT uColorIdx = 0u; uColorIdx < aDimension[3]; ++uColorIdx)
+            {
+                inputFile >> color.x >> color.y >> color.z;
+            }
+
+            std::vector<CHAR> aBlockTypes;
+            std::vector<FLOAT> aHeights;
+            aBlockTypes.reserve(static_cast<size_t>(aDimension[0]) * static_cast<size_t>(aDimension[2]));
+            aHeights.reserve(aBlockTypes.capacity());
+
+            CHAR voxelType;
+            FLOAT height;
+            while (inputFile >> voxelType >> height)
+            {
+                aBlockTypes.push_back(voxelType);
+                aHeights.push_back(height);
+            }
+
+            return aBlockTypes.size();
+        }
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: RunConvert
+
+      Summary:  Converts a height map to the text or the binary format.
+                The destination format defaults to binary
+
+      Args:     INT argc
+                  Number of arguments
+                PWSTR* argv
+                  <source> <destination> [text|binary]
+
+      Returns:  INT
+                  0 on success
+    F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+    INT RunConvert(_In_ INT argc, _In_reads_(argc) PWSTR* argv)
+    {
+        if (argc < 2)
+        {
+            wprintf(L"convert <source> <destination> [text|binary]\n");
+            return 1;
+        }
+
+        library::eHeightMapFormat format = library::eHeightMapFormat::BINARY;
+        if (argc > 2 && wcscmp(argv[2], L"text") == 0)
+        {
+            format = library::eHeightMapFormat::TEXT;
+        }
+
+        Stopwatch stopwatch;
+        HRESULT hr = library::HeightMap::Convert(argv[0], argv[1], format);
+        if (FAILED(hr))
+        {
+            wprintf(L"Failed to convert %ls (0x%08lX)\n", argv[0], static_cast<ULONG>(hr));
+            return 1;
+        }
+
+        wprintf(L"Converted %ls to %ls in %.3f ms\n", argv[0], argv[1], stopwatch.GetElapsedMilliseconds());
+
+        return 0;
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: RunBenchLoad
+
+      Summary:  Writes 256^2, 1024^2 and 4096^2 height maps in both
+                formats and compares the stream-based text loader, the
+                from_chars text loader and the memory-mapped binary
+                loader
+
+      Args:     INT argc
+                  Number of arguments
+                PWSTR* argv
+                  [directory] where the height maps are written
+
+      Returns:  INT
+                  0 on success
+    F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+    INT RunBenchLoad(_In_ INT argc, _In_reads_(argc) PWSTR* argv)
+    {
+        std::filesystem::path directory = argc > 0 ? std::filesystem::path(argv[0]) : std::filesystem::temp_directory_path();
+
+        wprintf(L"%10ls %12ls %12ls %12ls %12ls %12ls %9ls\n", L"size", L"text bytes", L"binary bytes", L"stream ms", L"text ms", L"binary ms", L"speedup");
+
+        for (UINT uSize : BENCH_MAP_SIZES)
+        {
+            std::filesystem::path textPath = directory / (L"HeightMap" + std::to_wstring(uSize) + L".txt");
+            std::filesystem::path binaryPath = directory / (L"HeightMap" + std::to_wstring(uSize) + L".hmap");
+
+            {
+                library::HeightMap heightMap = CreateBenchmarkMap(uSize);
+                if (FAILED(heightMap.SaveToText(textPath)) || FAILED(heightMap.SaveToBinary(binaryPath)))
+                {
+                    wprintf(L"Failed to write the %ux%u height maps to %ls\n", uSize, uSize, directory.c_str());
+                    return 1;
+                }
+            }
+
+            UINT uNumRuns = uSize >= 4096u ? 1u : 5u;
+            size_t uNumCells = static_cast<size_t>(uSize) * static_cast<size_t>(uSize);
+
+            DOUBLE streamTime = MeasureBest(uNumRuns, [&]() { return LoadWithStream(textPath) == uNumCells; });
+            DOUBLE textTime = MeasureBest(uNumRuns, [&]()
+            {
+                library::HeightMap heightMap;
+                return SUCCEEDED(heightMap.LoadFromText(textPath));
+            });
+            DOUBLE binaryTime = MeasureBest(uNumRuns, [&]()
+            {
+                library::HeightMap heightMap;
+                return SUCCEEDED(heightMap.LoadFromBinary(binaryPath));
+            });
+
+            if (streamTime < 0.0 || textTime < 0.0 || binaryTime < 0.0)
+            {
+                wprintf(L"Failed to load the %ux%u height maps\n", uSize, uSize);
+                return 1;
+            }
+
+            wprintf(L"%4ux%-5u %12llu %12llu %12.3f %12.3f %12.3f %8.1fx\n",
+                uSize, uSize,
+                static_cast<ULONGLONG>(std::filesystem::file_size(textPath)),
+                static_cast<ULONGLONG>(std::filesystem::file_size(binaryPath)),
+                streamTime, textTime, binaryTime, streamTime / binaryTime);
+        }
+
+        return 0;
+    }
+}
\ No newline at end of file
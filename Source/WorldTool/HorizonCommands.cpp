@@ -0,0 +1,387 @@
+/*+===================================================================
+  File:      HORIZONCOMMANDS.CPP
+
+  Summary:   Horizon culling commands of the world tool: replays
+             camera paths over a height map and reports the chunks,
+             columns and block instances hidden behind the terrain,
+             checking with raycasts that nothing culled can be seen.
+
+  Functions: RunBenchHorizon
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+
+#include "Commands.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <random>
+
+#include "BenchmarkMap.h"
+#include "Scene/VoxelHorizonCuller.h"
+#include "Stopwatch.h"
+
+namespace worldtool
+{
+    namespace
+    {
+        constexpr const UINT HORIZON_DEFAULT_SIZE = 512u;
+        constexpr const UINT HORIZON_PATH_FRAMES = 300u;
+        constexpr const UINT HORIZON_SEED = 0u;
+        constexpr const UINT HORIZON_NUM_EDITS = 1000u;
+
+        // Frames whose culled columns are checked with raycasts, and columns checked per frame
+        constexpr const UINT HORIZON_CHECK_INTERVAL = 25u;
+        constexpr const UINT HORIZON_CHECKED_COLUMNS = 2000u;
+
+        // Points of the top of a column aimed at, its center and 4 corners slightly inside it, in cells
+        constexpr const FLOAT HORIZON_CHECK_POINTS[5][2] =
+        {
+            { 0.5f, 0.5f }, { 0.05f, 0.05f }, { 0.95f, 0.05f }, { 0.05f, 0.95f }, { 0.95f, 0.95f },
+        };
+
+        /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+            Struct:   CameraPath
+
+            Summary:  Camera positions of one path in world space, one
+                      per frame
+        S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+        struct CameraPath
+        {
+            PCWSTR pszName;
+            std::vector<XMFLOAT3> aEyes;
+        };
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+
+          Function: getEyeOverCell
+
+          Summary:  Places the camera over a cell, above the highest of
+                    the columns around it
+
+          Args:     const library::VoxelGrid& grid
+                      Grid the camera moves over
+                    const library::HeightMap& heightMap
+                      Heights of the columns
+                    FLOAT x
+                    FLOAT z
+                      Position in cells
+                    FLOAT height
+                      Height over the columns in cells
+
+          Returns:  XMFLOAT3
+                      Position of the camera in world space
+
+        F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+        XMFLOAT3 getEyeOverCell(_In_ const library::VoxelGrid& grid, _In_ const library::HeightMap& heightMap, _In_ FLOAT x, _In_ FLOAT z, _In_ FLOAT height)
+        {
+            const INT iX = static_cast<INT>(x);
+            const INT iZ = static_cast<INT>(z);
+            UINT uTop = 0u;
+            for (INT iNeighborZ = std::max(iZ - 1, 0); iNeighborZ <= std::min(iZ + 1, static_cast<INT>(grid.GetDepth()) - 1); ++iNeighborZ)
+            {
+                for (INT iNeighborX = std::max(iX - 1, 0); iNeighborX <= std::min(iX + 1, static_cast<INT>(grid.GetWidth()) - 1); ++iNeighborX)
+                {
+                    uTop = std::max(uTop, heightMap.GetColumnHeight(static_cast<UINT>(iNeighborX), static_cast<UINT>(iNeighborZ)));
+                }
+            }
+
+            const XMFLOAT3& origin = grid.GetOrigin();
+            return XMFLOAT3(
+                origin.x + x * library::VoxelGrid::CELL_SIZE,
+                origin.y + (static_cast<FLOAT>(uTop) + height) * library::VoxelGrid::CELL_SIZE,
+                origin.z + z * library::VoxelGrid::CELL_SIZE
+            );
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+
+          Function: createPaths
+
+          Summary:  Scripts the camera paths over the map: a walk along
+                    the diagonal at eye height, a low flight around the
+                    center and a high orbit above the tallest column
+
+          Args:     const library::VoxelGrid& grid
+                      Grid the camera moves over
+                    const library::HeightMap& heightMap
+                      Heights of the columns
+
+          Returns:  std::vector<CameraPath>
+                      Paths of HORIZON_PATH_FRAMES frames
+
+        F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+        std::vector<CameraPath> createPaths(_In_ const library::VoxelGrid& grid, _In_ const library::HeightMap& heightMap)
+        {
+            const FLOAT width = static_cast<FLOAT>(grid.GetWidth());
+            const FLOAT depth = static_cast<FLOAT>(grid.GetDepth());
+            const FLOAT orbitHeight = static_cast<FLOAT>(grid.GetHeight()) + 16.0f;
+
+            std::vector<CameraPath> aPaths =
+            {
+                { .pszName = L"walk" },
+                { .pszName = L"flight" },
+                { .pszName = L"orbit" },
+            };
+            for (UINT uFrame = 0u; uFrame < HORIZON_PATH_FRAMES; ++uFrame)
+            {
+                const FLOAT t = static_cast<FLOAT>(uFrame) / static_cast<FLOAT>(HORIZON_PATH_FRAMES);
+                const FLOAT angle = 2.0f * XM_PI * t;
+
+                aPaths[0].aEyes.push_back(getEyeOverCell(grid, heightMap, (0.1f + 0.8f * t) * width, (0.1f + 0.8f * t) * depth, 1.5f));
+                aPaths[1].aEyes.push_back(getEyeOverCell(grid, heightMap, (0.5f + 0.3f * std::cos(angle)) * width, (0.5f + 0.3f * std::sin(angle)) * depth, 8.0f));
+
+                XMFLOAT3 orbitEye = getEyeOverCell(grid, heightMap, (0.5f + 0.45f * std::cos(angle)) * width, (0.5f + 0.45f * std::sin(angle)) * depth, 0.0f);
+                orbitEye.y = grid.GetOrigin().y + orbitHeight * library::VoxelGrid::CELL_SIZE;
+                aPaths[2].aEyes.push_back(orbitEye);
+            }
+
+            return aPaths;
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+
+          Function: loadPath
+
+          Summary:  Reads a recorded camera path, one "x y z" position
+                    in world space per line
+
+          Args:     PCWSTR pszFileName
+                      Path file
+                    CameraPath& outPath
+                      Path read
+
+          Returns:  BOOL
+                      TRUE when at least one position was read
+
+        F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+        BOOL loadPath(_In_ PCWSTR pszFileName, _Out_ CameraPath& outPath)
+        {
+            outPath = CameraPath{ .pszName = L"recorded" };
+
+            std::ifstream file{ std::filesystem::path(pszFileName) };
+            XMFLOAT3 eye;
+            while (file >> eye.x >> eye.y >> eye.z)
+            {
+                outPath.aEyes.push_back(eye);
+            }
+
+            return !outPath.aEyes.empty();
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+
+          Function: countVisibleCulledColumns
+
+          Summary:  Casts rays from the camera to the top of culled
+                    columns. A ray that reaches its column, or nothing,
+                    proves the column could be seen
+
+          Args:     const library::VoxelGrid& grid
+                      Grid of the culler
+                    const library::HeightMap& heightMap
+                      Heights of the columns
+                    const library::VoxelHorizonCuller& culler
+                      Culler after a cull from the eye
+                    const XMFLOAT3& eye
+                      Position of the camera
+                    std::mt19937& random
+                      Picks the checked columns
+                    UINT64& uNumRays
+                      Incremented by the rays cast
+
+          Returns:  UINT64
+                      Number of culled columns reached by a ray
+
+        F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+        UINT64 countVisibleCulledColumns(
+            _In_ const library::VoxelGrid& grid,
+            _In_ const library::HeightMap& heightMap,
+            _In_ const library::VoxelHorizonCuller& culler,
+            _In_ const XMFLOAT3& eye,
+            _Inout_ std::mt19937& random,
+            _Inout_ UINT64& uNumRays
+        )
+        {
+            std::vector<XMUINT2> aColumns;
+            for (UINT z = 0u; z < grid.GetDepth(); ++z)
+            {
+                for (UINT x = 0u; x < grid.GetWidth(); ++x)
+                {
+                    if (!culler.IsTileVisible(0u, x, z) && heightMap.GetColumnHeight(x, z) > 0u)
+                    {
+                        aColumns.emplace_back(x, z);
+                    }
+                }
+            }
+            std::shuffle(aColumns.begin(), aColumns.end(), random);
+            aColumns.resize(std::min<size_t>(aColumns.size(), HORIZON_CHECKED_COLUMNS));
+
+            const XMFLOAT3& origin = grid.GetOrigin();
+            std::vector<library::VoxelRay> aRays;
+            for (const XMUINT2& column : aColumns)
+            {
+                const FLOAT top = static_cast<FLOAT>(heightMap.GetColumnHeight(column.x, column.y)) - 0.01f;
+                for (const FLOAT (&point)[2] : HORIZON_CHECK_POINTS)
+                {
+                    XMFLOAT3 target(
+                        origin.x + (static_cast<FLOAT>(column.x) + point[0]) * library::VoxelGrid::CELL_SIZE,
+                        origin.y + top * library::VoxelGrid::CELL_SIZE,
+                        origin.z + (static_cast<FLOAT>(column.y) + point[1]) * library::VoxelGrid::CELL_SIZE
+                    );
+                    XMFLOAT3 direction(target.x - eye.x, target.y - eye.y, target.z - eye.z);
+                    aRays.push_back(
+                        library::VoxelRay
+                        {
+                            .origin = eye,
+                            .direction = direction,
+                            .maxDistance = std::sqrt(direction.x * direction.x + direction.y * direction.y + direction.z * direction.z),
+                        }
+                    );
+                }
+            }
+
+            std::vector<library::VoxelRayHit> aHits;
+            grid.RaycastBatch(aRays, aHits);
+            uNumRays += aRays.size();
+
+            UINT64 uNumVisible = 0u;
+            const size_t uNumPoints = std::size(HORIZON_CHECK_POINTS);
+            for (size_t uColumn = 0u; uColumn < aColumns.size(); ++uColumn)
+            {
+                BOOL bVisible = FALSE;
+                for (size_t uPoint = 0u; uPoint < uNumPoints; ++uPoint)
+                {
+                    const library::VoxelRayHit& hit = aHits[uColumn * uNumPoints + uPoint];
+                    bVisible |= !hit.bHit || (hit.uX == aColumns[uColumn].x && hit.uZ == aColumns[uColumn].y);
+                }
+                uNumVisible += bVisible ? 1u : 0u;
+            }
+
+            return uNumVisible;
+        }
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: RunBenchHorizon
+
+      Summary:  Builds the min/max quadtree of the given height map, or
+                of a size^2 benchmark map, and replays a recorded
+                camera path, or a scripted walk, flight and orbit. For
+                every path prints the share of chunks, columns and
+                block instances culled and the time of a chunk only
+                cull and of a cull down to the columns. Every few
+                frames, rays are cast at the culled columns to check
+                that none of them can be seen. Then times the refresh
+                of the quadtree after single block edits
+
+      Args:     INT argc
+                  Number of arguments
+                PWSTR* argv
+                  [heightmap|size] [path]
+
+      Returns:  INT
+                  0 on success, 1 when a culled column can be seen
+    F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+    INT RunBenchHorizon(_In_ INT argc, _In_reads_(argc) PWSTR* argv)
+    {
+        UINT uSize = 0u;
+        library::HeightMap heightMap;
+        if (ParseUint(argc, argv, 0, HORIZON_DEFAULT_SIZE, uSize) && uSize > 0u)
+        {
+            heightMap = CreateBenchmarkMap(uSize);
+        }
+        else if (FAILED(heightMap.LoadFromFile(argv[0])))
+        {
+            wprintf(L"bench-horizon [heightmap|size] [path]\n");
+            return 1;
+        }
+
+        library::VoxelGrid grid(heightMap);
+        library::VoxelHorizonCuller culler(grid);
+
+        Stopwatch stopwatch;
+        culler.Build();
+        wprintf(L"Built %u levels over %ux%u columns in %.1f ms, %u horizon bins\n",
+            culler.GetNumLevels(), grid.GetWidth(), grid.GetDepth(), stopwatch.GetElapsedMilliseconds(), library::VoxelHorizonCuller::NUM_HORIZON_BINS);
+
+        std::vector<CameraPath> aPaths;
+        if (argc > 1)
+        {
+            aPaths.emplace_back();
+            if (!loadPath(argv[1], aPaths.back()))
+            {
+                wprintf(L"Failed to read a camera path from %ls\n", argv[1]);
+                return 1;
+            }
+        }
+        else
+        {
+            aPaths = createPaths(grid, heightMap);
+        }
+
+        std::mt19937 random(HORIZON_SEED);
+        UINT64 uNumVisibleCulled = 0u;
+        wprintf(L"%-10ls %7ls %8ls %8ls %8ls %11ls %11ls %9ls %9ls\n",
+            L"path", L"frames", L"chunks", L"columns", L"blocks", L"chunks ms", L"columns ms", L"max ms", L"checked");
+        for (const CameraPath& path : aPaths)
+        {
+            DOUBLE chunkTime = 0.0;
+            DOUBLE columnTime = 0.0;
+            DOUBLE maxColumnTime = 0.0;
+            DOUBLE culledChunks = 0.0;
+            DOUBLE culledColumns = 0.0;
+            DOUBLE culledBlocks = 0.0;
+            UINT64 uNumRays = 0u;
+            UINT64 uNumChecked = 0u;
+            for (UINT uFrame = 0u; uFrame < path.aEyes.size(); ++uFrame)
+            {
+                const XMVECTOR eye = XMLoadFloat3(&path.aEyes[uFrame]);
+
+                culler.Cull(eye, FALSE);
+                chunkTime += culler.GetStats().cullTime * 1000.0;
+
+                culler.Cull(eye, TRUE);
+                const library::VoxelHorizonStats& stats = culler.GetStats();
+                columnTime += stats.cullTime * 1000.0;
+                maxColumnTime = std::max(maxColumnTime, stats.cullTime * 1000.0);
+                culledChunks += static_cast<DOUBLE>(stats.uNumCulledChunks) / static_cast<DOUBLE>(stats.uNumChunks);
+                culledColumns += static_cast<DOUBLE>(stats.uNumCulledColumns) / static_cast<DOUBLE>(stats.uNumColumns);
+                culledBlocks += static_cast<DOUBLE>(stats.uNumCulledBlocks) / static_cast<DOUBLE>(std::max<UINT64>(stats.uNumBlocks, 1u));
+
+                if (uFrame % HORIZON_CHECK_INTERVAL == 0u)
+                {
+                    uNumVisibleCulled += countVisibleCulledColumns(grid, heightMap, culler, path.aEyes[uFrame], random, uNumRays);
+                    uNumChecked += std::min<UINT64>(stats.uNumCulledColumns, HORIZON_CHECKED_COLUMNS);
+                }
+            }
+
+            const DOUBLE frames = static_cast<DOUBLE>(path.aEyes.size());
+            wprintf(L"%-10ls %7zu %7.1f%% %7.1f%% %7.1f%% %11.3f %11.3f %9.3f %9llu\n",
+                path.pszName, path.aEyes.size(), 100.0 * culledChunks / frames, 100.0 * culledColumns / frames, 100.0 * culledBlocks / frames,
+                chunkTime / frames, columnTime / frames, maxColumnTime, uNumChecked);
+        }
+        wprintf(L"Culled columns reached by a ray: %llu   %ls\n", uNumVisibleCulled, uNumVisibleCulled == 0u ? L"ok" : L"NOT CONSERVATIVE");
+
+        // Digging the top block of random columns, as the editor does
+        std::vector<library::VoxelRun> aRuns;
+        stopwatch.Restart();
+        for (UINT uEdit = 0u; uEdit < HORIZON_NUM_EDITS; ++uEdit)
+        {
+            UINT x = random() % grid.GetWidth();
+            UINT z = random() % grid.GetDepth();
+            grid.GetColumnRuns(x, z, aRuns);
+            if (!aRuns.empty() && aRuns.back().blockType == library::HeightMap::EMPTY_BLOCK && aRuns.size() > 1u)
+            {
+                grid.SetBlock(x, aRuns[aRuns.size() - 2u].uEnd - 1u, z, library::HeightMap::EMPTY_BLOCK);
+            }
+            culler.UpdateColumn(x, z);
+        }
+        wprintf(L"Edits: %u columns refreshed in %.3f ms, %.2f us each\n",
+            HORIZON_NUM_EDITS, stopwatch.GetElapsedMilliseconds(), stopwatch.GetElapsedMilliseconds() * 1000.0 / HORIZON_NUM_EDITS);
+
+        return uNumVisibleCulled == 0u ? 0 : 1;
+    }
+}
\ No newline at end of file
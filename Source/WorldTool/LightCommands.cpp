@@ -0,0 +1,257 @@
+/*+===================================================================
+  File:      LIGHTCOMMANDS.CPP
+
+  Summary:   Light commands of the world tool: measures the full bake
+             of the sky and block light of a generated density grid,
+             the cost of shaded meshes next to unshaded ones, and the
+             incremental relight after single block edits.
+
+  Functions: RunBenchLight
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+
+#include "Commands.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+
+#include "Scene/DensityGenerator.h"
+#include "Scene/VoxelChunkMesher.h"
+#include "Scene/VoxelLightMap.h"
+#include "Stopwatch.h"
+
+namespace worldtool
+{
+    namespace
+    {
+        constexpr const UINT BENCH_LIGHT_DEFAULT_SIZE = 512u;
+        constexpr const UINT BENCH_LIGHT_DEFAULT_LIGHTS = 256u;
+        constexpr const UINT BENCH_LIGHT_HEIGHT = 64u;
+        constexpr const UINT BENCH_LIGHT_RUNS = 3u;
+        constexpr const UINT BENCH_LIGHT_SEED = 0u;
+        constexpr const UINT BENCH_LIGHT_NUM_EDITS = 1000u;
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: countChunks
+
+          Summary:  Counts the chunks to mesh again after a relight, the
+                    ones that hold a changed cell or its neighbors, which
+                    read it for their faces and occlusion
+
+          Args:     const library::VoxelLightUpdate& update
+                      Cells changed by the relight
+                    const library::VoxelGrid& grid
+                      Grid of the light map
+
+          Returns:  UINT
+                      Number of chunks
+        F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+        UINT countChunks(_In_ const library::VoxelLightUpdate& update, _In_ const library::VoxelGrid& grid)
+        {
+            if (update.uMaxX <= update.uMinX)
+            {
+                return 0u;
+            }
+
+            constexpr const UINT CHUNK_SIZE = library::VoxelChunkMesher::CHUNK_SIZE;
+            auto countAxis = [](UINT uMin, UINT uMax, UINT uSize)
+            {
+                UINT uFirst = (uMin > 0u ? uMin - 1u : 0u) / CHUNK_SIZE;
+                UINT uLast = std::min(uMax, uSize - 1u) / CHUNK_SIZE;
+                return uLast - uFirst + 1u;
+            };
+
+            return countAxis(update.uMinX, update.uMaxX, grid.GetWidth()) *
+                countAxis(update.uMinY, update.uMaxY, grid.GetHeight()) *
+                countAxis(update.uMinZ, update.uMaxZ, grid.GetDepth());
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: countDifferentCells
+
+          Summary:  Compares the light of every cell of two light maps
+
+          Args:     const library::VoxelLightMap& lightMap
+                    const library::VoxelLightMap& otherLightMap
+                      Light maps of the same grid
+                    const library::VoxelGrid& grid
+                      Grid of the light maps
+
+          Returns:  UINT64
+                      Number of cells with another light
+        F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+        UINT64 countDifferentCells(_In_ const library::VoxelLightMap& lightMap, _In_ const library::VoxelLightMap& otherLightMap, _In_ const library::VoxelGrid& grid)
+        {
+            UINT64 uNumDifferent = 0u;
+            for (INT z = 0; z < static_cast<INT>(grid.GetDepth()); ++z)
+            {
+                for (INT x = 0; x < static_cast<INT>(grid.GetWidth()); ++x)
+                {
+                    for (INT y = 0; y < static_cast<INT>(grid.GetHeight()); ++y)
+                    {
+                        uNumDifferent += lightMap.GetLight(x, y, z) != otherLightMap.GetLight(x, y, z) ? 1u : 0u;
+                    }
+                }
+            }
+
+            return uNumDifferent;
+        }
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: RunBenchLight
+
+      Summary:  Generates a size^2 density grid, puts static lights in
+                random empty cells below the surface and bakes the sky
+                and block light on one core and on all cores. Meshes the
+                grid with and without shading, then digs and builds
+                single blocks, relighting after each edit, and checks
+                that the relit map matches a fresh bake
+
+      Args:     INT argc
+                  Number of arguments
+                PWSTR* argv
+                  [size] [lights]
+
+      Returns:  INT
+                  0 on success
+    F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+    INT RunBenchLight(_In_ INT argc, _In_reads_(argc) PWSTR* argv)
+    {
+        UINT uSize = 0u;
+        UINT uNumLights = 0u;
+        if (!ParseUint(argc, argv, 0, BENCH_LIGHT_DEFAULT_SIZE, uSize) || uSize == 0u ||
+            !ParseUint(argc, argv, 1, BENCH_LIGHT_DEFAULT_LIGHTS, uNumLights))
+        {
+            wprintf(L"bench-light [size] [lights]\n");
+            return 1;
+        }
+
+        std::unique_ptr<library::VoxelGrid> grid;
+        library::DensityGenerator generator(
+            library::DensityDesc
+            {
+                .uWidth = uSize,
+                .uHeight = BENCH_LIGHT_HEIGHT,
+                .uDepth = uSize,
+                .uSeed = BENCH_LIGHT_SEED,
+            }
+        );
+        if (FAILED(generator.Generate(grid)))
+        {
+            wprintf(L"Failed to generate a %ux%ux%u grid\n", uSize, BENCH_LIGHT_HEIGHT, uSize);
+            return 1;
+        }
+
+        library::VoxelLightMap lightMap(*grid);
+
+        // Lights go in the empty cells under the top block of their column, where only they shine
+        std::mt19937 random(BENCH_LIGHT_SEED);
+        std::vector<library::VoxelRun> aRuns;
+        std::vector<XMUINT4> aLights;
+        for (UINT uTry = 0u; uTry < uNumLights * 64u && aLights.size() < uNumLights; ++uTry)
+        {
+            UINT x = random() % grid->GetWidth();
+            UINT y = random() % grid->GetHeight();
+            UINT z = random() % grid->GetDepth();
+            grid->GetColumnRuns(x, z, aRuns);
+
+            UINT uTop = 0u;
+            for (const library::VoxelRun& run : aRuns)
+            {
+                uTop = run.blockType != library::HeightMap::EMPTY_BLOCK ? run.uEnd : uTop;
+            }
+
+            XMUINT4 light(x, y, z, 8u + random() % (library::VoxelLightMap::MAX_LIGHT - 7u));
+            if (y < uTop && grid->GetBlock(x, y, z) == library::HeightMap::EMPTY_BLOCK &&
+                SUCCEEDED(lightMap.AddLight(light.x, light.y, light.z, static_cast<BYTE>(light.w))))
+            {
+                aLights.push_back(light);
+            }
+        }
+
+        library::VoxelLightUpdate bake = {};
+        const DOUBLE serialTime = MeasureBest(BENCH_LIGHT_RUNS, [&]() { bake = lightMap.Bake(FALSE); return TRUE; });
+        const DOUBLE parallelTime = MeasureBest(BENCH_LIGHT_RUNS, [&]() { bake = lightMap.Bake(TRUE); return TRUE; });
+
+        const DOUBLE cells = static_cast<DOUBLE>(grid->GetWidth()) * grid->GetHeight() * grid->GetDepth();
+        wprintf(L"Grid %ux%ux%u, %u lights, %.1f MB of light map\n",
+            uSize, BENCH_LIGHT_HEIGHT, uSize, lightMap.GetNumLights(), static_cast<DOUBLE>(lightMap.GetMemoryUsage()) / (1024.0 * 1024.0));
+        wprintf(L"Bake: %.2f ms on one core, %.2f ms on all cores, %.1f Mcells/s, %llu lit cells, %llu cells flooded\n",
+            serialTime, parallelTime, cells / (parallelTime * 1000.0), bake.uNumChangedCells, bake.uNumVisitedCells);
+
+        std::vector<library::VoxelChunkMesh> aMeshes;
+        library::VoxelChunkMesher mesher(*grid, library::eVoxelMeshing::GREEDY);
+        const DOUBLE meshTime = MeasureBest(BENCH_LIGHT_RUNS, [&]() { mesher.MeshAll(aMeshes); return TRUE; });
+        const library::VoxelMeshStats meshStats = mesher.GetStats(aMeshes);
+
+        library::VoxelChunkMesher shadedMesher(*grid, library::eVoxelMeshing::GREEDY, lightMap);
+        const DOUBLE shadedMeshTime = MeasureBest(BENCH_LIGHT_RUNS, [&]() { shadedMesher.MeshAll(aMeshes); return TRUE; });
+        const library::VoxelMeshStats shadedMeshStats = shadedMesher.GetStats(aMeshes);
+
+        wprintf(L"Greedy mesh: %.2f ms, %llu vertices unshaded; %.2f ms, %llu vertices shaded (%.2fx), %llu bytes of shade\n",
+            meshTime, meshStats.uNumVertices, shadedMeshTime, shadedMeshStats.uNumVertices,
+            static_cast<DOUBLE>(shadedMeshStats.uNumVertices) / static_cast<DOUBLE>(std::max(meshStats.uNumVertices, static_cast<UINT64>(1u))),
+            shadedMeshStats.uNumVertices * sizeof(WORD));
+
+        // Dig out or build on the top block of random columns, and toggle random cells anywhere
+        DOUBLE totalRelightTime = 0.0;
+        DOUBLE maxRelightTime = 0.0;
+        UINT64 uNumChangedCells = 0u;
+        UINT64 uNumVisitedCells = 0u;
+        UINT64 uNumChunks = 0u;
+        UINT uMaxChunks = 0u;
+        for (UINT uEdit = 0u; uEdit < BENCH_LIGHT_NUM_EDITS; ++uEdit)
+        {
+            UINT x = random() % grid->GetWidth();
+            UINT z = random() % grid->GetDepth();
+            UINT y = random() % grid->GetHeight();
+            if ((uEdit & 1u) == 0u)
+            {
+                grid->GetColumnRuns(x, z, aRuns);
+                UINT uTop = 0u;
+                for (const library::VoxelRun& run : aRuns)
+                {
+                    uTop = run.blockType != library::HeightMap::EMPTY_BLOCK ? run.uEnd : uTop;
+                }
+                y = (random() & 1u) != 0u && uTop > 0u ? uTop - 1u : std::min(uTop, grid->GetHeight() - 1u);
+            }
+
+            CHAR blockType = grid->GetBlock(x, y, z) == library::HeightMap::EMPTY_BLOCK ?
+                static_cast<CHAR>(library::eBlockType::BARE) : library::HeightMap::EMPTY_BLOCK;
+            grid->SetBlock(x, y, z, blockType);
+
+            Stopwatch stopwatch;
+            library::VoxelLightUpdate update = lightMap.Relight(x, y, z);
+            DOUBLE relightTime = stopwatch.GetElapsedMilliseconds();
+
+            UINT uNumEditChunks = countChunks(update, *grid);
+            totalRelightTime += relightTime;
+            maxRelightTime = std::max(maxRelightTime, relightTime);
+            uNumChangedCells += update.uNumChangedCells;
+            uNumVisitedCells += update.uNumVisitedCells;
+            uNumChunks += uNumEditChunks;
+            uMaxChunks = std::max(uMaxChunks, uNumEditChunks);
+        }
+
+        // The relit map must match a bake of the edited grid with the same lights
+        library::VoxelLightMap bakedLightMap(*grid);
+        for (const XMUINT4& light : aLights)
+        {
+            bakedLightMap.AddLight(light.x, light.y, light.z, static_cast<BYTE>(light.w));
+        }
+        bakedLightMap.Bake();
+        const UINT64 uNumDifferentCells = countDifferentCells(lightMap, bakedLightMap, *grid);
+
+        const DOUBLE edits = static_cast<DOUBLE>(BENCH_LIGHT_NUM_EDITS);
+        wprintf(L"Relight: %u edits, %.1f us average, %.1f us max, %.0f cells changed and %.0f flooded per edit, %.1f chunks to mesh per edit (max %u)\n",
+            BENCH_LIGHT_NUM_EDITS, totalRelightTime * 1000.0 / edits, maxRelightTime * 1000.0,
+            static_cast<DOUBLE>(uNumChangedCells) / edits, static_cast<DOUBLE>(uNumVisitedCells) / edits,
+            static_cast<DOUBLE>(uNumChunks) / edits, uMaxChunks);
+        wprintf(L"Relit map against a fresh bake: %llu cells differ   %ls\n", uNumDifferentCells, uNumDifferentCells == 0u ? L"ok" : L"MISMATCH");
+
+        return uNumDifferentCells == 0u ? 0 : 1;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,152 @@
+/*+===================================================================
+  File:      LODCOMMANDS.CPP
+
+  Summary:   Level of detail commands of the world tool: builds the
+             voxel LOD tree and reports the geometry it selects from
+             several camera positions, and how many nodes change per
+             frame along a flight.
+
+  Functions: RunBenchLod
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+
+#include "Commands.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+
+#include "BenchmarkMap.h"
+#include "Scene/VoxelLodTree.h"
+#include "Stopwatch.h"
+
+namespace worldtool
+{
+    namespace
+    {
+        constexpr const UINT LOD_DEFAULT_SIZE = 1024u;
+        constexpr const UINT LOD_DEFAULT_ERROR = 2u;
+
+        // 1080 pixels high with the 45 degrees field of view of the renderer
+        constexpr const FLOAT LOD_VIEWPORT_HEIGHT = 1080.0f;
+        constexpr const FLOAT LOD_FIELD_OF_VIEW = 3.14159265f / 4.0f;
+
+        // 60 frames per second, flying at 120 units (60 blocks) per second
+        constexpr const FLOAT LOD_FLIGHT_SPEED = 120.0f / 60.0f;
+        constexpr const FLOAT LOD_FLIGHT_HEIGHT = 40.0f;
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: PrintSelection
+
+          Summary:  Selects the nodes seen from the camera and prints
+                    one row per level of detail and the total
+
+          Args:     PCWSTR pszName
+                      Name of the camera position
+                    library::VoxelLodTree& tree
+                      Built tree
+                    const XMVECTOR& eye
+                      Position of the camera
+                    FLOAT projectionScale
+                      Pixels covered by one world unit at a distance of
+                      one unit
+        F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+        void PrintSelection(_In_ PCWSTR pszName, _Inout_ library::VoxelLodTree& tree, _In_ const XMVECTOR& eye, _In_ FLOAT projectionScale)
+        {
+            std::vector<UINT> aNodeIndices;
+            Stopwatch stopwatch;
+            tree.Select(eye, projectionScale, aNodeIndices);
+            DOUBLE selectTime = stopwatch.GetElapsedMilliseconds();
+
+            const library::VoxelLodStats& stats = tree.GetStats();
+            library::VoxelLodLevelStats total = {};
+            for (UINT uLevel = 0u; uLevel < library::NUM_VOXEL_LOD_LEVELS; ++uLevel)
+            {
+                const library::VoxelLodLevelStats& level = stats.aLevels[uLevel];
+                wprintf(L"%-10ls %4ux %8llu %10llu %12llu\n", pszName, 1u << uLevel, level.uNumNodes, level.uNumDraws, level.uNumTriangles);
+
+                total.uNumNodes += level.uNumNodes;
+                total.uNumDraws += level.uNumDraws;
+                total.uNumTriangles += level.uNumTriangles;
+            }
+            wprintf(L"%-10ls %5ls %8llu %10llu %12llu   select %.3f ms\n", pszName, L"total", total.uNumNodes, total.uNumDraws, total.uNumTriangles, selectTime);
+        }
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: RunBenchLod
+
+      Summary:  Builds the LOD tree of the given height map, or of a
+                1024^2 benchmark map, and prints the nodes, draws and
+                triangles selected per level of detail at full detail,
+                and from the map center, its edge and above it. Then flies the
+                camera across the map at 60 frames per second and
+                reports the nodes refined or merged per frame
+
+      Args:     INT argc
+                  Number of arguments
+                PWSTR* argv
+                  [heightmap|size] [maxErrorPixels]
+
+      Returns:  INT
+                  0 on success
+    F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+    INT RunBenchLod(_In_ INT argc, _In_reads_(argc) PWSTR* argv)
+    {
+        UINT uSize = 0u;
+        UINT uMaxError = 0u;
+        library::HeightMap heightMap;
+        if (ParseUint(argc, argv, 0, LOD_DEFAULT_SIZE, uSize))
+        {
+            heightMap = CreateBenchmarkMap(uSize);
+        }
+        else if (FAILED(heightMap.LoadFromFile(argv[0])))
+        {
+            wprintf(L"Failed to load %ls\n", argv[0]);
+            return 1;
+        }
+
+        if (!ParseUint(argc, argv, 1, LOD_DEFAULT_ERROR, uMaxError) || uMaxError == 0u)
+        {
+            wprintf(L"bench-lod [heightmap|size] [maxErrorPixels]\n");
+            return 1;
+        }
+
+        library::VoxelLodTree tree(heightMap, library::eVoxelMeshing::GREEDY, static_cast<FLOAT>(uMaxError));
+
+        Stopwatch stopwatch;
+        tree.Build();
+        wprintf(L"Built %u nodes of %ux%u columns in %.1f ms, at most %u pixels of error at %.0f pixels high\n",
+            tree.GetNumNodes(), heightMap.GetWidth(), heightMap.GetDepth(), stopwatch.GetElapsedMilliseconds(), uMaxError, LOD_VIEWPORT_HEIGHT);
+
+        const FLOAT projectionScale = LOD_VIEWPORT_HEIGHT / (2.0f * std::tan(LOD_FIELD_OF_VIEW / 2.0f));
+        const FLOAT halfWidth = static_cast<FLOAT>(heightMap.GetWidth());
+        const FLOAT halfDepth = static_cast<FLOAT>(heightMap.GetDepth());
+
+        // Blocks are 2 units wide, the map spans [-W, W] x [-D, D]
+        wprintf(L"%-10ls %5ls %8ls %10ls %12ls\n", L"camera", L"lod", L"nodes", L"draws", L"triangles");
+        PrintSelection(L"full", tree, XMVectorSet(0.0f, LOD_FLIGHT_HEIGHT, 0.0f, 1.0f), FLT_MAX);
+        PrintSelection(L"center", tree, XMVectorSet(0.0f, LOD_FLIGHT_HEIGHT, 0.0f, 1.0f), projectionScale);
+        PrintSelection(L"edge", tree, XMVectorSet(-halfWidth, LOD_FLIGHT_HEIGHT, 0.0f, 1.0f), projectionScale);
+        PrintSelection(L"above", tree, XMVectorSet(0.0f, 2.0f * halfWidth, 0.0f, 1.0f), projectionScale);
+
+        // Straight flight across the map
+        std::vector<UINT> aNodeIndices;
+        UINT64 uTotalChanged = 0u;
+        UINT64 uMaxChanged = 0u;
+        UINT uNumFrames = 0u;
+        tree.Select(XMVectorSet(-halfWidth, LOD_FLIGHT_HEIGHT, 0.25f * halfDepth, 1.0f), projectionScale, aNodeIndices);
+        for (FLOAT x = -halfWidth; x <= halfWidth; x += LOD_FLIGHT_SPEED, ++uNumFrames)
+        {
+            tree.Select(XMVectorSet(x, LOD_FLIGHT_HEIGHT, 0.25f * halfDepth, 1.0f), projectionScale, aNodeIndices);
+            uTotalChanged += tree.GetStats().uNumChangedNodes;
+            uMaxChanged = std::max(uMaxChanged, tree.GetStats().uNumChangedNodes);
+        }
+
+        wprintf(L"Flight: %u frames, %llu nodes refined or merged, at most %llu in a frame\n", uNumFrames, uTotalChanged, uMaxChanged);
+
+        return 0;
+    }
+}
\ No newline at end of file
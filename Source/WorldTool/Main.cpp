@@ -0,0 +1,106 @@
+/*+===================================================================
+  File:      MAIN.CPP
+
+  Summary:   Entry point of the world tool, a headless console
+             application that pregenerates, converts and benchmarks
+             voxel worlds without creating a window or a device.
+
+  Functions: wmain, PrintUsage
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+
+#include "Common.h"
+
+#include <cstdio>
+
+#include "Commands.h"
+
+namespace
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+        Struct:   CommandEntry
+
+        Summary:  Name, usage and entry point of a command
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct CommandEntry
+    {
+        PCWSTR pszName;
+        PCWSTR pszUsage;
+        worldtool::PFN_COMMAND pfnCommand;
+    };
+
+    constexpr const CommandEntry COMMANDS[] =
+    {
+        { L"generate", L"generate <destination> [size] [height] [seed]", worldtool::RunGenerate },
+        { L"convert", L"convert <source> <destination> [text|binary]", worldtool::RunConvert },
+        { L"bench-load", L"bench-load [directory]", worldtool::RunBenchLoad },
+        { L"bench-mesh", L"bench-mesh [heightmap]", worldtool::RunBenchMesh },
+        { L"instance-stats", L"instance-stats [heightmap]", worldtool::RunInstanceStats },
+        { L"instance-memory", L"instance-memory [heightmap]", worldtool::RunInstanceMemory },
+        { L"water-stats", L"water-stats [heightmap]", worldtool::RunWaterStats },
+        { L"bench-noise", L"bench-noise [size]", worldtool::RunBenchNoise },
+        { L"soak-stream", L"soak-stream [frames] [budgetMB] [radius]", worldtool::RunSoakStream },
+        { L"bench-lod", L"bench-lod [heightmap|size] [maxErrorPixels]", worldtool::RunBenchLod },
+        { L"bench-edit", L"bench-edit [size] [editsPerFrame] [frames]", worldtool::RunBenchEdit },
+        { L"bench-raycast", L"bench-raycast [size]", worldtool::RunBenchRaycast },
+        { L"bench-storage", L"bench-storage [size]", worldtool::RunBenchStorage },
+        { L"bench-density", L"bench-density [size] [height]", worldtool::RunBenchDensity },
+        { L"bench-region", L"bench-region [directory]", worldtool::RunBenchRegion },
+        { L"bench-light", L"bench-light [size] [lights]", worldtool::RunBenchLight },
+        { L"bench-horizon", L"bench-horizon [heightmap|size] [path]", worldtool::RunBenchHorizon },
+        { L"bench-terrain", L"bench-terrain [heightmap|size] [detailDistance]", worldtool::RunBenchTerrain },
+        { L"bench-render", L"bench-render [heightmap|size] [instanced|exposed|chunked|streamed|lod|smooth] [frames] [objects]", worldtool::RunBenchRender },
+        { L"bench-upload", L"bench-upload [allocations] [allocationSize] [frames]", worldtool::RunBenchUpload },
+    };
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: PrintUsage
+
+      Summary:  Prints the usage of every command
+    F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+    void PrintUsage()
+    {
+        wprintf(L"Usage: WorldTool <command> [arguments]\n");
+        for (const CommandEntry& entry : COMMANDS)
+        {
+            wprintf(L"  %ls\n", entry.pszUsage);
+        }
+    }
+}
+
+/*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+  Function: wmain
+
+  Summary:  Entry point of the world tool. Dispatches the first
+            argument to the matching command
+
+  Args:     INT argc
+              Number of arguments
+            PWSTR* argv
+              Arguments
+
+  Returns:  INT
+              Exit code of the command, 1 on usage error
+F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+INT wmain(_In_ INT argc, _In_reads_(argc) PWSTR* argv)
+{
+    if (argc < 2)
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    for (const CommandEntry& entry : COMMANDS)
+    {
+        if (wcscmp(argv[1], entry.pszName) == 0)
+        {
+            return entry.pfnCommand(argc - 2, argv + 2);
+        }
+    }
+
+    wprintf(L"Unknown command: %ls\n", argv[1]);
+    PrintUsage();
+
+    return 1;
+}
\ No newline at end of file
@@ -0,0 +1,452 @@
+/*+===================================================================
+  File:      MESHCOMMANDS.CPP
+
+  Summary:   Meshing commands of the world tool: compares the geometry
+             of the per-block instanced voxels with the exposed-only
+             instances and the culled and greedy chunk meshes, and the
+             memory of the matrix, compact and column instance formats,
+             and the water surface with the water instances it drops.
+
+  Functions: RunBenchMesh, RunInstanceStats, RunInstanceMemory,
+             RunWaterStats
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+
+#include "Commands.h"
+
+#include <cstdio>
+
+#include "BenchmarkMap.h"
+#include "Renderer/DataTypes.h"
+#include "Scene/HeightMap.h"
+#include "Scene/TerrainGenerator.h"
+#include "Scene/VoxelChunkMesher.h"
+#include "Scene/VoxelWaterMesher.h"
+#include "Stopwatch.h"
+
+namespace worldtool
+{
+    namespace
+    {
+        constexpr const UINT BENCH_MESH_SIZES[] = { 256u, 1024u };
+        constexpr const UINT BENCH_MESH_RUNS = 3u;
+        constexpr const UINT INSTANCE_MEMORY_SIZES[] = { 256u, 512u, 1024u, 2048u };
+        constexpr const UINT WATER_STATS_SIZE = 1024u;
+        constexpr const UINT WATER_STATS_HEIGHT = 64u;
+        constexpr const UINT WATER_STATS_SEEDS[] = { 1u, 2u, 3u, 4u };
+
+        // The generator floods few cells, the maps are also measured with the cells below this height turned into ocean
+        constexpr const FLOAT WATER_STATS_FLOOD_LEVEL = 0.5f;
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: PrintMeshStats
+
+          Summary:  Meshes the height map with both meshing algorithms
+                    and prints one row for the instanced path and one
+                    row per algorithm
+
+          Args:     PCWSTR pszName
+                      Name of the height map in the table
+                    const library::HeightMap& heightMap
+                      Height map to mesh
+
+          Returns:  BOOL
+                      FALSE if the height map has no blocks
+        F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+        BOOL PrintMeshStats(_In_ PCWSTR pszName, _In_ const library::HeightMap& heightMap)
+        {
+            constexpr const PCWSTR aMeshingNames[] = { L"culled", L"greedy" };
+            library::VoxelGrid grid(heightMap);
+
+            for (UINT i = 0u; i < static_cast<UINT>(library::eVoxelMeshing::COUNT); ++i)
+            {
+                library::VoxelChunkMesher mesher(grid, static_cast<library::eVoxelMeshing>(i));
+
+                std::vector<library::VoxelChunkMesh> aMeshes;
+                DOUBLE serialTime = MeasureBest(BENCH_MESH_RUNS, [&]()
+                {
+                    mesher.MeshAll(aMeshes, FALSE);
+                    return TRUE;
+                });
+                DOUBLE parallelTime = MeasureBest(BENCH_MESH_RUNS, [&]()
+                {
+                    mesher.MeshAll(aMeshes, TRUE);
+                    return TRUE;
+                });
+
+                library::VoxelMeshStats stats = mesher.GetStats(aMeshes);
+                if (stats.uNumBlocks == 0u)
+                {
+                    return FALSE;
+                }
+
+                if (i == 0u)
+                {
+                    wprintf(L"%-12ls %-9ls %12llu %14llu %14llu %10llu %10ls %10ls\n",
+                        pszName, L"instanced", stats.uNumBlocks,
+                        stats.uNumInstancedVertices, stats.uNumInstancedTriangles, stats.uNumInstancedDraws,
+                        L"-", L"-");
+                }
+
+                wprintf(L"%-12ls %-9ls %12llu %14llu %14llu %10llu %10.1f %10.1f\n",
+                    pszName, aMeshingNames[i], stats.uNumChunks,
+                    stats.uNumVertices, stats.uNumTriangles, stats.uNumDraws,
+                    serialTime, parallelTime);
+            }
+
+            return TRUE;
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: PrintInstanceMemory
+
+          Summary:  Counts the instances of the height map, every block
+                    and only the exposed ones, and prints the size of
+                    their instance buffers in the matrix and compact
+                    formats next to one column instance per cell
+
+          Args:     PCWSTR pszName
+                      Name of the height map in the table
+                    const library::HeightMap& heightMap
+                      Height map to count
+
+          Returns:  BOOL
+                      FALSE if the height map has no blocks
+        F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+        BOOL PrintInstanceMemory(_In_ PCWSTR pszName, _In_ const library::HeightMap& heightMap)
+        {
+            UINT64 uNumBlocks = 0u;
+            UINT64 uNumExposed = 0u;
+            UINT64 uNumColumns = 0u;
+            for (UINT z = 0u; z < heightMap.GetDepth(); ++z)
+            {
+                for (UINT x = 0u; x < heightMap.GetWidth(); ++x)
+                {
+                    if (heightMap.GetBlockType(x, z) != library::HeightMap::EMPTY_BLOCK && heightMap.GetColumnHeight(x, z) > 0u)
+                    {
+                        uNumBlocks += heightMap.GetColumnHeight(x, z);
+                        uNumExposed += heightMap.GetColumnHeight(x, z) - heightMap.GetExposedHeight(x, z);
+                        ++uNumColumns;
+                    }
+                }
+            }
+
+            if (uNumBlocks == 0u)
+            {
+                return FALSE;
+            }
+
+            constexpr const DOUBLE megabyte = static_cast<DOUBLE>(1u << 20u);
+            const UINT64 aNumInstances[] = { uNumBlocks, uNumExposed };
+            constexpr const PCWSTR aBuildNames[] = { L"all", L"exposed" };
+            for (UINT i = 0u; i < ARRAYSIZE(aNumInstances); ++i)
+            {
+                DOUBLE matrixMegabytes = static_cast<DOUBLE>(aNumInstances[i] * sizeof(library::InstanceData)) / megabyte;
+                DOUBLE compactMegabytes = static_cast<DOUBLE>(aNumInstances[i] * sizeof(library::CompactInstanceData)) / megabyte;
+                DOUBLE columnMegabytes = static_cast<DOUBLE>(uNumColumns * sizeof(library::ColumnInstanceData)) / megabyte;
+                wprintf(L"%-12ls %-8ls %14llu %12llu %10.1f %11.1f %10.2f %8.1fx %8.1fx\n",
+                    pszName, aBuildNames[i], aNumInstances[i], uNumColumns, matrixMegabytes, compactMegabytes, columnMegabytes,
+                    matrixMegabytes / compactMegabytes, compactMegabytes / columnMegabytes);
+            }
+
+            return TRUE;
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: PrintWaterStats
+
+          Summary:  Builds the water surface of the height map and prints
+                    its quads next to the water instances it replaces,
+                    with every block, the exposed blocks and the columns
+
+          Args:     PCWSTR pszName
+                      Name of the height map in the table
+                    const library::HeightMap& heightMap
+                      Height map to mesh
+        F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+        void PrintWaterStats(_In_ PCWSTR pszName, _In_ const library::HeightMap& heightMap)
+        {
+            library::VoxelGrid grid(heightMap);
+            library::VoxelWaterMesher mesher(heightMap, grid.GetOrigin());
+
+            library::VoxelChunkMesh mesh;
+            library::VoxelWaterStats stats = {};
+            DOUBLE meshTime = MeasureBest(BENCH_MESH_RUNS, [&]()
+            {
+                mesher.Mesh(mesh, stats);
+                return TRUE;
+            });
+
+            // Every instance is a 12-triangle cube, every quad 2 triangles
+            DOUBLE waterPercent = 100.0 * static_cast<DOUBLE>(stats.uNumCells) / static_cast<DOUBLE>(static_cast<UINT64>(heightMap.GetWidth()) * heightMap.GetDepth());
+            DOUBLE savedPercent = stats.uNumExposedBlocks == 0u ? 0.0 :
+                100.0 - 100.0 * static_cast<DOUBLE>(stats.uNumQuads * 2u) / static_cast<DOUBLE>(stats.uNumExposedBlocks * 12u);
+            wprintf(L"%-16ls %6.1f%% %8llu %8llu %10llu %12llu %12llu %12llu %9.1f%% %8.2f\n",
+                pszName, waterPercent, stats.uNumRegions, stats.uNumQuads, stats.uNumQuads * 2u,
+                stats.uNumBlocks * 12u, stats.uNumExposedBlocks * 12u, stats.uNumColumns * 12u, savedPercent, meshTime);
+        }
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: RunBenchMesh
+
+      Summary:  Prints the vertices, triangles and draw calls of the
+                instanced voxels and of the culled and greedy chunk
+                meshes, with the serial and parallel meshing times.
+                Runs on the given height map, or on 256^2 and 1024^2
+                benchmark maps
+
+      Args:     INT argc
+                  Number of arguments
+                PWSTR* argv
+                  [heightmap] to mesh
+
+      Returns:  INT
+                  0 on success
+    F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+    INT RunBenchMesh(_In_ INT argc, _In_reads_(argc) PWSTR* argv)
+    {
+        wprintf(L"%-12ls %-9ls %12ls %14ls %14ls %10ls %10ls %10ls\n", L"map", L"path", L"blocks/chunks", L"vertices", L"triangles", L"draws", L"serial ms", L"par ms");
+
+        if (argc > 0)
+        {
+            library::HeightMap heightMap;
+            if (FAILED(heightMap.LoadFromFile(argv[0])))
+            {
+                wprintf(L"Failed to load %ls\n", argv[0]);
+                return 1;
+            }
+
+            if (!PrintMeshStats(std::filesystem::path(argv[0]).filename().wstring().c_str(), heightMap))
+            {
+                wprintf(L"%ls has no blocks\n", argv[0]);
+                return 1;
+            }
+
+            return 0;
+        }
+
+        for (UINT uSize : BENCH_MESH_SIZES)
+        {
+            std::wstring name = std::to_wstring(uSize) + L"x" + std::to_wstring(uSize);
+            if (!PrintMeshStats(name.c_str(), CreateBenchmarkMap(uSize)))
+            {
+                return 1;
+            }
+        }
+
+        return 0;
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: RunInstanceStats
+
+      Summary:  Prints, for each block type, the number of instances
+                the exposed-only build keeps and the number of fully
+                enclosed blocks it culls. Runs on the given height
+                map, or on a 1024^2 benchmark map
+
+      Args:     INT argc
+                  Number of arguments
+                PWSTR* argv
+                  [heightmap] to count
+
+      Returns:  INT
+                  0 on success
+    F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+    INT RunInstanceStats(_In_ INT argc, _In_reads_(argc) PWSTR* argv)
+    {
+        library::HeightMap heightMap;
+        if (argc > 0)
+        {
+            if (FAILED(heightMap.LoadFromFile(argv[0])))
+            {
+                wprintf(L"Failed to load %ls\n", argv[0]);
+                return 1;
+            }
+        }
+        else
+        {
+            heightMap = CreateBenchmarkMap(1024u);
+        }
+
+        constexpr const UINT uNumTypes = static_cast<UINT>(library::eBlockType::COUNT) - static_cast<UINT>(library::eBlockType::GRASSLAND);
+        UINT64 aNumKept[uNumTypes] = { 0u, };
+        UINT64 aNumCulled[uNumTypes] = { 0u, };
+        for (UINT z = 0u; z < heightMap.GetDepth(); ++z)
+        {
+            for (UINT x = 0u; x < heightMap.GetWidth(); ++x)
+            {
+                UINT uTypeIdx = static_cast<UINT>(heightMap.GetBlockType(x, z)) - static_cast<UINT>(library::eBlockType::GRASSLAND);
+                if (uTypeIdx < uNumTypes)
+                {
+                    UINT uExposedHeight = heightMap.GetExposedHeight(x, z);
+                    aNumKept[uTypeIdx] += heightMap.GetColumnHeight(x, z) - uExposedHeight;
+                    aNumCulled[uTypeIdx] += uExposedHeight;
+                }
+            }
+        }
+
+        wprintf(L"%6ls %14ls %14ls %8ls\n", L"type", L"kept", L"culled", L"kept %");
+
+        UINT64 uTotalKept = 0u;
+        UINT64 uTotalCulled = 0u;
+        for (UINT i = 0u; i < uNumTypes; ++i)
+        {
+            if (aNumKept[i] + aNumCulled[i] == 0u)
+            {
+                continue;
+            }
+
+            wprintf(L"%6u %14llu %14llu %7.1f%%\n",
+                static_cast<UINT>(library::eBlockType::GRASSLAND) + i, aNumKept[i], aNumCulled[i],
+                100.0 * static_cast<DOUBLE>(aNumKept[i]) / static_cast<DOUBLE>(aNumKept[i] + aNumCulled[i]));
+            uTotalKept += aNumKept[i];
+            uTotalCulled += aNumCulled[i];
+        }
+
+        if (uTotalKept + uTotalCulled == 0u)
+        {
+            wprintf(L"The height map has no blocks\n");
+            return 1;
+        }
+
+        wprintf(L"%6ls %14llu %14llu %7.1f%%\n", L"total", uTotalKept, uTotalCulled,
+            100.0 * static_cast<DOUBLE>(uTotalKept) / static_cast<DOUBLE>(uTotalKept + uTotalCulled));
+
+        return 0;
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: RunInstanceMemory
+
+      Summary:  Prints the instance buffer size of every block and of
+                the exposed blocks only, with 64-byte matrices and with
+                8-byte compact grid cells, next to one 8-byte column
+                per cell. Every instance draws the same 36 indices, so
+                the instance count is also the vertex shader work.
+                Runs on the given height map, or on 256^2 to 2048^2
+                benchmark maps
+
+      Args:     INT argc
+                  Number of arguments
+                PWSTR* argv
+                  [heightmap] to count
+
+      Returns:  INT
+                  0 on success
+    F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+    INT RunInstanceMemory(_In_ INT argc, _In_reads_(argc) PWSTR* argv)
+    {
+        wprintf(L"%-12ls %-8ls %14ls %12ls %10ls %11ls %10ls %9ls %9ls\n",
+            L"map", L"blocks", L"instances", L"columns", L"matrix MB", L"compact MB", L"column MB", L"mat/comp", L"comp/col");
+
+        if (argc > 0)
+        {
+            library::HeightMap heightMap;
+            if (FAILED(heightMap.LoadFromFile(argv[0])))
+            {
+                wprintf(L"Failed to load %ls\n", argv[0]);
+                return 1;
+            }
+
+            if (!PrintInstanceMemory(std::filesystem::path(argv[0]).filename().wstring().c_str(), heightMap))
+            {
+                wprintf(L"%ls has no blocks\n", argv[0]);
+                return 1;
+            }
+
+            return 0;
+        }
+
+        for (UINT uSize : INSTANCE_MEMORY_SIZES)
+        {
+            std::wstring name = std::to_wstring(uSize) + L"x" + std::to_wstring(uSize);
+            if (!PrintInstanceMemory(name.c_str(), CreateBenchmarkMap(uSize)))
+            {
+                return 1;
+            }
+        }
+
+        return 0;
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: RunWaterStats
+
+      Summary:  Prints the triangles of the water surface and of the
+                water instances it replaces in the per-block, exposed
+                and column builds, and the share of the exposed water
+                triangles it saves. Runs on the given height map, or
+                on generated 1024^2 maps of several seeds, as they are
+                and flooded up to WATER_STATS_FLOOD_LEVEL
+
+      Args:     INT argc
+                  Number of arguments
+                PWSTR* argv
+                  [heightmap] to mesh
+
+      Returns:  INT
+                  0 on success
+    F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+    INT RunWaterStats(_In_ INT argc, _In_reads_(argc) PWSTR* argv)
+    {
+        wprintf(L"%-16ls %7ls %8ls %8ls %10ls %12ls %12ls %12ls %10ls %8ls\n",
+            L"map", L"water", L"regions", L"quads", L"surf tris", L"block tris", L"exposed tris", L"column tris", L"saved", L"ms");
+
+        if (argc > 0)
+        {
+            library::HeightMap heightMap;
+            if (FAILED(heightMap.LoadFromFile(argv[0])))
+            {
+                wprintf(L"Failed to load %ls\n", argv[0]);
+                return 1;
+            }
+
+            PrintWaterStats(std::filesystem::path(argv[0]).filename().wstring().c_str(), heightMap);
+
+            return 0;
+        }
+
+        for (UINT uSeed : WATER_STATS_SEEDS)
+        {
+            library::TerrainGenerator generator(
+                library::TerrainDesc
+                {
+                    .uWidth = WATER_STATS_SIZE,
+                    .uHeight = WATER_STATS_HEIGHT,
+                    .uDepth = WATER_STATS_SIZE,
+                    .uHeightSeed = uSeed,
+                    .uMoistureSeed = uSeed + 1u,
+                }
+            );
+
+            library::HeightMap heightMap;
+            if (FAILED(generator.Generate(heightMap)))
+            {
+                return 1;
+            }
+
+            std::wstring name = L"seed " + std::to_wstring(uSeed);
+            PrintWaterStats(name.c_str(), heightMap);
+
+            for (UINT z = 0u; z < heightMap.GetDepth(); ++z)
+            {
+                for (UINT x = 0u; x < heightMap.GetWidth(); ++x)
+                {
+                    FLOAT height = heightMap.GetNormalizedHeight(x, z);
+                    if (height < WATER_STATS_FLOOD_LEVEL)
+                    {
+                        heightMap.SetCell(x, z, static_cast<CHAR>(library::eBlockType::OCEAN), height);
+                    }
+                }
+            }
+
+            name += L" flooded";
+            PrintWaterStats(name.c_str(), heightMap);
+        }
+
+        return 0;
+    }
+}
\ No newline at end of file
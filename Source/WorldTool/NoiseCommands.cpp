@@ -0,0 +1,262 @@
+/*+===================================================================
+  File:      NOISECOMMANDS.CPP
+
+  Summary:   Noise commands of the world tool: compares the throughput
+             of the former per-sample Scene::GetPerlin2d with the
+             scalar, SSE2 and AVX2 paths of the batched noise engine.
+
+  Functions: RunBenchNoise
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+
+#include "Commands.h"
+
+#include <cstdio>
+#include <cstring>
+#include <cwchar>
+
+#include "Scene/PerlinNoise.h"
+#include "Stopwatch.h"
+
+namespace worldtool
+{
+    namespace
+    {
+        constexpr const UINT BENCH_NOISE_DEFAULT_SIZE = 1024u;
+        constexpr const UINT BENCH_NOISE_RUNS = 3u;
+        constexpr const FLOAT BENCH_NOISE_FREQUENCY = 0.1f;
+        constexpr const UINT BENCH_NOISE_OCTAVES = 4u;
+
+        // Steps the map generator samples with, all of them are checked for bit-exactness
+        constexpr const FLOAT BENCH_NOISE_STEPS[] = { 1.0f, 2.0f, 4.0f, 8.0f };
+
+        /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+          Class:    LegacyNoise
+
+          Summary:  Copy of the per-sample noise Scene used before the
+                    batched engine, kept as the reference of the
+                    benchmark
+
+          Methods:  GetPerlin2d
+                      Evaluates one sample
+        C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+        class LegacyNoise
+        {
+        public:
+            static FLOAT GetPerlin2d(FLOAT x, FLOAT y, FLOAT frequency, UINT uDepth)
+            {
+                FLOAT xa = x * frequency;
+                FLOAT ya = y * frequency;
+                FLOAT amp = 1.0f;
+                FLOAT fin = 0.0f;
+                FLOAT div = 0.0f;
+
+                for (UINT i = 0; i < uDepth; ++i)
+                {
+                    div += 256.0f * amp;
+                    fin += getNoise2d(xa, ya) * amp;
+                    amp /= 2.0f;
+                    xa *= 2.0f;
+                    ya *= 2.0f;
+                }
+
+                return fin / div;
+            }
+
+        private:
+            static FLOAT getNoise2(UINT x, UINT y)
+            {
+                UINT temp = ms_aHashes[y % 256u];
+
+                return static_cast<FLOAT>(ms_aHashes[(temp + x) % 256u]);
+            }
+
+            static FLOAT getNoise2d(FLOAT x, FLOAT y)
+            {
+                UINT uX = static_cast<UINT>(x);
+                UINT uY = static_cast<UINT>(y);
+                FLOAT xFrac = x - static_cast<FLOAT>(uX);
+                FLOAT yFrac = y - static_cast<FLOAT>(uY);
+
+                UINT s = static_cast<UINT>(getNoise2(uX, uY));
+                UINT t = static_cast<UINT>(getNoise2(uX + 1u, uY));
+                UINT u = static_cast<UINT>(getNoise2(uX, uY + 1u));
+                UINT v = static_cast<UINT>(getNoise2(uX + 1u, uY + 1u));
+
+                FLOAT low = smoothLerp(static_cast<FLOAT>(s), static_cast<FLOAT>(t), xFrac);
+                FLOAT high = smoothLerp(static_cast<FLOAT>(u), static_cast<FLOAT>(v), xFrac);
+
+                return smoothLerp(low, high, yFrac);
+            }
+
+            static FLOAT lerp(FLOAT x, FLOAT y, FLOAT s)
+            {
+                return x + s * (y - x);
+            }
+
+            static FLOAT smoothLerp(FLOAT x, FLOAT y, FLOAT s)
+            {
+                return lerp(x, y, s * s * (3.0f - 2.0f * s));
+            }
+
+        private:
+            static constexpr const UINT ms_aHashes[] =
+            {
+                208,34,231,213,32,248,233,56,161,78,24,140,71,48,140,254,245,255,247,247,40,
+                185,248,251,245,28,124,204,204,76,36,1,107,28,234,163,202,224,245,128,167,204,
+                9,92,217,54,239,174,173,102,193,189,190,121,100,108,167,44,43,77,180,204,8,81,
+                70,223,11,38,24,254,210,210,177,32,81,195,243,125,8,169,112,32,97,53,195,13,
+                203,9,47,104,125,117,114,124,165,203,181,235,193,206,70,180,174,0,167,181,41,
+                164,30,116,127,198,245,146,87,224,149,206,57,4,192,210,65,210,129,240,178,105,
+                228,108,245,148,140,40,35,195,38,58,65,207,215,253,65,85,208,76,62,3,237,55,89,
+                232,50,217,64,244,157,199,121,252,90,17,212,203,149,152,140,187,234,177,73,174,
+                193,100,192,143,97,53,145,135,19,103,13,90,135,151,199,91,239,247,33,39,145,
+                101,120,99,3,186,86,99,41,237,203,111,79,220,135,158,42,30,154,120,67,87,167,
+                135,176,183,191,253,115,184,21,233,58,129,233,142,39,128,211,118,137,139,255,
+                114,20,218,113,154,27,127,246,250,1,8,198,250,209,92,222,173,21,88,102,219
+            };
+        };
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: FillLegacyTile
+
+          Summary:  Fills a square tile sample by sample with the
+                    former noise
+
+          Args:     FLOAT step
+                      Distance between two samples
+                    UINT uSize
+                      Number of samples of a side
+                    std::vector<FLOAT>& aOutSamples
+                      Output samples, row major
+
+          Modifies: [aOutSamples].
+        F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+        void FillLegacyTile(FLOAT step, UINT uSize, std::vector<FLOAT>& aOutSamples)
+        {
+            for (UINT z = 0u; z < uSize; ++z)
+            {
+                for (UINT x = 0u; x < uSize; ++x)
+                {
+                    aOutSamples[static_cast<size_t>(z) * uSize + x] = LegacyNoise::GetPerlin2d(step * static_cast<FLOAT>(x), step * static_cast<FLOAT>(z), BENCH_NOISE_FREQUENCY, BENCH_NOISE_OCTAVES);
+                }
+            }
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: PrintNoiseRow
+
+          Summary:  Prints the time, throughput and speedup of a path
+
+          Args:     PCWSTR pszPath
+                      Name of the path
+                    DOUBLE elapsed
+                      Time of the path in milliseconds
+                    UINT64 uNumSamples
+                      Number of samples of the tile
+                    DOUBLE baseline
+                      Time of the former noise in milliseconds
+                    PCWSTR pszExact
+                      Result of the bit-exactness check
+        F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+        void PrintNoiseRow(PCWSTR pszPath, DOUBLE elapsed, UINT64 uNumSamples, DOUBLE baseline, PCWSTR pszExact)
+        {
+            wprintf(L"%-8ls %10.1f %14.1f %8.2fx %6ls\n",
+                pszPath, elapsed,
+                static_cast<DOUBLE>(uNumSamples) / (elapsed / 1000.0) / 1.0e6,
+                baseline / elapsed, pszExact);
+        }
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: RunBenchNoise
+
+      Summary:  Fills a square tile of 4-octave noise with the former
+                per-sample function and with every code path of the
+                batched engine the CPU supports, then prints the
+                samples per second and the speedup of each path. Every
+                path is checked bit for bit against the former
+                function on all the steps the map generator uses
+
+      Args:     INT argc
+                  Number of arguments
+                PWSTR* argv
+                  [size] of the tile, 1024 by default
+
+      Returns:  INT
+                  0 on success, 1 if a path is not bit-exact
+    F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+    INT RunBenchNoise(_In_ INT argc, _In_reads_(argc) PWSTR* argv)
+    {
+        UINT uSize = BENCH_NOISE_DEFAULT_SIZE;
+        if (argc > 0)
+        {
+            uSize = static_cast<UINT>(wcstoul(argv[0], nullptr, 10));
+            if (uSize == 0u)
+            {
+                wprintf(L"Invalid size %ls\n", argv[0]);
+                return 1;
+            }
+        }
+
+        const UINT64 uNumSamples = static_cast<UINT64>(uSize) * uSize;
+        std::vector<FLOAT> aReference(uNumSamples);
+        std::vector<FLOAT> aSamples(uNumSamples);
+
+        wprintf(L"%ux%u samples, frequency %.2f, %u octaves\n", uSize, uSize, BENCH_NOISE_FREQUENCY, BENCH_NOISE_OCTAVES);
+        wprintf(L"%-8ls %10ls %14ls %9ls %6ls\n", L"path", L"ms", L"Msamples/s", L"speedup", L"exact");
+
+        DOUBLE baseline = MeasureBest(BENCH_NOISE_RUNS, [&]()
+        {
+            FillLegacyTile(1.0f, uSize, aReference);
+            return TRUE;
+        });
+        PrintNoiseRow(L"legacy", baseline, uNumSamples, baseline, L"-");
+
+        constexpr const PCWSTR aPathNames[] = { L"scalar", L"sse2", L"avx2" };
+        static_assert(ARRAYSIZE(aPathNames) == static_cast<size_t>(library::eNoiseInstructionSet::COUNT));
+
+        BOOL bAllExact = TRUE;
+        library::PerlinNoise noise;
+        for (UINT i = 0u; i < static_cast<UINT>(library::eNoiseInstructionSet::COUNT); ++i)
+        {
+            if (FAILED(noise.SetInstructionSet(static_cast<library::eNoiseInstructionSet>(i))))
+            {
+                wprintf(L"%-8ls %10ls\n", aPathNames[i], L"unsupported");
+                continue;
+            }
+
+            DOUBLE elapsed = MeasureBest(BENCH_NOISE_RUNS, [&]()
+            {
+                noise.FillTile(0.0f, 0.0f, 1.0f, BENCH_NOISE_FREQUENCY, BENCH_NOISE_OCTAVES, uSize, uSize, aSamples.data());
+                return TRUE;
+            });
+
+            BOOL bExact = memcmp(aSamples.data(), aReference.data(), aSamples.size() * sizeof(FLOAT)) == 0;
+            PrintNoiseRow(aPathNames[i], elapsed, uNumSamples, baseline, bExact ? L"yes" : L"NO");
+            bAllExact = bAllExact && bExact;
+        }
+
+        for (FLOAT step : BENCH_NOISE_STEPS)
+        {
+            FillLegacyTile(step, uSize, aReference);
+            for (UINT i = 0u; i < static_cast<UINT>(library::eNoiseInstructionSet::COUNT); ++i)
+            {
+                if (FAILED(noise.SetInstructionSet(static_cast<library::eNoiseInstructionSet>(i))))
+                {
+                    continue;
+                }
+
+                noise.FillTile(0.0f, 0.0f, step, BENCH_NOISE_FREQUENCY, BENCH_NOISE_OCTAVES, uSize, uSize, aSamples.data());
+                if (memcmp(aSamples.data(), aReference.data(), aSamples.size() * sizeof(FLOAT)) != 0)
+                {
+                    wprintf(L"%ls differs from legacy with step %.0f\n", aPathNames[i], step);
+                    bAllExact = FALSE;
+                }
+            }
+        }
+
+        return bAllExact ? 0 : 1;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,194 @@
+/*+===================================================================
+  File:      RAYCASTCOMMANDS.CPP
+
+  Summary:   Raycast commands of the world tool: measures the rays per
+             second of the voxel grid DDA on a benchmark map, one ray
+             per pixel of a camera view and long random rays, on one
+             core and on all cores.
+
+  Functions: RunBenchRaycast
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+
+#include "Commands.h"
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+#include "BenchmarkMap.h"
+#include "Scene/VoxelGrid.h"
+#include "Stopwatch.h"
+
+namespace worldtool
+{
+    namespace
+    {
+        constexpr const UINT RAYCAST_DEFAULT_SIZE = 1024u;
+        constexpr const UINT RAYCAST_RUNS = 3u;
+
+        // One ray per pixel of a 1920x1080 view with the 45 degrees field of view of the renderer
+        constexpr const UINT RAYCAST_VIEW_WIDTH = 1920u;
+        constexpr const UINT RAYCAST_VIEW_HEIGHT = 1080u;
+        constexpr const FLOAT RAYCAST_FIELD_OF_VIEW = 3.14159265f / 4.0f;
+        constexpr const FLOAT RAYCAST_FAR_PLANE = 1000.0f;
+
+        // Same random rays on every run
+        constexpr const UINT RAYCAST_SEED = 42u;
+        constexpr const UINT RAYCAST_NUM_RANDOM_RAYS = 1u << 20u;
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: CreateViewRays
+
+          Summary:  Creates one ray per pixel of a camera above the map
+                    center, looking along +z and 30 degrees down
+
+          Args:     const library::VoxelGrid& grid
+                      Grid the rays are cast into
+
+          Returns:  std::vector<library::VoxelRay>
+                      Rays, row by row
+        F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+        std::vector<library::VoxelRay> CreateViewRays(_In_ const library::VoxelGrid& grid)
+        {
+            const FLOAT tanHalfFov = std::tan(RAYCAST_FIELD_OF_VIEW / 2.0f);
+            const FLOAT aspect = static_cast<FLOAT>(RAYCAST_VIEW_WIDTH) / static_cast<FLOAT>(RAYCAST_VIEW_HEIGHT);
+            const FLOAT pitch = -3.14159265f / 6.0f;
+
+            // Just above the highest block
+            const XMFLOAT3 eye(0.0f, grid.GetOrigin().y + library::VoxelGrid::CELL_SIZE * static_cast<FLOAT>(grid.GetHeight()) + 8.0f, 0.0f);
+
+            std::vector<library::VoxelRay> aRays;
+            aRays.reserve(static_cast<size_t>(RAYCAST_VIEW_WIDTH) * RAYCAST_VIEW_HEIGHT);
+            for (UINT uRow = 0u; uRow < RAYCAST_VIEW_HEIGHT; ++uRow)
+            {
+                for (UINT uColumn = 0u; uColumn < RAYCAST_VIEW_WIDTH; ++uColumn)
+                {
+                    FLOAT u = (2.0f * (static_cast<FLOAT>(uColumn) + 0.5f) / static_cast<FLOAT>(RAYCAST_VIEW_WIDTH) - 1.0f) * tanHalfFov * aspect;
+                    FLOAT v = (1.0f - 2.0f * (static_cast<FLOAT>(uRow) + 0.5f) / static_cast<FLOAT>(RAYCAST_VIEW_HEIGHT)) * tanHalfFov;
+
+                    // Camera space (u, v, 1) pitched around the x axis
+                    aRays.push_back(
+                        library::VoxelRay
+                        {
+                            .origin = eye,
+                            .direction = XMFLOAT3(u, v * std::cos(pitch) + std::sin(pitch), std::cos(pitch) - v * std::sin(pitch)),
+                            .maxDistance = RAYCAST_FAR_PLANE
+                        }
+                    );
+                }
+            }
+
+            return aRays;
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: CreateRandomRays
+
+          Summary:  Creates rays from random points above the terrain
+                    in random directions, as long as the map is wide
+
+          Args:     const library::VoxelGrid& grid
+                      Grid the rays are cast into
+
+          Returns:  std::vector<library::VoxelRay>
+                      Rays
+        F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+        std::vector<library::VoxelRay> CreateRandomRays(_In_ const library::VoxelGrid& grid)
+        {
+            const XMFLOAT3& origin = grid.GetOrigin();
+            const FLOAT width = library::VoxelGrid::CELL_SIZE * static_cast<FLOAT>(grid.GetWidth());
+            const FLOAT height = library::VoxelGrid::CELL_SIZE * static_cast<FLOAT>(grid.GetHeight());
+            const FLOAT depth = library::VoxelGrid::CELL_SIZE * static_cast<FLOAT>(grid.GetDepth());
+
+            std::mt19937 generator(RAYCAST_SEED);
+            std::uniform_real_distribution<FLOAT> unit(0.0f, 1.0f);
+            std::uniform_real_distribution<FLOAT> signedUnit(-1.0f, 1.0f);
+
+            std::vector<library::VoxelRay> aRays;
+            aRays.reserve(RAYCAST_NUM_RANDOM_RAYS);
+            for (UINT i = 0u; i < RAYCAST_NUM_RANDOM_RAYS; ++i)
+            {
+                aRays.push_back(
+                    library::VoxelRay
+                    {
+                        .origin = XMFLOAT3(origin.x + width * unit(generator), origin.y + height * (0.75f + 0.25f * unit(generator)), origin.z + depth * unit(generator)),
+                        .direction = XMFLOAT3(signedUnit(generator), signedUnit(generator), signedUnit(generator)),
+                        .maxDistance = width
+                    }
+                );
+            }
+
+            return aRays;
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: PrintRaycastStats
+
+          Summary:  Casts the rays on one core and on all cores and
+                    prints the hits and the rays per second
+
+          Args:     PCWSTR pszName
+                      Name of the rays in the table
+                    const library::VoxelGrid& grid
+                      Grid the rays are cast into
+                    const std::vector<library::VoxelRay>& aRays
+                      Rays
+        F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+        void PrintRaycastStats(_In_ PCWSTR pszName, _In_ const library::VoxelGrid& grid, _In_ const std::vector<library::VoxelRay>& aRays)
+        {
+            std::vector<library::VoxelRayHit> aHits;
+            DOUBLE serialTime = MeasureBest(RAYCAST_RUNS, [&]() { grid.RaycastBatch(aRays, aHits, FALSE); return TRUE; });
+            DOUBLE parallelTime = MeasureBest(RAYCAST_RUNS, [&]() { grid.RaycastBatch(aRays, aHits, TRUE); return TRUE; });
+
+            UINT64 uNumHits = 0u;
+            for (const library::VoxelRayHit& hit : aHits)
+            {
+                uNumHits += hit.bHit ? 1u : 0u;
+            }
+
+            const DOUBLE rays = static_cast<DOUBLE>(aRays.size());
+            wprintf(L"%-8ls %10zu %7.1f%% %10.1f %10.2f %10.1f %10.2f\n",
+                pszName, aRays.size(), 100.0 * static_cast<DOUBLE>(uNumHits) / rays,
+                serialTime, rays / (serialTime * 1000.0), parallelTime, rays / (parallelTime * 1000.0));
+        }
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: RunBenchRaycast
+
+      Summary:  Fills the block grid of a benchmark map, 1024^2 by
+                default, and prints the rays per second of a view of
+                one ray per pixel and of long random rays
+
+      Args:     INT argc
+                  Number of arguments
+                PWSTR* argv
+                  [size]
+
+      Returns:  INT
+                  0 on success
+    F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+    INT RunBenchRaycast(_In_ INT argc, _In_reads_(argc) PWSTR* argv)
+    {
+        UINT uSize = 0u;
+        if (!ParseUint(argc, argv, 0, RAYCAST_DEFAULT_SIZE, uSize) || uSize == 0u)
+        {
+            wprintf(L"bench-raycast [size]\n");
+            return 1;
+        }
+
+        library::HeightMap heightMap = CreateBenchmarkMap(uSize);
+
+        Stopwatch stopwatch;
+        library::VoxelGrid grid(heightMap);
+        wprintf(L"Filled the %ux%ux%u grid in %.1f ms\n", grid.GetWidth(), grid.GetHeight(), grid.GetDepth(), stopwatch.GetElapsedMilliseconds());
+
+        wprintf(L"%-8ls %10ls %8ls %10ls %10ls %10ls %10ls\n", L"rays", L"count", L"hits", L"1 core ms", L"Mrays/s", L"all ms", L"Mrays/s");
+        PrintRaycastStats(L"view", grid, CreateViewRays(grid));
+        PrintRaycastStats(L"random", grid, CreateRandomRays(grid));
+
+        return 0;
+    }
+}
\ No newline at end of file
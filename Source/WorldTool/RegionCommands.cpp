@@ -0,0 +1,411 @@
+/*+===================================================================
+  File:      REGIONCOMMANDS.CPP
+
+  Summary:   Region commands of the world tool: measures the load and
+             save throughput of the region files of generated density
+             grids, the latency of a single chunk and the incremental
+             saves of edited chunks under a per-frame budget, and
+             checks that damaged region headers are rejected.
+
+  Functions: RunBenchRegion
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+
+#include "Commands.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <random>
+
+#include "Scene/DensityGenerator.h"
+#include "Scene/VoxelRegionStore.h"
+#include "Stopwatch.h"
+
+namespace worldtool
+{
+    namespace
+    {
+        constexpr const UINT REGION_HEIGHT = 64u;
+        constexpr const UINT REGION_RUNS = 3u;
+        constexpr const UINT REGION_SEED = 0u;
+
+        // Random chunks read one at a time for the latency of a single chunk
+        constexpr const UINT REGION_NUM_CHUNK_LOADS = 256u;
+
+        // Edited chunks of the incremental save and the serialized bytes handed to the writer per frame
+        constexpr const UINT REGION_NUM_EDITED_CHUNKS = 64u;
+        constexpr const UINT REGION_EDITS_PER_CHUNK = 32u;
+        constexpr const UINT64 REGION_BYTES_PER_FRAME = 64ull << 10u;
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: getDirectorySize
+
+          Summary:  Adds the sizes of the files of a directory
+
+          Args:     const std::filesystem::path& directoryPath
+                      Directory of the region files
+
+          Returns:  UINT64
+                      Bytes of the files
+        F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+        UINT64 getDirectorySize(_In_ const std::filesystem::path& directoryPath)
+        {
+            UINT64 uNumBytes = 0u;
+            for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(directoryPath))
+            {
+                uNumBytes += entry.is_regular_file() ? static_cast<UINT64>(entry.file_size()) : 0u;
+            }
+
+            return uNumBytes;
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: areGridsEqual
+
+          Summary:  Compares the serialized chunks of two grids
+
+          Args:     const library::VoxelGrid& grid
+                    const library::VoxelGrid& otherGrid
+                      Grids of the same size
+
+          Returns:  BOOL
+                      TRUE if every chunk holds the same blocks
+        F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+        BOOL areGridsEqual(_In_ const library::VoxelGrid& grid, _In_ const library::VoxelGrid& otherGrid)
+        {
+            std::vector<BYTE> aBytes;
+            std::vector<BYTE> aOtherBytes;
+            for (UINT uChunkZ = 0u; uChunkZ < grid.GetNumChunksZ(); ++uChunkZ)
+            {
+                for (UINT uChunkX = 0u; uChunkX < grid.GetNumChunksX(); ++uChunkX)
+                {
+                    aBytes.clear();
+                    aOtherBytes.clear();
+                    grid.SerializeChunk(uChunkX, uChunkZ, aBytes);
+                    otherGrid.SerializeChunk(uChunkX, uChunkZ, aOtherBytes);
+                    if (aBytes != aOtherBytes)
+                    {
+                        return FALSE;
+                    }
+                }
+            }
+
+            return TRUE;
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: loadGrid
+
+          Summary:  Reads every chunk of the region files into an empty
+                    grid of the same size, through a new store so that
+                    the files are opened again
+
+          Args:     const std::filesystem::path& directoryPath
+                      Directory of the region files
+                    const library::VoxelGrid& grid
+                      Grid the files were saved from
+                    std::unique_ptr<library::VoxelGrid>& outGrid
+                      Grid read back
+
+          Returns:  BOOL
+                      TRUE if every chunk was read
+        F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+        BOOL loadGrid(_In_ const std::filesystem::path& directoryPath, _In_ const library::VoxelGrid& grid, _Out_ std::unique_ptr<library::VoxelGrid>& outGrid)
+        {
+            outGrid = std::make_unique<library::VoxelGrid>(grid.GetWidth(), grid.GetHeight(), grid.GetDepth(), std::vector<XMFLOAT4>(grid.GetPalette()));
+
+            library::VoxelRegionStore store(directoryPath, grid.GetHeight(), REGION_BYTES_PER_FRAME);
+            UINT uNumLoaded = 0u;
+            return SUCCEEDED(store.LoadGrid(*outGrid, &uNumLoaded)) && uNumLoaded == grid.GetNumChunksX() * grid.GetNumChunksZ();
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: checkCorruptedHeader
+
+          Summary:  Saves four chunks to a region file, damages the
+                    entries of three of them on disk, one with sectors
+                    past the end of the file, one with a compressed size
+                    larger than its sectors and one with a serialized
+                    size larger than any chunk, then opens the file
+                    again. The damaged chunks must fail to load while
+                    the intact one still loads, and a damaged chunk
+                    must load again once it is saved
+
+          Args:     const std::filesystem::path& directoryPath
+                      Directory of the region file, emptied first
+
+          Returns:  BOOL
+                      TRUE if exactly the damaged entries are rejected
+        F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+        BOOL checkCorruptedHeader(_In_ const std::filesystem::path& directoryPath)
+        {
+            std::error_code error;
+            std::filesystem::remove_all(directoryPath, error);
+            std::filesystem::create_directories(directoryPath, error);
+            const std::filesystem::path filePath = directoryPath / L"corrupted.region";
+
+            library::VoxelChunkStorage chunk(REGION_HEIGHT);
+            for (UINT i = 0u; i < library::VoxelChunkStorage::CHUNK_SIZE; ++i)
+            {
+                chunk.SetBlock(i, i % REGION_HEIGHT, i, static_cast<CHAR>(1 + i % 4u));
+            }
+            std::vector<BYTE> aBytes;
+            chunk.Serialize(aBytes);
+
+            constexpr const UINT NUM_CHUNKS = 4u;
+            {
+                library::VoxelRegionFile regionFile;
+                if (FAILED(regionFile.Open(filePath, REGION_HEIGHT)))
+                {
+                    wprintf(L"Can't create \"%ls\"\n", filePath.c_str());
+                    return FALSE;
+                }
+                for (UINT uLocalX = 0u; uLocalX < NUM_CHUNKS; ++uLocalX)
+                {
+                    if (FAILED(regionFile.SaveChunk(uLocalX, 0u, aBytes.data(), aBytes.size(), nullptr)))
+                    {
+                        return FALSE;
+                    }
+                }
+            }
+
+            // Entries of chunks 1 to 3 of the first row, each damaged in one field
+            {
+                std::fstream file(filePath, std::ios::binary | std::ios::in | std::ios::out);
+                library::VoxelRegionEntry aEntries[NUM_CHUNKS];
+                file.seekg(sizeof(library::VoxelRegionHeader));
+                file.read(reinterpret_cast<char*>(aEntries), sizeof(aEntries));
+
+                aEntries[1].uFirstSector += 1u << 20u;
+                aEntries[2].uCompressedSize = aEntries[2].uNumSectors * library::VoxelRegionFile::SECTOR_SIZE + 1u;
+                aEntries[3].uRawSize = static_cast<UINT32>(library::VoxelChunkStorage::GetMaxSerializedSize(REGION_HEIGHT) + 1u);
+
+                file.seekp(sizeof(library::VoxelRegionHeader));
+                file.write(reinterpret_cast<const char*>(aEntries), sizeof(aEntries));
+                if (!file.good())
+                {
+                    return FALSE;
+                }
+            }
+
+            library::VoxelRegionFile regionFile;
+            if (FAILED(regionFile.Open(filePath, REGION_HEIGHT)))
+            {
+                return FALSE;
+            }
+
+            BOOL bRejected = TRUE;
+            library::VoxelChunkStorage loadedChunk(REGION_HEIGHT);
+            bRejected = regionFile.LoadChunk(0u, 0u, loadedChunk) == S_OK && bRejected;
+            for (UINT uLocalX = 1u; uLocalX < NUM_CHUNKS; ++uLocalX)
+            {
+                bRejected = regionFile.LoadChunk(uLocalX, 0u, loadedChunk) == E_FAIL && !regionFile.HasChunk(uLocalX, 0u) && bRejected;
+            }
+            bRejected = SUCCEEDED(regionFile.SaveChunk(1u, 0u, aBytes.data(), aBytes.size(), nullptr))
+                && regionFile.LoadChunk(1u, 0u, loadedChunk) == S_OK && bRejected;
+
+            wprintf(L"corrupted header: %u damaged entries   %ls\n", NUM_CHUNKS - 1u, bRejected ? L"rejected ok" : L"NOT REJECTED");
+
+            return bRejected;
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: benchWorld
+
+          Summary:  Saves a generated size^2 grid to empty region files,
+                    reads it back, reads single chunks, then edits a
+                    few chunks and saves them through the writer with
+                    the per-frame budget. Prints one row per step
+
+          Args:     const std::filesystem::path& directoryPath
+                      Directory of the region files, emptied first
+                    UINT uSize
+                      Width and depth of the grid
+
+          Returns:  BOOL
+                      TRUE if the saved grids read back
+        F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+        BOOL benchWorld(_In_ const std::filesystem::path& directoryPath, _In_ UINT uSize)
+        {
+            std::unique_ptr<library::VoxelGrid> grid;
+            library::DensityGenerator generator(
+                library::DensityDesc
+                {
+                    .uWidth = uSize,
+                    .uHeight = REGION_HEIGHT,
+                    .uDepth = uSize,
+                    .uSeed = REGION_SEED,
+                }
+            );
+            if (FAILED(generator.Generate(grid)))
+            {
+                wprintf(L"Failed to generate a %ux%ux%u grid\n", uSize, REGION_HEIGHT, uSize);
+                return FALSE;
+            }
+
+            std::error_code error;
+            std::filesystem::remove_all(directoryPath, error);
+
+            const UINT uNumChunks = grid->GetNumChunksX() * grid->GetNumChunksZ();
+
+            // Full save into empty region files, every chunk gets new sectors
+            library::VoxelRegionStore store(directoryPath, REGION_HEIGHT, REGION_BYTES_PER_FRAME);
+            if (FAILED(store.Initialize()))
+            {
+                wprintf(L"Can't create \"%ls\"\n", directoryPath.c_str());
+                return FALSE;
+            }
+
+            Stopwatch stopwatch;
+            if (FAILED(store.SaveGrid(*grid)))
+            {
+                wprintf(L"Can't save the %u^2 grid\n", uSize);
+                return FALSE;
+            }
+            const DOUBLE saveTime = stopwatch.GetElapsedMilliseconds();
+            const library::VoxelRegionStats saveStats = store.GetStats();
+            const UINT64 uFileSize = getDirectorySize(directoryPath);
+
+            // Saving again rewrites every chunk in its own sectors
+            const DOUBLE resaveTime = MeasureBest(REGION_RUNS, [&]() { return SUCCEEDED(store.SaveGrid(*grid)); });
+
+            std::unique_ptr<library::VoxelGrid> readGrid;
+            BOOL bRoundTrip = TRUE;
+            const DOUBLE loadTime = MeasureBest(REGION_RUNS, [&]() { bRoundTrip = loadGrid(directoryPath, *grid, readGrid) && bRoundTrip; return TRUE; });
+            bRoundTrip = bRoundTrip && areGridsEqual(*grid, *readGrid);
+
+            std::mt19937 random(REGION_SEED);
+            std::vector<XMUINT2> aChunks(REGION_NUM_CHUNK_LOADS);
+            for (XMUINT2& chunk : aChunks)
+            {
+                chunk = XMUINT2(random() % grid->GetNumChunksX(), random() % grid->GetNumChunksZ());
+            }
+            const DOUBLE chunkTime = MeasureBest(REGION_RUNS, [&]()
+            {
+                for (const XMUINT2& chunk : aChunks)
+                {
+                    library::VoxelChunkStorage chunkStorage(REGION_HEIGHT);
+                    if (store.LoadChunk(chunk.x, chunk.y, chunkStorage) != S_OK)
+                    {
+                        return FALSE;
+                    }
+                }
+                return TRUE;
+            });
+
+            const DOUBLE rawMegabytes = static_cast<DOUBLE>(saveStats.uNumRawBytesSaved) / (1024.0 * 1024.0);
+            wprintf(L"%5u^2 %7u %9.2f %9.2f %6.2fx | %9.1f %9.1f %9.1f | %9.0f %9.0f %8.1f\n",
+                uSize, uNumChunks, rawMegabytes, static_cast<DOUBLE>(uFileSize) / (1024.0 * 1024.0),
+                static_cast<DOUBLE>(saveStats.uNumRawBytesSaved) / static_cast<DOUBLE>(std::max(saveStats.uNumCompressedBytesSaved, static_cast<UINT64>(1u))),
+                rawMegabytes * 1000.0 / saveTime, rawMegabytes * 1000.0 / resaveTime, rawMegabytes * 1000.0 / loadTime,
+                static_cast<DOUBLE>(uNumChunks) * 1000.0 / saveTime, static_cast<DOUBLE>(uNumChunks) * 1000.0 / loadTime,
+                chunkTime * 1000.0 / static_cast<DOUBLE>(REGION_NUM_CHUNK_LOADS));
+
+            // Incremental save: dig into a few chunks, then hand them to the writer one frame at a time
+            std::vector<UINT> auChunkIndices(uNumChunks);
+            for (UINT i = 0u; i < uNumChunks; ++i)
+            {
+                auChunkIndices[i] = i;
+            }
+            std::shuffle(auChunkIndices.begin(), auChunkIndices.end(), random);
+            auChunkIndices.resize(std::min(uNumChunks, REGION_NUM_EDITED_CHUNKS));
+
+            for (UINT uChunkIndex : auChunkIndices)
+            {
+                const UINT uChunkX = uChunkIndex % grid->GetNumChunksX();
+                const UINT uChunkZ = uChunkIndex / grid->GetNumChunksX();
+                for (UINT i = 0u; i < REGION_EDITS_PER_CHUNK; ++i)
+                {
+                    grid->SetBlock(
+                        uChunkX * library::VoxelGrid::CHUNK_SIZE + random() % library::VoxelGrid::CHUNK_SIZE,
+                        random() % REGION_HEIGHT,
+                        uChunkZ * library::VoxelGrid::CHUNK_SIZE + random() % library::VoxelGrid::CHUNK_SIZE,
+                        library::HeightMap::EMPTY_BLOCK
+                    );
+                }
+                store.MarkDirty(uChunkX, uChunkZ);
+            }
+
+            const library::VoxelRegionStats editStats = store.GetStats();
+            UINT uNumFrames = 0u;
+            UINT64 uMaxBytesPerFrame = 0u;
+            DOUBLE maxQueueTime = 0.0;
+            stopwatch.Restart();
+            while (store.GetStats().uNumDirtyChunks > 0u)
+            {
+                Stopwatch frameStopwatch;
+                store.QueueDirtyChunks(*grid);
+                maxQueueTime = std::max(maxQueueTime, frameStopwatch.GetElapsedMilliseconds());
+                uMaxBytesPerFrame = std::max(uMaxBytesPerFrame, store.GetStats().uNumBytesQueuedLastFrame);
+                ++uNumFrames;
+            }
+            HRESULT hr = store.Flush(*grid);
+            const DOUBLE incrementalTime = stopwatch.GetElapsedMilliseconds();
+            const library::VoxelRegionStats flushStats = store.GetStats();
+
+            bRoundTrip = SUCCEEDED(hr) && loadGrid(directoryPath, *grid, readGrid) && areGridsEqual(*grid, *readGrid) && bRoundTrip;
+
+            wprintf(L"        %u chunks edited: %u frames, %.1f KB max per frame, %.3f ms max to queue, %.2f ms to write %.1f KB, file +%lld KB   %ls\n",
+                static_cast<UINT>(auChunkIndices.size()), uNumFrames, static_cast<DOUBLE>(uMaxBytesPerFrame) / 1024.0, maxQueueTime,
+                incrementalTime, static_cast<DOUBLE>(flushStats.uNumRawBytesSaved - editStats.uNumRawBytesSaved) / 1024.0,
+                (static_cast<INT64>(getDirectorySize(directoryPath)) - static_cast<INT64>(uFileSize)) / 1024,
+                bRoundTrip ? L"round trip ok" : L"MISMATCH");
+
+            std::filesystem::remove_all(directoryPath, error);
+
+            return bRoundTrip;
+        }
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: RunBenchRegion
+
+      Summary:  Saves generated density grids of 256^2, 512^2 and
+                1024^2 blocks to region files and reports the load
+                and save throughput, the compression ratio, the time
+                of a single chunk and the frames, bytes per frame and
+                file growth of an incremental save of edited chunks.
+                Checks that the codec and the saved grids round trip
+                and that damaged region file entries are rejected
+
+      Args:     INT argc
+                  Number of arguments
+                PWSTR* argv
+                  [directory]
+
+      Returns:  INT
+                  0 on success
+    F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+    INT RunBenchRegion(_In_ INT argc, _In_reads_(argc) PWSTR* argv)
+    {
+        std::filesystem::path directoryPath = argc > 0 ? std::filesystem::path(argv[0]) : std::filesystem::path(L"RegionBench");
+
+        // The codec must restore bytes without any repetition as well as long runs
+        std::vector<BYTE> aBytes(1u << 16u);
+        std::mt19937 random(REGION_SEED);
+        for (size_t i = 0u; i < aBytes.size(); ++i)
+        {
+            aBytes[i] = i < aBytes.size() / 2u ? static_cast<BYTE>(random()) : static_cast<BYTE>(i / 1024u);
+        }
+        std::vector<BYTE> aCompressedBytes;
+        std::vector<BYTE> aRawBytes;
+        library::VoxelRegionFile::Compress(aBytes.data(), aBytes.size(), aCompressedBytes);
+        BOOL bRoundTrip = library::VoxelRegionFile::Decompress(aCompressedBytes.data(), aCompressedBytes.size(), aBytes.size(), aRawBytes) && aRawBytes == aBytes;
+        wprintf(L"codec: %llu bytes to %llu   %ls\n", static_cast<UINT64>(aBytes.size()), static_cast<UINT64>(aCompressedBytes.size()), bRoundTrip ? L"round trip ok" : L"MISMATCH");
+
+        bRoundTrip = checkCorruptedHeader(directoryPath) && bRoundTrip;
+
+        wprintf(L"%7ls %7ls %9ls %9ls %7ls | %9ls %9ls %9ls | %9ls %9ls %8ls\n",
+            L"world", L"chunks", L"raw MB", L"file MB", L"ratio", L"save MB/s", L"rewr MB/s", L"load MB/s", L"save ch/s", L"load ch/s", L"chunk us");
+
+        constexpr const UINT aSizes[] = { 256u, 512u, 1024u };
+        for (UINT uSize : aSizes)
+        {
+            bRoundTrip = benchWorld(directoryPath, uSize) && bRoundTrip;
+        }
+
+        return bRoundTrip ? 0 : 1;
+    }
+}
\ No newline at end of file
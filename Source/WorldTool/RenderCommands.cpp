@@ -0,0 +1,576 @@
+/*+===================================================================
+  File:      RENDERCOMMANDS.CPP
+
+  Summary:   Rendering commands of the world tool: initializes the
+             renderer and the sample scene on the null render device
+             and reports the device calls, uploads, state changes and
+             draws of every frame without a GPU.
+
+  Classes:   BenchCube
+
+  Functions: RunBenchRender, RunBenchUpload
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+
+#include "Commands.h"
+
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <vector>
+
+#include "BenchmarkMap.h"
+#include "Light/PointLight.h"
+#include "Renderer/NullRenderDevice.h"
+#include "Renderer/Renderable.h"
+#include "Renderer/Renderer.h"
+#include "Renderer/Skybox.h"
+#include "Renderer/UploadArena.h"
+#include "Scene/Scene.h"
+#include "Shader/PixelShader.h"
+#include "Shader/SkyMapVertexShader.h"
+#include "Shader/TerrainVertexShader.h"
+#include "Shader/VoxelChunkVertexShader.h"
+#include "Shader/VoxelColumnVertexShader.h"
+#include "Shader/VoxelCompactVertexShader.h"
+#include "Stopwatch.h"
+
+namespace worldtool
+{
+    namespace
+    {
+        constexpr const UINT RENDER_DEFAULT_SIZE = 256u;
+        constexpr const UINT RENDER_DEFAULT_FRAMES = 120u;
+        constexpr const UINT RENDER_WIDTH = 1280u;
+        constexpr const UINT RENDER_HEIGHT = 720u;
+        constexpr const FLOAT RENDER_FRAME_TIME = 1.0f / 60.0f;
+        constexpr const FLOAT RENDER_OBJECT_SPACING = 4.0f;
+        constexpr const UINT UPLOAD_DEFAULT_ALLOCATIONS = 4096u;
+        constexpr const UINT UPLOAD_DEFAULT_ALLOCATION_SIZE = 1024u;
+        constexpr const UINT UPLOAD_DEFAULT_FRAMES = 600u;
+        constexpr const UINT UPLOAD_ALIGNMENT = 16u;
+
+        /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+            Struct:   ObjectShaderName
+
+            Summary:  Shaders of the stress objects, the objects take
+                      them in turn so that their draws change shaders
+        S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+        struct ObjectShaderName
+        {
+            PCWSTR pszName;
+            PCWSTR pszFileName;
+            PCSTR pszVertexEntryPoint;
+            PCSTR pszPixelEntryPoint;
+        };
+
+        constexpr const ObjectShaderName OBJECT_SHADERS[] =
+        {
+            { L"PhongShader", L"Shaders/PhongShaders.fxh", "VSPhong", "PSPhong" },
+            { L"LightShader", L"Shaders/PhongShaders.fxh", "VSLightCube", "PSLightCube" },
+            { L"EnvironmentMapShader", L"Shaders/Shaders.fxh", "VSEnvironmentMap", "PSEnvironmentMap" },
+        };
+
+        /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+          Class:    BenchCube
+
+          Summary:  Untextured unit cube of the stress scene, one draw
+                    with its own buffers like the cubes of the game
+
+          Methods:  Initialize
+                      Creates the buffers of the cube
+                    Update
+                      Does nothing, the cube does not move
+                    GetNumVertices
+                      Returns the number of vertices
+                    GetNumIndices
+                      Returns the number of indices
+                    BenchCube
+                      Constructor.
+                    ~BenchCube
+                      Destructor.
+        C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+        class BenchCube : public library::Renderable
+        {
+        public:
+            BenchCube(_In_ const XMFLOAT4& outputColor) : Renderable(outputColor) {}
+            BenchCube(const BenchCube& other) = delete;
+            BenchCube(BenchCube&& other) = delete;
+            BenchCube& operator=(const BenchCube& other) = delete;
+            BenchCube& operator=(BenchCube&& other) = delete;
+            ~BenchCube() = default;
+
+            HRESULT Initialize(_In_ library::RenderDevice* pDevice) override { return initialize(pDevice); }
+            void Update(_In_ FLOAT deltaTime) override { UNREFERENCED_PARAMETER(deltaTime); }
+
+            UINT GetNumVertices() const override { return ARRAYSIZE(VERTICES); }
+            UINT GetNumIndices() const override { return ARRAYSIZE(INDICES); }
+
+        protected:
+            const library::SimpleVertex* getVertices() const override { return VERTICES; }
+            const WORD* getIndices() const override { return INDICES; }
+
+        private:
+            static constexpr const library::SimpleVertex VERTICES[] =
+            {
+                { .Position = XMFLOAT3(-1.0f,  1.0f, -1.0f), .TexCoord = XMFLOAT2(0.0f, 0.0f), .Normal = XMFLOAT3(-1.0f,  1.0f, -1.0f) },
+                { .Position = XMFLOAT3( 1.0f,  1.0f, -1.0f), .TexCoord = XMFLOAT2(1.0f, 0.0f), .Normal = XMFLOAT3( 1.0f,  1.0f, -1.0f) },
+                { .Position = XMFLOAT3( 1.0f,  1.0f,  1.0f), .TexCoord = XMFLOAT2(1.0f, 1.0f), .Normal = XMFLOAT3( 1.0f,  1.0f,  1.0f) },
+                { .Position = XMFLOAT3(-1.0f,  1.0f,  1.0f), .TexCoord = XMFLOAT2(0.0f, 1.0f), .Normal = XMFLOAT3(-1.0f,  1.0f,  1.0f) },
+                { .Position = XMFLOAT3(-1.0f, -1.0f, -1.0f), .TexCoord = XMFLOAT2(0.0f, 1.0f), .Normal = XMFLOAT3(-1.0f, -1.0f, -1.0f) },
+                { .Position = XMFLOAT3( 1.0f, -1.0f, -1.0f), .TexCoord = XMFLOAT2(1.0f, 1.0f), .Normal = XMFLOAT3( 1.0f, -1.0f, -1.0f) },
+                { .Position = XMFLOAT3( 1.0f, -1.0f,  1.0f), .TexCoord = XMFLOAT2(1.0f, 0.0f), .Normal = XMFLOAT3( 1.0f, -1.0f,  1.0f) },
+                { .Position = XMFLOAT3(-1.0f, -1.0f,  1.0f), .TexCoord = XMFLOAT2(0.0f, 0.0f), .Normal = XMFLOAT3(-1.0f, -1.0f,  1.0f) },
+            };
+            static constexpr const WORD INDICES[] =
+            {
+                3,1,0, 2,1,3,
+                6,4,5, 7,4,6,
+                3,4,7, 0,4,3,
+                1,6,5, 2,6,1,
+                0,5,4, 1,5,0,
+                2,7,6, 3,7,2,
+            };
+        };
+
+        /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+            Struct:   BuildModeName
+
+            Summary:  Command line name of a voxel build mode
+        S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+        struct BuildModeName
+        {
+            PCWSTR pszName;
+            library::eVoxelBuildMode buildMode;
+        };
+
+        constexpr const BuildModeName BUILD_MODES[] =
+        {
+            { L"instanced", library::eVoxelBuildMode::INSTANCED },
+            { L"exposed", library::eVoxelBuildMode::INSTANCED_EXPOSED },
+            { L"chunked", library::eVoxelBuildMode::CHUNKED },
+            { L"streamed", library::eVoxelBuildMode::STREAMED },
+            { L"lod", library::eVoxelBuildMode::LOD },
+            { L"smooth", library::eVoxelBuildMode::SMOOTH },
+        };
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+
+          Function: createScene
+
+          Summary:  Creates the sample scene of the game: the voxel,
+                    chunk and terrain shaders, the sky box and the
+                    light. The models are left out, loading them needs
+                    their files
+
+          Args:     const std::filesystem::path& heightMapPath
+                      Height map of the voxels
+                    eVoxelBuildMode buildMode
+                      How the voxels are turned into draws
+
+          Returns:  std::shared_ptr<library::Scene>
+                      The scene, null on failure
+
+        F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+        std::shared_ptr<library::Scene> createScene(_In_ const std::filesystem::path& heightMapPath, _In_ library::eVoxelBuildMode buildMode)
+        {
+            std::shared_ptr<library::Scene> scene = std::make_shared<library::Scene>(heightMapPath, buildMode);
+
+            std::shared_ptr<library::SkyMapVertexShader> cubeMapVertexShader = std::make_shared<library::SkyMapVertexShader>(L"Shaders/CubeMap.fxh", "VSCubeMap", "vs_5_0");
+            std::shared_ptr<library::PixelShader> cubeMapPixelShader = std::make_shared<library::PixelShader>(L"Shaders/CubeMap.fxh", "PSCubeMap", "ps_5_0");
+            if (FAILED(scene->AddVertexShader(L"VoxelShader", std::make_shared<library::VertexShader>(L"Shaders/VoxelShaders.fxh", "VSVoxel", "vs_5_0")))
+                || FAILED(scene->AddVertexShader(L"VoxelChunkShader", std::make_shared<library::VoxelChunkVertexShader>(L"Shaders/VoxelShaders.fxh", "VSVoxelChunk", "vs_5_0")))
+                || FAILED(scene->AddVertexShader(L"TerrainShader", std::make_shared<library::TerrainVertexShader>(L"Shaders/VoxelShaders.fxh", "VSTerrain", "vs_5_0")))
+                || FAILED(scene->AddVertexShader(L"CubeMapShader", cubeMapVertexShader))
+                || FAILED(scene->AddPixelShader(L"VoxelShader", std::make_shared<library::PixelShader>(L"Shaders/VoxelShaders.fxh", "PSVoxel", "ps_5_0")))
+                || FAILED(scene->AddPixelShader(L"VoxelChunkShader", std::make_shared<library::PixelShader>(L"Shaders/VoxelShaders.fxh", "PSVoxelChunk", "ps_5_0")))
+                || FAILED(scene->AddPixelShader(L"CubeMapShader", cubeMapPixelShader)))
+            {
+                return nullptr;
+            }
+
+            if (FAILED(scene->SetVertexShaderOfVoxel(L"VoxelShader"))
+                || FAILED(scene->SetPixelShaderOfVoxel(L"VoxelShader"))
+                || FAILED(scene->SetVertexShaderOfVoxelChunk(L"VoxelChunkShader"))
+                || FAILED(scene->SetPixelShaderOfVoxelChunk(L"VoxelChunkShader"))
+                || FAILED(scene->SetVertexShaderOfTerrain(L"TerrainShader"))
+                || FAILED(scene->SetPixelShaderOfTerrain(L"VoxelChunkShader")))
+            {
+                return nullptr;
+            }
+
+            std::shared_ptr<library::Skybox> skybox = std::make_shared<library::Skybox>(L"Content/Common/Maskonaive2_1024.dds", 500.0f);
+            skybox->SetVertexShader(cubeMapVertexShader);
+            skybox->SetPixelShader(cubeMapPixelShader);
+            if (FAILED(scene->AddSkyBox(skybox)))
+            {
+                return nullptr;
+            }
+
+            XMFLOAT4 color;
+            XMStoreFloat4(&color, Colors::WhiteSmoke);
+            if (FAILED(scene->AddPointLight(0, std::make_shared<library::PointLight>(XMFLOAT4(0.0f, 30.0f, 0.0f, 1.0f), color, 45.0f))))
+            {
+                return nullptr;
+            }
+
+            return scene;
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+
+          Function: addObjects
+
+          Summary:  Adds the stress objects to the scene: cubes on a
+                    square grid above the map, taking the object
+                    shaders in turn so that neighbouring objects never
+                    share them
+
+          Args:     library::Scene& scene
+                      Scene of the objects
+                    UINT uNumObjects
+                      Number of cubes
+
+          Returns:  HRESULT
+                      Status code
+
+        F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+        HRESULT addObjects(_In_ library::Scene& scene, _In_ UINT uNumObjects)
+        {
+            HRESULT hr = S_OK;
+
+            for (const ObjectShaderName& shader : OBJECT_SHADERS)
+            {
+                hr = scene.AddVertexShader(shader.pszName, std::make_shared<library::VertexShader>(shader.pszFileName, shader.pszVertexEntryPoint, "vs_5_0"));
+                if (FAILED(hr))
+                {
+                    return hr;
+                }
+                hr = scene.AddPixelShader(shader.pszName, std::make_shared<library::PixelShader>(shader.pszFileName, shader.pszPixelEntryPoint, "ps_5_0"));
+                if (FAILED(hr))
+                {
+                    return hr;
+                }
+            }
+
+            XMFLOAT4 color;
+            XMStoreFloat4(&color, Colors::White);
+
+            const UINT uRowLength = static_cast<UINT>(std::ceil(std::sqrt(static_cast<FLOAT>(uNumObjects))));
+            for (UINT i = 0u; i < uNumObjects; ++i)
+            {
+                std::shared_ptr<BenchCube> cube = std::make_shared<BenchCube>(color);
+                cube->Translate(XMVectorSet(
+                    static_cast<FLOAT>(i % uRowLength) * RENDER_OBJECT_SPACING,
+                    40.0f,
+                    static_cast<FLOAT>(i / uRowLength) * RENDER_OBJECT_SPACING,
+                    0.0f));
+
+                const std::wstring name = L"Object" + std::to_wstring(i);
+                const PCWSTR pszShaderName = OBJECT_SHADERS[i % ARRAYSIZE(OBJECT_SHADERS)].pszName;
+                hr = scene.AddRenderable(name.c_str(), cube);
+                if (FAILED(hr))
+                {
+                    return hr;
+                }
+                hr = scene.SetVertexShaderOfRenderable(name.c_str(), pszShaderName);
+                if (FAILED(hr))
+                {
+                    return hr;
+                }
+                hr = scene.SetPixelShaderOfRenderable(name.c_str(), pszShaderName);
+                if (FAILED(hr))
+                {
+                    return hr;
+                }
+            }
+
+            return hr;
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+
+          Function: printStats
+
+          Summary:  Prints the calls of the null device, per frame when
+                    more than one frame was recorded
+
+          Args:     PCWSTR pszLabel
+                      Name of the recorded work
+                    const library::RenderDeviceStats& stats
+                      Recorded calls
+                    UINT uNumFrames
+                      Number of frames the calls were recorded over
+
+        F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+        void printStats(_In_ PCWSTR pszLabel, _In_ const library::RenderDeviceStats& stats, _In_ UINT uNumFrames)
+        {
+            const DOUBLE frames = static_cast<DOUBLE>(uNumFrames);
+
+            wprintf(L"%-12ls %10.1f %10.1f %10.1f %14.1f %10.1f %10.1f %14.1f\n",
+                pszLabel,
+                static_cast<DOUBLE>(stats.uNumCalls) / frames,
+                static_cast<DOUBLE>(stats.uNumCreatedResources) / frames,
+                static_cast<DOUBLE>(stats.uNumUploads) / frames,
+                static_cast<DOUBLE>(stats.uNumInitialBytes + stats.uNumUploadedBytes) / frames / 1024.0,
+                static_cast<DOUBLE>(stats.uNumStateChanges) / frames,
+                static_cast<DOUBLE>(stats.uNumDraws) / frames,
+                static_cast<DOUBLE>(stats.uNumDrawnIndices) / frames);
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+
+          Function: printQueueStats
+
+          Summary:  Prints the draws of the render queue of the last
+                    frame, with the state calls binding every draw in
+                    full would take against the state changes the
+                    sorted queue issued, and the state calls of the
+                    frame the state filter passed to the device and
+                    dropped, the constants the frame wrote to the
+                    constant buffer ring and the geometry it wrote to
+                    the vertex upload arena. The pipelines are the
+                    unique ones the renderables of the scene collapse
+                    to, with the pipeline switches of the frame and the
+                    state calls a draw cost
+
+          Args:     const library::RenderQueueStats& stats
+                      Work of the last submission
+                    const library::StateFilterStats& filterStats
+                      State calls of the last frame
+                    const library::ConstantBufferRingStats& ringStats
+                      Constants of the last frame
+                    const library::UploadArenaStats& uploadStats
+                      Transient vertex data of the last frame
+                    const library::PipelineStateCache& pipelineStates
+                      Pipelines of the renderables
+
+        F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+        void printQueueStats(_In_ const library::RenderQueueStats& stats, _In_ const library::StateFilterStats& filterStats, _In_ const library::ConstantBufferRingStats& ringStats, _In_ const library::UploadArenaStats& uploadStats, _In_ const library::PipelineStateCache& pipelineStates)
+        {
+            wprintf(L"Render queue: %llu draws (%llu transparent), %llu state changes instead of %llu unsorted\n",
+                stats.uNumDraws,
+                stats.uNumTransparentDraws,
+                stats.uNumStateChanges,
+                stats.uNumBindings);
+            wprintf(L"State filter: %llu state calls issued, %llu redundant ones filtered\n",
+                filterStats.uNumIssuedCalls,
+                filterStats.uNumFilteredCalls);
+            wprintf(L"Constant buffer ring: %llu constant blocks in %llu maps (%llu discarding), %.1f KiB uploaded\n",
+                ringStats.uNumAllocations,
+                ringStats.uNumMaps,
+                ringStats.uNumDiscards,
+                static_cast<DOUBLE>(ringStats.uNumUploadedBytes) / 1024.0);
+            wprintf(L"Vertex upload arena: %llu allocations in %llu maps, %.1f KiB uploaded\n",
+                uploadStats.uNumAllocations,
+                uploadStats.uNumMaps,
+                static_cast<DOUBLE>(uploadStats.uNumUploadedBytes) / 1024.0);
+            wprintf(L"Pipeline states: %u unique for %llu renderables, %llu switches, %.2f state calls per draw\n",
+                pipelineStates.GetNumPipelineStates(),
+                pipelineStates.GetNumRequests(),
+                stats.uNumPipelineChanges,
+                stats.uNumDraws > 0u ? static_cast<DOUBLE>(stats.uNumStateChanges) / static_cast<DOUBLE>(stats.uNumDraws) : 0.0);
+        }
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+
+      Function: RunBenchRender
+
+      Summary:  Initializes the renderer and the sample scene of the
+                given height map, or of a size^2 benchmark map, on the
+                null render device and renders frames while the camera
+                walks forward, with the given number of cubes above the
+                map as a stress scene of many objects. Prints the device
+                calls of the initialization and of an average frame:
+                the resources created, the uploads and their bytes, the
+                state changes and the draws, with the CPU time of a
+                frame, the state changes of the render queue and the
+                pipeline states the scene collapses to
+
+      Args:     INT argc
+                  Number of arguments
+                PWSTR* argv
+                  [heightmap|size] [instanced|exposed|chunked|streamed|
+                  lod|smooth] [frames] [objects]
+
+      Returns:  INT
+                  0 on success, 1 when the renderer fails
+    F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+    INT RunBenchRender(_In_ INT argc, _In_reads_(argc) PWSTR* argv)
+    {
+        UINT uSize = 0u;
+        std::filesystem::path heightMapPath = argc > 0 ? argv[0] : L"";
+        if (ParseUint(argc, argv, 0, RENDER_DEFAULT_SIZE, uSize) && uSize > 0u)
+        {
+            // The scene loads its voxels from a file, so the benchmark map is written out first
+            heightMapPath = std::filesystem::temp_directory_path() / L"WorldToolBenchRender.bin";
+            if (FAILED(CreateBenchmarkMap(uSize).SaveToBinary(heightMapPath)))
+            {
+                wprintf(L"Failed to write %ls\n", heightMapPath.c_str());
+                return 1;
+            }
+        }
+
+        library::eVoxelBuildMode buildMode = library::eVoxelBuildMode::INSTANCED;
+        if (argc > 1)
+        {
+            const BuildModeName* pMode = nullptr;
+            for (const BuildModeName& mode : BUILD_MODES)
+            {
+                if (wcscmp(argv[1], mode.pszName) == 0)
+                {
+                    pMode = &mode;
+                }
+            }
+            if (!pMode)
+            {
+                wprintf(L"bench-render [heightmap|size] [instanced|exposed|chunked|streamed|lod|smooth] [frames] [objects]\n");
+                return 1;
+            }
+            buildMode = pMode->buildMode;
+        }
+
+        UINT uNumFrames = 0u;
+        if (!ParseUint(argc, argv, 2, RENDER_DEFAULT_FRAMES, uNumFrames) || uNumFrames == 0u)
+        {
+            wprintf(L"bench-render [heightmap|size] [instanced|exposed|chunked|streamed|lod|smooth] [frames] [objects]\n");
+            return 1;
+        }
+
+        UINT uNumObjects = 0u;
+        if (!ParseUint(argc, argv, 3, 0u, uNumObjects))
+        {
+            wprintf(L"bench-render [heightmap|size] [instanced|exposed|chunked|streamed|lod|smooth] [frames] [objects]\n");
+            return 1;
+        }
+
+        std::shared_ptr<library::Scene> scene = createScene(heightMapPath, buildMode);
+        if (!scene || FAILED(addObjects(*scene, uNumObjects)))
+        {
+            wprintf(L"Failed to create the scene\n");
+            return 1;
+        }
+
+        std::shared_ptr<library::NullRenderDevice> device = std::make_shared<library::NullRenderDevice>();
+        library::Renderer renderer;
+        if (FAILED(renderer.AddScene(L"VoxelMap", scene)) || FAILED(renderer.SetMainScene(L"VoxelMap")))
+        {
+            return 1;
+        }
+
+        Stopwatch stopwatch;
+        if (FAILED(renderer.InitializeHeadless(device, RENDER_WIDTH, RENDER_HEIGHT)))
+        {
+            wprintf(L"Failed to initialize the renderer on %ls\n", heightMapPath.c_str());
+            return 1;
+        }
+        const DOUBLE initializeTime = stopwatch.GetElapsedMilliseconds();
+
+        wprintf(L"%-12ls %10ls %10ls %10ls %14ls %10ls %10ls %14ls\n", L"", L"calls", L"created", L"uploads", L"KiB", L"states", L"draws", L"indices");
+        printStats(L"initialize", device->GetStats(), 1u);
+        device->ResetStats();
+
+        // Walks forward so that the streamed and level of detail modes keep rebuilding around the camera
+        const library::DirectionsInput directions = { .bFront = TRUE };
+        const library::MouseRelativeMovement mouseRelativeMovement = {};
+
+        stopwatch.Restart();
+        for (UINT uFrame = 0u; uFrame < uNumFrames; ++uFrame)
+        {
+            renderer.HandleInput(directions, mouseRelativeMovement, RENDER_FRAME_TIME);
+            renderer.Update(RENDER_FRAME_TIME);
+            renderer.Render();
+        }
+        const DOUBLE frameTime = stopwatch.GetElapsedMilliseconds() / static_cast<DOUBLE>(uNumFrames);
+
+        printStats(L"per frame", device->GetStats(), uNumFrames);
+        printQueueStats(renderer.GetRenderQueueStats(), renderer.GetStateFilterStats(), renderer.GetConstantBufferRingStats(), renderer.GetVertexUploadArena().GetStats(), renderer.GetPipelineStateCache());
+        wprintf(L"Initialized in %.1f ms, %.3f ms of CPU time per frame over %u frames\n", initializeTime, frameTime, uNumFrames);
+
+        return 0;
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+
+      Function: RunBenchUpload
+
+      Summary:  Writes the given number of allocations of the given
+                size to a vertex upload arena on the null render device
+                every frame, like the instances of particles or debug
+                lines would be. Prints the megabytes and the allocations
+                of a frame, the maps and the pages they took and the CPU
+                time and throughput of the copies. The fences of the null
+                device pass at once, so the pages are those of a GPU
+                that keeps up with the frames
+
+      Args:     INT argc
+                  Number of arguments
+                PWSTR* argv
+                  [allocations] [allocationSize] [frames]
+
+      Returns:  INT
+                  0 on success, 1 when the arena fails
+    F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+    INT RunBenchUpload(_In_ INT argc, _In_reads_(argc) PWSTR* argv)
+    {
+        UINT uNumAllocations = 0u;
+        UINT uAllocationSize = 0u;
+        UINT uNumFrames = 0u;
+        if (!ParseUint(argc, argv, 0, UPLOAD_DEFAULT_ALLOCATIONS, uNumAllocations) || uNumAllocations == 0u
+            || !ParseUint(argc, argv, 1, UPLOAD_DEFAULT_ALLOCATION_SIZE, uAllocationSize) || uAllocationSize == 0u
+            || !ParseUint(argc, argv, 2, UPLOAD_DEFAULT_FRAMES, uNumFrames) || uNumFrames == 0u)
+        {
+            wprintf(L"bench-upload [allocations] [allocationSize] [frames]\n");
+            return 1;
+        }
+
+        std::shared_ptr<library::NullRenderDevice> device = std::make_shared<library::NullRenderDevice>();
+        library::UploadArena arena(D3D11_BIND_VERTEX_BUFFER, library::UploadArena::DEFAULT_PAGE_SIZE);
+        const std::vector<BYTE> aData(uAllocationSize, 0xABu);
+
+        UINT64 uNumAllocated = 0ull;
+        UINT64 uNumUploadedBytes = 0ull;
+        UINT64 uNumMaps = 0ull;
+
+        Stopwatch stopwatch;
+        for (UINT uFrame = 0u; uFrame < uNumFrames; ++uFrame)
+        {
+            arena.Begin();
+            for (UINT i = 0u; i < uNumAllocations; ++i)
+            {
+                library::UploadAllocation allocation;
+                if (FAILED(arena.Upload(device.get(), aData.data(), uAllocationSize, UPLOAD_ALIGNMENT, allocation)))
+                {
+                    wprintf(L"Failed to allocate %u bytes in frame %u\n", uAllocationSize, uFrame);
+                    return 1;
+                }
+            }
+            arena.End(device.get());
+            arena.Fence(device.get());
+
+            const library::UploadArenaStats& stats = arena.GetStats();
+            uNumAllocated += stats.uNumAllocations;
+            uNumUploadedBytes += stats.uNumUploadedBytes;
+            uNumMaps += stats.uNumMaps;
+        }
+        const DOUBLE elapsedTime = stopwatch.GetElapsedMilliseconds();
+
+        const DOUBLE frames = static_cast<DOUBLE>(uNumFrames);
+        const DOUBLE megabytes = static_cast<DOUBLE>(uNumUploadedBytes) / (1024.0 * 1024.0);
+        wprintf(L"%.2f MB and %.0f allocations per frame in %.1f maps, %u pages of %u KiB\n",
+            megabytes / frames,
+            static_cast<DOUBLE>(uNumAllocated) / frames,
+            static_cast<DOUBLE>(uNumMaps) / frames,
+            arena.GetNumPages(),
+            library::UploadArena::DEFAULT_PAGE_SIZE / 1024u);
+        wprintf(L"%.3f ms of CPU time per frame, %.1f ns per allocation, %.0f MB/s over %u frames\n",
+            elapsedTime / frames,
+            elapsedTime * 1000000.0 / static_cast<DOUBLE>(uNumAllocated),
+            elapsedTime > 0.0 ? megabytes * 1000.0 / elapsedTime : 0.0,
+            uNumFrames);
+
+        return 0;
+    }
+}
\ No newline at end of file
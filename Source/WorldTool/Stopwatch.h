@@ -0,0 +1,95 @@
+/*+===================================================================
+  File:      STOPWATCH.H
+
+  Summary:   Stopwatch header file contains the high resolution timer
+             used by the benchmarks of the world tool.
+
+  Classes: Stopwatch
+
+  Functions: MeasureBest
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+namespace worldtool
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    Stopwatch
+
+      Summary:  Measures elapsed time with QueryPerformanceCounter
+
+      Methods:  Restart
+                  Restarts the measurement
+                GetElapsedMilliseconds
+                  Returns the time elapsed since the last restart
+                Stopwatch
+                  Constructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class Stopwatch
+    {
+    public:
+        Stopwatch()
+            : m_frequency()
+            , m_start()
+        {
+            QueryPerformanceFrequency(&m_frequency);
+            Restart();
+        }
+
+        void Restart()
+        {
+            QueryPerformanceCounter(&m_start);
+        }
+
+        DOUBLE GetElapsedMilliseconds() const
+        {
+            LARGE_INTEGER now;
+            QueryPerformanceCounter(&now);
+
+            return static_cast<DOUBLE>(now.QuadPart - m_start.QuadPart) * 1000.0 / static_cast<DOUBLE>(m_frequency.QuadPart);
+        }
+
+    private:
+        LARGE_INTEGER m_frequency;
+        LARGE_INTEGER m_start;
+    };
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: MeasureBest
+
+      Summary:  Runs the given work several times and returns the
+                fastest run
+
+      Args:     UINT uNumRuns
+                  Number of runs
+                const Work& work
+                  Work to measure, returning FALSE on failure
+
+      Returns:  DOUBLE
+                  Fastest run in milliseconds, negative on failure
+    F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+    template <class Work>
+    DOUBLE MeasureBest(_In_ UINT uNumRuns, _In_ const Work& work)
+    {
+        DOUBLE best = -1.0;
+        for (UINT i = 0u; i < uNumRuns; ++i)
+        {
+            Stopwatch stopwatch;
+            if (!work())
+            {
+                return -1.0;
+            }
+
+            DOUBLE elapsed = stopwatch.GetElapsedMilliseconds();
+            if (best < 0.0 || elapsed < best)
+            {
+                best = elapsed;
+            }
+        }
+
+        return best;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,268 @@
+/*+===================================================================
+  File:      STORAGECOMMANDS.CPP
+
+  Summary:   Storage commands of the world tool: measures the bytes per
+             block of the palette and run-length encoded voxel grid on
+             benchmark and generated terrain, its serialized size and
+             its random access time next to a dense array of blocks.
+
+  Functions: RunBenchStorage
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+
+#include "Commands.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+
+#include "BenchmarkMap.h"
+#include "Scene/TerrainGenerator.h"
+#include "Scene/VoxelGrid.h"
+#include "Stopwatch.h"
+
+namespace worldtool
+{
+    namespace
+    {
+        constexpr const UINT STORAGE_DEFAULT_SIZE = 1024u;
+        constexpr const UINT STORAGE_RUNS = 3u;
+
+        // Same terrain, edits and lookups on every run
+        constexpr const UINT STORAGE_SEED = 7u;
+        constexpr const UINT STORAGE_NUM_EDITS = 100000u;
+        constexpr const UINT STORAGE_NUM_LOOKUPS = 1u << 22u;
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: EditRandomBlocks
+
+          Summary:  Sets random blocks of the grid to random types, or
+                    clears them, which splits the runs of the columns
+                    like caves and buildings would
+
+          Args:     library::VoxelGrid& grid
+                      Grid to edit
+
+          Returns:  DOUBLE
+                      Time of an edit in microseconds
+        F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+        DOUBLE EditRandomBlocks(_Inout_ library::VoxelGrid& grid)
+        {
+            const UINT uNumTypes = static_cast<UINT>(grid.GetPalette().size());
+            std::mt19937 generator(STORAGE_SEED);
+
+            Stopwatch stopwatch;
+            for (UINT i = 0u; i < STORAGE_NUM_EDITS; ++i)
+            {
+                UINT x = generator() % grid.GetWidth();
+                UINT y = generator() % grid.GetHeight();
+                UINT z = generator() % grid.GetDepth();
+                CHAR blockType = (generator() & 1u) != 0u ?
+                    library::HeightMap::EMPTY_BLOCK : static_cast<CHAR>(static_cast<UINT>(library::eBlockType::GRASSLAND) + generator() % uNumTypes);
+
+                grid.SetBlock(x, y, z, blockType);
+            }
+
+            return stopwatch.GetElapsedMilliseconds() * 1000.0 / static_cast<DOUBLE>(STORAGE_NUM_EDITS);
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: PrintStorageStats
+
+          Summary:  Prints the blocks of the grid, the bytes per block
+                    in memory and serialized, and the time of a random
+                    lookup in the grid and in a dense array of the same
+                    blocks. Checks that the serialized chunks read back
+                    into the same blocks
+
+          Args:     PCWSTR pszName
+                      Name of the terrain in the table
+                    const library::HeightMap& heightMap
+                      Height map the grid is built from
+                    const library::VoxelGrid& grid
+                      Grid to measure
+
+          Returns:  BOOL
+                      TRUE if the serialized chunks read back
+        F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+        BOOL PrintStorageStats(_In_ PCWSTR pszName, _In_ const library::HeightMap& heightMap, _In_ const library::VoxelGrid& grid)
+        {
+            const UINT uWidth = grid.GetWidth();
+            const UINT uHeight = grid.GetHeight();
+            const UINT uDepth = grid.GetDepth();
+            const UINT64 uNumCells = static_cast<UINT64>(uWidth) * uHeight * uDepth;
+
+            // Dense copy of the blocks, the layout the grid replaces
+            std::vector<CHAR> aDenseBlocks(static_cast<size_t>(uNumCells), library::HeightMap::EMPTY_BLOCK);
+            std::vector<library::VoxelRun> aRuns;
+            UINT64 uNumBlocks = 0u;
+            UINT64 uNumRuns = 0u;
+            for (UINT z = 0u; z < uDepth; ++z)
+            {
+                for (UINT x = 0u; x < uWidth; ++x)
+                {
+                    grid.GetColumnRuns(x, z, aRuns);
+                    uNumRuns += aRuns.size();
+
+                    UINT uRunStart = 0u;
+                    for (const library::VoxelRun& run : aRuns)
+                    {
+                        if (run.blockType != library::HeightMap::EMPTY_BLOCK)
+                        {
+                            uNumBlocks += run.uEnd - uRunStart;
+                            std::fill(aDenseBlocks.begin() + (static_cast<size_t>(z) * uWidth + x) * uHeight + uRunStart,
+                                aDenseBlocks.begin() + (static_cast<size_t>(z) * uWidth + x) * uHeight + run.uEnd, run.blockType);
+                        }
+                        uRunStart = run.uEnd;
+                    }
+                }
+            }
+
+            std::vector<BYTE> aBytes;
+            for (UINT uChunkZ = 0u; uChunkZ < grid.GetNumChunksZ(); ++uChunkZ)
+            {
+                for (UINT uChunkX = 0u; uChunkX < grid.GetNumChunksX(); ++uChunkX)
+                {
+                    grid.SerializeChunk(uChunkX, uChunkZ, aBytes);
+                }
+            }
+
+            // Every chunk read back into a grid of the same size must give the same blocks
+            library::VoxelGrid readGrid(heightMap);
+            BOOL bRoundTrip = TRUE;
+            size_t uOffset = 0u;
+            for (UINT uChunkZ = 0u; uChunkZ < grid.GetNumChunksZ() && bRoundTrip; ++uChunkZ)
+            {
+                for (UINT uChunkX = 0u; uChunkX < grid.GetNumChunksX() && bRoundTrip; ++uChunkX)
+                {
+                    size_t uNumBytesRead = 0u;
+                    bRoundTrip = SUCCEEDED(readGrid.DeserializeChunk(uChunkX, uChunkZ, aBytes.data() + uOffset, aBytes.size() - uOffset, &uNumBytesRead));
+                    uOffset += uNumBytesRead;
+                }
+            }
+
+            std::vector<library::VoxelRun> aReadRuns;
+            for (UINT z = 0u; z < uDepth && bRoundTrip; ++z)
+            {
+                for (UINT x = 0u; x < uWidth && bRoundTrip; ++x)
+                {
+                    grid.GetColumnRuns(x, z, aRuns);
+                    readGrid.GetColumnRuns(x, z, aReadRuns);
+                    bRoundTrip = aRuns.size() == aReadRuns.size() && std::equal(aRuns.begin(), aRuns.end(), aReadRuns.begin(),
+                        [](const library::VoxelRun& a, const library::VoxelRun& b) { return a.uEnd == b.uEnd && a.blockType == b.blockType; });
+                }
+            }
+
+            std::mt19937 generator(STORAGE_SEED);
+            std::vector<XMUINT3> aLookups(STORAGE_NUM_LOOKUPS);
+            for (XMUINT3& lookup : aLookups)
+            {
+                lookup = XMUINT3(generator() % uWidth, generator() % uHeight, generator() % uDepth);
+            }
+
+            UINT64 uNumFound = 0u;
+            DOUBLE gridTime = MeasureBest(STORAGE_RUNS, [&]()
+            {
+                uNumFound = 0u;
+                for (const XMUINT3& lookup : aLookups)
+                {
+                    uNumFound += grid.GetBlock(lookup.x, lookup.y, lookup.z) != library::HeightMap::EMPTY_BLOCK ? 1u : 0u;
+                }
+                return TRUE;
+            });
+
+            UINT64 uNumDenseFound = 0u;
+            DOUBLE denseTime = MeasureBest(STORAGE_RUNS, [&]()
+            {
+                uNumDenseFound = 0u;
+                for (const XMUINT3& lookup : aLookups)
+                {
+                    uNumDenseFound += aDenseBlocks[(static_cast<size_t>(lookup.z) * uWidth + lookup.x) * uHeight + lookup.y] != library::HeightMap::EMPTY_BLOCK ? 1u : 0u;
+                }
+                return TRUE;
+            });
+
+            const DOUBLE blocks = static_cast<DOUBLE>(std::max(uNumBlocks, static_cast<UINT64>(1u)));
+            const DOUBLE lookups = static_cast<DOUBLE>(STORAGE_NUM_LOOKUPS);
+            wprintf(L"%-12ls %8.1f %6.1f%% %8.2f | %9.1f %8.3f %8.3f %8.2f | %8.3f %8.1f %8.1f   %ls\n",
+                pszName, static_cast<DOUBLE>(uNumBlocks) / 1.0e6, 100.0 * static_cast<DOUBLE>(uNumBlocks) / static_cast<DOUBLE>(uNumCells),
+                static_cast<DOUBLE>(uNumRuns) / static_cast<DOUBLE>(static_cast<UINT64>(uWidth) * uDepth),
+                static_cast<DOUBLE>(grid.GetMemoryUsage()) / 1024.0, static_cast<DOUBLE>(grid.GetMemoryUsage()) / blocks,
+                static_cast<DOUBLE>(aBytes.size()) / blocks, static_cast<DOUBLE>(uNumCells) / blocks,
+                static_cast<DOUBLE>(grid.GetMemoryUsage()) / static_cast<DOUBLE>(uNumCells),
+                gridTime * 1.0e6 / lookups, denseTime * 1.0e6 / lookups,
+                bRoundTrip && uNumFound == uNumDenseFound ? L"round trip ok" : L"MISMATCH");
+
+            return bRoundTrip && uNumFound == uNumDenseFound;
+        }
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: RunBenchStorage
+
+      Summary:  Builds the voxel grid of a benchmark map, of generated
+                terrain 64 and 256 blocks tall, and of the benchmark
+                map after random edits, 1024^2 by default, and prints
+                the bytes per block of the chunk storage in memory and
+                serialized next to the bytes per block of a dense
+                array, and the time of a random lookup in both
+
+      Args:     INT argc
+                  Number of arguments
+                PWSTR* argv
+                  [size]
+
+      Returns:  INT
+                  0 on success
+    F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+    INT RunBenchStorage(_In_ INT argc, _In_reads_(argc) PWSTR* argv)
+    {
+        UINT uSize = 0u;
+        if (!ParseUint(argc, argv, 0, STORAGE_DEFAULT_SIZE, uSize) || uSize == 0u)
+        {
+            wprintf(L"bench-storage [size]\n");
+            return 1;
+        }
+
+        wprintf(L"%-12ls %8ls %7ls %8ls | %9ls %8ls %8ls %8ls | %8ls %8ls %8ls\n",
+            L"terrain", L"Mblocks", L"fill", L"runs/col", L"memory KB", L"B/block", L"file B/b", L"dense", L"B/cell", L"grid ns", L"dense ns");
+
+        library::HeightMap benchmarkMap = CreateBenchmarkMap(uSize);
+        library::VoxelGrid benchmarkGrid(benchmarkMap);
+        BOOL bRoundTrip = PrintStorageStats(L"bench 64", benchmarkMap, benchmarkGrid);
+
+        constexpr const UINT aTerrainHeights[] = { 64u, 256u };
+        constexpr const PCWSTR aTerrainNames[] = { L"terrain 64", L"terrain 256" };
+        for (UINT i = 0u; i < ARRAYSIZE(aTerrainHeights); ++i)
+        {
+            const UINT uHeight = aTerrainHeights[i];
+            library::TerrainGenerator generator(
+                library::TerrainDesc
+                {
+                    .uWidth = uSize,
+                    .uHeight = uHeight,
+                    .uDepth = uSize,
+                    .uHeightSeed = STORAGE_SEED,
+                    .uMoistureSeed = STORAGE_SEED + 1u,
+                }
+            );
+
+            library::HeightMap terrainMap;
+            if (FAILED(generator.Generate(terrainMap)))
+            {
+                wprintf(L"Failed to generate a %ux%ux%u world\n", uSize, uHeight, uSize);
+                return 1;
+            }
+
+            library::VoxelGrid terrainGrid(terrainMap);
+            bRoundTrip = PrintStorageStats(aTerrainNames[i], terrainMap, terrainGrid) && bRoundTrip;
+        }
+
+        DOUBLE editTime = EditRandomBlocks(benchmarkGrid);
+        bRoundTrip = PrintStorageStats(L"bench edited", benchmarkMap, benchmarkGrid) && bRoundTrip;
+        wprintf(L"%u random edits, %.2f us per edit\n", STORAGE_NUM_EDITS, editTime);
+
+        return bRoundTrip ? 0 : 1;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,214 @@
+/*+===================================================================
+  File:      STREAMCOMMANDS.CPP
+
+  Summary:   Streaming commands of the world tool: flies a scripted
+             camera over the streamed world without a device and
+             reports the memory and the per-frame cost of streaming.
+
+  Functions: RunSoakStream
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+
+#include "Commands.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+
+#include "Scene/VoxelChunkStreamer.h"
+#include "Stopwatch.h"
+
+namespace worldtool
+{
+    namespace
+    {
+        constexpr const UINT SOAK_DEFAULT_FRAMES = 3600u;
+        constexpr const UINT SOAK_DEFAULT_BUDGET_MB = 256u;
+        constexpr const UINT SOAK_DEFAULT_RADIUS = 12u;
+        constexpr const UINT SOAK_REPORT_INTERVAL = 300u;
+
+        // 60 frames per second, flying at 120 units (60 blocks) per second
+        constexpr const DOUBLE SOAK_FRAME_SECONDS = 1.0 / 60.0;
+        constexpr const DOUBLE SOAK_SPEED = 120.0;
+        constexpr const DOUBLE SOAK_SPIRAL_SPACING = 256.0;
+        constexpr const DOUBLE SOAK_HEIGHT = 40.0;
+
+        /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+            Struct:   PathState
+
+            Summary:  Position along the scripted path: a straight run
+                      along x for the first half of the frames, then an
+                      outward spiral around the end of the run, both at
+                      SOAK_SPEED
+        S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+        struct PathState
+        {
+            DOUBLE x;
+            DOUBLE z;
+            DOUBLE angle;
+        };
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: AdvancePath
+
+          Summary:  Moves the camera one frame along the scripted path
+
+          Args:     UINT uFrame
+                      Index of the frame
+                    UINT uNumFrames
+                      Number of frames of the soak
+                    PathState& state
+                      Position along the path
+
+          Modifies: [state].
+        F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+        void AdvancePath(_In_ UINT uFrame, _In_ UINT uNumFrames, _Inout_ PathState& state)
+        {
+            const DOUBLE distance = SOAK_SPEED * SOAK_FRAME_SECONDS;
+            if (uFrame < uNumFrames / 2u)
+            {
+                state.x += distance;
+                return;
+            }
+
+            // Archimedean spiral r = spacing * angle / 2pi, stepped by arc length
+            const DOUBLE spacing = SOAK_SPIRAL_SPACING / (2.0 * 3.14159265358979323846);
+            DOUBLE radius = std::max(spacing * state.angle, SOAK_SPEED);
+            DOUBLE previousX = spacing * state.angle * std::cos(state.angle);
+            DOUBLE previousZ = spacing * state.angle * std::sin(state.angle);
+
+            state.angle += distance / radius;
+            state.x += spacing * state.angle * std::cos(state.angle) - previousX;
+            state.z += spacing * state.angle * std::sin(state.angle) - previousZ;
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+          Function: ToMegabytes
+
+          Summary:  Converts a number of bytes to megabytes
+
+          Args:     UINT64 uBytes
+                      Number of bytes
+
+          Returns:  DOUBLE
+                      Number of megabytes
+        F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+        DOUBLE ToMegabytes(_In_ UINT64 uBytes)
+        {
+            return static_cast<DOUBLE>(uBytes) / static_cast<DOUBLE>(1u << 20u);
+        }
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: RunSoakStream
+
+      Summary:  Streams the generated world around a camera flying a
+                scripted path, one Update per 1/60 s frame, without a
+                device so only generation and meshing run on the
+                workers. Reports the peak resident memory and the
+                worst, 99th percentile and average cost of Update
+
+      Args:     INT argc
+                  Number of arguments
+                PWSTR* argv
+                  [frames] [budgetMB] [radius]
+
+      Returns:  INT
+                  0 on success
+    F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+    INT RunSoakStream(_In_ INT argc, _In_reads_(argc) PWSTR* argv)
+    {
+        UINT uNumFrames = 0u;
+        UINT uBudgetMb = 0u;
+        UINT uRadius = 0u;
+        if (!ParseUint(argc, argv, 0, SOAK_DEFAULT_FRAMES, uNumFrames) ||
+            !ParseUint(argc, argv, 1, SOAK_DEFAULT_BUDGET_MB, uBudgetMb) ||
+            !ParseUint(argc, argv, 2, SOAK_DEFAULT_RADIUS, uRadius) ||
+            uNumFrames == 0u)
+        {
+            wprintf(L"soak-stream [frames] [budgetMB] [radius]\n");
+            return 1;
+        }
+
+        library::ChunkStreamingDesc desc =
+        {
+            .terrain =
+            {
+                .uWidth = 0u,
+                .uHeight = 64u,
+                .uDepth = 0u,
+                .uHeightSeed = 0u,
+                .uMoistureSeed = 1u
+            },
+            .meshing = library::eVoxelMeshing::GREEDY,
+            .uLoadRadius = uRadius,
+            .uMemoryBudget = static_cast<UINT64>(uBudgetMb) << 20u,
+            .uMaxLoadsPerFrame = 4u,
+            .uMaxEvictionsPerFrame = 8u,
+            .uNumWorkers = 0u
+        };
+        library::VoxelChunkStreamer streamer(desc);
+
+        HRESULT hr = streamer.Initialize(nullptr);
+        if (FAILED(hr))
+        {
+            wprintf(L"Failed to start the streamer (0x%08lX)\n", static_cast<ULONG>(hr));
+            return 1;
+        }
+
+        wprintf(L"Soak: %u frames, radius %u columns, budget %u MB, %u threads\n", uNumFrames, uRadius, uBudgetMb, std::thread::hardware_concurrency());
+
+        std::vector<DOUBLE> aFrameTimes;
+        aFrameTimes.reserve(uNumFrames);
+
+        PathState path = {};
+        const std::chrono::steady_clock::duration framePeriod = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<DOUBLE>(SOAK_FRAME_SECONDS));
+        std::chrono::steady_clock::time_point nextFrame = std::chrono::steady_clock::now();
+
+        Stopwatch totalStopwatch;
+        for (UINT uFrame = 0u; uFrame < uNumFrames; ++uFrame)
+        {
+            AdvancePath(uFrame, uNumFrames, path);
+            XMVECTOR eye = XMVectorSet(static_cast<FLOAT>(path.x), static_cast<FLOAT>(SOAK_HEIGHT), static_cast<FLOAT>(path.z), 1.0f);
+
+            Stopwatch stopwatch;
+            streamer.Update(eye);
+            aFrameTimes.push_back(stopwatch.GetElapsedMilliseconds());
+
+            const library::ChunkStreamingStats& stats = streamer.GetStats();
+            if ((uFrame + 1u) % SOAK_REPORT_INTERVAL == 0u)
+            {
+                wprintf(L"  frame %5u: camera (%8.0f, %8.0f), radius %2u, %4u columns, %5u chunks, %7.1f MB, %4u queued, update %.3f ms\n",
+                    uFrame + 1u, path.x, path.z, stats.uStreamRadius, stats.uNumResidentColumns, stats.uNumResidentChunks,
+                    ToMegabytes(stats.uResidentBytes), stats.uNumQueuedColumns, aFrameTimes.back());
+            }
+
+            nextFrame += framePeriod;
+            std::this_thread::sleep_until(nextFrame);
+        }
+        DOUBLE totalSeconds = totalStopwatch.GetElapsedMilliseconds() / 1000.0;
+
+        const library::ChunkStreamingStats& stats = streamer.GetStats();
+
+        DOUBLE averageTime = 0.0;
+        for (DOUBLE frameTime : aFrameTimes)
+        {
+            averageTime += frameTime;
+        }
+        averageTime /= static_cast<DOUBLE>(aFrameTimes.size());
+
+        std::sort(aFrameTimes.begin(), aFrameTimes.end());
+        DOUBLE p99Time = aFrameTimes[(aFrameTimes.size() - 1u) * 99u / 100u];
+        DOUBLE worstTime = aFrameTimes.back();
+
+        wprintf(L"Flew %.0f units in %.1f s\n", SOAK_SPEED * SOAK_FRAME_SECONDS * uNumFrames, totalSeconds);
+        wprintf(L"Peak resident memory: %.1f MB of %u MB (%.1f MB at the end)\n", ToMegabytes(stats.uPeakResidentBytes), uBudgetMb, ToMegabytes(stats.uResidentBytes));
+        wprintf(L"Columns loaded: %llu, evicted: %llu, discarded: %llu\n", stats.uTotalLoadedColumns, stats.uTotalEvictedColumns, stats.uTotalDiscardedColumns);
+        wprintf(L"Update per frame: worst %.3f ms, p99 %.3f ms, average %.3f ms\n", worstTime, p99Time, averageTime);
+
+        return 0;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,560 @@
+/*+===================================================================
+  File:      TERRAINCOMMANDS.CPP
+
+  Summary:   Smooth terrain commands of the world tool: replays
+             camera paths over a height map and reports the patches
+             and triangles the CDLOD quadtree draws per frame,
+             checking that the patches cover the map once and meet
+             without cracks, and checks the levels and their morph
+             ranges at known distances over a flat map.
+
+  Functions: RunBenchTerrain
+
+  © 2022 Kyung Hee University
+===================================================================+*/
+
+#include "Commands.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <unordered_map>
+
+#include "BenchmarkMap.h"
+#include "Scene/TerrainLodTree.h"
+#include "Stopwatch.h"
+
+namespace worldtool
+{
+    namespace
+    {
+        constexpr const UINT TERRAIN_DEFAULT_SIZE = 1024u;
+        constexpr const UINT TERRAIN_DEFAULT_DETAIL = 256u;
+        constexpr const UINT TERRAIN_PATH_FRAMES = 300u;
+
+        // Frames whose patches are checked for holes, overlaps and cracks
+        constexpr const UINT TERRAIN_CHECK_INTERVAL = 10u;
+
+        // Largest gap between two patches along their shared edge, in world units
+        constexpr const FLOAT TERRAIN_CRACK_EPSILON = 1e-3f;
+
+        // Columns along each side of the flat map the levels are checked on
+        constexpr const UINT TERRAIN_LEVEL_CHECK_SIZE = 512u;
+
+        // Largest error of a morph factor, and of a morphed vertex in world units
+        constexpr const FLOAT TERRAIN_MORPH_EPSILON = 1e-4f;
+
+        /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+            Struct:   CameraPath
+
+            Summary:  Camera positions of one path in world space, one
+                      per frame
+        S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+        struct CameraPath
+        {
+            PCWSTR pszName;
+            std::vector<XMFLOAT3> aEyes;
+        };
+
+        /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+            Struct:   SelectionCheck
+
+            Summary:  Problems found in the patches of one frame
+        S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+        struct SelectionCheck
+        {
+            UINT64 uNumHoles;
+            UINT64 uNumLevelJumps;
+            UINT64 uNumCracks;
+            UINT64 uNumEdgeVertices;
+            UINT64 uCoveredArea;
+            FLOAT maxGap;
+        };
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+
+          Function: createPaths
+
+          Summary:  Scripts the camera paths over the map: a walk along
+                    the diagonal at eye height, a low flight around the
+                    center and a high orbit above the tallest column
+
+          Args:     const library::HeightMap& heightMap
+                      Heights of the columns
+                    const CBTerrain& constants
+                      Placement of the map in world space
+
+          Returns:  std::vector<CameraPath>
+                      Paths of TERRAIN_PATH_FRAMES frames
+
+        F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+        std::vector<CameraPath> createPaths(_In_ const library::HeightMap& heightMap, _In_ const library::CBTerrain& constants)
+        {
+            const FLOAT width = static_cast<FLOAT>(heightMap.GetWidth());
+            const FLOAT depth = static_cast<FLOAT>(heightMap.GetDepth());
+
+            auto getEye = [&](FLOAT x, FLOAT z, FLOAT height)
+            {
+                UINT uColumnX = std::min(static_cast<UINT>(x), heightMap.GetWidth() - 1u);
+                UINT uColumnZ = std::min(static_cast<UINT>(z), heightMap.GetDepth() - 1u);
+                FLOAT top = static_cast<FLOAT>(heightMap.GetColumnHeight(uColumnX, uColumnZ));
+
+                return XMFLOAT3(constants.Origin.x + 2.0f * x, constants.Origin.y + 2.0f * (top + height), constants.Origin.z + 2.0f * z);
+            };
+
+            std::vector<CameraPath> aPaths =
+            {
+                { .pszName = L"walk" },
+                { .pszName = L"flight" },
+                { .pszName = L"orbit" },
+            };
+            for (UINT uFrame = 0u; uFrame < TERRAIN_PATH_FRAMES; ++uFrame)
+            {
+                const FLOAT t = static_cast<FLOAT>(uFrame) / static_cast<FLOAT>(TERRAIN_PATH_FRAMES);
+                const FLOAT angle = 2.0f * XM_PI * t;
+
+                aPaths[0].aEyes.push_back(getEye((0.1f + 0.8f * t) * width, (0.1f + 0.8f * t) * depth, 1.5f));
+                aPaths[1].aEyes.push_back(getEye((0.5f + 0.3f * std::cos(angle)) * width, (0.5f + 0.3f * std::sin(angle)) * depth, 8.0f));
+
+                XMFLOAT3 orbitEye = getEye((0.5f + 0.45f * std::cos(angle)) * width, (0.5f + 0.45f * std::sin(angle)) * depth, 0.0f);
+                orbitEye.y = constants.Origin.y + 2.0f * (static_cast<FLOAT>(heightMap.GetHeight()) + 16.0f);
+                aPaths[2].aEyes.push_back(orbitEye);
+            }
+
+            return aPaths;
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+
+          Function: getPatchKey
+
+          Summary:  Returns the key of the patch of a level holding a
+                    column
+
+          Args:     UINT uLevel
+                      Level of the patch
+                    UINT uColumnX
+                    UINT uColumnZ
+                      Column in the patch
+
+          Returns:  UINT64
+                      Level and coordinates of the patch
+
+        F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+        UINT64 getPatchKey(_In_ UINT uLevel, _In_ UINT uColumnX, _In_ UINT uColumnZ)
+        {
+            const UINT uPatchColumns = library::TerrainLodTree::PATCH_SIZE << uLevel;
+
+            return (static_cast<UINT64>(uLevel) << 56u) | (static_cast<UINT64>(uColumnZ / uPatchColumns) << 28u) | static_cast<UINT64>(uColumnX / uPatchColumns);
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+
+          Function: checkSelection
+
+          Summary:  Checks the patches of a frame. The area of the
+                    patches clipped to the map must be the area of the
+                    map. Every vertex on the edge of a patch must lie on
+                    the edge of the patch across, morphed as the vertex
+                    shader does, which must be at most one level apart.
+                    Both edges are polylines along the same line since
+                    the vertices of an edge only slide along it
+
+          Args:     const library::TerrainLodTree& tree
+                      Tree the patches were selected from
+                    const library::HeightMap& heightMap
+                      Heights of the columns
+                    const std::vector<library::TerrainPatchData>& aPatches
+                      Selected patches
+                    const XMFLOAT3& eye
+                      Position of the camera
+
+          Returns:  SelectionCheck
+                      Problems found
+
+        F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+        SelectionCheck checkSelection(
+            _In_ const library::TerrainLodTree& tree,
+            _In_ const library::HeightMap& heightMap,
+            _In_ const std::vector<library::TerrainPatchData>& aPatches,
+            _In_ const XMFLOAT3& eye
+        )
+        {
+            constexpr const UINT uPatchSize = library::TerrainLodTree::PATCH_SIZE;
+
+            SelectionCheck check = {};
+            std::unordered_map<UINT64, size_t> patchIndices;
+            for (size_t uPatch = 0u; uPatch < aPatches.size(); ++uPatch)
+            {
+                const library::TerrainPatchData& patch = aPatches[uPatch];
+                const UINT uPatchColumns = uPatchSize << patch.Level;
+                patchIndices.emplace(getPatchKey(patch.Level, patch.X, patch.Z), uPatch);
+                check.uCoveredArea += static_cast<UINT64>(std::min(patch.X + uPatchColumns, heightMap.GetWidth()) - patch.X)
+                    * static_cast<UINT64>(std::min(patch.Z + uPatchColumns, heightMap.GetDepth()) - patch.Z);
+            }
+
+            auto findPatch = [&](UINT uColumnX, UINT uColumnZ) -> const library::TerrainPatchData*
+            {
+                for (UINT uLevel = 0u; uLevel < tree.GetNumLevels(); ++uLevel)
+                {
+                    auto it = patchIndices.find(getPatchKey(uLevel, uColumnX, uColumnZ));
+                    if (it != patchIndices.end())
+                    {
+                        return &aPatches[it->second];
+                    }
+                }
+
+                return nullptr;
+            };
+
+            // Edges as the side of the grid they lie on, and the step to the column across
+            struct Edge
+            {
+                BOOL bAlongZ;
+                UINT uGrid;
+                INT iAcross;
+            };
+            constexpr const Edge aEdges[4] =
+            {
+                { .bAlongZ = TRUE, .uGrid = 0u, .iAcross = -1 },
+                { .bAlongZ = TRUE, .uGrid = uPatchSize, .iAcross = 1 },
+                { .bAlongZ = FALSE, .uGrid = 0u, .iAcross = -1 },
+                { .bAlongZ = FALSE, .uGrid = uPatchSize, .iAcross = 1 },
+            };
+
+            std::vector<XMFLOAT3> aNeighborEdge(uPatchSize + 1u);
+            for (const library::TerrainPatchData& patch : aPatches)
+            {
+                const UINT uPatchColumns = uPatchSize << patch.Level;
+                for (const Edge& edge : aEdges)
+                {
+                    // The column across the edge, none past the edge of the map
+                    const INT iAcross = static_cast<INT>(edge.bAlongZ ? patch.X : patch.Z) + (edge.iAcross < 0 ? -1 : static_cast<INT>(uPatchColumns));
+                    if (iAcross < 0 || iAcross >= static_cast<INT>(edge.bAlongZ ? heightMap.GetWidth() : heightMap.GetDepth()))
+                    {
+                        continue;
+                    }
+
+                    for (UINT uVertex = 0u; uVertex <= uPatchSize; ++uVertex)
+                    {
+                        const UINT uGridX = edge.bAlongZ ? edge.uGrid : uVertex;
+                        const UINT uGridZ = edge.bAlongZ ? uVertex : edge.uGrid;
+                        const UINT uAlong = std::min((edge.bAlongZ ? patch.Z : patch.X) + uVertex * (1u << patch.Level), (edge.bAlongZ ? heightMap.GetDepth() : heightMap.GetWidth()) - 1u);
+
+                        // The last vertex belongs to the next patch along the edge, unless the map ends there
+                        const UINT uLookup = uVertex == uPatchSize && uAlong > (edge.bAlongZ ? patch.Z : patch.X) ? uAlong - 1u : uAlong;
+                        const library::TerrainPatchData* pNeighbor = edge.bAlongZ
+                            ? findPatch(static_cast<UINT>(iAcross), uLookup)
+                            : findPatch(uLookup, static_cast<UINT>(iAcross));
+                        if (!pNeighbor)
+                        {
+                            ++check.uNumHoles;
+                            continue;
+                        }
+                        if (std::abs(static_cast<INT>(pNeighbor->Level) - static_cast<INT>(patch.Level)) > 1)
+                        {
+                            ++check.uNumLevelJumps;
+                        }
+
+                        const UINT uNeighborGrid = edge.iAcross < 0 ? uPatchSize : 0u;
+                        for (UINT uNeighborVertex = 0u; uNeighborVertex <= uPatchSize; ++uNeighborVertex)
+                        {
+                            aNeighborEdge[uNeighborVertex] = edge.bAlongZ
+                                ? tree.GetVertexPosition(*pNeighbor, uNeighborGrid, uNeighborVertex, eye)
+                                : tree.GetVertexPosition(*pNeighbor, uNeighborVertex, uNeighborGrid, eye);
+                        }
+
+                        const XMFLOAT3 position = tree.GetVertexPosition(patch, uGridX, uGridZ, eye);
+                        const FLOAT along = edge.bAlongZ ? position.z : position.x;
+                        FLOAT gap = FLT_MAX;
+                        for (UINT uSegment = 0u; uSegment < uPatchSize; ++uSegment)
+                        {
+                            const XMFLOAT3& start = aNeighborEdge[uSegment];
+                            const XMFLOAT3& end = aNeighborEdge[uSegment + 1u];
+                            const FLOAT startAlong = edge.bAlongZ ? start.z : start.x;
+                            const FLOAT endAlong = edge.bAlongZ ? end.z : end.x;
+                            if (along < startAlong - TERRAIN_CRACK_EPSILON || along > endAlong + TERRAIN_CRACK_EPSILON)
+                            {
+                                continue;
+                            }
+
+                            const FLOAT t = endAlong > startAlong ? std::clamp((along - startAlong) / (endAlong - startAlong), 0.0f, 1.0f) : 0.0f;
+                            const FLOAT across = edge.bAlongZ ? position.x - start.x : position.z - start.z;
+                            const FLOAT height = position.y - (start.y + (end.y - start.y) * t);
+                            gap = std::min(gap, std::sqrt(across * across + height * height));
+                        }
+
+                        ++check.uNumEdgeVertices;
+                        check.maxGap = std::max(check.maxGap, gap);
+                        check.uNumCracks += gap > TERRAIN_CRACK_EPSILON ? 1u : 0u;
+                    }
+                }
+            }
+
+            return check;
+        }
+
+        /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+
+          Function: checkLevels
+
+          Summary:  Checks the levels at distances known in advance on
+                    a flat map. The eye is put above the middle of the
+                    map, halfway between the ranges of a level and of
+                    the one below, so the patch under it must be of that
+                    level. Every patch must be out of the range of the
+                    level below and its node within the range of its
+                    own. The morph factor of every level must be 0 up to
+                    where its morph starts and 1 from its range on, where
+                    an odd vertex lies on the grid of the next level
+
+          Args:     FLOAT detailDistance
+                      Range of the finest level
+
+          Returns:  BOOL
+                      TRUE when every patch is at the level and every
+                      vertex is where the distances put it
+
+        F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+        BOOL checkLevels(_In_ FLOAT detailDistance)
+        {
+            library::HeightMap heightMap(TERRAIN_LEVEL_CHECK_SIZE, BENCH_MAP_HEIGHT, TERRAIN_LEVEL_CHECK_SIZE, { XMFLOAT4(0.5f, 0.5f, 0.5f, 1.0f) });
+            for (UINT z = 0u; z < TERRAIN_LEVEL_CHECK_SIZE; ++z)
+            {
+                for (UINT x = 0u; x < TERRAIN_LEVEL_CHECK_SIZE; ++x)
+                {
+                    heightMap.SetCell(x, z, static_cast<CHAR>(library::eBlockType::GRASSLAND), 0.5f);
+                }
+            }
+
+            library::TerrainLodTree tree(heightMap, detailDistance);
+            tree.Build();
+
+            library::CBTerrain constants;
+            tree.GetShaderConstants(constants);
+            const FLOAT surface = constants.Origin.y + 2.0f * static_cast<FLOAT>(heightMap.GetColumnHeight(0u, 0u));
+            const UINT uRootLevel = tree.GetNumLevels() - 1u;
+            const UINT uCenter = TERRAIN_LEVEL_CHECK_SIZE / 2u;
+
+            // Distance from the eye to the surface over a square of columns, like the tree measures its nodes
+            auto getDistance = [&](const XMFLOAT3& eye, UINT uFirstX, UINT uFirstZ, UINT uNumColumns)
+            {
+                const FLOAT minX = constants.Origin.x + 2.0f * static_cast<FLOAT>(uFirstX);
+                const FLOAT minZ = constants.Origin.z + 2.0f * static_cast<FLOAT>(uFirstZ);
+                const FLOAT maxX = constants.Origin.x + 2.0f * static_cast<FLOAT>(std::min(uFirstX + uNumColumns, TERRAIN_LEVEL_CHECK_SIZE - 1u));
+                const FLOAT maxZ = constants.Origin.z + 2.0f * static_cast<FLOAT>(std::min(uFirstZ + uNumColumns, TERRAIN_LEVEL_CHECK_SIZE - 1u));
+                const FLOAT dx = std::max({ minX - eye.x, 0.0f, eye.x - maxX });
+                const FLOAT dy = eye.y - surface;
+                const FLOAT dz = std::max({ minZ - eye.z, 0.0f, eye.z - maxZ });
+
+                return std::sqrt(dx * dx + dy * dy + dz * dz);
+            };
+
+            std::vector<library::TerrainPatchData> aPatches;
+            UINT64 uNumPatches = 0u;
+            UINT64 uNumWrongLevels = 0u;
+            for (UINT uLevel = 0u; uLevel <= uRootLevel; ++uLevel)
+            {
+                // The root has no range, it is drawn anywhere past the one of the level below
+                const FLOAT nearRange = uLevel == 0u ? 0.0f : tree.GetRange(uLevel - 1u);
+                const FLOAT height = uLevel == uRootLevel ? 1.5f * nearRange : 0.5f * (nearRange + tree.GetRange(uLevel));
+                const XMFLOAT3 eye(
+                    constants.Origin.x + 2.0f * static_cast<FLOAT>(uCenter) + 1.0f,
+                    surface + height,
+                    constants.Origin.z + 2.0f * static_cast<FLOAT>(uCenter) + 1.0f
+                );
+
+                tree.Select(XMLoadFloat3(&eye), aPatches);
+                uNumPatches += aPatches.size();
+
+                UINT uNumUnderEye = 0u;
+                for (const library::TerrainPatchData& patch : aPatches)
+                {
+                    const UINT uPatchColumns = library::TerrainLodTree::PATCH_SIZE << patch.Level;
+                    const UINT uNodeColumns = 2u * uPatchColumns;
+                    const BOOL bFinerOutOfRange = patch.Level == 0u || getDistance(eye, patch.X, patch.Z, uPatchColumns) > tree.GetRange(patch.Level - 1u);
+                    const BOOL bNodeInRange = patch.Level == uRootLevel
+                        || getDistance(eye, patch.X / uNodeColumns * uNodeColumns, patch.Z / uNodeColumns * uNodeColumns, uNodeColumns) <= tree.GetRange(patch.Level);
+                    if (!bFinerOutOfRange || !bNodeInRange)
+                    {
+                        ++uNumWrongLevels;
+                    }
+
+                    if (patch.X <= uCenter && uCenter < patch.X + uPatchColumns && patch.Z <= uCenter && uCenter < patch.Z + uPatchColumns)
+                    {
+                        ++uNumUnderEye;
+                        uNumWrongLevels += patch.Level == uLevel ? 0u : 1u;
+                    }
+                }
+                uNumWrongLevels += uNumUnderEye == 1u ? 0u : 1u;
+            }
+
+            UINT64 uNumWrongMorphs = 0u;
+            auto checkMorph = [&](UINT uLevel, FLOAT distance, FLOAT expected)
+            {
+                uNumWrongMorphs += std::abs(tree.GetMorphFactor(uLevel, distance) - expected) > TERRAIN_MORPH_EPSILON ? 1u : 0u;
+            };
+            auto checkVertex = [&](const XMFLOAT3& vertex, FLOAT x, FLOAT z)
+            {
+                uNumWrongMorphs += std::abs(vertex.x - x) > TERRAIN_MORPH_EPSILON || std::abs(vertex.z - z) > TERRAIN_MORPH_EPSILON ? 1u : 0u;
+            };
+            for (UINT uLevel = 0u; uLevel < uRootLevel; ++uLevel)
+            {
+                const FLOAT nearRange = uLevel == 0u ? 0.0f : tree.GetRange(uLevel - 1u);
+                const FLOAT range = tree.GetRange(uLevel);
+                const FLOAT morphStart = nearRange + library::TerrainLodTree::MORPH_START_RATIO * (range - nearRange);
+                checkMorph(uLevel, nearRange, 0.0f);
+                checkMorph(uLevel, morphStart, 0.0f);
+                checkMorph(uLevel, 0.5f * (morphStart + range), 0.5f);
+                checkMorph(uLevel, range, 1.0f);
+                checkMorph(uLevel, 2.0f * range, 1.0f);
+
+                // Vertex (1, 1) of the first patch, with the eye straight above it
+                const library::TerrainPatchData patch = { .X = 0u, .Z = 0u, .Level = uLevel };
+                const FLOAT spacing = 2.0f * static_cast<FLOAT>(1u << uLevel);
+                const XMFLOAT3 startEye(constants.Origin.x + spacing, surface + morphStart, constants.Origin.z + spacing);
+                const XMFLOAT3 rangeEye(constants.Origin.x + spacing, surface + range, constants.Origin.z + spacing);
+                checkVertex(tree.GetVertexPosition(patch, 1u, 1u, startEye), constants.Origin.x + spacing, constants.Origin.z + spacing);
+                checkVertex(tree.GetVertexPosition(patch, 1u, 1u, rangeEye), constants.Origin.x, constants.Origin.z);
+            }
+            checkMorph(uRootLevel, 0.0f, 0.0f);
+            checkMorph(uRootLevel, 2.0f * tree.GetRange(uRootLevel - 1u), 0.0f);
+
+            wprintf(L"Known distances: %u eye heights over %ux%u flat columns, %llu patches, %llu at a wrong level   %ls\n",
+                uRootLevel + 1u, TERRAIN_LEVEL_CHECK_SIZE, TERRAIN_LEVEL_CHECK_SIZE, uNumPatches, uNumWrongLevels, uNumWrongLevels == 0u ? L"ok" : L"BROKEN");
+            wprintf(L"Morph ranges: %u levels, %llu wrong factors or vertices at the start and the end of the ranges   %ls\n",
+                uRootLevel, uNumWrongMorphs, uNumWrongMorphs == 0u ? L"ok" : L"BROKEN");
+
+            return uNumWrongLevels == 0u && uNumWrongMorphs == 0u;
+        }
+    }
+
+    /*F+F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F+++F
+      Function: RunBenchTerrain
+
+      Summary:  Builds the CDLOD quadtree of the given height map, or
+                of a size^2 benchmark map, and replays a scripted walk,
+                flight and orbit. For every path prints the patches and
+                triangles drawn per frame against the full resolution
+                heightfield, the selection time and the triangles of
+                every level. Every few frames, checks that the patches
+                cover the map once, that neighbors are at most one
+                level apart and that their morphed edges meet. Then
+                checks the levels and the morph ranges at known
+                distances over a flat map
+
+      Args:     INT argc
+                  Number of arguments
+                PWSTR* argv
+                  [heightmap|size] [detailDistance]
+
+      Returns:  INT
+                  0 on success, 1 when the patches leave holes or
+                  cracks or a level is drawn out of its range
+    F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F---F-F*/
+    INT RunBenchTerrain(_In_ INT argc, _In_reads_(argc) PWSTR* argv)
+    {
+        UINT uSize = 0u;
+        UINT uDetail = 0u;
+        library::HeightMap heightMap;
+        if (ParseUint(argc, argv, 0, TERRAIN_DEFAULT_SIZE, uSize) && uSize > 0u)
+        {
+            heightMap = CreateBenchmarkMap(uSize);
+        }
+        else if (FAILED(heightMap.LoadFromFile(argv[0])))
+        {
+            wprintf(L"Failed to load %ls\n", argv[0]);
+            return 1;
+        }
+
+        if (!ParseUint(argc, argv, 1, TERRAIN_DEFAULT_DETAIL, uDetail) || uDetail == 0u)
+        {
+            wprintf(L"bench-terrain [heightmap|size] [detailDistance]\n");
+            return 1;
+        }
+
+        library::TerrainLodTree tree(heightMap, static_cast<FLOAT>(uDetail));
+
+        Stopwatch stopwatch;
+        tree.Build();
+        wprintf(L"Built %u levels over %ux%u columns in %.1f ms, patches of %u triangles\n",
+            tree.GetNumLevels(), heightMap.GetWidth(), heightMap.GetDepth(), stopwatch.GetElapsedMilliseconds(), library::TerrainLodTree::PATCH_TRIANGLES);
+        for (UINT uLevel = 0u; uLevel + 1u < tree.GetNumLevels(); ++uLevel)
+        {
+            wprintf(L"  level %2u: %5u columns apart, drawn within %.0f units\n", uLevel, 1u << uLevel, tree.GetRange(uLevel));
+        }
+
+        library::CBTerrain constants;
+        tree.GetShaderConstants(constants);
+        std::vector<CameraPath> aPaths = createPaths(heightMap, constants);
+
+        // Two triangles between every four neighboring columns
+        const UINT64 uFullTriangles = 2u * static_cast<UINT64>(heightMap.GetWidth() - 1u) * static_cast<UINT64>(heightMap.GetDepth() - 1u);
+        const UINT64 uMapArea = static_cast<UINT64>(heightMap.GetWidth()) * static_cast<UINT64>(heightMap.GetDepth());
+
+        std::vector<library::TerrainPatchData> aPatches;
+        SelectionCheck total = {};
+        UINT64 uNumBadCoverage = 0u;
+        wprintf(L"%-10ls %7ls %9ls %11ls %11ls %9ls %9ls %9ls\n",
+            L"path", L"frames", L"patches", L"triangles", L"max tris", L"of full", L"select ms", L"max ms");
+        for (const CameraPath& path : aPaths)
+        {
+            library::TerrainLodLevelStats aLevels[MAX_NUM_TERRAIN_LEVELS] = {};
+            DOUBLE patches = 0.0;
+            DOUBLE triangles = 0.0;
+            UINT64 uMaxTriangles = 0u;
+            DOUBLE selectTime = 0.0;
+            DOUBLE maxSelectTime = 0.0;
+            for (UINT uFrame = 0u; uFrame < path.aEyes.size(); ++uFrame)
+            {
+                tree.Select(XMLoadFloat3(&path.aEyes[uFrame]), aPatches);
+
+                const library::TerrainLodStats& stats = tree.GetStats();
+                patches += static_cast<DOUBLE>(stats.uNumPatches);
+                triangles += static_cast<DOUBLE>(stats.uNumTriangles);
+                uMaxTriangles = std::max(uMaxTriangles, stats.uNumTriangles);
+                selectTime += stats.selectTime * 1000.0;
+                maxSelectTime = std::max(maxSelectTime, stats.selectTime * 1000.0);
+                for (UINT uLevel = 0u; uLevel < tree.GetNumLevels(); ++uLevel)
+                {
+                    aLevels[uLevel].uNumPatches += stats.aLevels[uLevel].uNumPatches;
+                    aLevels[uLevel].uNumTriangles += stats.aLevels[uLevel].uNumTriangles;
+                }
+
+                if (uFrame % TERRAIN_CHECK_INTERVAL == 0u)
+                {
+                    SelectionCheck check = checkSelection(tree, heightMap, aPatches, path.aEyes[uFrame]);
+                    uNumBadCoverage += check.uCoveredArea == uMapArea ? 0u : 1u;
+                    total.uNumHoles += check.uNumHoles;
+                    total.uNumLevelJumps += check.uNumLevelJumps;
+                    total.uNumCracks += check.uNumCracks;
+                    total.uNumEdgeVertices += check.uNumEdgeVertices;
+                    total.maxGap = std::max(total.maxGap, check.maxGap);
+                }
+            }
+
+            const DOUBLE frames = static_cast<DOUBLE>(path.aEyes.size());
+            wprintf(L"%-10ls %7zu %9.0f %11.0f %11llu %8.2f%% %9.3f %9.3f\n",
+                path.pszName, path.aEyes.size(), patches / frames, triangles / frames, uMaxTriangles,
+                100.0 * triangles / frames / static_cast<DOUBLE>(uFullTriangles), selectTime / frames, maxSelectTime);
+            for (UINT uLevel = 0u; uLevel < tree.GetNumLevels(); ++uLevel)
+            {
+                if (aLevels[uLevel].uNumPatches > 0u)
+                {
+                    wprintf(L"  level %2u %17.1f %11.0f\n", uLevel,
+                        static_cast<DOUBLE>(aLevels[uLevel].uNumPatches) / frames, static_cast<DOUBLE>(aLevels[uLevel].uNumTriangles) / frames);
+                }
+            }
+        }
+
+        const BOOL bPassed = uNumBadCoverage == 0u && total.uNumHoles == 0u && total.uNumLevelJumps == 0u && total.uNumCracks == 0u;
+        wprintf(L"Full resolution: %llu triangles\n", uFullTriangles);
+        wprintf(L"Checked %llu edge vertices: %llu frames with holes or overlaps, %llu vertices without a neighbor, %llu across two levels, %llu cracks, largest gap %.6f   %ls\n",
+            total.uNumEdgeVertices, uNumBadCoverage, total.uNumHoles, total.uNumLevelJumps, total.uNumCracks, total.maxGap, bPassed ? L"ok" : L"BROKEN");
+
+        const BOOL bLevelsPassed = checkLevels(static_cast<FLOAT>(uDetail));
+
+        return bPassed && bLevelsPassed ? 0 : 1;
+    }
+}
\ No newline at end of file